@@ -24,6 +24,7 @@ namespace onnxruntime {
 class IExecutionFrame;
 class OpKernelContext;
 class OpKernelWrapper;
+struct PrePackedWeights;
 namespace concurrency {
 class ThreadPool;
 }
@@ -49,6 +50,30 @@ class OpKernel {
     ORT_NOT_IMPLEMENTED(__FUNCTION__, " is not implemented");
   }
 
+  // Override this function to pre-pack a constant initializer into the layout preferred by the kernel.
+  // It is called once for each constant input of the node during session initialization, after the
+  // kernel has been created.
+  // If the kernel packs the tensor it must set is_packed to true. The original tensor may then be released
+  // by the session, so the kernel must not hold on to it or read the input from the context in Compute.
+  // Any buffer for the packed data must be allocated with 'alloc'. If 'prepacked_weights' is not null the
+  // packed buffers (and their sizes) must be moved into it instead of being kept by the kernel so that they
+  // can be shared between sessions; UseSharedPrePackedBuffers will then be called with the buffers to use.
+  virtual Status PrePack(const Tensor& /*tensor*/, int /*input_idx*/, AllocatorPtr /*alloc*/,
+                         /*out*/ bool& is_packed, /*out*/ PrePackedWeights* /*prepacked_weights*/) {
+    is_packed = false;
+    return Status::OK();
+  }
+
+  // Override this function to take the packed buffers produced by PrePack for 'input_idx'.
+  // The buffers may be shared with other kernels in this or other sessions, so they must be treated as
+  // read-only. The kernel must set used_shared_buffers to true if it takes ownership of the buffers.
+  virtual Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                           int /*input_idx*/,
+                                           /*out*/ bool& used_shared_buffers) {
+    used_shared_buffers = false;
+    return Status::OK();
+  }
+
   const OrtMemoryInfo& Allocator(int id, OrtMemType mem_type) const {
     return op_kernel_info_.GetMemoryInfo(id, mem_type);
   }
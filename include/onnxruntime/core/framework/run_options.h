@@ -22,6 +22,10 @@ struct OrtRunOptions {
   // be forced to terminate with an error status.
   bool terminate = false;
 
+  // Set to 'true' to return the memory regions of the session's arenas that have nothing in use
+  // to the device once the Run() calls using this instance complete.
+  bool shrink_memory_arenas = false;
+
   OrtRunOptions() = default;
   ~OrtRunOptions() = default;
 
@@ -116,7 +116,8 @@ class OrtMutex {
   OrtMutex& operator=(const OrtMutex&) = delete;
 
   void lock() { nsync::nsync_mu_lock(&data_); }
-  bool try_lock() noexcept { return nsync::nsync_mu_trylock(&data_) == 0; }
+  // nsync_mu_trylock returns non-zero iff the mutex was acquired
+  bool try_lock() noexcept { return nsync::nsync_mu_trylock(&data_) != 0; }
   void unlock() noexcept { nsync::nsync_mu_unlock(&data_); }
 
   using native_handle_type = nsync::nsync_mu*;
@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <atomic>
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <functional>
@@ -29,6 +31,32 @@ namespace onnxruntime {
 
 namespace concurrency {
 
+/**
+ * Cost of processing one unit of work in ParallelFor, in the terms used by Eigen::TensorOpCost:
+ * bytes loaded from memory, bytes stored to memory, and cycles of computation.
+ */
+struct TensorOpCost {
+  double bytes_loaded;
+  double bytes_stored;
+  double compute_cycles;
+};
+
+/**
+ * Options for the threads of a ThreadPool.
+ */
+struct ThreadPoolOptions {
+  // Let idle threads spin looking for work for a while before they block.
+  bool allow_spinning = true;
+
+  // Time in microseconds that the thread calling ParallelFor spins waiting for the pool threads to finish
+  // their share of the work before it blocks. 0 blocks straight away.
+  int spin_duration_us = 0;
+
+  // Logical processors each thread of the pool is restricted to: thread i uses affinity[i % affinity.size()].
+  // Empty means the threads are not pinned.
+  std::vector<std::vector<size_t>> affinity;
+};
+
 /**
  * Generic class for instantiating thread pools.
  * Don't put any object of this type into a global variable in a Win32 DLL.
@@ -38,7 +66,9 @@ class ThreadPool {
   /*
   Initializes a thread pool given the current environment.
   */
-  ThreadPool(const std::string& name, int num_threads);
+  ThreadPool(const std::string& name, int num_threads, const ThreadPoolOptions& options = ThreadPoolOptions());
+
+  ~ThreadPool();
 
   /*
   Enqueue a unit of work.
@@ -48,7 +78,21 @@ class ThreadPool {
   /*
   Schedule work in the interval [0, total).
   */
-  void ParallelFor(int32_t total, std::function<void(int32_t)> fn);
+  void ParallelFor(int32_t total, const std::function<void(int32_t)>& fn);
+
+  /*
+  Schedule work in the interval [0, total), calling fn on blocks [first, last).
+  The number of threads and the block size are chosen from the cost of one unit of work, so cheap
+  loops run on the calling thread. The calling thread always processes blocks as well.
+  */
+  void ParallelFor(std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                   const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn);
+
+  /*
+  Same as above, with the cost of one unit of work given in compute cycles only.
+  */
+  void ParallelFor(std::ptrdiff_t total, double cost_per_unit,
+                   const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn);
 
   /*
   Schedule work in the interval [0, total), with calls split into (num_batches) batches.
@@ -100,14 +144,37 @@ class ThreadPool {
     }
   }
 
+  /**
+  Tries to call the given function in parallel on blocks of [0, total), using the cost of one unit of work
+  to choose the block size.
+  **/
+  inline static void TryParallelFor(concurrency::ThreadPool* tp, std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                                    const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn) {
+    if (tp != nullptr) {
+      tp->ParallelFor(total, cost_per_unit, fn);
+    } else if (total > 0) {
+      fn(0, total);
+    }
+  }
+
   int NumThreads() const;
 
   int CurrentThreadId() const;
 
-  Eigen::ThreadPool& GetHandler() { return impl_; }
+  Eigen::ThreadPoolInterface& GetHandler() { return *impl_; }
 
  private:
-  Eigen::ThreadPool impl_;
+  // Runs fn on blocks of block_size from [0, total) on the calling thread and up to num_helpers pool threads.
+  // Blocks are claimed dynamically, so helpers that start late or threads that finish early balance the load.
+  // When several loops run at the same time, e.g. from sessions sharing the pool, a loop that starts schedules
+  // at most NumThreads() / (number of running loops) helpers. The cap is only taken when the loop starts, so a
+  // loop that started alone keeps all of its helpers when others start later.
+  void RunInParallel(std::ptrdiff_t total, std::ptrdiff_t block_size, int num_helpers,
+                     const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn);
+
+  const int spin_duration_us_;
+  std::atomic<int> num_active_loops_{0};
+  std::unique_ptr<Eigen::ThreadPoolInterface> impl_;
 };
 
 }  // namespace concurrency
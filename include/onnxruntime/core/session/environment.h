@@ -5,10 +5,19 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include "core/common/common.h"
 #include "core/common/status.h"
 
+struct OrtThreadingOptions;
+
 namespace onnxruntime {
+class PrepackedWeightsContainer;
+
+namespace concurrency {
+class ThreadPool;
+}
+
 /** TODO: remove this class
    Provides the runtime environment for onnxruntime.
    Create one instance for the duration of execution.
@@ -20,10 +29,43 @@ class Environment {
   */
   static Status Create(std::unique_ptr<Environment>& environment);
 
+  /**
+     Create and initialize the runtime environment, with global thread pools that sessions can use
+     instead of creating their own.
+  */
+  static Status Create(std::unique_ptr<Environment>& environment, const OrtThreadingOptions& tp_options);
+
+  ~Environment();
+
+  /**
+     Returns the container for weights pre-packed by kernels, shared by all sessions using this environment.
+  */
+  PrepackedWeightsContainer* GetPrepackedWeightsContainer() const { return prepacked_weights_container_.get(); }
+
+  /**
+     Returns true if the environment was created with global thread pools.
+  */
+  bool EnvCreatedWithGlobalThreadPools() const { return create_global_thread_pools_; }
+
+  /**
+     Returns the global thread pools. nullptr if there are none, or if the pool was configured with a single
+     thread, in which case the work runs on the calling thread.
+     The inter-op pool is only used by sessions with ORT_PARALLEL execution, so it is created by the first call.
+  */
+  concurrency::ThreadPool* GetIntraOpThreadPool() const { return intra_op_thread_pool_.get(); }
+  concurrency::ThreadPool* GetInterOpThreadPool() const;
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Environment);
 
   Environment() = default;
-  Status Initialize();
+  Status Initialize(const OrtThreadingOptions* tp_options);
+
+  std::unique_ptr<PrepackedWeightsContainer> prepacked_weights_container_;
+  bool create_global_thread_pools_{false};
+  std::unique_ptr<concurrency::ThreadPool> intra_op_thread_pool_;
+  std::unique_ptr<OrtThreadingOptions> tp_options_;
+  mutable std::once_flag inter_op_thread_pool_once_flag_;
+  mutable std::unique_ptr<concurrency::ThreadPool> inter_op_thread_pool_;
 };
 }  // namespace onnxruntime
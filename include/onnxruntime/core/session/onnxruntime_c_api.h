@@ -159,6 +159,8 @@ ORT_RUNTIME_CLASS(CustomOpDomain);
 ORT_RUNTIME_CLASS(MapTypeInfo);
 ORT_RUNTIME_CLASS(SequenceTypeInfo);
 ORT_RUNTIME_CLASS(ModelMetadata);
+ORT_RUNTIME_CLASS(RunHandle);
+ORT_RUNTIME_CLASS(ThreadingOptions);
 
 // When passing in an allocator to any ORT function, be sure that the allocator object
 // is not destroyed until the last allocated object using it is freed.
@@ -169,6 +171,22 @@ typedef struct OrtAllocator {
   const struct OrtMemoryInfo*(ORT_API_CALL* Info)(const struct OrtAllocator* this_);
 } OrtAllocator;
 
+// Statistics of a memory arena, returned by SessionGetAllocatorStats.
+typedef struct OrtAllocatorStats {
+  int64_t num_allocs;              // number of allocations
+  int64_t bytes_in_use;            // bytes allocated and not yet freed
+  int64_t total_allocated_bytes;   // bytes the arena holds, in use or not
+  int64_t max_bytes_in_use;        // high-water mark of bytes_in_use
+  int64_t max_alloc_size;          // largest single allocation
+  int64_t bytes_limit;             // the most the arena may hold, or 0 when unknown
+  int64_t num_thread_cache_hits;   // allocations served from a thread cache without locking the arena
+  int64_t bytes_in_thread_caches;  // freed bytes held in thread caches
+  int64_t num_lock_contentions;    // times a thread had to wait for the arena lock
+  int64_t num_regions;             // memory regions the arena holds
+  int64_t largest_free_block;      // largest allocation the arena can serve without growing
+  int64_t total_released_bytes;    // bytes returned to the device by shrinking the arena
+} OrtAllocatorStats;
+
 typedef void(ORT_API_CALL* OrtLoggingFunction)(
     void* param, OrtLoggingLevel severity, const char* category, const char* logid, const char* code_location,
     const char* message);
@@ -188,6 +206,13 @@ typedef enum ExecutionMode {
   ORT_PARALLEL = 1,
 } ExecutionMode;
 
+typedef enum OrtThreadAffinityPolicy {
+  ORT_THREAD_AFFINITY_NONE = 0,      // threads are not pinned
+  ORT_THREAD_AFFINITY_COMPACT = 1,   // threads are pinned to consecutive logical processors
+  ORT_THREAD_AFFINITY_SCATTER = 2,   // threads are pinned to logical processors spread evenly over the machine
+  ORT_THREAD_AFFINITY_EXPLICIT = 3,  // threads are pinned to a given list of logical processors
+} OrtThreadAffinityPolicy;
+
 struct OrtKernelInfo;
 typedef struct OrtKernelInfo OrtKernelInfo;
 struct OrtKernelContext;
@@ -747,6 +772,158 @@ struct OrtApi {
   OrtStatus*(ORT_API_CALL* ModelMetadataGetVersion)(_In_ const OrtModelMetadata* model_metadata, _Out_ int64_t* value)NO_EXCEPTION;
 
   ORT_CLASS_RELEASE(ModelMetadata);
+
+  /**
+   * Share the weights pre-packed by kernels with other sessions created from the same env with this option set.
+   * Useful when several sessions load the same model, as only one copy of the packed weights is kept.
+   * The env must outlive the sessions.
+   */
+  OrtStatus*(ORT_API_CALL* EnablePrePackedWeightsSharing)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+  OrtStatus*(ORT_API_CALL* DisablePrePackedWeightsSharing)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /**
+   * Resolve the input and output names, and whether inputs and outputs need to be copied between devices, once
+   * for repeated calls to RunWithHandle that use the same inputs and outputs.
+   * The handle can be shared by concurrent RunWithHandle calls on 'sess'. It must be released before 'sess'.
+   */
+  OrtStatus*(ORT_API_CALL* CreateRunHandle)(_In_ const OrtSession* sess,
+                                            _In_ const char* const* input_names, size_t input_len,
+                                            _In_ const char* const* output_names, size_t output_names_len,
+                                            _Outptr_ OrtRunHandle** out)NO_EXCEPTION;
+
+  /**
+   * Same as Run, using the input and output names resolved by CreateRunHandle.
+   * \param input values in the order of the input names given to CreateRunHandle.
+   * \param output values in the order of the output names given to CreateRunHandle. Null entries are allocated.
+   */
+  OrtStatus*(ORT_API_CALL* RunWithHandle)(_Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                                          _In_ const OrtRunHandle* run_handle,
+                                          _In_ const OrtValue* const* input, size_t input_len,
+                                          _Inout_ OrtValue** output, size_t output_len)NO_EXCEPTION;
+
+  ORT_CLASS_RELEASE(RunHandle);
+
+  /**
+   * Sets the time in microseconds that a thread running a parallel loop on one of the session's thread pools spins
+   * waiting for the pool threads to finish the last blocks of the loop before it blocks. Spinning lowers the latency
+   * of the wait at the cost of CPU time. 0, the default, blocks straight away.
+   * Only the calling thread uses the duration. See SetThreadPoolAllowSpinning for the pool's worker threads.
+   */
+  OrtStatus*(ORT_API_CALL* SetThreadPoolSpinDuration)(_Inout_ OrtSessionOptions* options, int spin_duration_us)NO_EXCEPTION;
+
+  /**
+   * Sets whether the idle worker threads of the session's thread pools spin looking for work for a while before they
+   * sleep. The length of that spin is built into the pool. 0 makes idle workers sleep straight away, which saves CPU
+   * time but makes them slower to pick up new work. Non-zero, the default, lets them spin.
+   */
+  OrtStatus*(ORT_API_CALL* SetThreadPoolAllowSpinning)(_Inout_ OrtSessionOptions* options, int allow_spinning)NO_EXCEPTION;
+
+  /**
+   * Sets how the threads of the session's thread pools are pinned to logical processors.
+   * \param logical_processors the processors for ORT_THREAD_AFFINITY_EXPLICIT. Thread i of a pool is pinned to
+   *   logical_processors[i % num_logical_processors]. Ignored for the other policies.
+   */
+  OrtStatus*(ORT_API_CALL* SetThreadPoolAffinity)(_Inout_ OrtSessionOptions* options, OrtThreadAffinityPolicy policy,
+                                                  _In_opt_ const size_t* logical_processors,
+                                                  size_t num_logical_processors)NO_EXCEPTION;
+
+  /**
+   * Restricts the threads of the session's thread pools to the logical processors of a NUMA node.
+   * Memory is normally placed on the node of the thread that first writes to it, so this also keeps the memory
+   * used by those threads local to the node. -1, the default, uses all nodes.
+   */
+  OrtStatus*(ORT_API_CALL* SetThreadPoolNumaNode)(_Inout_ OrtSessionOptions* options, int numa_node)NO_EXCEPTION;
+
+  /**
+   * Create an env with global intra-op and inter-op thread pools, configured by threading_options.
+   * Sessions that call DisablePerSessionThreads use these pools instead of creating their own, so many sessions
+   * in one process don't oversubscribe the machine. A parallel loop schedules fewer helper threads while
+   * other loops are running on the pool, but that limit is only set when the loop starts.
+   * As the env is a singleton, this fails if it already exists without global thread pools.
+   */
+  OrtStatus*(ORT_API_CALL* CreateEnvWithGlobalThreadPools)(OrtLoggingLevel default_logging_level, _In_ const char* logid,
+                                                           _In_ const OrtThreadingOptions* threading_options,
+                                                           _Outptr_ OrtEnv** out)NO_EXCEPTION;
+
+  /**
+   * Use the global thread pools of the env instead of creating thread pools for the session.
+   * The thread pool settings of the session options are then ignored.
+   */
+  OrtStatus*(ORT_API_CALL* DisablePerSessionThreads)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /**
+   * Options for the global thread pools, passed to CreateEnvWithGlobalThreadPools.
+   * The setters mirror the session option setters and apply to both the intra-op and inter-op pools,
+   * except for the number of threads.
+   */
+  OrtStatus*(ORT_API_CALL* CreateThreadingOptions)(_Outptr_ OrtThreadingOptions** out)NO_EXCEPTION;
+  ORT_CLASS_RELEASE(ThreadingOptions);
+  OrtStatus*(ORT_API_CALL* SetGlobalIntraOpNumThreads)(_Inout_ OrtThreadingOptions* tp_options,
+                                                       int intra_op_num_threads)NO_EXCEPTION;
+  OrtStatus*(ORT_API_CALL* SetGlobalInterOpNumThreads)(_Inout_ OrtThreadingOptions* tp_options,
+                                                       int inter_op_num_threads)NO_EXCEPTION;
+  OrtStatus*(ORT_API_CALL* SetGlobalSpinDuration)(_Inout_ OrtThreadingOptions* tp_options,
+                                                  int spin_duration_us)NO_EXCEPTION;
+  OrtStatus*(ORT_API_CALL* SetGlobalAllowSpinning)(_Inout_ OrtThreadingOptions* tp_options,
+                                                   int allow_spinning)NO_EXCEPTION;
+  OrtStatus*(ORT_API_CALL* SetGlobalThreadAffinity)(_Inout_ OrtThreadingOptions* tp_options,
+                                                    OrtThreadAffinityPolicy policy,
+                                                    _In_opt_ const size_t* logical_processors,
+                                                    size_t num_logical_processors)NO_EXCEPTION;
+  OrtStatus*(ORT_API_CALL* SetGlobalNumaNode)(_Inout_ OrtThreadingOptions* tp_options, int numa_node)NO_EXCEPTION;
+
+  /**
+   * Memory arenas only grow while a session runs. These options make the session return the memory regions of its
+   * arenas that have nothing in use to the device.
+   * \param interval_runs shrink the arenas after every interval_runs runs. 0, the default, disables it.
+   * \param idle_ms shrink the arenas when a run starts after the session was idle for at least idle_ms
+   *   milliseconds. 0, the default, disables it. The session has no background thread, so the idle check only
+   *   happens lazily at the start of the next Run: the memory is released when that run arrives, not during the
+   *   idle time, and is never released if no further run arrives. Call Run with RunOptionsSetShrinkArenas to
+   *   release it at a known point instead.
+   */
+  OrtStatus*(ORT_API_CALL* SetArenaShrinkPolicy)(_Inout_ OrtSessionOptions* options, int interval_runs,
+                                                 int64_t idle_ms)NO_EXCEPTION;
+
+  /**
+   * Caps the memory the CPU arena of the session may hold. Allocations that would take it over the cap fail.
+   * 0, the default, leaves it uncapped.
+   */
+  OrtStatus*(ORT_API_CALL* SetCpuMemArenaMaxBytes)(_Inout_ OrtSessionOptions* options, size_t max_bytes)NO_EXCEPTION;
+
+  /**
+   * Shrink the memory arenas of the session after Run calls that use this OrtRunOptions instance complete.
+   */
+  OrtStatus*(ORT_API_CALL* RunOptionsSetShrinkArenas)(_Inout_ OrtRunOptions* options, int shrink)NO_EXCEPTION;
+
+  /**
+   * Get the statistics of the memory arena of the session for mem_info.
+   * Fails if the session has no allocator for mem_info, or if that allocator isn't an arena.
+   */
+  OrtStatus*(ORT_API_CALL* SessionGetAllocatorStats)(_In_ const OrtSession* sess, _In_ const OrtMemoryInfo* mem_info,
+                                                     _Out_ OrtAllocatorStats* out)NO_EXCEPTION;
+
+  /**
+   * Share memory patterns between inputs of similar shapes. When looking up the memory pattern of a run, every
+   * input dim is rounded up to the smallest of the dim buckets that holds it, so e.g. inputs with sequence lengths
+   * in the same bucket use one pattern, traced with the largest of them.
+   * \param dim_buckets the buckets in increasing order. Dims larger than the last bucket are matched exactly.
+   *   May be null if num_buckets is 0, to match all dims exactly, which is the default.
+   * \param max_patterns the most memory patterns the session keeps. The least recently used pattern is evicted
+   *   to make room for another. The default is 64.
+   */
+  OrtStatus*(ORT_API_CALL* SetMemPatternShapeBuckets)(_Inout_ OrtSessionOptions* options,
+                                                      _In_opt_ const int64_t* dim_buckets, size_t num_buckets,
+                                                      size_t max_patterns)NO_EXCEPTION;
+
+  /**
+   * Map the model file into memory when a session loads a model from a file path. The large initializers of the
+   * main graph then use their data in the mapping instead of being copied out of the model, which lowers the peak
+   * memory and the time taken to load large models. Where files can't be mapped, the file is read once instead.
+   * Off by default.
+   */
+  OrtStatus*(ORT_API_CALL* EnableMappedModelLoading)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+  OrtStatus*(ORT_API_CALL* DisableMappedModelLoading)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
 };
 
 /*
@@ -71,6 +71,8 @@ ORT_DEFINE_RELEASE(TensorTypeAndShapeInfo);
 ORT_DEFINE_RELEASE(TypeInfo);
 ORT_DEFINE_RELEASE(Value);
 ORT_DEFINE_RELEASE(ModelMetadata);
+ORT_DEFINE_RELEASE(RunHandle);
+ORT_DEFINE_RELEASE(ThreadingOptions);
 
 // This is used internally by the C++ API. This is the common base class used by the wrapper objects.
 template <typename T>
@@ -119,11 +121,15 @@ struct Env;
 struct TypeInfo;
 struct Value;
 struct ModelMetadata;
+struct RunHandle;
+struct ThreadingOptions;
 
 struct Env : Base<OrtEnv> {
   Env(std::nullptr_t) {}
   Env(OrtLoggingLevel default_logging_level = ORT_LOGGING_LEVEL_WARNING, _In_ const char* logid = "");
   Env(OrtLoggingLevel default_logging_level, const char* logid, OrtLoggingFunction logging_function, void* logger_param);
+  Env(const ThreadingOptions& tp_options, OrtLoggingLevel default_logging_level = ORT_LOGGING_LEVEL_WARNING,
+      _In_ const char* logid = "");
   explicit Env(OrtEnv* p) : Base<OrtEnv>{p} {}
 
   Env& EnableTelemetryEvents();
@@ -132,6 +138,20 @@ struct Env : Base<OrtEnv> {
   static const OrtApi* s_api;
 };
 
+// Options for the global thread pools of an Env shared by sessions that call DisablePerSessionThreads
+struct ThreadingOptions : Base<OrtThreadingOptions> {
+  explicit ThreadingOptions(std::nullptr_t) {}
+  ThreadingOptions();
+
+  ThreadingOptions& SetGlobalIntraOpNumThreads(int intra_op_num_threads);
+  ThreadingOptions& SetGlobalInterOpNumThreads(int inter_op_num_threads);
+  ThreadingOptions& SetGlobalSpinDuration(int spin_duration_us);
+  ThreadingOptions& SetGlobalAllowSpinning(bool allow_spinning);
+  ThreadingOptions& SetGlobalThreadAffinity(OrtThreadAffinityPolicy policy, const size_t* logical_processors = nullptr,
+                                            size_t num_logical_processors = 0);
+  ThreadingOptions& SetGlobalNumaNode(int numa_node);
+};
+
 struct CustomOpDomain : Base<OrtCustomOpDomain> {
   explicit CustomOpDomain(std::nullptr_t) {}
   explicit CustomOpDomain(const char* domain);
@@ -156,6 +176,8 @@ struct RunOptions : Base<OrtRunOptions> {
   RunOptions& SetTerminate();
   // unset the terminate flag so this RunOptions instance can be used in a new Session::Run call
   RunOptions& UnsetTerminate();
+  // shrink the memory arenas of the session after Session::Run calls made using this RunOptions instance
+  RunOptions& SetShrinkArenas(bool shrink);
 };
 
 struct SessionOptions : Base<OrtSessionOptions> {
@@ -167,10 +189,18 @@ struct SessionOptions : Base<OrtSessionOptions> {
 
   SessionOptions& SetIntraOpNumThreads(int intra_op_num_threads);
   SessionOptions& SetInterOpNumThreads(int inter_op_num_threads);
+  SessionOptions& SetThreadPoolSpinDuration(int spin_duration_us);
+  SessionOptions& SetThreadPoolAllowSpinning(bool allow_spinning);
+  SessionOptions& SetThreadPoolAffinity(OrtThreadAffinityPolicy policy, const size_t* logical_processors = nullptr,
+                                        size_t num_logical_processors = 0);
+  SessionOptions& SetThreadPoolNumaNode(int numa_node);
+  SessionOptions& DisablePerSessionThreads();
   SessionOptions& SetGraphOptimizationLevel(GraphOptimizationLevel graph_optimization_level);
 
   SessionOptions& EnableCpuMemArena();
   SessionOptions& DisableCpuMemArena();
+  SessionOptions& SetCpuMemArenaMaxBytes(size_t max_bytes);
+  SessionOptions& SetArenaShrinkPolicy(int interval_runs, int64_t idle_ms);
 
   SessionOptions& SetOptimizedModelFilePath(const ORTCHAR_T* optimized_model_file);
 
@@ -178,8 +208,15 @@ struct SessionOptions : Base<OrtSessionOptions> {
   SessionOptions& DisableProfiling();
 
   SessionOptions& EnableMemPattern();
+  SessionOptions& SetMemPatternShapeBuckets(const std::vector<int64_t>& dim_buckets, size_t max_patterns);
   SessionOptions& DisableMemPattern();
 
+  SessionOptions& EnablePrePackedWeightsSharing();
+  SessionOptions& DisablePrePackedWeightsSharing();
+
+  SessionOptions& EnableMappedModelLoading();
+  SessionOptions& DisableMappedModelLoading();
+
   SessionOptions& SetExecutionMode(ExecutionMode execution_mode);
 
   SessionOptions& SetLogId(const char* logid);
@@ -199,6 +236,12 @@ struct ModelMetadata : Base<OrtModelMetadata> {
   int64_t GetVersion() const;
 };
 
+// Input and output names resolved once by Session::CreateRunHandle for repeated Session::Run calls
+struct RunHandle : Base<OrtRunHandle> {
+  explicit RunHandle(std::nullptr_t) {}
+  explicit RunHandle(OrtRunHandle* p) : Base<OrtRunHandle>{p} {}
+};
+
 struct Session : Base<OrtSession> {
   explicit Session(std::nullptr_t) {}
   Session(Env& env, const ORTCHAR_T* model_path, const SessionOptions& options);
@@ -211,6 +254,15 @@ struct Session : Base<OrtSession> {
   void Run(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
            const char* const* output_names, Value* output_values, size_t output_count);
 
+  RunHandle CreateRunHandle(const char* const* input_names, size_t input_count,
+                            const char* const* output_names, size_t output_count) const;
+  // Run with a handle from CreateRunHandle that will allocate the output values
+  std::vector<Value> Run(const RunOptions& run_options, const RunHandle& run_handle, const Value* input_values, size_t input_count,
+                         size_t output_count);
+  // Run with a handle from CreateRunHandle for when there is a list of preallocated outputs
+  void Run(const RunOptions& run_options, const RunHandle& run_handle, const Value* input_values, size_t input_count,
+           Value* output_values, size_t output_count);
+
   size_t GetInputCount() const;
   size_t GetOutputCount() const;
   size_t GetOverridableInitializerCount() const;
@@ -220,6 +272,7 @@ struct Session : Base<OrtSession> {
   char* GetOverridableInitializerName(size_t index, OrtAllocator* allocator) const;
   char* EndProfiling(OrtAllocator* allocator) const;
   ModelMetadata GetModelMetadata() const;
+  OrtAllocatorStats GetAllocatorStats(const OrtMemoryInfo* mem_info) const;
 
   TypeInfo GetInputTypeInfo(size_t index) const;
   TypeInfo GetOutputTypeInfo(size_t index) const;
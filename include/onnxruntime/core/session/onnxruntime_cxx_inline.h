@@ -84,6 +84,10 @@ inline Env::Env(OrtLoggingLevel default_warning_level, const char* logid, OrtLog
   ThrowOnError(Global<void>::api_.CreateEnvWithCustomLogger(logging_function, logger_param, default_warning_level, logid, &p_));
 }
 
+inline Env::Env(const ThreadingOptions& tp_options, OrtLoggingLevel default_warning_level, _In_ const char* logid) {
+  ThrowOnError(Global<void>::api_.CreateEnvWithGlobalThreadPools(default_warning_level, logid, tp_options, &p_));
+}
+
 inline Env& Env::EnableTelemetryEvents() {
   ThrowOnError(Global<void>::api_.EnableTelemetryEvents(p_));
   return *this;
@@ -94,6 +98,42 @@ inline Env& Env::DisableTelemetryEvents() {
   return *this;
 }
 
+inline ThreadingOptions::ThreadingOptions() {
+  ThrowOnError(Global<void>::api_.CreateThreadingOptions(&p_));
+}
+
+inline ThreadingOptions& ThreadingOptions::SetGlobalIntraOpNumThreads(int intra_op_num_threads) {
+  ThrowOnError(Global<void>::api_.SetGlobalIntraOpNumThreads(p_, intra_op_num_threads));
+  return *this;
+}
+
+inline ThreadingOptions& ThreadingOptions::SetGlobalInterOpNumThreads(int inter_op_num_threads) {
+  ThrowOnError(Global<void>::api_.SetGlobalInterOpNumThreads(p_, inter_op_num_threads));
+  return *this;
+}
+
+inline ThreadingOptions& ThreadingOptions::SetGlobalSpinDuration(int spin_duration_us) {
+  ThrowOnError(Global<void>::api_.SetGlobalSpinDuration(p_, spin_duration_us));
+  return *this;
+}
+
+inline ThreadingOptions& ThreadingOptions::SetGlobalAllowSpinning(bool allow_spinning) {
+  ThrowOnError(Global<void>::api_.SetGlobalAllowSpinning(p_, allow_spinning ? 1 : 0));
+  return *this;
+}
+
+inline ThreadingOptions& ThreadingOptions::SetGlobalThreadAffinity(OrtThreadAffinityPolicy policy,
+                                                                   const size_t* logical_processors,
+                                                                   size_t num_logical_processors) {
+  ThrowOnError(Global<void>::api_.SetGlobalThreadAffinity(p_, policy, logical_processors, num_logical_processors));
+  return *this;
+}
+
+inline ThreadingOptions& ThreadingOptions::SetGlobalNumaNode(int numa_node) {
+  ThrowOnError(Global<void>::api_.SetGlobalNumaNode(p_, numa_node));
+  return *this;
+}
+
 inline CustomOpDomain::CustomOpDomain(const char* domain) {
   ThrowOnError(Global<void>::api_.CreateCustomOpDomain(domain, &p_));
 }
@@ -143,6 +183,11 @@ inline RunOptions& RunOptions::UnsetTerminate() {
   return *this;
 }
 
+inline RunOptions& RunOptions::SetShrinkArenas(bool shrink) {
+  ThrowOnError(Global<void>::api_.RunOptionsSetShrinkArenas(p_, shrink ? 1 : 0));
+  return *this;
+}
+
 inline SessionOptions::SessionOptions() {
   ThrowOnError(Global<void>::api_.CreateSessionOptions(&p_));
 }
@@ -163,6 +208,33 @@ inline SessionOptions& SessionOptions::SetInterOpNumThreads(int inter_op_num_thr
   return *this;
 }
 
+inline SessionOptions& SessionOptions::SetThreadPoolSpinDuration(int spin_duration_us) {
+  ThrowOnError(Global<void>::api_.SetThreadPoolSpinDuration(p_, spin_duration_us));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::SetThreadPoolAllowSpinning(bool allow_spinning) {
+  ThrowOnError(Global<void>::api_.SetThreadPoolAllowSpinning(p_, allow_spinning ? 1 : 0));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::SetThreadPoolAffinity(OrtThreadAffinityPolicy policy,
+                                                             const size_t* logical_processors,
+                                                             size_t num_logical_processors) {
+  ThrowOnError(Global<void>::api_.SetThreadPoolAffinity(p_, policy, logical_processors, num_logical_processors));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::SetThreadPoolNumaNode(int numa_node) {
+  ThrowOnError(Global<void>::api_.SetThreadPoolNumaNode(p_, numa_node));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::DisablePerSessionThreads() {
+  ThrowOnError(Global<void>::api_.DisablePerSessionThreads(p_));
+  return *this;
+}
+
 inline SessionOptions& SessionOptions::SetGraphOptimizationLevel(GraphOptimizationLevel graph_optimization_level) {
   ThrowOnError(Global<void>::api_.SetSessionGraphOptimizationLevel(p_, graph_optimization_level));
   return *this;
@@ -193,6 +265,26 @@ inline SessionOptions& SessionOptions::DisableMemPattern() {
   return *this;
 }
 
+inline SessionOptions& SessionOptions::EnablePrePackedWeightsSharing() {
+  ThrowOnError(Global<void>::api_.EnablePrePackedWeightsSharing(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::DisablePrePackedWeightsSharing() {
+  ThrowOnError(Global<void>::api_.DisablePrePackedWeightsSharing(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableMappedModelLoading() {
+  ThrowOnError(Global<void>::api_.EnableMappedModelLoading(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::DisableMappedModelLoading() {
+  ThrowOnError(Global<void>::api_.DisableMappedModelLoading(p_));
+  return *this;
+}
+
 inline SessionOptions& SessionOptions::EnableCpuMemArena() {
   ThrowOnError(Global<void>::api_.EnableCpuMemArena(p_));
   return *this;
@@ -203,6 +295,22 @@ inline SessionOptions& SessionOptions::DisableCpuMemArena() {
   return *this;
 }
 
+inline SessionOptions& SessionOptions::SetMemPatternShapeBuckets(const std::vector<int64_t>& dim_buckets,
+                                                                 size_t max_patterns) {
+  ThrowOnError(Global<void>::api_.SetMemPatternShapeBuckets(p_, dim_buckets.data(), dim_buckets.size(), max_patterns));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::SetCpuMemArenaMaxBytes(size_t max_bytes) {
+  ThrowOnError(Global<void>::api_.SetCpuMemArenaMaxBytes(p_, max_bytes));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::SetArenaShrinkPolicy(int interval_runs, int64_t idle_ms) {
+  ThrowOnError(Global<void>::api_.SetArenaShrinkPolicy(p_, interval_runs, idle_ms));
+  return *this;
+}
+
 inline SessionOptions& SessionOptions::SetExecutionMode(ExecutionMode execution_mode) {
   ThrowOnError(Global<void>::api_.SetSessionExecutionMode(p_, execution_mode));
   return *this;
@@ -242,6 +350,30 @@ inline void Session::Run(const RunOptions& run_options, const char* const* input
   ThrowOnError(Global<void>::api_.Run(p_, run_options, input_names, ort_input_values, input_count, output_names, output_count, ort_output_values));
 }
 
+inline RunHandle Session::CreateRunHandle(const char* const* input_names, size_t input_count,
+                                          const char* const* output_names, size_t output_count) const {
+  OrtRunHandle* out;
+  ThrowOnError(Global<void>::api_.CreateRunHandle(p_, input_names, input_count, output_names, output_count, &out));
+  return RunHandle{out};
+}
+
+inline std::vector<Value> Session::Run(const RunOptions& run_options, const RunHandle& run_handle, const Value* input_values, size_t input_count,
+                                       size_t output_count) {
+  std::vector<Ort::Value> output_values;
+  for (size_t i = 0; i < output_count; i++)
+    output_values.emplace_back(nullptr);
+  Run(run_options, run_handle, input_values, input_count, output_values.data(), output_count);
+  return output_values;
+}
+
+inline void Session::Run(const RunOptions& run_options, const RunHandle& run_handle, const Value* input_values, size_t input_count,
+                         Value* output_values, size_t output_count) {
+  static_assert(sizeof(Value) == sizeof(OrtValue*), "Value is really just an array of OrtValue* in memory, so we can reinterpret_cast safely");
+  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Value*>(input_values));
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(Global<void>::api_.RunWithHandle(p_, run_options, run_handle, ort_input_values, input_count, ort_output_values, output_count));
+}
+
 inline size_t Session::GetInputCount() const {
   size_t out;
   ThrowOnError(Global<void>::api_.SessionGetInputCount(p_, &out));
@@ -290,6 +422,12 @@ inline ModelMetadata Session::GetModelMetadata() const {
   return ModelMetadata{out};
 }
 
+inline OrtAllocatorStats Session::GetAllocatorStats(const OrtMemoryInfo* mem_info) const {
+  OrtAllocatorStats out;
+  ThrowOnError(Global<void>::api_.SessionGetAllocatorStats(p_, mem_info, &out));
+  return out;
+}
+
 inline char* ModelMetadata::GetProducerName(OrtAllocator* allocator) const {
   char* out;
   ThrowOnError(Global<void>::api_.ModelMetadataGetProducerName(p_, allocator, &out));
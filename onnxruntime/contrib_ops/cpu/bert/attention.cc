@@ -8,12 +8,17 @@
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/cpu/math/gemm_helper.h"
-#include "core/providers/cpu/math/softmax.h"
 #include "core/providers/cpu/tensor/transpose.h"
 #include "core/common/safeint.h"
 
 namespace onnxruntime {
 namespace contrib {
+
+// Tile sizes of the fused attention. A tile of scores is small enough to stay in the L1/L2 cache while it is
+// exponentiated and multiplied by V.
+static constexpr int kAttentionQueryBlockSize = 32;
+static constexpr int kAttentionKeyBlockSize = 128;
+
 // These ops are internal-only, so register outside of onnx
 #define REGISTER_KERNEL_TYPED(T)                                  \
   ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
@@ -177,127 +182,128 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
     });
   }
 
-  // STEP.2: scratch(B, N, S, S) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S, H -> B, N, H, S) + 1 x mask_index(B -> B, 1, 1, 1)
-  auto scratch_data = allocator->Alloc(
-      SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * sequence_length * element_size);
-  BufferUniquePtr scratch_buffer(scratch_data, BufferDeleter(allocator));
-
+  // STEP.2: out(B, S, N, H) = Softmax(1/sqrt(H) x Q(B, N, S, H) x K'(B, N, H, S) + mask) x V(B, N, S, H)
+  //
+  // The attention is fused per (batch, head, query block): the scores of a query block against one key block are
+  // computed, exponentiated and multiplied by V before moving to the next key block, so only a small tile of the
+  // score matrix is ever live. The softmax is computed online: each query row keeps its running maximum and sum,
+  // and the partial output is rescaled whenever the maximum grows. The output rows are accumulated in place in
+  // the (B, S, N, H) layout, so no transpose is needed afterwards.
+  //
+  // Keys at or beyond mask_index[b] would get a bias of -10000 and so an exponential of zero, thus the key blocks
+  // stop at the mask. If every key is masked, the bias is uniform and the softmax is the same as without a mask.
   {
-    auto scratch_broadcast_data = allocator->Alloc(SafeInt<size_t>(batch_size) * sequence_length * element_size);
-    BufferUniquePtr scratch_broadcast_buffer(scratch_broadcast_data, BufferDeleter(allocator));
-    memset(scratch_broadcast_data, 0, batch_size * sequence_length * element_size);
-    T* p_scratch_broadcast_current_data = reinterpret_cast<T*>(scratch_broadcast_data);
-    for (int b_i = 0; b_i < batch_size; b_i++) {
-      // TODO: mask_index can be used in softmax to save some calculation.
-      int mask = mask_index->template Data<int32_t>()[b_i];
-      for (int m_i = mask; m_i < sequence_length; m_i++) {
-        p_scratch_broadcast_current_data[m_i] = static_cast<T>(-10000.0);
-      }
-      p_scratch_broadcast_current_data += sequence_length;
-    }
-
-    const int loop_len = batch_size * num_heads_;
+    const int query_block_count = (sequence_length + kAttentionQueryBlockSize - 1) / kAttentionQueryBlockSize;
+    const int loop_len = batch_size * num_heads_ * query_block_count;
     const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
-
-    concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), loop_len, [&](int32_t i) {
-      const int batch_index = i / num_heads_;
-      // broadcast masks (B) -> (B.N.)S.S
-      const T* broadcast_data_src = reinterpret_cast<T*>(scratch_broadcast_data) + batch_index * sequence_length;
-      T* broadcast_data_dest = reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i;
-      for (int seq_index = 0; seq_index < sequence_length; seq_index++) {
-        memcpy(broadcast_data_dest, broadcast_data_src, sequence_length * sizeof(T));
-        broadcast_data_dest += sequence_length;
-      }
-
-      // gemm
-
-      //                   original           transposed            iteration
-      // A: Q              (BxNxSxH)          (B.N.)S x H            S x H
-      // B: K'             (BxNxSxH)          (B.N.)H x S            H x S
-      // C: scratch_data   (BxNxSxS)          (B.N.)S x S            S x S
-
-      math::Gemm<T, concurrency::ThreadPool>(
-          CblasNoTrans,
-          CblasTrans,
-          sequence_length,
-          sequence_length,
-          head_size,
-          alpha,
-          Q + sequence_length * head_size * i,
-          K + sequence_length * head_size * i,
-          1.0,
-          reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i,
-          nullptr);
-    });
-  }
-
-  // STEP.3: P(B, N, S, S) = Softmax(scratch)
-  {
-    const int N = batch_size * num_heads_ * sequence_length;
-    const int D = sequence_length;
-
-    concurrency::ThreadPool::TryBatchParallelFor(context->GetOperatorThreadPool(), N, [&](int j) {
-      float* x = reinterpret_cast<T*>(scratch_data) + j * D;
-      float* y = x;
-
-      // e^x is represented as infinity if x is large enough, like 100.f.
-      // Infinity divided by Infinity is a NAN. Thus, softmax gets a NAN if one or more item are large enough.
-      // a math transform as below is leveraged to get a stable softmax:
-      // e^xi/(e^x1 + ...e^xn) = e^(xi - max) / (e^(x1 - max) + ... + e^(xn - max))
-      float max = -std::numeric_limits<float>::infinity();
-      for (int i = 0; i < D; i++) {
-        if (max < x[i]) max = x[i];
-      }
-      for (int i = 0; i < D; i++) {
-        y[i] = expf(x[i] - max);
-      }
-
-      double sum = 0.0;
-
-      for (int i = 0; i < D; i++) {
-        sum += x[i];
-      }
-
-      if (sum == 0) {
-        for (int i = 0; i < D; i++) {
-          y[i] = 1.0f / (float)D;
+    const int32_t* mask_data = mask_index->template Data<int32_t>();
+    T* output_data = output->template MutableData<T>();
+
+    // The work items are partitioned evenly across the workers, so the scratch of each worker is allocated once up
+    // front: one tile of scores plus the running maximum and sum of each query row.
+    concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+    const int num_threads = thread_pool == nullptr ? 1 : thread_pool->NumThreads() + 1;
+    const int degree_of_parallelism = std::min(num_threads, loop_len);
+    const int tile_size = kAttentionQueryBlockSize * (kAttentionKeyBlockSize + 2);
+    auto tile_data = allocator->Alloc(SafeInt<size_t>(tile_size) * degree_of_parallelism * element_size);
+    BufferUniquePtr tile_buffer(tile_data, BufferDeleter(allocator));
+
+    concurrency::ThreadPool::TryParallelFor(thread_pool, degree_of_parallelism, [&](int32_t worker) {
+      const int work_per_worker = loop_len / degree_of_parallelism;
+      const int work_extra = loop_len % degree_of_parallelism;
+      const int work_start = worker * work_per_worker + std::min(worker, work_extra);
+      const int work_end = work_start + work_per_worker + (worker < work_extra ? 1 : 0);
+
+      T* scores = reinterpret_cast<T*>(tile_data) + worker * tile_size;
+      T* row_max = scores + kAttentionQueryBlockSize * kAttentionKeyBlockSize;
+      T* row_sum = row_max + kAttentionQueryBlockSize;
+
+      for (int i = work_start; i < work_end; i++) {
+        const int batch_head_index = i / query_block_count;
+        const int batch_index = batch_head_index / num_heads_;
+        const int head_index = batch_head_index % num_heads_;
+        const int query_start = (i % query_block_count) * kAttentionQueryBlockSize;
+        const int query_count = std::min(kAttentionQueryBlockSize, sequence_length - query_start);
+
+        const int mask = mask_data[batch_index];
+        const int key_length = (mask > 0 && mask < sequence_length) ? mask : sequence_length;
+
+        const T* q = Q + (batch_head_index * sequence_length + query_start) * head_size;
+        const T* k = K + batch_head_index * sequence_length * head_size;
+        const T* v = V + batch_head_index * sequence_length * head_size;
+        T* out = output_data + ((batch_index * sequence_length + query_start) * num_heads_ + head_index) * head_size;
+
+        for (int key_start = 0; key_start < key_length; key_start += kAttentionKeyBlockSize) {
+          const int key_count = std::min(kAttentionKeyBlockSize, key_length - key_start);
+
+          //                   original           transposed            iteration
+          // A: Q              (BxNxSxH)          (B.N.)S x H            q x H
+          // B: K'             (BxNxSxH)          (B.N.)H x S            H x k
+          // C: scores                                                   q x k
+
+          math::GemmEx<float, concurrency::ThreadPool>(CblasNoTrans,
+                                                       CblasTrans,
+                                                       query_count,
+                                                       key_count,
+                                                       head_size,
+                                                       alpha,
+                                                       q,
+                                                       head_size,
+                                                       k + key_start * head_size,
+                                                       head_size,
+                                                       0.0f,
+                                                       scores,
+                                                       key_count,
+                                                       nullptr);
+
+          for (int r = 0; r < query_count; r++) {
+            EigenVectorArrayMap<T> row(scores + r * key_count, key_count);
+            const T block_max = row.maxCoeff();
+
+            if (key_start == 0) {
+              row_max[r] = block_max;
+              row = (row - block_max).exp();
+              row_sum[r] = row.sum();
+            } else {
+              const T new_max = std::max(row_max[r], block_max);
+              const T correction = std::exp(row_max[r] - new_max);
+              row_max[r] = new_max;
+              row = (row - new_max).exp();
+              row_sum[r] = row_sum[r] * correction + row.sum();
+              if (correction != 1.0f) {
+                EigenVectorArrayMap<T>(out + r * hidden_size, head_size) *= correction;
+              }
+            }
+          }
+
+          //                   original           transposed            iteration
+          // A: scores                                                   q x k
+          // B: V              (BxNxSxH)          (B.N.)S x H            k x H
+          // C: out            (BxSxNxH)          (B.)S x (N.)H          q x H
+
+          math::GemmEx<float, concurrency::ThreadPool>(CblasNoTrans,
+                                                       CblasNoTrans,
+                                                       query_count,
+                                                       head_size,
+                                                       key_count,
+                                                       1.0f,
+                                                       scores,
+                                                       key_count,
+                                                       v + key_start * head_size,
+                                                       head_size,
+                                                       key_start == 0 ? 0.0f : 1.0f,
+                                                       out,
+                                                       hidden_size,
+                                                       nullptr);
         }
-      } else {
-        for (int i = 0; i < D; i++) {
-          y[i] = x[i] / (float)sum;
+
+        for (int r = 0; r < query_count; r++) {
+          EigenVectorArrayMap<T>(out + r * hidden_size, head_size) *= 1.0f / row_sum[r];
         }
       }
     });
   }
 
-  // STEP.4: out_tmp(B, N, S, H) = P(B, N, S, S) x V(B, N, S, H)
-  auto out_tmp_data = allocator->Alloc(
-      SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * head_size * element_size);
-  BufferUniquePtr out_tmp_buffer(out_tmp_data, BufferDeleter(allocator));
-
-  concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), batch_size * num_heads_, [&](int i) {
-    T* current_tmp_data = reinterpret_cast<T*>(out_tmp_data) + sequence_length * head_size * i;
-    math::MatMul<T>(
-        sequence_length,
-        head_size,
-        sequence_length,
-        reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i,
-        V + sequence_length * head_size * i,
-        current_tmp_data,
-        nullptr);
-
-    // transpose: out(B, S, N, H) = transpose out_tmp(B, N, S, H)
-    const int batch_index = i / num_heads_;
-    const int head_index = i % num_heads_;
-    T* src = current_tmp_data;
-    T* dest = output->template MutableData<T>() + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
-    for (int j = 0; j < sequence_length; j++) {
-      memcpy(dest, src, head_size * sizeof(T));
-      src += head_size;
-      dest += hidden_size;
-    }
-  });
-
   return Status::OK();
 }
 
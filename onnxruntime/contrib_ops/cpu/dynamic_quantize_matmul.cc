@@ -0,0 +1,185 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/dynamic_quantize_matmul.h"
+#include "core/common/safeint.h"
+#include "core/providers/common.h"
+#include "core/providers/cpu/math/matmul_integer.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/cpu/tensor/dynamicquantizelinear.h"
+#include "core/util/qmath.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    DynamicQuantizeMatMul,
+    kMSDomain,
+    1,
+    uint8_t,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>()),
+    DynamicQuantizeMatMul<uint8_t>);
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    DynamicQuantizeMatMul,
+    kMSDomain,
+    1,
+    int8_t,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<int8_t>()),
+    DynamicQuantizeMatMul<int8_t>);
+
+namespace {
+void DynamicQuantizeGemm(int M, int N, int K, const uint8_t* a_data, uint8_t a_offset,
+                         const uint8_t* b_data, uint8_t b_offset, float* y_data, const float* multipliers,
+                         bool per_column_scale, int32_t* accumulator_data, concurrency::ThreadPool* thread_pool) {
+  QGemmu8u8_f32(M, N, K, a_data, K, a_offset, b_data, N, b_offset, y_data, N, multipliers, per_column_scale,
+                accumulator_data, thread_pool);
+}
+
+void DynamicQuantizeGemm(int M, int N, int K, const uint8_t* a_data, uint8_t a_offset,
+                         const int8_t* b_data, int8_t b_offset, float* y_data, const float* multipliers,
+                         bool per_column_scale, int32_t* accumulator_data, concurrency::ThreadPool* thread_pool) {
+  QGemmu8s8_f32(M, N, K, a_data, K, a_offset, b_data, N, b_offset, y_data, N, multipliers, per_column_scale,
+                accumulator_data, thread_pool);
+}
+}  // namespace
+
+template <typename T>
+Status DynamicQuantizeMatMul<T>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                         /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // Pack a constant matrix B once so that each call to Compute skips the
+  // packing that the QGEMM would otherwise repeat for every run.
+  if (input_idx == 1) {
+    size_t packed_b_size;
+    is_packed = QGemmPackBTensor(alloc, tensor, packed_b_, packed_b_size, b_shape_);
+    if (is_packed && prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(packed_b_));
+      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    }
+  }
+
+  return Status::OK();
+}
+
+template <typename T>
+Status DynamicQuantizeMatMul<T>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                           int input_idx,
+                                                           /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+template <typename T>
+Status DynamicQuantizeMatMul<T>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  auto a = ctx->Input<Tensor>(0);
+  // the original matrix B is released once it has been packed
+  auto b = packed_b_ ? nullptr : ctx->Input<Tensor>(1);
+  auto b_scale = ctx->Input<Tensor>(2);
+  auto b_zero_point = ctx->Input<Tensor>(3);
+  ORT_ENFORCE(a != nullptr && (packed_b_ || b != nullptr) && b_scale != nullptr);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), packed_b_ ? b_shape_ : b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  const auto M = static_cast<int>(helper.M());
+  const auto N = static_cast<int>(helper.N());
+  const auto K = static_cast<int>(helper.K());
+
+  if (y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  // validate the scale and zero point of B
+  const bool per_column_scale = !IsScalarOr1ElementVector(b_scale);
+  ORT_ENFORCE(!per_column_scale || (b_scale->Shape().NumDimensions() == 1 && b_scale->Shape()[0] == N),
+              "DynamicQuantizeMatMul : b_scale must be a scalar or 1D tensor of size N");
+
+  T b_offset = 0;
+  if (b_zero_point != nullptr) {
+    ORT_ENFORCE(IsScalarOr1ElementVector(b_zero_point),
+                "DynamicQuantizeMatMul : b_zero_point must be a scalar or 1D tensor of size 1");
+    b_offset = *b_zero_point->template Data<T>();
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+
+  // quantize A with the parameters that DynamicQuantizeLinear would have computed
+  const auto* a_data = a->template Data<float>();
+  const auto a_size = a->Shape().Size();
+
+  float a_scale;
+  uint8_t a_offset;
+  GetQuantizationParameter(a_data, a_size, a_scale, a_offset);
+
+  auto* a_quant_data = static_cast<uint8_t*>(allocator->Alloc(SafeInt<size_t>(a_size) * sizeof(uint8_t)));
+  BufferUniquePtr a_quant_buffer(a_quant_data, BufferDeleter(allocator));
+
+  MlasQuantizeLinear(a_data, a_quant_data, static_cast<size_t>(a_size), a_scale, a_offset);
+
+  // the output is dequantized with the product of the A and B scales
+  const auto* b_scale_data = b_scale->template Data<float>();
+  std::vector<float> multipliers(per_column_scale ? N : 1);
+  for (size_t i = 0; i < multipliers.size(); i++) {
+    multipliers[i] = a_scale * b_scale_data[i];
+  }
+
+  auto* accumulator_data = static_cast<int32_t*>(allocator->Alloc(SafeInt<size_t>(M) * N * sizeof(int32_t)));
+  BufferUniquePtr accumulator_buffer(accumulator_data, BufferDeleter(allocator));
+
+  if (packed_b_) {
+    // The packed matrix B is 2D, so the right offsets are always zero.
+    for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+      QGemmu8x8_f32(M, N, K,
+                    a_quant_data + helper.LeftOffsets()[i],
+                    K,
+                    a_offset,
+                    packed_b_.get(),
+                    static_cast<uint8_t>(b_offset),
+                    std::is_signed<T>::value,
+                    y->template MutableData<float>() + helper.OutputOffsets()[i],
+                    N,
+                    multipliers.data(),
+                    per_column_scale,
+                    accumulator_data,
+                    thread_pool);
+    }
+    return Status::OK();
+  }
+
+  for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+    DynamicQuantizeGemm(M, N, K,
+                        a_quant_data + helper.LeftOffsets()[i],
+                        a_offset,
+                        b->template Data<T>() + helper.RightOffsets()[i],
+                        b_offset,
+                        y->template MutableData<float>() + helper.OutputOffsets()[i],
+                        multipliers.data(),
+                        per_column_scale,
+                        accumulator_data,
+                        thread_pool);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
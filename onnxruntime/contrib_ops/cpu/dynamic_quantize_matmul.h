@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/prepacked_weights.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Fused DynamicQuantizeLinear -> MatMulInteger -> Cast -> Mul. The float input A is quantized to uint8 with the
+// same parameters as DynamicQuantizeLinear and the int32 accumulators are dequantized directly to the float output.
+template <typename T>
+class DynamicQuantizeMatMul final : public OpKernel {
+ public:
+  DynamicQuantizeMatMul(const OpKernelInfo& info) : OpKernel(info) {
+  }
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // Matrix B is packed once by PrePack when it is a constant 2D initializer.
+  TensorShape b_shape_;
+  BufferUniquePtr packed_b_;
+};
+}  // namespace contrib
+}  // namespace onnxruntime
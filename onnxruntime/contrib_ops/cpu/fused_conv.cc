@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/nn/conv.h"
+#include "core/providers/cpu/nn/conv_transpose.h"
 #include "contrib_ops/cpu/fused_activation.h"
 
 namespace onnxruntime {
@@ -22,5 +23,20 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
         .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     FusedConvFloat);
 
+class FusedConvTransposeFloat final : public ConvTranspose<float> {
+ public:
+  FusedConvTransposeFloat(const OpKernelInfo& info) : ConvTranspose<float>(info) {
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
+  }
+};
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    FusedConvTranspose,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedConvTransposeFloat);
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #include "nchwc_ops.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -67,6 +68,23 @@ ONNX_CPU_OPERATOR_TYPED_NCHWC_KERNEL(
         .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     NchwcAveragePool);
 
+ONNX_CPU_OPERATOR_TYPED_NCHWC_KERNEL(
+    Upsample,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NchwcUpsample);
+
+ONNX_CPU_OPERATOR_TYPED_NCHWC_KERNEL(
+    ScaleChannels,
+    1,
+    float,
+    KernelDefBuilder()
+        .MayInplace(0, 0)
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NchwcScaleChannels);
+
 Status ReorderInput::Compute(OpKernelContext* context) const {
   const auto* X = context->Input<Tensor>(0);
   const auto& X_shape = X->Shape();
@@ -211,5 +229,152 @@ Status NchwcAveragePool::Compute(OpKernelContext* context) const {
                                                                          : MlasAveragePoolingExcludePad);
 }
 
+std::vector<float> NchwcUpsample::ComputeInterpolation(int64_t input_length,
+                                                       int64_t output_length,
+                                                       int64_t scale) const {
+  // These formulas match the coordinate transformations of the CPU Resize
+  // kernel so that the transformed graph produces equivalent results.
+  std::vector<float> interpolation;
+  interpolation.resize(static_cast<size_t>(output_length));
+
+  const float scale_value = static_cast<float>(scale);
+  const float length_resized = static_cast<float>(output_length);
+  const float length_original = static_cast<float>(input_length);
+
+  for (int64_t i = 0; i < output_length; i++) {
+    const float x_resized = static_cast<float>(i);
+    float x_original;
+    switch (transformation_mode_) {
+      case TransformationMode::HALF_PIXEL:
+        x_original = ((x_resized + 0.5f) / scale_value) - 0.5f;
+        break;
+      case TransformationMode::PYTORCH_HALF_PIXEL:
+        x_original = length_resized > 1 ? (x_resized + 0.5f) / scale_value - 0.5f : 0.0f;
+        break;
+      case TransformationMode::ALIGN_CORNERS:
+        x_original = length_resized == 1 ? 0 : x_resized * (length_original - 1) / (length_resized - 1);
+        break;
+      default:
+        x_original = x_resized / scale_value;
+        break;
+    }
+    interpolation[static_cast<size_t>(i)] = x_original;
+  }
+
+  return interpolation;
+}
+
+Status NchwcUpsample::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto& X_shape = X->Shape();
+  ORT_ENFORCE(X_shape.NumDimensions() == 4);
+  ORT_ENFORCE((X_shape[1] % MlasNchwcGetBlockSize()) == 0);
+
+  const int64_t batch_count = X_shape[0];
+  const int64_t channels = X_shape[1];
+  const int64_t input_h = X_shape[2];
+  const int64_t input_w = X_shape[3];
+  const int64_t output_h = input_h * scales_[2];
+  const int64_t output_w = input_w * scales_[3];
+
+  auto* Y = context->Output(0, {batch_count, channels, output_h, output_w});
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const auto* x_data = X->template Data<float>();
+  auto* y_data = Y->template MutableData<float>();
+
+  const int64_t nchwc_block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  const int64_t total_blocks = batch_count * (channels / nchwc_block_size);
+  const int64_t input_block_size = input_h * input_w * nchwc_block_size;
+  const int64_t output_row_size = output_w * nchwc_block_size;
+  const int64_t output_block_size = output_h * output_row_size;
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  if (nearest_mode_) {
+    // Each unit of work replicates a single channel block.
+    const concurrency::TensorOpCost cost{static_cast<double>(input_block_size * sizeof(float)),
+                                         static_cast<double>(output_block_size * sizeof(float)),
+                                         static_cast<double>(output_block_size)};
+
+    concurrency::ThreadPool::TryParallelFor(thread_pool, total_blocks, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      const int64_t input_shape[] = {1, (last - first) * nchwc_block_size, input_h, input_w};
+      MlasNchwcUpsampleNearest(input_shape,
+                               scales_.data() + 2,
+                               x_data + first * input_block_size,
+                               y_data + first * output_block_size);
+    });
+
+  } else {
+    const auto interpolation_h = ComputeInterpolation(input_h, output_h, scales_[2]);
+    const auto interpolation_w = ComputeInterpolation(input_w, output_w, scales_[3]);
+
+    // Each unit of work produces a single output row of a channel block.
+    const concurrency::TensorOpCost cost{static_cast<double>(4 * output_row_size * sizeof(float)),
+                                         static_cast<double>(output_row_size * sizeof(float)),
+                                         static_cast<double>(8 * output_row_size)};
+
+    concurrency::ThreadPool::TryParallelFor(thread_pool, total_blocks * output_h, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t work_index = first; work_index < last; work_index++) {
+        const int64_t block_index = work_index / output_h;
+        const int64_t output_y = work_index % output_h;
+        MlasNchwcUpsampleLinear(static_cast<size_t>(input_h),
+                                static_cast<size_t>(input_w),
+                                static_cast<size_t>(output_w),
+                                interpolation_h[static_cast<size_t>(output_y)],
+                                interpolation_w.data(),
+                                x_data + block_index * input_block_size,
+                                y_data + work_index * output_row_size);
+      }
+    });
+  }
+
+  return Status::OK();
+}
+
+Status NchwcScaleChannels::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto* Scale = context->Input<Tensor>(1);
+  const auto& X_shape = X->Shape();
+  const auto& Scale_shape = Scale->Shape();
+  ORT_ENFORCE(X_shape.NumDimensions() == 4);
+  ORT_ENFORCE((X_shape[1] % MlasNchwcGetBlockSize()) == 0);
+  ORT_RETURN_IF_NOT(Scale_shape.NumDimensions() == 4 && Scale_shape[0] == X_shape[0] &&
+                        Scale_shape[1] == X_shape[1] && Scale_shape[2] == 1 && Scale_shape[3] == 1,
+                    "scale shape must be [N,C,1,1] matching the input");
+
+  auto* Y = context->Output(0, X_shape);
+  if (X_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  const auto* x_data = X->template Data<float>();
+  const auto* scale_data = Scale->template Data<float>();
+  auto* y_data = Y->template MutableData<float>();
+
+  const int64_t nchwc_block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  const int64_t total_blocks = X_shape[0] * (X_shape[1] / nchwc_block_size);
+  const int64_t spatial_size = X_shape[2] * X_shape[3];
+  const int64_t block_size = spatial_size * nchwc_block_size;
+
+  // Each unit of work scales a single channel block.
+  const concurrency::TensorOpCost cost{static_cast<double>(block_size * sizeof(float)),
+                                       static_cast<double>(block_size * sizeof(float)),
+                                       static_cast<double>(block_size)};
+
+  concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), total_blocks, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (std::ptrdiff_t block_index = first; block_index < last; block_index++) {
+      MlasNchwcScaleChannels(static_cast<size_t>(spatial_size),
+                             x_data + block_index * block_size,
+                             scale_data + block_index * nchwc_block_size,
+                             y_data + block_index * block_size);
+    }
+  });
+
+  return Status::OK();
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -75,5 +75,58 @@ class NchwcAveragePool : public OpKernel, public NchwcPoolBase {
   Status Compute(OpKernelContext* context) const override;
 };
 
+class NchwcUpsample : public OpKernel {
+ public:
+  NchwcUpsample(const OpKernelInfo& info) : OpKernel(info) {
+    ORT_ENFORCE(info.GetAttrs<int64_t>("scales", scales_).IsOK());
+    ORT_ENFORCE(scales_.size() == 4);
+    // Batch and channel scaling is not supported.
+    ORT_ENFORCE(scales_[0] == 1 && scales_[1] == 1 && scales_[2] >= 1 && scales_[3] >= 1);
+
+    std::string mode;
+    ORT_ENFORCE(info.GetAttr<std::string>("mode", &mode).IsOK());
+    nearest_mode_ = (mode == "nearest");
+    ORT_ENFORCE(nearest_mode_ || mode == "linear", "unsupported mode: " + mode);
+
+    std::string transformation_mode;
+    ORT_ENFORCE(info.GetAttr<std::string>("coordinate_transformation_mode", &transformation_mode).IsOK());
+    if (transformation_mode == "asymmetric") {
+      transformation_mode_ = TransformationMode::ASYMMETRIC;
+    } else if (transformation_mode == "half_pixel") {
+      transformation_mode_ = TransformationMode::HALF_PIXEL;
+    } else if (transformation_mode == "pytorch_half_pixel") {
+      transformation_mode_ = TransformationMode::PYTORCH_HALF_PIXEL;
+    } else if (transformation_mode == "align_corners") {
+      transformation_mode_ = TransformationMode::ALIGN_CORNERS;
+    } else {
+      ORT_THROW("unsupported coordinate_transformation_mode: " + transformation_mode);
+    }
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  enum class TransformationMode {
+    ASYMMETRIC,
+    HALF_PIXEL,
+    PYTORCH_HALF_PIXEL,
+    ALIGN_CORNERS,
+  };
+
+  std::vector<float> ComputeInterpolation(int64_t input_length, int64_t output_length, int64_t scale) const;
+
+  std::vector<int64_t> scales_;
+  bool nearest_mode_;
+  TransformationMode transformation_mode_;
+};
+
+class NchwcScaleChannels : public OpKernel {
+ public:
+  NchwcScaleChannels(const OpKernelInfo& info) : OpKernel(info) {
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -3,8 +3,22 @@
 
 #include "core/platform/threadpool.h"
 #include "core/common/common.h"
+#include "core/platform/env.h"
+#include "core/platform/ort_mutex.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#if defined(_M_AMD64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(_M_ARM) || defined(_M_ARM64)
+#include <intrin.h>
+#endif
 
 #if defined(__GNUC__)
 #pragma GCC diagnostic push
@@ -25,14 +39,327 @@ using Eigen::Barrier;
 namespace onnxruntime {
 
 namespace concurrency {
+
+namespace {
+// Cost model constants, matching Eigen's TensorCostModel.
+// Each load/store is assumed to cost a cache line fetch (11 cycles) amortized over 64 bytes.
+constexpr double kLoadCycles = 1.0 / 64 * 11;
+constexpr double kStoreCycles = 1.0 / 64 * 11;
+// Cost of starting parallel execution, and of each additional thread.
+constexpr double kStartupCycles = 100000;
+constexpr double kPerThreadCycles = 100000;
+// Target amount of work for one block.
+constexpr double kTaskSize = 40000;
+// Limit on the number of blocks per thread, to bound the scheduling overhead.
+constexpr std::ptrdiff_t kMaxOvershardingFactor = 4;
+
+double TotalCost(const TensorOpCost& cost) {
+  return cost.bytes_loaded * kLoadCycles + cost.bytes_stored * kStoreCycles + cost.compute_cycles;
+}
+
+std::ptrdiff_t DivUp(std::ptrdiff_t x, std::ptrdiff_t y) {
+  return (x + y - 1) / y;
+}
+
+// Number of threads, including the calling thread, that the loop is worth spreading over.
+int NumThreadsForCost(std::ptrdiff_t total, double cost_per_unit, int max_threads) {
+  const double threads = (static_cast<double>(total) * cost_per_unit - kStartupCycles) / kPerThreadCycles + 0.9;
+  if (threads >= max_threads) {
+    return max_threads;
+  }
+  return std::max(1, static_cast<int>(threads));
+}
+
+// Block size that gives roughly kTaskSize cycles of work per block, adjusted so that the blocks spread evenly
+// over num_threads. Follows Eigen's ThreadPoolDevice::CalculateParallelForBlock.
+std::ptrdiff_t BlockSizeForCost(std::ptrdiff_t total, double cost_per_unit, int num_threads) {
+  double block_size_f = cost_per_unit > 0 ? kTaskSize / cost_per_unit : static_cast<double>(total);
+  block_size_f = std::min(block_size_f, static_cast<double>(total));
+
+  std::ptrdiff_t block_size = std::min(total, std::max(DivUp(total, kMaxOvershardingFactor * num_threads),
+                                                       static_cast<std::ptrdiff_t>(block_size_f)));
+  const std::ptrdiff_t max_block_size = std::min(total, 2 * block_size);
+
+  // Look for a coarser block size that keeps all threads busy in the last round of blocks.
+  std::ptrdiff_t block_count = DivUp(total, block_size);
+  double max_efficiency = static_cast<double>(block_count) / (DivUp(block_count, num_threads) * num_threads);
+  for (std::ptrdiff_t prev_block_count = block_count; max_efficiency < 1.0 && prev_block_count > 1;) {
+    const std::ptrdiff_t coarser_block_size = DivUp(total, prev_block_count - 1);
+    if (coarser_block_size > max_block_size) {
+      break;
+    }
+    const std::ptrdiff_t coarser_block_count = DivUp(total, coarser_block_size);
+    prev_block_count = coarser_block_count;
+    const double coarser_efficiency =
+        static_cast<double>(coarser_block_count) / (DivUp(coarser_block_count, num_threads) * num_threads);
+    if (coarser_efficiency + 0.01 >= max_efficiency) {
+      block_size = coarser_block_size;
+      max_efficiency = std::max(max_efficiency, coarser_efficiency);
+    }
+  }
+
+  return block_size;
+}
+
+// Hints to the CPU that the calling thread is in a spin-wait loop.
+inline void SpinPause() {
+#if defined(_M_AMD64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+  _mm_pause();
+#elif defined(_M_ARM) || defined(_M_ARM64)
+  __yield();
+#elif defined(__arm__) || defined(__aarch64__)
+  asm volatile("yield");
+#else
+  std::this_thread::yield();
+#endif
+}
+
+// State shared by the threads running one ParallelFor. The calling thread works on the blocks along with the
+// helpers and then waits only for the blocks that helpers are still processing: a helper that starts after all
+// blocks have been claimed returns without running anything. A loop started from a pool thread, e.g. a GEMM
+// inside a parallel section, therefore never waits for helpers queued behind the busy threads of the same pool.
+// As a late helper may start after ParallelFor has returned, the state is reference counted. A helper task only
+// captures a pointer to it, which keeps the task small enough for std::function's inline storage.
+// The states are reused through a per-thread cache (see AcquireParallelLoop), so starting a loop doesn't allocate.
+class ParallelLoop {
+ public:
+  // A new loop is only referenced by its owner: the thread's cache, or the caller for a loop that isn't cached.
+  ParallelLoop() = default;
+
+  // Prepares the loop for a new ParallelFor. Only called by the owner while it holds the only reference, so no
+  // other thread can see the loop until its helpers are scheduled.
+  void Start(std::ptrdiff_t total, std::ptrdiff_t block_size, int num_helpers,
+             const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn) {
+    total_ = total;
+    block_size_ = block_size;
+    block_count_ = DivUp(total, block_size);
+    fn_ = &fn;
+    next_.store(0, std::memory_order_relaxed);
+    blocks_done_.store(0, std::memory_order_relaxed);
+    failed_.store(false, std::memory_order_relaxed);
+    done_ = false;
+    error_ = nullptr;
+    ref_count_.fetch_add(num_helpers + 1, std::memory_order_relaxed);
+  }
+
+  // True once every helper and the calling thread of the last ParallelFor dropped their references.
+  bool IsIdle() const { return ref_count_.load(std::memory_order_acquire) == 1; }
+
+  // Process blocks until none are left. fn_ is only used while a block is claimed, and the calling thread
+  // doesn't return before every claimed block is done, so it is valid whenever it is used.
+  // An exception thrown by fn_ is kept for the calling thread to rethrow, and the remaining blocks are skipped.
+  void Run() noexcept {
+    for (;;) {
+      const std::ptrdiff_t first = next_.fetch_add(block_size_, std::memory_order_relaxed);
+      if (first >= total_) {
+        break;
+      }
+      if (!failed_.load(std::memory_order_relaxed)) {
+        try {
+          (*fn_)(first, std::min(total_, first + block_size_));
+        } catch (...) {
+          std::lock_guard<OrtMutex> lock(mutex_);
+          if (!error_) {
+            error_ = std::current_exception();
+          }
+          failed_.store(true, std::memory_order_relaxed);
+        }
+      }
+      if (blocks_done_.fetch_add(1, std::memory_order_acq_rel) + 1 == block_count_) {
+        std::lock_guard<OrtMutex> lock(mutex_);
+        done_ = true;
+        done_cv_.notify_one();
+      }
+    }
+  }
+
+  // Spin for up to spin_duration_us before blocking, as waking up a blocked thread is expensive compared
+  // to the typical wait for the last blocks of a loop. Each poll relaxes the CPU so that a hyperthread sibling
+  // keeps running, and the clock is only read every kSpinsPerClockRead polls.
+  void WaitForBlocks(int spin_duration_us) {
+    if (spin_duration_us > 0) {
+      constexpr int kSpinsPerClockRead = 64;
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(spin_duration_us);
+      for (int spins = 1; blocks_done_.load(std::memory_order_acquire) < block_count_; spins++) {
+        SpinPause();
+        if (spins % kSpinsPerClockRead == 0 && std::chrono::steady_clock::now() >= deadline) {
+          break;
+        }
+      }
+    }
+    if (blocks_done_.load(std::memory_order_acquire) < block_count_) {
+      std::unique_lock<OrtMutex> lock(mutex_);
+      done_cv_.wait(lock, [this]() { return done_; });
+    }
+  }
+
+  // The first exception thrown by fn_. Only valid once every block is done.
+  std::exception_ptr Error() {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    return error_;
+  }
+
+  // Drops the reference held by the owner, the calling thread or a helper. The last one frees the loop.
+  void Release() {
+    if (ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+ private:
+  std::ptrdiff_t total_ = 0;
+  std::ptrdiff_t block_size_ = 1;
+  std::ptrdiff_t block_count_ = 0;
+  const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>* fn_ = nullptr;
+  std::atomic<std::ptrdiff_t> next_{0};
+  std::atomic<std::ptrdiff_t> blocks_done_{0};
+  std::atomic<int> ref_count_{1};
+  std::atomic<bool> failed_{false};
+  OrtMutex mutex_;
+  OrtCondVar done_cv_;
+  bool done_ = false;
+  std::exception_ptr error_;
+};
+
+// Loops owned by the calling thread. A loop stays busy while a late helper of an earlier ParallelFor hasn't run
+// yet, or while an enclosing ParallelFor on this thread is running, so a few of them are kept.
+class ParallelLoopCache {
+ public:
+  ParallelLoopCache() = default;
+  ParallelLoopCache(const ParallelLoopCache&) = delete;
+  ParallelLoopCache& operator=(const ParallelLoopCache&) = delete;
+
+  // A helper may still hold a reference when the thread exits, in which case it frees the loop.
+  ~ParallelLoopCache() {
+    for (ParallelLoop* loop : loops_) {
+      loop->Release();
+    }
+  }
+
+  // Returns an idle loop holding only the owner's reference. Past kMaxCachedLoops busy loops, a new loop is
+  // returned that isn't cached, and the caller passes the owner's reference on to the loop's last user.
+  ParallelLoop* Acquire(bool& cached) {
+    for (ParallelLoop* loop : loops_) {
+      if (loop->IsIdle()) {
+        cached = true;
+        return loop;
+      }
+    }
+    auto* loop = new ParallelLoop();
+    cached = loops_.size() < kMaxCachedLoops;
+    if (cached) {
+      loops_.push_back(loop);
+    }
+    return loop;
+  }
+
+ private:
+  static constexpr size_t kMaxCachedLoops = 8;
+  std::vector<ParallelLoop*> loops_;
+};
+
+ParallelLoop* AcquireParallelLoop(bool& cached) {
+  static thread_local ParallelLoopCache cache;
+  return cache.Acquire(cached);
+}
+
+// Eigen thread environment that restricts each thread of the pool to a set of logical processors.
+struct AffinityThreadEnvironment {
+  using Task = Eigen::StlThreadEnvironment::Task;
+  using EnvThread = Eigen::StlThreadEnvironment::EnvThread;
+
+  explicit AffinityThreadEnvironment(const std::vector<std::vector<size_t>>& affinity) : affinity_(affinity) {}
+
+  // Called once per thread, in order, when the pool is created.
+  EnvThread* CreateThread(std::function<void()> f) {
+    if (affinity_.empty()) {
+      return new EnvThread(std::move(f));
+    }
+
+    const std::vector<size_t>& processors = affinity_[next_thread_++ % affinity_.size()];
+    return new EnvThread([processors, f]() {
+      // pinning is best effort, the thread runs unpinned if the platform doesn't support it
+      Env::Default().SetCurrentThreadAffinity(processors);
+      f();
+    });
+  }
+
+  Task CreateTask(std::function<void()> f) { return Task{std::move(f)}; }
+  void ExecuteTask(const Task& t) { t.f(); }
+
+ private:
+  std::vector<std::vector<size_t>> affinity_;
+  size_t next_thread_ = 0;
+};
+}  // namespace
+
 //
 // ThreadPool
 //
-ThreadPool::ThreadPool(const std::string&, int num_threads) : impl_(num_threads) {}
+ThreadPool::ThreadPool(const std::string&, int num_threads, const ThreadPoolOptions& options)
+    : spin_duration_us_(options.spin_duration_us),
+      impl_(new Eigen::ThreadPoolTempl<AffinityThreadEnvironment>(num_threads, options.allow_spinning,
+                                                                   AffinityThreadEnvironment(options.affinity))) {}
 
-void ThreadPool::Schedule(std::function<void()> fn) { impl_.Schedule(fn); }
+ThreadPool::~ThreadPool() = default;
 
-void ThreadPool::ParallelFor(int32_t total, std::function<void(int32_t)> fn) {
+void ThreadPool::Schedule(std::function<void()> fn) { impl_->Schedule(std::move(fn)); }
+
+void ThreadPool::RunInParallel(std::ptrdiff_t total, std::ptrdiff_t block_size, int num_helpers,
+                               const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn) {
+  // the calling thread always works on the loop, so every loop makes progress even with no helpers
+  struct ActiveLoop {
+    explicit ActiveLoop(std::atomic<int>& num_active_loops) : num_active_loops_(num_active_loops) {
+      num_active_loops_.fetch_add(1, std::memory_order_relaxed);
+    }
+    ~ActiveLoop() { num_active_loops_.fetch_sub(1, std::memory_order_relaxed); }
+    std::atomic<int>& num_active_loops_;
+  } active_loop(num_active_loops_);
+
+  // the share is fixed when the loop starts. loops that start or finish later don't change how many
+  // helpers this loop has scheduled; helpers that find no blocks left simply return.
+  const int num_active_loops = num_active_loops_.load(std::memory_order_relaxed);
+  num_helpers = std::min(num_helpers, std::max(1, NumThreads() / num_active_loops));
+
+  bool cached = false;
+  ParallelLoop* loop = AcquireParallelLoop(cached);
+  loop->Start(total, block_size, num_helpers, fn);
+  if (!cached) {
+    loop->Release();
+  }
+
+  // The references of helpers that aren't scheduled yet belong to this thread. They are only released once every
+  // block is done, even if this thread unwinds, as helpers that did start use fn until then.
+  struct LoopReferences {
+    ~LoopReferences() {
+      loop->Run();
+      loop->WaitForBlocks(spin_duration_us);
+      for (int i = 0; i < count; ++i) {
+        loop->Release();
+      }
+    }
+    ParallelLoop* loop;
+    int spin_duration_us;
+    int count;
+  } references{loop, spin_duration_us_, num_helpers + 1};
+
+  for (int i = 0; i < num_helpers; ++i) {
+    impl_->Schedule([loop]() {
+      loop->Run();
+      loop->Release();
+    });
+    --references.count;
+  }
+
+  loop->Run();
+  loop->WaitForBlocks(spin_duration_us_);
+  std::exception_ptr error = loop->Error();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void ThreadPool::ParallelFor(int32_t total, const std::function<void(int32_t)>& fn) {
   if (total <= 0)
     return;
 
@@ -41,20 +368,48 @@ void ThreadPool::ParallelFor(int32_t total, std::function<void(int32_t)> fn) {
     return;
   }
 
-  // TODO: Eigen supports a more efficient ThreadPoolDevice mechanism
-  // We will simply rely on the work queue and stealing in the short term.
-  Barrier barrier(static_cast<unsigned int>(total - 1));
-  std::function<void(int32_t)> handle_iteration = [&barrier, &fn](int iteration) {
-    fn(iteration);
-    barrier.Notify();
-  };
+  // The cost of an iteration is unknown, so each iteration is a block. Callers such as MLAS size the
+  // iterations to the number of threads already.
+  const int num_helpers = std::min(total - 1, NumThreads());
+  if (num_helpers <= 0) {
+    for (int32_t i = 0; i < total; ++i) {
+      fn(i);
+    }
+    return;
+  }
 
-  for (int32_t id = 1; id < total; ++id) {
-    Schedule([=, &handle_iteration]() { handle_iteration(id); });
+  RunInParallel(total, 1, num_helpers, [&fn](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (std::ptrdiff_t i = first; i < last; ++i) {
+      fn(static_cast<int32_t>(i));
+    }
+  });
+}
+
+void ThreadPool::ParallelFor(std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                             const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn) {
+  ParallelFor(total, TotalCost(cost_per_unit), fn);
+}
+
+void ThreadPool::ParallelFor(std::ptrdiff_t total, double cost_per_unit,
+                             const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn) {
+  if (total <= 0)
+    return;
+
+  const int num_threads = NumThreadsForCost(total, cost_per_unit, NumThreads() + 1);
+  if (total == 1 || num_threads <= 1) {
+    fn(0, total);
+    return;
   }
 
-  fn(0);
-  barrier.Wait();
+  const std::ptrdiff_t block_size = BlockSizeForCost(total, cost_per_unit, num_threads);
+  const std::ptrdiff_t block_count = DivUp(total, block_size);
+  if (block_count <= 1) {
+    fn(0, total);
+    return;
+  }
+
+  const int num_helpers = static_cast<int>(std::min<std::ptrdiff_t>(num_threads, block_count)) - 1;
+  RunInParallel(total, block_size, num_helpers, fn);
 }
 
 void ThreadPool::BatchParallelFor(int32_t total, std::function<void(int32_t)> fn, int32_t num_batches) {
@@ -114,8 +469,8 @@ void ThreadPool::ParallelForRange(int64_t first, int64_t last, std::function<voi
 //   impl_->SetStealPartitions(partitions);
 // }
 
-int ThreadPool::NumThreads() const { return impl_.NumThreads(); }
+int ThreadPool::NumThreads() const { return impl_->NumThreads(); }
 
-int ThreadPool::CurrentThreadId() const { return impl_.CurrentThreadId(); }
+int ThreadPool::CurrentThreadId() const { return impl_->CurrentThreadId(); }
 }  // namespace concurrency
 }  // namespace onnxruntime
@@ -9,6 +9,59 @@
 #include "core/framework/allocator.h"
 
 namespace onnxruntime {
+// Runtime statistics collected by an allocator.
+struct AllocatorStats {
+  int64_t num_allocs;             // Number of allocations.
+  int64_t bytes_in_use;           // Number of bytes in use.
+  int64_t total_allocated_bytes;  // The total number of allocated bytes by the allocator.
+  int64_t max_bytes_in_use;       // The maximum bytes in use.
+  int64_t max_alloc_size;         // The max single allocation seen.
+                                  // The upper limit what the allocator can allocate, if such a limit
+                                  // is known. Certain allocator may return 0 to indicate the limit is
+                                  // unknown.
+  int64_t bytes_limit;
+  int64_t num_thread_cache_hits;   // Number of allocations served from a thread cache without locking the arena.
+  int64_t bytes_in_thread_caches;  // Number of freed bytes held in thread caches.
+  int64_t num_lock_contentions;    // Number of times a thread had to wait for the arena lock.
+  int64_t num_regions;             // Number of memory regions the arena holds.
+  int64_t largest_free_block;      // The largest allocation the arena can serve without growing.
+  int64_t total_released_bytes;    // The total number of bytes returned to the device by Shrink.
+
+  AllocatorStats() { Clear(); }
+
+  void Clear() {
+    this->num_allocs = 0;
+    this->bytes_in_use = 0;
+    this->max_bytes_in_use = 0;
+    this->max_alloc_size = 0;
+    this->bytes_limit = 0;
+    this->total_allocated_bytes = 0;
+    this->num_thread_cache_hits = 0;
+    this->bytes_in_thread_caches = 0;
+    this->num_lock_contentions = 0;
+    this->num_regions = 0;
+    this->largest_free_block = 0;
+    this->total_released_bytes = 0;
+  }
+
+  std::string DebugString() const {
+    std::ostringstream ss;
+    ss << "Limit:           " << this->bytes_limit << "\n"
+       << "InUse:          " << this->bytes_in_use << "\n"
+       << "TotalAllocated: " << this->total_allocated_bytes << "\n"
+       << "MaxInUse:       " << this->max_bytes_in_use << "\n"
+       << "NumAllocs:      " << this->num_allocs << "\n"
+       << "MaxAllocSize:   " << this->max_alloc_size << "\n"
+       << "CacheHits:      " << this->num_thread_cache_hits << "\n"
+       << "CachedBytes:    " << this->bytes_in_thread_caches << "\n"
+       << "LockWaits:      " << this->num_lock_contentions << "\n"
+       << "NumRegions:     " << this->num_regions << "\n"
+       << "LargestFree:    " << this->largest_free_block << "\n"
+       << "TotalReleased:  " << this->total_released_bytes << "\n";
+    return ss.str();
+  }
+};
+
 // The interface for arena which manage memory allocations
 // Arena will hold a pool of pre-allocate memories and manage their lifecycle.
 // Need an underline IResourceAllocator to allocate memories.
@@ -27,6 +80,10 @@ class IArenaAllocator : public IAllocator {
   virtual size_t Used() const = 0;
   virtual size_t Max() const = 0;
   const OrtMemoryInfo& Info() const override = 0;
+  // Returns the memory the arena holds but doesn't use to the device, as far as the arena is able to.
+  // Shrink call need to be thread safe.
+  virtual void Shrink() {}
+  virtual void GetStats(AllocatorStats* stats) { stats->Clear(); }
   // allocate host pinned memory?
 };
 
@@ -75,38 +132,4 @@ class DummyArena : public IArenaAllocator {
   OrtMemoryInfo info_;
 };
 
-// Runtime statistics collected by an allocator.
-struct AllocatorStats {
-  int64_t num_allocs;             // Number of allocations.
-  int64_t bytes_in_use;           // Number of bytes in use.
-  int64_t total_allocated_bytes;  // The total number of allocated bytes by the allocator.
-  int64_t max_bytes_in_use;       // The maximum bytes in use.
-  int64_t max_alloc_size;         // The max single allocation seen.
-                                  // The upper limit what the allocator can allocate, if such a limit
-                                  // is known. Certain allocator may return 0 to indicate the limit is
-                                  // unknown.
-  int64_t bytes_limit;
-
-  AllocatorStats() { Clear(); }
-
-  void Clear() {
-    this->num_allocs = 0;
-    this->bytes_in_use = 0;
-    this->max_bytes_in_use = 0;
-    this->max_alloc_size = 0;
-    this->bytes_limit = 0;
-    this->total_allocated_bytes = 0;
-  }
-
-  std::string DebugString() const {
-    std::ostringstream ss;
-    ss << "Limit:           " << this->bytes_limit << "\n"
-       << "InUse:          " << this->bytes_in_use << "\n"
-       << "TotalAllocated: " << this->total_allocated_bytes << "\n"
-       << "MaxInUse:       " << this->max_bytes_in_use << "\n"
-       << "NumAllocs:      " << this->num_allocs << "\n"
-       << "MaxAllocSize:   " << this->max_alloc_size << "\n";
-    return ss.str();
-  }
-};
 }  // namespace onnxruntime
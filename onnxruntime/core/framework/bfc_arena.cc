@@ -13,6 +13,7 @@ BFCArena::BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator,
             device_allocator_->Info().device, device_allocator_->Info().id, device_allocator_->Info().mem_type) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name;
   curr_region_allocation_bytes_ = RoundedBytes(std::min(total_memory, size_t{1048576}));
+  initial_region_allocation_bytes_ = curr_region_allocation_bytes_;
 
   // Allocate the requested amount of memory.
   memory_limit_ = total_memory;
@@ -187,19 +188,24 @@ void* BFCArena::Reserve(size_t size) {
   if (size == 0)
     return nullptr;
 
-  std::lock_guard<OrtMutex> lock(lock_);
+  auto lock = LockArena();
   void* ptr = device_allocator_->Alloc(size);
   ORT_ENFORCE(reserved_chunks_.find(ptr) == reserved_chunks_.end());
   reserved_chunks_.insert(std::pair<void*, size_t>(ptr, size));
   stats_.bytes_in_use += size;
   stats_.num_allocs += 1;
   stats_.max_alloc_size = std::max<size_t>(static_cast<size_t>(stats_.max_alloc_size), size);
-  stats_.max_bytes_in_use = std::max<int64_t>(static_cast<int64_t>(stats_.max_bytes_in_use), stats_.bytes_in_use);
   stats_.total_allocated_bytes += size;
+  AddBytesInUse(size);
   return ptr;
 }
 
 size_t BFCArena::RequestedSize(const void* ptr) {
+  LiveChunk live_chunk;
+  if (FindLiveChunk(ptr, &live_chunk)) {
+    return live_chunk.requested_size;
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
@@ -208,6 +214,11 @@ size_t BFCArena::RequestedSize(const void* ptr) {
 }
 
 size_t BFCArena::AllocatedSize(const void* ptr) {
+  LiveChunk live_chunk;
+  if (FindLiveChunk(ptr, &live_chunk)) {
+    return live_chunk.size;
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
@@ -226,12 +237,54 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   // so all memory addresses are nicely byte aligned.
   size_t rounded_bytes = RoundedBytes(num_bytes);
 
+  void* ptr = nullptr;
+  size_t chunk_size = rounded_bytes;
+  if (rounded_bytes <= kMaxCachedChunkSize) {
+    ptr = AllocateFromThreadCache(rounded_bytes);
+  }
+
+  if (ptr == nullptr) {
+    // Chunks held in the thread caches can't be split or coalesced, so
+    // return them to the bins before giving up.
+    bool flush_and_retry = cached_bytes_.load(std::memory_order_relaxed) > 0;
+    ptr = AllocateFromBins(num_bytes, rounded_bytes, dump_log_on_failure && !flush_and_retry, &chunk_size);
+    if (ptr == nullptr && flush_and_retry) {
+      FlushThreadCaches();
+      ptr = AllocateFromBins(num_bytes, rounded_bytes, dump_log_on_failure, &chunk_size);
+    }
+  }
+
+  if (ptr != nullptr) {
+    AddBytesInUse(chunk_size);
+
+    if (chunk_size <= kMaxCachedChunkSize) {
+      LiveChunkStripe& stripe = LiveChunkStripeFor(ptr);
+      std::lock_guard<OrtMutex> lock(stripe.mutex);
+      stripe.chunks[ptr] = LiveChunk{chunk_size, num_bytes};
+    }
+  }
+
+  return ptr;
+}
+
+void BFCArena::AddBytesInUse(size_t bytes) {
+  const int64_t bytes_in_use =
+      bytes_in_use_.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) + static_cast<int64_t>(bytes);
+  int64_t max_bytes_in_use = max_bytes_in_use_.load(std::memory_order_relaxed);
+  while (bytes_in_use > max_bytes_in_use &&
+         !max_bytes_in_use_.compare_exchange_weak(max_bytes_in_use, bytes_in_use, std::memory_order_relaxed)) {
+  }
+}
+
+void* BFCArena::AllocateFromBins(size_t num_bytes, size_t rounded_bytes, bool dump_log_on_failure,
+                                 size_t* chunk_size) {
   // The BFC allocator tries to find the best fit first.
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
-  std::lock_guard<OrtMutex> lock(lock_);
+  auto lock = LockArena();
   void* ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
   if (ptr != nullptr) {
+    *chunk_size = ChunkFromHandle(region_manager_.get_handle(ptr))->size;
     return ptr;
   }
 
@@ -242,6 +295,7 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   if (Extend(rounded_bytes)) {
     ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
     if (ptr != nullptr) {
+      *chunk_size = ChunkFromHandle(region_manager_.get_handle(ptr))->size;
       return ptr;
     }
   }
@@ -259,9 +313,193 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   return nullptr;
 }
 
+std::unique_lock<OrtMutex> BFCArena::LockArena() {
+  std::unique_lock<OrtMutex> lock(lock_, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    num_lock_contentions_.fetch_add(1, std::memory_order_relaxed);
+    lock.lock();
+  }
+  return lock;
+}
+
+BFCArena::ThreadCache& BFCArena::CurrentThreadCache() {
+  static std::atomic<size_t> next_thread_index{0};
+  static thread_local size_t thread_index = next_thread_index++;
+  return thread_caches_[thread_index % kNumThreadCaches];
+}
+
+BFCArena::LiveChunkStripe& BFCArena::LiveChunkStripeFor(const void* p) {
+  // chunks are kMinAllocationSize aligned, so neighbouring chunks go to neighbouring stripes
+  std::uintptr_t p_int = reinterpret_cast<std::uintptr_t>(p);
+  return live_chunk_stripes_[(p_int >> kMinAllocationBits) % kNumLiveChunkStripes];
+}
+
+bool BFCArena::FindLiveChunk(const void* p, LiveChunk* chunk) {
+  LiveChunkStripe& stripe = LiveChunkStripeFor(p);
+  std::lock_guard<OrtMutex> lock(stripe.mutex);
+  auto it = stripe.chunks.find(p);
+  if (it == stripe.chunks.end()) {
+    return false;
+  }
+  *chunk = it->second;
+  return true;
+}
+
+bool BFCArena::TakeLiveChunk(const void* p, LiveChunk* chunk) {
+  LiveChunkStripe& stripe = LiveChunkStripeFor(p);
+  std::lock_guard<OrtMutex> lock(stripe.mutex);
+  auto it = stripe.chunks.find(p);
+  if (it == stripe.chunks.end()) {
+    return false;
+  }
+  *chunk = it->second;
+  stripe.chunks.erase(it);
+  return true;
+}
+
+void* BFCArena::AllocateFromThreadCache(size_t rounded_bytes) {
+  ThreadCache& cache = CurrentThreadCache();
+  std::lock_guard<OrtMutex> lock(cache.mutex);
+  if (cache.free_chunks.empty()) {
+    return nullptr;
+  }
+
+  auto& chunks = cache.free_chunks[rounded_bytes / kMinAllocationSize - 1];
+  if (chunks.empty()) {
+    return nullptr;
+  }
+
+  void* ptr = chunks.back();
+  chunks.pop_back();
+  cache.bytes -= rounded_bytes;
+  cached_bytes_.fetch_sub(static_cast<int64_t>(rounded_bytes), std::memory_order_relaxed);
+  num_thread_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+  return ptr;
+}
+
+void BFCArena::FreeToThreadCache(void* p, size_t size) {
+  std::vector<std::pair<void*, size_t>> evicted;
+  {
+    ThreadCache& cache = CurrentThreadCache();
+    std::lock_guard<OrtMutex> lock(cache.mutex);
+    if (cache.free_chunks.empty()) {
+      cache.free_chunks.resize(kNumSizeClasses);
+    }
+
+    cache.free_chunks[size / kMinAllocationSize - 1].push_back(p);
+    cache.bytes += size;
+    cached_bytes_.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+
+    // Over budget, so evict the largest chunks until the cache is half full.
+    // Keeping the small chunks keeps the most allocations on the fast path.
+    if (cache.bytes > kMaxThreadCacheBytes) {
+      for (size_t size_class = kNumSizeClasses; size_class-- > 0 && cache.bytes > kMaxThreadCacheBytes / 2;) {
+        auto& chunks = cache.free_chunks[size_class];
+        const size_t chunk_size = (size_class + 1) * kMinAllocationSize;
+        while (!chunks.empty() && cache.bytes > kMaxThreadCacheBytes / 2) {
+          evicted.emplace_back(chunks.back(), chunk_size);
+          chunks.pop_back();
+          cache.bytes -= chunk_size;
+        }
+      }
+    }
+  }
+
+  if (!evicted.empty()) {
+    ReturnCachedChunks(evicted);
+  }
+}
+
+void BFCArena::ReturnCachedChunks(const std::vector<std::pair<void*, size_t>>& chunks) {
+  auto lock = LockArena();
+  for (const auto& chunk : chunks) {
+    DeallocateRawInternal(chunk.first);
+    cached_bytes_.fetch_sub(static_cast<int64_t>(chunk.second), std::memory_order_relaxed);
+  }
+}
+
+void BFCArena::FlushThreadCaches() {
+  for (auto& cache : thread_caches_) {
+    std::vector<std::pair<void*, size_t>> chunks;
+    {
+      std::lock_guard<OrtMutex> lock(cache.mutex);
+      for (size_t size_class = 0; size_class < cache.free_chunks.size(); ++size_class) {
+        const size_t chunk_size = (size_class + 1) * kMinAllocationSize;
+        for (void* p : cache.free_chunks[size_class]) {
+          chunks.emplace_back(p, chunk_size);
+        }
+        cache.free_chunks[size_class].clear();
+      }
+      cache.bytes = 0;
+    }
+
+    if (!chunks.empty()) {
+      ReturnCachedChunks(chunks);
+    }
+  }
+}
+
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
+
+  // the chunks in the thread caches are in use in stats_, and the cache hits
+  // never reached it
+  const int64_t cached_bytes = cached_bytes_.load(std::memory_order_relaxed);
+  const int64_t num_thread_cache_hits = num_thread_cache_hits_.load(std::memory_order_relaxed);
+  stats->bytes_in_use = bytes_in_use_.load(std::memory_order_relaxed);
+  stats->max_bytes_in_use = max_bytes_in_use_.load(std::memory_order_relaxed);
+  stats->bytes_in_thread_caches = cached_bytes;
+  stats->num_allocs += num_thread_cache_hits;
+  stats->num_thread_cache_hits = num_thread_cache_hits;
+  stats->num_lock_contentions = num_lock_contentions_.load(std::memory_order_relaxed);
+
+  stats->num_regions = static_cast<int64_t>(region_manager_.regions().size());
+  for (BinNum b = kNumBins - 1; b >= 0; b--) {
+    // the bins and the chunks in each bin are sorted by size
+    const Bin::FreeChunkSet& free_chunks = BinFromIndex(b)->free_chunks;
+    if (!free_chunks.empty()) {
+      stats->largest_free_block = static_cast<int64_t>(ChunkFromHandle(*free_chunks.rbegin())->size);
+      break;
+    }
+  }
+}
+
+void BFCArena::Shrink() {
+  // chunks in the thread caches are still in use in their regions
+  FlushThreadCaches();
+
+  auto lock = LockArena();
+
+  // A region with no chunk in use is a single free chunk once coalesced.
+  std::vector<void*> unused_regions;
+  for (const auto& region : region_manager_.regions()) {
+    const Chunk* c = ChunkFromHandle(region_manager_.get_handle(region.ptr()));
+    if (!c->in_use() && c->size == region.memory_size()) {
+      unused_regions.push_back(region.ptr());
+    }
+  }
+
+  size_t released_bytes = 0;
+  for (void* ptr : unused_regions) {
+    ChunkHandle h = region_manager_.get_handle(ptr);
+    const size_t bytes = ChunkFromHandle(h)->size;
+    RemoveFreeChunkFromBin(h);
+    DeleteChunk(h);
+    region_manager_.RemoveAllocationRegion(ptr);
+    device_allocator_->Free(ptr);
+    released_bytes += bytes;
+  }
+
+  stats_.total_allocated_bytes -= static_cast<int64_t>(released_bytes);
+  stats_.total_released_bytes += static_cast<int64_t>(released_bytes);
+  curr_region_allocation_bytes_ = initial_region_allocation_bytes_;
+
+  if (released_bytes > 0) {
+    LOGS_DEFAULT(INFO) << "Shrank BFCArena for " << device_allocator_->Info().name << " by " << released_bytes
+                       << " bytes in " << unused_regions.size() << " regions. Total allocated bytes: "
+                       << stats_.total_allocated_bytes;
+  }
 }
 
 void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
@@ -301,8 +539,6 @@ void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
         // Update stats.
         ++stats_.num_allocs;
         stats_.bytes_in_use += chunk->size;
-        stats_.max_bytes_in_use =
-            std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
         stats_.max_alloc_size =
             std::max<int64_t>(stats_.max_alloc_size, static_cast<int64_t>(chunk->size));
         return chunk->ptr;
@@ -351,14 +587,26 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
-  std::lock_guard<OrtMutex> lock(lock_);
+
+  LiveChunk live_chunk;
+  if (TakeLiveChunk(p, &live_chunk)) {
+    bytes_in_use_.fetch_sub(static_cast<int64_t>(live_chunk.size), std::memory_order_relaxed);
+    FreeToThreadCache(p, live_chunk.size);
+    return;
+  }
+
+  auto lock = LockArena();
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
     device_allocator_->Free(it->first);
     stats_.bytes_in_use -= it->second;
     stats_.total_allocated_bytes -= it->second;
+    bytes_in_use_.fetch_sub(static_cast<int64_t>(it->second), std::memory_order_relaxed);
     reserved_chunks_.erase(it);
   } else {
+    BFCArena::ChunkHandle h = region_manager_.get_handle(p);
+    ORT_ENFORCE(h != kInvalidChunkHandle);
+    bytes_in_use_.fetch_sub(static_cast<int64_t>(ChunkFromHandle(h)->size), std::memory_order_relaxed);
     DeallocateRawInternal(p);
   }
 }
@@ -16,9 +16,12 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
@@ -46,6 +49,14 @@ namespace onnxruntime {
 // coalescing.  One assumption we make is that the process using this
 // allocator owns pretty much all of the memory, and that nearly
 // all requests to allocate memory go through this interface.
+//
+// Small chunks are recycled through a front end of thread caches so that
+// concurrent Alloc/Free calls don't all serialize on the arena lock. A
+// freed chunk of up to kMaxCachedChunkSize bytes is parked in the cache of
+// the freeing thread, still marked in use in the arena, and is handed out
+// again to the next allocation of the same rounded size from a thread using
+// that cache. When a cache holds more than kMaxThreadCacheBytes, its largest
+// chunks are returned to the bins in one batch under a single lock.
 class BFCArena : public IArenaAllocator {
  public:
   BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator, size_t total_memory);
@@ -63,7 +74,7 @@ class BFCArena : public IArenaAllocator {
   void* Reserve(size_t size) override;
 
   size_t Used() const override {
-    return static_cast<size_t>(stats_.bytes_in_use);
+    return static_cast<size_t>(bytes_in_use_.load(std::memory_order_relaxed));
   }
 
   size_t Max() const override {
@@ -79,16 +90,27 @@ class BFCArena : public IArenaAllocator {
     return device_allocator_->CreateFence(session_state);
   }
 
-  void GetStats(AllocatorStats* stats);
+  void GetStats(AllocatorStats* stats) override;
+
+  // Frees the regions that have no chunk in use, after returning the chunks in
+  // the thread caches to the bins. Growth restarts from the initial region size.
+  void Shrink() override;
 
   size_t RequestedSize(const void* ptr);
 
   size_t AllocatedSize(const void* ptr);
 
+  // Returns the chunks held in the thread caches to the bins so they can be coalesced.
+  void FlushThreadCaches();
+
  private:
   void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure);
+  void* AllocateFromBins(size_t num_bytes, size_t rounded_bytes, bool dump_log_on_failure, size_t* chunk_size);
   void DeallocateRawInternal(void* ptr);
 
+  // Locks the arena, counting the times the lock was held by another thread.
+  std::unique_lock<OrtMutex> LockArena();
+
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
   // kInvalidChunkHandle means an invalid chunk
   using ChunkHandle = size_t;
@@ -185,6 +207,53 @@ class BFCArena : public IArenaAllocator {
   static const size_t kMinAllocationBits = 8;
   static const size_t kMinAllocationSize = 1 << kMinAllocationBits;
 
+  // Thread cache front end. Each size class holds chunks of exactly
+  // (class + 1) * kMinAllocationSize bytes.
+  static const size_t kMaxCachedChunkSize = 64 << 10;
+  static const size_t kNumSizeClasses = kMaxCachedChunkSize / kMinAllocationSize;
+  static const size_t kMaxThreadCacheBytes = 1 << 20;
+  static const size_t kNumThreadCaches = 16;
+  static const size_t kNumLiveChunkStripes = 64;
+
+  // Threads are assigned to the caches round robin in the order they first
+  // use an arena, so up to kNumThreadCaches threads each have their own cache.
+  struct ThreadCache {
+    OrtMutex mutex;
+    std::vector<std::vector<void*>> free_chunks;  // by size class, allocated on first use
+    size_t bytes = 0;
+  };
+
+  // The size of every chunk that may go into a thread cache is recorded when
+  // it is handed out, so Free can cache it without looking it up in the
+  // arena. The map is striped by address to keep the stripes uncontended.
+  struct LiveChunk {
+    size_t size;
+    size_t requested_size;
+  };
+
+  struct LiveChunkStripe {
+    OrtMutex mutex;
+    std::unordered_map<const void*, LiveChunk> chunks;
+  };
+
+  ThreadCache& CurrentThreadCache();
+  LiveChunkStripe& LiveChunkStripeFor(const void* p);
+  bool FindLiveChunk(const void* p, LiveChunk* chunk);
+  bool TakeLiveChunk(const void* p, LiveChunk* chunk);
+
+  // Returns a cached chunk of exactly rounded_bytes, or nullptr.
+  void* AllocateFromThreadCache(size_t rounded_bytes);
+
+  // Tracks the bytes handed out to callers and raises the peak, for both the
+  // thread cache hits and the allocations from the bins.
+  void AddBytesInUse(size_t bytes);
+
+  // Caches p, returning a batch of chunks to the bins if the cache is full.
+  void FreeToThreadCache(void* p, size_t size);
+
+  // Frees chunks that were held in a thread cache. Takes the arena lock once.
+  void ReturnCachedChunks(const std::vector<std::pair<void*, size_t>>& chunks);
+
   // AllocationRegion maps pointers to ChunkHandles for a single
   // contiguous memory region.
   //
@@ -271,6 +340,13 @@ class BFCArena : public IArenaAllocator {
       regions_.insert(entry, AllocationRegion(ptr, memory_size));
     }
 
+    void RemoveAllocationRegion(void* ptr) {
+      auto entry =
+          std::upper_bound(regions_.begin(), regions_.end(), ptr, &Comparator);
+      ORT_ENFORCE(entry != regions_.end() && entry->ptr() == ptr, "Could not find Region for ", ptr);
+      regions_.erase(entry);
+    }
+
     ChunkHandle get_handle(const void* p) const {
       return RegionFor(p)->get_handle(p);
     }
@@ -421,11 +497,25 @@ class BFCArena : public IArenaAllocator {
 
   // The size of the current region allocation.
   size_t curr_region_allocation_bytes_;
+  size_t initial_region_allocation_bytes_;
 
   std::unique_ptr<IDeviceAllocator> device_allocator_;
 
   mutable OrtMutex lock_;
 
+  std::array<ThreadCache, kNumThreadCaches> thread_caches_;
+  std::array<LiveChunkStripe, kNumLiveChunkStripes> live_chunk_stripes_;
+
+  // Bytes of the chunks held in thread caches. These chunks are in use as far
+  // as the bins and stats_ are concerned.
+  std::atomic<int64_t> cached_bytes_{0};
+  // Bytes in use by callers, which excludes the chunks in the thread caches,
+  // and its high-water mark. A cache hit raises them without the arena lock.
+  std::atomic<int64_t> bytes_in_use_{0};
+  std::atomic<int64_t> max_bytes_in_use_{0};
+  std::atomic<int64_t> num_thread_cache_hits_{0};
+  std::atomic<int64_t> num_lock_contentions_{0};
+
   RegionManager region_manager_;
   std::vector<Chunk> chunks_;
   // Pointer to head of linked list of free Chunks
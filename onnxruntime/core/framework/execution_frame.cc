@@ -192,42 +192,63 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
   // and we have execution plan generated, try to setup
   // memory pattern optimization.
   if (session_state.GetEnableMemoryPattern() && session_state.GetExecutionPlan()) {
-    std::vector<std::reference_wrapper<const TensorShape>> input_shapes;
-    bool all_tensors = true;
-    // Reserve mem to avoid re-allocation.
-    input_shapes.reserve(feeds.size());
-    for (const auto& feed : feeds) {
-      if (!(feed.IsTensor())) {
-        all_tensors = false;
-        break;
+    if (session_state.GetStaticMemoryPatterns()) {
+      // all the shapes are static, so the patterns were planned when the session was initialized.
+      // use the session's buffers for them unless another run has them.
+      mem_patterns_ = session_state.GetStaticMemoryPatterns();
+      static_mem_buffers_ = session_state.AcquireStaticMemoryBuffers();
+    } else {
+      std::vector<std::reference_wrapper<const TensorShape>> input_shapes;
+      bool all_tensors = true;
+      // Reserve mem to avoid re-allocation.
+      input_shapes.reserve(feeds.size());
+      for (const auto& feed : feeds) {
+        if (!(feed.IsTensor())) {
+          all_tensors = false;
+          break;
+        }
+        auto& tensor = feed.Get<Tensor>();
+        input_shapes.push_back(std::cref(tensor.Shape()));
+      }
+
+      //if there are some traditional ml value type in inputs disable the memory pattern optimization.
+      if (all_tensors) {
+        mem_patterns_ref_ = session_state.GetMemoryPatternGroup(input_shapes);
+        mem_patterns_ = mem_patterns_ref_.Get();
+        // if no existing patterns, generate one in this executionframe
+        if (!mem_patterns_) {
+          planner_ = onnxruntime::make_unique<OrtValuePatternPlanner>(*session_state.GetExecutionPlan());
+        }
       }
-      auto& tensor = feed.Get<Tensor>();
-      input_shapes.push_back(std::cref(tensor.Shape()));
     }
 
-    //if there are some traditional ml value type in inputs disable the memory pattern optimization.
-    if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(input_shapes);
-      // if no existing patterns, generate one in this executionframe
-      if (!mem_patterns_) {
-        planner_ = onnxruntime::make_unique<OrtValuePatternPlanner>(*session_state.GetExecutionPlan());
-      } else {
-        // pre-allocate the big chunk requested in memory pattern.
-        // all the internal kernel's input/output tensors will be allocated on these buffer.
-        for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
-          ORT_ENFORCE(buffers_.find(mem_patterns_->locations[i]) == buffers_.end());
-          AllocatorPtr alloc = GetAllocator(mem_patterns_->locations[i]);
-          void* buffer = mem_patterns_->patterns[i].PeakSize() > 0
-                             ? alloc->Alloc(mem_patterns_->patterns[i].PeakSize())
-                             : nullptr;
-          buffers_[mem_patterns_->locations[i]] = BufferUniquePtr(buffer, alloc);
+    if (mem_patterns_) {
+      // pre-allocate the big chunk requested in memory pattern.
+      // all the internal kernel's input/output tensors will be allocated on these buffer.
+      for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
+        ORT_ENFORCE(buffers_.find(mem_patterns_->locations[i]) == buffers_.end());
+        if (static_mem_buffers_) {
+          // borrowed from the session state, so not freed with the frame
+          buffers_[mem_patterns_->locations[i]] = BufferUniquePtr((*static_mem_buffers_)[i].get(), BufferDeleter());
+          continue;
         }
+
+        AllocatorPtr alloc = GetAllocator(mem_patterns_->locations[i]);
+        void* buffer = mem_patterns_->patterns[i].PeakSize() > 0
+                           ? alloc->Alloc(mem_patterns_->patterns[i].PeakSize())
+                           : nullptr;
+        buffers_[mem_patterns_->locations[i]] = BufferUniquePtr(buffer, alloc);
       }
     }
   }
 }
 
-ExecutionFrame::~ExecutionFrame() = default;
+ExecutionFrame::~ExecutionFrame() {
+  // the tensors left in the buffers don't touch their data when they're destroyed
+  if (static_mem_buffers_) {
+    session_state_.ReleaseStaticMemoryBuffers();
+  }
+}
 
 Status ExecutionFrame::AllocateMLValueTensorSelfOwnBuffer(OrtValue& ort_value, int ort_value_index,
                                                           MLDataType element_type, const OrtMemoryInfo& location,
@@ -270,26 +291,26 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   // if we have pre-calculated memory pattern, and the ort_value is not output mlvalue
   // try to allocated on pre-allocated big chunk.
   const auto& per_alloc_plan = GetAllocationPlan(ort_value_index);
-  if (mem_patterns_ && per_alloc_plan.alloc_kind != AllocKind::kAllocateOutput) {
+  // an intermediate value that is fetched must outlive the frame, so it can't be placed in the pattern's buffer
+  if (mem_patterns_ && per_alloc_plan.alloc_kind != AllocKind::kAllocateOutput && !IsOutput(ort_value_index)) {
     auto pattern = mem_patterns_->GetPatterns(location);
     if (pattern) {
       auto block = pattern->GetBlock(ort_value_index);
       // if block not found, fall back to default behavior
       if (block) {
         auto it = buffers_.find(location);
-        // if the block is not correct, log message then fall back to default behavior
-        if (it != buffers_.end() && block->size_ == size) {
+        // the pattern may have been traced with larger shapes in the same bucket, so any block that is large
+        // enough can be used. if the block is too small, log message then fall back to default behavior
+        if (it != buffers_.end() && size <= block->size_) {
           void* buffer = it->second.get();
           auto status = AllocateTensorWithPreAllocateBufferHelper(
               ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
               shape);
           return status;
         }
-        if (block->size_ != size) {
-          // the block size may vary especially if the model has NonZero ops, or different sequence lengths are
-          // fed in, so use VERBOSE as the log level as it's expected.
-          // TODO: Should we re-use the block if the size is large enough? Would probably need to allow it
-          // to be freed if the size difference was too large so our memory usage doesn't stick at a high water mark
+        if (size > block->size_) {
+          // the block size may vary especially if the model has NonZero ops, so use VERBOSE as the log level
+          // as it's expected.
           LOGS(session_state_.Logger(), VERBOSE) << "For ort_value with index: " << ort_value_index
                                                  << ", block in memory pattern size is: " << block->size_
                                                  << " but the actually size is: " << size
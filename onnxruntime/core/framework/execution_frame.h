@@ -9,6 +9,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/status.h"
 #include "core/framework/iexecutor.h"
+#include "core/framework/mem_pattern_cache.h"
 #include "core/framework/ml_value.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/sequential_execution_plan.h"
@@ -156,6 +157,11 @@ class ExecutionFrame final : public IExecutionFrame {
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
   const MemoryPatternGroup* mem_patterns_;
+  // keeps mem_patterns_ alive if it's evicted from the cache during the run
+  MemoryPatternCache::PatternRef mem_patterns_ref_;
+
+  // the buffers of the static memory patterns of the session, if this frame has them
+  const std::vector<BufferUniquePtr>* static_mem_buffers_ = nullptr;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
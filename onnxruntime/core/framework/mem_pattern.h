@@ -16,6 +16,7 @@ struct MemoryBlock {
 
 class MemoryPattern {
   friend class MemPatternPlanner;
+  friend class StaticMemoryPlanner;
 
  public:
   MemoryPattern() = default;
@@ -0,0 +1,226 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/mem_pattern_cache.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace onnxruntime {
+
+struct MemoryPatternCache::Entry {
+  // the rank and bucketed dims of every input
+  std::vector<int64_t> key;
+  uint64_t key_hash = 0;
+  // the dims of the inputs the patterns were traced with
+  std::vector<int64_t> traced_dims;
+  std::unique_ptr<MemoryPatternGroup> patterns;
+
+  std::atomic<int> refs{0};
+  std::atomic<uint64_t> last_used{0};
+
+  // whether the patterns were traced with shapes no smaller than the input shapes in any dim
+  bool Fits(const InputShapes& input_shapes) const {
+    size_t i = 0;
+    for (const auto& shape : input_shapes) {
+      for (auto dim : shape.get().GetDims()) {
+        if (dim > traced_dims[i++]) return false;
+      }
+    }
+    return true;
+  }
+};
+
+MemoryPatternCache::PatternRef& MemoryPatternCache::PatternRef::operator=(PatternRef&& other) noexcept {
+  if (this != &other) {
+    Release();
+    cache_ = other.cache_;
+    entry_ = other.entry_;
+    other.entry_ = nullptr;
+  }
+  return *this;
+}
+
+void MemoryPatternCache::PatternRef::Release() {
+  if (entry_ == nullptr) return;
+
+  // the entry may be deleted as soon as the reference is dropped, so only the cache is used after that.
+  // Insert retires an entry before it checks the references, so either it sees this reference gone or this
+  // sees the entry retired.
+  const bool last_ref = entry_->refs.fetch_sub(1) == 1;
+  entry_ = nullptr;
+  if (last_ref && cache_->num_retired_.load() != 0) {
+    std::lock_guard<OrtMutex> lock(cache_->mutex_);
+    cache_->DeleteReleasedEntries();
+  }
+}
+
+const MemoryPatternGroup* MemoryPatternCache::PatternRef::Get() const {
+  return entry_ != nullptr ? entry_->patterns.get() : nullptr;
+}
+
+MemoryPatternCache::MemoryPatternCache() : slots_(new std::atomic<Entry*>[max_patterns_]) {
+  for (size_t i = 0; i < max_patterns_; ++i) slots_[i] = nullptr;
+}
+
+MemoryPatternCache::~MemoryPatternCache() {
+  Clear();
+}
+
+void MemoryPatternCache::Configure(std::vector<int64_t> dim_buckets, size_t max_patterns) {
+  ORT_ENFORCE(std::is_sorted(dim_buckets.begin(), dim_buckets.end()), "The dim buckets must be in increasing order");
+  ORT_ENFORCE(max_patterns > 0, "At least one memory pattern must be kept");
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  Clear();
+  dim_buckets_ = std::move(dim_buckets);
+  max_patterns_ = max_patterns;
+  slots_.reset(new std::atomic<Entry*>[max_patterns_]);
+  for (size_t i = 0; i < max_patterns_; ++i) slots_[i] = nullptr;
+}
+
+void MemoryPatternCache::Clear() {
+  for (size_t i = 0; i < max_patterns_; ++i) {
+    delete slots_[i].exchange(nullptr);
+  }
+  for (auto* entry : retired_) {
+    delete entry;
+  }
+  retired_.clear();
+  num_retired_ = 0;
+}
+
+int64_t MemoryPatternCache::Bucket(int64_t dim) const {
+  auto it = std::lower_bound(dim_buckets_.begin(), dim_buckets_.end(), dim);
+  return it != dim_buckets_.end() ? *it : dim;
+}
+
+uint64_t MemoryPatternCache::Hash(const InputShapes& input_shapes) const {
+  // FNV-1a over the rank and bucketed dims of every input
+  uint64_t hash = 14695981039346656037ULL;
+  auto add = [&hash](int64_t value) {
+    hash ^= static_cast<uint64_t>(value);
+    hash *= 1099511628211ULL;
+  };
+  for (const auto& shape : input_shapes) {
+    const auto& dims = shape.get().GetDims();
+    add(static_cast<int64_t>(dims.size()));
+    for (auto dim : dims) add(Bucket(dim));
+  }
+  return hash;
+}
+
+bool MemoryPatternCache::IsSameBucket(const Entry& entry, const InputShapes& input_shapes) const {
+  size_t i = 0;
+  for (const auto& shape : input_shapes) {
+    const auto& dims = shape.get().GetDims();
+    if (i >= entry.key.size() || entry.key[i++] != static_cast<int64_t>(dims.size())) return false;
+    for (auto dim : dims) {
+      if (i >= entry.key.size() || entry.key[i++] != Bucket(dim)) return false;
+    }
+  }
+  return i == entry.key.size();
+}
+
+MemoryPatternCache::PatternRef MemoryPatternCache::Find(const InputShapes& input_shapes) const {
+  const uint64_t key_hash = Hash(input_shapes);
+  PatternRef ref;
+
+  // an entry that is retired while we look at it isn't deleted until the lookup is done
+  active_lookups_.fetch_add(1);
+  for (size_t i = 0; i < max_patterns_; ++i) {
+    Entry* entry = slots_[i].load();
+    if (entry != nullptr && entry->key_hash == key_hash && IsSameBucket(*entry, input_shapes)) {
+      if (entry->Fits(input_shapes)) {
+        entry->refs.fetch_add(1);
+        entry->last_used.store(++clock_, std::memory_order_relaxed);
+        ref = PatternRef(this, entry);
+      }
+      break;
+    }
+  }
+  active_lookups_.fetch_sub(1);
+
+  return ref;
+}
+
+void MemoryPatternCache::Insert(const InputShapes& input_shapes, std::unique_ptr<MemoryPatternGroup> patterns) {
+  std::unique_ptr<Entry> entry = onnxruntime::make_unique<Entry>();
+  entry->key_hash = Hash(input_shapes);
+  for (const auto& shape : input_shapes) {
+    const auto& dims = shape.get().GetDims();
+    entry->key.push_back(static_cast<int64_t>(dims.size()));
+    for (auto dim : dims) {
+      entry->key.push_back(Bucket(dim));
+      entry->traced_dims.push_back(dim);
+    }
+  }
+  entry->patterns = std::move(patterns);
+  entry->last_used = ++clock_;
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  // replace the pattern of the same bucket, or take an empty slot, or evict the least recently used pattern
+  size_t slot = max_patterns_;
+  size_t empty_slot = max_patterns_;
+  size_t lru_slot = 0;
+  uint64_t lru_time = std::numeric_limits<uint64_t>::max();
+  for (size_t i = 0; i < max_patterns_; ++i) {
+    Entry* current = slots_[i].load();
+    if (current == nullptr) {
+      if (empty_slot == max_patterns_) empty_slot = i;
+      continue;
+    }
+
+    if (current->key_hash == entry->key_hash && IsSameBucket(*current, input_shapes)) {
+      // another run may have cached a pattern for larger shapes in the meantime
+      if (current->Fits(input_shapes)) return;
+      slot = i;
+      break;
+    }
+
+    const uint64_t last_used = current->last_used.load(std::memory_order_relaxed);
+    if (last_used < lru_time) {
+      lru_time = last_used;
+      lru_slot = i;
+    }
+  }
+
+  if (slot == max_patterns_) {
+    slot = empty_slot != max_patterns_ ? empty_slot : lru_slot;
+  }
+
+  Entry* old_entry = slots_[slot].exchange(entry.release());
+  if (old_entry != nullptr) {
+    retired_.push_back(old_entry);
+    num_retired_ = retired_.size();
+  }
+
+  DeleteReleasedEntries();
+}
+
+void MemoryPatternCache::DeleteReleasedEntries() const {
+  // the retired entries are no longer in a slot, so lookups that start from now on can't find them.
+  // once no lookup is in progress, an entry without references can't get one.
+  if (retired_.empty() || active_lookups_.load() != 0) {
+    return;
+  }
+
+  auto released = std::remove_if(retired_.begin(), retired_.end(), [](Entry* entry) {
+    if (entry->refs.load() != 0) return false;
+    delete entry;
+    return true;
+  });
+  retired_.erase(released, retired_.end());
+  num_retired_ = retired_.size();
+}
+
+size_t MemoryPatternCache::NumPatterns() const {
+  size_t num_patterns = 0;
+  for (size_t i = 0; i < max_patterns_; ++i) {
+    if (slots_[i].load() != nullptr) ++num_patterns;
+  }
+  return num_patterns;
+}
+
+}  // namespace onnxruntime
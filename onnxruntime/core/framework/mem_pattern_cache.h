@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "core/common/common.h"
+#include "core/framework/mem_pattern.h"
+#include "core/framework/tensor_shape.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/*
+Cache of the memory patterns of a session, keyed by the shapes of its inputs.
+
+Every input dim is rounded up to the smallest of the configured buckets that holds it, so runs whose inputs only
+differ in a dim within a bucket (e.g. the sequence length) share a pattern. A pattern is used for the shapes it was
+traced with and for any smaller shapes in its bucket. A run with larger shapes traces a new pattern that replaces
+the old one, so the pattern of a bucket grows to fit the largest shapes seen in it.
+
+At most max_patterns patterns are kept, evicting the least recently used one. Finding a pattern takes no lock: the
+entries are read through atomic pointers, and an evicted entry is only deleted once it's released and no lookup
+that could have seen it is still in progress. That happens when the next pattern is inserted, when its last
+reference is released, or when the cache is reconfigured or destroyed.
+*/
+class MemoryPatternCache {
+ public:
+  struct Entry;
+
+  // Keeps a cached pattern alive while an execution frame uses it
+  class PatternRef {
+   public:
+    PatternRef() = default;
+    PatternRef(const MemoryPatternCache* cache, Entry* entry) : cache_(cache), entry_(entry) {}
+    PatternRef(PatternRef&& other) noexcept : cache_(other.cache_), entry_(other.entry_) { other.entry_ = nullptr; }
+    PatternRef& operator=(PatternRef&& other) noexcept;
+    ~PatternRef() { Release(); }
+
+    // nullptr if no pattern was found
+    const MemoryPatternGroup* Get() const;
+
+   private:
+    ORT_DISALLOW_COPY_AND_ASSIGNMENT(PatternRef);
+
+    void Release();
+
+    const MemoryPatternCache* cache_ = nullptr;
+    Entry* entry_ = nullptr;
+  };
+
+  using InputShapes = std::vector<std::reference_wrapper<const TensorShape>>;
+
+  static constexpr size_t kDefaultMaxPatterns = 64;
+
+  MemoryPatternCache();
+  ~MemoryPatternCache();
+
+  /**
+  Set the dim buckets, in increasing order, and the number of patterns kept. Dims larger than the last bucket are
+  used as is, so with no buckets the patterns are keyed by the exact input shapes.
+  Drops the cached patterns, so it must be called before the cache is used.
+  */
+  void Configure(std::vector<int64_t> dim_buckets, size_t max_patterns);
+
+  // Find the pattern that fits the input shapes. Thread-safe and lock free.
+  PatternRef Find(const InputShapes& input_shapes) const;
+
+  // Cache the patterns traced with the input shapes, unless the cached pattern of their bucket already fits them.
+  // Thread-safe.
+  void Insert(const InputShapes& input_shapes, std::unique_ptr<MemoryPatternGroup> patterns);
+
+  // Number of cached patterns. Thread-safe.
+  size_t NumPatterns() const;
+
+  // Number of evicted or replaced patterns that are not deleted yet. Thread-safe.
+  size_t NumRetiredPatterns() const { return num_retired_.load(); }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MemoryPatternCache);
+
+  int64_t Bucket(int64_t dim) const;
+  uint64_t Hash(const InputShapes& input_shapes) const;
+  bool IsSameBucket(const Entry& entry, const InputShapes& input_shapes) const;
+
+  // delete the retired entries if no lookup could still see them. requires mutex_.
+  void DeleteReleasedEntries() const;
+  void Clear();
+
+  std::vector<int64_t> dim_buckets_;
+  size_t max_patterns_ = kDefaultMaxPatterns;
+  std::unique_ptr<std::atomic<Entry*>[]> slots_;
+
+  mutable std::atomic<int> active_lookups_{0};
+  mutable std::atomic<uint64_t> clock_{0};
+
+  // serializes changes to the slots and to retired_
+  mutable OrtMutex mutex_;
+  // evicted or replaced entries that may still be in use
+  mutable std::vector<Entry*> retired_;
+  // size of retired_, so releasing a reference only takes the lock if there is something to delete
+  mutable std::atomic<size_t> num_retired_{0};
+};
+
+}  // namespace onnxruntime
@@ -35,6 +35,10 @@ namespace onnxruntime {
         *stats = stats_;
     }
 
+    void MiMallocArena::Shrink() {
+        mi_collect(true);
+    }
+
     size_t MiMallocArena::Used() const {
 #if (MI_STAT>1)
         return mi_heap_get_default()->tld->stats.malloc.current;
@@ -13,7 +13,10 @@ class MiMallocArena : public IArenaAllocator {
     void Free(void* p) override;
 
     // mimalloc only maintains stats when compiled under debug, or when MI_STAT >= 2
-    void GetStats(AllocatorStats* stats);
+    void GetStats(AllocatorStats* stats) override;
+
+    // returns the free pages of the heap to the OS
+    void Shrink() override;
 
     void* Reserve(size_t size) override;
 
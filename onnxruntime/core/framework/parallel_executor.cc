@@ -6,6 +6,7 @@
 #include <chrono>
 #include <memory>
 #include <thread>
+#include <unordered_set>
 #include <vector>
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
@@ -18,10 +19,24 @@
 
 namespace onnxruntime {
 
+namespace {
+// Nodes that only change the shape or type information of their input are cheaper to run than to enqueue.
+bool IsCheapNode(const Node& node) {
+  static const std::unordered_set<std::string> cheap_op_types{
+      "Identity", "Reshape", "Squeeze", "Unsqueeze", "Flatten", "Shape", "Size"};
+
+  return (node.Domain() == kOnnxDomain || node.Domain() == kOnnxDomainAlias) &&
+         cheap_op_types.count(node.OpType()) > 0;
+}
+}  // namespace
+
 ParallelExecutor::ParallelExecutor(const SessionState& session_state, const bool& terminate_flag)
-    : out_standings_(0), terminate_flag_(terminate_flag), executor_pool_(session_state.GetInterOpThreadPool()) {
+    : node_refs_(session_state.GetGraphViewer()->MaxNodeIndex()),
+      out_standings_(0),
+      has_errors_(false),
+      terminate_flag_(terminate_flag),
+      executor_pool_(session_state.GetInterOpThreadPool()) {
   auto graph_viewer = session_state.GetGraphViewer();
-  node_refs_.resize(graph_viewer->MaxNodeIndex());
   for (auto& node : graph_viewer->Nodes()) {
     node_refs_[node.Index()] = node.GetInputEdgesCount();
   }
@@ -40,14 +55,20 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
 
   root_frame_ = onnxruntime::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches,
                                                  fetch_allocators, session_state);
-  //std::cout << "start nodes:" << std::endl;
+  std::vector<size_t> root_nodes;
   for (auto node_index : session_state.GetGraphViewer()->GetRootNodes()) {
-    auto p_op_kernel = session_state.GetKernel(node_index);
-    if (!p_op_kernel)
-      continue;
+    if (session_state.GetKernel(node_index))
+      root_nodes.push_back(node_index);
+  }
 
-    //std::cout << "\t" << p_op_kernel->Node().Name() << std::endl;
-    EnqueueNode(node_index, session_state, logger);
+  // the calling thread runs the first root node instead of waiting idle, the others start in the thread pool
+  if (!root_nodes.empty()) {
+    ++out_standings_;
+    for (size_t i = 1; i < root_nodes.size(); ++i) {
+      EnqueueNode(root_nodes[i], session_state, logger);
+    }
+
+    RunNodeChain(root_nodes.front(), session_state, logger);
   }
 
   // Wait for finish.
@@ -114,8 +135,8 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
 
   Status status = Status::OK();
 
-  size_t node_index = p_node_index;
-  bool keep_running = true;
+  // nodes this thread runs next. the last one is popped first.
+  std::vector<size_t> inline_nodes{p_node_index};
   auto graph_viewer = session_state.GetGraphViewer();
   TimePoint sync_time_begin;
   TimePoint kernel_begin_time;
@@ -123,7 +144,10 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
   const SequentialExecutionPlan& exec_plan = *session_state.GetExecutionPlan();
 
   // Avoid context switching if possible.
-  while (keep_running) {
+  while (!inline_nodes.empty()) {
+    const size_t node_index = inline_nodes.back();
+    inline_nodes.pop_back();
+
     // TODO: Convert RunNodeAsync return Status.
     // to also handle exception propagation
     if (terminate_flag_) {
@@ -245,30 +269,21 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
                                                      {{"op_name", p_op_kernel->KernelDef().OpName()}});
     }
 
-    //std::cout << "Run async node finish: " << p_node_index << std::endl;
-
-    keep_running = false;
-
-    // Checking which output nodes ready for running.
-    {
-      auto begin = node.OutputEdgesBegin();
-      auto end = node.OutputEdgesEnd();
-
-      std::lock_guard<OrtMutex> lock(ref_mutex_);
-      for (auto it = begin; it != end; it++) {
-        auto idx = (*it).GetNode().Index();
-        if ((--node_refs_[idx]) == 0) {
-          if (!keep_running) {
-            node_index = idx;
-            keep_running = true;
-          } else {
-            EnqueueNode(idx, session_state, logger);
-          }
-        }
-
-        // std::cout << "handle output, current name: " << node.Name() << ", current index: "
-        // << p_node_index << ", output name: " << (*it)->GetNode().Name() << ", output index: "
-        // << (*it)->GetNode().Index() << ", after -- output ref: " << node_refs_[idx] << std::endl;
+    // Checking which output nodes ready for running. The first one continues on this thread, as do cheap ones.
+    bool continued = false;
+    for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+      const auto& output_node = (*it).GetNode();
+      const auto idx = output_node.Index();
+      if (--node_refs_[idx] != 0)
+        continue;
+
+      if (!continued) {
+        inline_nodes.push_back(idx);
+        continued = true;
+      } else if (IsCheapNode(output_node)) {
+        inline_nodes.push_back(idx);
+      } else {
+        EnqueueNode(idx, session_state, logger);
       }
     }
   }
@@ -276,36 +291,37 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
   return status;
 }
 
-void ParallelExecutor::EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger) {
-  {
-    std::unique_lock<OrtMutex> lock(complete_mutex_);
-    // if there are errors there's no point queuing more work
-    if (!errors_.empty())
-      return;
-
-    out_standings_++;
+void ParallelExecutor::RunNodeChain(size_t p_node_index, const SessionState& session_state,
+                                    const logging::Logger& logger) {
+  auto create_exception_message = [p_node_index, &session_state](const std::exception* ex) {
+    const auto* node = session_state.GetGraphViewer()->GetNode(p_node_index);
+
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exception running nodes starting at ", node->OpType(),
+                           " node '", node->Name(), "'. ",
+                           ex ? ex->what() : "Unknown exception was caught by catch-all handler.");
+  };
+
+  Status status;
+  try {
+    status = ParallelExecutor::RunNodeAsync(p_node_index, std::cref(session_state), std::cref(logger));
+  } catch (const std::exception& ex) {
+    status = create_exception_message(&ex);
+  } catch (...) {
+    // catch node processing failure exceptions here to prevent app crash.
+    status = create_exception_message(nullptr);
   }
 
-  executor_pool_->Schedule([this, p_node_index, &session_state, &logger]() {
-    auto create_exception_message = [p_node_index, &session_state](const std::exception* ex) {
-      const auto* node = session_state.GetGraphViewer()->GetNode(p_node_index);
-
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exception running nodes starting at ", node->OpType(),
-                             " node '", node->Name(), "'. ",
-                             ex ? ex->what() : "Unknown exception was caught by catch-all handler.");
-    };
+  FinishNodeRun(status);
+}
 
-    Status status;
-    try {
-      status = ParallelExecutor::RunNodeAsync(p_node_index, std::cref(session_state), std::cref(logger));
-    } catch (const std::exception& ex) {
-      status = create_exception_message(&ex);
-    } catch (...) {
-      // catch node processing failure exceptions here to prevent app crash.
-      status = create_exception_message(nullptr);
-    }
+void ParallelExecutor::EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger) {
+  // if there are errors there's no point queuing more work
+  if (has_errors_)
+    return;
 
-    FinishNodeRun(status);
+  ++out_standings_;
+  executor_pool_->Schedule([this, p_node_index, &session_state, &logger]() {
+    RunNodeChain(p_node_index, session_state, logger);
   });
 }
 }  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include "core/common/common.h"
 #include "core/common/status.h"
@@ -31,36 +32,44 @@ class ParallelExecutor : public IExecutor {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelExecutor);
 
+  // Runs the node and then, on the same thread, the successors it makes ready. The first ready successor and any
+  // cheap ones continue on this thread, the other branches are enqueued to the inter-op thread pool.
   Status RunNodeAsync(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
 
+  // Runs RunNodeAsync, converting exceptions to a Status, and records its completion.
+  void RunNodeChain(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
+
   void EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
 
   void FinishNodeRun(const Status& status) {
-    bool finished = false;
-    {
-      //Because we have a mutex here, it's not possible another thread is doing the test("while (out_standings_ > 0)"
-      std::lock_guard<OrtMutex> lock(complete_mutex_);
-      finished = --out_standings_ == 0;
-      if (!status.IsOK())
-        errors_.push_back(status);
+    if (!status.IsOK()) {
+      std::lock_guard<OrtMutex> lock(error_mutex_);
+      errors_.push_back(status);
+      has_errors_ = true;
     }
 
-    if (finished) {
-      //std::cout << "all out standing nodes are completed." << std::endl;
+    // decrement under the lock: once Execute sees zero it may return and destroy the executor, so the last chain
+    // must be done with the mutex and the condition variable by then
+    std::lock_guard<OrtMutex> lock(complete_mutex_);
+    if (--out_standings_ == 0) {
       complete_cv_.notify_all();
     }
   }
 
   std::unique_ptr<ExecutionFrame> root_frame_;
-  std::vector<size_t> node_refs_;
-  OrtMutex ref_mutex_;
-  int out_standings_;  //protected by complete_mutex_
+  // number of input edges of each node that are not produced yet. the thread that drops it to zero runs the node.
+  std::vector<std::atomic<size_t>> node_refs_;
+  // number of node chains that are running or queued
+  std::atomic<int> out_standings_;
   OrtMutex complete_mutex_;
   OrtCondVar complete_cv_;
+
+  // only used once a node fails
+  std::atomic<bool> has_errors_;
+  OrtMutex error_mutex_;
   std::vector<Status> errors_;
 
   const bool& terminate_flag_;
-  // TODO: Temporary threadpool for the executor.  This is a costly way to handle the problem.
   onnxruntime::concurrency::ThreadPool* const executor_pool_{};
 };
 }  // namespace onnxruntime
@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights.h"
+
+#include <cstring>
+
+namespace onnxruntime {
+
+uint64_t PrePackedWeights::GetHash() const {
+  ORT_ENFORCE(buffers_.size() == buffer_sizes_.size());
+
+  // 64-bit FNV-1a over the buffer sizes and contents
+  constexpr uint64_t kFnvPrime = 1099511628211ULL;
+  uint64_t hash = 14695981039346656037ULL;
+
+  auto hash_bytes = [&hash](const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+      hash ^= bytes[i];
+      hash *= kFnvPrime;
+    }
+  };
+
+  for (size_t i = 0; i < buffers_.size(); ++i) {
+    hash_bytes(&buffer_sizes_[i], sizeof(size_t));
+    if (buffers_[i] != nullptr) {
+      hash_bytes(buffers_[i].get(), buffer_sizes_[i]);
+    }
+  }
+
+  return hash;
+}
+
+bool PrePackedWeights::IsEqual(const PrePackedWeights& other) const {
+  if (buffer_sizes_ != other.buffer_sizes_ || buffers_.size() != other.buffers_.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < buffers_.size(); ++i) {
+    if ((buffers_[i] == nullptr) != (other.buffers_[i] == nullptr)) {
+      return false;
+    }
+    if (buffers_[i] != nullptr && memcmp(buffers_[i].get(), other.buffers_[i].get(), buffer_sizes_[i]) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace onnxruntime
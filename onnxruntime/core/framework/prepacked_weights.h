@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+// The packed form of a constant initializer produced by OpKernel::PrePack.
+struct PrePackedWeights final {
+  // Some weights may be packed into more than one buffer (e.g. one per gate of a recurrent op),
+  // so this is a list. buffer_sizes_[i] is the size in bytes of buffers_[i].
+  std::vector<BufferUniquePtr> buffers_;
+  std::vector<size_t> buffer_sizes_;
+
+  // Hash of the packed content. Used to look up identical packed weights produced by other sessions.
+  uint64_t GetHash() const;
+
+  // Returns true if 'other' holds exactly the same packed content.
+  bool IsEqual(const PrePackedWeights& other) const;
+};
+
+}  // namespace onnxruntime
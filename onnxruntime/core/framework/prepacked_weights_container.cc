@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_container.h"
+
+namespace onnxruntime {
+
+PrepackedWeightsContainer::PrepackedWeightsContainer() : allocator_(std::make_shared<CPUAllocator>()) {
+}
+
+const PrePackedWeights* PrepackedWeightsContainer::GetOrAddWeight(const std::string& key,
+                                                                  PrePackedWeights& packed_weights) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  auto entry = prepacked_weights_map_.find(key);
+  if (entry == prepacked_weights_map_.end()) {
+    entry = prepacked_weights_map_.emplace(key, std::move(packed_weights)).first;
+    return &entry->second;
+  }
+
+  return entry->second.IsEqual(packed_weights) ? &entry->second : nullptr;
+}
+
+size_t PrepackedWeightsContainer::GetNumberOfElements() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return prepacked_weights_map_.size();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * Holds pre-packed weights so that sessions loading the same model can share them instead of each
+ * keeping its own copy. Entries are keyed by a string built from the op type, the input index and
+ * the hash of the packed content, and live as long as the container.
+ * All methods are thread-safe as sessions may be initialized concurrently.
+ */
+class PrepackedWeightsContainer final {
+ public:
+  PrepackedWeightsContainer();
+
+  // Allocator that must be used for buffers written to this container.
+  AllocatorPtr GetAllocator() const { return allocator_; }
+
+  /**
+   * Adds 'packed_weights' under 'key' if there is no entry for it yet, taking the buffers from it.
+   * Returns the entry for 'key', or nullptr if an entry exists but its content differs from 'packed_weights'
+   * (i.e. a hash collision), in which case 'packed_weights' is left untouched.
+   * The returned entry remains valid for the lifetime of the container.
+   */
+  const PrePackedWeights* GetOrAddWeight(const std::string& key, PrePackedWeights& packed_weights);
+
+  size_t GetNumberOfElements() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsContainer);
+
+  AllocatorPtr allocator_;
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, PrePackedWeights> prepacked_weights_map_;
+};
+
+}  // namespace onnxruntime
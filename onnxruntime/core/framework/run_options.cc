@@ -53,3 +53,8 @@ ORT_API_STATUS_IMPL(OrtApis::RunOptionsUnsetTerminate, _Inout_ OrtRunOptions* op
   options->terminate = false;
   return nullptr;
 }
+
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsSetShrinkArenas, _Inout_ OrtRunOptions* options, int shrink) {
+  options->shrink_memory_arenas = shrink != 0;
+  return nullptr;
+}
@@ -31,13 +31,43 @@ struct SessionOptions {
   // and generate a memory pattern for future request. So next time we could just do one allocation
   // with a big chunk for all the internal memory allocation.
   // See class 'OrtValuePatternPlanner'.
+  // If all the shapes are static, e.g. after the free_dimension_overrides, the pattern is planned ahead of time
+  // instead, and the session keeps its buffer so that the runs don't allocate the memory of the tensors in it.
+  // See class 'StaticMemoryPlanner'.
   bool enable_mem_pattern = true;
 
+  // the input dims are rounded up to the smallest of these buckets when looking up a memory pattern, so inputs
+  // with e.g. different sequence lengths in the same bucket share the pattern traced with the largest of them.
+  // must be in increasing order. dims larger than the last bucket, or all dims if empty, are matched exactly.
+  std::vector<int64_t> mem_pattern_dim_buckets;
+
+  // the most memory patterns cached by the session. the least recently used one is evicted to cache another.
+  size_t mem_pattern_max_count = 64;
+
   // enable the memory arena on CPU
   // Arena may pre-allocate memory for future usage.
   // set this option to false if you don't want it.
   bool enable_cpu_mem_arena = true;
 
+  // the most memory the CPU arena may hold. 0 for no limit.
+  size_t cpu_mem_arena_max_bytes = 0;
+
+  // the arenas only grow, so a burst of large requests would keep its memory for the life of the session.
+  // the session returns the memory regions of its arenas that have nothing in use to the device after every
+  // arena_shrink_interval_runs runs, and when a run starts after it was idle for arena_shrink_idle_ms.
+  // 0 disables either. the idle shrink happens lazily at the start of the next Run, not when the idle time
+  // elapses, so the memory is never released if no further run arrives.
+  int arena_shrink_interval_runs = 0;
+  int64_t arena_shrink_idle_ms = 0;
+
+  // share the weights pre-packed by kernels with other sessions created from the same environment.
+  // useful when the same model is loaded by several sessions, as only one copy of the packed weights is kept.
+  bool share_prepacked_weights = false;
+
+  // map the model file into memory when loading a model from a file, instead of parsing a copy of the raw data
+  // of the initializers. the tensors of the large initializers use the data in the mapping, which the session keeps.
+  bool use_mapped_model_loading = false;
+
   // the prefix of the profile file. The current time will be appended to the file name.
   std::basic_string<ORTCHAR_T> profile_file_prefix = ORT_TSTR("onnxruntime_profile_");
 
@@ -61,6 +91,27 @@ struct SessionOptions {
   // configuring this makes sense only when you're using parallel executor
   int inter_op_num_threads = 0;
 
+  // create thread pools for this session. when false, the session uses the global thread pools of the
+  // environment, which must have been created with them.
+  bool use_per_session_threads = true;
+
+  // time in microseconds that a thread running a parallel loop on the thread pools spins waiting for the last blocks
+  // of the loop before it blocks. 0 blocks straight away.
+  int thread_pool_spin_duration_us = 0;
+
+  // let the idle worker threads of the thread pools spin looking for work for a while before they sleep.
+  bool thread_pool_allow_spinning = true;
+
+  // how the threads of the thread pools are pinned to logical processors.
+  OrtThreadAffinityPolicy thread_pool_affinity_policy = ORT_THREAD_AFFINITY_NONE;
+
+  // logical processors used with ORT_THREAD_AFFINITY_EXPLICIT.
+  std::vector<size_t> thread_pool_affinity;
+
+  // when >= 0, the threads of the thread pools only run on the logical processors of this NUMA node.
+  // with the usual first-touch placement, the memory they allocate then stays local to the node.
+  int thread_pool_numa_node = -1;
+
   // For models with free input dimensions (most commonly batch size), specifies a set of values to override those
   // free dimensions with, keyed by dimension denotation.
   std::vector<FreeDimensionOverride> free_dimension_overrides;
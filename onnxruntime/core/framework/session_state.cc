@@ -3,6 +3,7 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "core/common/logging/logging.h"
@@ -127,6 +128,32 @@ Status SessionState::AddInitializedTensor(int ort_value_index, const OrtValue& o
   return Status::OK();
 }
 
+Status SessionState::RemoveInitializedTensor(int ort_value_index, bool release_buffer) {
+  auto entry = initialized_tensors_.find(ort_value_index);
+  if (entry == initialized_tensors_.end())
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid ort_value index:", ort_value_index);
+
+  const void* data = entry->second.IsTensor() ? entry->second.Get<Tensor>().DataRaw() : nullptr;
+  initialized_tensors_.erase(entry);
+  constant_initialized_tensors_.erase(ort_value_index);
+
+  auto deleter = deleter_for_initialized_tensors_.find(ort_value_index);
+  if (deleter != deleter_for_initialized_tensors_.end()) {
+    deleter->second.f(deleter->second.param);
+    deleter_for_initialized_tensors_.erase(deleter);
+  }
+
+  if (release_buffer && data != nullptr) {
+    auto buffer = std::find_if(weights_buffers_.begin(), weights_buffers_.end(),
+                               [data](const BufferUniquePtr& b) { return b.get() == data; });
+    if (buffer != weights_buffers_.end()) {
+      weights_buffers_.erase(buffer);
+    }
+  }
+
+  return Status::OK();
+}
+
 const std::unordered_map<int, OrtValue>& SessionState::GetInitializedTensors() const { return initialized_tensors_; }
 
 const std::unordered_map<int, OrtValue>& SessionState::GetConstantInitializedTensors() const {
@@ -148,39 +175,51 @@ void SessionState::SetProfiler(profiling::Profiler& profiler) { profiler_ = &pro
 
 ::onnxruntime::profiling::Profiler& SessionState::Profiler() const { return *profiler_; }
 
-static int64_t CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& shapes) {
-  int64_t key = 0;
-  for (auto shape : shapes) {
-    for (auto dim : shape.get().GetDims()) key ^= dim;
-  }
-  return key;
+void SessionState::SetMemoryPatternCacheOptions(std::vector<int64_t> dim_buckets, size_t max_patterns) {
+  mem_patterns_.Configure(std::move(dim_buckets), max_patterns);
 }
 
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
+MemoryPatternCache::PatternRef SessionState::GetMemoryPatternGroup(
     const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
-
-  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) return nullptr;
-
-  return it->second.get();
+  return mem_patterns_.Find(input_shapes);
 }
 
 Status SessionState::UpdateMemoryPatternGroupCache(
     const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
     std::unique_ptr<MemoryPatternGroup> mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
+  mem_patterns_.Insert(input_shapes, std::move(mem_patterns));
+  return Status::OK();
+}
 
-  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
-    mem_patterns_[key] = std::move(mem_patterns);
+Status SessionState::SetStaticMemoryPatterns(std::unique_ptr<MemoryPatternGroup> mem_patterns) {
+  std::vector<BufferUniquePtr> buffers;
+  for (size_t i = 0; i < mem_patterns->locations.size(); i++) {
+    AllocatorPtr alloc = execution_providers_.get().GetAllocator(mem_patterns->locations[i]);
+    if (!alloc) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "No allocator for ", mem_patterns->locations[i]);
+    }
+    void* buffer = mem_patterns->patterns[i].PeakSize() > 0 ? alloc->Alloc(mem_patterns->patterns[i].PeakSize())
+                                                            : nullptr;
+    buffers.emplace_back(buffer, alloc);
   }
 
+  static_mem_patterns_ = std::move(mem_patterns);
+  static_mem_buffers_ = std::move(buffers);
   return Status::OK();
 }
 
+const std::vector<BufferUniquePtr>* SessionState::AcquireStaticMemoryBuffers() const {
+  bool in_use = false;
+  if (!static_mem_patterns_ || !static_mem_buffers_in_use_.compare_exchange_strong(in_use, true)) {
+    return nullptr;
+  }
+  return &static_mem_buffers_;
+}
+
+void SessionState::ReleaseStaticMemoryBuffers() const {
+  static_mem_buffers_in_use_.store(false);
+}
+
 bool SessionState::GetEnableMemoryPattern() const { return enable_mem_pattern_; }
 
 common::Status SessionState::AddInputNameToNodeInfoMapping(const std::string& input_name, const NodeInfo& node_info) {
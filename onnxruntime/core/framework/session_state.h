@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -18,6 +19,7 @@
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
+#include "core/framework/mem_pattern_cache.h"
 #include "core/framework/ml_value.h"
 #include "core/framework/callback.h"
 #include "core/framework/ort_value_name_idx_map.h"
@@ -95,6 +97,13 @@ class SessionState {
    */
   Status AddInitializedTensor(int ort_value_index, const OrtValue& ort_value, const OrtCallback* d, bool constant);
 
+  /**
+   * Removes an initialized tensor that is no longer needed, e.g. because every kernel consuming it
+   * has pre-packed its content. If 'release_buffer' is true and the tensor was given a weights buffer of
+   * its own, the buffer is freed as well.
+   */
+  Status RemoveInitializedTensor(int ort_value_index, bool release_buffer);
+
   Status SetGraph(const Graph& graph);
   Status CreateKernels(const KernelRegistryManager& custom_registry_manager);
   Status SetGraphAndCreateKernels(const Graph& graph, const KernelRegistryManager& custom_registry_manager) {
@@ -142,9 +151,16 @@ class SessionState {
   profiling::Profiler& Profiler() const;
 
   /**
-  Get cached memory pattern based on input shapes
+  Set how the memory patterns are cached. See MemoryPatternCache::Configure.
+  Must be called before the session runs.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  void SetMemoryPatternCacheOptions(std::vector<int64_t> dim_buckets, size_t max_patterns);
+
+  /**
+  Get cached memory pattern based on input shapes.
+  The pattern is kept alive by the returned reference, as it may be evicted from the cache in the meantime.
+  */
+  MemoryPatternCache::PatternRef GetMemoryPatternGroup(
       const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const;
 
   /**
@@ -154,6 +170,25 @@ class SessionState {
   Status UpdateMemoryPatternGroupCache(const std::vector<std::reference_wrapper<const TensorShape>>& input_shape,
                                        std::unique_ptr<MemoryPatternGroup> mem_patterns) const;
 
+  /**
+  Set the memory patterns planned ahead of time for the static shapes of the graph, and allocate their buffers
+  so that the runs can use them without allocating.
+  */
+  Status SetStaticMemoryPatterns(std::unique_ptr<MemoryPatternGroup> mem_patterns);
+
+  /**
+  Get the memory patterns planned ahead of time, or nullptr if the shapes in the graph aren't all static.
+  */
+  const MemoryPatternGroup* GetStaticMemoryPatterns() const { return static_mem_patterns_.get(); }
+
+  /**
+  Take the buffers of the static memory patterns for a run, one for each of their locations.
+  Returns nullptr if another run is using them. Otherwise they must be given back with ReleaseStaticMemoryBuffers.
+  Thread-safe.
+  */
+  const std::vector<BufferUniquePtr>* AcquireStaticMemoryBuffers() const;
+  void ReleaseStaticMemoryBuffers() const;
+
   /**
   Get enable memory pattern flag
   */
@@ -205,6 +240,13 @@ class SessionState {
   concurrency::ThreadPool* GetThreadPool() const { return thread_pool_; }
   concurrency::ThreadPool* GetInterOpThreadPool() const { return inter_op_thread_pool_; }
 
+  // Use thread pools owned by someone else, e.g. the global thread pools of the environment.
+  // Must be called before the kernels are created.
+  void SetThreadPools(concurrency::ThreadPool* thread_pool, concurrency::ThreadPool* inter_op_thread_pool) {
+    thread_pool_ = thread_pool;
+    inter_op_thread_pool_ = inter_op_thread_pool;
+  }
+
   bool ExportDll() const { return export_fused_dll_; }
   void SetExportDllFlag(bool flag) { export_fused_dll_ = flag; }
 
@@ -244,10 +286,12 @@ class SessionState {
 
   // switch for enable memory pattern optimization or not.
   const bool enable_mem_pattern_;
-  // lock for the mem_patterns_
-  mutable OrtMutex mem_patterns_lock_;
   // cache for the generated mem_patterns. key is calculated based on input shapes.
-  mutable std::map<int64_t, std::unique_ptr<MemoryPatternGroup>> mem_patterns_;
+  mutable MemoryPatternCache mem_patterns_;
+  // memory patterns planned ahead of time if all the shapes are static, and the buffers they are laid out in
+  std::unique_ptr<MemoryPatternGroup> static_mem_patterns_;
+  std::vector<BufferUniquePtr> static_mem_buffers_;
+  mutable std::atomic<bool> static_mem_buffers_in_use_{false};
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -259,8 +303,8 @@ class SessionState {
   SubgraphSessionStateMap subgraph_session_states_;
 
   // It could be NULL
-  concurrency::ThreadPool* const thread_pool_{};
-  concurrency::ThreadPool* const inter_op_thread_pool_{};
+  concurrency::ThreadPool* thread_pool_{};
+  concurrency::ThreadPool* inter_op_thread_pool_{};
 
   bool export_fused_dll_ = false;
   FuncManager fused_funcs_mgr_;
@@ -18,8 +18,11 @@
 #include "core/framework/ml_value.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/prepacked_weights_container.h"
 #include "core/framework/sequential_execution_plan.h"
 #include "core/framework/session_state.h"
+#include "core/framework/static_memory_planner.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 #include "core/framework/mem_buffer.h"
@@ -32,6 +35,7 @@ template <typename T>
 static common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                                              const onnxruntime::Graph& graph, const ExecutionProviders& exec_providers,
                                              const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                             const ExecutionPlanBase& exec_plan,
                                              ITensorAllocator* planner, const T& save_tensor_func,
                                              const logging::Logger& logger,
                                              const DataTransferManager& data_transfer_mgr);
@@ -42,18 +46,25 @@ static common::Status SaveInputOutputNamesToNodeMapping(
     SessionState& session_state,
     const ConstPointerContainer<std::vector<NodeArg*>>* implicit_inputs);
 
+static common::Status PrepackConstantInitializedTensors(const GraphViewer& graph_viewer, SessionState& session_state,
+                                                        PrepackedWeightsContainer* prepacked_weights_container,
+                                                        bool release_weights_buffers,
+                                                        const logging::Logger& logger);
+
 SessionStateInitializer::SessionStateInitializer(bool enable_mem_pattern,
                                                  const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                                                  onnxruntime::Graph& graph, SessionState& session_state,
                                                  const ExecutionProviders& providers,
-                                                 KernelRegistryManager& kernel_registry_manager)
+                                                 KernelRegistryManager& kernel_registry_manager,
+                                                 PrepackedWeightsContainer* prepacked_weights_container)
     : graph_loc_(graph_loc),
       graph_(graph),
       session_state_(session_state),
       execution_providers_(providers),
       kernel_registry_manager_(kernel_registry_manager),
       logger_(session_state.Logger()),
-      enable_mem_pattern_(enable_mem_pattern) {}
+      enable_mem_pattern_(enable_mem_pattern),
+      prepacked_weights_container_(prepacked_weights_container) {}
 
 common::Status SessionStateInitializer::CreatePlan(
     const Node* parent_node,
@@ -87,13 +98,25 @@ common::Status SessionStateInitializer::CreatePlan(
   const auto* exec_plan_ptr = session_state_.GetExecutionPlan();
   ORT_ENFORCE(exec_plan_ptr, "Execution plan was not found in SessionState. CreatePlan must be called first.");
 
+  // if all the shapes are static, the memory of the tensors can be planned now instead of traced by the first run
+  if (session_state_.GetEnableMemoryPattern()) {
+    auto static_mem_patterns = onnxruntime::make_unique<MemoryPatternGroup>();
+    if (PlanStaticMemoryPatterns(*exec_plan_ptr, *graph_viewer, ort_value_name_idx_map, *static_mem_patterns)) {
+      for (size_t i = 0; i < static_mem_patterns->locations.size(); i++) {
+        LOGS(logger_, INFO) << "Planned " << static_mem_patterns->patterns[i].PeakSize() << " bytes on "
+                            << static_mem_patterns->locations[i].ToString() << " for the tensors of the static shapes";
+      }
+      ORT_RETURN_IF_ERROR(session_state_.SetStaticMemoryPatterns(std::move(static_mem_patterns)));
+    }
+  }
+
   std::unique_ptr<ITensorAllocator> tensor_allocator_(ITensorAllocator::Create(
       enable_mem_pattern_, *exec_plan_ptr, execution_providers_, session_state_.GetMutableWeightsBuffers()));
 
   // lambda to save initialized tensors into SessionState directly
   const Env& env = Env::Default();
   ORT_RETURN_IF_ERROR(SaveInitializedTensors(
-      env, graph_loc_, graph_, execution_providers_, ort_value_name_idx_map, tensor_allocator_.get(),
+      env, graph_loc_, graph_, execution_providers_, ort_value_name_idx_map, *exec_plan_ptr, tensor_allocator_.get(),
       [this](int idx, const OrtValue& value, const OrtCallback& d, bool constant) -> Status {
         return session_state_.AddInitializedTensor(idx, value, &d, constant);
       },
@@ -104,18 +127,32 @@ common::Status SessionStateInitializer::CreatePlan(
   graph_.CleanAllInitializedTensors();
 
   ORT_RETURN_IF_ERROR(session_state_.CreateKernels(kernel_registry_manager_));
+
+  // with the memory pattern enabled the weights share one buffer per location, so only a weight that was
+  // given its own buffer can be freed once it has been pre-packed.
+  ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(*graph_viewer, session_state_, prepacked_weights_container_,
+                                                        !enable_mem_pattern_, logger_));
   ORT_RETURN_IF_ERROR(
       SaveInputOutputNamesToNodeMapping(graph_, kernel_registry_manager_, session_state_, outer_scope_node_args));
   return Status::OK();
 }
 
+static bool IsCpuLocation(const OrtMemoryInfo& alloc_info) {
+  return strcmp(alloc_info.name, CPU) == 0 || alloc_info.mem_type == OrtMemTypeCPUOutput;
+}
+
+// a tensor on CPU may use the data the tensor proto refers to in memory, and need no buffer of its own
+static bool UsesInMemoryData(const ONNX_NAMESPACE::TensorProto& tensor_proto, const OrtMemoryInfo& alloc_info) {
+  return IsCpuLocation(alloc_info) && utils::UsesInMemoryData(tensor_proto);
+}
+
 static common::Status DeserializeTensorProto(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& proto_path,
                                              const ONNX_NAMESPACE::TensorProto& tensor_proto, const MemBuffer& m,
                                              const ExecutionProviders& exec_providers, OrtValue& ort_value,
                                              OrtCallback& deleter,
                                              const DataTransferManager& data_transfer_mgr) {
   const OrtMemoryInfo& alloc_info = m.GetAllocInfo();
-  if (strcmp(alloc_info.name, CPU) == 0 || alloc_info.mem_type == OrtMemTypeCPUOutput) {
+  if (IsCpuLocation(alloc_info)) {
     // deserialize directly to CPU tensor
     return utils::TensorProtoToMLValue(env, proto_path.c_str(), tensor_proto, m, ort_value, deleter);
   }
@@ -173,7 +210,8 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
 template <typename T>
 common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                                       const Graph& graph, const ExecutionProviders& exec_providers,
-                                      const OrtValueNameIdxMap& ort_value_name_idx_map, ITensorAllocator* planner,
+                                      const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                      const ExecutionPlanBase& exec_plan, ITensorAllocator* planner,
                                       const T& save_tensor_func, const logging::Logger& logger,
                                       const DataTransferManager& data_transfer_mgr) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
@@ -188,6 +226,9 @@ common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PA
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
   for (const auto& entry : id_to_initialized_tensor) {
+    if (UsesInMemoryData(*entry.second, exec_plan.GetLocation(entry.first))) {
+      continue;
+    }
     ORT_RETURN_IF_ERROR(planner->Trace(entry.first, entry.second));
   }
 
@@ -201,8 +242,13 @@ common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PA
     const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
 
     std::unique_ptr<MemBuffer> m;
-    // TODO: if the tensor need be copied, does it have enough room?
-    ORT_RETURN_IF_ERROR(planner->GetPreallocatedBuffer(ort_value_index, name, m));
+    const OrtMemoryInfo& location = exec_plan.GetLocation(ort_value_index);
+    if (UsesInMemoryData(tensor_proto, location)) {
+      m = onnxruntime::make_unique<MemBuffer>(nullptr, 0, location);
+    } else {
+      // TODO: if the tensor need be copied, does it have enough room?
+      ORT_RETURN_IF_ERROR(planner->GetPreallocatedBuffer(ort_value_index, name, m));
+    }
 #ifndef NDEBUG
     ORT_ENFORCE(m != nullptr);
     ORT_ENFORCE(m->GetBuffer() != nullptr || m->GetLen() == 0);
@@ -225,6 +271,125 @@ common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PA
   return common::Status::OK();
 }
 
+// Hand the buffers packed by 'kernel' to the container so that sessions loading the same model share one copy,
+// and give the kernel the shared buffers to use.
+static common::Status UseSharedPrePackedWeights(const Node& node, int input_idx, OpKernel& kernel,
+                                                PrePackedWeights& packed_weights,
+                                                PrepackedWeightsContainer& prepacked_weights_container) {
+  const std::string key = node.Domain() + "+" + node.OpType() + "+" + std::to_string(input_idx) + "+" +
+                          std::to_string(packed_weights.GetHash());
+
+  std::vector<BufferUniquePtr> buffers;
+  const PrePackedWeights* shared_weights = prepacked_weights_container.GetOrAddWeight(key, packed_weights);
+  if (shared_weights != nullptr) {
+    // the container owns the shared buffers so hand out non-owning pointers
+    for (const auto& buffer : shared_weights->buffers_) {
+      buffers.emplace_back(buffer.get(), BufferDeleter(nullptr));
+    }
+  } else {
+    // content differs from an existing entry with the same key. keep the buffers private to this kernel.
+    buffers = std::move(packed_weights.buffers_);
+  }
+
+  bool used_shared_buffers = false;
+  ORT_RETURN_IF_ERROR(kernel.UseSharedPrePackedBuffers(buffers, input_idx, used_shared_buffers));
+  if (!used_shared_buffers) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Kernel for node ", node.Name(),
+                           " pre-packed input ", input_idx, " but did not use the pre-packed buffers.");
+  }
+
+  return Status::OK();
+}
+
+common::Status PrepackConstantInitializedTensors(const GraphViewer& graph_viewer, SessionState& session_state,
+                                                 PrepackedWeightsContainer* prepacked_weights_container,
+                                                 bool release_weights_buffers,
+                                                 const logging::Logger& logger) {
+  const auto& constant_initialized_tensors = session_state.GetConstantInitializedTensors();
+  if (constant_initialized_tensors.empty()) {
+    return Status::OK();
+  }
+
+  const auto& ort_value_name_idx_map = session_state.GetOrtValueNameIdxMap();
+
+  // count the uses of each constant initializer. an initializer can only be released once every use has been
+  // pre-packed. implicit inputs (consumed by a subgraph) and graph outputs always need the original tensor.
+  std::unordered_map<int, size_t> use_counts;
+  auto add_use = [&](const NodeArg& arg) -> Status {
+    if (!arg.Exists()) {
+      return Status::OK();
+    }
+    int ort_value_index;
+    ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(arg.Name(), ort_value_index));
+    if (constant_initialized_tensors.find(ort_value_index) != constant_initialized_tensors.cend()) {
+      ++use_counts[ort_value_index];
+    }
+    return Status::OK();
+  };
+
+  for (const auto& node : graph_viewer.Nodes()) {
+    for (const auto* input_def : node.InputDefs()) {
+      ORT_RETURN_IF_ERROR(add_use(*input_def));
+    }
+    for (const auto* input_def : node.ImplicitInputDefs()) {
+      ORT_RETURN_IF_ERROR(add_use(*input_def));
+    }
+  }
+  for (const auto* output_def : graph_viewer.GetOutputs()) {
+    ORT_RETURN_IF_ERROR(add_use(*output_def));
+  }
+
+  for (const auto& node : graph_viewer.Nodes()) {
+    OpKernel* kernel = session_state.GetMutableKernel(node.Index());
+    if (kernel == nullptr) {
+      continue;
+    }
+
+    // the container allocates CPU memory so only share the weights packed by CPU kernels
+    const bool share_weights = prepacked_weights_container != nullptr &&
+                               node.GetExecutionProviderType() == kCpuExecutionProvider;
+
+    const auto& input_defs = node.InputDefs();
+    for (size_t i = 0, end = input_defs.size(); i < end; ++i) {
+      if (!input_defs[i]->Exists()) {
+        continue;
+      }
+
+      int ort_value_index;
+      ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(input_defs[i]->Name(), ort_value_index));
+      auto entry = constant_initialized_tensors.find(ort_value_index);
+      if (entry == constant_initialized_tensors.cend() || !entry->second.IsTensor()) {
+        continue;
+      }
+
+      const int input_idx = static_cast<int>(i);
+      const Tensor& tensor = entry->second.Get<Tensor>();
+      AllocatorPtr alloc = share_weights ? prepacked_weights_container->GetAllocator()
+                                         : kernel->Info().GetAllocator(0, OrtMemTypeDefault);
+
+      PrePackedWeights packed_weights;
+      bool is_packed = false;
+      ORT_RETURN_IF_ERROR(kernel->PrePack(tensor, input_idx, alloc, is_packed,
+                                          share_weights ? &packed_weights : nullptr));
+      if (!is_packed) {
+        continue;
+      }
+
+      if (share_weights) {
+        ORT_RETURN_IF_ERROR(UseSharedPrePackedWeights(node, input_idx, *kernel, packed_weights,
+                                                      *prepacked_weights_container));
+      }
+
+      if (--use_counts[ort_value_index] == 0) {
+        VLOGS(logger, 1) << "Releasing pre-packed initializer " << input_defs[i]->Name();
+        ORT_RETURN_IF_ERROR(session_state.RemoveInitializedTensor(ort_value_index, release_weights_buffers));
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
 template <typename T>  // T is container of const NodeArg* or NodeArg*
 static bool IsArgNameInInputsOutputs(const std::string& name,
                                      const T& graph_args) {
@@ -19,6 +19,7 @@ class InsertCastTransformer;
 class KernelRegistryManager;
 class Node;
 class NodeArg;
+class PrepackedWeightsContainer;
 class SessionState;
 
 namespace logging {
@@ -31,13 +32,16 @@ class SessionStateInitializer {
   /**
    *
    * \param graph_loc The file path of where the graph was loaded. e.g. /tmp/test_squeezenet/model.onnx
+   * \param prepacked_weights_container Optional container to share pre-packed weights with other sessions.
    */
   SessionStateInitializer(bool enable_mem_pattern, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                           onnxruntime::Graph& graph, SessionState& session_state, const ExecutionProviders& providers,
-                          KernelRegistryManager& kernel_registry_manager);
+                          KernelRegistryManager& kernel_registry_manager,
+                          PrepackedWeightsContainer* prepacked_weights_container = nullptr);
 
   // First perform any transformations and create the execution plan
-  // Then initialize tensors, and save. save kernels and input/output node mappings
+  // Then initialize tensors, and save. save kernels, let them pre-pack constant initializers,
+  // and save input/output node mappings
   common::Status CreatePlan(_In_opt_ const Node* parent_node,
                             _In_opt_ const ConstPointerContainer<std::vector<NodeArg*>>* outer_scope_node_args,
                             ExecutionMode execution_mode);
@@ -51,5 +55,6 @@ class SessionStateInitializer {
   KernelRegistryManager& kernel_registry_manager_;
   const logging::Logger& logger_;
   const bool enable_mem_pattern_;
+  PrepackedWeightsContainer* const prepacked_weights_container_;
 };
 }  // namespace onnxruntime
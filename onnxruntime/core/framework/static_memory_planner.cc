@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/static_memory_planner.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <numeric>
+#include "core/common/safeint.h"
+#include "core/framework/data_types.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/framework/utils.h"
+
+namespace onnxruntime {
+
+void StaticMemoryPlanner::AddTensor(int ml_value_idx, size_t size, size_t first_step, size_t last_step) {
+  ORT_ENFORCE(first_step <= last_step, "Tensor ", ml_value_idx, " is freed before it's created");
+  tensors_.push_back({ml_value_idx, size, first_step, last_step});
+}
+
+MemoryPattern StaticMemoryPlanner::GenerateMemPattern() const {
+  std::vector<size_t> order(tensors_.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    return tensors_[a].size > tensors_[b].size;
+  });
+
+  MemoryPattern pattern;
+  SafeInt<size_t> buffer_size{0};
+  std::vector<size_t> offsets(tensors_.size(), 0);
+  // the tensors placed so far, in order of offset
+  std::vector<size_t> placed;
+  placed.reserve(tensors_.size());
+
+  for (size_t i : order) {
+    const TensorLifetime& tensor = tensors_[i];
+    if (tensor.size == 0) {
+      pattern.patterns_[tensor.index] = MemoryBlock(0, 0);
+      continue;
+    }
+
+    // take the smallest gap between the placed tensors alive at the same time, or go after the last of them
+    size_t current = 0;
+    size_t best_offset = 0;
+    size_t waste_bytes = std::numeric_limits<size_t>::max();
+    bool found_gap = false;
+    for (size_t p : placed) {
+      const TensorLifetime& other = tensors_[p];
+      if (!tensor.Overlaps(other)) continue;
+
+      if (offsets[p] >= current) {
+        const size_t gap = offsets[p] - current;
+        if (gap >= tensor.size && gap - tensor.size < waste_bytes) {
+          waste_bytes = gap - tensor.size;
+          best_offset = current;
+          found_gap = true;
+        }
+      }
+      current = std::max(current, offsets[p] + other.size);
+    }
+    if (!found_gap) {
+      best_offset = current;
+    }
+
+    buffer_size = std::max(buffer_size, SafeInt<size_t>(best_offset) + tensor.size);
+    offsets[i] = best_offset;
+    pattern.patterns_[tensor.index] = MemoryBlock(best_offset, tensor.size);
+
+    auto insert_at = std::upper_bound(placed.begin(), placed.end(), best_offset,
+                                      [&offsets](size_t offset, size_t p) { return offset < offsets[p]; });
+    placed.insert(insert_at, i);
+  }
+
+  pattern.peak_size_ = buffer_size;
+  return pattern;
+}
+
+bool PlanStaticMemoryPatterns(const SequentialExecutionPlan& plan, const GraphViewer& graph_viewer,
+                              const OrtValueNameIdxMap& ort_value_name_idx_map, MemoryPatternGroup& patterns) {
+  const auto& allocation_plan = plan.allocation_plan;
+  const size_t num_steps = plan.execution_plan.size();
+
+  // a tensor is freed after the step that releases it, or lives to the end of the run
+  std::vector<size_t> last_steps(allocation_plan.size(), num_steps > 0 ? num_steps - 1 : 0);
+  for (size_t step = 0; step < num_steps; ++step) {
+    const auto& node_plan = plan.execution_plan[step];
+    for (int i = node_plan.free_from_index; i <= node_plan.free_to_index; ++i) {
+      last_steps[plan.to_be_freed[i]] = step;
+    }
+  }
+
+  std::map<OrtMemoryInfo, StaticMemoryPlanner> planners;
+  for (size_t step = 0; step < num_steps; ++step) {
+    const Node* node = graph_viewer.GetNode(plan.execution_plan[step].node_index);
+    if (node == nullptr) continue;
+
+    for (const NodeArg* output_def : node->OutputDefs()) {
+      int ort_value_idx;
+      if (!output_def->Exists() || !ort_value_name_idx_map.GetIdx(output_def->Name(), ort_value_idx).IsOK()) {
+        continue;
+      }
+
+      const auto& per_alloc_plan = allocation_plan[ort_value_idx];
+      const auto* ml_type = per_alloc_plan.value_type;
+      if (per_alloc_plan.alloc_kind != AllocKind::kAllocate || ml_type == nullptr || !ml_type->IsTensorType()) {
+        continue;
+      }
+
+      const auto* element_type = static_cast<const TensorTypeBase*>(ml_type)->GetElementType();
+      if (utils::IsDataTypeString(element_type)) continue;
+
+      const auto* shape_proto = output_def->Shape();
+      if (shape_proto == nullptr) return false;
+      for (const auto& dim : shape_proto->dim()) {
+        if (!dim.has_dim_value() || dim.dim_value() < 0) return false;
+      }
+
+      // the same size the execution frame asks for
+      const int64_t num_elements = utils::GetTensorShapeFromTensorShapeProto(*shape_proto).Size();
+      size_t size;
+      if (!IAllocator::CalcMemSizeForArrayWithAlignment<64>(static_cast<size_t>(num_elements), element_type->Size(),
+                                                            &size)) {
+        return false;
+      }
+
+      planners[per_alloc_plan.location].AddTensor(ort_value_idx, size, step, std::max(step, last_steps[ort_value_idx]));
+    }
+  }
+
+  patterns.locations.clear();
+  patterns.patterns.clear();
+  for (const auto& location_planner : planners) {
+    patterns.locations.push_back(location_planner.first);
+    patterns.patterns.push_back(location_planner.second.GenerateMemPattern());
+  }
+
+  return true;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <vector>
+#include "core/framework/mem_pattern.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+/*
+StaticMemoryPlanner assigns the offsets of tensors in one buffer ahead of time, from their sizes and lifetimes.
+
+The MemPatternPlanner places the tensors in the order a run allocates them, and the allocation plan only reuses the
+buffer of a tensor of exactly the same size. Knowing every lifetime up front, the tensors can be placed greedily by
+size instead: the largest ones first, each in the smallest gap left between the tensors already placed that are
+alive at the same time. Tensors of any size that are never alive at the same time overlap.
+*/
+class StaticMemoryPlanner {
+ public:
+  StaticMemoryPlanner() = default;
+
+  // The tensor is alive from the step of the execution plan that creates it to last_step, inclusive.
+  void AddTensor(int ml_value_idx, size_t size, size_t first_step, size_t last_step);
+
+  MemoryPattern GenerateMemPattern() const;
+
+ private:
+  struct TensorLifetime {
+    int index;
+    size_t size;
+    size_t first_step;
+    size_t last_step;
+
+    bool Overlaps(const TensorLifetime& other) const {
+      return first_step <= other.last_step && other.first_step <= last_step;
+    }
+  };
+
+  std::vector<TensorLifetime> tensors_;
+};
+
+/**
+Plan the memory of all the tensors the execution plan allocates, in one buffer per location, if all their shapes
+are known. Graph outputs, strings and non-tensor values are left out, as they aren't placed in memory patterns.
+@returns false if the shape of a tensor isn't static, in which case patterns is left unchanged.
+*/
+bool PlanStaticMemoryPatterns(const SequentialExecutionPlan& plan, const GraphViewer& graph_viewer,
+                              const OrtValueNameIdxMap& ort_value_name_idx_map, MemoryPatternGroup& patterns);
+
+}  // namespace onnxruntime
@@ -3,9 +3,13 @@
 
 #include "core/framework/tensorprotoutils.h"
 
+#include <cerrno>
+#include <cstdlib>
 #include <memory>
 #include <algorithm>
 #include <limits>
+#include <map>
+#include <mutex>
 #include <gsl/gsl>
 
 #include "core/common/logging/logging.h"
@@ -18,6 +22,8 @@
 #include "core/framework/callback.h"
 #include "core/framework/data_types.h"
 #include "core/framework/path_lib.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/ort_mutex.h"
 #include "core/session/ort_apis.h"
 
 using namespace ONNX_NAMESPACE;
@@ -369,6 +375,79 @@ static void MoveOrtCallback(OrtCallback& from, OrtCallback& to) {
   from.param = nullptr;
 }
 
+// The blocks of memory that tensor protos may refer to as external data in memory, by address
+static OrtMutex in_memory_external_data_mutex;
+static std::map<uintptr_t, size_t> in_memory_external_data_blocks;
+
+void RegisterInMemoryExternalData(const void* data, size_t length) {
+  std::lock_guard<OrtMutex> lock(in_memory_external_data_mutex);
+  in_memory_external_data_blocks[reinterpret_cast<uintptr_t>(data)] = length;
+}
+
+void UnregisterInMemoryExternalData(const void* data) {
+  std::lock_guard<OrtMutex> lock(in_memory_external_data_mutex);
+  in_memory_external_data_blocks.erase(reinterpret_cast<uintptr_t>(data));
+}
+
+static bool ParseUInt64(const std::string& str, uint64_t& value) {
+  if (str.empty() || str.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+  errno = 0;
+  value = std::strtoull(str.c_str(), nullptr, 10);
+  return errno == 0;
+}
+
+Status GetInMemoryExternalData(const ONNX_NAMESPACE::TensorProto& tensor_proto, const void*& data, size_t& length) {
+  if (!HasInMemoryExternalData(tensor_proto)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Tensor '", tensor_proto.name(),
+                           "' doesn't refer to its data in memory");
+  }
+  uint64_t address = 0;
+  uint64_t num_bytes = 0;
+  bool has_address = false;
+  bool has_length = false;
+  for (const auto& entry : tensor_proto.external_data()) {
+    if (entry.key() == "offset") {
+      has_address = ParseUInt64(entry.value(), address);
+    } else if (entry.key() == "length") {
+      has_length = ParseUInt64(entry.value(), num_bytes);
+    }
+  }
+
+  // only the data in a registered block is used. anything else, e.g. an address in a model file, is rejected.
+  bool registered = false;
+  if (has_address && has_length && address <= std::numeric_limits<uintptr_t>::max()) {
+    std::lock_guard<OrtMutex> lock(in_memory_external_data_mutex);
+    auto block = in_memory_external_data_blocks.upper_bound(static_cast<uintptr_t>(address));
+    if (block != in_memory_external_data_blocks.begin()) {
+      --block;
+      const uint64_t offset = address - block->first;
+      registered = offset <= block->second && num_bytes <= block->second - offset;
+    }
+  }
+  if (!registered) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Tensor '", tensor_proto.name(),
+                           "' refers to data in memory that wasn't loaded with the model");
+  }
+
+  data = reinterpret_cast<const void*>(static_cast<uintptr_t>(address));
+  length = static_cast<size_t>(num_bytes);
+  return Status::OK();
+}
+
+bool UsesInMemoryData(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  const void* data;
+  size_t length;
+  if (endian::native != endian::little || !HasInMemoryExternalData(tensor_proto) ||
+      !GetInMemoryExternalData(tensor_proto, data, length).IsOK()) {
+    return false;
+  }
+  // the data can be anywhere in the model file, so it's only used in place if it's aligned like the buffers the
+  // CPU allocator returns
+  return reinterpret_cast<uintptr_t>(data) % MlasGetPreferredBufferAlignment() == 0;
+}
+
 Status TensorProtoToMLValue(const Env& env, const ORTCHAR_T* tensor_proto_path,
                             const ONNX_NAMESPACE::TensorProto& tensor_proto, const MemBuffer& m, OrtValue& value,
                             OrtCallback& deleter) {
@@ -380,12 +459,25 @@ Status TensorProtoToMLValue(const Env& env, const ORTCHAR_T* tensor_proto_path,
   size_t raw_data_len = 0;
   const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
   AutoDelete deleter_for_file_data;
+  // the data is in memory that outlives the tensor, e.g. a mapped model file, so it's used without a deleter
+  const bool data_in_memory = UsesInMemoryData(tensor_proto);
   void* tensor_data;
   {
+    const void* in_memory_data = nullptr;
     if (tensor_proto.data_location() == TensorProto_DataLocation_EXTERNAL) {
       if (ele_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING)
         return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "string tensor can not have raw data");
-
+    }
+    if (utils::HasInMemoryExternalData(tensor_proto)) {
+      ORT_RETURN_IF_ERROR(utils::GetInMemoryExternalData(tensor_proto, in_memory_data, raw_data_len));
+      size_t expected_len;
+      ORT_RETURN_IF_ERROR(GetSizeInBytesFromTensorProto<0>(tensor_proto, &expected_len));
+      if (raw_data_len != expected_len) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The data of tensor '", tensor_proto.name(), "' has ",
+                               raw_data_len, " bytes, expected ", expected_len);
+      }
+      raw_data = const_cast<void*>(in_memory_data);
+    } else if (tensor_proto.data_location() == TensorProto_DataLocation_EXTERNAL) {
       std::unique_ptr<ExternalDataInfo> external_data_info;
       ORT_RETURN_IF_ERROR(ExternalDataInfo::Create(tensor_proto.external_data(), external_data_info));
       std::basic_string<ORTCHAR_T> full_path;
@@ -412,7 +504,8 @@ Status TensorProtoToMLValue(const Env& env, const ORTCHAR_T* tensor_proto_path,
       //raw_data = buffer.release();
       raw_data_len = tensor_proto.raw_data().size();
     }
-    if (endian::native == endian::little && raw_data != nullptr && deleter_for_file_data.d.f != nullptr) {
+    if (raw_data != nullptr &&
+        (data_in_memory || (endian::native == endian::little && deleter_for_file_data.d.f != nullptr))) {
       tensor_data = raw_data;
       MoveOrtCallback(deleter_for_file_data.d, deleter);
     } else {
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <type_traits>
 
@@ -35,6 +37,12 @@ common::Status TensorProtoToMLValue(const Env& env, const ORTCHAR_T* tensor_prot
                                     const ONNX_NAMESPACE::TensorProto& input, const MemBuffer& m, OrtValue& value,
                                     OrtCallback& deleter);
 
+/**
+ * Whether TensorProtoToMLValue creates the tensor on the data the tensor proto refers to in memory, rather than
+ * copying the data into the preallocated buffer, which then isn't needed.
+ */
+bool UsesInMemoryData(const ONNX_NAMESPACE::TensorProto& tensor_proto);
+
 /** Creates a TensorProto from a Tensor.
     @param[in] tensor the Tensor whose data and shape will be used to create the TensorProto.
     @param[in] tensor_proto_name the name of the TensorProto.
@@ -98,6 +106,55 @@ inline bool HasDataType(const ONNX_NAMESPACE::TensorProto& ten_proto) {
   return ten_proto.data_type() != ONNX_NAMESPACE::TensorProto::UNDEFINED;
 }
 
+// The 'location' of external data that is already in memory. Its 'offset' is the address of the data.
+// See Model::LoadWithMappedInitializers.
+constexpr const char* kTensorProtoMemoryAddressTag = "*/_ORT_MEM_ADDR_/*";
+
+// Make the tensor refer to its raw data in memory rather than hold a copy. The data must be in memory registered with
+// RegisterInMemoryExternalData, and outlive the tensor proto and the tensors created from it.
+inline void SetInMemoryExternalData(const void* data, size_t length, ONNX_NAMESPACE::TensorProto& ten_proto) {
+  ten_proto.clear_raw_data();
+  ten_proto.clear_external_data();
+  ten_proto.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
+  auto* location = ten_proto.add_external_data();
+  location->set_key("location");
+  location->set_value(kTensorProtoMemoryAddressTag);
+  auto* offset = ten_proto.add_external_data();
+  offset->set_key("offset");
+  offset->set_value(std::to_string(reinterpret_cast<uintptr_t>(data)));
+  auto* len = ten_proto.add_external_data();
+  len->set_key("length");
+  len->set_value(std::to_string(length));
+}
+
+// Whether the tensor claims to refer to its raw data in memory. Only GetInMemoryExternalData checks the claim.
+inline bool HasInMemoryExternalData(const ONNX_NAMESPACE::TensorProto& ten_proto) {
+  if (ten_proto.data_location() != ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL) {
+    return false;
+  }
+  for (const auto& entry : ten_proto.external_data()) {
+    if (entry.key() == "location") {
+      return entry.value() == kTensorProtoMemoryAddressTag;
+    }
+  }
+  return false;
+}
+
+/**
+ * Get the raw data of a tensor that refers to it in memory (see HasInMemoryExternalData).
+ * Fails unless the data is within a block of memory registered with RegisterInMemoryExternalData, so a tensor proto
+ * that comes from a model can't make us read arbitrary memory.
+ */
+common::Status GetInMemoryExternalData(const ONNX_NAMESPACE::TensorProto& ten_proto, const void*& data,
+                                       size_t& length);
+
+/**
+ * Register a block of memory, e.g. a mapped model file, that tensor protos may refer to with SetInMemoryExternalData.
+ * It must be unregistered before it's released.
+ */
+void RegisterInMemoryExternalData(const void* data, size_t length);
+void UnregisterInMemoryExternalData(const void* data);
+
 inline bool HasName(const ONNX_NAMESPACE::TensorProto& ten_proto) {
   return ten_proto.has_name();  // XXX
 }
@@ -517,6 +517,60 @@ common::Status ExecuteGraph(const SessionState& session_state,
   return status;
 }
 
+// check if the feeds and pre-allocated fetches are on the devices the static copy info expects,
+// in which case no copies are needed.
+static bool FeedsAndFetchesOnExpectedDevices(const FeedsFetchesManager& feeds_fetches_manager,
+                                             const std::vector<OrtValue>& feeds,
+                                             const std::vector<OrtValue>& fetches) {
+  const auto& feed_copy_info = feeds_fetches_manager.GetFeedsDeviceCopyInfo();
+  for (size_t i = 0, end = feeds.size(); i < end; ++i) {
+    const auto& feed = feeds[i];
+    OrtDevice feed_device = feed.IsTensor() ? feed.Get<Tensor>().Location().device : OrtDevice();
+    if (feed_device != feed_copy_info[i].target_device) {
+      return false;
+    }
+  }
+
+  const auto& fetch_copy_info = feeds_fetches_manager.GetFetchesDeviceCopyInfo();
+  for (size_t i = 0, end = fetch_copy_info.size(); i < end; ++i) {
+    // fetches that are not pre-allocated are returned on CPU
+    OrtDevice fetch_device;
+    if (i < fetches.size() && fetches[i].IsAllocated() && fetches[i].IsTensor()) {
+      fetch_device = fetches[i].Get<Tensor>().Location().device;
+    }
+    if (fetch_device != fetch_copy_info[i].source_device) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+common::Status ExecuteGraph(const SessionState& session_state,
+                            const FeedsFetchesManager& feeds_fetches_manager,
+                            const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                            ExecutionMode execution_mode, const bool& terminate_flag,
+                            const logging::Logger& logger) {
+  // if no copies are possible, or the inputs and outputs are already where they need to be, the cached manager
+  // can be used as-is. ExecuteGraphImpl only copies when the checks say Copy.
+  if (feeds_fetches_manager.GetDeviceCopyChecks().status == DeviceCopyCheck::NoCopy ||
+      FeedsAndFetchesOnExpectedDevices(feeds_fetches_manager, feeds, fetches)) {
+    return ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
+                            execution_mode, terminate_flag, logger);
+  }
+
+  // copies are required. finalize a per-call copy of the manager so the cached one is not modified.
+  FeedsFetchesInfo info = feeds_fetches_manager.GetFeedsFetchesInfo();
+  FeedsFetchesManager run_feeds_fetches_manager{std::move(info)};
+  run_feeds_fetches_manager.GetMutableFeedsDeviceCopyInfo() = feeds_fetches_manager.GetFeedsDeviceCopyInfo();
+  run_feeds_fetches_manager.GetMutableFetchesDeviceCopyInfo() = feeds_fetches_manager.GetFetchesDeviceCopyInfo();
+
+  FinalizeFeedFetchCopyInfo(session_state, run_feeds_fetches_manager, feeds, fetches);
+
+  return ExecuteGraphImpl(session_state, run_feeds_fetches_manager, feeds, fetches, {},
+                          execution_mode, terminate_flag, logger);
+}
+
 common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
                                const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                                const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
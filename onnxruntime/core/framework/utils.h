@@ -70,6 +70,13 @@ common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManag
                             const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                             ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger);
 
+// Execute the main graph using a feeds_fetches_manager that was set up once with InitializeFeedFetchCopyInfo and is
+// reused across calls. The manager is not modified so it can be shared by concurrent calls. If the feeds and any
+// pre-allocated fetches are on the expected devices no per-call copy info is created.
+common::Status ExecuteGraph(const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
+                            const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                            ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger);
+
 // Execute a subgraph. The feeds_fetches_manager should have been finalized prior to calling this function.
 // See IControlFlowNode::SetupSubgraphExecutionInfo usage in the control flow kernels.
 common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
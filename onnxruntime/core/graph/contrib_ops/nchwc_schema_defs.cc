@@ -147,6 +147,51 @@ void RegisterNchwcSchemas() {
 
   ONNX_CONTRIB_OPERATOR_SCHEMA(GlobalAveragePool)
       .FillUsing(NchwcGlobalPoolOpSchemaGenerator);
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(Upsample)
+      .SetDomain(kMSNchwcDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(For internal use.)DOC")
+      .Attr("scales", "", AttributeProto::INTS)
+      .Attr("mode", "", AttributeProto::STRING, std::string("nearest"))
+      .Attr("coordinate_transformation_mode", "", AttributeProto::STRING, std::string("asymmetric"))
+      .Input(0, "X", "", "T")
+      .Output(0, "Y", "", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasNInputShapes(ctx, 1)) {
+          return;
+        }
+
+        auto& input_shape = getInputShape(ctx, 0);
+        auto* output_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+
+        auto input_rank = input_shape.dim_size();
+        std::vector<int64_t> scales;
+        if (!getRepeatedAttribute(ctx, "scales", scales) || scales.size() != static_cast<size_t>(input_rank)) {
+          fail_shape_inference("scales must match the input rank");
+        }
+
+        for (int i = 0; i < input_rank; i++) {
+          auto* output_dim = output_shape->add_dim();
+          if (input_shape.dim(i).has_dim_value()) {
+            output_dim->set_dim_value(input_shape.dim(i).dim_value() * scales[i]);
+          } else if (scales[i] == 1) {
+            *output_dim = input_shape.dim(i);
+          }
+        }
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(ScaleChannels)
+      .SetDomain(kMSNchwcDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(For internal use.)DOC")
+      .Input(0, "X", "", "T")
+      .Input(1, "Scale", "", "T")
+      .Output(0, "Y", "", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
 }
 
 }  // namespace contrib
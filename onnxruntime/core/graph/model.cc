@@ -26,6 +26,53 @@ using namespace onnxruntime;
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
+// Tensors may only refer to their data in memory if the mapped loader set them up to, which it does for initializers
+// of the main graph in memory it registered. Anywhere else, e.g. in a model file, the reserved location is rejected
+// rather than trusted as an address.
+static Status ValidateInMemoryExternalData(const TensorProto& tensor, bool allow_in_memory_data) {
+  if (!utils::HasInMemoryExternalData(tensor)) {
+    return Status::OK();
+  }
+  if (!allow_in_memory_data) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Tensor '", tensor.name(),
+                           "' has external data with the reserved location ", utils::kTensorProtoMemoryAddressTag);
+  }
+  const void* data;
+  size_t length;
+  return utils::GetInMemoryExternalData(tensor, data, length);
+}
+
+static Status ValidateInMemoryExternalData(const SparseTensorProto& tensor) {
+  ORT_RETURN_IF_ERROR(ValidateInMemoryExternalData(tensor.values(), false));
+  return ValidateInMemoryExternalData(tensor.indices(), false);
+}
+
+static Status ValidateInMemoryExternalData(const GraphProto& graph, bool allow_mapped_initializers) {
+  for (const auto& initializer : graph.initializer()) {
+    ORT_RETURN_IF_ERROR(ValidateInMemoryExternalData(initializer, allow_mapped_initializers));
+  }
+  for (const auto& initializer : graph.sparse_initializer()) {
+    ORT_RETURN_IF_ERROR(ValidateInMemoryExternalData(initializer));
+  }
+  for (const auto& node : graph.node()) {
+    for (const auto& attr : node.attribute()) {
+      ORT_RETURN_IF_ERROR(ValidateInMemoryExternalData(attr.t(), false));
+      for (const auto& tensor : attr.tensors()) {
+        ORT_RETURN_IF_ERROR(ValidateInMemoryExternalData(tensor, false));
+      }
+      ORT_RETURN_IF_ERROR(ValidateInMemoryExternalData(attr.sparse_tensor()));
+      for (const auto& tensor : attr.sparse_tensors()) {
+        ORT_RETURN_IF_ERROR(ValidateInMemoryExternalData(tensor));
+      }
+      ORT_RETURN_IF_ERROR(ValidateInMemoryExternalData(attr.g(), false));
+      for (const auto& subgraph : attr.graphs()) {
+        ORT_RETURN_IF_ERROR(ValidateInMemoryExternalData(subgraph, false));
+      }
+    }
+  }
+  return Status::OK();
+}
+
 Model::Model(const std::string& graph_name,
              bool is_onnx_domain_only,
              const ModelMetaData& model_metadata,
@@ -80,7 +127,7 @@ Model::Model(const ModelProto& model_proto, const IOnnxRuntimeOpSchemaRegistryLi
 }
 
 Model::Model(std::unique_ptr<ModelProto> model_proto, const IOnnxRuntimeOpSchemaRegistryList* local_registries,
-             const logging::Logger& logger) {
+             const logging::Logger& logger, bool allow_mapped_initializers) {
   if (!model_proto) {
     throw std::invalid_argument("ModelProto was null.");
   }
@@ -89,6 +136,11 @@ Model::Model(std::unique_ptr<ModelProto> model_proto, const IOnnxRuntimeOpSchema
     throw std::invalid_argument("ModelProto does not have a graph.");
   }
 
+  auto status = ValidateInMemoryExternalData(model_proto->graph(), allow_mapped_initializers);
+  if (!status.IsOK()) {
+    throw std::invalid_argument(status.ErrorMessage());
+  }
+
   if (model_proto->opset_import_size() == 0) {
     throw std::invalid_argument(
         "Missing opset in the model. All ModelProtos MUST have at least one entry that"
@@ -269,7 +321,7 @@ Status Model::Load(const ModelProto& model_proto, std::shared_ptr<Model>& model,
 
 Status Model::Load(std::unique_ptr<ModelProto> p_model_proto, std::shared_ptr<Model>& model,
                    const IOnnxRuntimeOpSchemaRegistryList* local_registries,
-                   const logging::Logger& logger) {
+                   const logging::Logger& logger, bool allow_mapped_initializers) {
   // we expect a graph to be present
   if (!utils::HasGraph(*p_model_proto)) {
     return Status(ONNXRUNTIME, INVALID_ARGUMENT, "No graph was found in the protobuf.");
@@ -278,7 +330,7 @@ Status Model::Load(std::unique_ptr<ModelProto> p_model_proto, std::shared_ptr<Mo
   // need to call private ctor so can't use make_shared
   GSL_SUPPRESS(r .11)
   try {
-    model.reset(new Model(std::move(p_model_proto), local_registries, logger));
+    model.reset(new Model(std::move(p_model_proto), local_registries, logger, allow_mapped_initializers));
   } catch (const std::exception& ex) {
     return Status(ONNXRUNTIME, INVALID_ARGUMENT, "Failed to load model with error: " + std::string(ex.what()));
   }
@@ -452,6 +504,261 @@ Status Model::Load(int fd, std::shared_ptr<Model>& p_model, const IOnnxRuntimeOp
   return Status::OK();
 }
 
+namespace {
+// The numbers of the fields that lead to the raw data of the initializers, see onnx.proto
+constexpr uint32_t kModelProtoGraph = 7;
+constexpr uint32_t kGraphProtoInitializer = 5;
+constexpr uint32_t kTensorProtoDataType = 2;
+constexpr uint32_t kTensorProtoRawData = 9;
+constexpr uint32_t kTensorProtoExternalData = 13;
+constexpr uint32_t kTensorProtoDataLocation = 14;
+
+constexpr uint32_t kWireTypeVarint = 0;
+constexpr uint32_t kWireTypeFixed64 = 1;
+constexpr uint32_t kWireTypeLengthDelimited = 2;
+constexpr uint32_t kWireTypeFixed32 = 5;
+
+// Initializers with less raw data are left in the ModelProto. They're cheap to copy, and small initializers such
+// as shapes are read from the TensorProto by shape inference.
+constexpr size_t kMinMappedInitializerBytes = 1024;
+
+// A field of a serialized message
+struct WireField {
+  uint32_t number;
+  uint32_t wire_type;
+  uint64_t varint;
+  // the whole field, tag included
+  const uint8_t* begin;
+  const uint8_t* end;
+  // the content of a length-delimited field
+  const uint8_t* value;
+};
+
+// The raw data of an initializer, left in the model file
+struct MappedRawData {
+  int initializer_index;
+  size_t offset;
+  size_t length;
+};
+
+bool ReadVarint(const uint8_t*& pos, const uint8_t* end, uint64_t& value) {
+  value = 0;
+  for (int shift = 0; shift < 64 && pos < end; shift += 7) {
+    const uint8_t byte = *pos++;
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ReadField(const uint8_t*& pos, const uint8_t* end, WireField& field) {
+  field.begin = pos;
+  uint64_t tag;
+  if (!ReadVarint(pos, end, tag)) {
+    return false;
+  }
+  field.number = static_cast<uint32_t>(tag >> 3);
+  field.wire_type = static_cast<uint32_t>(tag & 7);
+  field.varint = 0;
+  field.value = nullptr;
+  switch (field.wire_type) {
+    case kWireTypeVarint:
+      if (!ReadVarint(pos, end, field.varint)) return false;
+      break;
+    case kWireTypeFixed64:
+      if (end - pos < 8) return false;
+      pos += 8;
+      break;
+    case kWireTypeFixed32:
+      if (end - pos < 4) return false;
+      pos += 4;
+      break;
+    case kWireTypeLengthDelimited: {
+      uint64_t length;
+      if (!ReadVarint(pos, end, length) || length > static_cast<uint64_t>(end - pos)) return false;
+      field.value = pos;
+      pos += length;
+      break;
+    }
+    default:
+      // groups aren't used by onnx.proto
+      return false;
+  }
+  field.end = pos;
+  return true;
+}
+
+void WriteVarint(uint64_t value, std::string& out) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+void WriteLengthDelimited(uint32_t number, const std::string& value, std::string& out) {
+  WriteVarint((static_cast<uint64_t>(number) << 3) | kWireTypeLengthDelimited, out);
+  WriteVarint(value.size(), out);
+  out.append(value);
+}
+
+void WriteField(const WireField& field, std::string& out) {
+  out.append(reinterpret_cast<const char*>(field.begin), field.end - field.begin);
+}
+
+// Copy a serialized TensorProto, leaving out its raw data if it's large enough to be mapped.
+Status StripTensorRawData(const uint8_t* file_begin, const uint8_t* begin, const uint8_t* end, std::string& out,
+                          bool& stripped, MappedRawData& raw_data) {
+  // the tensor is left as is if it has no raw data to map, e.g. a string tensor or one with external data
+  WireField raw_data_field{};
+  bool has_raw_data = false;
+  bool can_map = true;
+  WireField field;
+  for (const uint8_t* pos = begin; pos < end;) {
+    if (!ReadField(pos, end, field)) {
+      return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Failed to load model because protobuf parsing failed.");
+    }
+    if (field.number == kTensorProtoRawData && field.wire_type == kWireTypeLengthDelimited) {
+      // the last occurrence of a field wins
+      raw_data_field = field;
+      has_raw_data = true;
+    } else if (field.number == kTensorProtoExternalData || field.number == kTensorProtoDataLocation ||
+               (field.number == kTensorProtoDataType &&
+                field.varint == static_cast<uint64_t>(TensorProto_DataType_STRING))) {
+      can_map = false;
+    }
+  }
+
+  stripped = can_map && has_raw_data &&
+             static_cast<size_t>(raw_data_field.end - raw_data_field.value) >= kMinMappedInitializerBytes;
+  if (!stripped) {
+    out.assign(reinterpret_cast<const char*>(begin), end - begin);
+    return Status::OK();
+  }
+
+  raw_data.offset = static_cast<size_t>(raw_data_field.value - file_begin);
+  raw_data.length = static_cast<size_t>(raw_data_field.end - raw_data_field.value);
+  out.clear();
+  for (const uint8_t* pos = begin; pos < end;) {
+    ReadField(pos, end, field);
+    if (field.number != kTensorProtoRawData) {
+      WriteField(field, out);
+    }
+  }
+  return Status::OK();
+}
+
+// Copy a serialized GraphProto, leaving out the raw data of its initializers that can be mapped
+Status StripGraphRawData(const uint8_t* file_begin, const uint8_t* begin, const uint8_t* end, std::string& out,
+                         int& num_initializers, std::vector<MappedRawData>& mapped) {
+  std::string tensor;
+  WireField field;
+  for (const uint8_t* pos = begin; pos < end;) {
+    if (!ReadField(pos, end, field)) {
+      return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Failed to load model because protobuf parsing failed.");
+    }
+    if (field.number != kGraphProtoInitializer || field.wire_type != kWireTypeLengthDelimited) {
+      WriteField(field, out);
+      continue;
+    }
+
+    bool stripped;
+    MappedRawData raw_data{num_initializers++, 0, 0};
+    ORT_RETURN_IF_ERROR(StripTensorRawData(file_begin, field.value, field.end, tensor, stripped, raw_data));
+    if (stripped) {
+      WriteLengthDelimited(kGraphProtoInitializer, tensor, out);
+      mapped.push_back(raw_data);
+    } else {
+      WriteField(field, out);
+    }
+  }
+  return Status::OK();
+}
+}  // namespace
+
+static void DeleteCharArray(void* param) noexcept {
+  delete[] static_cast<char*>(param);
+}
+
+// The memory of a model file registered for its initializers, and how to release it
+struct RegisteredModelData {
+  const void* data;
+  OrtCallback release;
+};
+
+static void UnregisterModelData(void* param) noexcept {
+  std::unique_ptr<RegisteredModelData> model_data(static_cast<RegisteredModelData*>(param));
+  utils::UnregisterInMemoryExternalData(model_data->data);
+  if (model_data->release.f != nullptr) {
+    model_data->release.f(model_data->release.param);
+  }
+}
+
+Status Model::LoadWithMappedInitializers(const std::basic_string<ORTCHAR_T>& file_path, ModelProto& model_proto,
+                                         Env::MappedMemoryPtr& model_data) {
+  const Env& env = Env::Default();
+  size_t length;
+  ORT_RETURN_IF_ERROR(env.GetFileLength(file_path.c_str(), length));
+  if (!env.MapFileIntoMemory(file_path.c_str(), 0, length, model_data).IsOK()) {
+    // e.g. if the platform can't map files. the initializers use the data read into the buffer instead.
+    auto buffer = onnxruntime::make_unique<char[]>(length);
+    ORT_RETURN_IF_ERROR(env.ReadFileIntoBuffer(file_path.c_str(), 0, length, gsl::make_span(buffer.get(), length)));
+    char* data = buffer.release();
+    model_data = Env::MappedMemoryPtr{data, OrtCallbackInvoker{OrtCallback{DeleteCharArray, data}}};
+  }
+
+  // parse the model without the raw data of the initializers, which would be copied into the ModelProto
+  const uint8_t* const file_begin = reinterpret_cast<const uint8_t*>(model_data.get());
+  const uint8_t* const file_end = file_begin + length;
+  std::string model_bytes;
+  std::string graph;
+  int num_initializers = 0;
+  std::vector<MappedRawData> mapped;
+  WireField field;
+  for (const uint8_t* pos = file_begin; pos < file_end;) {
+    if (!ReadField(pos, file_end, field)) {
+      return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Failed to load model because protobuf parsing failed.");
+    }
+    if (field.number != kModelProtoGraph || field.wire_type != kWireTypeLengthDelimited) {
+      WriteField(field, model_bytes);
+      continue;
+    }
+
+    graph.clear();
+    ORT_RETURN_IF_ERROR(StripGraphRawData(file_begin, field.value, field.end, graph, num_initializers, mapped));
+    WriteLengthDelimited(kModelProtoGraph, graph, model_bytes);
+  }
+
+  if (model_bytes.size() > static_cast<size_t>(INT_MAX) ||
+      !model_proto.ParseFromArray(model_bytes.data(), static_cast<int>(model_bytes.size()))) {
+    return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Failed to load model because protobuf parsing failed.");
+  }
+
+  // the file can't refer to data in memory itself, only the initializers mapped below do
+  ORT_RETURN_IF_ERROR(ValidateInMemoryExternalData(model_proto.graph(), false));
+  if (mapped.empty()) {
+    return Status::OK();
+  }
+
+  // the initializers can only refer to the file while it's registered, so it's unregistered when it's released
+  char* data = model_data.release();
+  const OrtCallback release = model_data.get_deleter().callback;
+  model_data = Env::MappedMemoryPtr{
+      data, OrtCallbackInvoker{OrtCallback{UnregisterModelData, new RegisteredModelData{data, release}}}};
+  utils::RegisterInMemoryExternalData(data, length);
+
+  auto* initializers = model_proto.mutable_graph()->mutable_initializer();
+  for (const auto& raw_data : mapped) {
+    ORT_ENFORCE(raw_data.initializer_index < initializers->size());
+    utils::SetInMemoryExternalData(model_data.get() + raw_data.offset, raw_data.length,
+                                   *initializers->Mutable(raw_data.initializer_index));
+  }
+
+  return Status::OK();
+}
+
 Status Model::Save(Model& model, int p_fd) {
   if (p_fd < 0) {
     return Status(ONNXRUNTIME, INVALID_ARGUMENT, "<p_fd> is less than 0.");
@@ -460,6 +767,17 @@ Status Model::Save(Model& model, int p_fd) {
   ORT_RETURN_IF_ERROR(model.MainGraph().Resolve());
 
   auto model_proto = model.ToProto();
+  // the data of initializers loaded from a mapped file is only valid in this process, so save it in the model
+  for (auto& initializer : *model_proto.mutable_graph()->mutable_initializer()) {
+    if (utils::HasInMemoryExternalData(initializer)) {
+      const void* data;
+      size_t length;
+      ORT_RETURN_IF_ERROR(utils::GetInMemoryExternalData(initializer, data, length));
+      initializer.clear_data_location();
+      initializer.clear_external_data();
+      initializer.set_raw_data(data, length);
+    }
+  }
   google::protobuf::io::FileOutputStream output(p_fd);
   const bool result = model_proto.SerializeToZeroCopyStream(&output) && output.Flush();
   if (result) {
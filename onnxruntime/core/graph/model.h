@@ -8,6 +8,7 @@
 #include <climits>
 #include <string>
 #include "core/graph/graph_viewer.h"
+#include "core/platform/env.h"
 #include "core/session/onnxruntime_c_api.h"
 
 #include "gsl/gsl"
@@ -46,9 +47,12 @@ class Model {
 
   // NOTE: after calling this constructor, <*this> model will
   // own the <model_proto>.
+  // <allow_mapped_initializers> allows the initializers of the main graph to refer to their data in memory, which
+  // only a ModelProto from LoadWithMappedInitializers may do.
   explicit Model(std::unique_ptr<ONNX_NAMESPACE::ModelProto> model_proto,
                  const IOnnxRuntimeOpSchemaRegistryList* local_registries,
-                 const logging::Logger& logger);
+                 const logging::Logger& logger,
+                 bool allow_mapped_initializers = false);
 
   // Get model's IR version.
   // Return <kNoVersion> if not specified.
@@ -120,6 +124,18 @@ class Model {
                              const IOnnxRuntimeOpSchemaRegistryList* local_registries,
                              const logging::Logger& logger);
 
+  /**
+  Load the model without copying the raw data of the large initializers of the main graph into the ModelProto.
+  The file is mapped into memory, or read into one buffer if it can't be mapped, and those initializers refer to
+  their data in it as external data in memory (see utils::GetInMemoryExternalData), which Load only accepts with
+  allow_mapped_initializers. A file that refers to data in memory itself is rejected.
+  @param model_data Owns the memory of the file, which is registered for the initializers until it's released.
+  It must outlive the ModelProto and the tensors created from it.
+  */
+  static common::Status LoadWithMappedInitializers(const std::basic_string<ORTCHAR_T>& file_path,
+                                                   /*out*/ ONNX_NAMESPACE::ModelProto& model_proto,
+                                                   /*out*/ Env::MappedMemoryPtr& model_data);
+
   // 'int' rather than 'size_t' because of a protobuf design choice; let callers handle type checks
   static common::Status LoadFromBytes(int count, void* pBytes,
                                       /*out*/ ONNX_NAMESPACE::ModelProto& model_proto);
@@ -136,7 +152,8 @@ class Model {
   static common::Status Load(std::unique_ptr<ONNX_NAMESPACE::ModelProto> p_model_proto,
                              /*out*/ std::shared_ptr<Model>& p_model,
                              const IOnnxRuntimeOpSchemaRegistryList* local_registries,
-                             const logging::Logger& logger);
+                             const logging::Logger& logger,
+                             bool allow_mapped_initializers = false);
 
  private:
   // Model data.
@@ -78,6 +78,7 @@ enum MLAS_ACTIVATION_KIND {
     MlasTanhActivation,
     MlasLogisticActivation,
     MlasClipActivation,
+    MlasHardSigmoidActivation,
 };
 
 struct MLAS_ACTIVATION {
@@ -90,6 +91,10 @@ struct MLAS_ACTIVATION {
             float minimum;
             float maximum;
         } Clip;
+        struct {
+            float alpha;
+            float beta;
+        } HardSigmoid;
         float Values[2];
     } Parameters;
 };
@@ -128,6 +133,47 @@ MlasGemm(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Packed matrix/matrix multiply routines. Matrix B is packed once by
+// MlasGemmPackB into a buffer sized by MlasGemmPackBSize and aligned to
+// MlasGetPreferredBufferAlignment, and can then be reused across calls.
+//
+
+size_t
+MLASCALL
+MlasGemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+void
+MLASCALL
+MlasGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasGemm(
@@ -147,6 +193,125 @@ MlasGemm(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Output processors for the quantized matrix/matrix multiply routines. The
+// processor is invoked on each block of the 32-bit accumulator matrix C as
+// soon as the block is complete and while it is still in the cache, so that
+// converting the accumulators doesn't take another pass over memory.
+//
+
+class MLAS_QGEMM_OUTPUT_PROCESSOR
+{
+public:
+    virtual ~MLAS_QGEMM_OUTPUT_PROCESSOR() = default;
+
+    virtual
+    void
+    Process(
+        const int32_t* C,
+        size_t StartM,
+        size_t StartN,
+        size_t CountM,
+        size_t CountN,
+        size_t ldc
+        ) const = 0;
+};
+
+//
+// Requantizes the accumulators to 8-bit values:
+//
+//     Output = Saturate(RoundToEven((C + Bias) * Scale) + ZeroPoint)
+//
+// The bias is per column and the scale is per matrix or per column.
+//
+
+class MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR : public MLAS_QGEMM_OUTPUT_PROCESSOR
+{
+public:
+    MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR(
+        uint8_t* Output,
+        size_t OutputLeadingDimension,
+        const int32_t* Bias,
+        const float* Scale,
+        bool PerColumnScale,
+        uint8_t ZeroPoint
+        ) :
+        Output_(Output),
+        OutputLeadingDimension_(OutputLeadingDimension),
+        Bias_(Bias),
+        Scale_(Scale),
+        PerColumnScale_(PerColumnScale),
+        ZeroPoint_(ZeroPoint)
+    {
+    }
+
+    void
+    Process(
+        const int32_t* C,
+        size_t StartM,
+        size_t StartN,
+        size_t CountM,
+        size_t CountN,
+        size_t ldc
+        ) const override;
+
+private:
+    uint8_t* Output_;
+    size_t OutputLeadingDimension_;
+    const int32_t* Bias_;
+    const float* Scale_;
+    bool PerColumnScale_;
+    uint8_t ZeroPoint_;
+};
+
+//
+// Dequantizes the accumulators to floating point values and optionally
+// applies an activation:
+//
+//     Output = Activation(C * Scale + Bias)
+//
+// The bias is per column and the scale is per matrix or per column.
+//
+
+class MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR : public MLAS_QGEMM_OUTPUT_PROCESSOR
+{
+public:
+    MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR(
+        float* Output,
+        size_t OutputLeadingDimension,
+        const float* Scale,
+        bool PerColumnScale,
+        const float* Bias,
+        const MLAS_ACTIVATION* Activation
+        ) :
+        Output_(Output),
+        OutputLeadingDimension_(OutputLeadingDimension),
+        Scale_(Scale),
+        PerColumnScale_(PerColumnScale),
+        Bias_(Bias),
+        Activation_(Activation)
+    {
+    }
+
+    void
+    Process(
+        const int32_t* C,
+        size_t StartM,
+        size_t StartN,
+        size_t CountM,
+        size_t CountN,
+        size_t ldc
+        ) const override;
+
+private:
+    float* Output_;
+    size_t OutputLeadingDimension_;
+    const float* Scale_;
+    bool PerColumnScale_;
+    const float* Bias_;
+    const MLAS_ACTIVATION* Activation_;
+};
+
 void
 MLASCALL
 MlasGemm(
@@ -161,7 +326,8 @@ MlasGemm(
     int8_t offb,
     int32_t* C,
     size_t ldc,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor = nullptr
     );
 
 void
@@ -178,7 +344,91 @@ MlasGemm(
     uint8_t offb,
     int32_t* C,
     size_t ldc,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor = nullptr
+    );
+
+//
+// Packed quantized matrix/matrix multiply routines. Matrix B is packed once by
+// MlasGemmPackB, or matrix A by MlasGemmPackA, into a buffer sized by the
+// matching size routine and aligned to MlasGetPreferredBufferAlignment. The
+// packed buffer doesn't depend on the zero point offsets, which are supplied
+// to each multiply. BIsSigned selects the int8_t or uint8_t format of matrix
+// B, and a signed offb is passed reinterpreted as uint8_t.
+//
+
+size_t
+MLASCALL
+MlasGemmPackBSize(
+    size_t N,
+    size_t K,
+    bool BIsSigned
+    );
+
+void
+MLASCALL
+MlasGemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    bool BIsSigned,
+    void* PackedB
+    );
+
+size_t
+MLASCALL
+MlasGemmPackASize(
+    size_t M,
+    size_t K,
+    bool BIsSigned
+    );
+
+void
+MLASCALL
+MlasGemmPackA(
+    size_t M,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    bool BIsSigned,
+    void* PackedA
+    );
+
+void
+MLASCALL
+MlasGemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const void* PackedB,
+    uint8_t offb,
+    bool BIsSigned,
+    int32_t* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor = nullptr
+    );
+
+void
+MLASCALL
+MlasGemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const void* PackedA,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    bool BIsSigned,
+    int32_t* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor = nullptr
     );
 
 //
@@ -189,6 +439,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmGemmThenCol2Im,
 };
 
 struct MLAS_CONV_PARAMETERS {
@@ -252,6 +503,38 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+void
+MLASCALL
+MlasConvTransposePrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t Dimensions,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t FilterCount,
+    const MLAS_ACTIVATION* Activation,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasConvTranspose(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Pooling routines.
 //
@@ -306,6 +589,17 @@ MlasComputeErf(
     size_t N
     );
 
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -363,6 +657,57 @@ MlasReorderFilterOIHWBo(
     float* D
     );
 
+//
+// Matrix transpose routines.
+//
+// The M x N input matrix is transposed to the N x M output matrix. The
+// leading dimensions are expressed in elements.
+//
+
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    size_t ldInput,
+    uint8_t* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    size_t ldInput,
+    uint16_t* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    size_t ldInput,
+    uint32_t* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint64_t* Input,
+    size_t ldInput,
+    uint64_t* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    );
+
 //
 // Single precision NCHWc routines.
 //
@@ -409,6 +754,36 @@ MlasNchwcPool(
     MLAS_THREADPOOL* ThreadPool
     );
 
+void
+MLASCALL
+MlasNchwcUpsampleNearest(
+    const int64_t* InputShape,
+    const int64_t* Scales,
+    const float* Input,
+    float* Output
+    );
+
+void
+MLASCALL
+MlasNchwcUpsampleLinear(
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t OutputWidth,
+    float InterpolationHeight,
+    const float* InterpolationWidth,
+    const float* Input,
+    float* Output
+    );
+
+void
+MLASCALL
+MlasNchwcScaleChannels(
+    size_t SpatialSize,
+    const float* Input,
+    const float* Scale,
+    float* Output
+    );
+
 //
 // Linear quantization routines.
 //
@@ -432,3 +807,18 @@ MlasQuantizeLinear(
     float Scale,
     int8_t ZeroPoint
     );
+
+void
+MLASCALL
+MlasRequantizeOutput(
+    const int32_t* Input,
+    size_t InputLeadingDimension,
+    uint8_t* Output,
+    size_t OutputLeadingDimension,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerRowScale,
+    uint8_t ZeroPoint,
+    size_t M,
+    size_t N
+    );
@@ -0,0 +1,100 @@
+;++
+;
+; Copyright (c) Microsoft Corporation. All rights reserved.
+;
+; Licensed under the MIT License.
+;
+; Module Name:
+;
+;   SoftmaxKernelAvx.asm
+;
+; Abstract:
+;
+;   This module implements the kernels for the single precision softmax
+;   operation.
+;
+;   This implementation uses AVX instructions.
+;
+;--
+
+        .xlist
+INCLUDE mlasi.inc
+        .list
+
+;++
+;
+; Routine Description:
+;
+;   This routine implements a vectorized kernel to find the maximum value of
+;   the supplied buffer.
+;
+; Arguments:
+;
+;   Input (rcx) - Supplies the input buffer.
+;
+;   N (rdx) - Supplies the number of elements to process.
+;
+; Return Value:
+;
+;   Returns the maximum value of the supplied buffer.
+;
+;--
+
+        LEAF_ENTRY MlasReduceMaximumF32KernelAvx, _TEXT
+
+        mov     eax,0FF7FFFFFh                  ; std::numeric_limits<float>::lowest()
+        vmovd   xmm0,eax
+        vshufps xmm0,xmm0,xmm0,0
+        vinsertf128 ymm0,ymm0,xmm0,1
+        cmp     rdx,8
+        jb      ProcessRemainingCountBy1
+        cmp     rdx,32
+        jb      ProcessRemainingCountBy8
+        vmovaps ymm1,ymm0
+        vmovaps ymm2,ymm0
+        vmovaps ymm3,ymm0
+
+ProcessRemainingCountBy32:
+        vmaxps  ymm0,ymm0,YMMWORD PTR [rcx]
+        vmaxps  ymm1,ymm1,YMMWORD PTR [rcx+8*4]
+        sub     rdx,32
+        vmaxps  ymm2,ymm2,YMMWORD PTR [rcx+16*4]
+        vmaxps  ymm3,ymm3,YMMWORD PTR [rcx+24*4]
+        add     rcx,32*4                        ; advance input by 32 elements
+        cmp     rdx,32
+        jae     ProcessRemainingCountBy32
+        vmaxps  ymm0,ymm0,ymm1                  ; reduce to single vector
+        vmaxps  ymm2,ymm2,ymm3
+        vmaxps  ymm0,ymm0,ymm2
+
+ProcessRemainingCountBy8:
+        cmp     rdx,8
+        jb      ProcessRemainingCountLessThan8
+        vmaxps  ymm0,ymm0,YMMWORD PTR [rcx]
+        sub     rdx,8
+        add     rcx,8*4                         ; advance input by 8 elements
+        jmp     ProcessRemainingCountBy8
+
+ProcessRemainingCountLessThan8:
+        vextractf128 xmm1,ymm0,1                ; reduce to single scalar
+        vmaxps  xmm0,xmm0,xmm1
+        vshufps xmm1,xmm0,xmm0,0EEh
+        vmaxps  xmm0,xmm0,xmm1
+        vshufps xmm1,xmm0,xmm0,055h
+        vmaxss  xmm0,xmm0,xmm1
+
+ProcessRemainingCountBy1:
+        test    rdx,rdx
+        jz      ExitKernel
+        vmaxss  xmm0,xmm0,DWORD PTR [rcx]
+        add     rcx,4                           ; advance input by 1 element
+        dec     rdx
+        jmp     ProcessRemainingCountBy1
+
+ExitKernel:
+        vzeroupper
+        ret
+
+        LEAF_END MlasReduceMaximumF32KernelAvx, _TEXT
+
+        END
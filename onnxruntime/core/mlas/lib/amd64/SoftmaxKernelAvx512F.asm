@@ -0,0 +1,163 @@
+;++
+;
+; Copyright (c) Microsoft Corporation. All rights reserved.
+;
+; Licensed under the MIT License.
+;
+; Module Name:
+;
+;   SoftmaxKernelAvx512F.asm
+;
+; Abstract:
+;
+;   This module implements the kernels for the single precision softmax
+;   operation.
+;
+;   This implementation uses AVX512F instructions.
+;
+;--
+
+        .xlist
+INCLUDE mlasi.inc
+        .list
+
+        EXTERN  MlasExpConstants:NEAR
+
+;
+; Structure layout for the exponential constants block.
+;
+
+ExpConstants STRUCT
+
+        LowerRange DWORD ?
+        RoundingBias DWORD ?
+        Log2Reciprocal DWORD ?
+        Log2High DWORD ?
+        Log2Low DWORD ?
+        poly_0 DWORD ?
+        poly_1 DWORD ?
+        poly_2 DWORD ?
+        poly_3 DWORD ?
+        poly_4 DWORD ?
+        poly_56 DWORD ?
+
+ExpConstants ENDS
+
+;++
+;
+; Routine Description:
+;
+;   This routine implements a vectorized kernel to compute the exponential of
+;   each element offset by the negative maximum and to sum the results.
+;
+; Arguments:
+;
+;   Input (rcx) - Supplies the input buffer.
+;
+;   Output (rdx) - Optionally supplies the output buffer. When supplied, the
+;       exponential of each element is stored here.
+;
+;   N (r8) - Supplies the number of elements to process.
+;
+;   NegativeMaximum (r9) - Supplies the address of the negative of the maximum
+;       value of the input buffer, which is added to each element before
+;       computing the exponential.
+;
+; Return Value:
+;
+;   Returns the sum of the exponentials.
+;
+;--
+
+        LEAF_ENTRY MlasComputeSumExpF32KernelAvx512F, _TEXT
+
+        lea     rax,MlasExpConstants
+        vbroadcastss zmm16,ExpConstants.LowerRange[rax]
+        vbroadcastss zmm17,ExpConstants.RoundingBias[rax]
+        vbroadcastss zmm18,ExpConstants.Log2Reciprocal[rax]
+        vbroadcastss zmm19,ExpConstants.Log2High[rax]
+        vbroadcastss zmm20,ExpConstants.Log2Low[rax]
+        vbroadcastss zmm21,ExpConstants.poly_0[rax]
+        vbroadcastss zmm22,ExpConstants.poly_1[rax]
+        vbroadcastss zmm23,ExpConstants.poly_2[rax]
+        vbroadcastss zmm24,ExpConstants.poly_3[rax]
+        vbroadcastss zmm25,ExpConstants.poly_4[rax]
+        vbroadcastss zmm26,ExpConstants.poly_56[rax]
+        vbroadcastss zmm27,DWORD PTR [r9]       ; broadcast negative maximum value
+        vpxord  zmm0,zmm0,zmm0                  ; clear exp() accumulator
+
+        sub     r8,16
+        jb      ProcessRemainingCount
+
+ComputeSumExpBy16Loop:
+        vaddps  zmm1,zmm27,ZMMWORD PTR [rcx]    ; bias by negative maximum value
+        vmaxps  zmm1,zmm16,zmm1                 ; clamp lower bound
+        vmovaps zmm3,zmm17
+        vfmadd231ps zmm3,zmm1,zmm18             ; (input / ln2) plus rounding bias
+        vsubps  zmm2,zmm3,zmm17                 ; m = round(input / ln2)
+        vfmadd231ps zmm1,zmm2,zmm19             ; range reduce: x -= (m * ln2_high)
+        vfmadd231ps zmm1,zmm2,zmm20             ; range reduce: x -= (m * ln2_low)
+        vmovaps zmm2,zmm21                      ; p = poly_0
+        vfmadd213ps zmm2,zmm1,zmm22             ; p = p * x + poly_1
+        vpslld  zmm3,zmm3,23                    ; shift m to exponent field
+        vfmadd213ps zmm2,zmm1,zmm23             ; p = p * x + poly_2
+        vfmadd213ps zmm2,zmm1,zmm24             ; p = p * x + poly_3
+        vfmadd213ps zmm2,zmm1,zmm25             ; p = p * x + poly_4
+        vfmadd213ps zmm2,zmm1,zmm26             ; p = p * x + poly_5
+        vfmadd213ps zmm2,zmm1,zmm26             ; p = p * x + poly_6
+        vmulps  zmm2,zmm2,zmm3                  ; scale p with exponent
+        vaddps  zmm0,zmm0,zmm2                  ; accumulate exp() results
+        add     rcx,16*4                        ; advance input by 16 elements
+        test    rdx,rdx
+        jz      SkipStoreResultsBy16
+        vmovups ZMMWORD PTR [rdx],zmm2
+        add     rdx,16*4                        ; advance output by 16 elements
+
+SkipStoreResultsBy16:
+        sub     r8,16
+        jae     ComputeSumExpBy16Loop
+
+ProcessRemainingCount:
+        add     r8,16                           ; correct for over-subtract above
+        jz      ReduceAccumulator
+        mov     r10,rcx
+        mov     ecx,r8d
+        mov     eax,1
+        shl     eax,cl
+        dec     eax
+        kmovw   k1,eax                          ; mask for remaining elements
+        vmovups zmm1{k1}{z},ZMMWORD PTR [r10]
+        vaddps  zmm1,zmm27,zmm1                 ; bias by negative maximum value
+        vmaxps  zmm1,zmm16,zmm1                 ; clamp lower bound
+        vmovaps zmm3,zmm17
+        vfmadd231ps zmm3,zmm1,zmm18             ; (input / ln2) plus rounding bias
+        vsubps  zmm2,zmm3,zmm17                 ; m = round(input / ln2)
+        vfmadd231ps zmm1,zmm2,zmm19             ; range reduce: x -= (m * ln2_high)
+        vfmadd231ps zmm1,zmm2,zmm20             ; range reduce: x -= (m * ln2_low)
+        vmovaps zmm2,zmm21                      ; p = poly_0
+        vfmadd213ps zmm2,zmm1,zmm22             ; p = p * x + poly_1
+        vpslld  zmm3,zmm3,23                    ; shift m to exponent field
+        vfmadd213ps zmm2,zmm1,zmm23             ; p = p * x + poly_2
+        vfmadd213ps zmm2,zmm1,zmm24             ; p = p * x + poly_3
+        vfmadd213ps zmm2,zmm1,zmm25             ; p = p * x + poly_4
+        vfmadd213ps zmm2,zmm1,zmm26             ; p = p * x + poly_5
+        vfmadd213ps zmm2,zmm1,zmm26             ; p = p * x + poly_6
+        vmulps  zmm2,zmm2,zmm3                  ; scale p with exponent
+        vaddps  zmm0{k1},zmm0,zmm2              ; accumulate exp() results
+        test    rdx,rdx
+        jz      ReduceAccumulator
+        vmovups ZMMWORD PTR [rdx]{k1},zmm2
+
+ReduceAccumulator:
+        vextractf64x4 ymm1,zmm0,1               ; reduce to single scalar
+        vaddps  ymm0,ymm0,ymm1
+        vextractf128 xmm1,ymm0,1
+        vaddps  xmm0,xmm0,xmm1
+        vhaddps xmm0,xmm0,xmm0
+        vhaddps xmm0,xmm0,xmm0
+        vzeroupper
+        ret
+
+        LEAF_END MlasComputeSumExpF32KernelAvx512F, _TEXT
+
+        END
@@ -0,0 +1,217 @@
+;++
+;
+; Copyright (c) Microsoft Corporation. All rights reserved.
+;
+; Licensed under the MIT License.
+;
+; Module Name:
+;
+;   SoftmaxKernelFma3.asm
+;
+; Abstract:
+;
+;   This module implements the kernels for the single precision softmax
+;   operation.
+;
+;   This implementation uses AVX fused multiply/add instructions.
+;
+;--
+
+        .xlist
+INCLUDE mlasi.inc
+        .list
+
+        EXTERN  MlasMaskMoveAvx:NEAR
+        EXTERN  MlasExpConstants:NEAR
+
+;
+; Structure layout for the exponential constants block.
+;
+
+ExpConstants STRUCT
+
+        LowerRange DWORD ?
+        RoundingBias DWORD ?
+        Log2Reciprocal DWORD ?
+        Log2High DWORD ?
+        Log2Low DWORD ?
+        poly_0 DWORD ?
+        poly_1 DWORD ?
+        poly_2 DWORD ?
+        poly_3 DWORD ?
+        poly_4 DWORD ?
+        poly_56 DWORD ?
+
+ExpConstants ENDS
+
+;
+; Stack frame layout for the sum exponential kernel.
+;
+
+SumExpKernelFrame STRUCT
+
+        SavedXmm6 OWORD ?
+        SavedXmm7 OWORD ?
+        SavedXmm8 OWORD ?
+        SavedXmm9 OWORD ?
+        SavedXmm10 OWORD ?
+        SavedXmm11 OWORD ?
+        SavedXmm12 OWORD ?
+        SavedXmm13 OWORD ?
+        SavedXmm14 OWORD ?
+        SavedXmm15 OWORD ?
+        Padding0 QWORD ?
+        Padding1 QWORD ?
+        CountN QWORD ?
+        ReturnAddress QWORD ?
+        PreviousP1Home QWORD ?
+        PreviousP2Home QWORD ?
+        PreviousP3Home QWORD ?
+        PreviousP4Home QWORD ?
+
+SumExpKernelFrame ENDS
+
+;++
+;
+; Routine Description:
+;
+;   This routine implements a vectorized kernel to compute the exponential of
+;   each element offset by the negative maximum and to sum the results.
+;
+; Arguments:
+;
+;   Input (rcx) - Supplies the input buffer.
+;
+;   Output (rdx) - Optionally supplies the output buffer. When supplied, the
+;       exponential of each element is stored here.
+;
+;   N (r8) - Supplies the number of elements to process.
+;
+;   NegativeMaximum (r9) - Supplies the address of the negative of the maximum
+;       value of the input buffer, which is added to each element before
+;       computing the exponential.
+;
+; Return Value:
+;
+;   Returns the sum of the exponentials.
+;
+;--
+
+        NESTED_ENTRY MlasComputeSumExpF32KernelFma3, _TEXT
+
+        alloc_stack (SumExpKernelFrame.ReturnAddress)
+
+        save_xmm128_avx xmm6,SumExpKernelFrame.SavedXmm6
+        save_xmm128_avx xmm7,SumExpKernelFrame.SavedXmm7
+        save_xmm128_avx xmm8,SumExpKernelFrame.SavedXmm8
+        save_xmm128_avx xmm9,SumExpKernelFrame.SavedXmm9
+        save_xmm128_avx xmm10,SumExpKernelFrame.SavedXmm10
+        save_xmm128_avx xmm11,SumExpKernelFrame.SavedXmm11
+        save_xmm128_avx xmm12,SumExpKernelFrame.SavedXmm12
+        save_xmm128_avx xmm13,SumExpKernelFrame.SavedXmm13
+        save_xmm128_avx xmm14,SumExpKernelFrame.SavedXmm14
+        save_xmm128_avx xmm15,SumExpKernelFrame.SavedXmm15
+
+        END_PROLOGUE
+
+        lea     rax,MlasExpConstants
+        vbroadcastss ymm4,ExpConstants.LowerRange[rax]
+        vbroadcastss ymm5,ExpConstants.RoundingBias[rax]
+        vbroadcastss ymm6,ExpConstants.Log2Reciprocal[rax]
+        vbroadcastss ymm7,ExpConstants.Log2High[rax]
+        vbroadcastss ymm8,ExpConstants.Log2Low[rax]
+        vbroadcastss ymm9,ExpConstants.poly_0[rax]
+        vbroadcastss ymm10,ExpConstants.poly_1[rax]
+        vbroadcastss ymm11,ExpConstants.poly_2[rax]
+        vbroadcastss ymm12,ExpConstants.poly_3[rax]
+        vbroadcastss ymm13,ExpConstants.poly_4[rax]
+        vbroadcastss ymm14,ExpConstants.poly_56[rax]
+        vbroadcastss ymm15,DWORD PTR [r9]       ; broadcast negative maximum value
+        vxorps  xmm3,xmm3,xmm3                  ; clear exp() accumulator
+
+        sub     r8,8
+        jb      ProcessRemainingCount
+
+ComputeSumExpBy8Loop:
+        vaddps  ymm0,ymm15,YMMWORD PTR [rcx]    ; bias by negative maximum value
+        vmaxps  ymm0,ymm4,ymm0                  ; clamp lower bound
+        vmovaps ymm2,ymm5
+        vfmadd231ps ymm2,ymm0,ymm6              ; (input / ln2) plus rounding bias
+        vsubps  ymm1,ymm2,ymm5                  ; m = round(input / ln2)
+        vfmadd231ps ymm0,ymm1,ymm7              ; range reduce: x -= (m * ln2_high)
+        vfmadd231ps ymm0,ymm1,ymm8              ; range reduce: x -= (m * ln2_low)
+        vmovaps ymm1,ymm9                       ; p = poly_0
+        vfmadd213ps ymm1,ymm0,ymm10             ; p = p * x + poly_1
+        vpslld  ymm2,ymm2,23                    ; shift m to exponent field
+        vfmadd213ps ymm1,ymm0,ymm11             ; p = p * x + poly_2
+        vfmadd213ps ymm1,ymm0,ymm12             ; p = p * x + poly_3
+        vfmadd213ps ymm1,ymm0,ymm13             ; p = p * x + poly_4
+        vfmadd213ps ymm1,ymm0,ymm14             ; p = p * x + poly_5
+        vfmadd213ps ymm1,ymm0,ymm14             ; p = p * x + poly_6
+        vmulps  ymm1,ymm1,ymm2                  ; scale p with exponent
+        vaddps  ymm3,ymm3,ymm1                  ; accumulate exp() results
+        add     rcx,8*4                         ; advance input by 8 elements
+        test    rdx,rdx
+        jz      SkipStoreResultsBy8
+        vmovups YMMWORD PTR [rdx],ymm1
+        add     rdx,8*4                         ; advance output by 8 elements
+
+SkipStoreResultsBy8:
+        sub     r8,8
+        jae     ComputeSumExpBy8Loop
+
+ProcessRemainingCount:
+        add     r8,8                            ; correct for over-subtract above
+        jz      ReduceAccumulator
+        mov     DWORD PTR SumExpKernelFrame.CountN[rsp],r8d
+        vbroadcastss ymm2,DWORD PTR SumExpKernelFrame.CountN[rsp]
+        vpcmpgtd ymm2,ymm2,YMMWORD PTR [MlasMaskMoveAvx]
+        vmaskmovps ymm0,ymm2,YMMWORD PTR [rcx]
+        vaddps  ymm0,ymm15,ymm0                 ; bias by negative maximum value
+        vmovaps ymm15,ymm2                      ; save mask for remaining elements
+        vmaxps  ymm0,ymm4,ymm0                  ; clamp lower bound
+        vmovaps ymm2,ymm5
+        vfmadd231ps ymm2,ymm0,ymm6              ; (input / ln2) plus rounding bias
+        vsubps  ymm1,ymm2,ymm5                  ; m = round(input / ln2)
+        vfmadd231ps ymm0,ymm1,ymm7              ; range reduce: x -= (m * ln2_high)
+        vfmadd231ps ymm0,ymm1,ymm8              ; range reduce: x -= (m * ln2_low)
+        vmovaps ymm1,ymm9                       ; p = poly_0
+        vfmadd213ps ymm1,ymm0,ymm10             ; p = p * x + poly_1
+        vpslld  ymm2,ymm2,23                    ; shift m to exponent field
+        vfmadd213ps ymm1,ymm0,ymm11             ; p = p * x + poly_2
+        vfmadd213ps ymm1,ymm0,ymm12             ; p = p * x + poly_3
+        vfmadd213ps ymm1,ymm0,ymm13             ; p = p * x + poly_4
+        vfmadd213ps ymm1,ymm0,ymm14             ; p = p * x + poly_5
+        vfmadd213ps ymm1,ymm0,ymm14             ; p = p * x + poly_6
+        vmulps  ymm1,ymm1,ymm2                  ; scale p with exponent
+        vandps  ymm1,ymm15,ymm1                 ; mask exp() results
+        vaddps  ymm3,ymm3,ymm1                  ; accumulate exp() results
+        test    rdx,rdx
+        jz      ReduceAccumulator
+        vmaskmovps YMMWORD PTR [rdx],ymm15,ymm1
+
+ReduceAccumulator:
+        vextractf128 xmm1,ymm3,1                ; reduce to single scalar
+        vaddps  xmm0,xmm3,xmm1
+        vhaddps xmm0,xmm0,xmm0
+        vhaddps xmm0,xmm0,xmm0
+        vzeroupper
+        vmovaps xmm6,SumExpKernelFrame.SavedXmm6[rsp]
+        vmovaps xmm7,SumExpKernelFrame.SavedXmm7[rsp]
+        vmovaps xmm8,SumExpKernelFrame.SavedXmm8[rsp]
+        vmovaps xmm9,SumExpKernelFrame.SavedXmm9[rsp]
+        vmovaps xmm10,SumExpKernelFrame.SavedXmm10[rsp]
+        vmovaps xmm11,SumExpKernelFrame.SavedXmm11[rsp]
+        vmovaps xmm12,SumExpKernelFrame.SavedXmm12[rsp]
+        vmovaps xmm13,SumExpKernelFrame.SavedXmm13[rsp]
+        vmovaps xmm14,SumExpKernelFrame.SavedXmm14[rsp]
+        vmovaps xmm15,SumExpKernelFrame.SavedXmm15[rsp]
+        add     rsp,(SumExpKernelFrame.ReturnAddress)
+
+        BEGIN_EPILOGUE
+
+        ret
+
+        NESTED_END MlasComputeSumExpF32KernelFma3, _TEXT
+
+        END
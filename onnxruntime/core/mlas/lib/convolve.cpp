@@ -988,6 +988,15 @@ Return Value:
 
                     break;
                 }
+
+                case MlasConvAlgorithmGemmThenCol2Im:
+                {
+                    //
+                    // This algorithm is only selected by MlasConvTransposePrepare.
+                    //
+
+                    break;
+                }
             }
 
             //
@@ -1005,6 +1014,116 @@ Return Value:
     }
 }
 
+void
+MlasConvSaveShapes(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t Dimensions,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    bool* AllStridesAreOne,
+    bool* AllDilationsAreOne,
+    bool* AllPaddingIsZero
+    )
+/*++
+
+Routine Description:
+
+    This routine saves the shapes of a convolution operation and computes the
+    sizes derived from the shapes.
+
+    A one dimensional operation is saved as a two dimensional operation with
+    a unit height, so that the kernels only need to handle two and three
+    dimensional operations.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation. The InputChannels field must
+        already be initialized.
+
+    Dimensions - Supplies the number of dimensions (must be between 1 and 3).
+
+    InputShape - Supplies the shape of the input tensor.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    Padding - Supplies the number of zero padding elements at the edge of the
+        input tensor.
+
+    StrideShape - Supplies the shape of the stride.
+
+    OutputShape - Supplies the shape of the output tensor.
+
+    AllStridesAreOne - Receives true if all strides are one.
+
+    AllDilationsAreOne - Receives true if all dilations are one.
+
+    AllPaddingIsZero - Receives true if all padding is zero.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t SavedDimensions = (Dimensions == 1) ? 2 : Dimensions;
+    const size_t UnitDimensions = SavedDimensions - Dimensions;
+
+    Parameters->Dimensions = SavedDimensions;
+
+    size_t InputSize = 1;
+    size_t OutputSize = 1;
+    size_t K = Parameters->InputChannels;
+
+    *AllStridesAreOne = true;
+    *AllDilationsAreOne = true;
+    *AllPaddingIsZero = true;
+
+    for (size_t dim = 0; dim < SavedDimensions; dim++) {
+
+        if (dim < UnitDimensions) {
+
+            Parameters->InputShape[dim] = 1;
+            Parameters->OutputShape[dim] = 1;
+            Parameters->KernelShape[dim] = 1;
+            Parameters->DilationShape[dim] = 1;
+            Parameters->Padding[dim] = 0;
+            Parameters->Padding[dim + SavedDimensions] = 0;
+            Parameters->StrideShape[dim] = 1;
+
+        } else {
+
+            const size_t SourceDim = dim - UnitDimensions;
+
+            Parameters->InputShape[dim] = size_t(InputShape[SourceDim]);
+            Parameters->OutputShape[dim] = size_t(OutputShape[SourceDim]);
+            Parameters->KernelShape[dim] = size_t(KernelShape[SourceDim]);
+            Parameters->DilationShape[dim] = size_t(DilationShape[SourceDim]);
+            Parameters->Padding[dim] = size_t(Padding[SourceDim]);
+            Parameters->Padding[dim + SavedDimensions] = size_t(Padding[SourceDim + Dimensions]);
+            Parameters->StrideShape[dim] = size_t(StrideShape[SourceDim]);
+        }
+
+        InputSize *= Parameters->InputShape[dim];
+        OutputSize *= Parameters->OutputShape[dim];
+        K *= Parameters->KernelShape[dim];
+
+        *AllStridesAreOne &= (Parameters->StrideShape[dim] == 1);
+        *AllDilationsAreOne &= (Parameters->DilationShape[dim] == 1);
+        *AllPaddingIsZero &= (Parameters->Padding[dim] == 0 && Parameters->Padding[dim + SavedDimensions] == 0);
+    }
+
+    Parameters->InputSize = InputSize;
+    Parameters->OutputSize = OutputSize;
+    Parameters->K = K;
+}
+
 void
 MLASCALL
 MlasConvPrepare(
@@ -1037,7 +1156,7 @@ Arguments:
     Parameters - Supplies the structure that stores the provided and computed
         parameters for the convolution operation.
 
-    Dimensions - Supplies the number of dimensions (must be 2 or 3).
+    Dimensions - Supplies the number of dimensions (must be between 1 and 3).
 
     BatchCount - Supplies the number of batches to the processed.
 
@@ -1080,42 +1199,21 @@ Return Value:
     //
 
     Parameters->Activation = Activation;
-    Parameters->Dimensions = Dimensions;
     Parameters->BatchCount = BatchCount;
     Parameters->GroupCount = GroupCount;
     Parameters->InputChannels = InputChannels;
     Parameters->FilterCount = FilterCount;
 
-    size_t InputSize = 1;
-    size_t OutputSize = 1;
-    size_t K = InputChannels;
-
-    bool AllStridesAreOne = true;
-    bool AllDilationsAreOne = true;
-    bool AllPaddingIsZero = true;
-
-    for (size_t dim = 0; dim < Dimensions; dim++) {
-
-        Parameters->InputShape[dim] = size_t(InputShape[dim]);
-        Parameters->OutputShape[dim] = size_t(OutputShape[dim]);
-        Parameters->KernelShape[dim] = size_t(KernelShape[dim]);
-        Parameters->DilationShape[dim] = size_t(DilationShape[dim]);
-        Parameters->Padding[dim] = size_t(Padding[dim]);
-        Parameters->Padding[dim + Dimensions] = size_t(Padding[dim + Dimensions]);
-        Parameters->StrideShape[dim] = size_t(StrideShape[dim]);
+    bool AllStridesAreOne;
+    bool AllDilationsAreOne;
+    bool AllPaddingIsZero;
 
-        InputSize *= Parameters->InputShape[dim];
-        OutputSize *= Parameters->OutputShape[dim];
-        K *= Parameters->KernelShape[dim];
+    MlasConvSaveShapes(Parameters, Dimensions, InputShape, KernelShape,
+        DilationShape, Padding, StrideShape, OutputShape, &AllStridesAreOne,
+        &AllDilationsAreOne, &AllPaddingIsZero);
 
-        AllStridesAreOne &= (Parameters->StrideShape[dim] == 1);
-        AllDilationsAreOne &= (Parameters->DilationShape[dim] == 1);
-        AllPaddingIsZero &= (Parameters->Padding[dim] == 0 && Parameters->Padding[dim + Dimensions] == 0);
-    }
-
-    Parameters->InputSize = InputSize;
-    Parameters->OutputSize = OutputSize;
-    Parameters->K = K;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t K = Parameters->K;
 
     //
     // Evaluate how the convolution will be performed.
@@ -1138,7 +1236,7 @@ Return Value:
             return;
         }
 
-        if (Dimensions == 2 && AllDilationsAreOne && InputChannels == 1) {
+        if (Parameters->Dimensions == 2 && AllDilationsAreOne && InputChannels == 1) {
 
             //
             // Detect convolutions where the kernel is using the entire input
@@ -1232,3 +1330,572 @@ Return Value:
         *WorkingBufferSize = TargetThreadCount * MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD;
     }
 }
+
+void
+MlasConvTransposeCol2Im(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* ColumnBuffer,
+    float* Output,
+    size_t k,
+    size_t CountK,
+    size_t n,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine accumulates a slice of the column buffer produced by a
+    transposed convolution GEMM into the output image.
+
+    The rows of the column buffer are indexed by (output channel, kernel
+    position) and the columns are indexed by input position. Each element is
+    scattered to the output position that the kernel position maps the input
+    position to, skipping any positions that fall inside the padding.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    ColumnBuffer - Supplies the slice of the column buffer of CountK rows and
+        CountN columns.
+
+    Output - Supplies the output tensor for the current batch and group.
+
+    k - Supplies the row of the column buffer where the slice begins.
+
+    CountK - Supplies the number of rows in the slice.
+
+    n - Supplies the input position where the slice begins.
+
+    CountN - Supplies the number of input positions in the slice.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Treat a two dimensional operation as a three dimensional operation
+    // with a unit depth.
+    //
+
+    size_t OutputDepth = 1;
+    size_t KernelDepth = 1;
+    size_t DilationDepth = 1;
+    size_t PaddingLeftZ = 0;
+    size_t StrideDepth = 1;
+
+    size_t HeightShapeIndex = 0;
+    size_t WidthShapeIndex = 1;
+
+    if (Parameters->Dimensions == 3) {
+
+        OutputDepth = Parameters->OutputShape[0];
+        KernelDepth = Parameters->KernelShape[0];
+        DilationDepth = Parameters->DilationShape[0];
+        PaddingLeftZ = Parameters->Padding[0];
+        StrideDepth = Parameters->StrideShape[0];
+
+        HeightShapeIndex = 1;
+        WidthShapeIndex = 2;
+    }
+
+    const size_t InputHeight = Parameters->InputShape[HeightShapeIndex];
+    const size_t InputWidth = Parameters->InputShape[WidthShapeIndex];
+    const size_t InputPlaneSize = InputHeight * InputWidth;
+
+    const size_t OutputHeight = Parameters->OutputShape[HeightShapeIndex];
+    const size_t OutputWidth = Parameters->OutputShape[WidthShapeIndex];
+    const size_t OutputSize = Parameters->OutputSize;
+
+    const size_t KernelHeight = Parameters->KernelShape[HeightShapeIndex];
+    const size_t KernelWidth = Parameters->KernelShape[WidthShapeIndex];
+    const size_t KernelSize = KernelDepth * KernelHeight * KernelWidth;
+
+    const size_t DilationHeight = Parameters->DilationShape[HeightShapeIndex];
+    const size_t DilationWidth = Parameters->DilationShape[WidthShapeIndex];
+
+    const size_t PaddingLeftY = Parameters->Padding[HeightShapeIndex];
+    const size_t PaddingLeftX = Parameters->Padding[WidthShapeIndex];
+
+    const size_t StrideHeight = Parameters->StrideShape[HeightShapeIndex];
+    const size_t StrideWidth = Parameters->StrideShape[WidthShapeIndex];
+
+    for (size_t row = k; row < k + CountK; row++) {
+
+        //
+        // Decompose the row into the output channel and the kernel position.
+        //
+
+        const size_t channel = row / KernelSize;
+        size_t kernel = row % KernelSize;
+
+        const size_t kx = kernel % KernelWidth;
+        kernel /= KernelWidth;
+        const size_t ky = kernel % KernelHeight;
+        const size_t kz = kernel / KernelHeight;
+
+        float* output = Output + channel * OutputSize;
+
+        //
+        // Decompose the starting input position.
+        //
+
+        size_t ix = n % InputWidth;
+        size_t iy = (n / InputWidth) % InputHeight;
+        size_t iz = n / InputPlaneSize;
+
+        for (size_t i = 0; i < CountN; i++) {
+
+            //
+            // Compute the output position using unsigned arithmetic, so that
+            // positions inside the leading padding wrap to large values and
+            // fail the bounds checks.
+            //
+
+            const size_t oz = iz * StrideDepth + kz * DilationDepth - PaddingLeftZ;
+            const size_t oy = iy * StrideHeight + ky * DilationHeight - PaddingLeftY;
+            const size_t ox = ix * StrideWidth + kx * DilationWidth - PaddingLeftX;
+
+            if (oz < OutputDepth && oy < OutputHeight && ox < OutputWidth) {
+                output[(oz * OutputHeight + oy) * OutputWidth + ox] += ColumnBuffer[i];
+            }
+
+            if (++ix == InputWidth) {
+
+                ix = 0;
+
+                if (++iy == InputHeight) {
+                    iy = 0;
+                    iz++;
+                }
+            }
+        }
+
+        ColumnBuffer += CountN;
+    }
+}
+
+void
+MlasConvTransposeOperation(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    float* ColumnBuffer,
+    float* Output,
+    size_t FilterStart,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the transposed convolution operation for a range
+    of output channels of a single batch and group.
+
+    The output channels must be cleared before calling this routine.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor for the current batch and group.
+
+    Filter - Supplies the filter tensor for the current group.
+
+    ColumnBuffer - Supplies the thread local slice of the working buffer.
+
+    Output - Supplies the output tensor for the current batch and group.
+
+    FilterStart - Supplies the first output channel to compute.
+
+    FilterCount - Supplies the number of output channels to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t InputSize = Parameters->InputSize;
+    const size_t KernelSize = Parameters->K / InputChannels;
+    const size_t lda = Parameters->FilterCount * KernelSize;
+
+    const size_t RowStart = FilterStart * KernelSize;
+    const size_t RowCount = FilterCount * KernelSize;
+
+    //
+    // Compute the strides to step through slices of the column buffer.
+    //
+    // See MlasConvOperation.
+    //
+
+    uint32_t StrideN = MLAS_SGEMM_STRIDEN;
+    uint32_t StrideK = MLAS_SGEMM_STRIDEK;
+
+    if (InputSize >= RowCount) {
+
+        while (StrideK / 2 >= RowCount) {
+            StrideN *= 2;
+            StrideK /= 2;
+        }
+
+    } else {
+
+        while (StrideN > 16 && StrideN / 2 >= InputSize) {
+            StrideK *= 2;
+            StrideN /= 2;
+        }
+    }
+
+    //
+    // Step through each slice of the input tensor along the N dimension and
+    // then each slice of the filter rows.
+    //
+
+    size_t CountN;
+
+    for (size_t n = 0; n < InputSize; n += CountN) {
+
+        CountN = InputSize - n;
+
+        if (CountN > StrideN) {
+            CountN = StrideN;
+        }
+
+        size_t CountK;
+
+        for (size_t k = RowStart; k < RowStart + RowCount; k += CountK) {
+
+            CountK = RowStart + RowCount - k;
+
+            if (CountK > StrideK) {
+                CountK = StrideK;
+            }
+
+            MlasSgemmOperation(CblasTrans, CblasNoTrans, CountK, CountN,
+                InputChannels, 1.0f, Filter + k, lda, Input + n, InputSize, 0.0f,
+                ColumnBuffer, CountN);
+
+            MlasConvTransposeCol2Im(Parameters, ColumnBuffer, Output, k, CountK,
+                n, CountN);
+        }
+    }
+}
+
+void
+MlasConvTransposeThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    transposed convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t GroupCount = Parameters->GroupCount;
+
+    const size_t InputGroupSize = InputChannels * Parameters->InputSize;
+    const size_t OutputGroupSize = FilterCount * OutputSize;
+    const size_t FilterGroupSize = FilterCount * Parameters->K;
+
+    //
+    // Partition the output channels of all batches and groups across the
+    // threads.
+    //
+
+    const size_t TotalWork = Parameters->BatchCount * GroupCount * FilterCount;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount, TotalWork, &WorkIndex,
+        &WorkRemaining);
+
+    float* ColumnBuffer = WorkBlock->WorkingBuffer;
+
+    if (ColumnBuffer != nullptr) {
+        ColumnBuffer += Index * MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD;
+    }
+
+    while (WorkRemaining > 0) {
+
+        const size_t bg = WorkIndex / FilterCount;
+        const size_t FilterStart = WorkIndex % FilterCount;
+        const size_t group = bg % GroupCount;
+
+        size_t CountFilters = FilterCount - FilterStart;
+
+        if (CountFilters > WorkRemaining) {
+            CountFilters = WorkRemaining;
+        }
+
+        const float* input = WorkBlock->Input + bg * InputGroupSize;
+        const float* filter = WorkBlock->Filter + group * FilterGroupSize;
+        float* output = WorkBlock->Output + bg * OutputGroupSize;
+
+        if (Parameters->Algorithm == MlasConvAlgorithmGemmDirect) {
+
+            //
+            // Invoke the non-threaded GEMM directly with the input tensor.
+            //
+
+            MlasSgemmOperation(CblasTrans, CblasNoTrans, CountFilters, OutputSize,
+                InputChannels, 1.0f, filter + FilterStart, FilterCount, input,
+                OutputSize, 0.0f, output + FilterStart * OutputSize, OutputSize);
+
+        } else {
+
+            //
+            // Clear the output channels and then accumulate the column
+            // buffer slices.
+            //
+
+            std::fill_n(output + FilterStart * OutputSize, CountFilters * OutputSize, 0.0f);
+
+            MlasConvTransposeOperation(Parameters, input, filter, ColumnBuffer,
+                output, FilterStart, CountFilters);
+        }
+
+        //
+        // Apply the activation with optional bias.
+        //
+
+        const float* bias = WorkBlock->Bias;
+
+        if (bias != nullptr) {
+            bias += group * FilterCount + FilterStart;
+        }
+
+        MlasActivation(Parameters->Activation, output + FilterStart * OutputSize,
+            bias, CountFilters, OutputSize, OutputSize);
+
+        WorkIndex += CountFilters;
+        WorkRemaining -= CountFilters;
+    }
+}
+
+void
+MLASCALL
+MlasConvTranspose(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the transposed convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor in the layout [InputChannels *
+        GroupCount, FilterCount, KernelShape].
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvTransposePrepare.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.Filter = Filter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.Output = Output;
+    WorkBlock.TargetThreadCount = Parameters->ThreadCount;
+
+    MlasExecuteThreaded(MlasConvTransposeThreaded, &WorkBlock,
+        Parameters->ThreadCount, ThreadPool);
+}
+
+void
+MLASCALL
+MlasConvTransposePrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t Dimensions,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t FilterCount,
+    const MLAS_ACTIVATION* Activation,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a transposed convolution operation by computing
+    required parameters including the required working buffer size for
+    intermediate results.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    Dimensions - Supplies the number of dimensions (must be between 1 and 3).
+
+    BatchCount - Supplies the number of batches to the processed.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    InputShape - Supplies the shape of the input tensor.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    Padding - Supplies the number of padding elements removed from the edge
+        of the output tensor.
+
+    StrideShape - Supplies the shape of the stride.
+
+    OutputShape - Supplies the shape of the output tensor.
+
+    FilterCount - Supplies the number of output channels per group.
+
+    Activation - Supplies the parameters for the activation to apply to the
+        convolution output.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Save the convolution parameters.
+    //
+
+    Parameters->Activation = Activation;
+    Parameters->BatchCount = BatchCount;
+    Parameters->GroupCount = GroupCount;
+    Parameters->InputChannels = InputChannels;
+    Parameters->FilterCount = FilterCount;
+
+    bool AllStridesAreOne;
+    bool AllDilationsAreOne;
+    bool AllPaddingIsZero;
+
+    MlasConvSaveShapes(Parameters, Dimensions, InputShape, KernelShape,
+        DilationShape, Padding, StrideShape, OutputShape, &AllStridesAreOne,
+        &AllDilationsAreOne, &AllPaddingIsZero);
+
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t K = Parameters->K;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. The output channels of all batches and groups are
+    // partitioned across the threads, so each thread owns a disjoint slice
+    // of the output tensor.
+    //
+
+    const size_t TotalWork = BatchCount * GroupCount * FilterCount;
+
+    int32_t TargetThreadCount;
+    double Complexity = double(TotalWork) * double(InputSize) * double(K);
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) >= TotalWork) {
+        TargetThreadCount = int32_t(TotalWork);
+    }
+
+    Parameters->ThreadCount = TargetThreadCount;
+
+    //
+    // Detect a pointwise transposed convolution, which maps directly to a
+    // GEMM with the input tensor.
+    //
+
+    if (AllStridesAreOne && AllPaddingIsZero && K == InputChannels &&
+        InputSize == OutputSize) {
+
+        Parameters->Algorithm = MlasConvAlgorithmGemmDirect;
+
+        *WorkingBufferSize = 0;
+
+        return;
+    }
+
+    Parameters->Algorithm = MlasConvAlgorithmGemmThenCol2Im;
+
+    *WorkingBufferSize = TargetThreadCount * MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD;
+}
@@ -120,6 +120,15 @@ Abstract:
 #define MLAS_DGEMM_STRIDEN                          64
 #define MLAS_DGEMM_STRIDEK                          128
 
+//
+// Define the strides to step through slices of a matrix B that has been
+// packed by MlasGemmPackB. The K stride is larger than the default stride
+// because the cost of packing is not paid per operation.
+//
+
+#define MLAS_SGEMM_PACKED_STRIDEN                   128
+#define MLAS_SGEMM_PACKED_STRIDEK                   256
+
 //
 // Define the alignment for segmenting a GEMM operation across multiple
 // threads.
@@ -347,7 +356,12 @@ void
     size_t ldb,
     int16_t offb,
     int32_t* C,
-    size_t ldc
+    size_t ldc,
+    size_t RangeStartM,
+    size_t RangeStartN,
+    bool AIsPacked,
+    bool BIsPacked,
+    const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor
     );
 
 typedef MLAS_GEMM_X8X8_OPERATION* PMLAS_GEMM_X8X8_OPERATION;
@@ -451,6 +465,43 @@ void
 
 typedef MLAS_ELEMENTWISE_KERNEL_ROUTINE* PMLAS_ELEMENTWISE_KERNEL_ROUTINE;
 
+typedef
+float
+(MLASCALL MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL)(
+    const float* Input,
+    size_t N
+    );
+
+typedef MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL* PMLAS_REDUCE_MAXIMUM_FLOAT_KERNEL;
+
+typedef
+float
+(MLASCALL MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL)(
+    const float* Input,
+    float* Output,
+    size_t N,
+    const float* NegativeMaximum
+    );
+
+typedef MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL* PMLAS_COMPUTE_SUMEXP_FLOAT_KERNEL;
+
+typedef
+void
+(MLASCALL MLAS_COMPUTE_SOFTMAX_OUTPUT_FLOAT_KERNEL)(
+    float* Output,
+    size_t N,
+    const float* Parameters
+    );
+
+typedef
+void
+(MLASCALL MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL)(
+    const float* Input,
+    float* Output,
+    size_t N,
+    const float* Parameters
+    );
+
 extern "C" {
 
 #if defined(MLAS_TARGET_AMD64_IX86)
@@ -550,6 +601,16 @@ extern "C" {
     MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasErfKernelFma3;
 #endif
 
+    MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL MlasReduceMaximumF32Kernel;
+    MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL MlasComputeSumExpF32Kernel;
+    MLAS_COMPUTE_SOFTMAX_OUTPUT_FLOAT_KERNEL MlasComputeSoftmaxOutputF32Kernel;
+    MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL MlasComputeLogSoftmaxOutputF32Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL MlasReduceMaximumF32KernelAvx;
+    MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL MlasComputeSumExpF32KernelFma3;
+    MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL MlasComputeSumExpF32KernelAvx512F;
+#endif
+
 }
 
 //
@@ -631,6 +692,8 @@ struct MLAS_PLATFORM {
     PMLAS_ELEMENTWISE_KERNEL_ROUTINE LogisticKernelRoutine;
     PMLAS_ELEMENTWISE_KERNEL_ROUTINE TanhKernelRoutine;
     PMLAS_ELEMENTWISE_KERNEL_ROUTINE ErfKernelRoutine;
+    PMLAS_REDUCE_MAXIMUM_FLOAT_KERNEL ReduceMaximumF32Kernel;
+    PMLAS_COMPUTE_SUMEXP_FLOAT_KERNEL ComputeSumExpF32Kernel;
     uint32_t NchwcBlockSize;
     uint32_t PreferredBufferAlignment;
 #endif
@@ -1014,6 +1077,42 @@ MlasXorFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
 #endif
 }
 
+inline
+float
+MlasReduceAddFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    Vector = vpaddq_f32(Vector, Vector);
+    Vector = vpaddq_f32(Vector, Vector);
+    return vgetq_lane_f32(Vector, 0);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    float32x2_t VectorLow = vpadd_f32(vget_low_f32(Vector), vget_high_f32(Vector));
+    VectorLow = vpadd_f32(VectorLow, VectorLow);
+    return vget_lane_f32(VectorLow, 0);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    Vector = _mm_add_ps(Vector, _mm_shuffle_ps(Vector, Vector, _MM_SHUFFLE(3, 2, 3, 2)));
+    Vector = _mm_add_ss(Vector, _mm_shuffle_ps(Vector, Vector, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(Vector);
+#endif
+}
+
+inline
+float
+MlasReduceMaximumFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vmaxvq_f32(Vector);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    float32x2_t VectorLow = vpmax_f32(vget_low_f32(Vector), vget_high_f32(Vector));
+    VectorLow = vpmax_f32(VectorLow, VectorLow);
+    return vget_lane_f32(VectorLow, 0);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    Vector = _mm_max_ps(Vector, _mm_shuffle_ps(Vector, Vector, _MM_SHUFFLE(3, 2, 3, 2)));
+    Vector = _mm_max_ss(Vector, _mm_shuffle_ps(Vector, Vector, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(Vector);
+#endif
+}
+
 // calc 2^int(N)
 inline
 MLAS_FLOAT32X4
@@ -47,6 +47,9 @@ struct MLAS_GEMM_X8X8_WORK_BLOCK {
     size_t StrideN;
     int16_t offa;
     int16_t offb;
+    bool AIsPacked;
+    bool BIsPacked;
+    const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor;
 };
 
 #ifdef MLAS_TARGET_AMD64_IX86
@@ -1120,6 +1123,71 @@ Return Value:
     return 1;
 }
 
+//
+// Matrices packed by MlasGemmPackA and MlasGemmPackB start with the raw row or
+// column sums of each slice along the K dimension, followed by the panels of
+// each slice in the layout that the operations otherwise build in their local
+// panel buffers. The sums are scaled by the zero point of the other matrix
+// when the packed matrix is used, so the packed buffer doesn't depend on it.
+//
+
+inline
+size_t
+MlasGemmX8X8PackedCountK(
+    size_t CountK,
+    bool BIsSigned
+    )
+{
+    //
+    // The U8S8 kernels consume matrix A and matrix B in groups of four along
+    // the K dimension and the U8U8 kernels consume them in pairs.
+    //
+
+    if (BIsSigned) {
+        return (CountK + 3) & ~size_t(3);
+    } else {
+        return (CountK + 1) & ~size_t(1);
+    }
+}
+
+inline
+size_t
+MlasGemmX8X8AlignPackedN(
+    size_t N
+    )
+{
+    return (N + MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1) &
+        ~size_t(MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1);
+}
+
+inline
+size_t
+MlasGemmX8X8PackedSumsSize(
+    size_t Count,
+    size_t K
+    )
+{
+    const size_t SliceCountK = (K + MLAS_GEMM_X8X8_STRIDEK - 1) / MLAS_GEMM_X8X8_STRIDEK;
+    const size_t BytesRequired = SliceCountK * Count * sizeof(int32_t);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+
+    return (BytesRequired + BufferAlignment - 1) & ~(BufferAlignment - 1);
+}
+
+inline
+void
+MlasGemmX8X8ScalePackedSums(
+    int32_t* SumVector,
+    const int32_t* PackedSumVector,
+    size_t Count,
+    int16_t Offset
+    )
+{
+    for (size_t i = 0; i < Count; i++) {
+        SumVector[i] = PackedSumVector[i] * int32_t(Offset);
+    }
+}
+
 void
 MLASCALL
 MlasGemmU8S8Operation(
@@ -1133,7 +1201,12 @@ MlasGemmU8S8Operation(
     size_t ldb,
     int16_t offb,
     int32_t* C,
-    size_t ldc
+    size_t ldc,
+    size_t RangeStartM,
+    size_t RangeStartN,
+    bool AIsPacked,
+    bool BIsPacked,
+    const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor
     )
 /*++
 
@@ -1151,15 +1224,19 @@ Arguments:
     K - Supplies the number of columns of matrix A and the number of rows of
         matrix B.
 
-    A - Supplies the address of matrix A.
+    A - Supplies the address of matrix A, or the address of the entire packed
+        matrix A if AIsPacked is true.
 
-    lda - Supplies the first dimension of matrix A.
+    lda - Supplies the first dimension of matrix A, or the total number of
+        rows of the packed matrix A if AIsPacked is true.
 
     offa - Supplies the zero point offset of matrix A.
 
-    B - Supplies the address of matrix B.
+    B - Supplies the address of matrix B, or the address of the entire packed
+        matrix B if BIsPacked is true.
 
-    ldb - Supplies the first dimension of matrix B.
+    ldb - Supplies the first dimension of matrix B, or the total number of
+        columns of the packed matrix B if BIsPacked is true.
 
     offb - Supplies the zero point offset of matrix B.
 
@@ -1167,6 +1244,21 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    RangeStartM - Supplies the starting row of this operation within the
+        overall output matrix, which is passed to the output processor and
+        locates the rows of a packed matrix A.
+
+    RangeStartN - Supplies the starting column of this operation within the
+        overall output matrix, which is passed to the output processor and
+        locates the columns of a packed matrix B.
+
+    AIsPacked - Supplies true if matrix A was packed by MlasGemmPackA.
+
+    BIsPacked - Supplies true if matrix B was packed by MlasGemmPackB.
+
+    OutputProcessor - Optionally supplies the processor that is invoked on
+        each block of matrix C once the block is complete.
+
 Return Value:
 
     None.
@@ -1185,10 +1277,16 @@ Return Value:
 
 #if defined(MLAS_TARGET_AMD64)
 
-    if (M == 1 && offa == 0 && offb == 0) {
+    if (M == 1 && offa == 0 && offb == 0 && !AIsPacked && !BIsPacked) {
 
         if (MlasPlatform.GemvU8S8Kernel != nullptr) {
+
             MlasPlatform.GemvU8S8Kernel(A, (const int8_t*)B, C, K, N, ldb);
+
+            if (OutputProcessor != nullptr) {
+                OutputProcessor->Process(C, RangeStartM, RangeStartN, 1, N, ldc);
+            }
+
             return;
         }
     }
@@ -1223,10 +1321,34 @@ Return Value:
                 CountN = N - n;
             }
 
-            const int8_t* b = (const int8_t*)B + n + k * ldb;
+            const int8_t* pb;
+
+            if (BIsPacked) {
+
+                const size_t AlignedN = MlasGemmX8X8AlignPackedN(ldb);
+                const size_t SliceStartN = RangeStartN + n;
+
+                const int32_t* PackedColumnSums = (const int32_t*)B +
+                    (k / StrideK) * AlignedN + SliceStartN;
+
+                MlasGemmX8X8ScalePackedSums(ColumnSumVector, PackedColumnSums,
+                    MlasGemmX8X8AlignPackedN(CountN), -int16_t(offa));
+
+                const int8_t* PackedPanels = (const int8_t*)(B +
+                    MlasGemmX8X8PackedSumsSize(AlignedN, K));
+
+                pb = PackedPanels + AlignedN * k +
+                    SliceStartN * MlasGemmX8X8PackedCountK(CountK, true);
+
+            } else {
+
+                const int8_t* b = (const int8_t*)B + n + k * ldb;
 
-            MlasPlatform.GemmU8S8CopyPackBRoutine(PanelB, b, ldb, CountN,
-                CountK, ColumnSumVector, -int16_t(offa));
+                MlasPlatform.GemmU8S8CopyPackBRoutine(PanelB, b, ldb, CountN,
+                    CountK, ColumnSumVector, -int16_t(offa));
+
+                pb = PanelB;
+            }
 
             size_t CountM;
 
@@ -1238,10 +1360,32 @@ Return Value:
                     CountM = M - m;
                 }
 
-                MlasPlatform.GemmU8S8CopyPackARoutine(PanelA, A + k + m * lda,
-                    lda, CountM, CountK, RowSumVector, -int16_t(offb));
+                const uint8_t* pa;
+
+                if (AIsPacked) {
+
+                    const size_t SliceStartM = RangeStartM + m;
+
+                    const int32_t* PackedRowSums = (const int32_t*)A +
+                        (k / StrideK) * lda + SliceStartM;
+
+                    MlasGemmX8X8ScalePackedSums(RowSumVector, PackedRowSums,
+                        CountM, -int16_t(offb));
+
+                    const uint8_t* PackedPanels = (const uint8_t*)(A +
+                        MlasGemmX8X8PackedSumsSize(lda, K));
+
+                    pa = PackedPanels + lda * k +
+                        SliceStartM * MlasGemmX8X8PackedCountK(CountK, true);
+
+                } else {
+
+                    MlasPlatform.GemmU8S8CopyPackARoutine(PanelA, A + k + m * lda,
+                        lda, CountM, CountK, RowSumVector, -int16_t(offb));
+
+                    pa = PanelA;
+                }
 
-                uint8_t* pa = PanelA;
                 int32_t* c = C + n + m * ldc;
 
                 int32_t* RowSums = RowSumVector;
@@ -1253,7 +1397,7 @@ Return Value:
 
                 while (RowsRemaining > 0) {
 
-                    RowsHandled = MlasPlatform.GemmU8S8Kernel(pa, PanelB, c,
+                    RowsHandled = MlasPlatform.GemmU8S8Kernel(pa, pb, c,
                         QuadCountK, RowsRemaining, CountN, ldc, RowSums,
                         ColumnSumVector, int32_t(CountK) * offa * offb, k == 0);
 
@@ -1262,6 +1406,16 @@ Return Value:
                     pa += 4 * QuadCountK * RowsHandled;
                     RowSums += RowsHandled;
                 }
+
+                //
+                // Invoke the output processor on the completed block while
+                // it is still in the cache.
+                //
+
+                if (OutputProcessor != nullptr && (k + CountK) == K) {
+                    OutputProcessor->Process(C + n + m * ldc, RangeStartM + m,
+                        RangeStartN + n, CountM, CountN, ldc);
+                }
             }
         }
     }
@@ -1280,7 +1434,12 @@ MlasGemmU8U8Operation(
     size_t ldb,
     int16_t offb,
     int32_t* C,
-    size_t ldc
+    size_t ldc,
+    size_t RangeStartM,
+    size_t RangeStartN,
+    bool AIsPacked,
+    bool BIsPacked,
+    const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor
     )
 /*++
 
@@ -1298,15 +1457,19 @@ Arguments:
     K - Supplies the number of columns of matrix A and the number of rows of
         matrix B.
 
-    A - Supplies the address of matrix A.
+    A - Supplies the address of matrix A, or the address of the entire packed
+        matrix A if AIsPacked is true.
 
-    lda - Supplies the first dimension of matrix A.
+    lda - Supplies the first dimension of matrix A, or the total number of
+        rows of the packed matrix A if AIsPacked is true.
 
     offa - Supplies the zero point offset of matrix A.
 
-    B - Supplies the address of matrix B.
+    B - Supplies the address of matrix B, or the address of the entire packed
+        matrix B if BIsPacked is true.
 
-    ldb - Supplies the first dimension of matrix B.
+    ldb - Supplies the first dimension of matrix B, or the total number of
+        columns of the packed matrix B if BIsPacked is true.
 
     offb - Supplies the zero point offset of matrix B.
 
@@ -1314,6 +1477,21 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    RangeStartM - Supplies the starting row of this operation within the
+        overall output matrix, which is passed to the output processor and
+        locates the rows of a packed matrix A.
+
+    RangeStartN - Supplies the starting column of this operation within the
+        overall output matrix, which is passed to the output processor and
+        locates the columns of a packed matrix B.
+
+    AIsPacked - Supplies true if matrix A was packed by MlasGemmPackA.
+
+    BIsPacked - Supplies true if matrix B was packed by MlasGemmPackB.
+
+    OutputProcessor - Optionally supplies the processor that is invoked on
+        each block of matrix C once the block is complete.
+
 Return Value:
 
     None.
@@ -1358,10 +1536,34 @@ Return Value:
                 CountN = N - n;
             }
 
-            const uint8_t* b = (const uint8_t*)B + n + k * ldb;
+            const uint8_t* pb;
+
+            if (BIsPacked) {
 
-            MlasPlatform.GemmU8U8CopyPackBRoutine(PanelB, b, ldb, CountN,
-                CountK, ColumnSumVector, -int16_t(offa));
+                const size_t AlignedN = MlasGemmX8X8AlignPackedN(ldb);
+                const size_t SliceStartN = RangeStartN + n;
+
+                const int32_t* PackedColumnSums = (const int32_t*)B +
+                    (k / StrideK) * AlignedN + SliceStartN;
+
+                MlasGemmX8X8ScalePackedSums(ColumnSumVector, PackedColumnSums,
+                    MlasGemmX8X8AlignPackedN(CountN), -int16_t(offa));
+
+                const uint8_t* PackedPanels = (const uint8_t*)(B +
+                    MlasGemmX8X8PackedSumsSize(AlignedN, K));
+
+                pb = PackedPanels + AlignedN * k +
+                    SliceStartN * MlasGemmX8X8PackedCountK(CountK, false);
+
+            } else {
+
+                const uint8_t* b = (const uint8_t*)B + n + k * ldb;
+
+                MlasPlatform.GemmU8U8CopyPackBRoutine(PanelB, b, ldb, CountN,
+                    CountK, ColumnSumVector, -int16_t(offa));
+
+                pb = PanelB;
+            }
 
             size_t CountM;
 
@@ -1373,10 +1575,32 @@ Return Value:
                     CountM = M - m;
                 }
 
-                MlasPlatform.GemmU8U8CopyPackARoutine(PanelA, A + k + m * lda,
-                    lda, CountM, CountK, RowSumVector, -int16_t(offb));
+                const int16_t* pa;
+
+                if (AIsPacked) {
+
+                    const size_t SliceStartM = RangeStartM + m;
+
+                    const int32_t* PackedRowSums = (const int32_t*)A +
+                        (k / StrideK) * lda + SliceStartM;
+
+                    MlasGemmX8X8ScalePackedSums(RowSumVector, PackedRowSums,
+                        CountM, -int16_t(offb));
+
+                    const int16_t* PackedPanels = (const int16_t*)(A +
+                        MlasGemmX8X8PackedSumsSize(lda, K));
+
+                    pa = PackedPanels + lda * k +
+                        SliceStartM * MlasGemmX8X8PackedCountK(CountK, false);
+
+                } else {
+
+                    MlasPlatform.GemmU8U8CopyPackARoutine(PanelA, A + k + m * lda,
+                        lda, CountM, CountK, RowSumVector, -int16_t(offb));
+
+                    pa = PanelA;
+                }
 
-                int16_t* pa = PanelA;
                 int32_t* c = C + n + m * ldc;
 
                 int32_t* RowSums = RowSumVector;
@@ -1388,7 +1612,7 @@ Return Value:
 
                 while (RowsRemaining > 0) {
 
-                    RowsHandled = MlasPlatform.GemmU8U8Kernel(pa, PanelB, c,
+                    RowsHandled = MlasPlatform.GemmU8U8Kernel(pa, pb, c,
                         PairCountK, RowsRemaining, CountN, ldc, RowSums,
                         ColumnSumVector, int32_t(CountK) * offa * offb, k == 0);
 
@@ -1397,6 +1621,16 @@ Return Value:
                     pa += 2 * PairCountK * RowsHandled;
                     RowSums += RowsHandled;
                 }
+
+                //
+                // Invoke the output processor on the completed block while
+                // it is still in the cache.
+                //
+
+                if (OutputProcessor != nullptr && (k + CountK) == K) {
+                    OutputProcessor->Process(C + n + m * ldc, RangeStartM + m,
+                        RangeStartN + n, CountM, CountN, ldc);
+                }
             }
         }
     }
@@ -1472,12 +1706,18 @@ Return Value:
     const size_t ldb = WorkBlock->ldb;
     const size_t ldc = WorkBlock->ldc;
 
-    const uint8_t* a = WorkBlock->A + m * lda;
-    const uint8_t* b = WorkBlock->B + n;
+    //
+    // Packed matrices are located by the operation from the range start, so
+    // they are passed through unchanged.
+    //
+
+    const uint8_t* a = WorkBlock->AIsPacked ? WorkBlock->A : WorkBlock->A + m * lda;
+    const uint8_t* b = WorkBlock->BIsPacked ? WorkBlock->B : WorkBlock->B + n;
     int32_t* c = WorkBlock->C + n + m * ldc;
 
     WorkBlock->GemmX8X8Operation(CountM, CountN, WorkBlock->K, a, lda,
-        WorkBlock->offa, b, ldb, WorkBlock->offb, c, ldc);
+        WorkBlock->offa, b, ldb, WorkBlock->offb, c, ldc, m, n,
+        WorkBlock->AIsPacked, WorkBlock->BIsPacked, WorkBlock->OutputProcessor);
 }
 
 void
@@ -1576,7 +1816,8 @@ MlasGemm(
     int8_t offb,
     int32_t* C,
     size_t ldc,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor
     )
 /*++
 
@@ -1613,6 +1854,10 @@ Arguments:
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
+    OutputProcessor - Optionally supplies the processor that is invoked on
+        each block of matrix C once the block is complete, for example to
+        requantize or dequantize the accumulators.
+
 Return Value:
 
     None.
@@ -1636,6 +1881,9 @@ Return Value:
     WorkBlock.ldc = ldc;
     WorkBlock.offa = int16_t(offa);
     WorkBlock.offb = int16_t(offb);
+    WorkBlock.AIsPacked = false;
+    WorkBlock.BIsPacked = false;
+    WorkBlock.OutputProcessor = OutputProcessor;
     WorkBlock.GemmX8X8Operation = MlasGemmU8S8Operation;
 
     //
@@ -1659,7 +1907,8 @@ MlasGemm(
     uint8_t offb,
     int32_t* C,
     size_t ldc,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor
     )
 /*++
 
@@ -1696,6 +1945,10 @@ Arguments:
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
+    OutputProcessor - Optionally supplies the processor that is invoked on
+        each block of matrix C once the block is complete, for example to
+        requantize or dequantize the accumulators.
+
 Return Value:
 
     None.
@@ -1719,6 +1972,9 @@ Return Value:
     WorkBlock.ldc = ldc;
     WorkBlock.offa = int16_t(offa);
     WorkBlock.offb = int16_t(offb);
+    WorkBlock.AIsPacked = false;
+    WorkBlock.BIsPacked = false;
+    WorkBlock.OutputProcessor = OutputProcessor;
     WorkBlock.GemmX8X8Operation = MlasGemmU8U8Operation;
 
     //
@@ -1728,4 +1984,453 @@ Return Value:
     MlasGemmX8X8Schedule(&WorkBlock, ThreadPool);
 }
 
+size_t
+MLASCALL
+MlasGemmPackBSize(
+    size_t N,
+    size_t K,
+    bool BIsSigned
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of bytes required to pack matrix B for
+    use with the packed quantized integer matrix/matrix multiply operation.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    BIsSigned - Supplies true if matrix B holds signed values.
+
+Return Value:
+
+    Returns the number of bytes required to pack matrix B.
+
+--*/
+{
+    const size_t AlignedN = MlasGemmX8X8AlignPackedN(N);
+    const size_t BytesRequired = MlasGemmX8X8PackedSumsSize(AlignedN, K) +
+        AlignedN * MlasGemmX8X8PackedCountK(K, BIsSigned);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+
+    return (BytesRequired + BufferAlignment - 1) & ~(BufferAlignment - 1);
+}
+
+void
+MLASCALL
+MlasGemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    bool BIsSigned,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the contents of matrix B to the destination buffer. The
+    destination buffer should be sized based on MlasGemmPackBSize() and
+    aligned to MlasGetPreferredBufferAlignment().
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    BIsSigned - Supplies true if matrix B holds signed values.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(int32_t ColumnSumVector[MLAS_GEMM_X8X8_STRIDEN], 16);
+
+    const size_t AlignedN = MlasGemmX8X8AlignPackedN(N);
+    const size_t PackedSumsSize = MlasGemmX8X8PackedSumsSize(AlignedN, K);
+
+    //
+    // Clear the column sums so that the padding columns, which the kernels
+    // read as a full group, are zero.
+    //
+
+    int32_t* PackedColumnSums = (int32_t*)PackedB;
+    uint8_t* PackedPanels = (uint8_t*)PackedB + PackedSumsSize;
+
+    memset(PackedColumnSums, 0, PackedSumsSize);
+
+    //
+    // Step through each slice of matrix B along the K dimension and then
+    // along the N dimension, packing with a unit zero point offset to capture
+    // the raw column sums.
+    //
+
+    size_t CountK;
+
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = MLAS_GEMM_X8X8_STRIDEK;
+
+        if (CountK > (K - k)) {
+            CountK = K - k;
+        }
+
+        const size_t PackedCountK = MlasGemmX8X8PackedCountK(CountK, BIsSigned);
+
+        size_t CountN;
+
+        for (size_t n = 0; n < N; n += CountN) {
+
+            CountN = MLAS_GEMM_X8X8_STRIDEN;
+
+            if (CountN > (N - n)) {
+                CountN = N - n;
+            }
+
+            uint8_t* D = PackedPanels + AlignedN * k + n * PackedCountK;
+            const uint8_t* b = B + n + k * ldb;
+
+            if (BIsSigned) {
+                MlasPlatform.GemmU8S8CopyPackBRoutine((int8_t*)D, (const int8_t*)b,
+                    ldb, CountN, CountK, ColumnSumVector, 1);
+            } else {
+                MlasPlatform.GemmU8U8CopyPackBRoutine(D, b, ldb, CountN, CountK,
+                    ColumnSumVector, 1);
+            }
+
+            memcpy(PackedColumnSums + (k / MLAS_GEMM_X8X8_STRIDEK) * AlignedN + n,
+                ColumnSumVector, CountN * sizeof(int32_t));
+        }
+    }
+}
+
+size_t
+MLASCALL
+MlasGemmPackASize(
+    size_t M,
+    size_t K,
+    bool BIsSigned
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of bytes required to pack matrix A for
+    use with the packed quantized integer matrix/matrix multiply operation.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A.
+
+    K - Supplies the number of columns of matrix A.
+
+    BIsSigned - Supplies true if matrix A will be multiplied with a matrix B
+        that holds signed values, which selects the packed format.
+
+Return Value:
+
+    Returns the number of bytes required to pack matrix A.
+
+--*/
+{
+    const size_t ElementSize = BIsSigned ? sizeof(uint8_t) : sizeof(int16_t);
+    const size_t BytesRequired = MlasGemmX8X8PackedSumsSize(M, K) +
+        M * MlasGemmX8X8PackedCountK(K, BIsSigned) * ElementSize;
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+
+    return (BytesRequired + BufferAlignment - 1) & ~(BufferAlignment - 1);
+}
+
+void
+MLASCALL
+MlasGemmPackA(
+    size_t M,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    bool BIsSigned,
+    void* PackedA
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the contents of matrix A to the destination buffer. The
+    destination buffer should be sized based on MlasGemmPackASize() and
+    aligned to MlasGetPreferredBufferAlignment().
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A.
+
+    K - Supplies the number of columns of matrix A.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    BIsSigned - Supplies true if matrix A will be multiplied with a matrix B
+        that holds signed values, which selects the packed format.
+
+    PackedA - Supplies the address of packed matrix A.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(int32_t RowSumVector[MLAS_GEMM_X8X8_STRIDEM], 16);
+
+    const size_t PackedSumsSize = MlasGemmX8X8PackedSumsSize(M, K);
+
+    int32_t* PackedRowSums = (int32_t*)PackedA;
+    uint8_t* PackedPanels = (uint8_t*)PackedA + PackedSumsSize;
+
+    //
+    // Step through each slice of matrix A along the K dimension and then
+    // along the M dimension, packing with a unit zero point offset to capture
+    // the raw row sums.
+    //
+
+    size_t CountK;
+
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = MLAS_GEMM_X8X8_STRIDEK;
+
+        if (CountK > (K - k)) {
+            CountK = K - k;
+        }
+
+        const size_t PackedCountK = MlasGemmX8X8PackedCountK(CountK, BIsSigned);
+
+        size_t CountM;
+
+        for (size_t m = 0; m < M; m += CountM) {
+
+            CountM = MLAS_GEMM_X8X8_STRIDEM;
+
+            if (CountM > (M - m)) {
+                CountM = M - m;
+            }
+
+            const uint8_t* a = A + k + m * lda;
+
+            if (BIsSigned) {
+                MlasPlatform.GemmU8S8CopyPackARoutine(PackedPanels + M * k +
+                    m * PackedCountK, a, lda, CountM, CountK, RowSumVector, 1);
+            } else {
+                MlasPlatform.GemmU8U8CopyPackARoutine((int16_t*)PackedPanels +
+                    M * k + m * PackedCountK, a, lda, CountM, CountK,
+                    RowSumVector, 1);
+            }
+
+            memcpy(PackedRowSums + (k / MLAS_GEMM_X8X8_STRIDEK) * M + m,
+                RowSumVector, CountM * sizeof(int32_t));
+        }
+    }
+}
+
+void
+MLASCALL
+MlasGemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const void* PackedB,
+    uint8_t offb,
+    bool BIsSigned,
+    int32_t* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM) using a matrix B that has been packed by MlasGemmPackB.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    offa - Supplies the zero point offset of matrix A.
+
+    PackedB - Supplies the address of packed matrix B.
+
+    offb - Supplies the zero point offset of matrix B. If matrix B holds signed
+        values, the offset is the signed value reinterpreted as unsigned.
+
+    BIsSigned - Supplies true if matrix B holds signed values.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+    OutputProcessor - Optionally supplies the processor that is invoked on
+        each block of matrix C once the block is complete, for example to
+        requantize or dequantize the accumulators.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_GEMM_X8X8_WORK_BLOCK WorkBlock;
+
+    //
+    // Capture the GEMM parameters to the work block. The total number of
+    // columns of the packed matrix B is passed as its first dimension.
+    //
+
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.B = (const uint8_t*)PackedB;
+    WorkBlock.ldb = N;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+    WorkBlock.offa = int16_t(offa);
+    WorkBlock.offb = BIsSigned ? int16_t(int8_t(offb)) : int16_t(offb);
+    WorkBlock.AIsPacked = false;
+    WorkBlock.BIsPacked = true;
+    WorkBlock.OutputProcessor = OutputProcessor;
+    WorkBlock.GemmX8X8Operation = BIsSigned ? MlasGemmU8S8Operation : MlasGemmU8U8Operation;
+
+    //
+    // Schedule the operation across a set of worker threads.
+    //
+
+    MlasGemmX8X8Schedule(&WorkBlock, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const void* PackedA,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    bool BIsSigned,
+    int32_t* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool,
+    const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM) using a matrix A that has been packed by MlasGemmPackA.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    PackedA - Supplies the address of packed matrix A.
+
+    offa - Supplies the zero point offset of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    offb - Supplies the zero point offset of matrix B. If matrix B holds signed
+        values, the offset is the signed value reinterpreted as unsigned.
+
+    BIsSigned - Supplies true if matrix B holds signed values. This must match
+        the value used to pack matrix A.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+    OutputProcessor - Optionally supplies the processor that is invoked on
+        each block of matrix C once the block is complete, for example to
+        requantize or dequantize the accumulators.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_GEMM_X8X8_WORK_BLOCK WorkBlock;
+
+    //
+    // Capture the GEMM parameters to the work block. The total number of
+    // rows of the packed matrix A is passed as its first dimension.
+    //
+
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.A = (const uint8_t*)PackedA;
+    WorkBlock.lda = M;
+    WorkBlock.B = B;
+    WorkBlock.ldb = ldb;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+    WorkBlock.offa = int16_t(offa);
+    WorkBlock.offb = BIsSigned ? int16_t(int8_t(offb)) : int16_t(offb);
+    WorkBlock.AIsPacked = true;
+    WorkBlock.BIsPacked = false;
+    WorkBlock.OutputProcessor = OutputProcessor;
+    WorkBlock.GemmX8X8Operation = BIsSigned ? MlasGemmU8S8Operation : MlasGemmU8U8Operation;
+
+    //
+    // Schedule the operation across a set of worker threads.
+    //
+
+    MlasGemmX8X8Schedule(&WorkBlock, ThreadPool);
+}
+
 #endif
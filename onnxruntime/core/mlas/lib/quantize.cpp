@@ -183,6 +183,159 @@ MlasQuantizeLinearKernel(
     }
 }
 
+MLAS_FORCEINLINE
+MLAS_INT32X4
+MlasRequantizeOutputVector(
+    MLAS_INT32X4 IntegerVector,
+    MLAS_FLOAT32X4 ScaleVector,
+    MLAS_FLOAT32X4 MinimumValueVector,
+    MLAS_FLOAT32X4 MaximumValueVector,
+    MLAS_INT32X4 ZeroPointVector
+    )
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    auto FloatVector = vmulq_f32(vcvtq_f32_s32(IntegerVector), ScaleVector);
+    FloatVector = vmaxnmq_f32(FloatVector, MinimumValueVector);
+    FloatVector = vminnmq_f32(FloatVector, MaximumValueVector);
+    return vaddq_s32(vcvtnq_s32_f32(FloatVector), ZeroPointVector);
+#else
+    auto FloatVector = _mm_mul_ps(_mm_cvtepi32_ps(IntegerVector), ScaleVector);
+    FloatVector = _mm_max_ps(FloatVector, MinimumValueVector);
+    FloatVector = _mm_min_ps(FloatVector, MaximumValueVector);
+    return _mm_add_epi32(_mm_cvtps_epi32(FloatVector), ZeroPointVector);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasRequantizeOutputRow(
+    const int32_t* Input,
+    uint8_t* Output,
+    size_t N,
+    int32_t RowBias,
+    const int32_t* ColumnBias,
+    float RowScale,
+    const float* ColumnScale,
+    int32_t ZeroPoint
+    )
+{
+    auto RowBiasVector = MlasBroadcastInt32x4(RowBias);
+    auto ScaleVector = MlasBroadcastFloat32x4(RowScale);
+    auto MinimumValueVector = MlasBroadcastFloat32x4(float(0 - ZeroPoint));
+    auto MaximumValueVector = MlasBroadcastFloat32x4(float(255 - ZeroPoint));
+    auto ZeroPointVector = MlasBroadcastInt32x4(ZeroPoint);
+
+    while (N >= 4) {
+
+#if defined(MLAS_NEON64_INTRINSICS)
+        auto IntegerVector = vaddq_s32(vld1q_s32(Input), RowBiasVector);
+        if (ColumnBias != nullptr) {
+            IntegerVector = vaddq_s32(IntegerVector, vld1q_s32(ColumnBias));
+            ColumnBias += 4;
+        }
+#else
+        auto IntegerVector = _mm_add_epi32(_mm_loadu_si128((const __m128i*)Input), RowBiasVector);
+        if (ColumnBias != nullptr) {
+            IntegerVector = _mm_add_epi32(IntegerVector, _mm_loadu_si128((const __m128i*)ColumnBias));
+            ColumnBias += 4;
+        }
+#endif
+
+        if (ColumnScale != nullptr) {
+            ScaleVector = MlasLoadFloat32x4(ColumnScale);
+            ColumnScale += 4;
+        }
+
+        IntegerVector = MlasRequantizeOutputVector(IntegerVector, ScaleVector,
+            MinimumValueVector, MaximumValueVector, ZeroPointVector);
+
+        IntegerVector = MlasQuantizeLinearPackBytes<uint8_t>(IntegerVector);
+
+#if defined(MLAS_NEON64_INTRINSICS)
+        vst1q_lane_s32((int32_t*)Output, IntegerVector, 0);
+#else
+        *((int32_t*)Output) = _mm_cvtsi128_si32(IntegerVector);
+#endif
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    for (size_t n = 0; n < N; n++) {
+
+        int32_t IntegerValue = Input[n] + RowBias;
+        if (ColumnBias != nullptr) {
+            IntegerValue += ColumnBias[n];
+        }
+
+        if (ColumnScale != nullptr) {
+            ScaleVector = MlasBroadcastFloat32x4(ColumnScale[n]);
+        }
+
+        auto IntegerVector = MlasRequantizeOutputVector(MlasBroadcastInt32x4(IntegerValue),
+            ScaleVector, MinimumValueVector, MaximumValueVector, ZeroPointVector);
+
+#if defined(MLAS_NEON64_INTRINSICS)
+        vst1q_lane_u8(Output + n, vreinterpretq_u8_s32(IntegerVector), 0);
+#else
+        Output[n] = (uint8_t)_mm_cvtsi128_si32(IntegerVector);
+#endif
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasScaleBiasOutputRow(
+    const int32_t* Input,
+    float* Output,
+    size_t N,
+    float RowScale,
+    const float* ColumnScale,
+    const float* ColumnBias
+    )
+{
+    auto ScaleVector = MlasBroadcastFloat32x4(RowScale);
+
+    while (N >= 4) {
+
+#if defined(MLAS_NEON64_INTRINSICS)
+        auto FloatVector = vcvtq_f32_s32(vld1q_s32(Input));
+#else
+        auto FloatVector = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)Input));
+#endif
+
+        if (ColumnScale != nullptr) {
+            ScaleVector = MlasLoadFloat32x4(ColumnScale);
+            ColumnScale += 4;
+        }
+
+        FloatVector = MlasMultiplyFloat32x4(FloatVector, ScaleVector);
+
+        if (ColumnBias != nullptr) {
+            FloatVector = MlasAddFloat32x4(FloatVector, MlasLoadFloat32x4(ColumnBias));
+            ColumnBias += 4;
+        }
+
+        MlasStoreFloat32x4(Output, FloatVector);
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    for (size_t n = 0; n < N; n++) {
+
+        float FloatValue = float(Input[n]) * ((ColumnScale != nullptr) ? ColumnScale[n] : RowScale);
+
+        if (ColumnBias != nullptr) {
+            FloatValue += ColumnBias[n];
+        }
+
+        Output[n] = FloatValue;
+    }
+}
+
 #else
 
 //
@@ -209,6 +362,56 @@ MlasQuantizeLinearKernel(
     }
 }
 
+MLAS_FORCEINLINE
+void
+MlasRequantizeOutputRow(
+    const int32_t* Input,
+    uint8_t* Output,
+    size_t N,
+    int32_t RowBias,
+    const int32_t* ColumnBias,
+    float RowScale,
+    const float* ColumnScale,
+    int32_t ZeroPoint
+    )
+{
+    for (size_t n = 0; n < N; n++) {
+
+        int32_t IntegerValue = Input[n] + RowBias;
+        if (ColumnBias != nullptr) {
+            IntegerValue += ColumnBias[n];
+        }
+
+        float FloatValue = float(IntegerValue) * ((ColumnScale != nullptr) ? ColumnScale[n] : RowScale);
+        FloatValue = std::max(FloatValue, float(0 - ZeroPoint));
+        FloatValue = std::min(FloatValue, float(255 - ZeroPoint));
+        Output[n] = (uint8_t)((int32_t)std::nearbyintf(FloatValue) + ZeroPoint);
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasScaleBiasOutputRow(
+    const int32_t* Input,
+    float* Output,
+    size_t N,
+    float RowScale,
+    const float* ColumnScale,
+    const float* ColumnBias
+    )
+{
+    for (size_t n = 0; n < N; n++) {
+
+        float FloatValue = float(Input[n]) * ((ColumnScale != nullptr) ? ColumnScale[n] : RowScale);
+
+        if (ColumnBias != nullptr) {
+            FloatValue += ColumnBias[n];
+        }
+
+        Output[n] = FloatValue;
+    }
+}
+
 #endif
 
 void
@@ -284,3 +487,175 @@ Return Value:
 {
     return MlasQuantizeLinearKernel<int8_t, -127, 127>(Input, Output, N, Scale, ZeroPoint);
 }
+
+void
+MLASCALL
+MlasRequantizeOutput(
+    const int32_t* Input,
+    size_t InputLeadingDimension,
+    uint8_t* Output,
+    size_t OutputLeadingDimension,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerRowScale,
+    uint8_t ZeroPoint,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine requantizes the 32-bit integer accumulators of a quantized
+    matrix multiply or convolution to 8-bit values in a single pass:
+
+        Output = Saturate(RoundToEven((Input + Bias) * Scale) + ZeroPoint)
+
+    Each row of the matrix typically holds one output channel, so the bias and
+    optionally the scale are supplied per row.
+
+Arguments:
+
+    Input - Supplies the input matrix of 32-bit accumulators.
+
+    InputLeadingDimension - Supplies the number of elements between the rows of
+        the input matrix.
+
+    Output - Supplies the output matrix.
+
+    OutputLeadingDimension - Supplies the number of elements between the rows
+        of the output matrix.
+
+    Bias - Optionally supplies the per-row bias vector.
+
+    Scale - Supplies the scale. If PerRowScale is true, this is a vector of M
+        elements, else a single value.
+
+    PerRowScale - Supplies true if the scale is supplied per row.
+
+    ZeroPoint - Supplies the output zero point value.
+
+    M - Supplies the number of rows of the matrices.
+
+    N - Supplies the number of columns of the matrices.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t m = 0; m < M; m++) {
+
+        MlasRequantizeOutputRow(Input, Output, N, (Bias != nullptr) ? Bias[m] : 0,
+            nullptr, PerRowScale ? Scale[m] : Scale[0], nullptr, ZeroPoint);
+
+        Input += InputLeadingDimension;
+        Output += OutputLeadingDimension;
+    }
+}
+
+void
+MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR::Process(
+    const int32_t* C,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    ) const
+/*++
+
+Routine Description:
+
+    This routine requantizes a block of the 32-bit accumulators produced by a
+    quantized matrix/matrix multiply to the 8-bit output matrix.
+
+Arguments:
+
+    C - Supplies the address of the block of accumulators.
+
+    StartM - Supplies the starting row of the block within the output matrix.
+
+    StartN - Supplies the starting column of the block within the output
+        matrix.
+
+    CountM - Supplies the number of rows of the block.
+
+    CountN - Supplies the number of columns of the block.
+
+    ldc - Supplies the first dimension of the accumulator matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    uint8_t* Output = Output_ + StartM * OutputLeadingDimension_ + StartN;
+    const int32_t* Bias = (Bias_ != nullptr) ? Bias_ + StartN : nullptr;
+    const float* ColumnScale = PerColumnScale_ ? Scale_ + StartN : nullptr;
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        MlasRequantizeOutputRow(C, Output, CountN, 0, Bias, Scale_[0],
+            ColumnScale, ZeroPoint_);
+
+        C += ldc;
+        Output += OutputLeadingDimension_;
+    }
+}
+
+void
+MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR::Process(
+    const int32_t* C,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    ) const
+/*++
+
+Routine Description:
+
+    This routine dequantizes a block of the 32-bit accumulators produced by a
+    quantized matrix/matrix multiply to the floating point output matrix and
+    applies the optional activation.
+
+Arguments:
+
+    C - Supplies the address of the block of accumulators.
+
+    StartM - Supplies the starting row of the block within the output matrix.
+
+    StartN - Supplies the starting column of the block within the output
+        matrix.
+
+    CountM - Supplies the number of rows of the block.
+
+    CountN - Supplies the number of columns of the block.
+
+    ldc - Supplies the first dimension of the accumulator matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float* Output = Output_ + StartM * OutputLeadingDimension_ + StartN;
+    const float* Bias = (Bias_ != nullptr) ? Bias_ + StartN : nullptr;
+    const float* ColumnScale = PerColumnScale_ ? Scale_ + StartN : nullptr;
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        MlasScaleBiasOutputRow(C + m * ldc, Output + m * OutputLeadingDimension_,
+            CountN, Scale_[0], ColumnScale, Bias);
+    }
+
+    if (Activation_ != nullptr) {
+        MlasActivation(Activation_, Output, nullptr, CountM, CountN,
+            OutputLeadingDimension_);
+    }
+}
@@ -40,15 +40,43 @@ struct MLAS_SGEMM_WORK_BLOCK {
     size_t ldc;
     float alpha;
     float beta;
+    const void* PackedB;
+    size_t AlignedN;
     struct SEGMENT {
         size_t M;
         size_t N;
+        size_t StartN;
         const float* A;
         const float* B;
         float* C;
     } Segments[MLAS_MAXIMUM_THREAD_COUNT];
 };
 
+inline
+size_t
+MlasSgemmAlignPackedN(
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the number of columns of matrix B after padding to
+    the width of the panels stored in a packed buffer.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+Return Value:
+
+    Returns the number of aligned columns.
+
+--*/
+{
+    return (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+}
+
 void
 MlasSgemmMultiplyBeta(
     float* C,
@@ -762,6 +790,141 @@ Return Value:
     }
 }
 
+void
+MlasSgemmKernelLoop(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* PanelB,
+    float* C,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine steps through the rows of matrix A and invokes the SGEMM
+    kernel to multiply each block of rows by the packed panel of matrix B.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    CountN - Supplies the number of columns of the packed panel of matrix B
+        and matrix C.
+
+    CountK - Supplies the number of columns of matrix A and the number of rows
+        of the packed panel of matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A, adjusted to the current slice of the
+        K dimension.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PanelB - Supplies the address of the packed panel of matrix B.
+
+    C - Supplies the address of matrix C, adjusted to the current slice of the
+        N dimension.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t RowsRemaining = M;
+    size_t RowsHandled;
+
+    if (TransA == CblasNoTrans) {
+
+        //
+        // Step through the rows of matrix A.
+        //
+
+        do {
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+            RowsHandled = MlasPlatform.GemmFloatKernel(A, PanelB, C, CountK, RowsRemaining, CountN, lda, ldc, alpha, ZeroMode);
+#else
+            if (ZeroMode) {
+                RowsHandled = MlasSgemmKernelZero(A, PanelB, C, CountK, RowsRemaining, CountN, lda, ldc, alpha);
+            } else {
+                RowsHandled = MlasSgemmKernelAdd(A, PanelB, C, CountK, RowsRemaining, CountN, lda, ldc, alpha);
+            }
+#endif
+
+            C += ldc * RowsHandled;
+            A += lda * RowsHandled;
+
+            RowsRemaining -= RowsHandled;
+
+        } while (RowsRemaining > 0);
+
+    } else {
+
+        float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_PACKED_STRIDEK];
+
+        do {
+
+            //
+            // Transpose elements from matrix A into a local buffer.
+            //
+
+            size_t RowsTransposed = RowsRemaining;
+
+            if (RowsTransposed > MLAS_SGEMM_TRANSA_ROWS) {
+                RowsTransposed = MLAS_SGEMM_TRANSA_ROWS;
+            }
+
+            RowsRemaining -= RowsTransposed;
+
+            MlasSgemmTransposeA(PanelA, A, lda, RowsTransposed, CountK);
+
+            A += RowsTransposed;
+
+            //
+            // Step through the rows of the local buffer.
+            //
+
+            const float* pa = PanelA;
+
+            do {
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+                RowsHandled = MlasPlatform.GemmFloatKernel(pa, PanelB, C, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+#else
+                if (ZeroMode) {
+                    RowsHandled = MlasSgemmKernelZero(pa, PanelB, C, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
+                } else {
+                    RowsHandled = MlasSgemmKernelAdd(pa, PanelB, C, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
+                }
+#endif
+
+                C += ldc * RowsHandled;
+                pa += CountK * RowsHandled;
+
+                RowsTransposed -= RowsHandled;
+
+            } while (RowsTransposed > 0);
+
+        } while (RowsRemaining > 0);
+    }
+}
+
 void
 MlasSgemmOperation(
     CBLAS_TRANSPOSE TransA,
@@ -820,7 +983,6 @@ Return Value:
 
 --*/
 {
-    float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_STRIDEK];
     MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK], 16 * sizeof(float));
 
     //
@@ -955,87 +1117,125 @@ Return Value:
             // Step through each slice of matrix A along the M dimension.
             //
 
-            float* c = C + n;
+            const float* a = (TransA == CblasNoTrans) ? A + k : A + k * lda;
+
+            MlasSgemmKernelLoop(TransA, M, CountN, CountK, alpha, a, lda, PanelB,
+                C + n, ldc, ZeroMode);
+        }
+    }
+}
+
+void
+MlasSgemmPackedOperation(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    size_t AlignedN,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
 
-            size_t RowsRemaining = M;
-            size_t RowsHandled;
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) using a matrix B that has been packed by MlasGemmPackB.
 
-            if (TransA == CblasNoTrans) {
+Arguments:
 
-                const float* a = A + k;
+    TransA - Supplies the transpose operation for matrix A.
 
-                //
-                // Step through the rows of matrix A.
-                //
+    M - Supplies the number of rows of matrix A and matrix C.
 
-                do {
+    RangeStartN - Supplies the starting column from packed matrix B.
 
-#if defined(MLAS_TARGET_AMD64_IX86)
-                    RowsHandled = MlasPlatform.GemmFloatKernel(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha, ZeroMode);
-#else
-                    if (ZeroMode) {
-                        RowsHandled = MlasSgemmKernelZero(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
-                    } else {
-                        RowsHandled = MlasSgemmKernelAdd(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
-                    }
-#endif
+    RangeCountN - Supplies the number of columns from packed matrix B and
+        matrix C.
 
-                    c += ldc * RowsHandled;
-                    a += lda * RowsHandled;
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
 
-                    RowsRemaining -= RowsHandled;
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
 
-                } while (RowsRemaining > 0);
+    A - Supplies the address of matrix A.
 
-            } else {
+    lda - Supplies the first dimension of matrix A.
 
-                const float* a = A + k * lda;
+    PackedB - Supplies the address of packed matrix B.
 
-                do {
+    AlignedN - Supplies the total number of aligned columns for packed matrix
+        B.
 
-                    //
-                    // Transpose elements from matrix A into a local buffer.
-                    //
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
 
-                    size_t RowsTransposed = RowsRemaining;
+    C - Supplies the address of matrix C.
 
-                    if (RowsTransposed > MLAS_SGEMM_TRANSA_ROWS) {
-                        RowsTransposed = MLAS_SGEMM_TRANSA_ROWS;
-                    }
+    ldc - Supplies the first dimension of matrix C.
 
-                    RowsRemaining -= RowsTransposed;
+Return Value:
 
-                    MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
+    None.
 
-                    a += RowsTransposed;
+--*/
+{
+    //
+    // Step through each slice of matrix B along the N dimension.
+    //
 
-                    //
-                    // Step through the rows of the local buffer.
-                    //
+    size_t CountN;
+    size_t CountK;
 
-                    const float* pa = PanelA;
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
 
-                    do {
+        const size_t SliceStartN = RangeStartN + n;
 
-#if defined(MLAS_TARGET_AMD64_IX86)
-                        RowsHandled = MlasPlatform.GemmFloatKernel(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
-#else
-                        if (ZeroMode) {
-                            RowsHandled = MlasSgemmKernelZero(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
-                        } else {
-                            RowsHandled = MlasSgemmKernelAdd(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
-                        }
-#endif
+        CountN = RangeCountN - n;
 
-                        c += ldc * RowsHandled;
-                        pa += CountK * RowsHandled;
+        if (CountN > MLAS_SGEMM_PACKED_STRIDEN) {
+            CountN = MLAS_SGEMM_PACKED_STRIDEN;
+        }
 
-                        RowsTransposed -= RowsHandled;
+        //
+        // Multiply the output matrix by beta as needed.
+        //
 
-                    } while (RowsTransposed > 0);
+        if (beta != 0.0f && beta != 1.0f) {
+            MlasSgemmMultiplyBeta(C + n, M, CountN, ldc, beta);
+        }
 
-                } while (RowsRemaining > 0);
+        //
+        // Step through each slice of matrix B along the K dimension.
+        //
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            bool ZeroMode = (k == 0 && beta == 0.0f);
+
+            CountK = K - k;
+
+            if (CountK > MLAS_SGEMM_PACKED_STRIDEK) {
+                CountK = MLAS_SGEMM_PACKED_STRIDEK;
             }
+
+            //
+            // The packed buffer stores each slice of the K dimension as a
+            // sequence of panels that are 16 columns wide, so the panel for
+            // this slice of the N dimension can be referenced directly.
+            //
+
+            const float* PanelB = (const float*)PackedB + AlignedN * k + CountK * SliceStartN;
+
+            const float* a = (TransA == CblasNoTrans) ? A + k : A + k * lda;
+
+            MlasSgemmKernelLoop(TransA, M, CountN, CountK, alpha, a, lda, PanelB,
+                C + n, ldc, ZeroMode);
         }
     }
 }
@@ -1068,10 +1268,20 @@ Return Value:
 
     MLAS_SGEMM_WORK_BLOCK::SEGMENT* Segment = &WorkBlock->Segments[Index];
 
-    MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, Segment->M,
-        Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
-        Segment->B, WorkBlock->ldb, WorkBlock->beta, Segment->C,
-        WorkBlock->ldc);
+    if (WorkBlock->PackedB != nullptr) {
+
+        MlasSgemmPackedOperation(WorkBlock->TransA, Segment->M,
+            Segment->StartN, Segment->N, WorkBlock->K, WorkBlock->alpha,
+            Segment->A, WorkBlock->lda, WorkBlock->PackedB, WorkBlock->AlignedN,
+            WorkBlock->beta, Segment->C, WorkBlock->ldc);
+
+    } else {
+
+        MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, Segment->M,
+            Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
+            Segment->B, WorkBlock->ldb, WorkBlock->beta, Segment->C,
+            WorkBlock->ldc);
+    }
 }
 
 inline
@@ -1087,6 +1297,7 @@ MlasSgemmTryMultithread(
     size_t lda,
     const float* B,
     size_t ldb,
+    const void* PackedB,
     float beta,
     float* C,
     size_t ldc,
@@ -1122,6 +1333,9 @@ Arguments:
 
     ldb - Supplies the first dimension of matrix B.
 
+    PackedB - Supplies the address of matrix B packed by MlasGemmPackB, else
+        nullptr if matrix B is supplied using B and ldb.
+
     beta - Supplies the scalar beta multiplier (see SGEMM definition).
 
     C - Supplies the address of matrix C.
@@ -1176,6 +1390,8 @@ Return Value:
     WorkBlock.ldc = ldc;
     WorkBlock.alpha = alpha;
     WorkBlock.beta = beta;
+    WorkBlock.PackedB = PackedB;
+    WorkBlock.AlignedN = MlasSgemmAlignPackedN(N);
 
     //
     // Segment the operation across multiple threads.
@@ -1194,6 +1410,11 @@ Return Value:
         StrideN =
             (StrideN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
 
+        //
+        // Matrix B is only referenced through the column offset of each
+        // segment when it has been packed.
+        //
+
         size_t pldb = (TransB == CblasNoTrans) ? 1 : ldb;
 
         for (size_t CountN, n = 0; n < N; n += CountN) {
@@ -1206,8 +1427,9 @@ Return Value:
 
             WorkBlock.Segments[Index].M = M;
             WorkBlock.Segments[Index].N = CountN;
+            WorkBlock.Segments[Index].StartN = n;
             WorkBlock.Segments[Index].A = A;
-            WorkBlock.Segments[Index].B = B + n * pldb;
+            WorkBlock.Segments[Index].B = (PackedB == nullptr) ? B + n * pldb : nullptr;
             WorkBlock.Segments[Index].C = C + n;
 
             Index++;
@@ -1233,6 +1455,7 @@ Return Value:
 
             WorkBlock.Segments[Index].M = CountM;
             WorkBlock.Segments[Index].N = N;
+            WorkBlock.Segments[Index].StartN = 0;
             WorkBlock.Segments[Index].A = A + m * plda;
             WorkBlock.Segments[Index].B = B;
             WorkBlock.Segments[Index].C = C + m * ldc;
@@ -1314,7 +1537,179 @@ Return Value:
     // single thread based on the GEMM parameters and system configuration.
     //
 
-    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, ThreadPool)) {
+    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, nullptr, beta, C, ldc, ThreadPool)) {
         MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
     }
 }
+
+size_t
+MLASCALL
+MlasGemmPackBSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of bytes required to pack matrix B for
+    use with the packed single precision matrix/matrix multiply operation.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the number of bytes required to pack matrix B.
+
+--*/
+{
+    //
+    // Compute the number of bytes required to hold the packed buffer. Pad the
+    // buffer to the preferred alignment so that callers can allocate several
+    // packed buffers from a single allocation.
+    //
+
+    const size_t AlignedN = MlasSgemmAlignPackedN(N);
+    const size_t BytesRequired = AlignedN * K * sizeof(float);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+
+    return (BytesRequired + BufferAlignment - 1) & ~(BufferAlignment - 1);
+}
+
+void
+MLASCALL
+MlasGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the contents of matrix B to the destination buffer. The
+    destination buffer should be sized based on MlasGemmPackBSize() and
+    aligned to MlasGetPreferredBufferAlignment().
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedN = MlasSgemmAlignPackedN(N);
+
+    //
+    // Step through each slice of matrix B along the K dimension. Each slice
+    // is packed using the same layout that MlasSgemmOperation builds in its
+    // local panel buffer, but covering all columns of matrix B.
+    //
+
+    float* D = (float*)PackedB;
+    size_t CountK;
+
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = K - k;
+
+        if (CountK > MLAS_SGEMM_PACKED_STRIDEK) {
+            CountK = MLAS_SGEMM_PACKED_STRIDEK;
+        }
+
+        if (TransB == CblasNoTrans) {
+            MlasSgemmCopyPackB(D, B + k * ldb, ldb, N, CountK);
+        } else {
+            MlasSgemmTransposePackB(D, B + k, ldb, N, CountK);
+        }
+
+        D += AlignedN * CountK;
+    }
+}
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) using a matrix B that has been packed by MlasGemmPackB.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of packed matrix B.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Try to run the operation across multiple threads or fall back to a
+    // single thread based on the GEMM parameters and system configuration.
+    //
+
+    if (!MlasSgemmTryMultithread(TransA, CblasNoTrans, M, N, K, alpha, A, lda, nullptr, 0, PackedB, beta, C, ldc, ThreadPool)) {
+        MlasSgemmPackedOperation(TransA, M, 0, N, K, alpha, A, lda, PackedB, MlasSgemmAlignPackedN(N), beta, C, ldc);
+    }
+}
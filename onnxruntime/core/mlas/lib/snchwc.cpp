@@ -1415,6 +1415,241 @@ Return Value:
     MlasExecuteThreaded(MlasNchwcThreaded<MLAS_NCHWC_POOL_ALGORITHM>, &WorkBlock, WorkBlock.tids, ThreadPool);
 }
 
+void
+MLASCALL
+MlasNchwcUpsampleNearest(
+    const int64_t* InputShape,
+    const int64_t* Scales,
+    const float* Input,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the NCHWc nearest neighbor upsample operation for
+    integer scale factors, where each input element is replicated into a
+    block of ScaleHeight by ScaleWidth output elements.
+
+Arguments:
+
+    InputShape - Supplies the shape of the input tensor. The product of the
+        batch and channel dimensions must be a multiple of the block size.
+
+    Scales - Supplies the integer scale factors for the height and width
+        dimensions.
+
+    Input - Supplies the input tensor.
+
+    Output - Supplies the output tensor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockSize = MlasNchwcGetBlockSize();
+
+    const size_t TotalChannels = size_t(InputShape[0]) * size_t(InputShape[1]);
+    const size_t InputHeight = size_t(InputShape[2]);
+    const size_t InputWidth = size_t(InputShape[3]);
+    const size_t ScaleHeight = size_t(Scales[0]);
+    const size_t ScaleWidth = size_t(Scales[1]);
+
+    const size_t OutputRowSize = InputWidth * ScaleWidth * BlockSize;
+
+    for (size_t c = 0; c < TotalChannels; c += BlockSize) {
+
+        for (size_t h = 0; h < InputHeight; h++) {
+
+            float* OutputRow = Output;
+
+            //
+            // Replicate each input block across the scaled width of the row.
+            //
+
+            for (size_t w = 0; w < InputWidth; w++) {
+
+                for (size_t sw = 0; sw < ScaleWidth; sw++) {
+
+                    for (size_t bc = 0; bc < BlockSize; bc += 4) {
+                        MlasStoreFloat32x4(&Output[bc], MlasLoadFloat32x4(&Input[bc]));
+                    }
+
+                    Output += BlockSize;
+                }
+
+                Input += BlockSize;
+            }
+
+            //
+            // Replicate the output row across the scaled height.
+            //
+
+            for (size_t sh = 1; sh < ScaleHeight; sh++) {
+                std::copy_n(OutputRow, OutputRowSize, Output);
+                Output += OutputRowSize;
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasNchwcUpsampleLinear(
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t OutputWidth,
+    float InterpolationHeight,
+    const float* InterpolationWidth,
+    const float* Input,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the NCHWc bilinear upsample operation for a single
+    output row of a single channel block.
+
+Arguments:
+
+    InputHeight - Supplies the input height.
+
+    InputWidth - Supplies the input width.
+
+    OutputWidth - Supplies the output width.
+
+    InterpolationHeight - Supplies the input coordinate along the height
+        dimension that maps to this output row.
+
+    InterpolationWidth - Supplies the input coordinates along the width
+        dimension that map to each output column.
+
+    Input - Supplies the input channel block.
+
+    Output - Supplies the output row of the channel block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockSize = MlasNchwcGetBlockSize();
+
+    //
+    // Compute the source rows and weights along the height dimension. The
+    // coordinate is clamped to the bounds of the input to match the reference
+    // implementation.
+    //
+
+    InterpolationHeight = (std::max)(0.0f, (std::min)(InterpolationHeight, float(InputHeight - 1)));
+
+    const size_t y1 = (std::min)(size_t(InterpolationHeight), InputHeight - 1);
+    const size_t y2 = (std::min)(y1 + 1, InputHeight - 1);
+
+    float dy1 = InterpolationHeight - float(y1);
+    float dy2 = float(y2) - InterpolationHeight;
+
+    if (y1 == y2) {
+        dy1 = 0.5f;
+        dy2 = 0.5f;
+    }
+
+    const float* InputRow1 = Input + y1 * InputWidth * BlockSize;
+    const float* InputRow2 = Input + y2 * InputWidth * BlockSize;
+
+    for (size_t ow = 0; ow < OutputWidth; ow++) {
+
+        float InterpolationWidthValue =
+            (std::max)(0.0f, (std::min)(InterpolationWidth[ow], float(InputWidth - 1)));
+
+        const size_t x1 = (std::min)(size_t(InterpolationWidthValue), InputWidth - 1);
+        const size_t x2 = (std::min)(x1 + 1, InputWidth - 1);
+
+        float dx1 = InterpolationWidthValue - float(x1);
+        float dx2 = float(x2) - InterpolationWidthValue;
+
+        if (x1 == x2) {
+            dx1 = 0.5f;
+            dx2 = 0.5f;
+        }
+
+        MLAS_FLOAT32X4 Weight11 = MlasBroadcastFloat32x4(dx2 * dy2);
+        MLAS_FLOAT32X4 Weight21 = MlasBroadcastFloat32x4(dx1 * dy2);
+        MLAS_FLOAT32X4 Weight12 = MlasBroadcastFloat32x4(dx2 * dy1);
+        MLAS_FLOAT32X4 Weight22 = MlasBroadcastFloat32x4(dx1 * dy1);
+
+        const float* Input11 = InputRow1 + x1 * BlockSize;
+        const float* Input21 = InputRow1 + x2 * BlockSize;
+        const float* Input12 = InputRow2 + x1 * BlockSize;
+        const float* Input22 = InputRow2 + x2 * BlockSize;
+
+        for (size_t bc = 0; bc < BlockSize; bc += 4) {
+
+            MLAS_FLOAT32X4 Accumulator = MlasMultiplyFloat32x4(Weight11, MlasLoadFloat32x4(&Input11[bc]));
+            Accumulator = MlasAddFloat32x4(Accumulator, MlasMultiplyFloat32x4(Weight21, MlasLoadFloat32x4(&Input21[bc])));
+            Accumulator = MlasAddFloat32x4(Accumulator, MlasMultiplyFloat32x4(Weight12, MlasLoadFloat32x4(&Input12[bc])));
+            Accumulator = MlasAddFloat32x4(Accumulator, MlasMultiplyFloat32x4(Weight22, MlasLoadFloat32x4(&Input22[bc])));
+
+            MlasStoreFloat32x4(&Output[bc], Accumulator);
+        }
+
+        Output += BlockSize;
+    }
+}
+
+void
+MLASCALL
+MlasNchwcScaleChannels(
+    size_t SpatialSize,
+    const float* Input,
+    const float* Scale,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies each element of a NCHWc channel block by the scale
+    for its channel. This implements the channel-wise multiply used by
+    squeeze-and-excitation blocks.
+
+Arguments:
+
+    SpatialSize - Supplies the number of spatial elements in the channel block.
+
+    Input - Supplies the input channel block.
+
+    Scale - Supplies the block of channel scale factors.
+
+    Output - Supplies the output channel block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockSize = MlasNchwcGetBlockSize();
+
+    for (size_t bc = 0; bc < BlockSize; bc += 4) {
+
+        MLAS_FLOAT32X4 ScaleVector = MlasLoadFloat32x4(&Scale[bc]);
+
+        const float* input = Input + bc;
+        float* output = Output + bc;
+
+        for (size_t i = 0; i < SpatialSize; i++) {
+            MlasStoreFloat32x4(output, MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(input)));
+            input += BlockSize;
+            output += BlockSize;
+        }
+    }
+}
+
 #if !defined(MLAS_TARGET_AMD64)
 
 //
@@ -0,0 +1,653 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    softmax.cpp
+
+Abstract:
+
+    This module implements routines to compute the softmax and log softmax
+    functions over the rows of a matrix.
+
+    The exponential function uses a range reduction to [-ln(2)/2, ln(2)/2]
+    followed by a polynomial approximation, using the same coefficients as
+    the exponential computed by the error function kernels. The implementation
+    below targets the base instruction set (typically SSE2) while assembly
+    implementations target newer instruction sets (such as FMA3 and AVX512F).
+
+--*/
+
+#include "mlasi.h"
+#include <cmath>
+
+//
+// Bundles the floating point constants for use by kernels written in assembly.
+//
+
+MLAS_INTERNAL_DATA const struct {
+    float LowerRange;
+    float RoundingBias;
+    float Log2Reciprocal;
+    float Log2High;
+    float Log2Low;
+    float poly_0;
+    float poly_1;
+    float poly_2;
+    float poly_3;
+    float poly_4;
+    float poly_56;
+} MlasExpConstants = {
+    // The smallest input where 2^round(x/ln(2)) is still a normal value.
+    -87.3365448f,
+    // 1.5 * 2^23 + 127: adding this to a value rounds it to an integer stored
+    // in the low bits of the mantissa, already biased so that shifting the bits
+    // left by 23 gives 2^round(x).
+    12583039.0f,
+    1.44269504088896341f,
+    -6.93145752e-1f,
+    -1.42860677e-6f,
+    1.38319808e-3f,
+    8.37550033e-3f,
+    4.16689515e-2f,
+    1.66664466e-1f,
+    4.99999851e-1f,
+    1.00000000e+0f,
+};
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasComputeExpVector(
+    MLAS_FLOAT32X4 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for a vector of elements.
+    Elements below the lower range are clamped to the lower range.
+
+Arguments:
+
+    Vector - Supplies the values to operate on.
+
+Return Value:
+
+    Returns the exponential of each element.
+
+--*/
+{
+    Vector = MlasMaximumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.LowerRange), Vector);
+
+    //
+    // Range reduce the input to exp(x) = 2^m * exp(f) with f in [-ln(2)/2, ln(2)/2].
+    //
+
+    const MLAS_FLOAT32X4 RoundingBias = MlasBroadcastFloat32x4(MlasExpConstants.RoundingBias);
+
+    MLAS_FLOAT32X4 m = MlasMultiplyAddFloat32x4(Vector, MlasBroadcastFloat32x4(MlasExpConstants.Log2Reciprocal), RoundingBias);
+    m = MlasSubtractFloat32x4(m, RoundingBias);
+
+    MLAS_FLOAT32X4 f = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.Log2High), Vector);
+    f = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.Log2Low), f);
+
+    MLAS_FLOAT32X4 p = MlasBroadcastFloat32x4(MlasExpConstants.poly_0);
+    p = MlasMultiplyAddFloat32x4(p, f, MlasBroadcastFloat32x4(MlasExpConstants.poly_1));
+    p = MlasMultiplyAddFloat32x4(p, f, MlasBroadcastFloat32x4(MlasExpConstants.poly_2));
+    p = MlasMultiplyAddFloat32x4(p, f, MlasBroadcastFloat32x4(MlasExpConstants.poly_3));
+    p = MlasMultiplyAddFloat32x4(p, f, MlasBroadcastFloat32x4(MlasExpConstants.poly_4));
+    p = MlasMultiplyAddFloat32x4(p, f, MlasBroadcastFloat32x4(MlasExpConstants.poly_56));
+    p = MlasMultiplyAddFloat32x4(p, f, MlasBroadcastFloat32x4(MlasExpConstants.poly_56));
+
+    return MlasMultiplyFloat32x4(p, MlasPowerOf2Float32x4(m));
+}
+
+MLAS_FORCEINLINE
+float
+MlasComputeExpScalar(
+    float Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for a single element using
+    the same approximation as the vectorized form.
+
+Arguments:
+
+    Value - Supplies the value to operate on.
+
+Return Value:
+
+    Returns the exponential of the value.
+
+--*/
+{
+    Value = (std::max)(MlasExpConstants.LowerRange, Value);
+
+    float m = Value * MlasExpConstants.Log2Reciprocal + MlasExpConstants.RoundingBias;
+    m -= MlasExpConstants.RoundingBias;
+
+    float f = m * MlasExpConstants.Log2High + Value;
+    f = m * MlasExpConstants.Log2Low + f;
+
+    float p = MlasExpConstants.poly_0;
+    p = p * f + MlasExpConstants.poly_1;
+    p = p * f + MlasExpConstants.poly_2;
+    p = p * f + MlasExpConstants.poly_3;
+    p = p * f + MlasExpConstants.poly_4;
+    p = p * f + MlasExpConstants.poly_56;
+    p = p * f + MlasExpConstants.poly_56;
+
+    return std::ldexp(p, int(m));
+}
+
+float
+MLASCALL
+MlasReduceMaximumF32Kernel(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to find the maximum value of
+    the supplied buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the maximum value of the supplied buffer.
+
+--*/
+{
+    float Maximum = std::numeric_limits<float>::lowest();
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 MaximumVector0 = MlasBroadcastFloat32x4(Maximum);
+
+        if (N >= 16) {
+
+            MLAS_FLOAT32X4 MaximumVector1 = MaximumVector0;
+            MLAS_FLOAT32X4 MaximumVector2 = MaximumVector0;
+            MLAS_FLOAT32X4 MaximumVector3 = MaximumVector0;
+
+            while (N >= 16) {
+
+                MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MlasLoadFloat32x4(Input));
+                MaximumVector1 = MlasMaximumFloat32x4(MaximumVector1, MlasLoadFloat32x4(Input + 4));
+                MaximumVector2 = MlasMaximumFloat32x4(MaximumVector2, MlasLoadFloat32x4(Input + 8));
+                MaximumVector3 = MlasMaximumFloat32x4(MaximumVector3, MlasLoadFloat32x4(Input + 12));
+
+                Input += 16;
+                N -= 16;
+            }
+
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MaximumVector1);
+            MaximumVector2 = MlasMaximumFloat32x4(MaximumVector2, MaximumVector3);
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MaximumVector2);
+        }
+
+        while (N >= 4) {
+
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MlasLoadFloat32x4(Input));
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Maximum = MlasReduceMaximumFloat32x4(MaximumVector0);
+    }
+
+    while (N > 0) {
+
+        Maximum = (std::max)(Maximum, *Input);
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Maximum;
+}
+
+float
+MLASCALL
+MlasComputeSumExpF32Kernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    const float* NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to compute the exponential of
+    each element offset by the negative maximum and to sum the results.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Optionally supplies the output buffer. When supplied, the
+        exponential of each element is stored here.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the negative of the maximum value of the input
+        buffer, which is added to each element before computing the
+        exponential.
+
+Return Value:
+
+    Returns the sum of the exponentials.
+
+--*/
+{
+    MLAS_FLOAT32X4 NegativeMaximumVector = MlasBroadcastFloat32x4(*NegativeMaximum);
+    float Accumulator = 0.0f;
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 AccumulatorVector = MlasZeroFloat32x4();
+
+        while (N >= 4) {
+
+            MLAS_FLOAT32X4 Vector = MlasAddFloat32x4(MlasLoadFloat32x4(Input), NegativeMaximumVector);
+
+            Vector = MlasComputeExpVector(Vector);
+
+            if (Output != nullptr) {
+                MlasStoreFloat32x4(Output, Vector);
+                Output += 4;
+            }
+
+            AccumulatorVector = MlasAddFloat32x4(AccumulatorVector, Vector);
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Accumulator = MlasReduceAddFloat32x4(AccumulatorVector);
+    }
+
+    while (N > 0) {
+
+        float Value = MlasComputeExpScalar(*Input + *NegativeMaximum);
+
+        if (Output != nullptr) {
+            *Output++ = Value;
+        }
+
+        Accumulator += Value;
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Accumulator;
+}
+
+void
+MLASCALL
+MlasComputeSoftmaxOutputF32Kernel(
+    float* Output,
+    size_t N,
+    const float* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to produce the final output for
+    the softmax operation by scaling the exponentials by the reciprocal of
+    their sum.
+
+Arguments:
+
+    Output - Supplies the output buffer, which contains the exponentials of the
+        input on entry.
+
+    N - Supplies the number of elements to process.
+
+    Parameters - Supplies an array containing the scale value.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float Scale = Parameters[0];
+    const MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+
+    while (N >= 16) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output));
+        MLAS_FLOAT32X4 Vector1 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output + 4));
+        MLAS_FLOAT32X4 Vector2 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output + 8));
+        MLAS_FLOAT32X4 Vector3 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output + 12));
+
+        MlasStoreFloat32x4(Output, Vector0);
+        MlasStoreFloat32x4(Output + 4, Vector1);
+        MlasStoreFloat32x4(Output + 8, Vector2);
+        MlasStoreFloat32x4(Output + 12, Vector3);
+
+        Output += 16;
+        N -= 16;
+    }
+
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output)));
+
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output *= Scale;
+
+        Output += 1;
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeLogSoftmaxOutputF32Kernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    const float* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to produce the final output for
+    the log softmax operation by offsetting each element by the negative
+    maximum and the negative logarithm of the sum of the exponentials.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Parameters - Supplies an array containing the negative maximum and the
+        negative logarithm of the sum of the exponentials.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float NegativeMaximum = Parameters[0];
+    const float Logarithm = Parameters[1];
+    const MLAS_FLOAT32X4 NegativeMaximumVector = MlasBroadcastFloat32x4(NegativeMaximum);
+    const MLAS_FLOAT32X4 LogarithmVector = MlasBroadcastFloat32x4(Logarithm);
+
+    while (N >= 16) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasLoadFloat32x4(Input);
+        MLAS_FLOAT32X4 Vector1 = MlasLoadFloat32x4(Input + 4);
+        MLAS_FLOAT32X4 Vector2 = MlasLoadFloat32x4(Input + 8);
+        MLAS_FLOAT32X4 Vector3 = MlasLoadFloat32x4(Input + 12);
+
+        Vector0 = MlasAddFloat32x4(Vector0, NegativeMaximumVector);
+        Vector1 = MlasAddFloat32x4(Vector1, NegativeMaximumVector);
+        Vector2 = MlasAddFloat32x4(Vector2, NegativeMaximumVector);
+        Vector3 = MlasAddFloat32x4(Vector3, NegativeMaximumVector);
+
+        Vector0 = MlasAddFloat32x4(Vector0, LogarithmVector);
+        Vector1 = MlasAddFloat32x4(Vector1, LogarithmVector);
+        Vector2 = MlasAddFloat32x4(Vector2, LogarithmVector);
+        Vector3 = MlasAddFloat32x4(Vector3, LogarithmVector);
+
+        MlasStoreFloat32x4(Output, Vector0);
+        MlasStoreFloat32x4(Output + 4, Vector1);
+        MlasStoreFloat32x4(Output + 8, Vector2);
+        MlasStoreFloat32x4(Output + 12, Vector3);
+
+        Input += 16;
+        Output += 16;
+        N -= 16;
+    }
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input);
+        Vector = MlasAddFloat32x4(Vector, NegativeMaximumVector);
+        Vector = MlasAddFloat32x4(Vector, LogarithmVector);
+        MlasStoreFloat32x4(Output, Vector);
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output = *Input + NegativeMaximum + Logarithm;
+
+        Input += 1;
+        Output += 1;
+        N -= 1;
+    }
+}
+
+//
+// Define the parameters to execute segments of a softmax operation on worker
+// threads.
+//
+
+struct MLAS_SOFTMAX_WORK_BLOCK {
+    int32_t ThreadCountN;
+    bool LogSoftmax;
+    const float* Input;
+    float* Output;
+    size_t N;
+    size_t D;
+};
+
+void
+MlasComputeSoftmaxThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    softmax or log softmax operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_SOFTMAX_WORK_BLOCK*)Context;
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t n;
+    size_t CountN;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+    //
+    // Compute the softmax or log softmax function.
+    //
+
+    const size_t D = WorkBlock->D;
+    const bool LogSoftmax = WorkBlock->LogSoftmax;
+
+    const float* Input = WorkBlock->Input + n * D;
+    float* Output = WorkBlock->Output + n * D;
+
+#if defined(MLAS_TARGET_AMD64)
+    PMLAS_REDUCE_MAXIMUM_FLOAT_KERNEL ReduceMaximumF32Kernel = MlasPlatform.ReduceMaximumF32Kernel;
+    PMLAS_COMPUTE_SUMEXP_FLOAT_KERNEL ComputeSumExpF32Kernel = MlasPlatform.ComputeSumExpF32Kernel;
+#else
+    PMLAS_REDUCE_MAXIMUM_FLOAT_KERNEL ReduceMaximumF32Kernel = MlasReduceMaximumF32Kernel;
+    PMLAS_COMPUTE_SUMEXP_FLOAT_KERNEL ComputeSumExpF32Kernel = MlasComputeSumExpF32Kernel;
+#endif
+
+    while (CountN > 0) {
+
+        //
+        // Find the maximum value for the row so that the exponentials cannot
+        // overflow.
+        //
+
+        const float Maximum = ReduceMaximumF32Kernel(Input, D);
+        const float NegativeMaximum = -Maximum;
+
+        if (LogSoftmax) {
+
+            //
+            // Compute the sum of the exponential functions for the row.
+            //
+
+            const float Accumulation = ComputeSumExpF32Kernel(Input, nullptr, D, &NegativeMaximum);
+
+            //
+            // Compute the log softmax output.
+            //
+
+            float Parameters[] = { NegativeMaximum, -std::log(Accumulation) };
+
+            MlasComputeLogSoftmaxOutputF32Kernel(Input, Output, D, Parameters);
+
+        } else {
+
+            //
+            // Compute the exponential function for each element of the row and
+            // compute the sum of these exponential functions.
+            //
+
+            const float Accumulation = ComputeSumExpF32Kernel(Input, Output, D, &NegativeMaximum);
+
+            //
+            // Normalize the softmax output.
+            //
+
+            float Parameters[] = { 1.0f / Accumulation };
+
+            MlasComputeSoftmaxOutputF32Kernel(Output, D, Parameters);
+        }
+
+        Input += D;
+        Output += D;
+        CountN--;
+    }
+}
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function over each row of
+    the input matrix.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns per row to process.
+
+    LogSoftmax - Supplies true if this is a log softmax operation, else false
+        if this is a softmax operation.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SOFTMAX_WORK_BLOCK WorkBlock;
+
+    if (N == 0) {
+        return;
+    }
+
+    //
+    // Capture the softmax parameters to the work block.
+    //
+
+    WorkBlock.LogSoftmax = LogSoftmax;
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+
+    //
+    // Compute the number of target threads given the complexity of the softmax
+    // operation. Limit the number of threads to the number of rows and try to
+    // keep each thread processing a minimum number of elements before using
+    // another thread.
+    //
+
+    int32_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountN) > N) {
+        ThreadCountN = int32_t(N);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((N * D) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCountN) > BlockCount) {
+        ThreadCountN = int32_t(BlockCount);
+    }
+
+    WorkBlock.ThreadCountN = ThreadCountN;
+
+    MlasExecuteThreaded(MlasComputeSoftmaxThreaded, &WorkBlock, ThreadCountN, ThreadPool);
+}
@@ -0,0 +1,499 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transpose.cpp
+
+Abstract:
+
+    This module implements routines to transpose matrices.
+
+    The matrix is processed in tiles that fit in the L1 cache. Each tile is
+    then processed by a kernel that transposes a square block of elements in
+    registers.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the maximum number of elements along each side of a cache tile and
+// the maximum number of bytes for each row of a cache tile.
+//
+
+#define MLAS_TRANSPOSE_TILE_ELEMENTS 64
+#define MLAS_TRANSPOSE_TILE_ROW_BYTES 256
+
+//
+// Define the kernels to transpose a square block of elements. The block size
+// is chosen so that each row of the block fills a vector register where the
+// target supports it.
+//
+
+template<typename ElementType>
+struct MLAS_TRANSPOSE_BLOCK_KERNEL;
+
+template<>
+struct MLAS_TRANSPOSE_BLOCK_KERNEL<uint8_t>
+{
+    static constexpr size_t BlockSize = 8;
+
+    MLAS_FORCEINLINE
+    static
+    void
+    Transpose(
+        const uint8_t* Input,
+        size_t ldInput,
+        uint8_t* Output,
+        size_t ldOutput
+        )
+    {
+#if defined(MLAS_SSE2_INTRINSICS)
+        __m128i a0 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 0]);
+        __m128i a1 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 1]);
+        __m128i a2 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 2]);
+        __m128i a3 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 3]);
+        __m128i a4 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 4]);
+        __m128i a5 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 5]);
+        __m128i a6 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 6]);
+        __m128i a7 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 7]);
+
+        __m128i b0 = _mm_unpacklo_epi8(a0, a1);
+        __m128i b1 = _mm_unpacklo_epi8(a2, a3);
+        __m128i b2 = _mm_unpacklo_epi8(a4, a5);
+        __m128i b3 = _mm_unpacklo_epi8(a6, a7);
+
+        __m128i c0 = _mm_unpacklo_epi16(b0, b1);
+        __m128i c1 = _mm_unpackhi_epi16(b0, b1);
+        __m128i c2 = _mm_unpacklo_epi16(b2, b3);
+        __m128i c3 = _mm_unpackhi_epi16(b2, b3);
+
+        __m128i d0 = _mm_unpacklo_epi32(c0, c2);
+        __m128i d1 = _mm_unpackhi_epi32(c0, c2);
+        __m128i d2 = _mm_unpacklo_epi32(c1, c3);
+        __m128i d3 = _mm_unpackhi_epi32(c1, c3);
+
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 0], d0);
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 1], _mm_unpackhi_epi64(d0, d0));
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 2], d1);
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 3], _mm_unpackhi_epi64(d1, d1));
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 4], d2);
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 5], _mm_unpackhi_epi64(d2, d2));
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 6], d3);
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 7], _mm_unpackhi_epi64(d3, d3));
+#elif defined(MLAS_NEON_INTRINSICS)
+        uint8x8_t a0 = vld1_u8(&Input[ldInput * 0]);
+        uint8x8_t a1 = vld1_u8(&Input[ldInput * 1]);
+        uint8x8_t a2 = vld1_u8(&Input[ldInput * 2]);
+        uint8x8_t a3 = vld1_u8(&Input[ldInput * 3]);
+        uint8x8_t a4 = vld1_u8(&Input[ldInput * 4]);
+        uint8x8_t a5 = vld1_u8(&Input[ldInput * 5]);
+        uint8x8_t a6 = vld1_u8(&Input[ldInput * 6]);
+        uint8x8_t a7 = vld1_u8(&Input[ldInput * 7]);
+
+        uint8x8x2_t b0 = vtrn_u8(a0, a1);
+        uint8x8x2_t b1 = vtrn_u8(a2, a3);
+        uint8x8x2_t b2 = vtrn_u8(a4, a5);
+        uint8x8x2_t b3 = vtrn_u8(a6, a7);
+
+        uint16x4x2_t c0 = vtrn_u16(vreinterpret_u16_u8(b0.val[0]), vreinterpret_u16_u8(b1.val[0]));
+        uint16x4x2_t c1 = vtrn_u16(vreinterpret_u16_u8(b0.val[1]), vreinterpret_u16_u8(b1.val[1]));
+        uint16x4x2_t c2 = vtrn_u16(vreinterpret_u16_u8(b2.val[0]), vreinterpret_u16_u8(b3.val[0]));
+        uint16x4x2_t c3 = vtrn_u16(vreinterpret_u16_u8(b2.val[1]), vreinterpret_u16_u8(b3.val[1]));
+
+        uint32x2x2_t d0 = vtrn_u32(vreinterpret_u32_u16(c0.val[0]), vreinterpret_u32_u16(c2.val[0]));
+        uint32x2x2_t d1 = vtrn_u32(vreinterpret_u32_u16(c1.val[0]), vreinterpret_u32_u16(c3.val[0]));
+        uint32x2x2_t d2 = vtrn_u32(vreinterpret_u32_u16(c0.val[1]), vreinterpret_u32_u16(c2.val[1]));
+        uint32x2x2_t d3 = vtrn_u32(vreinterpret_u32_u16(c1.val[1]), vreinterpret_u32_u16(c3.val[1]));
+
+        vst1_u8(&Output[ldOutput * 0], vreinterpret_u8_u32(d0.val[0]));
+        vst1_u8(&Output[ldOutput * 1], vreinterpret_u8_u32(d1.val[0]));
+        vst1_u8(&Output[ldOutput * 2], vreinterpret_u8_u32(d2.val[0]));
+        vst1_u8(&Output[ldOutput * 3], vreinterpret_u8_u32(d3.val[0]));
+        vst1_u8(&Output[ldOutput * 4], vreinterpret_u8_u32(d0.val[1]));
+        vst1_u8(&Output[ldOutput * 5], vreinterpret_u8_u32(d1.val[1]));
+        vst1_u8(&Output[ldOutput * 6], vreinterpret_u8_u32(d2.val[1]));
+        vst1_u8(&Output[ldOutput * 7], vreinterpret_u8_u32(d3.val[1]));
+#else
+        for (size_t n = 0; n < BlockSize; n++) {
+            for (size_t m = 0; m < BlockSize; m++) {
+                Output[ldOutput * n + m] = Input[ldInput * m + n];
+            }
+        }
+#endif
+    }
+};
+
+template<>
+struct MLAS_TRANSPOSE_BLOCK_KERNEL<uint16_t>
+{
+    static constexpr size_t BlockSize = 8;
+
+    MLAS_FORCEINLINE
+    static
+    void
+    Transpose(
+        const uint16_t* Input,
+        size_t ldInput,
+        uint16_t* Output,
+        size_t ldOutput
+        )
+    {
+#if defined(MLAS_SSE2_INTRINSICS)
+        __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 0]);
+        __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 1]);
+        __m128i a2 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 2]);
+        __m128i a3 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 3]);
+        __m128i a4 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 4]);
+        __m128i a5 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 5]);
+        __m128i a6 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 6]);
+        __m128i a7 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 7]);
+
+        __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+        __m128i b1 = _mm_unpackhi_epi16(a0, a1);
+        __m128i b2 = _mm_unpacklo_epi16(a2, a3);
+        __m128i b3 = _mm_unpackhi_epi16(a2, a3);
+        __m128i b4 = _mm_unpacklo_epi16(a4, a5);
+        __m128i b5 = _mm_unpackhi_epi16(a4, a5);
+        __m128i b6 = _mm_unpacklo_epi16(a6, a7);
+        __m128i b7 = _mm_unpackhi_epi16(a6, a7);
+
+        __m128i c0 = _mm_unpacklo_epi32(b0, b2);
+        __m128i c1 = _mm_unpackhi_epi32(b0, b2);
+        __m128i c2 = _mm_unpacklo_epi32(b1, b3);
+        __m128i c3 = _mm_unpackhi_epi32(b1, b3);
+        __m128i c4 = _mm_unpacklo_epi32(b4, b6);
+        __m128i c5 = _mm_unpackhi_epi32(b4, b6);
+        __m128i c6 = _mm_unpacklo_epi32(b5, b7);
+        __m128i c7 = _mm_unpackhi_epi32(b5, b7);
+
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 0], _mm_unpacklo_epi64(c0, c4));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 1], _mm_unpackhi_epi64(c0, c4));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 2], _mm_unpacklo_epi64(c1, c5));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 3], _mm_unpackhi_epi64(c1, c5));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 4], _mm_unpacklo_epi64(c2, c6));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 5], _mm_unpackhi_epi64(c2, c6));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 6], _mm_unpacklo_epi64(c3, c7));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 7], _mm_unpackhi_epi64(c3, c7));
+#else
+        for (size_t n = 0; n < BlockSize; n++) {
+            for (size_t m = 0; m < BlockSize; m++) {
+                Output[ldOutput * n + m] = Input[ldInput * m + n];
+            }
+        }
+#endif
+    }
+};
+
+template<>
+struct MLAS_TRANSPOSE_BLOCK_KERNEL<uint32_t>
+{
+    static constexpr size_t BlockSize = 4;
+
+    MLAS_FORCEINLINE
+    static
+    void
+    Transpose(
+        const uint32_t* Input,
+        size_t ldInput,
+        uint32_t* Output,
+        size_t ldOutput
+        )
+    {
+#if defined(MLAS_SSE2_INTRINSICS)
+        __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 0]);
+        __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 1]);
+        __m128i a2 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 2]);
+        __m128i a3 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 3]);
+
+        __m128i b0 = _mm_unpacklo_epi32(a0, a1);
+        __m128i b1 = _mm_unpacklo_epi32(a2, a3);
+        __m128i b2 = _mm_unpackhi_epi32(a0, a1);
+        __m128i b3 = _mm_unpackhi_epi32(a2, a3);
+
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 0], _mm_unpacklo_epi64(b0, b1));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 1], _mm_unpackhi_epi64(b0, b1));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 2], _mm_unpacklo_epi64(b2, b3));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 3], _mm_unpackhi_epi64(b2, b3));
+#elif defined(MLAS_NEON_INTRINSICS)
+        uint32x4_t a0 = vld1q_u32(&Input[ldInput * 0]);
+        uint32x4_t a1 = vld1q_u32(&Input[ldInput * 1]);
+        uint32x4_t a2 = vld1q_u32(&Input[ldInput * 2]);
+        uint32x4_t a3 = vld1q_u32(&Input[ldInput * 3]);
+
+        uint32x4x2_t b0 = vtrnq_u32(a0, a1);
+        uint32x4x2_t b1 = vtrnq_u32(a2, a3);
+
+        vst1q_u32(&Output[ldOutput * 0], vcombine_u32(vget_low_u32(b0.val[0]), vget_low_u32(b1.val[0])));
+        vst1q_u32(&Output[ldOutput * 1], vcombine_u32(vget_low_u32(b0.val[1]), vget_low_u32(b1.val[1])));
+        vst1q_u32(&Output[ldOutput * 2], vcombine_u32(vget_high_u32(b0.val[0]), vget_high_u32(b1.val[0])));
+        vst1q_u32(&Output[ldOutput * 3], vcombine_u32(vget_high_u32(b0.val[1]), vget_high_u32(b1.val[1])));
+#else
+        for (size_t n = 0; n < BlockSize; n++) {
+            for (size_t m = 0; m < BlockSize; m++) {
+                Output[ldOutput * n + m] = Input[ldInput * m + n];
+            }
+        }
+#endif
+    }
+};
+
+template<>
+struct MLAS_TRANSPOSE_BLOCK_KERNEL<uint64_t>
+{
+    static constexpr size_t BlockSize = 2;
+
+    MLAS_FORCEINLINE
+    static
+    void
+    Transpose(
+        const uint64_t* Input,
+        size_t ldInput,
+        uint64_t* Output,
+        size_t ldOutput
+        )
+    {
+#if defined(MLAS_SSE2_INTRINSICS)
+        __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 0]);
+        __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 1]);
+
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 0], _mm_unpacklo_epi64(a0, a1));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 1], _mm_unpackhi_epi64(a0, a1));
+#else
+        uint64_t a00 = Input[ldInput * 0 + 0];
+        uint64_t a01 = Input[ldInput * 0 + 1];
+        uint64_t a10 = Input[ldInput * 1 + 0];
+        uint64_t a11 = Input[ldInput * 1 + 1];
+
+        Output[ldOutput * 0 + 0] = a00;
+        Output[ldOutput * 0 + 1] = a10;
+        Output[ldOutput * 1 + 0] = a01;
+        Output[ldOutput * 1 + 1] = a11;
+#endif
+    }
+};
+
+template<typename ElementType>
+MLAS_FORCEINLINE
+void
+MlasTransposeEdge(
+    const ElementType* Input,
+    size_t ldInput,
+    ElementType* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the partial block at the edge of a tile one
+    element at a time.
+
+Arguments:
+
+    Input - Supplies the input matrix.
+
+    ldInput - Supplies the first dimension of the input matrix.
+
+    Output - Supplies the output matrix.
+
+    ldOutput - Supplies the first dimension of the output matrix.
+
+    M - Supplies the number of rows of the input matrix.
+
+    N - Supplies the number of columns of the input matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < N; n++) {
+        for (size_t m = 0; m < M; m++) {
+            Output[ldOutput * n + m] = Input[ldInput * m + n];
+        }
+    }
+}
+
+template<typename ElementType>
+void
+MlasTransposeTile(
+    const ElementType* Input,
+    size_t ldInput,
+    ElementType* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a tile of the input matrix that fits in the L1
+    cache using the block kernel for the element type.
+
+Arguments:
+
+    Input - Supplies the input matrix.
+
+    ldInput - Supplies the first dimension of the input matrix.
+
+    Output - Supplies the output matrix.
+
+    ldOutput - Supplies the first dimension of the output matrix.
+
+    M - Supplies the number of rows of the input tile.
+
+    N - Supplies the number of columns of the input tile.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = MLAS_TRANSPOSE_BLOCK_KERNEL<ElementType>::BlockSize;
+
+    size_t m = 0;
+
+    for (; m + BlockSize <= M; m += BlockSize) {
+
+        size_t n = 0;
+
+        for (; n + BlockSize <= N; n += BlockSize) {
+            MLAS_TRANSPOSE_BLOCK_KERNEL<ElementType>::Transpose(&Input[ldInput * m + n],
+                ldInput, &Output[ldOutput * n + m], ldOutput);
+        }
+
+        if (n < N) {
+            MlasTransposeEdge(&Input[ldInput * m + n], ldInput,
+                &Output[ldOutput * n + m], ldOutput, BlockSize, N - n);
+        }
+    }
+
+    if (m < M) {
+        MlasTransposeEdge(&Input[ldInput * m], ldInput, &Output[m], ldOutput, M - m, N);
+    }
+}
+
+template<typename ElementType>
+void
+MlasTransposeImpl(
+    const ElementType* Input,
+    size_t ldInput,
+    ElementType* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the input matrix to the output matrix.
+
+Arguments:
+
+    Input - Supplies the input matrix.
+
+    ldInput - Supplies the first dimension of the input matrix.
+
+    Output - Supplies the output matrix.
+
+    ldOutput - Supplies the first dimension of the output matrix.
+
+    M - Supplies the number of rows of the input matrix.
+
+    N - Supplies the number of columns of the input matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Walk the matrix in square tiles so that the rows read from the input
+    // and the rows written to the output both stay resident in the L1 cache
+    // while the tile is processed.
+    //
+
+    constexpr size_t TileSize = (MLAS_TRANSPOSE_TILE_ROW_BYTES / sizeof(ElementType)) < MLAS_TRANSPOSE_TILE_ELEMENTS ?
+        (MLAS_TRANSPOSE_TILE_ROW_BYTES / sizeof(ElementType)) : MLAS_TRANSPOSE_TILE_ELEMENTS;
+
+    for (size_t m = 0; m < M; m += TileSize) {
+
+        const size_t CountM = std::min(M - m, TileSize);
+
+        for (size_t n = 0; n < N; n += TileSize) {
+
+            const size_t CountN = std::min(N - n, TileSize);
+
+            MlasTransposeTile(&Input[ldInput * m + n], ldInput,
+                &Output[ldOutput * n + m], ldOutput, CountM, CountN);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    size_t ldInput,
+    uint8_t* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTransposeImpl(Input, ldInput, Output, ldOutput, M, N);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    size_t ldInput,
+    uint16_t* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTransposeImpl(Input, ldInput, Output, ldOutput, M, N);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    size_t ldInput,
+    uint32_t* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTransposeImpl(Input, ldInput, Output, ldOutput, M, N);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint64_t* Input,
+    size_t ldInput,
+    uint64_t* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTransposeImpl(Input, ldInput, Output, ldOutput, M, N);
+}
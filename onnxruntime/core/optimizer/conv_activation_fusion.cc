@@ -84,7 +84,9 @@ Status ConvActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_l
 
     ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
 
-    if (!graph_utils::IsSupportedOptypeVersionAndDomain(*node, "Conv", {1, 11}) ||
+    // ConvTranspose fuses the activation in the same pass that adds the bias to each output tile
+    const bool is_conv_transpose = graph_utils::IsSupportedOptypeVersionAndDomain(*node, "ConvTranspose", {1, 11});
+    if ((!graph_utils::IsSupportedOptypeVersionAndDomain(*node, "Conv", {1, 11}) && !is_conv_transpose) ||
         !graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders()) ||
         node->GetOutputEdgesCount() != 1) {
       continue;
@@ -108,6 +110,11 @@ Status ConvActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_l
         !graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "Tanh", {6})) {
       if (graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "LeakyRelu", {6})) {
         activation_params.push_back(graph_utils::GetNodeAttribute(next_node, "alpha")->f());
+      } else if (graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "HardSigmoid", {6})) {
+        const auto* alpha_attr = graph_utils::GetNodeAttribute(next_node, "alpha");
+        const auto* beta_attr = graph_utils::GetNodeAttribute(next_node, "beta");
+        activation_params.push_back((alpha_attr != nullptr && utils::HasFloat(*alpha_attr)) ? alpha_attr->f() : 0.2f);
+        activation_params.push_back((beta_attr != nullptr && utils::HasFloat(*beta_attr)) ? beta_attr->f() : 0.5f);
       } else if (graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "Clip", {6, 11})) {
         float min, max;
         if (GetClipConstantMinMax(graph, next_node, min, max)) {
@@ -124,8 +131,10 @@ Status ConvActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_l
     Node& conv_node = *node;
     Node& act_node = *graph.GetNode(next_node.Index());
 
-    Node& fused_conv = graph.AddNode(graph.GenerateNodeName("fused " + conv_node.Name()), "FusedConv",
-                                     "fused Conv " + conv_node.Name() + "with activation " + act_node.OpType(),
+    const std::string fused_op_type = is_conv_transpose ? "FusedConvTranspose" : "FusedConv";
+    Node& fused_conv = graph.AddNode(graph.GenerateNodeName("fused " + conv_node.Name()), fused_op_type,
+                                     "fused " + conv_node.OpType() + " " + conv_node.Name() + "with activation " +
+                                         act_node.OpType(),
                                      conv_node.MutableInputDefs(),
                                      {},
                                      &conv_node.GetAttributes(),
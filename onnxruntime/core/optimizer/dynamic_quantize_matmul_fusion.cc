@@ -0,0 +1,194 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/utils.h"
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+bool IsScalarOr1ElementVector(const NodeArg& node_arg) {
+  const auto* shape = node_arg.Shape();
+  if (shape == nullptr) {
+    return false;
+  }
+  return shape->dim_size() == 0 ||
+         (shape->dim_size() == 1 && shape->dim(0).has_dim_value() && shape->dim(0).dim_value() == 1);
+}
+
+// The scale of B may be per tensor or, like the broadcast in the Mul it came from, per column of B.
+bool IsSupportedScaleOfB(const NodeArg& scale_arg, const NodeArg& b_arg) {
+  if (IsScalarOr1ElementVector(scale_arg)) {
+    return true;
+  }
+  const auto* scale_shape = scale_arg.Shape();
+  const auto* b_shape = b_arg.Shape();
+  if (scale_shape == nullptr || b_shape == nullptr || scale_shape->dim_size() != 1 || b_shape->dim_size() < 2) {
+    return false;
+  }
+  const auto& scale_dim = scale_shape->dim(0);
+  const auto& b_dim = b_shape->dim(b_shape->dim_size() - 1);
+  return scale_dim.has_dim_value() && b_dim.has_dim_value() && scale_dim.dim_value() == b_dim.dim_value();
+}
+
+// Removes a node whose outputs have all been consumed by fused nodes.
+bool RemoveNodeIfUnused(Graph& graph, Node& node) {
+  if (node.GetOutputEdgesCount() != 0 || !graph.GetNodeOutputsInGraphOutputs(node).empty()) {
+    return false;
+  }
+  return graph.RemoveNode(node.Index());
+}
+}  // namespace
+
+/**
+DynamicQuantizeMatMulFusion will fuse subgraph like below into DynamicQuantizeMatMul:
+
+            A
+            |
+  DynamicQuantizeLinear
+     |       |       \
+     |       |   A_scale    B_scale
+     |   A_zero_point  \     /
+     |       |           Mul
+     B       |            |
+      \      |            |
+      MatMulInteger       |
+           |              |
+          Cast            |
+             \           /
+                  Mul
+                   |
+                   Y
+*/
+Status DynamicQuantizeMatMulFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                              const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (!node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMulInteger", {10}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        node.GetOutputEdgesCount() != 1 ||
+        !graph.GetNodeOutputsInGraphOutputs(node).empty()) {
+      continue;
+    }
+
+    Node& matmul_integer_node = node;
+    auto& matmul_integer_input_defs = matmul_integer_node.MutableInputDefs();
+
+    // A and its zero point must come straight from DynamicQuantizeLinear.
+    const Node* p_dynamic_quantize_node = graph_utils::GetInputNode(matmul_integer_node, 0);
+    if (p_dynamic_quantize_node == nullptr ||
+        !graph_utils::IsSupportedOptypeVersionAndDomain(*p_dynamic_quantize_node, "DynamicQuantizeLinear", {11}) ||
+        p_dynamic_quantize_node->GetExecutionProviderType() != matmul_integer_node.GetExecutionProviderType() ||
+        matmul_integer_input_defs.size() < 3 ||
+        matmul_integer_input_defs[0] != p_dynamic_quantize_node->OutputDefs()[0] ||
+        matmul_integer_input_defs[2] != p_dynamic_quantize_node->OutputDefs()[2]) {
+      continue;
+    }
+
+    // The zero point of B must be a scalar, as MatMulInteger also allows one per column.
+    NodeArg* b_zero_point_arg = nullptr;
+    if (matmul_integer_input_defs.size() > 3 && matmul_integer_input_defs[3]->Exists()) {
+      b_zero_point_arg = matmul_integer_input_defs[3];
+      if (!IsScalarOr1ElementVector(*b_zero_point_arg)) {
+        continue;
+      }
+    }
+
+    const Node& cast_node = *matmul_integer_node.OutputNodesBegin();
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(cast_node, "Cast", {6, 9}) ||
+        cast_node.GetExecutionProviderType() != matmul_integer_node.GetExecutionProviderType() ||
+        !optimizer_utils::IsAttributeWithExpectedValue(cast_node, "to",
+                                                       static_cast<int64_t>(TensorProto_DataType_FLOAT)) ||
+        cast_node.GetOutputEdgesCount() != 1 ||
+        !graph.GetNodeOutputsInGraphOutputs(cast_node).empty()) {
+      continue;
+    }
+
+    const Node& mul_node = *cast_node.OutputNodesBegin();
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(mul_node, "Mul", {7}) ||
+        mul_node.GetExecutionProviderType() != matmul_integer_node.GetExecutionProviderType()) {
+      continue;
+    }
+
+    // The other input of the Mul is the product of the scales of A and B.
+    const int cast_input_index = optimizer_utils::IndexOfNodeInput(mul_node, *cast_node.OutputDefs()[0]);
+    if (cast_input_index < 0) {
+      continue;
+    }
+    const Node* p_scales_mul_node = graph_utils::GetInputNode(mul_node, 1 - cast_input_index);
+    if (p_scales_mul_node == nullptr ||
+        !graph_utils::IsSupportedOptypeVersionAndDomain(*p_scales_mul_node, "Mul", {7}) ||
+        p_scales_mul_node->GetExecutionProviderType() != matmul_integer_node.GetExecutionProviderType()) {
+      continue;
+    }
+
+    const int a_scale_input_index =
+        optimizer_utils::IndexOfNodeInput(*p_scales_mul_node, *p_dynamic_quantize_node->OutputDefs()[1]);
+    if (a_scale_input_index < 0) {
+      continue;
+    }
+    NodeArg* b_scale_arg = const_cast<Node*>(p_scales_mul_node)->MutableInputDefs()[1 - a_scale_input_index];
+    if (!IsSupportedScaleOfB(*b_scale_arg, *matmul_integer_input_defs[1])) {
+      continue;
+    }
+
+    Node& dynamic_quantize_node = *graph.GetNode(p_dynamic_quantize_node->Index());
+    Node& scales_mul_node = *graph.GetNode(p_scales_mul_node->Index());
+    Node& mutable_cast_node = *graph.GetNode(cast_node.Index());
+    Node& mutable_mul_node = *graph.GetNode(mul_node.Index());
+
+    std::vector<NodeArg*> input_defs{dynamic_quantize_node.MutableInputDefs()[0],
+                                     matmul_integer_input_defs[1],
+                                     b_scale_arg};
+    if (b_zero_point_arg != nullptr) {
+      input_defs.push_back(b_zero_point_arg);
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("DynamicQuantizeMatMul"),
+                                     "DynamicQuantizeMatMul",
+                                     "fused DynamicQuantizeLinear, MatMulInteger, Cast and Mul",
+                                     input_defs,
+                                     {},
+                                     nullptr,
+                                     kMSDomain);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(matmul_integer_node.GetExecutionProviderType());
+
+    // A is read from the input of DynamicQuantizeLinear, so connect the fused node to its producer.
+    const Node::EdgeEnd* a_input_edge = graph_utils::GetInputEdge(dynamic_quantize_node, 0);
+    if (a_input_edge != nullptr) {
+      graph.AddEdge(a_input_edge->GetNode().Index(), fused_node.Index(), a_input_edge->GetSrcArgIndex(), 0);
+    }
+
+    // remove MatMulInteger and Cast, then move the output definitions and edges from the Mul to the fused node.
+    graph_utils::RemoveNodeOutputEdges(graph, matmul_integer_node);
+    graph.RemoveNode(matmul_integer_node.Index());
+    graph_utils::RemoveNodeOutputEdges(graph, mutable_cast_node);
+    graph.RemoveNode(mutable_cast_node.Index());
+    graph_utils::FinalizeNodeFusion(graph, fused_node, mutable_mul_node);
+
+    // DynamicQuantizeLinear and the scales Mul may be shared with other MatMulInteger nodes that are fused later.
+    if (RemoveNodeIfUnused(graph, scales_mul_node)) {
+      RemoveNodeIfUnused(graph, dynamic_quantize_node);
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
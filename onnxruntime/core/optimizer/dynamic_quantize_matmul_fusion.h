@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class DynamicQuantizeMatMulFusion
+
+Fuses the DynamicQuantizeLinear -> MatMulInteger -> Cast -> Mul chains produced by dynamic quantization into a single
+DynamicQuantizeMatMul contrib op. The scale of B is taken from the Mul that multiplies it with the scale produced by
+DynamicQuantizeLinear. DynamicQuantizeLinear and the scales Mul are removed once they have no consumers left.
+*/
+class DynamicQuantizeMatMulFusion : public GraphTransformer {
+ public:
+  DynamicQuantizeMatMulFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("DynamicQuantizeMatMulFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
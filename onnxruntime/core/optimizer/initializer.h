@@ -63,7 +63,12 @@ class Initializer final {
 
     size_ = std::accumulate(dims_.begin(), dims_.end(), static_cast<int64_t>(1), std::multiplies<int64_t>{});
 
-    if (utils::HasRawData(tensor_proto)) {
+    if (utils::HasInMemoryExternalData(tensor_proto)) {
+      const void* in_memory_data = nullptr;
+      size_t in_memory_length = 0;
+      ORT_THROW_IF_ERROR(utils::GetInMemoryExternalData(tensor_proto, in_memory_data, in_memory_length));
+      raw_data_.assign(static_cast<const char*>(in_memory_data), in_memory_length);
+    } else if (utils::HasRawData(tensor_proto)) {
       raw_data_ = tensor_proto.raw_data();
     } else {
       switch (data_type_) {
@@ -130,6 +135,9 @@ class Initializer final {
     tensor_proto.clear_data_type();
     tensor_proto.set_data_type(data_type_);
 
+    tensor_proto.clear_data_location();
+    tensor_proto.clear_external_data();
+
     if (!raw_data_.empty()) {
       tensor_proto.clear_raw_data();
       tensor_proto.set_raw_data(raw_data_);
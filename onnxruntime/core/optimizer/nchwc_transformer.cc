@@ -116,10 +116,13 @@ class NchwcTransformerImpl {
   void TransformConv(Node& node);
   void TransformPool(Node& node);
   void TransformAdd(Node& node);
+  void TransformMul(Node& node);
   void TransformConcat(Node& node);
   void TransformActivation(Node& node);
   void TransformBatchNormalization(Node& node);
   void TransformTranspose(Node& node);
+  void TransformResize(Node& node);
+  void TransformReduceMean(Node& node);
 
   Graph& graph_;
 
@@ -504,9 +507,9 @@ void NchwcTransformerImpl::TransformPool(Node& node) {
   removed_nodes_.push_front(node.Index());
 }
 
-// The existing Add/Sum operator implementations can be used with tensors
+// The existing Add/Sum/Mul operator implementations can be used with tensors
 // in NCHWc format if the tensor shapes are exactly the same (elementwise
-// add).
+// add or multiply).
 void NchwcTransformerImpl::TransformAdd(Node& node) {
   auto& input_defs = node.MutableInputDefs();
 
@@ -556,7 +559,7 @@ void NchwcTransformerImpl::TransformAdd(Node& node) {
 
   // If one of the inputs to the Add/Sum node is a NCHWc convolution, then
   // attempt to fuse the addition into the convolution itself.
-  if (input_defs_count == 2) {
+  if (input_defs_count == 2 && node.OpType() != "Mul") {
     for (size_t n = 0; n < 2; n++) {
       auto* nchwc_input_n = nchwc_inputs[n];
       auto& nchwc_node = nchwc_input_n->output_node_;
@@ -592,6 +595,82 @@ void NchwcTransformerImpl::TransformAdd(Node& node) {
   CreateNchwcArgument(node, node, nchwc_input_0->channels_, nchwc_input_0->shape_);
 }
 
+// Transform a multiply of a NCHWc tensor by a [N,C,1,1] tensor to a channel
+// scale. This is the excitation step of a squeeze-and-excitation block, where
+// the scale tensor is produced from a global pool of the NCHWc tensor followed
+// by a pair of pointwise convolutions, so the whole block stays in NCHWc format.
+void NchwcTransformerImpl::TransformMul(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+  auto& output_defs = node.MutableOutputDefs();
+
+  // Verify that all of the inputs to this operator are from NCHWc outputs.
+  NchwcArgument* nchwc_inputs[2];
+  for (size_t n = 0; n < 2; n++) {
+    auto it = nchwc_args_.find(input_defs[n]);
+    if (it == nchwc_args_.end()) {
+      return;
+    }
+    nchwc_inputs[n] = it->second.get();
+  }
+
+  auto is_channel_scale = [&](size_t n) {
+    auto* scale_shape = input_defs[n]->Shape();
+    auto* input_shape = input_defs[n ^ 1]->Shape();
+    if ((scale_shape == nullptr) || (scale_shape->dim_size() != kNchwcDims) ||
+        (input_shape == nullptr) || (input_shape->dim_size() != kNchwcDims)) {
+      return false;
+    }
+    for (int i = kNchwcBatchChannelDims; i < kNchwcDims; i++) {
+      auto& scale_dim = scale_shape->dim(i);
+      if (!utils::HasDimValue(scale_dim) || scale_dim.dim_value() != 1) {
+        return false;
+      }
+    }
+    // The batch count must match and the channel counts must match to
+    // avoid broadcasting across the NCHWc blocks.
+    if (nchwc_inputs[n]->channels_ != nchwc_inputs[n ^ 1]->channels_) {
+      return false;
+    }
+    if (!nchwc_inputs[n]->shape_.IsDimEqual(nchwc_inputs[n ^ 1]->shape_, 0)) {
+      auto& scale_dim = scale_shape->dim(0);
+      auto& input_dim = input_shape->dim(0);
+      if (!utils::HasDimValue(scale_dim) || !utils::HasDimValue(input_dim) ||
+          (scale_dim.dim_value() != input_dim.dim_value())) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  for (size_t n = 0; n < 2; n++) {
+    if (is_channel_scale(n)) {
+      auto* nchwc_input = nchwc_inputs[n ^ 1];
+      auto* nchwc_scale = nchwc_inputs[n];
+
+      // Create the replacement node.
+      std::string nchwc_node_name = graph_.GenerateNodeName(output_defs[0]->Name() + "_nchwc");
+      Node& nchwc_node = graph_.AddNode(nchwc_node_name,
+                                        "ScaleChannels",
+                                        nchwc_node_name,
+                                        {nchwc_input->nchwc_arg_, nchwc_scale->nchwc_arg_},
+                                        output_defs,
+                                        nullptr,
+                                        kMSNchwcDomain);
+      nchwc_node.SetExecutionProviderType(kCpuExecutionProvider);
+
+      nchwc_input->remaining_original_uses_--;
+      nchwc_scale->remaining_original_uses_--;
+
+      CreateNchwcArgument(node, nchwc_node, nchwc_input->channels_, nchwc_input->shape_);
+      removed_nodes_.push_front(node.Index());
+      return;
+    }
+  }
+
+  // Fallback to an elementwise multiply of identically shaped tensors.
+  TransformAdd(node);
+}
+
 void NchwcTransformerImpl::TransformConcat(Node& node) {
   auto& input_defs = node.MutableInputDefs();
   auto& output_defs = node.MutableOutputDefs();
@@ -656,6 +735,14 @@ void NchwcTransformerImpl::TransformActivation(Node& node) {
         (nchwc_input->starting_original_uses_ == 1) &&
         (graph_utils::GetNodeAttribute(nchwc_node, "activation") == nullptr)) {
       nchwc_node.AddAttribute("activation", node.OpType());
+      if (node.OpType() == "HardSigmoid") {
+        const auto* alpha_attr = graph_utils::GetNodeAttribute(node, "alpha");
+        const auto* beta_attr = graph_utils::GetNodeAttribute(node, "beta");
+        std::vector<float> activation_params{
+            (alpha_attr != nullptr && utils::HasFloat(*alpha_attr)) ? alpha_attr->f() : 0.2f,
+            (beta_attr != nullptr && utils::HasFloat(*beta_attr)) ? beta_attr->f() : 0.5f};
+        nchwc_node.AddAttribute("activation_params", activation_params);
+      }
       FuseNchwcArgument(node, *nchwc_input);
       removed_nodes_.push_front(node.Index());
     } else {
@@ -825,6 +912,195 @@ void NchwcTransformerImpl::TransformTranspose(Node& node) {
   removed_nodes_.push_front(node.Index());
 }
 
+// Transform Upsample/Resize with constant integer scaling of the spatial
+// dimensions to the NCHWc Upsample operator. Nearest neighbor modes are only
+// transformed if the coordinate transformation and rounding reduce to a simple
+// replication of each input element.
+void NchwcTransformerImpl::TransformResize(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+  auto& output_defs = node.MutableOutputDefs();
+
+  // Don't transform the node if the input is not already in NCHWc format.
+  auto it = nchwc_args_.find(input_defs[0]);
+  if (it == nchwc_args_.end()) {
+    return;
+  }
+  auto* nchwc_input = it->second.get();
+
+  const bool is_resize_11 = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Resize", {11});
+
+  // Extract the scales from the attribute or the constant input tensor.
+  std::vector<float> scales;
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Upsample", {7})) {
+    const auto* scales_attr = graph_utils::GetNodeAttribute(node, "scales");
+    if (scales_attr == nullptr) {
+      return;
+    }
+    scales.assign(scales_attr->floats().begin(), scales_attr->floats().end());
+  } else {
+    const size_t scales_index = is_resize_11 ? 2 : 1;
+    if (input_defs.size() <= scales_index) {
+      return;
+    }
+    // Bail out if Resize-11 has the optional sizes tensor specified.
+    if (is_resize_11 && input_defs.size() > 3 && input_defs[3]->Exists()) {
+      return;
+    }
+    const auto* scales_tensor_proto = graph_utils::GetConstantInitializer(graph_, input_defs[scales_index]->Name());
+    if ((scales_tensor_proto == nullptr) ||
+        (scales_tensor_proto->data_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) ||
+        (scales_tensor_proto->dims_size() != 1) ||
+        (scales_tensor_proto->dims(0) != kNchwcDims)) {
+      return;
+    }
+    Initializer scales_initializer(*scales_tensor_proto);
+    const float* scales_data = scales_initializer.data<float>();
+    scales.assign(scales_data, scales_data + kNchwcDims);
+  }
+
+  // Require that only the spatial dimensions are scaled by integer factors.
+  if (scales.size() != kNchwcDims || scales[0] != 1.0f || scales[1] != 1.0f) {
+    return;
+  }
+  std::vector<int64_t> nchwc_scales(kNchwcDims, 1);
+  for (int i = kNchwcBatchChannelDims; i < kNchwcDims; i++) {
+    // Bound the scale so that the integer conversion is well defined.
+    const float scale = scales[i];
+    if (scale < 1.0f || scale > 64.0f || scale != static_cast<float>(static_cast<int64_t>(scale))) {
+      return;
+    }
+    nchwc_scales[i] = static_cast<int64_t>(scale);
+  }
+
+  std::string mode = "nearest";
+  const auto* mode_attr = graph_utils::GetNodeAttribute(node, "mode");
+  if (mode_attr != nullptr && utils::HasString(*mode_attr)) {
+    mode = mode_attr->s();
+  }
+
+  // The coordinate transformation mode was introduced in Resize-11. Earlier
+  // versions behave as asymmetric with truncation for nearest neighbor.
+  std::string transformation_mode = "asymmetric";
+  std::string nearest_mode = "floor";
+  if (is_resize_11) {
+    transformation_mode = "half_pixel";
+    const auto* transformation_mode_attr = graph_utils::GetNodeAttribute(node, "coordinate_transformation_mode");
+    if (transformation_mode_attr != nullptr && utils::HasString(*transformation_mode_attr)) {
+      transformation_mode = transformation_mode_attr->s();
+    }
+    nearest_mode = "round_prefer_floor";
+    const auto* nearest_mode_attr = graph_utils::GetNodeAttribute(node, "nearest_mode");
+    if (nearest_mode_attr != nullptr && utils::HasString(*nearest_mode_attr)) {
+      nearest_mode = nearest_mode_attr->s();
+    }
+  }
+
+  if (mode == "nearest") {
+    const bool is_round_nearest = (nearest_mode == "round_prefer_floor" || nearest_mode == "round_prefer_ceil");
+    if (!((transformation_mode == "asymmetric" && nearest_mode == "floor") ||
+          (transformation_mode == "tf_half_pixel_for_nn" && nearest_mode == "floor") ||
+          (transformation_mode == "half_pixel" && is_round_nearest) ||
+          (transformation_mode == "pytorch_half_pixel" && is_round_nearest))) {
+      return;
+    }
+  } else if (mode == "linear") {
+    if (transformation_mode != "asymmetric" &&
+        transformation_mode != "half_pixel" &&
+        transformation_mode != "pytorch_half_pixel" &&
+        transformation_mode != "align_corners") {
+      return;
+    }
+  } else {
+    return;
+  }
+
+  // Create the replacement node.
+  std::string nchwc_node_name = graph_.GenerateNodeName(output_defs[0]->Name() + "_nchwc");
+  Node& nchwc_node = graph_.AddNode(nchwc_node_name,
+                                    "Upsample",
+                                    nchwc_node_name,
+                                    {nchwc_input->nchwc_arg_},
+                                    output_defs,
+                                    nullptr,
+                                    kMSNchwcDomain);
+  nchwc_node.SetExecutionProviderType(kCpuExecutionProvider);
+  nchwc_node.AddAttribute("scales", nchwc_scales);
+  nchwc_node.AddAttribute("mode", mode);
+  if (mode == "linear") {
+    nchwc_node.AddAttribute("coordinate_transformation_mode", transformation_mode);
+  }
+
+  nchwc_input->remaining_original_uses_--;
+
+  // Maintain the batch and channel dimensions from the NCHWc input.
+  NchwcArgument::Shape output_shape(output_defs[0]);
+  output_shape.dims_[0] = nchwc_input->shape_.dims_[0];
+  output_shape.dims_[1] = nchwc_input->shape_.dims_[1];
+
+  CreateNchwcArgument(node, nchwc_node, nchwc_input->channels_, output_shape);
+  removed_nodes_.push_front(node.Index());
+}
+
+// Transform ReduceMean over the spatial dimensions to the NCHWc
+// GlobalAveragePool operator. Models converted from other frameworks commonly
+// use this form for the squeeze step of squeeze-and-excitation blocks.
+void NchwcTransformerImpl::TransformReduceMean(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+  auto& output_defs = node.MutableOutputDefs();
+
+  // Don't transform the node if the input is not already in NCHWc format.
+  auto it = nchwc_args_.find(input_defs[0]);
+  if (it == nchwc_args_.end()) {
+    return;
+  }
+  auto* nchwc_input = it->second.get();
+
+  // Require that the reduced dimensions are kept.
+  const auto* keepdims_attr = graph_utils::GetNodeAttribute(node, "keepdims");
+  if (keepdims_attr != nullptr && utils::HasInt(*keepdims_attr) && keepdims_attr->i() != 1) {
+    return;
+  }
+
+  // Require that the reduction is over exactly the spatial dimensions.
+  const auto* axes_attr = graph_utils::GetNodeAttribute(node, "axes");
+  if (axes_attr == nullptr || axes_attr->ints_size() != kNchwcSpatialDims) {
+    return;
+  }
+  bool reduced_axes[kNchwcDims] = {};
+  for (auto axis : axes_attr->ints()) {
+    if (axis < 0) {
+      axis += kNchwcDims;
+    }
+    if (axis < kNchwcBatchChannelDims || axis >= kNchwcDims) {
+      return;
+    }
+    reduced_axes[axis] = true;
+  }
+  if (!reduced_axes[2] || !reduced_axes[3]) {
+    return;
+  }
+
+  // Create the replacement node.
+  std::string nchwc_node_name = graph_.GenerateNodeName(output_defs[0]->Name() + "_nchwc");
+  Node& nchwc_node = graph_.AddNode(nchwc_node_name,
+                                    "GlobalAveragePool",
+                                    nchwc_node_name,
+                                    {nchwc_input->nchwc_arg_},
+                                    output_defs,
+                                    nullptr,
+                                    kMSNchwcDomain);
+  nchwc_node.SetExecutionProviderType(kCpuExecutionProvider);
+
+  nchwc_input->remaining_original_uses_--;
+
+  // Maintain the batch dimension from the NCHWc input.
+  NchwcArgument::Shape output_shape(output_defs[0]);
+  output_shape.dims_[0] = nchwc_input->shape_.dims_[0];
+
+  CreateNchwcArgument(node, nchwc_node, nchwc_input->channels_, output_shape);
+  removed_nodes_.push_front(node.Index());
+}
+
 void NchwcTransformerImpl::Transform(Node& node) {
   if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Conv", {1, 11}) ||
       graph_utils::IsSupportedOptypeVersionAndDomain(node, "FusedConv", {1}, kMSDomain)) {
@@ -843,14 +1119,24 @@ void NchwcTransformerImpl::Transform(Node& node) {
     if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7}) ||
         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sum", {6, 8})) {
       TransformAdd(node);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7})) {
+      TransformMul(node);
     } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Concat", {4, 11})) {
       TransformConcat(node);
-    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6})) {
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "HardSigmoid", {6})) {
       TransformActivation(node);
     } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "BatchNormalization", {7, 9})) {
       TransformBatchNormalization(node);
     } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Transpose", {1})) {
       TransformTranspose(node);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Upsample", {7, 9}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Resize", {10, 11})) {
+      TransformResize(node);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceMean", {1, 11})) {
+      TransformReduceMean(node);
     }
   }
 
@@ -37,8 +37,11 @@ OptimizerExecutionFrame::Info::Info(const std::vector<const Node*>& nodes,
     InitializedTensorSet::const_iterator it = initialized_tensor_set.find(arg.Name());
     if (it != initialized_tensor_set.cend()) {
       const auto& tensor_proto = *(it->second);
-      size_t cpu_tensor_length;
-      ORT_RETURN_IF_ERROR(utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &cpu_tensor_length));
+      // a tensor that uses the data the tensor proto refers to in memory needs no buffer
+      size_t cpu_tensor_length = 0;
+      if (!utils::UsesInMemoryData(tensor_proto)) {
+        ORT_RETURN_IF_ERROR(utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &cpu_tensor_length));
+      }
       OrtValue ort_value;
       const OrtMemoryInfo& info = cpu_execution_provider_->GetAllocator(0, OrtMemTypeDefault)->Info();
       std::unique_ptr<char[]> data(new char[cpu_tensor_length]);
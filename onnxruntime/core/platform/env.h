@@ -67,6 +67,18 @@ class Env {
 
   virtual int GetNumCpuCores() const = 0;
 
+  /// \brief Restricts the calling thread to run on the given logical processors.
+  /// Returns false if thread affinity is not supported on this platform or could not be set.
+  virtual bool SetCurrentThreadAffinity(const std::vector<size_t>& logical_processors) const = 0;
+
+  /// \brief Returns the logical processors the process is allowed to run on, e.g. as restricted by a cpuset.
+  /// Returns an empty vector if this information is not available.
+  virtual std::vector<size_t> GetAvailableProcessors() const = 0;
+
+  /// \brief Returns the logical processors that belong to the given NUMA node.
+  /// Returns an empty vector if the node does not exist or NUMA information is not available.
+  virtual std::vector<size_t> GetNumaNodeProcessors(int numa_node) const = 0;
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const { return env_time_->NowMicros(); }
 
@@ -25,7 +25,10 @@ limitations under the License.
 #include <sys/mman.h>
 #include <fcntl.h>
 #include <dlfcn.h>
+#include <sched.h>
 #include <string.h>
+#include <fstream>
+#include <sstream>
 #include <thread>
 #include <utility>  // for std::forward
 #include <vector>
@@ -97,6 +100,73 @@ class PosixEnv : public Env {
     return std::thread::hardware_concurrency();
   }
 
+  bool SetCurrentThreadAffinity(const std::vector<size_t>& logical_processors) const override {
+#if defined(__linux__)
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (size_t processor : logical_processors) {
+      if (processor >= CPU_SETSIZE) {
+        return false;
+      }
+      CPU_SET(processor, &cpuset);
+    }
+    // a pid of 0 applies the mask to the calling thread
+    return !logical_processors.empty() && sched_setaffinity(0, sizeof(cpuset), &cpuset) == 0;
+#else
+    ORT_UNUSED_PARAMETER(logical_processors);
+    return false;
+#endif
+  }
+
+  std::vector<size_t> GetAvailableProcessors() const override {
+    std::vector<size_t> processors;
+#if defined(__linux__)
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    // a pid of 0 returns the mask of the calling thread, which new threads inherit
+    if (sched_getaffinity(0, sizeof(cpuset), &cpuset) == 0) {
+      for (size_t processor = 0; processor < CPU_SETSIZE; ++processor) {
+        if (CPU_ISSET(processor, &cpuset)) {
+          processors.push_back(processor);
+        }
+      }
+    }
+#endif
+    return processors;
+  }
+
+  std::vector<size_t> GetNumaNodeProcessors(int numa_node) const override {
+    std::vector<size_t> processors;
+#if defined(__linux__)
+    if (numa_node < 0) {
+      return processors;
+    }
+
+    // the list is formatted as comma separated ranges, e.g. "0-7,16-23"
+    std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(numa_node) + "/cpulist");
+    std::string range;
+    while (std::getline(cpulist, range, ',')) {
+      size_t first = 0;
+      size_t last = 0;
+      char dash = 0;
+      std::istringstream range_stream(range);
+      if (!(range_stream >> first)) {
+        break;
+      }
+      last = first;
+      if (range_stream >> dash >> last && dash != '-') {
+        break;
+      }
+      for (size_t processor = first; processor <= last; ++processor) {
+        processors.push_back(processor);
+      }
+    }
+#else
+    ORT_UNUSED_PARAMETER(numa_node);
+#endif
+    return processors;
+  }
+
   void SleepForMicroseconds(int64_t micros) const override {
     while (micros > 0) {
       timespec sleep_time;
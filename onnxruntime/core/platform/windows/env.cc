@@ -79,6 +79,46 @@ class WindowsEnv : public Env {
     return processorCoreCount;
   }
 
+  bool SetCurrentThreadAffinity(const std::vector<size_t>& logical_processors) const override {
+    // only the processors of the current processor group can be addressed with a thread affinity mask
+    DWORD_PTR mask = 0;
+    for (size_t processor : logical_processors) {
+      if (processor >= sizeof(DWORD_PTR) * 8) {
+        return false;
+      }
+      mask |= static_cast<DWORD_PTR>(1) << processor;
+    }
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+  }
+
+  std::vector<size_t> GetAvailableProcessors() const override {
+    std::vector<size_t> processors;
+    DWORD_PTR process_mask = 0;
+    DWORD_PTR system_mask = 0;
+    if (GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask)) {
+      for (size_t processor = 0; processor < sizeof(process_mask) * 8; ++processor) {
+        if (process_mask & (static_cast<DWORD_PTR>(1) << processor)) {
+          processors.push_back(processor);
+        }
+      }
+    }
+    return processors;
+  }
+
+  std::vector<size_t> GetNumaNodeProcessors(int numa_node) const override {
+    std::vector<size_t> processors;
+    ULONGLONG mask = 0;
+    if (numa_node >= 0 && numa_node <= MAXUCHAR &&
+        GetNumaNodeProcessorMask(static_cast<UCHAR>(numa_node), &mask)) {
+      for (size_t processor = 0; processor < sizeof(mask) * 8; ++processor) {
+        if (mask & (static_cast<ULONGLONG>(1) << processor)) {
+          processors.push_back(processor);
+        }
+      }
+    }
+    return processors;
+  }
+
   static WindowsEnv& Instance() {
     static WindowsEnv default_env;
     return default_env;
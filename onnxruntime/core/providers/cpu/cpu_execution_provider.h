@@ -12,6 +12,8 @@ namespace onnxruntime {
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  // the most memory the arena may hold. 0 for no limit.
+  size_t arena_max_bytes{0};
 
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
@@ -29,7 +31,8 @@ class CPUExecutionProvider : public IExecutionProvider {
       : IExecutionProvider{onnxruntime::kCpuExecutionProvider} {
     DeviceAllocatorRegistrationInfo device_info{OrtMemTypeDefault,
                                                 [](int) { return onnxruntime::make_unique<TAllocator>(); },
-                                                std::numeric_limits<size_t>::max()};
+                                                info.arena_max_bytes > 0 ? info.arena_max_bytes
+                                                                         : std::numeric_limits<size_t>::max()};
 
 #ifdef USE_JEMALLOC
 #if defined(USE_MIMALLOC_ARENA_ALLOCATOR) || defined(USE_MIMALLOC_STL_ALLOCATOR)
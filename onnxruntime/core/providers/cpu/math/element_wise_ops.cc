@@ -268,7 +268,9 @@ Status Pow<T>::Compute(OpKernelContext* context) const {
       *context,
       [](EigenVectorMap<T> output, T input0, ConstEigenVectorMap<T> input1) { output = Eigen::pow(input0, input1.array()); },
       input1scalar,
-      [](EigenVectorMap<T> output, ConstEigenVectorMap<T> input0, ConstEigenVectorMap<T> input1) { output = Eigen::pow(input0.array(), input1.array()); });
+      [](EigenVectorMap<T> output, ConstEigenVectorMap<T> input0, ConstEigenVectorMap<T> input1) { output = Eigen::pow(input0.array(), input1.array()); },
+      // pow costs much more than the other element-wise ops, so it's worth splitting smaller outputs
+      20.0);
 }
 
 template <typename T>
@@ -512,7 +514,15 @@ Status Mean_8<float>::Compute(OpKernelContext* context) const {
     return status;
 
   // Now divide by the input count to get the mean
-  EigenMap<float>(*context->Output<Tensor>(0)) *= 1.0f / static_cast<float>(Node().InputArgCount().front());
+  const float weight = 1.0f / static_cast<float>(Node().InputArgCount().front());
+  auto& mean = *context->Output<Tensor>(0);
+  float* mean_data = mean.template MutableData<float>();
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), mean.Shape().Size(),
+      concurrency::TensorOpCost{sizeof(float), sizeof(float), 1.0},
+      [mean_data, weight](std::ptrdiff_t first, std::ptrdiff_t last) {
+        EigenVectorMap<float>(mean_data + first, last - first) *= weight;
+      });
   return Status::OK();
 }
 
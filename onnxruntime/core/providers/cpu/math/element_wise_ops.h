@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -330,6 +331,25 @@ struct BroadcastIterator {
     return index;
   }
 
+  // Moves to the entry for the given offset in the output, as if AdvanceBy was called for all the prior entries.
+  void AdvanceTo(size_t offset) {
+    std::fill(counters_.begin(), counters_.end(), 0);
+    index_ = 0;
+    if (offset == 0)
+      return;
+
+    // deltas_[i] is added each time the counter below it wraps around
+    ptrdiff_t index = deltas_[0] * static_cast<ptrdiff_t>(offset);
+    int64_t wraps = static_cast<int64_t>(offset);
+    for (size_t counterIndex = 0; counterIndex < counters_.size(); counterIndex++) {
+      if (counterIndex > 0)
+        index += deltas_[counterIndex] * wraps;
+      counters_[counterIndex] = wraps % counts_[counterIndex];
+      wraps /= counts_[counterIndex];
+    }
+    index_ = static_cast<size_t>(index);
+  }
+
   void Reserve(int64_t max_dims) {
     deltas_.reserve(static_cast<size_t>(max_dims));
     counts_.reserve(static_cast<size_t>(max_dims));
@@ -500,18 +520,25 @@ struct TBroadcaster {
   bool IsInput0Scalar() const { return broadcaster_.iterator1_.deltas_.front() == 0; }
   bool IsInput1Scalar() const { return broadcaster_.iterator2_.deltas_.front() == 0; }
 
-  const T0& NextScalar0() { return *Next0(); }
-  const T1& NextScalar1() { return *Next1(); }
+  // Moves to the given offset in the output, so that a range of the output can be processed on its own.
+  void AdvanceTo(size_t offset) {
+    broadcaster_.iterator1_.AdvanceTo(offset);
+    broadcaster_.iterator2_.AdvanceTo(offset);
+  }
+
+  // The next count entries. count can be less than the span size, but must not cross the end of a span.
+  const T0& NextScalar0(size_t count) { return *Next0(count); }
+  const T1& NextScalar1(size_t count) { return *Next1(count); }
 
-  gsl::span<const T0> NextSpan0() { return gsl::span<const T0>(Next0(), span_size_); }
-  gsl::span<const T1> NextSpan1() { return gsl::span<const T1>(Next1(), span_size_); }
+  gsl::span<const T0> NextSpan0(size_t count) { return gsl::span<const T0>(Next0(count), count); }
+  gsl::span<const T1> NextSpan1(size_t count) { return gsl::span<const T1>(Next1(count), count); }
 
-  ConstEigenVectorMap<T0> NextEigen0() { return ConstEigenVectorMap<T0>(Next0(), span_size_); }
-  ConstEigenVectorMap<T1> NextEigen1() { return ConstEigenVectorMap<T1>(Next1(), span_size_); }
+  ConstEigenVectorMap<T0> NextEigen0(size_t count) { return ConstEigenVectorMap<T0>(Next0(count), count); }
+  ConstEigenVectorMap<T1> NextEigen1(size_t count) { return ConstEigenVectorMap<T1>(Next1(count), count); }
 
  private:
-  const T0* Next0() { return input0_ + broadcaster_.iterator1_.AdvanceBy(span_size_); }
-  const T1* Next1() { return input1_ + broadcaster_.iterator2_.AdvanceBy(span_size_); }
+  const T0* Next0(size_t count) { return input0_ + broadcaster_.iterator1_.AdvanceBy(count); }
+  const T1* Next1(size_t count) { return input1_ + broadcaster_.iterator2_.AdvanceBy(count); }
 
   const Tensor& input_tensor0_;
   const Tensor& input_tensor1_;
@@ -530,28 +557,49 @@ struct TBroadcastOutput {
     output_end_ = output_ + tensor.Shape().Size();
   }
 
+  // Output for the entries [first, last) of the tensor. The spans are cut short at the ends of the range.
+  TBroadcastOutput(size_t span_size, Tensor& tensor, std::ptrdiff_t first, std::ptrdiff_t last)
+      : span_size_(span_size) {
+    output_ = tensor.template MutableData<T>() + first;
+    output_end_ = tensor.template MutableData<T>() + last;
+    span_offset_ = span_size == 0 ? 0 : static_cast<size_t>(first) % span_size;
+  }
+
   operator bool() const {
     return output_ != output_end_;
   }
 
+  // Number of entries up to the end of the current span or of the output, whichever comes first
+  size_t NextSpanSize() const {
+    return std::min(span_size_ - span_offset_, static_cast<size_t>(output_end_ - output_));
+  }
+
   EigenVectorMap<T> NextEigenOutput() {
-    return EigenVectorMap<T>(NextOutput(), span_size_);
+    return NextEigenOutput(NextSpanSize());
   }
 
-  gsl::span<T> NextSpanOutput() {
-    return gsl::span<T>(NextOutput(), span_size_);
+  EigenVectorMap<T> NextEigenOutput(size_t count) {
+    return EigenVectorMap<T>(NextOutput(count), count);
+  }
+
+  gsl::span<T> NextSpanOutput(size_t count) {
+    return gsl::span<T>(NextOutput(count), count);
   }
 
  private:
-  T* NextOutput() {
+  T* NextOutput(size_t count) {
     T* output = output_;
-    output_ += span_size_;
+    output_ += count;
+    span_offset_ += count;
+    if (span_offset_ == span_size_)
+      span_offset_ = 0;
     return output;
   }
 
   T* output_;
   const T* output_end_;
   size_t span_size_;
+  size_t span_offset_{};
 };
 
 template <typename T>
@@ -580,14 +628,20 @@ struct TensorAllocator {
 template <typename TBroadcaster, typename Output, typename Input0Scalar, typename Input1Scalar, typename General>
 void BroadcastLoop(TBroadcaster& bc, Output& output, Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
   if (bc.IsInput0Scalar()) {
-    while (output)
-      input0scalar(output.NextEigenOutput(), bc.NextScalar0(), bc.NextEigen1());
+    while (output) {
+      const size_t count = output.NextSpanSize();
+      input0scalar(output.NextEigenOutput(count), bc.NextScalar0(count), bc.NextEigen1(count));
+    }
   } else if (bc.IsInput1Scalar()) {
-    while (output)
-      input1scalar(output.NextEigenOutput(), bc.NextEigen0(), bc.NextScalar1());
+    while (output) {
+      const size_t count = output.NextSpanSize();
+      input1scalar(output.NextEigenOutput(count), bc.NextEigen0(count), bc.NextScalar1(count));
+    }
   } else {
-    while (output)
-      general(output.NextEigenOutput(), bc.NextEigen0(), bc.NextEigen1());
+    while (output) {
+      const size_t count = output.NextSpanSize();
+      general(output.NextEigenOutput(count), bc.NextEigen0(count), bc.NextEigen1(count));
+    }
   }
 }
 
@@ -599,22 +653,54 @@ void BroadcastLoop(TBroadcaster& bc, Output& output, Input0Scalar input0scalar,
 template <typename TBroadcaster, typename Output, typename Input0Scalar, typename Input1Scalar, typename General>
 void BroadcastLoopSpan(TBroadcaster& bc, Output& output, Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
   if (bc.IsInput0Scalar()) {
-    while (output)
-      input0scalar(output.NextSpanOutput(), bc.NextScalar0(), bc.NextSpan1());
+    while (output) {
+      const size_t count = output.NextSpanSize();
+      input0scalar(output.NextSpanOutput(count), bc.NextScalar0(count), bc.NextSpan1(count));
+    }
   } else if (bc.IsInput1Scalar()) {
-    while (output)
-      input1scalar(output.NextSpanOutput(), bc.NextSpan0(), bc.NextScalar1());
+    while (output) {
+      const size_t count = output.NextSpanSize();
+      input1scalar(output.NextSpanOutput(count), bc.NextSpan0(count), bc.NextScalar1(count));
+    }
   } else {
-    while (output)
-      general(output.NextSpanOutput(), bc.NextSpan0(), bc.NextSpan1());
+    while (output) {
+      const size_t count = output.NextSpanSize();
+      general(output.NextSpanOutput(count), bc.NextSpan0(count), bc.NextSpan1(count));
+    }
   }
 }
 
+// Splits the output of a broadcast into blocks that are processed in parallel. Each block calls
+// loop(TBroadcaster<TInput0, TInput1>& bc, TBroadcastOutput<TOutput>& output) with a copy of bc moved to the start of
+// the block, so loop is usually a call to BroadcastLoop or BroadcastLoopSpan.
+// The block size is chosen from the cost of computing one output entry, so small outputs run on the calling thread.
+// Broadcasts of a scalar, a row or a column over the other input are all handled the same way, as a span is cut short
+// at the ends of a block.
+template <typename TInput0, typename TInput1, typename TOutput, typename Loop>
+void ParallelBroadcastLoop(concurrency::ThreadPool* tp, const TBroadcaster<TInput0, TInput1>& bc, Tensor& output_tensor,
+                           Loop loop, double compute_cycles_per_entry = 1.0) {
+  const concurrency::TensorOpCost cost{static_cast<double>(sizeof(TInput0) + sizeof(TInput1)),
+                                       static_cast<double>(sizeof(TOutput)), compute_cycles_per_entry};
+  concurrency::ThreadPool::TryParallelFor(
+      tp, output_tensor.Shape().Size(), cost, [&bc, &output_tensor, &loop](std::ptrdiff_t first, std::ptrdiff_t last) {
+        TBroadcaster<TInput0, TInput1> block_bc(bc);
+        block_bc.AdvanceTo(static_cast<size_t>(first));
+        TBroadcastOutput<TOutput> block_output(bc.GetSpanSize(), output_tensor, first, last);
+        loop(block_bc, block_output);
+      });
+}
+
 template <typename TInput, typename TOutput, typename Input0Scalar, typename Input1Scalar, typename General>
-Status BroadcastTwo(OpKernelContext& context, Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
+Status BroadcastTwo(OpKernelContext& context, Input0Scalar input0scalar, Input1Scalar input1scalar, General general,
+                    double compute_cycles_per_entry = 1.0) {
   TBroadcaster<TInput, TInput> bc(*context.Input<Tensor>(0), *context.Input<Tensor>(1));
-  TBroadcastOutput<TOutput> output(bc.GetSpanSize(), *context.Output(0, bc.GetOutputShape()));
-  BroadcastLoop(bc, output, input0scalar, input1scalar, general);
+  Tensor& output = *context.Output(0, bc.GetOutputShape());
+  ParallelBroadcastLoop<TInput, TInput, TOutput>(
+      context.GetOperatorThreadPool(), bc, output,
+      [&](TBroadcaster<TInput, TInput>& block_bc, TBroadcastOutput<TOutput>& block_output) {
+        BroadcastLoop(block_bc, block_output, input0scalar, input1scalar, general);
+      },
+      compute_cycles_per_entry);
 
   return Status::OK();
 }
@@ -651,9 +737,11 @@ Status BroadcastVariadic(const Node& node, OpKernelContext& context, Input0Scala
       p_output = tempOutput.get();
     }
 
-    TBroadcastOutput<TOutput> output(bc.GetSpanSize(), *p_output);
-
-    BroadcastLoop(bc, output, input0scalar, input1scalar, general);
+    ParallelBroadcastLoop<TInput, TInput, TOutput>(
+        context.GetOperatorThreadPool(), bc, *p_output,
+        [&](TBroadcaster<TInput, TInput>& block_bc, TBroadcastOutput<TOutput>& block_output) {
+          BroadcastLoop(block_bc, block_output, input0scalar, input1scalar, general);
+        });
 
     tempInput = std::move(tempOutput);
   }
@@ -5,6 +5,34 @@
 
 namespace onnxruntime {
 
+bool GemmPackBFp32(const AllocatorPtr& alloc, const Tensor& tensor_b, bool trans_b,
+                   /*out*/ BufferUniquePtr& packed_b, /*out*/ size_t& packed_b_size,
+                   /*out*/ TensorShape& b_shape) {
+  // Only a 2D matrix B is packed as it is shared by every matrix from A.
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const size_t K = static_cast<size_t>(trans_b ? b_shape[1] : b_shape[0]);
+  const size_t N = static_cast<size_t>(trans_b ? b_shape[0] : b_shape[1]);
+
+  packed_b_size = MlasGemmPackBSize(N, K);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+
+  // Clear the buffer so that any padding is deterministic, as packed buffers
+  // are compared by content when shared between sessions.
+  memset(packed_b_data, 0, packed_b_size);
+  MlasGemmPackB(trans_b ? CblasTrans : CblasNoTrans, N, K, tensor_b.Data<float>(),
+                static_cast<size_t>(b_shape[1]), packed_b_data);
+  return true;
+}
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Gemm,
     7,
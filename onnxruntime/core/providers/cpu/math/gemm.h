@@ -5,12 +5,20 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
 
 namespace onnxruntime {
 
+// Packs the 2D float matrix B for MlasGemm into a buffer allocated from 'alloc'.
+// Returns false if B is not packed.
+bool GemmPackBFp32(const AllocatorPtr& alloc, const Tensor& tensor_b, bool trans_b,
+                   /*out*/ BufferUniquePtr& packed_b, /*out*/ size_t& packed_b_size,
+                   /*out*/ TensorShape& b_shape);
+
 template <typename T>
 class Gemm : public OpKernel {
  public:
@@ -26,14 +34,45 @@ class Gemm : public OpKernel {
     ORT_ENFORCE(info.GetAttr<float>("beta", &beta_).IsOK());
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override {
+    is_packed = false;
+
+    // Pack a constant float matrix B once so that each call to Compute skips
+    // the packing that MlasGemm would otherwise repeat for every run.
+    if (std::is_same<T, float>::value && input_idx == 1) {
+      size_t packed_b_size;
+      is_packed = GemmPackBFp32(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+      if (is_packed && prepacked_weights != nullptr) {
+        prepacked_weights->buffers_.push_back(std::move(packed_b_));
+        prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+      }
+    }
+
+    return Status::OK();
+  }
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override {
+    used_shared_buffers = false;
+
+    if (input_idx == 1) {
+      used_shared_buffers = true;
+      packed_b_ = std::move(prepacked_buffers[0]);
+    }
+
+    return Status::OK();
+  }
+
   Status Compute(OpKernelContext* context) const override {
     concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
     const auto* X = context->Input<Tensor>(0);
-    const auto* W = context->Input<Tensor>(1);
+    // the original matrix B is released once it has been packed
+    const auto* W = packed_b_ ? nullptr : context->Input<Tensor>(1);
     const auto* B = context->Input<Tensor>(2);
     // Bias could be missing. Treat as scalar 0 if that is the case.
-    GemmHelper helper(X->Shape(), trans_A_ != CblasNoTrans, W->Shape(), trans_B_ != CblasNoTrans,
+    GemmHelper helper(X->Shape(), trans_A_ != CblasNoTrans, packed_b_ ? b_shape_ : W->Shape(), trans_B_ != CblasNoTrans,
                       B != nullptr ? B->Shape() : TensorShape({}));
 
     if (!helper.State().IsOK())
@@ -68,20 +107,38 @@ class Gemm : public OpKernel {
     }
 
     // W * x
-    math::Gemm<T>(
-        trans_A_,
-        trans_B_,
-        M,
-        N,
-        helper.K(),
-        alpha_,
-        X->template Data<T>(),
-        W->template Data<T>(),
-        // ideally we need to set the output buffer contents to 0 if bias is missing,
-        // but passing 0 for beta is cheaper and it will ignore any junk in the output buffer
-        B != nullptr ? beta_ : 0,
-        y_data,
-        thread_pool);
+    if (packed_b_) {
+      // packed_b_ is only populated when T is float.
+      const int64_t K = helper.K();
+      MlasGemm(
+          trans_A_,
+          static_cast<size_t>(M),
+          static_cast<size_t>(N),
+          static_cast<size_t>(K),
+          alpha_,
+          X->template Data<float>(),
+          static_cast<size_t>(trans_A_ == CblasNoTrans ? K : M),
+          packed_b_.get(),
+          B != nullptr ? beta_ : 0,
+          Y->template MutableData<float>(),
+          static_cast<size_t>(N),
+          thread_pool);
+    } else {
+      math::Gemm<T>(
+          trans_A_,
+          trans_B_,
+          M,
+          N,
+          helper.K(),
+          alpha_,
+          X->template Data<T>(),
+          W->template Data<T>(),
+          // ideally we need to set the output buffer contents to 0 if bias is missing,
+          // but passing 0 for beta is cheaper and it will ignore any junk in the output buffer
+          B != nullptr ? beta_ : 0,
+          y_data,
+          thread_pool);
+    }
 
     FuseActivation<T>(activation_, y_data, M * N, leaky_relu_alpha_);
 
@@ -94,6 +151,10 @@ class Gemm : public OpKernel {
   float alpha_;
   float beta_;
 
+  // Matrix B is packed once by PrePack when it is a constant 2D initializer.
+  TensorShape b_shape_;
+  BufferUniquePtr packed_b_;
+
  protected:
   // For fused gemm + activation
   std::string activation_;
@@ -2,8 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/matmul.h"
+#include "core/providers/cpu/math/gemm.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
 #include "matmul_helper.h"
 
 namespace onnxruntime {
@@ -92,4 +94,85 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                              /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // Pack a constant matrix B once so that each call to Compute skips the
+  // packing that MlasGemm would otherwise repeat for every run.
+  if (input_idx == 1) {
+    size_t packed_b_size;
+    is_packed = GemmPackBFp32(alloc, tensor, false, packed_b_, packed_b_size, b_shape_);
+    if (is_packed && prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(packed_b_));
+      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    }
+  }
+
+  return Status::OK();
+}
+
+Status MatMul<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                                /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status MatMul<float>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const auto* left_X = ctx->Input<Tensor>(0);
+  // the original matrix B is released once it has been packed
+  const auto* right_X = packed_b_ ? nullptr : ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(left_X->Shape(), packed_b_ ? b_shape_ : right_X->Shape()));
+
+  Tensor* Y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (Y->Shape().Size() == 0)
+    return Status::OK();
+
+  const float* a_data = left_X->Data<float>();
+  float* y_data = Y->MutableData<float>();
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  if (packed_b_) {
+    // The packed matrix B is 2D, so the right offsets are always zero.
+    for (size_t i = 0; i < max_len; i++) {
+      MlasGemm(CblasNoTrans, M, N, K, 1.0f,
+               a_data + helper.LeftOffsets()[i], K,
+               packed_b_.get(), 0.0f,
+               y_data + helper.OutputOffsets()[i], N,
+               thread_pool);
+    }
+    return Status::OK();
+  }
+
+  const float* b_data = right_X->Data<float>();
+
+  for (size_t i = 0; i < max_len; i++) {
+    math::MatMul<float>(
+        static_cast<int>(M),
+        static_cast<int>(N),
+        static_cast<int>(K),
+        a_data + helper.LeftOffsets()[i],
+        b_data + helper.RightOffsets()[i],
+        y_data + helper.OutputOffsets()[i], thread_pool);
+  }
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
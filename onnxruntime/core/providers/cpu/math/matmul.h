@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/prepacked_weights.h"
 
 namespace onnxruntime {
 
@@ -18,4 +19,25 @@ class MatMul final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 };
 
+template <>
+class MatMul<float> final : public OpKernel {
+ public:
+  MatMul(const OpKernelInfo& info)
+      : OpKernel(info) {
+  }
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // Matrix B is packed once by PrePack when it is a constant 2D initializer.
+  TensorShape b_shape_;
+  BufferUniquePtr packed_b_;
+};
+
 }  // namespace onnxruntime
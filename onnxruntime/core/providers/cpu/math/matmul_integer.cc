@@ -9,6 +9,34 @@
 
 namespace onnxruntime {
 
+bool QGemmPackBTensor(const AllocatorPtr& alloc, const Tensor& tensor_b,
+                      /*out*/ BufferUniquePtr& packed_b, /*out*/ size_t& packed_b_size,
+                      /*out*/ TensorShape& b_shape) {
+  // Only a 2D matrix B is packed as it is shared by every matrix from A.
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const int K = static_cast<int>(b_shape[0]);
+  const int N = static_cast<int>(b_shape[1]);
+  const bool b_is_signed = tensor_b.IsDataType<int8_t>();
+
+  packed_b_size = QGemmPackBSize(N, K, b_is_signed);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+
+  // Clear the buffer so that any padding is deterministic, as packed buffers
+  // are compared by content when shared between sessions.
+  memset(packed_b_data, 0, packed_b_size);
+  QGemmPackB(N, K, static_cast<const uint8_t*>(tensor_b.DataRaw()), N, b_is_signed, packed_b_data);
+  return true;
+}
+
 // only register this operator if low precision computation is enabled.
 ONNX_OPERATOR_TYPED_KERNEL_EX(
     MatMulInteger,
@@ -39,11 +67,12 @@ Status MatMulInteger<uint8_t, uint8_t>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
   auto a = ctx->Input<Tensor>(0);
-  auto b = ctx->Input<Tensor>(1);
-  ORT_ENFORCE(a != nullptr && b != nullptr);
+  // the original matrix B is released once it has been packed
+  auto b = packed_b_ ? nullptr : ctx->Input<Tensor>(1);
+  ORT_ENFORCE(a != nullptr && (packed_b_ || b != nullptr));
 
   MatMulComputeHelper helper;
-  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), packed_b_ ? b_shape_ : b->Shape()));
   Tensor* y = ctx->Output(0, helper.OutputShape());
 
   // validate zero points
@@ -62,6 +91,25 @@ Status MatMulInteger<uint8_t, uint8_t>::Compute(OpKernelContext* ctx) const {
     b_offset = static_cast<int32_t>(*b_zero_point->template Data<uint8_t>());
   }
 
+  if (packed_b_) {
+    // The packed matrix B is 2D, so the right offsets are always zero.
+    for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+      QGemmu8x8_s32(static_cast<int>(helper.M()),
+                    static_cast<int>(helper.N()),
+                    static_cast<int>(helper.K()),
+                    a->template Data<uint8_t>() + helper.LeftOffsets()[i],
+                    static_cast<int>(helper.K()),
+                    a_offset,
+                    packed_b_.get(),
+                    b_offset,
+                    false,
+                    y->template MutableData<int32_t>() + helper.OutputOffsets()[i],
+                    static_cast<int>(helper.N()),
+                    thread_pool);
+    }
+    return Status::OK();
+  }
+
   for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
     QGemmu8u8_s32(static_cast<int>(helper.M()),
                   static_cast<int>(helper.N()),
@@ -84,11 +132,12 @@ Status MatMulInteger<uint8_t, int8_t>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
   auto a = ctx->Input<Tensor>(0);
-  auto b = ctx->Input<Tensor>(1);
-  ORT_ENFORCE(a != nullptr && b != nullptr);
+  // the original matrix B is released once it has been packed
+  auto b = packed_b_ ? nullptr : ctx->Input<Tensor>(1);
+  ORT_ENFORCE(a != nullptr && (packed_b_ || b != nullptr));
 
   MatMulComputeHelper helper;
-  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), packed_b_ ? b_shape_ : b->Shape()));
   Tensor* y = ctx->Output(0, helper.OutputShape());
 
   if (has_a_zero_point_ || has_b_zero_point_) {
@@ -111,6 +160,25 @@ Status MatMulInteger<uint8_t, int8_t>::Compute(OpKernelContext* ctx) const {
     }
   }
 
+  if (packed_b_) {
+    // The packed matrix B is 2D, so the right offsets are always zero.
+    for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+      QGemmu8x8_s32(static_cast<int>(helper.M()),
+                    static_cast<int>(helper.N()),
+                    static_cast<int>(helper.K()),
+                    a->template Data<uint8_t>() + helper.LeftOffsets()[i],
+                    static_cast<int>(helper.K()),
+                    0,
+                    packed_b_.get(),
+                    0,
+                    true,
+                    y->template MutableData<int32_t>() + helper.OutputOffsets()[i],
+                    static_cast<int>(helper.N()),
+                    thread_pool);
+    }
+    return Status::OK();
+  }
+
   for (int i = 0; i < static_cast<int>(helper.OutputOffsets().size()); i++) {
     QGemmu8s8_s32(static_cast<int>(helper.M()),
                   static_cast<int>(helper.N()),
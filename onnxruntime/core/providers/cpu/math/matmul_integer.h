@@ -5,10 +5,17 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/prepacked_weights.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
 
+// Packs the 2D uint8 or int8 matrix B of a quantized matrix multiply for the QGEMM into a buffer allocated from
+// 'alloc'. Returns false if B is not packed.
+bool QGemmPackBTensor(const AllocatorPtr& alloc, const Tensor& tensor_b,
+                      /*out*/ BufferUniquePtr& packed_b, /*out*/ size_t& packed_b_size,
+                      /*out*/ TensorShape& b_shape);
+
 template <typename T1, typename T2>
 class MatMulInteger final : public OpKernel {
  public:
@@ -23,10 +30,44 @@ class MatMulInteger final : public OpKernel {
     }
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override {
+    is_packed = false;
+
+    // Pack a constant matrix B once so that each call to Compute skips the
+    // packing that the QGEMM would otherwise repeat for every run.
+    if (input_idx == 1) {
+      size_t packed_b_size;
+      is_packed = QGemmPackBTensor(alloc, tensor, packed_b_, packed_b_size, b_shape_);
+      if (is_packed && prepacked_weights != nullptr) {
+        prepacked_weights->buffers_.push_back(std::move(packed_b_));
+        prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+      }
+    }
+
+    return Status::OK();
+  }
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override {
+    used_shared_buffers = false;
+
+    if (input_idx == 1) {
+      used_shared_buffers = true;
+      packed_b_ = std::move(prepacked_buffers[0]);
+    }
+
+    return Status::OK();
+  }
+
   Status Compute(OpKernelContext* context) const override;
 
  private:
   bool has_a_zero_point_;
   bool has_b_zero_point_;
+
+  // Matrix B is packed once by PrePack when it is a constant 2D initializer.
+  TensorShape b_shape_;
+  BufferUniquePtr packed_b_;
 };
 }  // namespace onnxruntime
@@ -3,7 +3,9 @@
 
 #include "core/providers/cpu/math/quantize_linear_matmul.h"
 #include "core/providers/cpu/math/matmul_helper.h"
+#include "core/common/safeint.h"
 #include "core/providers/common.h"
+#include "core/util/qmath.h"
 
 namespace onnxruntime {
 
@@ -56,22 +58,34 @@ Status QLinearMatMul<uint8_t, uint8_t, uint8_t>::Compute(OpKernelContext* ctx) c
   auto y_scale_data = *(y_scale->template Data<float>());
 
   const float real_multiplier = (a_scale_data * b_scale_data) / y_scale_data;
-  int32_t integer_multiplier;
-  int right_shift;
-  QuantizeMultiplier(real_multiplier, &integer_multiplier, &right_shift);
+
+  // With MLAS, the int32 accumulators of each block are requantized while they are still in the cache, so the
+  // accumulator buffer is only written and read back once per block. gemmlowp doesn't use the buffer.
+  int32_t* accumulator_data = nullptr;
+#ifndef USE_GEMMLOWP
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+  BufferUniquePtr accumulator_buffer(allocator->Alloc(SafeInt<size_t>(sizeof(int32_t)) * helper.M() * helper.N()),
+                                     BufferDeleter(allocator));
+  accumulator_data = static_cast<int32_t*>(accumulator_buffer.get());
+#endif
 
   for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
-    GemmlowpMultiplyu8u8_u8(a->template Data<uint8_t>() + helper.LeftOffsets()[i],
-                            b->template Data<uint8_t>() + helper.RightOffsets()[i],
-                            y->template MutableData<uint8_t>() + helper.OutputOffsets()[i],
-                            *a_offset->template Data<uint8_t>(),
-                            *b_offset->template Data<uint8_t>(),
-                            *y_offset->template Data<uint8_t>(),
-                            static_cast<int>(helper.M()),
-                            static_cast<int>(helper.N()),
-                            static_cast<int>(helper.K()),
-                            integer_multiplier,
-                            right_shift);
+    QGemmu8u8_u8(static_cast<int>(helper.M()),
+                 static_cast<int>(helper.N()),
+                 static_cast<int>(helper.K()),
+                 a->template Data<uint8_t>() + helper.LeftOffsets()[i],
+                 static_cast<int>(helper.K()),
+                 *a_offset->template Data<uint8_t>(),
+                 b->template Data<uint8_t>() + helper.RightOffsets()[i],
+                 static_cast<int>(helper.N()),
+                 *b_offset->template Data<uint8_t>(),
+                 y->template MutableData<uint8_t>() + helper.OutputOffsets()[i],
+                 static_cast<int>(helper.N()),
+                 real_multiplier,
+                 *y_offset->template Data<uint8_t>(),
+                 accumulator_data,
+                 ctx->GetOperatorThreadPool());
   }
 
   return Status::OK();
@@ -20,6 +20,7 @@ limitations under the License.
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/op_kernel_context_internal.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 #include "core/util/softmax.h"
 #include "core/providers/common.h"
@@ -39,9 +40,6 @@ class Softmax final : public OpKernel {
   }
 
   Status Compute(OpKernelContext* ctx) const override {
-#ifndef USE_OPENMP
-    concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
-#endif
     const auto* tensor_pointer = ctx->Input<Tensor>(0);
     if (tensor_pointer == nullptr)
       return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
@@ -58,25 +56,38 @@ class Softmax final : public OpKernel {
 
     const int64_t axis = HandleNegativeAxis(axis_, input_shape.NumDimensions());
 
-    int N = static_cast<int>(input_shape.SizeToDimension(axis));
-    int D = static_cast<int>(input_shape.SizeFromDimension(axis));
+    const size_t N = static_cast<size_t>(input_shape.SizeToDimension(axis));
+    const size_t D = static_cast<size_t>(input_shape.SizeFromDimension(axis));
+
+    ComputeSoftmax(X.Data<T>(), Y->MutableData<T>(), N, D, ctx->GetOperatorThreadPool());
+    return Status::OK();
+  }
+
+ private:
+  // MLAS runs the max, exp/sum and scale steps on one row at a time, without materializing intermediates across
+  // rows, and partitions the rows across the thread pool.
+  void ComputeSoftmax(const float* X, float* Y, size_t N, size_t D, concurrency::ThreadPool* tp) const {
+    MlasComputeSoftmax(X, Y, N, D, use_log, tp);
+  }
 
-    Eigen::TensorMap<Eigen::Tensor<const T, 2, Eigen::RowMajor, Eigen::DenseIndex>, Eigen::Aligned> X_tensor(
-        X.Data<T>(), N, D);
-    Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor, Eigen::DenseIndex>, Eigen::Aligned> Y_tensor(
-        Y->MutableData<T>(), N, D);
+  void ComputeSoftmax(const double* X, double* Y, size_t N, size_t D, concurrency::ThreadPool* tp) const {
+    Eigen::TensorMap<Eigen::Tensor<const double, 2, Eigen::RowMajor, Eigen::DenseIndex>, Eigen::Aligned> X_tensor(
+        X, N, D);
+    Eigen::TensorMap<Eigen::Tensor<double, 2, Eigen::RowMajor, Eigen::DenseIndex>, Eigen::Aligned> Y_tensor(
+        Y, N, D);
 #ifndef USE_OPENMP
     if (tp == nullptr)
+#else
+    ORT_UNUSED_PARAMETER(tp);
 #endif
-      ComputeSoftMax<use_log>(Eigen::DefaultDevice(), X_tensor, Y_tensor, N, D);
+      ComputeSoftMax<use_log>(Eigen::DefaultDevice(), X_tensor, Y_tensor, static_cast<int>(N), static_cast<int>(D));
 #ifndef USE_OPENMP
     else
-      ComputeSoftMax<use_log>(Eigen::ThreadPoolDevice(&tp->GetHandler(), tp->NumThreads()), X_tensor, Y_tensor, N, D);
+      ComputeSoftMax<use_log>(Eigen::ThreadPoolDevice(&tp->GetHandler(), tp->NumThreads()), X_tensor, Y_tensor,
+                              static_cast<int>(N), static_cast<int>(D));
 #endif
-    return Status::OK();
   }
 
- private:
   int axis_;
 };
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 namespace ml {  // name space for onnx.ml operators
@@ -267,25 +268,56 @@ static inline void ComputeSoftmax(std::vector<float>& values) {
 }
 
 //this function skips zero values (since exp(0) is non zero)
-static inline void ComputeSoftmaxZero(std::vector<float>& values) {
+static inline void ComputeSoftmaxZero(float* values, size_t count) {
+  float* end = values + count;
   // compute exp with negative number to be numerically stable
   float v_max = -std::numeric_limits<float>::max();
-  for (float value : values) {
-    if (value > v_max)
-      v_max = value;
+  for (float* value = values; value != end; ++value) {
+    if (*value > v_max)
+      v_max = *value;
   }
   float exp_neg_v_max = std::exp(-v_max);
   float this_sum = 0.f;
-  for (float& value : values) {
-    if (value > 0.0000001f || value < -0.0000001f) {
-      value = std::exp(value - v_max);
-      this_sum += value;
+  for (float* value = values; value != end; ++value) {
+    if (*value > 0.0000001f || *value < -0.0000001f) {
+      *value = std::exp(*value - v_max);
+      this_sum += *value;
     } else {
-      value *= exp_neg_v_max;
+      *value *= exp_neg_v_max;
     }
   }
-  for (float& value : values)
-    value /= this_sum;
+  for (float* value = values; value != end; ++value)
+    *value /= this_sum;
+}
+
+static inline void ComputeSoftmaxZero(std::vector<float>& values) {
+  ComputeSoftmaxZero(values.data(), values.size());
+}
+
+// Applies the post transform in place to num_rows rows of num_scores scores, as write_scores does for a row of
+// two or more scores. LOGISTIC and SOFTMAX use the vectorized MLAS kernels over all the rows at once.
+static inline void batch_post_transform(float* scores, int64_t num_rows, int64_t num_scores,
+                                        POST_EVAL_TRANSFORM post_transform, concurrency::ThreadPool* tp) {
+  const size_t count = static_cast<size_t>(num_rows * num_scores);
+  switch (post_transform) {
+    case POST_EVAL_TRANSFORM::PROBIT:
+      for (size_t i = 0; i < count; ++i)
+        scores[i] = ComputeProbit(scores[i]);
+      break;
+    case POST_EVAL_TRANSFORM::LOGISTIC:
+      MlasComputeLogistic(scores, scores, count);
+      break;
+    case POST_EVAL_TRANSFORM::SOFTMAX:
+      MlasComputeSoftmax(scores, scores, static_cast<size_t>(num_rows), static_cast<size_t>(num_scores), false, tp);
+      break;
+    case POST_EVAL_TRANSFORM::SOFTMAX_ZERO:
+      for (int64_t i = 0; i < num_rows; ++i)
+        ComputeSoftmaxZero(scores + i * num_scores, static_cast<size_t>(num_scores));
+      break;
+    default:
+    case POST_EVAL_TRANSFORM::NONE:
+      break;
+  }
 }
 
 template <typename T>
@@ -0,0 +1,166 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/ml/tree_ensemble_common.h"
+
+namespace onnxruntime {
+namespace ml {
+
+TreeEnsembleNodes::TreeEnsembleNodes(const OpKernelInfo& info,
+                                     const std::vector<int64_t>& leaf_treeids,
+                                     const std::vector<int64_t>& leaf_nodeids,
+                                     const std::vector<int64_t>& leaf_slots,
+                                     const std::vector<float>& leaf_weights,
+                                     size_t num_slots)
+    : num_slots_(num_slots) {
+  const auto nodes_treeids = info.GetAttrsOrDefault<int64_t>("nodes_treeids");
+  const auto nodes_nodeids = info.GetAttrsOrDefault<int64_t>("nodes_nodeids");
+  const auto nodes_featureids = info.GetAttrsOrDefault<int64_t>("nodes_featureids");
+  const auto nodes_values = info.GetAttrsOrDefault<float>("nodes_values");
+  const auto nodes_hitrates = info.GetAttrsOrDefault<float>("nodes_hitrates");
+  const auto nodes_modes_names = info.GetAttrsOrDefault<std::string>("nodes_modes");
+  const auto nodes_truenodeids = info.GetAttrsOrDefault<int64_t>("nodes_truenodeids");
+  const auto nodes_falsenodeids = info.GetAttrsOrDefault<int64_t>("nodes_falsenodeids");
+  const auto missing_tracks_true = info.GetAttrsOrDefault<int64_t>("nodes_missing_value_tracks_true");
+
+  const size_t num_nodes = nodes_nodeids.size();
+  ORT_ENFORCE(!nodes_treeids.empty());
+  ORT_ENFORCE(num_nodes == nodes_treeids.size());
+  ORT_ENFORCE(num_nodes == nodes_featureids.size());
+  ORT_ENFORCE(num_nodes == nodes_modes_names.size());
+  ORT_ENFORCE(num_nodes == nodes_values.size());
+  ORT_ENFORCE(num_nodes == nodes_truenodeids.size());
+  ORT_ENFORCE(num_nodes == nodes_falsenodeids.size());
+  ORT_ENFORCE((num_nodes == nodes_hitrates.size()) || (nodes_hitrates.empty()));
+  ORT_ENFORCE(num_nodes < std::numeric_limits<uint32_t>::max(), "Too many nodes in the tree ensemble: ", num_nodes);
+  ORT_ENFORCE(leaf_treeids.size() == leaf_nodeids.size());
+  ORT_ENFORCE(leaf_treeids.size() == leaf_slots.size());
+  ORT_ENFORCE(leaf_treeids.size() == leaf_weights.size());
+
+  // in the absence of bool type supported by GetAttrs this ensure that we don't have any negative
+  // values so that we can check for the truth condition without worrying about negative values.
+  ORT_ENFORCE(std::all_of(missing_tracks_true.begin(), missing_tracks_true.end(),
+                          [](int64_t elem) { return elem >= 0; }));
+  // the missing value tracks are ignored unless there is one for every node
+  const bool has_missing_tracks = missing_tracks_true.size() == num_nodes;
+
+  std::vector<NODE_MODE> modes;
+  modes.reserve(num_nodes);
+  for (const auto& mode : nodes_modes_names) {
+    modes.push_back(MakeTreeNodeMode(mode));
+  }
+
+  // node ids are only unique within a tree
+  std::map<std::pair<int64_t, int64_t>, size_t> node_positions;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    node_positions.emplace(std::make_pair(nodes_treeids[i], nodes_nodeids[i]), i);
+  }
+
+  auto find_child = [&](size_t i, int64_t child_id) {
+    auto it = node_positions.find(std::make_pair(nodes_treeids[i], child_id));
+    ORT_ENFORCE(it != node_positions.end(), "Child node ", child_id, " of node ", nodes_nodeids[i],
+                " is not in tree ", nodes_treeids[i]);
+    return it->second;
+  };
+
+  // resolve the children of the branch nodes. the nodes that aren't the child of another node are the roots.
+  std::vector<size_t> true_positions(num_nodes, 0);
+  std::vector<size_t> false_positions(num_nodes, 0);
+  std::vector<bool> has_parent(num_nodes, false);
+  for (size_t i = 0; i < num_nodes; ++i) {
+    if (modes[i] == NODE_MODE::LEAF) continue;
+    true_positions[i] = find_child(i, nodes_truenodeids[i]);
+    false_positions[i] = find_child(i, nodes_falsenodeids[i]);
+    has_parent[true_positions[i]] = true;
+    has_parent[false_positions[i]] = true;
+  }
+
+  // lay out each tree depth first from its root, with the true branch right after its parent
+  const uint32_t unassigned = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> new_index(num_nodes, unassigned);
+  std::vector<size_t> order;
+  order.reserve(num_nodes);
+  std::vector<std::pair<size_t, int64_t>> stack;  // node position and depth
+  int64_t total_leaf_depth = 0;
+  int64_t num_leaves = 0;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    if (has_parent[i]) continue;
+
+    roots_.push_back(static_cast<uint32_t>(order.size()));
+    stack.emplace_back(i, 1);
+    while (!stack.empty()) {
+      const size_t position = stack.back().first;
+      const int64_t depth = stack.back().second;
+      stack.pop_back();
+      if (new_index[position] != unassigned) continue;
+
+      new_index[position] = static_cast<uint32_t>(order.size());
+      order.push_back(position);
+      if (modes[position] == NODE_MODE::LEAF) {
+        total_leaf_depth += depth;
+        ++num_leaves;
+      } else {
+        stack.emplace_back(false_positions[position], depth + 1);
+        stack.emplace_back(true_positions[position], depth + 1);
+      }
+    }
+  }
+
+  if (num_leaves > 0) {
+    average_depth_ = static_cast<double>(total_leaf_depth) / num_leaves;
+  }
+
+  // nodes that can't be reached from a root are never evaluated and are dropped
+  const size_t num_compiled = order.size();
+  modes_.resize(num_compiled);
+  feature_ids_.resize(num_compiled, 0);
+  thresholds_.resize(num_compiled, 0.f);
+  true_ids_.resize(num_compiled, 0);
+  false_ids_.resize(num_compiled, 0);
+  missing_tracks_true_.resize(num_compiled, 0);
+  for (size_t n = 0; n < num_compiled; ++n) {
+    const size_t i = order[n];
+    modes_[n] = modes[i];
+    if (modes[i] == NODE_MODE::LEAF) continue;
+
+    ORT_ENFORCE(nodes_featureids[i] >= 0 && nodes_featureids[i] <= std::numeric_limits<int32_t>::max(),
+                "Invalid feature id ", nodes_featureids[i], " for node ", nodes_nodeids[i], " in tree ",
+                nodes_treeids[i]);
+    feature_ids_[n] = static_cast<int32_t>(nodes_featureids[i]);
+    max_feature_id_ = std::max(max_feature_id_, nodes_featureids[i]);
+    thresholds_[n] = nodes_values[i];
+    true_ids_[n] = new_index[true_positions[i]];
+    false_ids_[n] = new_index[false_positions[i]];
+    missing_tracks_true_[n] = has_missing_tracks && missing_tracks_true[i] != 0;
+  }
+
+  // group the leaf weights by node, keeping the order they were given in
+  std::vector<uint32_t> weight_nodes(leaf_weights.size(), unassigned);
+  weights_begin_.assign(num_compiled + 1, 0);
+  for (size_t w = 0; w < leaf_weights.size(); ++w) {
+    if (leaf_slots[w] < 0) continue;
+    ORT_ENFORCE(static_cast<size_t>(leaf_slots[w]) < num_slots_);
+
+    auto it = node_positions.find(std::make_pair(leaf_treeids[w], leaf_nodeids[w]));
+    if (it == node_positions.end() || new_index[it->second] == unassigned) continue;
+
+    weight_nodes[w] = new_index[it->second];
+    ++weights_begin_[weight_nodes[w] + 1];
+  }
+  for (size_t n = 0; n < num_compiled; ++n) {
+    weights_begin_[n + 1] += weights_begin_[n];
+  }
+
+  std::vector<uint32_t> next_weight(weights_begin_.begin(), weights_begin_.end() - 1);
+  weight_slots_.resize(weights_begin_.back());
+  weight_values_.resize(weights_begin_.back());
+  for (size_t w = 0; w < leaf_weights.size(); ++w) {
+    if (weight_nodes[w] == unassigned) continue;
+    const uint32_t position = next_weight[weight_nodes[w]]++;
+    weight_slots_[position] = static_cast<uint32_t>(leaf_slots[w]);
+    weight_values_[position] = leaf_weights[w];
+  }
+}
+
+}  // namespace ml
+}  // namespace onnxruntime
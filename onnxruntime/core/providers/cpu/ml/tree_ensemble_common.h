@@ -0,0 +1,200 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+#include "ml_common.h"
+
+namespace onnxruntime {
+namespace ml {
+
+// Score of one class (TreeEnsembleClassifier) or target (TreeEnsembleRegressor) for one row, accumulated over the
+// leaf weights that the trees voted for.
+struct TreeEnsembleScore {
+  float sum = 0.f;
+  float min = std::numeric_limits<float>::max();
+  float max = std::numeric_limits<float>::lowest();
+  bool has_score = false;
+
+  void Add(float weight) {
+    sum += weight;
+    min = std::min(min, weight);
+    max = std::max(max, weight);
+    has_score = true;
+  }
+
+  void Merge(const TreeEnsembleScore& other) {
+    if (other.has_score) {
+      sum += other.sum;
+      min = std::min(min, other.min);
+      max = std::max(max, other.max);
+      has_score = true;
+    }
+  }
+};
+
+/*
+The nodes of a tree ensemble compiled for evaluation.
+
+The nodes_* attributes are flattened into contiguous arrays indexed by 32-bit node indices. The nodes of each tree
+are laid out depth first from its root with the true branch first, so the most common path through a tree is
+mostly sequential in memory. Child node ids are resolved once, and the leaf weights of every node are a range of
+the weight arrays, with each weight already mapped to the score (slot) it is added to.
+
+Rows are evaluated in blocks that are walked through one tree at a time, so the nodes of a tree stay in cache
+for the whole block. Batches of rows are split across the thread pool, and when there are too few rows to keep
+the pool busy the trees are split across it instead.
+*/
+class TreeEnsembleNodes {
+ public:
+  // Reads the nodes_* attributes. leaf_slots gives the slot each leaf weight is added to, or -1 to ignore the weight.
+  TreeEnsembleNodes(const OpKernelInfo& info,
+                    const std::vector<int64_t>& leaf_treeids,
+                    const std::vector<int64_t>& leaf_nodeids,
+                    const std::vector<int64_t>& leaf_slots,
+                    const std::vector<float>& leaf_weights,
+                    size_t num_slots);
+
+  size_t NumTrees() const { return roots_.size(); }
+
+  size_t NumSlots() const { return num_slots_; }
+
+  // Rows need at least this many features
+  int64_t NumFeatures() const { return max_feature_id_ + 1; }
+
+  // Adds the leaf weights of every tree for the N rows of x_data to scores, which has NumSlots() scores per row.
+  template <typename T>
+  void ComputeScores(const T* x_data, int64_t stride, int64_t N, TreeEnsembleScore* scores,
+                     concurrency::ThreadPool* tp) const;
+
+ private:
+  template <typename T>
+  uint32_t FindLeaf(uint32_t index, const T* x) const;
+
+  template <typename T>
+  void ScoreTrees(const T* x_data, int64_t stride, int64_t row_begin, int64_t row_end,
+                  size_t tree_begin, size_t tree_end, TreeEnsembleScore* scores) const;
+
+  static constexpr int64_t kMaxTreeDepth = 1000;
+  static constexpr int64_t kRowBlockSize = 64;
+
+  std::vector<NODE_MODE> modes_;
+  std::vector<int32_t> feature_ids_;
+  std::vector<float> thresholds_;
+  std::vector<uint32_t> true_ids_;
+  std::vector<uint32_t> false_ids_;
+  std::vector<uint8_t> missing_tracks_true_;
+
+  // the leaf weights of node i are [weights_begin_[i], weights_begin_[i + 1])
+  std::vector<uint32_t> weights_begin_;
+  std::vector<uint32_t> weight_slots_;
+  std::vector<float> weight_values_;
+
+  std::vector<uint32_t> roots_;
+  size_t num_slots_;
+  int64_t max_feature_id_ = -1;
+  double average_depth_ = 1.0;
+};
+
+template <typename T>
+inline uint32_t TreeEnsembleNodes::FindLeaf(uint32_t index, const T* x) const {
+  // walk down tree to the leaf
+  int64_t loopcount = 0;
+  for (NODE_MODE mode = modes_[index]; mode != NODE_MODE::LEAF; mode = modes_[index]) {
+    const T val = x[feature_ids_[index]];
+    const float threshold = thresholds_[index];
+    bool branch_true;
+    switch (mode) {
+      case NODE_MODE::BRANCH_LEQ:
+        branch_true = val <= threshold;
+        break;
+      case NODE_MODE::BRANCH_LT:
+        branch_true = val < threshold;
+        break;
+      case NODE_MODE::BRANCH_GTE:
+        branch_true = val >= threshold;
+        break;
+      case NODE_MODE::BRANCH_GT:
+        branch_true = val > threshold;
+        break;
+      case NODE_MODE::BRANCH_EQ:
+        branch_true = val == threshold;
+        break;
+      default:
+        branch_true = val != threshold;
+        break;
+    }
+    if (missing_tracks_true_[index] && std::isnan(static_cast<float>(val))) {
+      branch_true = true;
+    }
+    index = branch_true ? true_ids_[index] : false_ids_[index];
+    if (++loopcount > kMaxTreeDepth) break;
+  }
+  return index;
+}
+
+template <typename T>
+void TreeEnsembleNodes::ScoreTrees(const T* x_data, int64_t stride, int64_t row_begin, int64_t row_end,
+                                   size_t tree_begin, size_t tree_end, TreeEnsembleScore* scores) const {
+  for (int64_t block_begin = row_begin; block_begin < row_end; block_begin += kRowBlockSize) {
+    const int64_t block_end = std::min(block_begin + kRowBlockSize, row_end);
+    for (size_t tree = tree_begin; tree < tree_end; ++tree) {
+      const uint32_t root = roots_[tree];
+      for (int64_t row = block_begin; row < block_end; ++row) {
+        const uint32_t leaf = FindLeaf(root, x_data + row * stride);
+        TreeEnsembleScore* row_scores = scores + row * num_slots_;
+        for (uint32_t w = weights_begin_[leaf], end = weights_begin_[leaf + 1]; w < end; ++w) {
+          row_scores[weight_slots_[w]].Add(weight_values_[w]);
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+void TreeEnsembleNodes::ComputeScores(const T* x_data, int64_t stride, int64_t N, TreeEnsembleScore* scores,
+                                      concurrency::ThreadPool* tp) const {
+  const size_t num_trees = roots_.size();
+  const int64_t num_threads = tp != nullptr ? tp->NumThreads() + 1 : 1;
+
+  if (N >= num_threads || num_trees < 2) {
+    // each row walks every tree, roughly 4 cycles per node visited
+    const double cost = static_cast<double>(num_trees) * average_depth_ * 4.0;
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(N),
+        concurrency::TensorOpCost{static_cast<double>(stride * sizeof(T)),
+                                  static_cast<double>(num_slots_ * sizeof(TreeEnsembleScore)), cost},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          ScoreTrees(x_data, stride, first, last, 0, num_trees, scores);
+        });
+    return;
+  }
+
+  // too few rows to split, so split the trees. the first batch adds to scores and the others to their own
+  // partial scores, which are merged in order so the result doesn't depend on the scheduling.
+  const size_t num_batches = std::min(static_cast<size_t>(num_threads), num_trees);
+  std::vector<std::vector<TreeEnsembleScore>> partial_scores(num_batches - 1);
+
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_batches), [&](int32_t batch) {
+    const size_t tree_begin = num_trees * batch / num_batches;
+    const size_t tree_end = num_trees * (batch + 1) / num_batches;
+    TreeEnsembleScore* batch_scores = scores;
+    if (batch > 0) {
+      auto& partial = partial_scores[batch - 1];
+      partial.resize(static_cast<size_t>(N) * num_slots_);
+      batch_scores = partial.data();
+    }
+    ScoreTrees(x_data, stride, 0, N, tree_begin, tree_end, batch_scores);
+  });
+
+  for (const auto& partial : partial_scores) {
+    for (size_t i = 0; i < partial.size(); ++i) {
+      scores[i].Merge(partial[i]);
+    }
+  }
+}
+
+}  // namespace ml
+}  // namespace onnxruntime
@@ -18,8 +18,6 @@
 #include "core/providers/cpu/nn/conv_transpose.h"
 
 #include "core/common/safeint.h"
-#include "core/util/math.h"
-#include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
 
@@ -49,121 +47,50 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
   bool has_bias = dynamic_padding ? num_inputs == 4 : num_inputs == 3;
   ORT_RETURN_IF_ERROR(conv_transpose_attrs_.PrepareForCompute(context, has_bias, p, dynamic_padding));
 
-  const int64_t input_image_size = p.input_shape.Size();
-  const int64_t X_offset = p.num_input_channels / conv_transpose_attrs_.group * input_image_size;
-  const int64_t Y_offset = p.Y->Shape().Size() / p.Y->Shape()[0] / conv_transpose_attrs_.group;
-  const int64_t W_offset = p.F->Shape().Size() / conv_transpose_attrs_.group;
-  const int64_t kernel_size = TensorShape(p.kernel_shape).Size();
-  const int64_t kernel_dim = p.num_output_channels / conv_transpose_attrs_.group * kernel_size;
-  const int64_t output_size = (p.Y->Shape().Slice(2)).Size();
+  // Bail out early if one of the dimensions is zero.
+  if (p.Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const int64_t group = conv_transpose_attrs_.group;
+  const size_t kernel_rank = p.kernel_shape.size();
+  TensorShape output_shape = p.Y->Shape().Slice(2);
+
+  // The transposed convolution runs as a threaded GEMM into a tiled column
+  // buffer that is folded back into the output image, with the bias added
+  // in the same pass.
+  MLAS_CONV_PARAMETERS Parameters;
+  size_t WorkingBufferSize;
+  MlasConvTransposePrepare(&Parameters,
+                           kernel_rank,
+                           static_cast<size_t>(p.N),
+                           static_cast<size_t>(group),
+                           static_cast<size_t>(p.num_input_channels / group),
+                           p.input_shape.GetDims().data(),
+                           p.kernel_shape.data(),
+                           p.dilations.data(),
+                           p.pads.data(),
+                           p.strides.data(),
+                           output_shape.GetDims().data(),
+                           static_cast<size_t>(p.num_output_channels / group),
+                           &activation_,
+                           &WorkingBufferSize,
+                           thread_pool);
 
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
-  const int64_t col_buffer_size = kernel_dim * p.input_shape.Size();
-  auto col_data = alloc->Alloc(SafeInt<size_t>(sizeof(T)) * col_buffer_size);
-  BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
-  T* col_buffer_data = static_cast<T*>(col_buffer.get());
-
-  const T* Xdata = p.X->template Data<T>();
-  const T* filter_data = p.F->template Data<T>();
-  T* Ydata = p.Y->template MutableData<T>();
-
-  std::vector<int64_t> col_buffer_shape{kernel_dim};
-  col_buffer_shape.insert(col_buffer_shape.end(), p.input_shape.GetDims().begin(), p.input_shape.GetDims().end());
-
-  if (p.X->Shape().NumDimensions() == 4) {
-    for (auto image_id = 0; image_id < p.N; ++image_id) {
-      for (int group_id = 0; group_id < conv_transpose_attrs_.group; ++group_id) {
-        // Weight term
-        math::Gemm<T>(
-            CblasTrans,
-            CblasNoTrans,
-            kernel_dim,
-            input_image_size,
-            p.num_input_channels / conv_transpose_attrs_.group,
-            1,
-            filter_data + group_id * W_offset,
-            Xdata + group_id * X_offset,
-            0,
-            col_buffer_data,
-            thread_pool);
-
-        // Col2im
-        math::Col2im<T, CPUMathUtil, StorageOrder::NCHW>(
-            col_buffer_data,
-            p.num_output_channels / conv_transpose_attrs_.group,
-            p.Y->Shape()[2],
-            p.Y->Shape()[3],
-            p.kernel_shape[0],
-            p.kernel_shape[1],
-            p.dilations[0],
-            p.dilations[1],
-            p.pads[0],
-            p.pads[1],
-            p.pads[2],
-            p.pads[3],
-            p.strides[0],
-            p.strides[1],
-            Ydata + group_id * Y_offset,
-            &CPUMathUtil::Instance());
-      }
-
-      if (p.B != nullptr) {
-        auto Ymatrix = EigenMatrixMap<T>(Ydata, output_size, p.num_output_channels);
-        auto Bvec = ConstEigenVectorMap<T>(p.B->template Data<T>(), p.num_output_channels);
-        Ymatrix.rowwise() += Bvec.transpose();
-      }
-
-      Xdata += X_offset * conv_transpose_attrs_.group;
-      Ydata += Y_offset * conv_transpose_attrs_.group;
-    }
-  } else {
-    TensorShape output_shape = p.Y->Shape().Slice(1);
-    output_shape[0] = output_shape[0] / conv_transpose_attrs_.group;
-
-    for (auto image_id = 0; image_id < p.N; ++image_id) {
-      for (int group_id = 0; group_id < conv_transpose_attrs_.group; ++group_id) {
-        // Weight term
-        math::Gemm<T>(
-            CblasTrans,
-            CblasNoTrans,
-            kernel_dim,
-            input_image_size,
-            p.num_input_channels / conv_transpose_attrs_.group,
-            1,
-            filter_data + group_id * W_offset,
-            Xdata + group_id * X_offset,
-            0,
-            col_buffer_data,
-            thread_pool);
-
-        // Col2im
-        math::Col2imNd<T, CPUMathUtil, StorageOrder::NCHW>(
-            col_buffer_data,
-            output_shape.GetDims().data(),
-            col_buffer_shape.data(),
-            output_shape.Size(),
-            col_buffer_size,
-            p.kernel_shape.data(),
-            p.strides.data(),
-            p.dilations.data(),
-            p.pads.data(),
-            static_cast<int>(p.kernel_shape.size()),
-            Ydata + group_id * Y_offset,
-            &CPUMathUtil::Instance());
-      }
-
-      if (p.B != nullptr) {
-        auto Ymatrix = EigenMatrixMap<T>(Ydata, output_size, p.num_output_channels);
-        auto Bvec = ConstEigenVectorMap<T>(p.B->template Data<T>(), p.num_output_channels);
-        Ymatrix.rowwise() += Bvec.transpose();
-      }
-
-      Xdata += X_offset * conv_transpose_attrs_.group;
-      Ydata += Y_offset * conv_transpose_attrs_.group;
-    }
-  }
+  auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(SafeInt<size_t>(sizeof(T)) * WorkingBufferSize)
+                                             : nullptr;
+  BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
+
+  MlasConvTranspose(&Parameters,
+                    p.X->template Data<T>(),
+                    p.F->template Data<T>(),
+                    p.B != nullptr ? p.B->template Data<T>() : nullptr,
+                    static_cast<T*>(working_buffer.get()),
+                    p.Y->template MutableData<T>(),
+                    thread_pool);
 
   return Status::OK();
 }
@@ -19,19 +19,25 @@
 
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/nn/conv_transpose_attributes.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
 template <typename T>
 class ConvTranspose : public OpKernel {
  public:
-  ConvTranspose(const OpKernelInfo& info) : OpKernel(info), conv_transpose_attrs_(info) {}
+  ConvTranspose(const OpKernelInfo& info) : OpKernel(info), conv_transpose_attrs_(info) {
+    activation_.ActivationKind = MlasIdentityActivation;
+  }
 
   Status Compute(OpKernelContext* context) const override;
 
  protected:
   Status DoConvTranspose(OpKernelContext* context, bool dynamic_padding) const;
 
+  // set by the fused ConvTranspose kernel; applied together with the bias as the output is folded back
+  MLAS_ACTIVATION activation_;
+
  private:
   ConvTransposeAttributes conv_transpose_attrs_;
 };
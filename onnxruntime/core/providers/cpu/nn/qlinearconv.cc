@@ -4,9 +4,11 @@
 #include "core/providers/cpu/nn/qlinearconv.h"
 
 #include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/common.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
+#include "core/util/qmath.h"
 
 namespace onnxruntime {
 ONNX_OPERATOR_KERNEL_EX(
@@ -21,9 +23,144 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T4", DataTypeImpl::GetTensorType<int32_t>()),
     QLinearConv);
 
+namespace {
+
+// Target size of the im2col tile of one work item. The tile, the int32 accumulators of the output channels and
+// the filter stay in the cache between the expansion, the GEMM and the requantization.
+constexpr int64_t kQLinearConvColumnTileBytes = 64 * 1024;
+constexpr int64_t kQLinearConvMinimumOutputTile = 16;
+
+// Expands the output pixels [output_start, output_start + output_count) of one group of an image into a
+// (kernel_dim x output_count) column tile. Padded positions read the input zero point so that they don't
+// contribute to the accumulators.
+void Im2colTile(const uint8_t* input,
+                int64_t kernel_dim,
+                const std::vector<int64_t>& input_shape,
+                const std::vector<int64_t>& output_shape,
+                const std::vector<int64_t>& kernel_shape,
+                const std::vector<int64_t>& strides,
+                const std::vector<int64_t>& dilations,
+                const std::vector<int64_t>& pads,
+                int64_t output_start,
+                int64_t output_count,
+                uint8_t padding_value,
+                uint8_t* col) {
+  const size_t rank = kernel_shape.size();
+  const int64_t input_image_size = TensorShape(input_shape).Size();
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+
+  std::vector<int64_t> output_start_coords(rank);
+  for (size_t d = rank; d > 0; d--) {
+    output_start_coords[d - 1] = output_start % output_shape[d - 1];
+    output_start /= output_shape[d - 1];
+  }
+
+  std::vector<int64_t> kernel_coords(rank);
+  std::vector<int64_t> output_coords(rank);
+
+  for (int64_t row = 0; row < kernel_dim; row++) {
+    const uint8_t* input_channel = input + (row / kernel_size) * input_image_size;
+
+    int64_t kernel_index = row % kernel_size;
+    for (size_t d = rank; d > 0; d--) {
+      kernel_coords[d - 1] = (kernel_index % kernel_shape[d - 1]) * dilations[d - 1] - pads[d - 1];
+      kernel_index /= kernel_shape[d - 1];
+    }
+
+    output_coords = output_start_coords;
+
+    for (int64_t p = 0; p < output_count; p++) {
+      int64_t offset = 0;
+      bool is_padding = false;
+      for (size_t d = 0; d < rank; d++) {
+        const int64_t input_coord = output_coords[d] * strides[d] + kernel_coords[d];
+        if (static_cast<uint64_t>(input_coord) >= static_cast<uint64_t>(input_shape[d])) {
+          is_padding = true;
+          break;
+        }
+        offset = offset * input_shape[d] + input_coord;
+      }
+      col[p] = is_padding ? padding_value : input_channel[offset];
+
+      for (size_t d = rank; d > 0; d--) {
+        if (++output_coords[d - 1] < output_shape[d - 1]) {
+          break;
+        }
+        output_coords[d - 1] = 0;
+      }
+    }
+
+    col += output_count;
+  }
+}
+
+}  // namespace
+
+Status QLinearConv::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // The filter is matrix A of the GEMM of each group, so pack the rows of every group once so that each call to
+  // Compute skips the packing that the QGEMM would otherwise repeat for every output tile.
+  if (input_idx == 3) {
+    const TensorShape& w_shape = tensor.Shape();
+    if (w_shape.NumDimensions() < 3 || w_shape[0] == 0 || w_shape[0] % conv_attrs_.group != 0) {
+      return Status::OK();
+    }
+
+    const int64_t group_count = conv_attrs_.group;
+    const int64_t group_output_channels = w_shape[0] / group_count;
+    const int64_t kernel_dim = w_shape.SizeFromDimension(1);
+
+    packed_w_group_size_ = QGemmPackASize(static_cast<int>(group_output_channels), static_cast<int>(kernel_dim),
+                                          false);
+    if (packed_w_group_size_ == 0) {
+      return Status::OK();
+    }
+    w_shape_ = w_shape;
+
+    const size_t packed_w_size = SafeInt<size_t>(packed_w_group_size_) * group_count;
+    auto* packed_w_data = static_cast<uint8_t*>(alloc->Alloc(packed_w_size));
+    packed_w_ = BufferUniquePtr(packed_w_data, BufferDeleter(alloc));
+
+    // Clear the buffer so that any padding is deterministic, as packed buffers
+    // are compared by content when shared between sessions.
+    memset(packed_w_data, 0, packed_w_size);
+
+    const auto* w_data = tensor.Data<uint8_t>();
+    for (int64_t group_id = 0; group_id < group_count; group_id++) {
+      QGemmPackA(static_cast<int>(group_output_channels), static_cast<int>(kernel_dim),
+                 w_data + group_id * group_output_channels * kernel_dim, static_cast<int>(kernel_dim), false,
+                 packed_w_data + group_id * packed_w_group_size_);
+    }
+
+    is_packed = true;
+    if (prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(packed_w_));
+      prepacked_weights->buffer_sizes_.push_back(packed_w_size);
+    }
+  }
+
+  return Status::OK();
+}
+
+Status QLinearConv::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 3) {
+    used_shared_buffers = true;
+    packed_w_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status QLinearConv::Compute(OpKernelContext* context) const {
   const auto* X = context->Input<Tensor>(0);
-  const auto* W = context->Input<Tensor>(3);
+  // the original filter is released once it has been packed
+  const auto* W = packed_w_ ? nullptr : context->Input<Tensor>(3);
+  const TensorShape& W_shape = packed_w_ ? w_shape_ : W->Shape();
 
   // validate offsets
   auto input_offset = context->Input<Tensor>(2);
@@ -36,25 +173,32 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
   ORT_ENFORCE(IsScalarOr1ElementVector(result_offset),
               "QLinearConv : result zero point must be a scalar or 1D tensor of size 1");
 
+  const int64_t N = X->Shape()[0];
+  const int64_t C = X->Shape()[1];
+  const int64_t M = W_shape[0];
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape));
+
   // validate scale
   auto input_scale = context->Input<Tensor>(1);
   auto filter_scale = context->Input<Tensor>(4);
   auto result_scale = context->Input<Tensor>(6);
   ORT_ENFORCE(IsScalarOr1ElementVector(input_scale),
               "QLinearConv : input scale must be a scalar or 1D tensor of size 1");
-  ORT_ENFORCE(IsScalarOr1ElementVector(filter_scale),
-              "QLinearConv : filter scale must be a scalar or 1D tensor of size 1");
+  ORT_ENFORCE(IsScalarOr1ElementVector(filter_scale) ||
+                  (filter_scale->Shape().NumDimensions() == 1 && filter_scale->Shape()[0] == M),
+              "QLinearConv : filter scale must be a scalar or 1D tensor of size 1 or M");
   ORT_ENFORCE(IsScalarOr1ElementVector(result_scale),
               "QLinearConv : result scale must be a scalar or 1D tensor of size 1");
 
-  auto input_scale_data = *(input_scale->template Data<float>());
-  auto filter_scale_data = *(filter_scale->template Data<float>());
-  auto result_scale_data = *(result_scale->template Data<float>());
-
-  const float real_multiplier = (input_scale_data * filter_scale_data) / result_scale_data;
-  int32_t integer_multiplier;
-  int right_shift;
-  QuantizeMultiplier(real_multiplier, &integer_multiplier, &right_shift);
+  // The accumulators are requantized with the real multiplier (input_scale * filter_scale) / result_scale, which
+  // is per output channel when the filter is quantized per channel.
+  const float input_scale_data = *(input_scale->template Data<float>());
+  const float result_scale_data = *(result_scale->template Data<float>());
+  const bool per_channel_scale = !IsScalarOr1ElementVector(filter_scale);
+  std::vector<float> output_scales(per_channel_scale ? static_cast<size_t>(M) : 1);
+  for (size_t i = 0; i < output_scales.size(); i++) {
+    output_scales[i] = (input_scale_data * filter_scale->template Data<float>()[i]) / result_scale_data;
+  }
 
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* bias = nullptr;
@@ -62,13 +206,8 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
     bias = context->Input<Tensor>(8);
   }
 
-  const int64_t N = X->Shape()[0];
-  const int64_t C = X->Shape()[1];
-  const int64_t M = W->Shape()[0];
-  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
-
   std::vector<int64_t> kernel_shape;
-  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
 
   std::vector<int64_t> pads(conv_attrs_.pads);
   if (pads.empty()) {
@@ -90,87 +229,128 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
   Tensor* Y = context->Output(0, TensorShape(Y_dims));
   TensorShape output_shape = Y->Shape().Slice(2);
 
+  // Bail out early if one of the dimensions is zero.
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
   const auto* Xdata = X->template Data<uint8_t>();
+  const auto* Wdata = W == nullptr ? nullptr : W->template Data<uint8_t>();
+  const auto* packed_Wdata = static_cast<const uint8_t*>(packed_w_.get());
+  const auto* Bdata = bias == nullptr ? nullptr : bias->template Data<int32_t>();
   auto* Ydata = Y->template MutableData<uint8_t>();
 
+  const uint8_t input_zero_point = *input_offset->template Data<uint8_t>();
+  const uint8_t filter_zero_point = *filter_offset->template Data<uint8_t>();
+  const uint8_t result_zero_point = *result_offset->template Data<uint8_t>();
+
+  const int64_t group_count = conv_attrs_.group;
+  const int64_t group_input_channels = C / group_count;
+  const int64_t group_output_channels = M / group_count;
   const int64_t input_image_size = input_shape.Size();
   const int64_t output_image_size = output_shape.Size();
   const int64_t kernel_size = TensorShape(kernel_shape).Size();
-  const int64_t X_offset = C / conv_attrs_.group * input_image_size;
-  const int64_t Y_offset = Y->Shape().Size() / Y->Shape()[0] / conv_attrs_.group;
-  const int64_t W_offset = W->Shape().Size() / conv_attrs_.group;
-  const int64_t kernel_dim = C / conv_attrs_.group * kernel_size;
-  const int64_t col_buffer_size = kernel_dim * output_image_size;
-  const int bias_offset = static_cast<int>(M / conv_attrs_.group);
-
-  auto col_data = alloc->Alloc(SafeInt<size_t>(sizeof(uint8_t)) * col_buffer_size);
-  BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
-  auto* col_buffer_data = static_cast<uint8_t*>(col_buffer.get());
-
-  TensorShape image_shape = X->Shape().Slice(1);
-  std::vector<int64_t> col_buffer_shape{kernel_dim};
-  col_buffer_shape.insert(col_buffer_shape.end(), output_shape.GetDims().begin(),
-                          output_shape.GetDims().end());
-
-  const size_t kernel_rank = kernel_shape.size();
-
-  for (int image_id = 0; image_id < N; ++image_id) {
-    for (int group_id = 0; group_id < conv_attrs_.group; ++group_id) {
-      if (kernel_rank == 2) {
-        math::Im2col<uint8_t, StorageOrder::NCHW>()(
-            Xdata + group_id * X_offset,
-            C / conv_attrs_.group,
-            input_shape[0],
-            input_shape[1],
-            kernel_shape[0],
-            kernel_shape[1],
-            dilations[0],
-            dilations[1],
-            pads[0],
-            pads[1],
-            pads[2],
-            pads[3],
-            strides[0],
-            strides[1],
-            col_buffer_data,
-            *input_offset->template Data<uint8_t>());
+  const int64_t kernel_dim = group_input_channels * kernel_size;
+
+  // Pointwise convolutions read the input tensor in place, otherwise each work item expands its output tile
+  // into a private column buffer.
+  const bool is_pointwise = kernel_size == 1 && conv_attrs_.HasStridesOneAndNoPadding();
+
+  int64_t output_tile = std::max(kQLinearConvColumnTileBytes / kernel_dim, kQLinearConvMinimumOutputTile);
+  output_tile = std::min((output_tile + kQLinearConvMinimumOutputTile - 1) & ~(kQLinearConvMinimumOutputTile - 1),
+                         output_image_size);
+  const int64_t tiles_per_image = (output_image_size + output_tile - 1) / output_tile;
+  const int64_t total_work = N * group_count * tiles_per_image;
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+  const int64_t num_threads = thread_pool == nullptr ? 1 : thread_pool->NumThreads() + 1;
+  const int64_t degree_of_parallelism = std::min(num_threads, total_work);
+
+  // Each worker's column buffer and int32 accumulators start on the alignment MLAS prefers for its buffers.
+  const int64_t buffer_alignment = static_cast<int64_t>(MlasGetPreferredBufferAlignment());
+  auto align_buffer_size = [buffer_alignment](int64_t size) {
+    return (size + buffer_alignment - 1) & ~(buffer_alignment - 1);
+  };
+  const int64_t col_buffer_size = is_pointwise ? 0 : align_buffer_size(kernel_dim * output_tile);
+  const int64_t worker_buffer_size =
+      col_buffer_size + align_buffer_size(group_output_channels * output_tile * sizeof(int32_t));
+  auto worker_data = alloc->Alloc(SafeInt<size_t>(worker_buffer_size) * degree_of_parallelism);
+  BufferUniquePtr worker_buffer(worker_data, BufferDeleter(alloc));
+
+  const std::vector<int64_t>& input_dims = input_shape.GetDims();
+  const std::vector<int64_t>& output_dims = output_shape.GetDims();
+
+  concurrency::ThreadPool::TryParallelFor(thread_pool, static_cast<int32_t>(degree_of_parallelism), [&](int32_t worker) {
+    // Partition the (image, group, output tile) work items evenly across the workers.
+    const int64_t work_per_worker = total_work / degree_of_parallelism;
+    const int64_t work_extra = total_work % degree_of_parallelism;
+    int64_t work_index = worker * work_per_worker + std::min<int64_t>(worker, work_extra);
+    const int64_t work_end = work_index + work_per_worker + (worker < work_extra ? 1 : 0);
+
+    uint8_t* col_data = static_cast<uint8_t*>(worker_data) + worker * worker_buffer_size;
+    int32_t* accumulator_data = reinterpret_cast<int32_t*>(col_data + col_buffer_size);
+
+    for (; work_index < work_end; work_index++) {
+      const int64_t image_group = work_index / tiles_per_image;
+      const int64_t output_start = (work_index % tiles_per_image) * output_tile;
+      const int64_t output_count = std::min(output_tile, output_image_size - output_start);
+      const int64_t image_id = image_group / group_count;
+      const int64_t group_id = image_group % group_count;
+      const int64_t output_channel = group_id * group_output_channels;
+
+      const uint8_t* input_data = Xdata + (image_id * C + group_id * group_input_channels) * input_image_size;
+      const uint8_t* gemm_b = input_data + output_start;
+      int64_t ldb = input_image_size;
+
+      if (!is_pointwise) {
+        Im2colTile(input_data, kernel_dim, input_dims, output_dims, kernel_shape, strides, dilations, pads,
+                   output_start, output_count, input_zero_point, col_data);
+        gemm_b = col_data;
+        ldb = output_count;
+      }
+
+      if (packed_Wdata != nullptr) {
+        QGemmu8u8_s32(static_cast<int>(group_output_channels),
+                      static_cast<int>(output_count),
+                      static_cast<int>(kernel_dim),
+                      packed_Wdata + group_id * packed_w_group_size_,
+                      filter_zero_point,
+                      gemm_b,
+                      static_cast<int>(ldb),
+                      input_zero_point,
+                      accumulator_data,
+                      static_cast<int>(output_count),
+                      nullptr);
       } else {
-        math::Im2colNd<uint8_t, StorageOrder::NCHW>()(
-            Xdata + group_id * X_offset,
-            image_shape.GetDims().data(),
-            col_buffer_shape.data(),
-            C * input_image_size,
-            col_buffer_size,
-            kernel_shape.data(),
-            strides.data(),
-            dilations.data(),
-            pads.data(),
-            static_cast<int>(kernel_shape.size()),
-            col_buffer_data,
-            false,
-            *input_offset->template Data<uint8_t>());
+        QGemmu8u8_s32(static_cast<int>(group_output_channels),
+                      static_cast<int>(output_count),
+                      static_cast<int>(kernel_dim),
+                      Wdata + output_channel * kernel_dim,
+                      static_cast<int>(kernel_dim),
+                      filter_zero_point,
+                      gemm_b,
+                      static_cast<int>(ldb),
+                      input_zero_point,
+                      accumulator_data,
+                      static_cast<int>(output_count),
+                      nullptr);
       }
 
-      GemmlowpMultiplyu8u8_u8(W->template Data<uint8_t>() + group_id * W_offset,
-                              col_buffer_data,
-                              Ydata + group_id * Y_offset,
-                              *filter_offset->template Data<uint8_t>(),
-                              *input_offset->template Data<uint8_t>(),
-                              *result_offset->template Data<uint8_t>(),
-                              static_cast<int>(M / conv_attrs_.group),
-                              static_cast<int>(output_image_size),
-                              static_cast<int>(kernel_dim),
-                              integer_multiplier,
-                              right_shift,
-                              bias == nullptr ? nullptr : bias->template Data<int32_t>() + group_id * bias_offset);
+      MlasRequantizeOutput(accumulator_data,
+                           static_cast<size_t>(output_count),
+                           Ydata + (image_id * M + output_channel) * output_image_size + output_start,
+                           static_cast<size_t>(output_image_size),
+                           Bdata == nullptr ? nullptr : Bdata + output_channel,
+                           output_scales.data() + (per_channel_scale ? output_channel : 0),
+                           per_channel_scale,
+                           result_zero_point,
+                           static_cast<size_t>(group_output_channels),
+                           static_cast<size_t>(output_count));
     }
-
-    Xdata += X_offset * conv_attrs_.group;
-    Ydata += Y_offset * conv_attrs_.group;
-  }
+  });
 
   return Status::OK();
 }
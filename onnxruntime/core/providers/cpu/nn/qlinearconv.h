@@ -4,8 +4,8 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/framework/prepacked_weights.h"
 #include "core/providers/cpu/nn/conv_attributes.h"
-#include "core/util/gemmlowp_common.h"
 
 namespace onnxruntime {
 class QLinearConv : public OpKernel {
@@ -13,8 +13,20 @@ class QLinearConv : public OpKernel {
   explicit QLinearConv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
   ConvAttributes conv_attrs_;
+
+ private:
+  // The filter is packed once by PrePack when it is a constant initializer, one packed matrix per group.
+  TensorShape w_shape_;
+  BufferUniquePtr packed_w_;
+  size_t packed_w_group_size_ = 0;
 };
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/cpu/containers.h"
+#include "core/platform/threadpool.h"
 using namespace std;
 namespace onnxruntime {
 
@@ -119,11 +120,50 @@ REGISTER_UNARY_ELEMENTWISE_KERNEL(ArgMax, 11);
 REGISTER_UNARY_ELEMENTWISE_VERSIONED_KERNEL(ArgMin, 1, 10);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ArgMin, 11);
 
-// When all reduce axises located at the tail of the dims, quite general cases, transpose and extra
-// copy could be skipped to improve performance, if required by check_no_transpose = true;
-// return value: true means transposedInputData is not created/copied, input tensor data could
-//               be direct use as row major matrix [block_size, blocks], where blocks is the
-//               size of each reduce.
+// The input of a reduction viewed as a row major [outer, reduced, inner] tensor, where the middle axis is reduced.
+// This is possible when the reduced axes are adjacent once the dims with value 1 are ignored, which covers
+// reducing the last axes, the leading axes, all axes, or a block of axes in the middle.
+struct FastReduceShape {
+  int64_t outer;
+  int64_t reduced;
+  int64_t inner;
+};
+
+// Returns false if the reduced axes aren't adjacent.
+static bool GetFastReduceShape(const std::vector<int64_t>& input_dims, const vector<bool>& keep_axis,
+                               FastReduceShape& fast_shape) {
+  fast_shape = {1, 1, 1};
+  bool seen_reduced = false;
+  bool seen_inner = false;
+  for (size_t i = 0; i < input_dims.size(); ++i) {
+    const auto dim = input_dims[i];
+    if (dim == 1) {
+      continue;
+    }
+
+    if (!keep_axis[i]) {
+      if (seen_inner) {
+        return false;
+      }
+      seen_reduced = true;
+      fast_shape.reduced *= dim;
+    } else if (seen_reduced) {
+      seen_inner = true;
+      fast_shape.inner *= dim;
+    } else {
+      fast_shape.outer *= dim;
+    }
+  }
+
+  return true;
+}
+
+// When the reduced axes are adjacent, quite general cases, transpose and extra copy can be skipped
+// if fast_shape is provided.
+// return value: true means transposedInputData is not created/copied, and the input tensor data can
+//               be used directly with the layout described by fast_shape.
+//               false means transposedInputData holds the input as a row major matrix [blocks, block_size],
+//               where blocks is the size of each reduce.
 template <typename T>
 bool PrepareForReduce(OpKernelContext* ctx,
                       FastAllocVector<T>& transposedInputData,
@@ -132,7 +172,7 @@ bool PrepareForReduce(OpKernelContext* ctx,
                       int64_t& blocks,
                       const std::vector<int64_t>& axes_,
                       bool keepdims_,
-                      bool check_no_transpose = false) {
+                      FastReduceShape* fast_shape = nullptr) {
   const auto* input_tensor_ptr = ctx->Input<Tensor>(0);
   ORT_ENFORCE(input_tensor_ptr != nullptr);
   const Tensor& input = *input_tensor_ptr;
@@ -153,14 +193,6 @@ bool PrepareForReduce(OpKernelContext* ctx,
 
   std::sort(axes.begin(), axes.end());
 
-  // If all reduced axes are located at the tail of the input shape, then copy could be skipped is required
-  bool need_copy = true;
-  if (axes.size() <= ndim &&
-      axes.front() == static_cast<int64_t>(ndim - axes.size()) &&
-      axes.back() == static_cast<int64_t>(ndim) - 1) {
-    need_copy = false;
-  }
-
   vector<bool> keep_axis(ndim, true);
   for (auto i : axes) {
     keep_axis[i] = false;
@@ -236,7 +268,7 @@ bool PrepareForReduce(OpKernelContext* ctx,
   block_size = num_elements / first_dim;
   blocks = first_dim;
 
-  if (!need_copy && check_no_transpose) {
+  if (fast_shape != nullptr && GetFastReduceShape(in_dims, keep_axis, *fast_shape)) {
     return true;
   }
 
@@ -306,58 +338,226 @@ bool PrepareForReduce(OpKernelContext* ctx,
   return false;
 }
 
+// Aggregators used by FastReduce. Reduce returns the value of n contiguous elements before Finalize, and Merge
+// combines two such values. Init and Update accumulate n elements of one row of the reduced axis into n outputs.
+// Finalize converts the accumulated values into the outputs of the reduction of reduced_size elements.
 template <typename T>
-Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+struct ReduceAggregatorSum {
+  static T Reduce(const T* data, int64_t n) { return ConstEigenVectorArrayMap<T>(data, n).sum(); }
+  static T Merge(T a, T b) { return a + b; }
+  static void Init(T* out, const T* row, int64_t n) {
+    EigenVectorArrayMap<T>(out, n) = ConstEigenVectorArrayMap<T>(row, n);
+  }
+  static void Update(T* out, const T* row, int64_t n) {
+    EigenVectorArrayMap<T>(out, n) += ConstEigenVectorArrayMap<T>(row, n);
+  }
+  static void Finalize(T* /*out*/, int64_t /*n*/, int64_t /*reduced_size*/) {}
+};
 
-  T* output_data = reduced->template MutableData<T>();
+template <typename T>
+struct ReduceAggregatorMean : ReduceAggregatorSum<T> {
+  static void Finalize(T* out, int64_t n, int64_t reduced_size) {
+    EigenVectorArrayMap<T>(out, n) /= static_cast<T>(reduced_size);
+  }
+};
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).cwiseAbs().rowwise().sum();
+template <typename T>
+struct ReduceAggregatorLogSum : ReduceAggregatorSum<T> {
+  static void Finalize(T* out, int64_t n, int64_t /*reduced_size*/) {
+    for (int64_t i = 0; i < n; ++i) {
+      out[i] = static_cast<T>(std::log(out[i]));
+    }
+  }
+};
 
-  return Status::OK();
-}
+template <typename T>
+struct ReduceAggregatorSumSquare {
+  static T Reduce(const T* data, int64_t n) { return ConstEigenVectorArrayMap<T>(data, n).square().sum(); }
+  static T Merge(T a, T b) { return a + b; }
+  static void Init(T* out, const T* row, int64_t n) {
+    EigenVectorArrayMap<T>(out, n) = ConstEigenVectorArrayMap<T>(row, n).square();
+  }
+  static void Update(T* out, const T* row, int64_t n) {
+    EigenVectorArrayMap<T>(out, n) += ConstEigenVectorArrayMap<T>(row, n).square();
+  }
+  static void Finalize(T* /*out*/, int64_t /*n*/, int64_t /*reduced_size*/) {}
+};
 
 template <typename T>
-Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+struct ReduceAggregatorL2 : ReduceAggregatorSumSquare<T> {
+  static void Finalize(T* out, int64_t n, int64_t /*reduced_size*/) {
+    for (int64_t i = 0; i < n; ++i) {
+      out[i] = static_cast<T>(std::sqrt(out[i]));
+    }
+  }
+};
 
-  T* output_data = reduced->template MutableData<T>();
+template <typename T>
+struct ReduceAggregatorL1 {
+  static T Reduce(const T* data, int64_t n) { return ConstEigenVectorArrayMap<T>(data, n).abs().sum(); }
+  static T Merge(T a, T b) { return a + b; }
+  static void Init(T* out, const T* row, int64_t n) {
+    EigenVectorArrayMap<T>(out, n) = ConstEigenVectorArrayMap<T>(row, n).abs();
+  }
+  static void Update(T* out, const T* row, int64_t n) {
+    EigenVectorArrayMap<T>(out, n) += ConstEigenVectorArrayMap<T>(row, n).abs();
+  }
+  static void Finalize(T* /*out*/, int64_t /*n*/, int64_t /*reduced_size*/) {}
+};
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().norm();
+template <typename T>
+struct ReduceAggregatorProd {
+  static T Reduce(const T* data, int64_t n) { return ConstEigenVectorArrayMap<T>(data, n).prod(); }
+  static T Merge(T a, T b) { return a * b; }
+  static void Init(T* out, const T* row, int64_t n) {
+    EigenVectorArrayMap<T>(out, n) = ConstEigenVectorArrayMap<T>(row, n);
+  }
+  static void Update(T* out, const T* row, int64_t n) {
+    EigenVectorArrayMap<T>(out, n) *= ConstEigenVectorArrayMap<T>(row, n);
+  }
+  static void Finalize(T* /*out*/, int64_t /*n*/, int64_t /*reduced_size*/) {}
+};
 
-  return Status::OK();
-}
+template <typename T>
+struct ReduceAggregatorMax {
+  static T Reduce(const T* data, int64_t n) { return ConstEigenVectorArrayMap<T>(data, n).maxCoeff(); }
+  static T Merge(T a, T b) { return std::max(a, b); }
+  static void Init(T* out, const T* row, int64_t n) {
+    EigenVectorArrayMap<T>(out, n) = ConstEigenVectorArrayMap<T>(row, n);
+  }
+  static void Update(T* out, const T* row, int64_t n) {
+    EigenVectorArrayMap<T> out_arr(out, n);
+    out_arr = out_arr.max(ConstEigenVectorArrayMap<T>(row, n));
+  }
+  static void Finalize(T* /*out*/, int64_t /*n*/, int64_t /*reduced_size*/) {}
+};
 
 template <typename T>
-Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
+struct ReduceAggregatorMin {
+  static T Reduce(const T* data, int64_t n) { return ConstEigenVectorArrayMap<T>(data, n).minCoeff(); }
+  static T Merge(T a, T b) { return std::min(a, b); }
+  static void Init(T* out, const T* row, int64_t n) {
+    EigenVectorArrayMap<T>(out, n) = ConstEigenVectorArrayMap<T>(row, n);
+  }
+  static void Update(T* out, const T* row, int64_t n) {
+    EigenVectorArrayMap<T> out_arr(out, n);
+    out_arr = out_arr.min(ConstEigenVectorArrayMap<T>(row, n));
+  }
+  static void Finalize(T* /*out*/, int64_t /*n*/, int64_t /*reduced_size*/) {}
+};
+
+// Reduces the middle axis of the row major [outer, reduced, inner] input, splitting the work across the thread pool.
+template <typename T, typename AGG>
+void FastReduce(const T* input, T* output, const FastReduceShape& shape, concurrency::ThreadPool* tp) {
+  const int64_t outer = shape.outer;
+  const int64_t reduced = shape.reduced;
+  const int64_t inner = shape.inner;
+
+  // cost of computing one output
+  const concurrency::TensorOpCost cost{static_cast<double>(reduced * sizeof(T)), static_cast<double>(sizeof(T)),
+                                       static_cast<double>(reduced)};
+
+  if (inner > 1) {
+    // the units are the outputs. a block of them accumulates one row of the reduced axis at a time, so the loads
+    // and stores are contiguous and vectorized.
+    concurrency::ThreadPool::TryParallelFor(tp, outer * inner, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (int64_t o = first / inner; o * inner < last; ++o) {
+        const int64_t begin = std::max<int64_t>(first, o * inner) - o * inner;
+        const int64_t end = std::min<int64_t>(last, (o + 1) * inner) - o * inner;
+        const T* in = input + o * reduced * inner + begin;
+        T* out = output + o * inner + begin;
+
+        AGG::Init(out, in, end - begin);
+        for (int64_t r = 1; r < reduced; ++r) {
+          AGG::Update(out, in + r * inner, end - begin);
+        }
+        AGG::Finalize(out, end - begin, reduced);
+      }
+    });
+    return;
+  }
+
+  // each output reduces a contiguous row. when there are fewer rows than threads, e.g. when reducing all axes,
+  // the rows are split in parts that are reduced in parallel and merged afterwards.
+  const int64_t num_threads = tp == nullptr ? 1 : tp->NumThreads() + 1;
+  int64_t num_parts = outer >= num_threads ? 1 : (num_threads + outer - 1) / outer;
+  if (num_parts == 1 || reduced < num_parts) {
+    concurrency::ThreadPool::TryParallelFor(tp, outer, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t o = first; o < last; ++o) {
+        output[o] = AGG::Reduce(input + o * reduced, reduced);
+      }
+      AGG::Finalize(output + first, last - first, reduced);
+    });
+    return;
+  }
+
+  // make sure every part is non empty
+  const int64_t part_size = (reduced + num_parts - 1) / num_parts;
+  num_parts = (reduced + part_size - 1) / part_size;
+
+  std::vector<T> partial_results(outer * num_parts);
+  const concurrency::TensorOpCost part_cost{static_cast<double>(part_size * sizeof(T)),
+                                            static_cast<double>(sizeof(T)), static_cast<double>(part_size)};
+  concurrency::ThreadPool::TryParallelFor(
+      tp, outer * num_parts, part_cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t begin = (i % num_parts) * part_size;
+          partial_results[i] = AGG::Reduce(input + (i / num_parts) * reduced + begin,
+                                           std::min(part_size, reduced - begin));
+        }
+      });
+
+  for (int64_t o = 0; o < outer; ++o) {
+    T value = partial_results[o * num_parts];
+    for (int64_t part = 1; part < num_parts; ++part) {
+      value = AGG::Merge(value, partial_results[o * num_parts + part]);
+    }
+    output[o] = value;
+  }
+  AGG::Finalize(output, outer, reduced);
+}
+
+template <typename T, typename AGG>
+Status CommonReduce(OpKernelContext* ctx, const std::vector<int64_t>& axes_, bool keepdims_) {
   FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
   int64_t block_size;
   int64_t blocks;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  FastReduceShape fast_shape;
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_,
+                                          &fast_shape);
 
-  T* output_data = reduced->template MutableData<T>();
+  // edge case. one or more input dims with value of 0.
+  if (blocks == 0) {
+    return Status::OK();
+  }
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  for (int j = 0; j < block_size; ++j) {
-    *(output_data) = static_cast<T>(std::log(*(output_data)));
-    ++output_data;
+  const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+  if (!no_transpose) {
+    // the transposed copy has all the reduced axes first
+    input_data = &transposedInputData[0];
+    fast_shape = {1, blocks, block_size};
   }
 
+  FastReduce<T, AGG>(input_data, reduced->template MutableData<T>(), fast_shape, ctx->GetOperatorThreadPool());
   return Status::OK();
 }
 
+template <typename T>
+Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
+  return CommonReduce<T, ReduceAggregatorL1<T>>(ctx, axes_, keepdims_);
+}
+
+template <typename T>
+Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
+  return CommonReduce<T, ReduceAggregatorL2<T>>(ctx, axes_, keepdims_);
+}
+
+template <typename T>
+Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
+  return CommonReduce<T, ReduceAggregatorLogSum<T>>(ctx, axes_, keepdims_);
+}
+
 template <typename T>
 Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
   FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
@@ -384,136 +584,32 @@ Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
 
 template <typename T>
 Status ReduceMax<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).maxCoeff();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().maxCoeff();
-  }
-
-  return Status::OK();
+  return CommonReduce<T, ReduceAggregatorMax<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceMean<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).mean();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().mean();
-  }
-
-  return Status::OK();
+  return CommonReduce<T, ReduceAggregatorMean<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceMin<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).minCoeff();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().minCoeff();
-  }
-
-  return Status::OK();
+  return CommonReduce<T, ReduceAggregatorMin<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceProd<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().prod();
-
-  return Status::OK();
+  return CommonReduce<T, ReduceAggregatorProd<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceSum<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).sum();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  }
-
-  return Status::OK();
+  return CommonReduce<T, ReduceAggregatorSum<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().squaredNorm();
-
-  return Status::OK();
+  return CommonReduce<T, ReduceAggregatorSumSquare<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
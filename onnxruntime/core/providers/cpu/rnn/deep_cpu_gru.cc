@@ -173,8 +173,8 @@ class UniDirectionalGru {
                     onnxruntime::concurrency::ThreadPool* ttp);
 
   void Compute(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths, int num_directions,
-               const gsl::span<const T>& input_weights, const gsl::span<const T>& recurrent_weights,
-               gsl::span<T>& outputs, gsl::span<T>& final_hidden_state);
+               const GemmWeights<T>& input_weights, const GemmWeights<T>& recurrent_weightsZR,
+               const GemmWeights<T>& recurrent_weightsH, gsl::span<T>& outputs, gsl::span<T>& final_hidden_state);
 
   ~UniDirectionalGru() = default;
 
@@ -248,6 +248,38 @@ class UniDirectionalGru {
 #define DumpMatrix(...) ((void)0)
 #endif
 
+Status DeepCpuGruOp::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                             /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // pack the constant W and R, see rnn::detail::PackWeights
+  if (input_idx == 1 || input_idx == 2) {
+    const auto hidden_size = static_cast<size_t>(hidden_size_);
+    PackedWeights& packed_weights = input_idx == 1 ? packed_W_ : packed_R_;
+    is_packed = input_idx == 1
+                    ? PackWeights(tensor, alloc, {3 * hidden_size}, packed_weights)
+                    : PackWeights(tensor, alloc, {2 * hidden_size, hidden_size}, packed_weights);
+    if (is_packed && prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(packed_weights.buffer_));
+      prepacked_weights->buffer_sizes_.push_back(packed_weights.buffer_size_);
+    }
+  }
+
+  return Status::OK();
+}
+
+Status DeepCpuGruOp::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                               /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1 || input_idx == 2) {
+    used_shared_buffers = true;
+    (input_idx == 1 ? packed_W_ : packed_R_).buffer_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status DeepCpuGruOp::Compute(OpKernelContext* context) const {
   const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
 
@@ -270,8 +302,11 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   concurrency::ThreadPool* thread_pool = context.GetOperatorThreadPool();
 
   const Tensor& X = *context.Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
-  const Tensor& W = *context.Input<Tensor>(1);  // weights. [num_directions, 3*hidden_size, input_size]
-  const Tensor& R = *context.Input<Tensor>(2);  // recurrence weights. [num_directions, 3*hidden_size, hidden_size]
+
+  const Tensor* W = packed_W_.buffer_ ? nullptr : context.Input<Tensor>(1);  // weights. [num_directions, 3*hidden_size, input_size]
+  const Tensor* R = packed_R_.buffer_ ? nullptr : context.Input<Tensor>(2);  // recurrence weights. [num_directions, 3*hidden_size, hidden_size]
+  const TensorShape& W_shape = W != nullptr ? W->Shape() : packed_W_.shape_;
+  const TensorShape& R_shape = R != nullptr ? R->Shape() : packed_R_.shape_;
 
   // optional
   const auto* B = context.Input<Tensor>(3);              // bias. [num_directions, 6*hidden_size]
@@ -284,7 +319,7 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   int batch_size = gsl::narrow<int>(X_shape[1]);
   int input_size = gsl::narrow<int>(X_shape[2]);
 
-  auto status = ValidateCommonRnnInputs(X, W, R, B, 3, sequence_lens, initial_h, num_directions_, hidden_size_);
+  auto status = ValidateCommonRnnInputs(X, W_shape, R_shape, B, 3, sequence_lens, initial_h, num_directions_, hidden_size_);
   ORT_RETURN_IF_ERROR(status);
 
   // GRU outputs are optional but must be in the same order
@@ -307,8 +342,6 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   AllocatorPtr alloc;
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
-  gsl::span<const T> input_weights = W.DataAsSpan<T>();
-  gsl::span<const T> recurrent_weights = R.DataAsSpan<T>();
   gsl::span<const T> bias = B != nullptr ? B->DataAsSpan<T>() : gsl::span<const T>();
 
   // spans for first direction
@@ -316,8 +349,24 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   const size_t recurrent_weights_size_per_direction = 3 * hidden_size_ * hidden_size_;
   const size_t bias_size_per_direction = 6 * hidden_size_;
 
-  gsl::span<const T> input_weights_1 = input_weights.subspan(0, input_weights_size_per_direction);
-  gsl::span<const T> recurrent_weights_1 = recurrent_weights.subspan(0, recurrent_weights_size_per_direction);
+  // weights for a direction, either packed or as the original span. R is split into the R[zr] and R[h] blocks.
+  auto input_weights = [&](int direction) {
+    return W != nullptr ? GemmWeights<T>(W->DataAsSpan<T>().subspan(direction * input_weights_size_per_direction,
+                                                                     input_weights_size_per_direction))
+                        : packed_W_.Block(direction, 0);
+  };
+
+  auto recurrent_weights = [&](int direction, size_t block) {
+    const size_t recurrent_weightsZR_size = 2 * hidden_size_ * hidden_size_;
+    if (R == nullptr) {
+      return packed_R_.Block(direction, block);
+    }
+    auto direction_weights = R->DataAsSpan<T>().subspan(direction * recurrent_weights_size_per_direction,
+                                                        recurrent_weights_size_per_direction);
+    return block == 0 ? GemmWeights<T>(direction_weights.subspan(0, recurrent_weightsZR_size))
+                      : GemmWeights<T>(direction_weights.subspan(recurrent_weightsZR_size));
+  };
+
   gsl::span<const T> bias_1 = bias.empty() ? bias : bias.subspan(0, bias_size_per_direction);
 
   gsl::span<const T> input = X.DataAsSpan<T>();
@@ -352,10 +401,6 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
 
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
-    gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
-                                                               input_weights_size_per_direction);
-    gsl::span<const T> recurrent_weights_2 = recurrent_weights.subspan(recurrent_weights_size_per_direction,
-                                                                       recurrent_weights_size_per_direction);
     gsl::span<const T> bias_2 = bias.empty() ? bias : bias.subspan(bias_size_per_direction, bias_size_per_direction);
 
     gsl::span<const T> initial_hidden_2 = initial_hidden.empty()
@@ -374,24 +419,30 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
                                     activation_funcs_.Entries()[0],
                                     activation_funcs_.Entries()[1],
                                     clip_, thread_pool);
-    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
-               output_1, hidden_output_1);
 
     detail::UniDirectionalGru<T> bw(alloc, seq_length, batch_size, input_size, hidden_size_,
                                     linear_before_reset_, Direction::kReverse, bias_2, initial_hidden_2,
                                     activation_funcs_.Entries()[2],
                                     activation_funcs_.Entries()[3],
                                     clip_, thread_pool);
-    bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2,
-               output_2, hidden_output_2);
+
+    ExecuteLambdaInParallel(thread_pool, 2, [&](int32_t direction) {
+      if (direction == 0) {
+        fw.Compute(input, sequence_lens_span, num_directions_, input_weights(0), recurrent_weights(0, 0),
+                   recurrent_weights(0, 1), output_1, hidden_output_1);
+      } else {
+        bw.Compute(input, sequence_lens_span, num_directions_, input_weights(1), recurrent_weights(1, 0),
+                   recurrent_weights(1, 1), output_2, hidden_output_2);
+      }
+    });
   } else {
     detail::UniDirectionalGru<T> gru_p(alloc, seq_length, batch_size, input_size, hidden_size_,
                                        linear_before_reset_, direction_, bias_1, initial_hidden_1,
                                        activation_funcs_.Entries()[0],
                                        activation_funcs_.Entries()[1],
                                        clip_, thread_pool);
-    gru_p.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
-                  output_1, hidden_output_1);
+    gru_p.Compute(input, sequence_lens_span, num_directions_, input_weights(0), recurrent_weights(0, 0),
+                  recurrent_weights(0, 1), output_1, hidden_output_1);
   }
 
   if (!output.empty())
@@ -490,8 +541,9 @@ template <typename T>
 void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
                                    const gsl::span<const int>& sequence_lengths_arg,
                                    const int num_directions,
-                                   const gsl::span<const T>& input_weights,
-                                   const gsl::span<const T>& recurrent_weights,
+                                   const GemmWeights<T>& input_weights,
+                                   const GemmWeights<T>& recurrent_weightsZR,
+                                   const GemmWeights<T>& recurrent_weightsH,
                                    gsl::span<T>& outputs,
                                    gsl::span<T>& final_hidden_state) {
   using span_T_const_iter = typename gsl::span<T>::const_iterator;
@@ -508,11 +560,6 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   }
 
   DumpMatrix("Inputs", inputs.data(), seq_length_ * batch_size_, input_size_);
-  DumpMatrix("input_weights", input_weights.data(), 3 * hidden_size_, input_size_);
-  DumpMatrix("recurrent_weights", recurrent_weights.data(), 3 * hidden_size_, hidden_size_);
-
-  gsl::span<const T> recurrent_weightsZR = recurrent_weights.subspan(0, 2 * hidden_size_ * hidden_size_);
-  gsl::span<const T> recurrent_weightsH = recurrent_weights.subspan(2 * hidden_size_ * hidden_size_, hidden_size_ * hidden_size_);
 
   gsl::span<T> original_outputs = outputs;
   const bool output_sequence = !outputs.empty();
@@ -544,8 +591,8 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
               inputs.cbegin(), inputs.cend(),
               input_size_,
-              input_weights.cbegin(), input_weights.cend(),
-              input_size_, beta,
+              input_weights,
+              beta,
               outputZRH_.begin(), outputZRH_.end(),
               hidden_size_x3, ttp_);
 
@@ -610,8 +657,8 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
     ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
                 prev_Ht, prev_Ht_end,
                 hidden_size_,
-                recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
-                hidden_size_, beta,
+                recurrent_weightsZR,
+                beta,
                 outputZRH_.begin() + out_added_offset, outputZRH_.end(),
                 hidden_size_x3, ttp_);
 
@@ -626,8 +673,8 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
       ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
                   prev_Ht, prev_Ht_end,  // Ht-1
                   hidden_size_,
-                  recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                  hidden_size_, beta,
+                  recurrent_weightsH,  // Rh^T
+                  beta,
                   linear_output_.begin(), linear_output_.end(),  // pre: Rbh, post:output
                   hidden_size_, ttp_);
 
@@ -697,8 +744,8 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
       ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
                   cur_h_local, cur_h_local_end,  // rt (.) Ht-1
                   hidden_size_,
-                  recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                  hidden_size_, beta,
+                  recurrent_weightsH,  // Rh^T
+                  beta,
                   out_H, outputZRH_.end(),
                   hidden_size_x3, ttp_);
     }
@@ -7,6 +7,7 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/prepacked_weights.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
 
 namespace onnxruntime {
@@ -52,6 +53,12 @@ class DeepCpuGruOp final : public OpKernel {
                                                      activation_func_betas);
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
   ~DeepCpuGruOp() override = default;
@@ -66,6 +73,11 @@ class DeepCpuGruOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
+  // The input and recurrence weights are packed once by PrePack when they are constant initializers.
+  // R is packed as separate R[zr] and R[h] blocks as they are multiplied separately.
+  rnn::detail::PackedWeights packed_W_;
+  rnn::detail::PackedWeights packed_R_;
+
   template <typename T>
   Status ComputeImpl(OpKernelContext& context) const;
 };
@@ -196,11 +196,10 @@ class UniDirectionalLstm {
                      const gsl::span<const T>& initial_hidden_state, const gsl::span<const T>& initial_cell_state,
                      const ActivationFuncs::Entry& activation_func_f, const ActivationFuncs::Entry& activation_func_g,
                      const ActivationFuncs::Entry& activation_func_h, float clip,
-                     concurrency::ThreadPool& lstm_tp_,
-                     concurrency::ThreadPool* mlas_tp_);
+                     concurrency::ThreadPool* thread_pool);
 
   void Compute(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths, int num_directions,
-               const gsl::span<const T>& input_weights, const gsl::span<const T>& recurrent_weights,
+               const GemmWeights<T>& input_weights, const GemmWeights<T>& recurrent_weights,
                gsl::span<T>& outputs, gsl::span<T>& final_hidden_state, gsl::span<T>& final_cell_state);
 
   ~UniDirectionalLstm() = default;
@@ -279,12 +278,40 @@ class UniDirectionalLstm {
   ActivationInfo<deepcpu::ActivationFuncPtr> activation_g_;
   ActivationInfo<deepcpu::LstmMergeGatesFuncPtr> activation_h_;
 
-  concurrency::ThreadPool& lstm_tp_;
-  concurrency::ThreadPool* mlas_tp_;
+  concurrency::ThreadPool* thread_pool_;
 };
 
 }  // namespace detail
 
+Status DeepCpuLstmOp::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                              /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // pack the constant W and R, see rnn::detail::PackWeights
+  if (input_idx == 1 || input_idx == 2) {
+    PackedWeights& packed_weights = input_idx == 1 ? packed_W_ : packed_R_;
+    is_packed = PackWeights(tensor, alloc, {static_cast<size_t>(4 * hidden_size_)}, packed_weights);
+    if (is_packed && prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(packed_weights.buffer_));
+      prepacked_weights->buffer_sizes_.push_back(packed_weights.buffer_size_);
+    }
+  }
+
+  return Status::OK();
+}
+
+Status DeepCpuLstmOp::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                                /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1 || input_idx == 2) {
+    used_shared_buffers = true;
+    (input_idx == 1 ? packed_W_ : packed_R_).buffer_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status
 DeepCpuLstmOp::Compute(OpKernelContext* context) const {
   const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
@@ -313,13 +340,16 @@ DeepCpuLstmOp::Compute(OpKernelContext* context) const {
 
 template <typename T>
 Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
-  concurrency::ThreadPool* mlas_thread_pool = context.GetOperatorThreadPool();
+  concurrency::ThreadPool* thread_pool = context.GetOperatorThreadPool();
 
   auto& logger = context.Logger();
 
   const Tensor& X = *context.Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
-  const Tensor& W = *context.Input<Tensor>(1);  // weights. [num_directions, 4*hidden_size, input_size]
-  const Tensor& R = *context.Input<Tensor>(2);  // recurrence weights. [num_directions, 4*hidden_size, hidden_size]
+
+  const Tensor* W = packed_W_.buffer_ ? nullptr : context.Input<Tensor>(1);  // weights. [num_directions, 4*hidden_size, input_size]
+  const Tensor* R = packed_R_.buffer_ ? nullptr : context.Input<Tensor>(2);  // recurrence weights. [num_directions, 4*hidden_size, hidden_size]
+  const TensorShape& W_shape = W != nullptr ? W->Shape() : packed_W_.shape_;
+  const TensorShape& R_shape = R != nullptr ? R->Shape() : packed_R_.shape_;
 
   // optional
   const Tensor* B = context.Input<Tensor>(3);              // bias. [num_directions, 8*hidden_size]
@@ -334,7 +364,7 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   int batch_size = gsl::narrow<int>(X_shape[1]);
   int input_size = gsl::narrow<int>(X_shape[2]);
 
-  Status status = ValidateInputs(X, W, R, B, sequence_lens, initial_h, initial_c, P, batch_size);
+  Status status = ValidateInputs(X, W_shape, R_shape, B, sequence_lens, initial_h, initial_c, P, batch_size);
   ORT_RETURN_IF_ERROR(status);
 
   // LSTM outputs are optional but must be in the same order
@@ -362,8 +392,6 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
 
-  gsl::span<const T> input_weights = W.DataAsSpan<T>();
-  gsl::span<const T> recurrent_weights = R.DataAsSpan<T>();
   gsl::span<const T> bias = B != nullptr ? B->DataAsSpan<T>() : gsl::span<const T>();
   gsl::span<const T> peephole_weights = P != nullptr ? P->DataAsSpan<T>() : gsl::span<const T>();
 
@@ -373,8 +401,16 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   const size_t bias_size_per_direction = 8 * hidden_size_;
   const size_t peephole_weights_size_per_direction = 3 * hidden_size_;
 
-  gsl::span<const T> input_weights_1 = input_weights.subspan(0, input_weights_size_per_direction);
-  gsl::span<const T> recurrent_weights_1 = recurrent_weights.subspan(0, hidden_weights_size_per_direction);
+  // weights for a direction, either packed or as the original span
+  auto direction_weights = [](const Tensor* weights, const PackedWeights& packed_weights,
+                              int direction, size_t size_per_direction) {
+    return weights != nullptr
+               ? GemmWeights<T>(weights->DataAsSpan<T>().subspan(direction * size_per_direction, size_per_direction))
+               : packed_weights.Block(direction, 0);
+  };
+
+  GemmWeights<T> input_weights_1 = direction_weights(W, packed_W_, 0, input_weights_size_per_direction);
+  GemmWeights<T> recurrent_weights_1 = direction_weights(R, packed_R_, 0, hidden_weights_size_per_direction);
   gsl::span<const T> bias_1 = bias.empty() ? bias : bias.subspan(0, bias_size_per_direction);
   gsl::span<const T> peephole_weights_1 =
       peephole_weights.empty() ? peephole_weights
@@ -426,10 +462,8 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
 
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
-    gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
-                                                               input_weights_size_per_direction);
-    gsl::span<const T> hidden_weights_2 = recurrent_weights.subspan(hidden_weights_size_per_direction,
-                                                                    hidden_weights_size_per_direction);
+    GemmWeights<T> input_weights_2 = direction_weights(W, packed_W_, 1, input_weights_size_per_direction);
+    GemmWeights<T> hidden_weights_2 = direction_weights(R, packed_R_, 1, hidden_weights_size_per_direction);
     gsl::span<const T> bias_2 = bias.empty() ? bias : bias.subspan(bias_size_per_direction, bias_size_per_direction);
     gsl::span<const T> peephole_weights_2 =
         peephole_weights.empty() ? peephole_weights
@@ -458,7 +492,7 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                      activation_funcs_.Entries()[0],
                                      activation_funcs_.Entries()[1],
                                      activation_funcs_.Entries()[2],
-                                     clip_, lstm_tp_, mlas_thread_pool);
+                                     clip_, thread_pool);
 
     detail::UniDirectionalLstm<T> bw(alloc, logger, seq_length, batch_size, input_size,
                                      hidden_size_, Direction::kReverse, input_forget_,
@@ -466,12 +500,17 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                      activation_funcs_.Entries()[3],
                                      activation_funcs_.Entries()[4],
                                      activation_funcs_.Entries()[5],
-                                     clip_, lstm_tp_, mlas_thread_pool);
+                                     clip_, thread_pool);
 
-    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
-               output_1, hidden_output_1, last_cell_1);
-    bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2,
-               output_2, hidden_output_2, last_cell_2);
+    ExecuteLambdaInParallel(thread_pool, 2, [&](int32_t direction) {
+      if (direction == 0) {
+        fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+                   output_1, hidden_output_1, last_cell_1);
+      } else {
+        bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2,
+                   output_2, hidden_output_2, last_cell_2);
+      }
+    });
   } else {
     detail::UniDirectionalLstm<T> fw(alloc, logger, seq_length, batch_size, input_size,
                                      hidden_size_, direction_, input_forget_,
@@ -479,7 +518,7 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                      activation_funcs_.Entries()[0],
                                      activation_funcs_.Entries()[1],
                                      activation_funcs_.Entries()[2],
-                                     clip_, lstm_tp_, mlas_thread_pool);
+                                     clip_, thread_pool);
 
     fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
                output_1, hidden_output_1, last_cell_1);
@@ -495,10 +534,10 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   return Status::OK();
 }
 
-Status DeepCpuLstmOp::ValidateInputs(const Tensor& X, const Tensor& W, const Tensor& R, const Tensor* B,
-                                     const Tensor* sequence_lens, const Tensor* initial_h, const Tensor* initial_c,
-                                     const Tensor* P, int batch_size) const {
-  auto status = rnn::detail::ValidateCommonRnnInputs(X, W, R, B, 4, sequence_lens, initial_h,
+Status DeepCpuLstmOp::ValidateInputs(const Tensor& X, const TensorShape& W_shape, const TensorShape& R_shape,
+                                     const Tensor* B, const Tensor* sequence_lens, const Tensor* initial_h,
+                                     const Tensor* initial_c, const Tensor* P, int batch_size) const {
+  auto status = rnn::detail::ValidateCommonRnnInputs(X, W_shape, R_shape, B, 4, sequence_lens, initial_h,
                                                      num_directions_, hidden_size_);
   ORT_RETURN_IF_ERROR(status);
 
@@ -552,8 +591,7 @@ UniDirectionalLstm<T>::UniDirectionalLstm(AllocatorPtr allocator,
                                           const ActivationFuncs::Entry& activation_func_g,
                                           const ActivationFuncs::Entry& activation_func_h,
                                           const float clip,
-                                          concurrency::ThreadPool& lstm_tp,
-                                          concurrency::ThreadPool* mlas_tp)
+                                          concurrency::ThreadPool* thread_pool)
     : allocator_(allocator),
       logger_(logger),
       seq_length_(seq_length),
@@ -565,8 +603,7 @@ UniDirectionalLstm<T>::UniDirectionalLstm(AllocatorPtr allocator,
       clip_(clip),
       use_bias_(!bias.empty()),
       use_peepholes_(!peephole_weights.empty()),
-      lstm_tp_(lstm_tp),
-      mlas_tp_(mlas_tp) {
+      thread_pool_(thread_pool) {
   activation_f_ = {deepcpu::ActivationFuncByName(activation_func_f.name),
                    activation_func_f.alpha,
                    activation_func_f.beta};
@@ -718,8 +755,8 @@ template <typename T>
 void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
                                     const gsl::span<const int>& sequence_lengths_arg,
                                     const int num_directions,
-                                    const gsl::span<const T>& input_weights,
-                                    const gsl::span<const T>& recurrent_weights,
+                                    const GemmWeights<T>& input_weights,
+                                    const GemmWeights<T>& recurrent_weights,
                                     gsl::span<T>& outputs,
                                     gsl::span<T>& final_hidden_state,
                                     gsl::span<T>& final_cell_state) {
@@ -779,10 +816,10 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
   ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha,
               inputs.cbegin(), inputs.cend(),
               input_size_,
-              input_weights.cbegin(), input_weights.cend(),  // W[iofc]
-              input_size_, beta,
+              input_weights,  // W[iofc]
+              beta,
               output_iofc_.begin(), output_iofc_.end(),
-              hidden_size_x4, mlas_tp_);
+              hidden_size_x4, thread_pool_);
 
   DumpMatrix("Xt*(W[iofc]^T)", output_iofc_.data(), total_rows, hidden_size_x4);
 
@@ -829,10 +866,10 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
         ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
                     previous_state, previous_state_end,  // Ht-1
                     hidden_size_,
-                    recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
-                    hidden_size_, beta,
+                    recurrent_weights,  // R[iofc]
+                    beta,
                     step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                    hidden_size_x4, mlas_tp_);
+                    hidden_size_x4, thread_pool_);
 
         DumpMatrix("Xt*(W[iofc]^T) + Ht-t*R[iofc]" + row_str,
                    &*step_out_IOFC, local_fused_hidden_rows, hidden_size_x4);
@@ -883,7 +920,11 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
       }
     };
 
-    ExecuteLambdaInParallel("Processing batch", hidden_gemm_and_activations, batch_size_, fused_hidden_rows, lstm_tp_, logger_);
+    // each chunk of rows runs through all the steps independently of the other chunks
+    const int num_chunks = (batch_size_ + fused_hidden_rows - 1) / fused_hidden_rows;
+    ExecuteLambdaInParallel(thread_pool_, num_chunks, [&](int32_t chunk) {
+      hidden_gemm_and_activations(chunk * fused_hidden_rows);
+    });
 
   } else {
     span_T_const_iter previous_state_end = batched_hidden_state_one_step.cend();
@@ -909,10 +950,10 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
       ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
                   previous_state, previous_state_end,  // Ht-1
                   hidden_size_,
-                  recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
-                  hidden_size_, beta,
+                  recurrent_weights,  // R[iofc]
+                  beta,
                   step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4, mlas_tp_);
+                  hidden_size_x4, thread_pool_);
 
       span_T_iter batched_output;
       span_T_iter batched_output_end;
@@ -1122,10 +1163,8 @@ void UniDirectionalLstm<T>::GateComputations(span_T_iter& out, span_T_iter& out_
 
 template <typename T>
 void UniDirectionalLstm<T>::SetNumThreads() {
-  int threads = std::thread::hardware_concurrency() - 1;
-
-  if (threads < 1)
-    threads = 1;
+  // the calling thread works on the batch along with the threads of the pool
+  int threads = thread_pool_ != nullptr ? thread_pool_->NumThreads() + 1 : 1;
 
   hidden_num_threads_ = threads;
   batch_parallel_ = false;
@@ -6,8 +6,8 @@
 #include <limits>
 
 #include "core/framework/op_kernel.h"
+#include "core/framework/prepacked_weights.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
-#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
@@ -51,6 +51,12 @@ class DeepCpuLstmOp final : public OpKernel {
                                                      activation_func_betas);
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
   ~DeepCpuLstmOp() override = default;
@@ -60,8 +66,8 @@ class DeepCpuLstmOp final : public OpKernel {
   Status ComputeImpl(OpKernelContext& context) const;
 
   Status ValidateInputs(const Tensor& X,
-                        const Tensor& W,
-                        const Tensor& R,
+                        const TensorShape& W_shape,
+                        const TensorShape& R_shape,
                         const Tensor* B,
                         const Tensor* sequence_lens,
                         const Tensor* initial_h,
@@ -78,12 +84,9 @@ class DeepCpuLstmOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
-  // Threadpool for operator. If concurrent Compute calls are possible, it will be shared
-  // across them. mutable due to this.
-  // The alternative would be to create a threadpool in each call to Compute but that would incur thread creation
-  // cost on every call.
-  mutable onnxruntime::concurrency::ThreadPool lstm_tp_{"DEEPCPU_LSTM",
-                                                        static_cast<int>(std::thread::hardware_concurrency())};
+  // The input and recurrence weights are packed once by PrePack when they are constant initializers.
+  rnn::detail::PackedWeights packed_W_;
+  rnn::detail::PackedWeights packed_R_;
 };
 
 }  // namespace onnxruntime
@@ -13,6 +13,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/cpu/rnn/rnn_activation_functors.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
@@ -24,8 +25,8 @@ namespace detail {
 using namespace ::onnxruntime::common;
 
 Status ValidateCommonRnnInputs(const Tensor& X,
-                               const Tensor& W,
-                               const Tensor& R,
+                               const TensorShape& W_shape,
+                               const TensorShape& R_shape,
                                const Tensor* B,
                                int WRB_dim_1_multipler,
                                const Tensor* sequence_lens,
@@ -33,8 +34,6 @@ Status ValidateCommonRnnInputs(const Tensor& X,
                                int64_t num_directions,
                                int64_t hidden_size) {
   auto& X_shape = X.Shape();
-  auto& W_shape = W.Shape();
-  auto& R_shape = R.Shape();
 
   int64_t seq_length = X_shape[0];
   int64_t batch_size = X_shape[1];
@@ -188,6 +187,58 @@ ActivationFuncs::ActivationFuncs(const std::vector<std::string>& funcs,
   }
 }
 
+bool PackWeights(const Tensor& weights, const AllocatorPtr& alloc, const std::vector<size_t>& block_rows,
+                 /*out*/ PackedWeights& packed) {
+  const auto& shape = weights.Shape();
+  if (!weights.IsDataType<float>() || shape.NumDimensions() != 3) {
+    return false;
+  }
+
+  const auto num_directions = static_cast<size_t>(shape[0]);
+  const auto rows = static_cast<size_t>(shape[1]);
+  const auto K = static_cast<size_t>(shape[2]);
+
+  size_t total_block_rows = 0;
+  size_t direction_size = 0;
+  std::vector<size_t> block_offsets;
+  for (size_t N : block_rows) {
+    const size_t block_size = MlasGemmPackBSize(N, K);
+    if (block_size == 0) {
+      return false;
+    }
+    block_offsets.push_back(direction_size);
+    direction_size += block_size;
+    total_block_rows += N;
+  }
+  if (total_block_rows != rows) {
+    return false;
+  }
+
+  const size_t buffer_size = num_directions * direction_size;
+  auto* buffer = static_cast<uint8_t*>(alloc->Alloc(buffer_size));
+  packed.buffer_ = BufferUniquePtr(buffer, BufferDeleter(alloc));
+
+  // Clear the buffer so that any padding is deterministic, as packed buffers
+  // are compared by content when shared between sessions.
+  memset(buffer, 0, buffer_size);
+
+  // The weights are used as matrix B transposed, with each row of a block being a column of B.
+  const float* weights_data = weights.Data<float>();
+  for (size_t direction = 0; direction < num_directions; direction++) {
+    for (size_t block = 0; block < block_rows.size(); block++) {
+      MlasGemmPackB(CblasTrans, block_rows[block], K, weights_data, K,
+                    buffer + direction * direction_size + block_offsets[block]);
+      weights_data += block_rows[block] * K;
+    }
+  }
+
+  packed.buffer_size_ = buffer_size;
+  packed.direction_size_ = direction_size;
+  packed.block_offsets_ = std::move(block_offsets);
+  packed.shape_ = shape;
+  return true;
+}
+
 void DumpMatrixImpl(const std::string& name, const float* src, int row, int col, int offset, int col_width) {
   std::cout << "Dump matrix: " << name << std::endl;
 
@@ -205,61 +256,8 @@ void DumpMatrixImpl(const std::string& name, const float* src, int row, int col,
 
 namespace deepcpu {
 
-const float alpha_1 = 4.89352455891786e-03f;
-const float alpha_3 = 6.37261928875436e-04f;
-const float alpha_5 = 1.48572235717979e-05f;
-const float alpha_7 = 5.12229709037114e-08f;
-const float alpha_9 = -8.60467152213735e-11f;
-const float alpha_11 = 2.00018790482477e-13f;
-const float alpha_13 = -2.76076847742355e-16f;
-
-const float beta_0 = 4.89352518554385e-03f;
-const float beta_2 = 2.26843463243900e-03f;
-const float beta_4 = 1.18534705686654e-04f;
-const float beta_6 = 1.19825839466702e-06f;
-
-const float sigmoid_bound = 20.0f;
-const float tanh_bound = 10.0f;
-
-inline void clip_for_sigmoid_in_place(float* ps, int c) {
-  for (int i = 0; i < c; i++) {
-    if (ps[i] < -sigmoid_bound)
-      ps[i] = -sigmoid_bound;
-    else if (ps[i] > sigmoid_bound)
-      ps[i] = sigmoid_bound;
-  }
-}
-
-inline void clip_for_tanh_in_place(float* ps, int c) {
-  for (int i = 0; i < c; i++) {
-    if (ps[i] < -tanh_bound)
-      ps[i] = -tanh_bound;
-    else if (ps[i] > tanh_bound)
-      ps[i] = tanh_bound;
-  }
-}
-
-inline void clip_for_sigmoid(const float* ps, float* pd, int c) {
-  for (int i = 0; i < c; i++) {
-    if (ps[i] < -sigmoid_bound)
-      pd[i] = -sigmoid_bound;
-    else if (ps[i] > sigmoid_bound)
-      pd[i] = sigmoid_bound;
-    else
-      pd[i] = ps[i];
-  }
-}
-
-inline void clip_for_tanh(const float* ps, float* pd, int c) {
-  for (int i = 0; i < c; i++) {
-    if (ps[i] < -tanh_bound)
-      pd[i] = -tanh_bound;
-    else if (ps[i] > tanh_bound)
-      pd[i] = tanh_bound;
-    else
-      pd[i] = ps[i];
-  }
-}
+// The sigmoid and tanh activations below run on whole rows using the vectorized MLAS kernels, which clamp
+// the input range themselves.
 
 void add_bias_into_ignore(const float* ps, const float* pd, int c) {
   ORT_UNUSED_PARAMETER(ps);
@@ -314,22 +312,10 @@ void sigmoid_m(const float* ps1, float* ps1_c, const float* ps2, float* pd, int
   ORT_UNUSED_PARAMETER(alpha);
   ORT_UNUSED_PARAMETER(beta);
 
-  clip_for_sigmoid(ps1, ps1_c, c);
+  MlasComputeLogistic(ps1, ps1_c, c);
 
   for (int i = 0; i < c; i++) {
-    float x = 0.5f * ps1_c[i];
-    float x2 = x * x;
-    float p = x2 * alpha_13 + alpha_11;
-    p = x2 * p + alpha_9;
-    p = x2 * p + alpha_7;
-    p = x2 * p + alpha_5;
-    p = x2 * p + alpha_3;
-    p = x2 * p + alpha_1;
-    p = x * p;
-    float q = x2 * beta_6 + beta_4;
-    q = x2 * q + beta_2;
-    q = x2 * q + beta_0;
-    pd[i] = ps2[i] * 0.5f * (1 + (p / q));
+    pd[i] = ps2[i] * ps1_c[i];
   }
 }
 
@@ -338,22 +324,10 @@ void tanh_m(const float* ps1, float* ps1_c, const float* ps2, float* pd, int c,
   ORT_UNUSED_PARAMETER(alpha);
   ORT_UNUSED_PARAMETER(beta);
 
-  clip_for_tanh(ps1, ps1_c, c);
+  MlasComputeTanh(ps1, ps1_c, c);
 
   for (int i = 0; i < c; i++) {
-    float x = ps1_c[i];
-    float x2 = x * x;
-    float p = x2 * alpha_13 + alpha_11;
-    p = x2 * p + alpha_9;
-    p = x2 * p + alpha_7;
-    p = x2 * p + alpha_5;
-    p = x2 * p + alpha_3;
-    p = x2 * p + alpha_1;
-    p = x * p;
-    float q = x2 * beta_6 + beta_4;
-    q = x2 * q + beta_2;
-    q = x2 * q + beta_0;
-    pd[i] = ps2[i] * p / q;
+    pd[i] = ps2[i] * ps1_c[i];
   }
 }
 
@@ -402,46 +376,14 @@ void sigmoid(float* pd, int c, float alpha, float beta) {
   ORT_UNUSED_PARAMETER(alpha);
   ORT_UNUSED_PARAMETER(beta);
 
-  clip_for_sigmoid_in_place(pd, c);
-
-  for (int i = 0; i < c; i++) {
-    float x = 0.5f * pd[i];
-    float x2 = x * x;
-    float p = x2 * alpha_13 + alpha_11;
-    p = x2 * p + alpha_9;
-    p = x2 * p + alpha_7;
-    p = x2 * p + alpha_5;
-    p = x2 * p + alpha_3;
-    p = x2 * p + alpha_1;
-    p = x * p;
-    float q = x2 * beta_6 + beta_4;
-    q = x2 * q + beta_2;
-    q = x2 * q + beta_0;
-    pd[i] = 0.5f * (1 + (p / q));
-  }
+  MlasComputeLogistic(pd, pd, c);
 }
 
 void tanh(float* pd, int c, float alpha, float beta) {
   ORT_UNUSED_PARAMETER(alpha);
   ORT_UNUSED_PARAMETER(beta);
 
-  clip_for_tanh_in_place(pd, c);
-
-  for (int i = 0; i < c; i++) {
-    float x = pd[i];
-    float x2 = x * x;
-    float p = x2 * alpha_13 + alpha_11;
-    p = x2 * p + alpha_9;
-    p = x2 * p + alpha_7;
-    p = x2 * p + alpha_5;
-    p = x2 * p + alpha_3;
-    p = x2 * p + alpha_1;
-    p = x * p;
-    float q = x2 * beta_6 + beta_4;
-    q = x2 * q + beta_2;
-    q = x2 * q + beta_0;
-    pd[i] = p / q;
-  }
+  MlasComputeTanh(pd, pd, c);
 }
 
 void relu(float* pd, int c, float alpha, float beta) {
@@ -485,22 +427,10 @@ void gru_reset_gate_tanh(const float* ps1, float* ps2, float* pd, int c, float a
   ORT_UNUSED_PARAMETER(alpha);
   ORT_UNUSED_PARAMETER(beta);
 
-  clip_for_tanh_in_place(ps2, c);
+  MlasComputeTanh(ps2, ps2, c);
 
   for (int i = 0; i < c; i++) {
-    float x = ps2[i];
-    float x2 = x * x;
-    float p = x2 * alpha_13 + alpha_11;
-    p = x2 * p + alpha_9;
-    p = x2 * p + alpha_7;
-    p = x2 * p + alpha_5;
-    p = x2 * p + alpha_3;
-    p = x2 * p + alpha_1;
-    p = x * p;
-    float q = x2 * beta_6 + beta_4;
-    q = x2 * q + beta_2;
-    q = x2 * q + beta_0;
-    pd[i] = ps1[i] * p / q;
+    pd[i] = ps1[i] * ps2[i];
   }
 }
 
@@ -508,22 +438,10 @@ void gru_reset_gate_sigmoid(const float* ps1, float* ps2, float* pd, int c, floa
   ORT_UNUSED_PARAMETER(alpha);
   ORT_UNUSED_PARAMETER(beta);
 
-  clip_for_sigmoid_in_place(ps2, c);
+  MlasComputeLogistic(ps2, ps2, c);
 
   for (int i = 0; i < c; i++) {
-    float x = 0.5f * ps2[i];
-    float x2 = x * x;
-    float p = x2 * alpha_13 + alpha_11;
-    p = x2 * p + alpha_9;
-    p = x2 * p + alpha_7;
-    p = x2 * p + alpha_5;
-    p = x2 * p + alpha_3;
-    p = x2 * p + alpha_1;
-    p = x * p;
-    float q = x2 * beta_6 + beta_4;
-    q = x2 * q + beta_2;
-    q = x2 * q + beta_0;
-    pd[i] = ps1[i] * 0.5f * (1 + p / q);
+    pd[i] = ps1[i] * ps2[i];
   }
 }
 
@@ -548,22 +466,10 @@ void gru_output_gate_tanh(float* ph, const float* pz, const float* ps, float* po
   ORT_UNUSED_PARAMETER(alpha);
   ORT_UNUSED_PARAMETER(beta);
 
-  clip_for_tanh_in_place(ph, c);
+  MlasComputeTanh(ph, ph, c);
 
   for (int i = 0; i < c; i++) {
-    float x = ph[i];
-    float x2 = x * x;
-    float p = x2 * alpha_13 + alpha_11;
-    p = x2 * p + alpha_9;
-    p = x2 * p + alpha_7;
-    p = x2 * p + alpha_5;
-    p = x2 * p + alpha_3;
-    p = x2 * p + alpha_1;
-    p = x * p;
-    float q = x2 * beta_6 + beta_4;
-    q = x2 * q + beta_2;
-    q = x2 * q + beta_0;
-    po[i] = (1 - pz[i]) * (p / q) + pz[i] * ps[i];
+    po[i] = (1 - pz[i]) * ph[i] + pz[i] * ps[i];
   }
 }
 
@@ -588,22 +494,10 @@ void gru_output_gate_sigmoid(float* ph, const float* pz, const float* ps, float*
   ORT_UNUSED_PARAMETER(alpha);
   ORT_UNUSED_PARAMETER(beta);
 
-  clip_for_sigmoid_in_place(ph, c);
+  MlasComputeLogistic(ph, ph, c);
 
   for (int i = 0; i < c; i++) {
-    float x = 0.5f * (ph[i]);
-    float x2 = x * x;
-    float p = x2 * alpha_13 + alpha_11;
-    p = x2 * p + alpha_9;
-    p = x2 * p + alpha_7;
-    p = x2 * p + alpha_5;
-    p = x2 * p + alpha_3;
-    p = x2 * p + alpha_1;
-    p = x * p;
-    float q = x2 * beta_6 + beta_4;
-    q = x2 * q + beta_2;
-    q = x2 * q + beta_0;
-    po[i] = (1 - pz[i]) * 0.5f * (1 + (p / q)) + pz[i] * ps[i];
+    po[i] = (1 - pz[i]) * ph[i] + pz[i] * ps[i];
   }
 }
 
@@ -8,8 +8,9 @@
 #endif
 
 #include <algorithm>
+#include <exception>
 #include <functional>
-#include <future>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -18,9 +19,12 @@
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
+#include "core/platform/ort_mutex.h"
 #include "core/platform/threadpool.h"
 
 namespace onnxruntime {
@@ -76,8 +80,8 @@ gsl::span<TAlloc> Allocate(std::shared_ptr<IAllocator> allocator,
 
 // validate the common inputs to RNN, LSTM and GRU operators
 Status ValidateCommonRnnInputs(const Tensor& X,
-                               const Tensor& W,
-                               const Tensor& R,
+                               const TensorShape& W_shape,
+                               const TensorShape& R_shape,
                                const Tensor* B,
                                int WRB_dim_1_multipler,  // multiplier used with hidden_size for W, R and B inputs
                                const Tensor* sequence_lens,
@@ -174,6 +178,100 @@ void ComputeGemm(const int M,
       &*C, ldc, tp);
 }
 
+// The weights of one direction of a recurrent op with shape [N, K], for use as matrix B of ComputeGemm.
+// They are either the original weights or a matrix packed once for MlasGemm by PackWeights.
+template <typename T>
+struct GemmWeights {
+  GemmWeights() = default;
+  explicit GemmWeights(gsl::span<const T> weights) : weights_(weights) {}
+  explicit GemmWeights(const void* packed) : packed_(packed) {}
+
+  gsl::span<const T> weights_;
+  const void* packed_ = nullptr;
+};
+
+// A weights input of a recurrent op with shape [num_directions, rows, K] packed for MlasGemm by PackWeights.
+// The rows of each direction may be split into blocks that are multiplied separately, e.g. the [zr] and [h]
+// gates of GRU. All the blocks are packed into one buffer so that it can be shared between sessions.
+struct PackedWeights {
+  BufferUniquePtr buffer_;
+  size_t buffer_size_ = 0;
+  // size in bytes of the packed blocks of one direction, and the offset of each block within them
+  size_t direction_size_ = 0;
+  std::vector<size_t> block_offsets_;
+  TensorShape shape_;
+
+  GemmWeights<float> Block(int direction, size_t block) const {
+    const auto* buffer = static_cast<const uint8_t*>(buffer_.get());
+    return GemmWeights<float>(buffer + direction * direction_size_ + block_offsets_[block]);
+  }
+};
+
+// Packs the float 'weights' input with shape [num_directions, rows, K] into 'packed', with the rows of each
+// direction split into blocks of 'block_rows' rows. Returns false if the weights are not packed.
+// The recurrent ops pack their constant W and R from PrePack, so the GEMMs for every step of the sequence skip the
+// packing that MlasGemm would otherwise repeat for every call. The original weights are released once they have
+// been packed, so Compute must take them from 'packed' then.
+bool PackWeights(const Tensor& weights, const AllocatorPtr& alloc, const std::vector<size_t>& block_rows,
+                 /*out*/ PackedWeights& packed);
+
+// Runs lambda(i) for i in [0, total) on the thread pool and rethrows the first exception it throws, e.g. from
+// ORT_ENFORCE, on the calling thread rather than letting it terminate the process from a pool or OpenMP thread.
+// The recurrent ops use it to run the independent directions of a bidirectional op concurrently. The GEMMs within
+// each direction share the same thread pool, which is safe as a loop started from a pool thread never waits for
+// queued work.
+template <typename TLambda>
+void ExecuteLambdaInParallel(concurrency::ThreadPool* thread_pool, int32_t total, TLambda lambda) {
+  std::exception_ptr error;
+  OrtMutex error_mutex;
+  concurrency::ThreadPool::TryParallelFor(thread_pool, total, [&](int32_t i) {
+    try {
+      lambda(i);
+    } catch (...) {
+      std::lock_guard<OrtMutex> lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  });
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+// Same as ComputeGemm above, with matrix B given as GemmWeights with ldb == K.
+template <typename TSpanAIter, typename TSpanCIter>
+void ComputeGemm(const int M,
+                 const int N,
+                 const int K,
+                 const float alpha,
+                 TSpanAIter A,
+                 TSpanAIter A_end,
+                 const int lda,
+                 const GemmWeights<float>& weights,
+                 const float beta,
+                 TSpanCIter C,
+                 TSpanCIter C_end,
+                 const int ldc, concurrency::ThreadPool* tp) {
+  if (weights.packed_ == nullptr) {
+    ComputeGemm(M, N, K, alpha, A, A_end, lda, weights.weights_.cbegin(), weights.weights_.cend(), K,
+                beta, C, C_end, ldc, tp);
+    return;
+  }
+
+  // validate all the inputs. the packed matrix B was validated when it was packed
+  ORT_ENFORCE(lda >= K && ldc >= N);
+  ORT_ENFORCE(A + (M * lda - (lda - K)) <= A_end);
+  ORT_ENFORCE(C + (M * ldc - (ldc - N)) <= C_end);
+
+  MlasGemm(CblasNoTrans,
+           static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K), alpha,
+           &*A, static_cast<size_t>(lda),
+           weights.packed_, beta,
+           &*C, static_cast<size_t>(ldc), tp);
+}
+
 // helper to convert a span to a raw pointer
 // after validating the memory covered by the span supports the size required
 template <typename T>
@@ -210,82 +308,6 @@ T* SafeRawPointer(typename gsl::span<T> span, size_t offset, size_t size) {
   return span.data() + offset;
 }
 
-template <typename TLambda>
-void ExecuteLambdaInParallel(const std::string& name, TLambda lambda, int max, int step,
-                             onnxruntime::concurrency::ThreadPool& ttp,
-                             const ::onnxruntime::logging::Logger& logger) {
-  // #define NOTHREADS to execute the lambdas directly and in order if you need to do that to debug
-
-#ifdef NOTHREADS
-  ORT_UNUSED_PARAMETER(ttp);
-  ORT_UNUSED_PARAMETER(logger);
-
-  for (int i = 0; i < max; i += step) {
-    (void)name;
-    std::bind(lambda, i)();
-  }
-#else
-
-  ORT_UNUSED_PARAMETER(name);
-  ORT_UNUSED_PARAMETER(logger);
-
-  // ORT_ENFORCE may and does throw at times from within the tasks that run
-  // on a thread-pool. Without propagating exceptions the process exits silently
-  // which will make diagnosing bugs more difficult.
-
-  // \! UGLY
-  // We have a problem here with the current thread-pool is that it takes std::function
-  // by value and copies it more than once (even though it is movable).
-  //
-  // To report status and exceptions properly it's better to use
-  // futures and promises but they are not copyable, so we can't come up with a functor
-  // with a promise member and we are downgrading to C++11 where we can't have captures that moved in.
-  //
-  // At the same time promises MUST live in the child thread so if we throw from the main thread
-  // we don't destroy any promises that are on the main thread stack which children threads may still be using.
-  //
-  // The only solution with the current Eigen that comes to mind is to have shared_ptr to with std::promise.
-  //
-  const int total_tasks = max / (step > 0 ? step : 1) + (max % step > 0 ? 1 : 0);
-  std::vector<std::future<void> > futures;
-  futures.reserve(total_tasks);
-
-  for (int i = 0, t = 0; i < max; i += step, ++t) {
-    auto p_ptr = std::make_shared<std::promise<void> >();
-    futures.push_back(p_ptr->get_future());
-    ttp.Schedule([p_ptr, lambda, i]() {
-      try {
-        lambda(i);
-        p_ptr->set_value();
-      } catch (...) {
-        p_ptr->set_exception(std::current_exception());
-      }
-    });
-  }
-
-  // We'd like to wait until all of the tasks have finished
-  // even though one or more have already thrown. We will store
-  // the first exception and then will re-throw at the end.
-  std::exception_ptr pending_exception;
-  for (auto& fut : futures) {
-    try {
-      // get() will re-throw any exceptions
-      // the running task may throw
-      fut.get();
-    } catch (...) {
-      if (!pending_exception) {
-        pending_exception = std::current_exception();
-      }
-    }
-  }
-
-  if (pending_exception) {
-    std::rethrow_exception(pending_exception);
-  }
-
-#endif
-}
-
 void DumpMatrixImpl(const std::string& name, const float* src, int row, int col,
                     int offset = 0, int col_width = -1);
 
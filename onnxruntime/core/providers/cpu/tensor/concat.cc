@@ -4,6 +4,7 @@
 #include "core/providers/cpu/tensor/concat.h"
 #include "core/providers/common.h"
 #include "core/framework/TensorSeq.h"
+#include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime {
 
@@ -151,51 +152,39 @@ Status ConcatBase::PrepareForCompute(OpKernelContext* ctx,
   return Status::OK();
 }
 
-// This method computes the output tensor for Concat/ConcatFromSequence ops
-Status ConcatBase::ComputeImpl(Prepare& p) const {
-  int input_count = static_cast<int>(p.inputs.size());
-  int64_t initial_output_offset = 0;  // initial offset for each input
-  auto element_bytes = p.output_tensor->DataType()->Size();
-  for (int input_index = 0; input_index < input_count; input_index++) {
-    const auto& prep = p.inputs[input_index];
+// Each input is copied as a region of blocks of 'input_axis_pitch' values. For every block copied, the output moves
+// over by the 'output_axis_pitch'. Concatenating on the outermost axis or stacking scalars makes the blocks contiguous
+// and the copy engine merges them into a single buffer copy.
+template <typename T>
+static void ConcatCopy(const Prepare& p, int64_t element_count, concurrency::ThreadPool* tp) {
+  std::vector<StridedCopyRegion<T>> regions;
+  regions.reserve(p.inputs.size());
 
+  T* output = static_cast<T*>(p.output_tensor->MutableDataRaw());
+  int64_t initial_output_offset = 0;  // initial offset for each input
+  for (const auto& prep : p.inputs) {
     // no data in this tensor - so skip it
     if (prep.num_elements == 0)
       continue;
 
-    auto input_axis_pitch = prep.axis_pitch;
-    const uint8_t* input = static_cast<const uint8_t*>(prep.tensor->DataRaw());
-
-    auto input_size = prep.num_elements;
-
-    // Copy the data across. For every 'input_axis_pitch' values copied, we move over by the 'output_axis_pitch'
-    // TODO: Optimization possibility: There are cases where we simply need to "merge" raw buffers and this 
-    // could be done without the pointer house-keeping as below. Some scenarios whether this is possible are:
-    // 1) Concatenating on input axis = 0
-    // 2) Stacking on output axis = 0
-    // 3) Stacking scalars
-    uint8_t* output = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
-    int64_t cur_out_offset = 0;
-    int64_t cur_in_offset = 0;
-    for (size_t idx_copy = 0, end = input_size / input_axis_pitch; idx_copy < end; ++idx_copy) {
-      if (p.is_string_type) {
-        size_t out = initial_output_offset + cur_out_offset;
-        for (int idx_item = 0; idx_item < input_axis_pitch; ++idx_item) {
-          reinterpret_cast<std::string*>(output)[out + idx_item] =
-              reinterpret_cast<const std::string*>(input)[cur_in_offset + idx_item];
-        }
-      } else {
-        memcpy(
-            output + (initial_output_offset + cur_out_offset) * element_bytes,
-            input + cur_in_offset * element_bytes,
-            input_axis_pitch * element_bytes);
-      }
-
-      cur_out_offset += p.output_axis_pitch;
-      cur_in_offset += input_axis_pitch;
-    }
+    const size_t input_axis_pitch = static_cast<size_t>(prep.axis_pitch * element_count);
+    regions.push_back({static_cast<const T*>(prep.tensor->DataRaw()), input_axis_pitch,
+                       output + initial_output_offset * element_count,
+                       static_cast<size_t>(p.output_axis_pitch * element_count),
+                       input_axis_pitch, static_cast<size_t>(prep.num_elements / prep.axis_pitch)});
 
-    initial_output_offset += input_axis_pitch;
+    initial_output_offset += prep.axis_pitch;
+  }
+
+  StridedCopy(tp, regions);
+}
+
+// This method computes the output tensor for Concat/ConcatFromSequence ops
+Status ConcatBase::ComputeImpl(Prepare& p, concurrency::ThreadPool* tp) const {
+  if (p.is_string_type) {
+    ConcatCopy<std::string>(p, 1, tp);
+  } else {
+    ConcatCopy<uint8_t>(p, static_cast<int64_t>(p.output_tensor->DataType()->Size()), tp);
   }
 
   return Status::OK();
@@ -224,7 +213,7 @@ Status Concat::Compute(OpKernelContext* ctx) const {
     return Status::OK();
 
   // Compute values to be placed in the output tensor
-  return ComputeImpl(p);
+  return ComputeImpl(p, ctx->GetOperatorThreadPool());
 }
 
 }  // namespace onnxruntime
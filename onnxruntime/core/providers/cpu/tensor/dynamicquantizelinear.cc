@@ -24,6 +24,32 @@ static float RoundHalfToEven(float input) {
   return result;
 }
 
+template <typename T>
+void GetQuantizationParameter(const float* data, int64_t num_of_elements, float& scale, T& zero_point) {
+  // find quantization range min and max
+  float qmax = std::numeric_limits<T>::max();
+  float qmin = std::numeric_limits<T>::min();
+  // Adjust the int8 range to -127 to 127 so that zero point can be 0
+  if (qmin == -128) {
+    qmin = -127;
+  }
+
+  // find input range min and max
+  auto min = ConstEigenVectorMap<float>(data, num_of_elements).minCoeff();
+  min = std::min(min, qmin);
+  auto max = ConstEigenVectorMap<float>(data, num_of_elements).maxCoeff();
+  max = std::max(max, qmin);
+
+  // find scale and zero point
+  scale = (max - min) / (qmax - qmin);
+
+  const auto initial_zero_point = qmin - min / scale;
+  zero_point = static_cast<T>(RoundHalfToEven(std::max(qmin, std::min(qmax, initial_zero_point))));
+}
+
+template void GetQuantizationParameter<uint8_t>(const float* data, int64_t num_of_elements,
+                                                float& scale, uint8_t& zero_point);
+
 // formula is Y = X / Scale + ZeroPoint
 template <typename T>
 Status DynamicQuantizeLinear<T>::Compute(OpKernelContext* ctx) const {
@@ -38,27 +64,13 @@ Status DynamicQuantizeLinear<T>::Compute(OpKernelContext* ctx) const {
   auto& y_scale = *ctx->Output(1, shape);
   auto& y_zeropoint = *ctx->Output(2, shape);
 
-  // find quantization range min and max
-  float qmax = std::numeric_limits<T>::max();
-  float qmin = std::numeric_limits<T>::min();
-  // Adjust the int8 range to -127 to 127 so that zero point can be 0
-  if (qmin == -128) {
-    qmin = -127;
-  }
-
-  // find input range min and max
-  auto min = ConstEigenVectorMap<float>(x_data, num_of_elements).minCoeff();
-  min = std::min(min, qmin);
-  auto max = ConstEigenVectorMap<float>(x_data, num_of_elements).maxCoeff();
-  max = std::max(max, qmin);
+  float scale;
+  T zero_point;
+  GetQuantizationParameter(x_data, num_of_elements, scale, zero_point);
 
-  // find scale and zero point
-  auto scale = (max - min) / (qmax - qmin);
   auto* output_scale = y_scale.template MutableData<float>();
   *output_scale = scale;
 
-  const auto initial_zero_point = qmin - min / scale;
-  auto zero_point = static_cast<T>(RoundHalfToEven(std::max(qmin, std::min(qmax, initial_zero_point))));
   auto* output_zp = y_zeropoint.template MutableData<T>();
   *output_zp = zero_point;
 
@@ -8,6 +8,10 @@
 
 namespace onnxruntime {
 
+// Computes the scale and zero point that DynamicQuantizeLinear uses to quantize the supplied data.
+template <typename T>
+void GetQuantizationParameter(const float* data, int64_t num_of_elements, float& scale, T& zero_point);
+
 template <typename T>
 class DynamicQuantizeLinear final : public OpKernel {
  public:
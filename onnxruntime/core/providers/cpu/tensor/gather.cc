@@ -4,6 +4,7 @@
 //https://github.com/onnx/onnx/blob/master/docs/Operators.md#Gather
 #include "core/providers/cpu/tensor/gather.h"
 #include "core/common/common.h"
+#include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime {
 
@@ -56,12 +57,12 @@ Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const
 template <typename Tin>
 Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uint8_t* dst_base, bool is_string_type,
                       const size_t element_bytes, const int64_t block_size, const int64_t M,
-                      const int64_t N, const int64_t data_batch_bytes, const int64_t gathered_batch_bytes,
-                      const TensorShape& input_data_shape, const int64_t axis) {
+                      const int64_t N, const int64_t data_batch_bytes, const TensorShape& input_data_shape,
+                      const int64_t axis, concurrency::ThreadPool* tp) {
   const Tin* indices_data = indices_tensor->template Data<Tin>();
 
   // Check the indices first in case there's a out of bound index.
-  // We can't merge this code in the omp loop below as omp does not allow return in the loop
+  // We can't return from within the parallel copy below.
   auto axis_dim_limit = input_data_shape[axis];
 
   for (int64_t i = 0; i < N; ++i) {
@@ -73,26 +74,21 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
     }
   }
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t index = 0; index < M * N; ++index) {
-    int64_t batch = index / N;
-    int64_t i = index % N;
-
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    Tin idx = indices_data[i];
-    idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
-    const int64_t src_offset = src_offset_batch + idx * block_size;
-    const int64_t dst_offset = dst_offset_batch + i * block_size;
-
-    if (is_string_type) {
-      reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-          reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
-    } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, block_size);
-    }
+  // The output is M * N contiguous blocks. Block 'index' comes from batch 'index / N' of the input, at the
+  // position along the axis given by indices_data[index % N].
+  auto src_offset = [&](size_t index) {
+    const int64_t batch = static_cast<int64_t>(index) / N;
+    int64_t idx = static_cast<int64_t>(indices_data[static_cast<int64_t>(index) % N]);
+    idx = idx < 0 ? idx + axis_dim_limit : idx;
+    return static_cast<size_t>(batch * data_batch_bytes + idx * block_size);
+  };
+
+  if (is_string_type) {
+    GatherCopy(tp, reinterpret_cast<const std::string*>(src_base), reinterpret_cast<std::string*>(dst_base),
+               static_cast<size_t>(block_size) / element_bytes, static_cast<size_t>(M * N),
+               [&](size_t index) { return src_offset(index) / element_bytes; });
+  } else {
+    GatherCopy(tp, src_base, dst_base, static_cast<size_t>(block_size), static_cast<size_t>(M * N), src_offset);
   }
 
   return Status::OK();
@@ -112,18 +108,19 @@ Status Gather::Compute(OpKernelContext* context) const {
   const int64_t M = input_data_shape.SizeToDimension(p.axis);
   const int64_t N = p.indices_tensor->Shape().Size();
   const int64_t data_batch_bytes = input_data_shape.SizeFromDimension(p.axis) * element_bytes;
-  const int64_t gathered_batch_bytes = N * block * element_bytes;
 
   const auto* src_base = static_cast<const uint8_t*>(p.input_tensor->DataRaw());
   auto* dst_base = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
 
   if (p.indices_tensor->IsDataType<int32_t>()) {
     return GatherCopyData<int32_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis);
+                                   block_size, M, N, data_batch_bytes, input_data_shape, p.axis,
+                                   context->GetOperatorThreadPool());
   }
   if (p.indices_tensor->IsDataType<int64_t>()) {
     return GatherCopyData<int64_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis);
+                                   block_size, M, N, data_batch_bytes, input_data_shape, p.axis,
+                                   context->GetOperatorThreadPool());
   }
 
   return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Type for Tind not supported yet in Gather.");
@@ -2,7 +2,7 @@
 // Licensed under the MIT License.
 
 #include "gather_elements.h"
-#include "onnxruntime_config.h"
+#include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime {
 
@@ -114,15 +114,9 @@ static std::vector<int64_t> parse_and_validate_indices_tensor(const Tensor* indi
   return indices_data;
 }
 
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#ifdef HAS_CLASS_MEMACCESS
-#pragma GCC diagnostic ignored "-Wclass-memaccess"
-#endif
-#endif
 template <bool is_string, typename T>
 static void core_impl(const Tensor* input_tensor, const Tensor* indices_tensor,
-                      Tensor* output_tensor, int64_t axis) {
+                      Tensor* output_tensor, int64_t axis, concurrency::ThreadPool* tp) {
   // get pointer to input data
   // optimizer will remove the redundant if/else block based on 'is_string' template parameter
   const T* input_data = nullptr;
@@ -147,60 +141,36 @@ static void core_impl(const Tensor* input_tensor, const Tensor* indices_tensor,
   const std::vector<int64_t>& indices_data = parse_and_validate_indices_tensor(indices_tensor, axis, input_tensor->Shape());
   const TensorShape& indices_shape = indices_tensor->Shape();
 
-  int64_t num_inner_dim = calculate_num_inner_dim(indices_shape);
-  int64_t inner_dim_size = indices_shape[input_rank - 1];
-  bool processing_inner_dim = (axis == input_rank - 1) ? true : false;
+  const int64_t num_inner_dim = calculate_num_inner_dim(indices_shape);
+  const int64_t inner_dim_size = indices_shape[input_rank - 1];
+  const bool processing_inner_dim = (axis == input_rank - 1) ? true : false;
+  const int64_t axis_pitch = input_shape_pitches[axis];
 
-  int64_t base_offset = 0;
-  int64_t indices_counter = -1;
-  int64_t output_counter = -1;
-  size_t element_size = input_tensor->DataType()->Size();
+  // strings are copied one element at a time. other types are copied as a block of element_size bytes.
+  const size_t element_size = is_string ? 1 : input_tensor->DataType()->Size();
 
+  // cache the base offset of every 'inner dimension' chunk so the per element offsets are cheap to compute
+  // from any thread
+  std::vector<int64_t> base_offsets(num_inner_dim);
   std::vector<int64_t> process_dims(input_rank, 0);
-
-  if (!processing_inner_dim) {
-    while (num_inner_dim-- != 0) {
-      base_offset = compute_base_offset(process_dims, input_shape_pitches, axis);
-
-      // process 1 chunk of 'inner dimension' length
-      for (int64_t i = 0; i < inner_dim_size; ++i) {
-        // optimizer will remove the redundant if/else block based on 'is_string' template parameter
-        if (is_string) {
-          output_data[++output_counter] = input_data[base_offset + (indices_data[++indices_counter] * input_shape_pitches[axis]) + i];
-        } else {
-          memcpy(output_data,
-                 input_data + (base_offset + (indices_data[++indices_counter] * input_shape_pitches[axis]) + i) * element_size, element_size);
-          output_data += element_size;
-        }
-      }
-
-      increment_over_inner_dim(process_dims, indices_shape);
-    }
+  for (int64_t chunk = 0; chunk < num_inner_dim; ++chunk) {
+    base_offsets[chunk] = compute_base_offset(process_dims, input_shape_pitches, axis);
+    increment_over_inner_dim(process_dims, indices_shape);
   }
-  // we special-case inner dim as we can weed-out some unnecessary computations in element offset calculations
-  else {
-    while (num_inner_dim-- != 0) {
-      base_offset = compute_base_offset(process_dims, input_shape_pitches, axis);
-
-      // process 1 chunk of 'inner dimension' length
-      for (int64_t i = 0; i < inner_dim_size; ++i) {
-        // for innermost axis, input_shape_pitches[axis] = 1 (so no need to multiply)
-        // optimizer will remove the redundant if/else block based on 'is_string' template parameter
-        if (is_string) {
-          output_data[++output_counter] = input_data[base_offset + indices_data[++indices_counter]];
-        } else {
-          memcpy(output_data, input_data + (base_offset + indices_data[++indices_counter]) * element_size, element_size);
-          output_data += element_size;
-        }
-      }
-
-      increment_over_inner_dim(process_dims, indices_shape);
+
+  // we special-case inner dim as we can weed-out some unnecessary computations in element offset calculations.
+  // for innermost axis, input_shape_pitches[axis] = 1 and the position within the chunk comes from the index.
+  auto element_offset = [&](size_t i) {
+    const int64_t index = static_cast<int64_t>(i);
+    int64_t offset = base_offsets[index / inner_dim_size] + indices_data[index] * axis_pitch;
+    if (!processing_inner_dim) {
+      offset += index % inner_dim_size;
     }
-  }
+    return static_cast<size_t>(offset) * element_size;
+  };
+
+  GatherCopy(tp, input_data, output_data, element_size, static_cast<size_t>(indices_shape.Size()), element_offset);
 }
-#ifdef __GNUC__
-#pragma GCC diagnostic pop
-#endif
 
 Status GatherElements::ValidateInputShapes(const TensorShape& input_data_shape,
                                            const TensorShape& indices_shape,
@@ -260,12 +230,11 @@ Status GatherElements::Compute(OpKernelContext* context) const {
   if (indices_shape.Size() == 0)
     return Status::OK();
 
-
   if (input_tensor->IsDataTypeString())
-    core_impl<true, std::string>(input_tensor, indices_tensor, output_tensor, axis);
+    core_impl<true, std::string>(input_tensor, indices_tensor, output_tensor, axis, context->GetOperatorThreadPool());
 
   else
-    core_impl<false, int8_t>(input_tensor, indices_tensor, output_tensor, axis);
+    core_impl<false, int8_t>(input_tensor, indices_tensor, output_tensor, axis, context->GetOperatorThreadPool());
 
   return Status::OK();
 }
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "gather_nd.h"
+#include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime {
 
@@ -110,30 +111,20 @@ Status GatherND::Compute(OpKernelContext* context) const {
                           ? PrepareForCompute<int32_t>(context, p)
                           : PrepareForCompute<int64_t>(context, p));
 
-  return nullptr == p.input_str_base ? GatherNumber(p) : GatherString(p);
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  return nullptr == p.input_str_base ? GatherNumber(p, tp) : GatherString(p, tp);
 }
 
-Status GatherND::GatherNumber(const Prepare& p) const {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    memcpy(p.output_base + i * p.bytes_to_copy, p.input_base + p.element_offsets[i] * p.element_bytes,
-           p.bytes_to_copy);
-  }
+Status GatherND::GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
+  GatherCopy(tp, p.input_base, p.output_base, p.bytes_to_copy, p.element_offsets.size(),
+             [&p](size_t i) { return p.element_offsets[i] * p.element_bytes; });
 
   return Status::OK();
 }
 
-Status GatherND::GatherString(const Prepare& p) const {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    for (int64_t j = 0; j < static_cast<int64_t>(p.element_to_copy); ++j) {
-      p.output_str_base[i * p.element_to_copy + j] = p.input_str_base[p.element_offsets[i] + j];
-    }
-  }
+Status GatherND::GatherString(const Prepare& p, concurrency::ThreadPool* tp) const {
+  GatherCopy(tp, p.input_str_base, p.output_str_base, p.element_to_copy, p.element_offsets.size(),
+             [&p](size_t i) { return p.element_offsets[i]; });
 
   return Status::OK();
 }
@@ -241,9 +241,6 @@ Status PadCpuImpl(OpKernelContext* ctx,
     return PadInputWithDimValueOfZero(ctx, mode, orig_input_shape, output_dims, value);
   }
 
-  TensorShape input_shape(reshaped_input_dims);
-  SliceIterator<T> input(input_tensor, input_shape, input_starts, input_extents, {});
-
   // output_shape need to keep original.
   TensorShape output_shape(output_dims);
   auto& output_tensor = *ctx->Output(0, output_shape);
@@ -256,6 +253,52 @@ Status PadCpuImpl(OpKernelContext* ctx,
   for (size_t i = 0; i < new_dims_count; i++)
     alignSkip += reshaped_pad[i] * output_pitches[i];
 
+  // Copy the input data into the output first. The innermost two axes are a strided region in both the input and
+  // the output, so there is one region per index of the outer axes and StridedCopy spreads the rows across the
+  // thread pool. The padding is written afterwards by walking the output, as edge and reflect padding read back
+  // the data copied to the output.
+  {
+    const T* input_data = input_tensor.template Data<T>();
+    TensorPitches input_pitches(reshaped_input_dims);
+
+    size_t input_offset = 0;
+    for (size_t i = 0; i < new_dims_count; i++)
+      input_offset += input_starts[i] * input_pitches[i];
+
+    std::vector<StridedCopyRegion<T>> regions;
+    if (new_dims_count == 1) {
+      regions.push_back({input_data + input_offset, 0, output + alignSkip, 0,
+                         static_cast<size_t>(input_extents[0]), 1});
+    } else {
+      const size_t row_axis = new_dims_count - 2;
+      size_t num_regions = 1;
+      for (size_t i = 0; i < row_axis; i++)
+        num_regions *= static_cast<size_t>(input_extents[i]);
+
+      regions.reserve(num_regions);
+      std::vector<int64_t> indices(row_axis, 0);
+      size_t output_offset = alignSkip;
+      for (size_t region = 0; region < num_regions; region++) {
+        regions.push_back({input_data + input_offset, static_cast<size_t>(input_pitches[row_axis]),
+                           output + output_offset, static_cast<size_t>(output_pitches[row_axis]),
+                           static_cast<size_t>(input_extents[inner_axis]), static_cast<size_t>(input_extents[row_axis])});
+
+        for (size_t axis = row_axis; axis-- > 0;) {
+          input_offset += input_pitches[axis];
+          output_offset += output_pitches[axis];
+          if (++indices[axis] != input_extents[axis])
+            break;
+          indices[axis] = 0;
+          input_offset -= input_pitches[axis] * input_extents[axis];
+          output_offset -= output_pitches[axis] * input_extents[axis];
+        }
+      }
+    }
+
+    StridedCopy(ctx->GetOperatorThreadPool(), regions);
+  }
+
+  const size_t inner_extent = static_cast<size_t>(input_extents[inner_axis]);
   ExtentAxisCounters input_counters(input_extents);
 
   switch (mode) {
@@ -267,7 +310,7 @@ Status PadCpuImpl(OpKernelContext* ctx,
         output += alignSkip;
         {
           T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
+          output += inner_extent;
 
           int64_t prePad = reshaped_pad[inner_axis];
           int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
@@ -298,7 +341,7 @@ Status PadCpuImpl(OpKernelContext* ctx,
         output += alignSkip;
         {
           T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
+          output += inner_extent;
 
           int64_t prePad = reshaped_pad[inner_axis];
           int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
@@ -329,7 +372,7 @@ Status PadCpuImpl(OpKernelContext* ctx,
         output += alignSkip;
         {
           T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
+          output += inner_extent;
 
           int64_t prePad = reshaped_pad[inner_axis];
           int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
@@ -328,36 +328,63 @@ Status SliceImpl(OpKernelContext* ctx,
   if (output_shape.Size() == 0)
     return Status::OK();
 
-  auto* output = output_tensor.template MutableData<T>();
-  const auto* output_end = output + output_tensor.Shape().Size();
+  // if we have flattened output dims we need to also flatten the input dims.
+  // as we're combining the innermost dims and keeping all values we can just copy the size of the last dim
+  std::vector<int64_t> input_dims(input_tensor.Shape().GetDims());
+  const std::vector<int64_t>& extents = flattened_output_dims ? *flattened_output_dims : output_dims;
+  if (flattened_output_dims) {
+    input_dims.resize(extents.size());
+    input_dims.back() = extents.back();
+  }
 
-  auto create_output = [&output, &output_end](SliceIterator<T>& input_iterator) {
-    if (input_iterator.SolitaryInnerStep()) {
-      while (output < output_end) {
-        output = input_iterator.CopyInnermostAxisSolitaryInnerStep(output);
-      }
-    } else {
-      while (output < output_end) {
-        output = input_iterator.CopyInnermostAxisNonSolitaryInnerStep(output);
+  const TensorPitches input_pitches(input_dims);
+  const size_t rank = extents.size();
+  const int64_t inner_step = steps[rank - 1];
+  const size_t inner_extent = static_cast<size_t>(extents[rank - 1]);
+  const size_t num_rows = static_cast<size_t>(output_shape.Size()) / inner_extent;
+
+  const T* input = input_tensor.template Data<T>();
+  T* output = output_tensor.template MutableData<T>();
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
+  // offset of the first element to copy
+  int64_t offset = 0;
+  for (size_t i = 0; i < rank; ++i) {
+    offset += starts[i] * input_pitches[i];
+  }
+
+  // a single contiguous run, which StridedCopy splits into chunks for the thread pool
+  if (num_rows == 1 && inner_step == 1) {
+    StridedCopy(tp, input + offset, 0, output, 0, inner_extent, 1);
+    return Status::OK();
+  }
+
+  // cache the input offset of the start of every output row (innermost axis) so the copy can start at any
+  // row from any thread
+  std::vector<int64_t> row_offsets(num_rows);
+  std::vector<int64_t> indices(rank, 0);
+  for (size_t row = 0; row < num_rows; ++row) {
+    row_offsets[row] = offset;
+    for (size_t axis = rank - 1; axis-- > 0;) {
+      offset += steps[axis] * input_pitches[axis];
+      if (++indices[axis] != extents[axis]) {
+        break;
       }
+      indices[axis] = 0;
+      offset -= steps[axis] * input_pitches[axis] * extents[axis];
     }
+  }
 
-    ORT_ENFORCE(output == output_end);
-  };
-
-  if (flattened_output_dims) {
-    // if we have flattened output dims we need to also flatten the input dims.
-    // as we're combining the innermost dims and keeping all values we can just copy the size of the last dim
-    std::vector<int64_t> flattened_input_dims(input_tensor.Shape().GetDims());
-    flattened_input_dims.resize(flattened_output_dims->size());
-    flattened_input_dims.back() = flattened_output_dims->back();
-    TensorShape input_shape(std::move(flattened_input_dims));
-
-    auto input_iterator = SliceIterator<T>(input_tensor, input_shape, starts, *flattened_output_dims, steps);
-    create_output(input_iterator);
+  if (inner_step == 1) {
+    GatherCopy(tp, input, output, inner_extent, num_rows,
+               [&row_offsets](size_t row) { return static_cast<size_t>(row_offsets[row]); });
   } else {
-    auto input_iterator = SliceIterator<T>(input_tensor, starts, output_dims, steps);
-    create_output(input_iterator);
+    // a non unit step along the innermost axis copies one element at a time
+    GatherCopy(tp, input, output, 1, num_rows * inner_extent,
+               [&row_offsets, inner_extent, inner_step](size_t i) {
+                 return static_cast<size_t>(row_offsets[i / inner_extent] +
+                                            static_cast<int64_t>(i % inner_extent) * inner_step);
+               });
   }
 
   return Status::OK();
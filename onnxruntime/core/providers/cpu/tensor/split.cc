@@ -3,8 +3,7 @@
 
 #include "core/providers/cpu/tensor/split.h"
 #include "core/providers/common.h"
-#include "core/util/math.h"
-#include "core/util/math_cpuonly.h"
+#include "core/providers/cpu/tensor/utils.h"
 
 #include "gsl/gsl"
 
@@ -91,17 +90,6 @@ Status Split::Compute(OpKernelContext* context) const {
   return status;
 }
 
-template <typename T>
-inline void copy_data(const T* src, T* dst, size_t count) {
-  memcpy(dst, src, count * sizeof(T));
-}
-
-template <>
-inline void copy_data<std::string>(const std::string* src, std::string* dst, size_t count) {
-  const std::string* end = src + count;
-  std::copy(src, end, dst);
-}
-
 template <typename T>
 Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
   auto& input_shape = input.Shape();
@@ -127,6 +115,11 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
   int64_t input_offset = 0;
   const T* input_data = input.template Data<T>();
 
+  // each output is a region of before_dims blocks. the blocks are contiguous in the output and
+  // after_dims_including_split_axis apart in the input.
+  std::vector<StridedCopyRegion<T>> regions;
+  regions.reserve(num_outputs);
+
   for (int i = 0; i < num_outputs; ++i) {
     // update size of dimension for axis we're splitting on
     auto split_size = gsl::narrow<int>(split_sizes[i]);
@@ -135,20 +128,15 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
     Tensor* output = context.Output(i, TensorShape{output_dimensions});
     T* output_data = output->template MutableData<T>();
 
-    ::onnxruntime::math::CopyMatrix<T>(
-        before_dims,                                       // M
-        split_size * after_dims_excluding_split,           // N
-        static_cast<const T*>(input_data + input_offset),  // A
-        after_dims_including_split_axis,                   // lda
-        static_cast<T*>(output_data),                      // B
-        split_size * after_dims_excluding_split,           // ldb
-        [](const T* src, T* dst, size_t count) {
-          copy_data<T>(src, dst, count);
-        });
+    const size_t block_size = static_cast<size_t>(split_size) * after_dims_excluding_split;
+    regions.push_back({input_data + input_offset, static_cast<size_t>(after_dims_including_split_axis),
+                       output_data, block_size, block_size, static_cast<size_t>(before_dims)});
 
     input_offset += split_size * after_dims_excluding_split;  // offset by the N data we used in this iteration
   }
 
+  StridedCopy(context.GetOperatorThreadPool(), regions);
+
   return Status::OK();
 }
 
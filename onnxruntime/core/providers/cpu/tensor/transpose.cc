@@ -2,10 +2,16 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/transpose.h"
+
+#include <algorithm>
+#include <numeric>
+
 #include "core/framework/utils.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 namespace onnxruntime {
 
-/* A permutation [a,b,c,...] indicates that 
+/* A permutation [a,b,c,...] indicates that
    - The 0-th dimension of the output corresponds to the a-th dimension of input
    - The 1-st dimension of the output corresponds to the b-th dimension of input
    - The 2-nd dimension of the output corresponds to the c-th dimension of input
@@ -34,13 +40,6 @@ static inline void IncrementIndex(std::vector<int64_t>& index, const std::vector
 
 // DoTransposeSingleBlock: specialization of DoTranspose for the num_blocks=1 case.
 // copies source tensor to target, transposing elements.
-static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const void* source, void* target,
-                                          size_t element_size) {
-  size_t blocksize = num_elts_in_block * element_size;
-  // copy
-  memcpy(target, source, blocksize);
-}
-
 static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const std::string* source, std::string* target) {
   const std::string* end = source + num_elts_in_block;
   std::copy(source, end, target);
@@ -48,25 +47,6 @@ static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const std::s
 
 // DoTranspose: copies source tensor to target, transposing elements.
 // The stride vector indicates the transposition.
-static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
-                            size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
-                            const uint8_t* source, uint8_t* target, size_t element_size) {
-  size_t blocksize = num_elts_in_block * element_size;
-  // index used to iterate over target iteration-space
-  std::vector<int64_t> target_index(num_axes, 0);
-  for (size_t i = 0; i < num_blocks; ++i) {
-    // convert target_index into an offset in source data
-    size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-    // copy
-    memcpy(target, source + source_offset * element_size, blocksize);
-
-    // increment target_index:
-    IncrementIndex(target_index, target_dims, num_axes);
-    target += blocksize;
-  }
-}
-
 static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
                             size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
                             const std::string* source, std::string* target) {
@@ -85,78 +65,9 @@ static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target
   }
 }
 
-template <class T>
-inline void CopyPrim(uint8_t* target, const uint8_t* source) {
-  *reinterpret_cast<T*>(target) = *reinterpret_cast<const T*>(source);
-}
-
 // DoTransposeEltWise: specialization of DoTranspose for the num_elts_in_block=1 case.
 // copies source tensor to target, transposing elements.
 // The stride vector indicates the transposition.
-static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& target_dims, size_t num_blocks,
-                               const std::vector<size_t>& stride, const uint8_t* source, uint8_t* target,
-                               size_t element_size) {
-  // index used to iterate over target iteration-space
-  std::vector<int64_t> target_index(num_axes, 0);
-
-  switch (element_size) {
-    case sizeof(uint64_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        CopyPrim<uint64_t>(target, source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
-      break;
-    case sizeof(uint32_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        CopyPrim<uint32_t>(target, source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
-      break;
-    case sizeof(uint16_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        CopyPrim<uint16_t>(target, source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
-      break;
-    case sizeof(uint8_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        *target = *(source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
-      break;
-    default:
-      assert(false);
-  }
-}
-
 static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& target_dims, size_t num_blocks,
                                const std::vector<size_t>& stride, const std::string* source, std::string* target) {
   // index used to iterate over target iteration-space
@@ -174,14 +85,11 @@ static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& tar
   }
 }
 
-static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output) {
+static Status DoStringTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output) {
   const auto& input_shape = input.Shape();
   const auto& input_dims = input_shape.GetDims();
   auto rank = input_shape.NumDimensions();
 
-  const auto element_size = input.DataType()->Size();
-  const bool is_string_type = input.IsDataTypeString();
-
   std::vector<size_t> stride(rank);
   for (size_t i = 0; i < rank; i++) {
     size_t inpdim = permutations[i];
@@ -209,326 +117,252 @@ static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const
     }
   }
 
-  if (is_string_type) {
-    const auto* input_data = input.template Data<std::string>();
-    auto* output_data = output.template MutableData<std::string>();
-    if (1 == prefix_blocksize) {
-      DoTransposeSingleBlock(suffix_blocksize, input_data, output_data);
-    } else if (1 == suffix_blocksize) {
-      DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                         input_data, output_data);
-    } else {
-      DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                      input_data, output_data);
-    }
+  const auto* input_data = input.template Data<std::string>();
+  auto* output_data = output.template MutableData<std::string>();
+  if (1 == prefix_blocksize) {
+    DoTransposeSingleBlock(suffix_blocksize, input_data, output_data);
+  } else if (1 == suffix_blocksize) {
+    DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
+                       input_data, output_data);
   } else {
-    const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-    auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
-    if (1 == prefix_blocksize) {
-      DoTransposeSingleBlock(suffix_blocksize, input_data, output_data, element_size);
-    } else if (1 == suffix_blocksize) {
-      DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                         input_data, output_data, element_size);
-    } else {
-      DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                      input_data, output_data, element_size);
-    }
+    DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
+                    input_data, output_data);
   }
 
   return Status::OK();
 }
 
 /*
-Optimizations for moving a single axis either inwards or outwards.
+Numeric transposes are reduced to a batch of 2D transposes.
 
-If moving outwards we can use a single reader and multiple writers. The number of writers is equal to the value of 
-the axis being moved.
+Axes of size 1 are dropped, and input axes that stay adjacent and in the same order in the output are merged into a
+single axis. If the innermost input axis is then also the innermost output axis, it is folded into the element so
+that each element of the transpose is a contiguous block of bytes.
 
-  e.g. if the input is NHWC with shape {N, 300, 300, 3}, we can transpose to NCHW by reading once and having
-       one writer for each of the 3 channels at a different offset in the output, updating the offset for each item
-       in the batch of N.
+What remains is a 2D transpose between the input axis that becomes the innermost output axis (the rows) and the
+innermost input axis (the columns), repeated for every index of the other axes (the batch).
 
-Similarly if one axis is moving inwards we can use a single writer and multiple readers. The number of readers is equal
-to the value of the axis being moved.
+  e.g. NCHW -> NHWC reduces to {N, C, H*W} with permutation {0, 2, 1}, so N transposes of a C x HW matrix.
+       The attention head permute {B, S, N, H} -> {B, N, S, H} reduces to {B, S, N} blocks of H elements with
+       permutation {0, 2, 1}, so B transposes of a S x N matrix of blocks.
 
-  e.g. if the input is NCHW with shape {N, 3, 300, 300}, we can transpose to NHWC by writing once using one reader for
-       each of the 3 channels at a different offset in the input, updating the read offset for each item in the batch
-       of N.
-
-This can be generalized for any input where only one axis is being moved, with the block size for each read/write
-being dependent on which axis is moving, what direction it's moving in, and where it's moving to.
-
-We use simple pointer arithmetic if the size of each read/write is a power of 2 and between 8 and 64 bits. 
-We use memcpy if the block size is larger.
-
-We fall back to the default implementation in all other cases, and if the input is std::string.
+Blocks of 1, 2, 4 or 8 bytes use the cache tiled MLAS transpose kernels. Other block sizes are copied with memcpy.
+The batch and the rows of each 2D transpose are split across the thread pool.
 */
 
-// moving a single axis outwards where the read/write size is a power of 2 and between 8 and 64 bits.
-template <typename T>
-static void SimpleTransposeSingleAxisOutwards(const T* input_data, T* output_data,
-                                              int64_t num_loops, int64_t num_writers,
-                                              int64_t writes_per_loop, int64_t writes_per_writer_per_loop) {
-  std::vector<T*> writers;
-  writers.resize(num_writers);
-
-  for (int64_t l = 0; l < num_loops; ++l) {
-    for (auto w = 0; w < num_writers; ++w) {
-      writers[w] = (output_data + (w * writes_per_writer_per_loop));
+namespace {
+
+struct TransposePlan {
+  size_t block_size = 0;  // bytes in each element of the 2D transposes
+  size_t rows = 1;        // rows of the 2D transposes. this input axis is the innermost output axis.
+  size_t cols = 1;        // columns of the 2D transposes. this is the innermost input axis.
+  size_t input_ld = 0;    // number of blocks between rows in the input
+  size_t output_ld = 0;   // number of blocks between columns in the output
+
+  // the remaining axes in output order, with their strides in blocks
+  std::vector<size_t> batch_dims;
+  std::vector<size_t> batch_input_strides;
+  std::vector<size_t> batch_output_strides;
+};
+
+}  // namespace
+
+static TransposePlan PlanTranspose(const std::vector<size_t>& permutations, const std::vector<int64_t>& input_dims,
+                                   size_t element_size) {
+  const size_t rank = input_dims.size();
+
+  // drop the axes of size 1
+  std::vector<size_t> compact_axis(rank);
+  std::vector<size_t> dims;
+  for (size_t i = 0; i < rank; ++i) {
+    compact_axis[i] = dims.size();
+    if (input_dims[i] != 1) {
+      dims.push_back(static_cast<size_t>(input_dims[i]));
     }
+  }
 
-    for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-      for (int64_t w = 0; w < num_writers; ++w) {
-        *(writers[w]++) = *input_data++;
-      }
+  // merge the runs of consecutive input axes in the output. each group is the first and last input axis of a run,
+  // in output order.
+  std::vector<std::pair<size_t, size_t>> groups;
+  for (size_t i = 0; i < rank; ++i) {
+    if (input_dims[permutations[i]] == 1) {
+      continue;
     }
 
-    output_data += writes_per_loop;
+    size_t axis = compact_axis[permutations[i]];
+    if (!groups.empty() && groups.back().second + 1 == axis) {
+      groups.back().second = axis;
+    } else {
+      groups.emplace_back(axis, axis);
+    }
   }
-}
-
-static void TranposeSingleAxisOutwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                       int64_t from, int64_t to) {
-  ORT_UNUSED_PARAMETER(permutations);
 
-  const auto& input_shape = input.Shape();
-  const auto& input_dims = input_shape.GetDims();
-
-  const auto element_size = input.DataType()->Size();
-
-  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
+  // the merged input axes are the groups sorted by their first input axis
+  const size_t merged_rank = groups.size();
+  std::vector<size_t> input_order(merged_rank);
+  std::iota(input_order.begin(), input_order.end(), size_t{0});
+  std::sort(input_order.begin(), input_order.end(),
+            [&groups](size_t a, size_t b) { return groups[a].first < groups[b].first; });
+
+  std::vector<size_t> merged_dims(merged_rank);
+  std::vector<size_t> merged_perm(merged_rank);
+  for (size_t i = 0; i < merged_rank; ++i) {
+    const auto& group = groups[input_order[i]];
+    merged_dims[i] = std::accumulate(dims.begin() + group.first, dims.begin() + group.second + 1, size_t{1},
+                                     std::multiplies<size_t>());
+    merged_perm[input_order[i]] = i;
+  }
 
-  auto num_loops = input_shape.SizeToDimension(to);
-  auto num_writers = input_dims[from];
-  auto block_size = input_shape.SizeFromDimension(from + 1);
-  auto writes_per_loop = int64_t(input_shape.Size() / num_loops / block_size);
-  auto writes_per_writer_per_loop = int64_t(writes_per_loop / num_writers);
-  const int64_t bytes_per_write = block_size * element_size;
-
-  switch (bytes_per_write) {
-    case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisOutwards(input_data, output_data,
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint16_t*>(input_data),
-                                        reinterpret_cast<uint16_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint32_t*>(input_data),
-                                        reinterpret_cast<uint32_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint64_t*>(input_data),
-                                        reinterpret_cast<uint64_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    default: {
-      // we need to use memcpy for each block
-      std::vector<uint8_t*> writers;
-      writers.resize(num_writers);
+  TransposePlan plan;
+  plan.block_size = element_size;
 
-      for (int64_t l = 0; l < num_loops; ++l) {
-        for (auto w = 0; w < num_writers; ++w) {
-          writers[w] = (output_data + (w * writes_per_writer_per_loop * bytes_per_write));
-        }
+  // fold the innermost axis into the block if it doesn't move. a fully merged transpose is a single block copy.
+  size_t num_axes = merged_rank;
+  if (num_axes > 0 && merged_perm[num_axes - 1] == num_axes - 1) {
+    plan.block_size *= merged_dims[num_axes - 1];
+    --num_axes;
+  }
 
-        for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-          for (int64_t w = 0; w < num_writers; ++w) {
-            memcpy(writers[w], input_data, bytes_per_write);
-            writers[w] += bytes_per_write;
-            input_data += bytes_per_write;
-          }
-        }
+  if (num_axes == 0) {
+    return plan;
+  }
 
-        output_data += writes_per_loop * bytes_per_write;
-      }
-    }
+  // strides of the input axes in the input and in the output
+  std::vector<size_t> input_strides(num_axes);
+  std::vector<size_t> output_strides(num_axes);
+  for (size_t i = num_axes, input_stride = 1, output_stride = 1; i-- > 0;) {
+    input_strides[i] = input_stride;
+    input_stride *= merged_dims[i];
+    output_strides[merged_perm[i]] = output_stride;
+    output_stride *= merged_dims[merged_perm[i]];
   }
-}
 
-template <typename T>
-static void SimpleTransposeSingleAxisInwards(const T* input_data, T* output_data,
-                                             int64_t num_loops, int64_t num_readers,
-                                             int64_t reads_per_loop, int64_t reads_per_reader_per_loop) {
-  std::vector<const T*> readers;
-  readers.resize(num_readers);
+  const size_t row_axis = merged_perm[num_axes - 1];
+  const size_t col_axis = num_axes - 1;
 
-  for (int64_t l = 0; l < num_loops; ++l) {
-    for (auto r = 0; r < num_readers; ++r) {
-      readers[r] = (input_data + (r * reads_per_reader_per_loop));
-    }
+  plan.rows = merged_dims[row_axis];
+  plan.cols = merged_dims[col_axis];
+  plan.input_ld = input_strides[row_axis];
+  plan.output_ld = output_strides[col_axis];
 
-    for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-      for (int64_t r = 0; r < num_readers; ++r) {
-        *output_data++ = *(readers[r]++);
-      }
+  for (size_t i = 0; i < num_axes; ++i) {
+    size_t axis = merged_perm[i];
+    if (axis != row_axis && axis != col_axis) {
+      plan.batch_dims.push_back(merged_dims[axis]);
+      plan.batch_input_strides.push_back(input_strides[axis]);
+      plan.batch_output_strides.push_back(output_strides[axis]);
     }
-
-    input_data += reads_per_loop;
   }
-}
-
-// moving a single axis inwards where the read/write size is a power of 2 and between 8 and 64 bits.
-static void TranposeSingleAxisInwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                      int64_t from, int64_t to) {
-  ORT_UNUSED_PARAMETER(permutations);
 
-  const auto& input_shape = input.Shape();
-  const auto& input_dims = input_shape.GetDims();
+  return plan;
+}
 
-  const auto element_size = input.DataType()->Size();
+// transpose rows [row_start, row_start + row_count) of a single 2D transpose
+static void Transpose2D(const TransposePlan& plan, const uint8_t* input, uint8_t* output,
+                        size_t row_start, size_t row_count) {
+  const size_t block_size = plan.block_size;
+  const size_t input_ld = plan.input_ld;
+  const size_t output_ld = plan.output_ld;
 
-  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
+  input += row_start * input_ld * block_size;
+  output += row_start * block_size;
 
-  auto num_loops = input_shape.SizeToDimension(from);
-  auto num_readers = input_dims[from];
-  auto block_size = input_shape.SizeFromDimension(to + 1);
-  auto reads_per_loop = int64_t(input_shape.Size() / num_loops / block_size);
-  auto reads_per_reader_per_loop = int64_t(reads_per_loop / num_readers);
-  const int64_t bytes_per_read = block_size * element_size;
-
-  switch (bytes_per_read) {
-    case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisInwards(input_data, output_data,
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+  switch (block_size) {
+    case sizeof(uint8_t):
+      MlasTranspose(input, input_ld, output, output_ld, row_count, plan.cols);
       break;
-    }
-    case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint16_t*>(input_data),
-                                       reinterpret_cast<uint16_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+    case sizeof(uint16_t):
+      MlasTranspose(reinterpret_cast<const uint16_t*>(input), input_ld,
+                    reinterpret_cast<uint16_t*>(output), output_ld, row_count, plan.cols);
       break;
-    }
-    case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint32_t*>(input_data),
-                                       reinterpret_cast<uint32_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+    case sizeof(uint32_t):
+      MlasTranspose(reinterpret_cast<const uint32_t*>(input), input_ld,
+                    reinterpret_cast<uint32_t*>(output), output_ld, row_count, plan.cols);
       break;
-    }
-    case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint64_t*>(input_data),
-                                       reinterpret_cast<uint64_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+    case sizeof(uint64_t):
+      MlasTranspose(reinterpret_cast<const uint64_t*>(input), input_ld,
+                    reinterpret_cast<uint64_t*>(output), output_ld, row_count, plan.cols);
       break;
-    }
-    default: {
+    default:
       // we need to use memcpy for each block
-      std::vector<const uint8_t*> readers;
-      readers.resize(num_readers);
-
-      for (int64_t l = 0; l < num_loops; ++l) {
-        for (auto r = 0; r < num_readers; ++r) {
-          readers[r] = (input_data + (r * reads_per_reader_per_loop * bytes_per_read));
+      for (size_t m = 0; m < row_count; ++m) {
+        const uint8_t* source = input + m * input_ld * block_size;
+        uint8_t* target = output + m * block_size;
+        for (size_t n = 0; n < plan.cols; ++n) {
+          memcpy(target + n * output_ld * block_size, source + n * block_size, block_size);
         }
-
-        for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-          for (int64_t r = 0; r < num_readers; ++r) {
-            memcpy(output_data, readers[r], bytes_per_read);
-            readers[r] += bytes_per_read;
-            output_data += bytes_per_read;
-          }
-        }
-
-        input_data += reads_per_loop * bytes_per_read;
       }
-    }
-  }
-}
-
-static void SingleAxisTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                size_t from, size_t to) {
-  // TODO: We may want to fall back to the default implementation if the size of the axis being moved is large
-  // compared to the other axes.
-  // e.g. transpose {3, 2048} with permutation of {1, 0} would result in 2048 writers being created
-  //   (std::vector<uint8_t*> of size 2048) but only used in 3 loops. however that may still be cheaper than
-  //   calling ComputeOffset and IncrementIndex 6K times.
-
-  if (from > to) {
-    TranposeSingleAxisOutwards(permutations, input, output, from, to);
-  } else {
-    TranposeSingleAxisInwards(permutations, input, output, from, to);
   }
 }
 
-static bool IsMovingSingleAxis(const std::vector<size_t>& permutations, size_t& from, size_t& to) {
-  // if a single axis moved to an outer dimension, the values should be one lower than the index until the slot the
-  // axis was moved from, and equal to the index after that.
-  // e.g. axis 3 moves out to 1 would be: 0, 3, 1, 2, 4
-  auto check_moved_outwards = [&permutations](size_t cur, size_t moved_from) {
-    // we start processing with the slot after the moved one, so the expected value is one less than the index
-    size_t expected = cur - 1;
-    for (size_t end = permutations.size(); cur < end; ++cur) {
-      if (permutations[cur] != expected) {
-        return false;
-      }
+static void DoNumericTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
+                               concurrency::ThreadPool* tp) {
+  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
+  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
 
-      // we are at the slot the axis moved from, so do an additional increment before checking the next value
-      if (cur == moved_from) {
-        ++expected;
-      }
+  const TransposePlan plan = PlanTranspose(permutations, input.Shape().GetDims(), input.DataType()->Size());
 
-      ++expected;
-    }
+  const size_t batch_count = std::accumulate(plan.batch_dims.begin(), plan.batch_dims.end(), size_t{1},
+                                             std::multiplies<size_t>());
+  if (plan.rows == 1 && batch_count == 1) {
+    // the permutation only moves axes of size 1, so the data is unchanged
+    memcpy(output_data, input_data, plan.block_size);
+    return;
+  }
 
-    return true;
-  };
-
-  // if a single axis moved to an inner dimension, the values should be one higher than the index until the slot the
-  // axis was moved to, and equal to the index after that.
-  // e.g. axis 1 moves inwards to 3 would be: 0, 2, 3, 1, 4
-  auto check_moved_inwards = [&permutations](size_t cur, size_t& moved_to) {
-    size_t started_at = cur;
-    size_t expected = cur + 1;
-    moved_to = std::numeric_limits<size_t>::max();
-
-    for (size_t end = permutations.size(); cur < end; ++cur) {
-      if (permutations[cur] != expected) {
-        // if a single axis moved it must have come from the location we started at
-        if (started_at != permutations[cur]) {
-          return false;
+  // each unit of work is a range of rows from one 2D transpose. the range covers several cache tiles so the
+  // threads don't share output cache lines.
+  constexpr size_t kRowsPerUnit = 64;
+  const size_t units_per_batch = (plan.rows + kRowsPerUnit - 1) / kRowsPerUnit;
+  const size_t rows_per_unit = std::min(plan.rows, kRowsPerUnit);
+  const double bytes_per_unit = static_cast<double>(rows_per_unit * plan.cols * plan.block_size);
+  const size_t num_batch_axes = plan.batch_dims.size();
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_count * units_per_batch),
+      concurrency::TensorOpCost{bytes_per_unit, bytes_per_unit, bytes_per_unit / 16},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        size_t unit = static_cast<size_t>(first);
+        size_t batch = unit / units_per_batch;
+        size_t row_unit = unit % units_per_batch;
+
+        // decompose the batch into an index over the batch axes
+        std::vector<size_t> index(num_batch_axes);
+        size_t input_offset = 0;
+        size_t output_offset = 0;
+        for (size_t i = num_batch_axes, remaining = batch; i-- > 0;) {
+          index[i] = remaining % plan.batch_dims[i];
+          remaining /= plan.batch_dims[i];
+          input_offset += index[i] * plan.batch_input_strides[i];
+          output_offset += index[i] * plan.batch_output_strides[i];
         }
 
-        moved_to = cur;
-      } else {
-        ++expected;
-      }
-    }
-
-    return moved_to != std::numeric_limits<size_t>::max();
-  };
-
-  bool single_axis_moved = false;
-  // check axis moving outwards (earlier entry in permutations)
-  for (size_t i = 0, end = permutations.size(); i < end; ++i) {
-    size_t axis = permutations[i];
-
-    if (axis != i) {
-      if (check_moved_outwards(i + 1, axis)) {
-        single_axis_moved = true;
-        to = i;
-        from = axis;
-      } else if (check_moved_inwards(i, to)) {
-        single_axis_moved = true;
-        from = i;
-      }
-
-      break;
-    }
-  }
-
-  return single_axis_moved;
+        for (; unit < static_cast<size_t>(last); ++unit) {
+          const size_t row_start = row_unit * kRowsPerUnit;
+          Transpose2D(plan, input_data + input_offset * plan.block_size, output_data + output_offset * plan.block_size,
+                      row_start, std::min(plan.rows - row_start, kRowsPerUnit));
+
+          if (++row_unit == units_per_batch) {
+            row_unit = 0;
+
+            // move to the next batch
+            for (size_t i = num_batch_axes; i-- > 0;) {
+              input_offset += plan.batch_input_strides[i];
+              output_offset += plan.batch_output_strides[i];
+              if (++index[i] < plan.batch_dims[i]) {
+                break;
+              }
+              input_offset -= index[i] * plan.batch_input_strides[i];
+              output_offset -= index[i] * plan.batch_output_strides[i];
+              index[i] = 0;
+            }
+          }
+        }
+      });
 }
 
-Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output) {
+Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
+                                  concurrency::ThreadPool* tp) {
   Status status = Status::OK();
 
   auto input_type = input.DataType();
@@ -537,16 +371,12 @@ Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const
   if (input_type != output_type) {
     status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Mismatched data types between input and output Tensors. ",
                              input_type, " != ", output_type);
+  } else if (input.Shape().Size() == 0) {
+    // nothing to copy
+  } else if (input.IsDataTypeString()) {
+    status = DoStringTranspose(permutations, input, output);
   } else {
-    size_t from = 0, to = 0;
-    bool moving_single_axis = IsMovingSingleAxis(permutations, from, to);
-
-    if (moving_single_axis && !input.IsDataTypeString()) {
-      SingleAxisTranspose(permutations, input, output, from, to);
-    } else {
-      // fall back to default implementation
-      status = DoUntypedTranspose(permutations, input, output);
-    }
+    DoNumericTranspose(permutations, input, output, tp);
   }
 
   return status;
@@ -573,17 +403,7 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
   if (output_shape.Size() == 0)
     return Status::OK();
 
-  size_t from = 0, to = 0;
-  bool moving_single_axis = IsMovingSingleAxis(*p_perm, from, to);
-
-  if (moving_single_axis && !X.IsDataTypeString()) {
-    SingleAxisTranspose(*p_perm, X, Y, from, to);
-  } else {
-    // fall back to default implementation
-    status = DoUntypedTranspose(*p_perm, X, Y);
-  }
-
-  return status;
+  return DoTranspose(*p_perm, X, Y, ctx->GetOperatorThreadPool());
 }
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -16,7 +16,16 @@ class TransposeBase {
   Transpose the input Tensor into the output Tensor using the provided permutations.
   Both Tensors must have the same data type. 
   */
-  static Status DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output);
+  static Status DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output) {
+    return DoTranspose(permutations, input, output, nullptr);
+  }
+
+  /**
+  Transpose the input Tensor into the output Tensor using the provided permutations, splitting the work across
+  the thread pool if one is provided.
+  */
+  static Status DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
+                            concurrency::ThreadPool* tp);
 
  protected:
   TransposeBase(const OpKernelInfo& info) {
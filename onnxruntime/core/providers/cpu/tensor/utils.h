@@ -4,6 +4,10 @@
 #pragma once
 #include "gsl/gsl"
 #include "core/framework/utils.h"
+#include "core/platform/threadpool.h"
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
 namespace onnxruntime {
 
 struct TensorPitches : std::vector<int64_t> {
@@ -396,4 +400,211 @@ struct WritableSliceIterator {
   std::vector<int64_t> indices_;  // There is no index for innermost axis since it's a special case
 };
 
+// Block copy engine for the data movement ops (Concat, Split, Gather, GatherElements, GatherND).
+//
+// A copy is described as a number of blocks of block_size elements. The blocks are split across the thread pool
+// using the bytes in a block as the cost of each unit of work, so small copies stay on the calling thread.
+// Blocks of 1, 2, 4, 8 or 16 bytes are copied with a fixed size memcpy that the compiler expands inline, larger
+// blocks use memcpy and std::string blocks are copied by assignment.
+
+// Describes num_blocks blocks of block_size elements. Block i is copied from source + i * source_stride
+// to target + i * target_stride.
+template <typename T>
+struct StridedCopyRegion {
+  const T* source;
+  size_t source_stride;
+  T* target;
+  size_t target_stride;
+  size_t block_size;
+  size_t num_blocks;
+};
+
+namespace copy_engine_detail {
+
+// Contiguous copies are split into blocks of this size so they can be spread across the thread pool
+constexpr size_t kContiguousBlockBytes = 64 * 1024;
+
+// Number of blocks to look ahead when prefetching the source of an indirect copy
+constexpr size_t kPrefetchDistance = 8;
+
+inline void PrefetchRead(const void* address) {
+#if defined(__GNUC__)
+  __builtin_prefetch(address, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+  ORT_UNUSED_PARAMETER(address);
+#endif
+}
+
+// Calls fn with a function object that copies one block of block_size elements.
+template <typename T>
+struct BlockCopier {
+  template <typename Fn>
+  static void Dispatch(size_t block_size, Fn&& fn) {
+    static_assert(std::is_trivially_copyable<T>::value, "BlockCopier requires a trivially copyable type");
+    switch (block_size * sizeof(T)) {
+      case 1:
+        fn([](const T* source, T* target) { memcpy(target, source, 1); });
+        break;
+      case 2:
+        fn([](const T* source, T* target) { memcpy(target, source, 2); });
+        break;
+      case 4:
+        fn([](const T* source, T* target) { memcpy(target, source, 4); });
+        break;
+      case 8:
+        fn([](const T* source, T* target) { memcpy(target, source, 8); });
+        break;
+      case 16:
+        fn([](const T* source, T* target) { memcpy(target, source, 16); });
+        break;
+      default: {
+        const size_t block_bytes = block_size * sizeof(T);
+        fn([block_bytes](const T* source, T* target) { memcpy(target, source, block_bytes); });
+      }
+    }
+  }
+};
+
+template <>
+struct BlockCopier<std::string> {
+  template <typename Fn>
+  static void Dispatch(size_t block_size, Fn&& fn) {
+    fn([block_size](const std::string* source, std::string* target) {
+      std::copy(source, source + block_size, target);
+    });
+  }
+};
+
+}  // namespace copy_engine_detail
+
+// Copy all the regions, splitting the blocks of every region across the thread pool.
+template <typename T>
+void StridedCopy(concurrency::ThreadPool* tp, const std::vector<StridedCopyRegion<T>>& regions) {
+  using namespace copy_engine_detail;
+
+  // coalesce regions whose blocks are contiguous in both the source and the target, and re-split them into
+  // blocks that are large enough to copy efficiently but still give the thread pool something to share.
+  std::vector<StridedCopyRegion<T>> work;
+  work.reserve(regions.size());
+  for (const auto& region : regions) {
+    if (region.num_blocks == 0 || region.block_size == 0) {
+      continue;
+    }
+
+    const bool contiguous = region.num_blocks == 1 ||
+                            (region.source_stride == region.block_size && region.target_stride == region.block_size);
+    if (!contiguous) {
+      work.push_back(region);
+      continue;
+    }
+
+    const size_t total = region.block_size * region.num_blocks;
+    const size_t chunk = std::max<size_t>(kContiguousBlockBytes / sizeof(T), 1);
+    const size_t num_chunks = total / chunk;
+    if (num_chunks > 0) {
+      work.push_back({region.source, chunk, region.target, chunk, chunk, num_chunks});
+    }
+    if (total % chunk != 0) {
+      const size_t done = num_chunks * chunk;
+      work.push_back({region.source + done, 0, region.target + done, 0, total - done, 1});
+    }
+  }
+
+  // prefix sums of the blocks in each region so a unit of work can be mapped back to its region
+  std::vector<size_t> region_ends(work.size());
+  size_t total_blocks = 0;
+  size_t total_elements = 0;
+  for (size_t i = 0; i < work.size(); ++i) {
+    total_blocks += work[i].num_blocks;
+    total_elements += work[i].num_blocks * work[i].block_size;
+    region_ends[i] = total_blocks;
+  }
+
+  if (total_blocks == 0) {
+    return;
+  }
+
+  const double bytes_per_block = static_cast<double>(total_elements * sizeof(T)) / total_blocks;
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(total_blocks), concurrency::TensorOpCost{bytes_per_block, bytes_per_block, 0},
+      [&work, &region_ends](std::ptrdiff_t first, std::ptrdiff_t last) {
+        size_t block = static_cast<size_t>(first);
+        size_t r = std::upper_bound(region_ends.begin(), region_ends.end(), block) - region_ends.begin();
+
+        while (block < static_cast<size_t>(last)) {
+          const auto& region = work[r];
+          const size_t region_start = region_ends[r] - region.num_blocks;
+          const size_t end = std::min(region_ends[r], static_cast<size_t>(last));
+
+          BlockCopier<T>::Dispatch(region.block_size, [&](auto copy_block) {
+            const T* source = region.source + (block - region_start) * region.source_stride;
+            T* target = region.target + (block - region_start) * region.target_stride;
+            for (size_t i = block; i < end; ++i) {
+              copy_block(source, target);
+              source += region.source_stride;
+              target += region.target_stride;
+            }
+          });
+
+          block = end;
+          ++r;
+        }
+      });
+}
+
+// Copy num_blocks blocks of block_size elements from source to target, where block i is copied from
+// source + i * source_stride to target + i * target_stride.
+template <typename T>
+void StridedCopy(concurrency::ThreadPool* tp, const T* source, size_t source_stride, T* target, size_t target_stride,
+                 size_t block_size, size_t num_blocks) {
+  StridedCopy(tp, std::vector<StridedCopyRegion<T>>{{source, source_stride, target, target_stride,
+                                                      block_size, num_blocks}});
+}
+
+// Copy num_blocks blocks of block_size elements to the contiguous target, where block i is copied from
+// source + source_offset(i). The source of upcoming blocks is prefetched as the reads are indirect.
+template <typename T, typename SourceOffsetFn>
+void GatherCopy(concurrency::ThreadPool* tp, const T* source, T* target, size_t block_size, size_t num_blocks,
+                const SourceOffsetFn& source_offset) {
+  using namespace copy_engine_detail;
+
+  if (num_blocks == 0 || block_size == 0) {
+    return;
+  }
+
+  const double bytes_per_block = static_cast<double>(block_size * sizeof(T));
+
+  BlockCopier<T>::Dispatch(block_size, [&](auto copy_block) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(num_blocks), concurrency::TensorOpCost{bytes_per_block, bytes_per_block, 0},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          const size_t begin = static_cast<size_t>(first);
+          const size_t end = static_cast<size_t>(last);
+          T* output = target + begin * block_size;
+
+          // the offsets of the next kPrefetchDistance blocks, so each offset is computed once for both
+          // the prefetch and the copy
+          size_t offsets[kPrefetchDistance];
+          for (size_t i = begin; i < end && i - begin < kPrefetchDistance; ++i) {
+            offsets[i - begin] = source_offset(i);
+          }
+
+          size_t slot = 0;
+          for (size_t i = begin; i < end; ++i) {
+            const size_t offset = offsets[slot];
+            if (i + kPrefetchDistance < end) {
+              offsets[slot] = source_offset(i + kPrefetchDistance);
+              PrefetchRead(source + offsets[slot]);
+            }
+            copy_block(source + offset, output);
+            output += block_size;
+            slot = slot + 1 == kPrefetchDistance ? 0 : slot + 1;
+          }
+        });
+  });
+}
+
 }  // namespace onnxruntime
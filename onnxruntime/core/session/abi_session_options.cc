@@ -5,6 +5,7 @@
 #include "core/session/onnxruntime_c_api.h"
 #include "core/session/ort_apis.h"
 #include "core/framework/error_code_helper.h"
+#include <algorithm>
 #include <cstring>
 #include <cassert>
 #include "core/session/inference_session.h"
@@ -96,6 +97,30 @@ ORT_API_STATUS_IMPL(OrtApis::DisableCpuMemArena, _In_ OrtSessionOptions* options
   return nullptr;
 }
 
+// share the weights pre-packed by kernels with other sessions created from the same env.
+// each session otherwise keeps its own copy of the packed weights.
+ORT_API_STATUS_IMPL(OrtApis::EnablePrePackedWeightsSharing, _In_ OrtSessionOptions* options) {
+  options->value.share_prepacked_weights = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::DisablePrePackedWeightsSharing, _In_ OrtSessionOptions* options) {
+  options->value.share_prepacked_weights = false;
+  return nullptr;
+}
+
+// map the model file into memory and use the data of the large initializers in place.
+// by default the raw data of the initializers is parsed into the model and then copied into the tensors.
+ORT_API_STATUS_IMPL(OrtApis::EnableMappedModelLoading, _Inout_ OrtSessionOptions* options) {
+  options->value.use_mapped_model_loading = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::DisableMappedModelLoading, _Inout_ OrtSessionOptions* options) {
+  options->value.use_mapped_model_loading = false;
+  return nullptr;
+}
+
 ///< logger id to use for session output
 ORT_API_STATUS_IMPL(OrtApis::SetSessionLogId, _In_ OrtSessionOptions* options, const char* logid) {
   options->value.session_logid = logid;
@@ -150,6 +175,87 @@ ORT_API_STATUS_IMPL(OrtApis::SetInterOpNumThreads, _In_ OrtSessionOptions* optio
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SetThreadPoolSpinDuration, _Inout_ OrtSessionOptions* options, int spin_duration_us) {
+  if (spin_duration_us < 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "spin_duration_us must be 0 or greater");
+  }
+  options->value.thread_pool_spin_duration_us = spin_duration_us;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetThreadPoolAllowSpinning, _Inout_ OrtSessionOptions* options, int allow_spinning) {
+  options->value.thread_pool_allow_spinning = allow_spinning != 0;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetThreadPoolAffinity, _Inout_ OrtSessionOptions* options,
+                    OrtThreadAffinityPolicy policy,
+                    _In_opt_ const size_t* logical_processors, size_t num_logical_processors) {
+  switch (policy) {
+    case ORT_THREAD_AFFINITY_NONE:
+    case ORT_THREAD_AFFINITY_COMPACT:
+    case ORT_THREAD_AFFINITY_SCATTER:
+      options->value.thread_pool_affinity.clear();
+      break;
+    case ORT_THREAD_AFFINITY_EXPLICIT:
+      if (logical_processors == nullptr || num_logical_processors == 0) {
+        return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                     "ORT_THREAD_AFFINITY_EXPLICIT requires a list of logical processors");
+      }
+      options->value.thread_pool_affinity.assign(logical_processors, logical_processors + num_logical_processors);
+      break;
+    default:
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "unknown thread affinity policy");
+  }
+  options->value.thread_pool_affinity_policy = policy;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetThreadPoolNumaNode, _Inout_ OrtSessionOptions* options, int numa_node) {
+  if (numa_node < -1) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "numa_node must be -1 or greater");
+  }
+  options->value.thread_pool_numa_node = numa_node;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::DisablePerSessionThreads, _Inout_ OrtSessionOptions* options) {
+  options->value.use_per_session_threads = false;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetArenaShrinkPolicy, _Inout_ OrtSessionOptions* options, int interval_runs,
+                    int64_t idle_ms) {
+  if (interval_runs < 0 || idle_ms < 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "interval_runs and idle_ms must be 0 or greater");
+  }
+  options->value.arena_shrink_interval_runs = interval_runs;
+  options->value.arena_shrink_idle_ms = idle_ms;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetCpuMemArenaMaxBytes, _Inout_ OrtSessionOptions* options, size_t max_bytes) {
+  options->value.cpu_mem_arena_max_bytes = max_bytes;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetMemPatternShapeBuckets, _Inout_ OrtSessionOptions* options,
+                    _In_opt_ const int64_t* dim_buckets, size_t num_buckets, size_t max_patterns) {
+  if (num_buckets > 0 && dim_buckets == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "dim_buckets is null");
+  }
+  std::vector<int64_t> buckets(dim_buckets, dim_buckets + num_buckets);
+  if (!std::is_sorted(buckets.begin(), buckets.end())) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "dim_buckets must be in increasing order");
+  }
+  if (max_patterns == 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "max_patterns must be greater than 0");
+  }
+  options->value.mem_pattern_dim_buckets = std::move(buckets);
+  options->value.mem_pattern_max_count = max_patterns;
+  return nullptr;
+}
+
 ORT_API_STATUS_IMPL(OrtApis::AddFreeDimensionOverride, _Inout_ OrtSessionOptions* options,
                     _In_ const char* symbolic_dim, _In_ int64_t dim_override) {
   options->value.free_dimension_overrides.push_back(onnxruntime::FreeDimensionOverride{symbolic_dim, dim_override});
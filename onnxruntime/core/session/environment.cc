@@ -3,8 +3,10 @@
 
 #include "core/session/environment.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/prepacked_weights_container.h"
 #include "core/graph/constants.h"
 #include "core/graph/op.h"
+#include "core/util/thread_utils.h"
 #include "onnx/defs/operator_sets.h"
 #include "onnx/defs/operator_sets-ml.h"
 #ifndef DISABLE_CONTRIB_OPS
@@ -31,14 +33,43 @@ std::once_flag schemaRegistrationOnceFlag;
 
 Status Environment::Create(std::unique_ptr<Environment>& environment) {
   environment = std::unique_ptr<Environment>(new Environment());
-  auto status = environment->Initialize();
+  auto status = environment->Initialize(nullptr);
   return status;
 }
 
-Status Environment::Initialize() {
+Status Environment::Create(std::unique_ptr<Environment>& environment, const OrtThreadingOptions& tp_options) {
+  environment = std::unique_ptr<Environment>(new Environment());
+  auto status = environment->Initialize(&tp_options);
+  return status;
+}
+
+Environment::~Environment() = default;
+
+concurrency::ThreadPool* Environment::GetInterOpThreadPool() const {
+  if (tp_options_ == nullptr)
+    return nullptr;
+
+  std::call_once(inter_op_thread_pool_once_flag_, [this]() {
+    inter_op_thread_pool_ = concurrency::CreateThreadPool("env_global_inter_op_thread_pool",
+                                                          tp_options_->inter_op_thread_pool_params);
+  });
+  return inter_op_thread_pool_.get();
+}
+
+Status Environment::Initialize(const OrtThreadingOptions* tp_options) {
   auto status = Status::OK();
 
   try {
+    prepacked_weights_container_ = onnxruntime::make_unique<PrepackedWeightsContainer>();
+
+    if (tp_options != nullptr) {
+      create_global_thread_pools_ = true;
+      intra_op_thread_pool_ = concurrency::CreateThreadPool("env_global_intra_op_thread_pool",
+                                                            tp_options->intra_op_thread_pool_params);
+      // the inter-op pool is created on first use, see GetInterOpThreadPool
+      tp_options_ = onnxruntime::make_unique<OrtThreadingOptions>(*tp_options);
+    }
+
     // Register Microsoft domain with min/max op_set version as 1/1.
     std::call_once(schemaRegistrationOnceFlag, []() {
       ONNX_NAMESPACE::OpSchemaRegistry::DomainToVersionRange::Instance().AddDomainToVersion(onnxruntime::kMSDomain, 1, 1);
@@ -169,13 +169,23 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
       session_options_.max_num_graph_transformation_steps);
   logging_manager_ = logging_manager;
 
-  thread_pool_ = concurrency::CreateThreadPool("intra_op_thread_pool",
-                                               session_options_.intra_op_num_threads);
-
-  inter_op_thread_pool_ = session_options_.execution_mode == ExecutionMode::ORT_PARALLEL
-                              ? concurrency::CreateThreadPool("inter_op_thread_pool",
-                                                              session_options_.inter_op_num_threads)
-                              : nullptr;
+  concurrency::ThreadPoolParams thread_pool_params;
+  thread_pool_params.spin_duration_us = session_options_.thread_pool_spin_duration_us;
+  thread_pool_params.allow_spinning = session_options_.thread_pool_allow_spinning;
+  thread_pool_params.affinity_policy = session_options_.thread_pool_affinity_policy;
+  thread_pool_params.affinity = session_options_.thread_pool_affinity;
+  thread_pool_params.numa_node = session_options_.thread_pool_numa_node;
+
+  // the global thread pools are provided later through SetGlobalThreadPools
+  if (session_options_.use_per_session_threads) {
+    thread_pool_params.thread_pool_size = session_options_.intra_op_num_threads;
+    thread_pool_ = concurrency::CreateThreadPool("intra_op_thread_pool", thread_pool_params);
+
+    thread_pool_params.thread_pool_size = session_options_.inter_op_num_threads;
+    inter_op_thread_pool_ = session_options_.execution_mode == ExecutionMode::ORT_PARALLEL
+                                ? concurrency::CreateThreadPool("inter_op_thread_pool", thread_pool_params)
+                                : nullptr;
+  }
 
   session_state_ = onnxruntime::make_unique<SessionState>(execution_providers_,
                                                           session_options_.enable_mem_pattern &&
@@ -185,6 +195,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
 
   InitLogger(logging_manager);
 
+  session_state_->SetMemoryPatternCacheOptions(session_options_.mem_pattern_dim_buckets,
+                                               session_options_.mem_pattern_max_count);
   session_state_->SetDataTransferMgr(&data_transfer_mgr_);
   session_profiler_.Initialize(session_logger_);
   session_state_->SetProfiler(session_profiler_);
@@ -210,7 +222,9 @@ InferenceSession::InferenceSession(const SessionOptions& session_options,
     : insert_cast_transformer_("CastFloat16Transformer") {
   model_location_ = ToWideString(model_uri);
   model_proto_ = onnxruntime::make_unique<ONNX_NAMESPACE::ModelProto>();
-  auto status = Model::Load(model_location_, *model_proto_);
+  auto status = session_options.use_mapped_model_loading
+                    ? Model::LoadWithMappedInitializers(model_location_, *model_proto_, model_data_)
+                    : Model::Load(model_location_, *model_proto_);
   ORT_ENFORCE(status.IsOK(), "Given model could not be parsed while creating inference session. Error message: ",
               status.ErrorMessage());
 
@@ -225,7 +239,9 @@ InferenceSession::InferenceSession(const SessionOptions& session_options,
     : insert_cast_transformer_("CastFloat16Transformer") {
   model_location_ = ToWideString(model_uri);
   model_proto_ = onnxruntime::make_unique<ONNX_NAMESPACE::ModelProto>();
-  auto status = Model::Load(model_location_, *model_proto_);
+  auto status = session_options.use_mapped_model_loading
+                    ? Model::LoadWithMappedInitializers(model_location_, *model_proto_, model_data_)
+                    : Model::Load(model_location_, *model_proto_);
   ORT_ENFORCE(status.IsOK(), "Given model could not be parsed while creating inference session. Error message: ",
               status.ErrorMessage());
 
@@ -331,6 +347,38 @@ common::Status InferenceSession::AddCustomOpDomains(const std::vector<OrtCustomO
   return Status::OK();
 }
 
+common::Status InferenceSession::SetGlobalThreadPools(concurrency::ThreadPool* intra_op_thread_pool,
+                                                      concurrency::ThreadPool* inter_op_thread_pool) {
+  if (is_inited_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                           "The global thread pools must be set before the session is initialized.");
+  }
+
+  if (session_options_.use_per_session_threads) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "The session creates its own thread pools. Set use_per_session_threads to false "
+                           "to use the global thread pools.");
+  }
+
+  // the inter-op pool is only used by the parallel executor
+  session_state_->SetThreadPools(intra_op_thread_pool,
+                                 session_options_.execution_mode == ExecutionMode::ORT_PARALLEL
+                                     ? inter_op_thread_pool
+                                     : nullptr);
+  global_thread_pools_set_ = true;
+  return Status::OK();
+}
+
+common::Status InferenceSession::SetPrepackedWeightsContainer(PrepackedWeightsContainer* prepacked_weights_container) {
+  if (is_inited_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                           "The pre-packed weights container must be set before the session is initialized.");
+  }
+
+  prepacked_weights_container_ = prepacked_weights_container;
+  return Status::OK();
+}
+
 common::Status InferenceSession::RegisterCustomRegistry(std::shared_ptr<CustomRegistry> custom_registry) {
   if (custom_registry == nullptr) {
     return Status(common::ONNXRUNTIME, common::FAIL, "Received nullptr for custom registry");
@@ -403,6 +451,13 @@ common::Status InferenceSession::Load(const std::basic_string<T>& model_uri) {
       AddCustomOpDomains({domain.get()});
     }
 #endif
+    if (session_options_.use_mapped_model_loading) {
+      auto model_proto = onnxruntime::make_unique<ONNX_NAMESPACE::ModelProto>();
+      ORT_RETURN_IF_ERROR(onnxruntime::Model::LoadWithMappedInitializers(model_location_, *model_proto, model_data_));
+      return onnxruntime::Model::Load(std::move(model_proto), model,
+                                      HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_,
+                                      /*allow_mapped_initializers*/ true);
+    }
     return onnxruntime::Model::Load(model_location_, model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
                                     *session_logger_);
   };
@@ -554,8 +609,9 @@ common::Status InferenceSession::Load() {
     }
 #endif
     // Pass on ownership of the parsed ModelProto to the Model instance (its job here is done by this stage)
+    // the ModelProto refers to the data of its initializers in memory if it was loaded with model_data_
     return Model::Load(std::move(this->model_proto_), model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
-                       *session_logger_);
+                       *session_logger_, /*allow_mapped_initializers*/ model_data_ != nullptr);
   };
 
   return Load(loader, "model_loading_from_saved_proto");
@@ -672,6 +728,8 @@ common::Status InferenceSession::CreateSubgraphSessionState(Graph& graph, Sessio
                                                                            session_state.GetEnableMemoryPattern(),
                                                                            session_state.GetThreadPool(),
                                                                            session_state.GetInterOpThreadPool());
+      subgraph_session_state->SetMemoryPatternCacheOptions(session_options_.mem_pattern_dim_buckets,
+                                                           session_options_.mem_pattern_max_count);
       subgraph_session_state->SetProfiler(session_profiler_);
       subgraph_session_state->SetLogger(*session_logger_);
       // Pass data transfer manager to subgraph.
@@ -719,7 +777,8 @@ common::Status InferenceSession::InitializeSubgraphSessions(Graph& graph, Sessio
 
       // setup everything required to execute the subgraph and save it in subgraph_session_state
       SessionStateInitializer initializer(session_options_.enable_mem_pattern, model_location_, subgraph,
-                                          *subgraph_session_state, execution_providers_, kernel_registry_manager_);
+                                          *subgraph_session_state, execution_providers_, kernel_registry_manager_,
+                                          prepacked_weights_container_);
 
       const auto implicit_inputs = node.ImplicitInputDefs();
       ORT_RETURN_IF_ERROR_SESSIONID_(initializer.CreatePlan(&node, &implicit_inputs,
@@ -801,6 +860,12 @@ common::Status InferenceSession::Initialize() {
       LOGS(*session_logger_, INFO) << "Session has already been initialized.";
       return common::Status::OK();
     }
+    if (!session_options_.use_per_session_threads && !global_thread_pools_set_) {
+      LOGS(*session_logger_, ERROR) << "use_per_session_threads is false but the global thread pools were not set";
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                             "The session does not use per session threads, but no global thread pools were "
+                             "provided. Create the environment with global thread pools.");
+    }
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
     TraceLoggingWriteStart(session_activity, "OrtInferenceSessionActivity");
     session_activity_started_ = true;
@@ -809,6 +874,7 @@ common::Status InferenceSession::Initialize() {
     if (!execution_providers_.Get(onnxruntime::kCpuExecutionProvider)) {
       LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
       CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+      epi.arena_max_bytes = session_options_.cpu_mem_arena_max_bytes;
       auto p_cpu_exec_provider = onnxruntime::make_unique<CPUExecutionProvider>(epi);
       ORT_RETURN_IF_ERROR_SESSIONID_(RegisterExecutionProvider(std::move(p_cpu_exec_provider)));
     }
@@ -839,7 +905,8 @@ common::Status InferenceSession::Initialize() {
     ORT_RETURN_IF_ERROR_SESSIONID_(kernel_registry_manager_.RegisterKernels(execution_providers_));
 
     SessionStateInitializer session_initializer(session_options_.enable_mem_pattern, model_location_, graph,
-                                                *session_state_, execution_providers_, kernel_registry_manager_);
+                                                *session_state_, execution_providers_, kernel_registry_manager_,
+                                                prepacked_weights_container_);
 
     // create SessionState for subgraphs as it's needed by the transformers
     ORT_RETURN_IF_ERROR_SESSIONID_(CreateSubgraphSessionState(graph, *session_state_));
@@ -899,6 +966,38 @@ int InferenceSession::GetCurrentNumRuns() const {
   return current_num_runs_.load();
 }
 
+void InferenceSession::ShrinkMemoryArenas() {
+  for (const auto& xp : execution_providers_) {
+    for (const auto& allocator : xp->GetAllocators()) {
+      if (allocator->Info().alloc_type != OrtArenaAllocator) {
+        continue;
+      }
+
+      // the provider owns its allocators as non-const objects, GetAllocators only hands them out as const
+      const auto* arena = dynamic_cast<const IArenaAllocator*>(allocator.get());
+      if (arena) {
+        const_cast<IArenaAllocator*>(arena)->Shrink();
+      }
+    }
+  }
+}
+
+Status InferenceSession::GetAllocatorStats(const OrtMemoryInfo& mem_info, AllocatorStats& stats) const {
+  auto arena = std::dynamic_pointer_cast<IArenaAllocator>(execution_providers_.GetAllocator(mem_info));
+  if (!arena) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The session has no arena for ", mem_info);
+  }
+
+  arena->GetStats(&stats);
+  return Status::OK();
+}
+
+static int64_t SteadyClockMicroSeconds() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
 const std::vector<std::string>& InferenceSession::GetRegisteredProviderTypes() const {
   return execution_providers_.GetIds();
 }
@@ -953,8 +1052,9 @@ static common::Status CheckTypes(MLDataType actual, MLDataType expected) {
                 "Unexpected input data type. Actual: (" + actual_name + ") , expected: (" + expected_name + ")");
 }
 
-common::Status InferenceSession::ValidateInputs(const std::vector<std::string>& feed_names,
+common::Status InferenceSession::ValidateInputs(const PreparedRun& prepared_run,
                                                 const std::vector<OrtValue>& feeds) const {
+  const auto& feed_names = prepared_run.GetFeedNames();
   if (feed_names.size() != feeds.size()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Size mismatch: feed_names has ", feed_names.size(),
                            "elements, but feeds has ", feeds.size(), " elements.");
@@ -962,13 +1062,9 @@ common::Status InferenceSession::ValidateInputs(const std::vector<std::string>&
 
   for (size_t i = 0; i < feeds.size(); ++i) {
     const auto& feed_name = feed_names[i];
+    const auto& feed_def = prepared_run.feed_defs_[i];
 
-    auto iter = input_def_map_.find(feed_name);
-    if (input_def_map_.end() == iter) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid Feed Input Name:", feed_name);
-    }
-
-    auto expected_type = iter->second.ml_data_type;
+    auto expected_type = feed_def.ml_data_type;
     auto& input_ml_value = feeds.at(i);
     if (input_ml_value.IsTensor()) {
       // check for type
@@ -981,7 +1077,7 @@ common::Status InferenceSession::ValidateInputs(const std::vector<std::string>&
       ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type));
 
       // check for shape
-      const auto& expected_shape = iter->second.tensor_shape;
+      const auto& expected_shape = *feed_def.tensor_shape;
       if (expected_shape.NumDimensions() > 0) {
         const auto& input_shape = input_ml_value.Get<Tensor>().Shape();
         ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(feed_name, input_shape, expected_shape));
@@ -1012,16 +1108,27 @@ common::Status InferenceSession::ValidateInputs(const std::vector<std::string>&
   return Status::OK();
 }
 
-common::Status InferenceSession::ValidateOutputs(const std::vector<std::string>& output_names,
+common::Status InferenceSession::ValidateOutputNames(const std::vector<std::string>& output_names) const {
+  if (output_names.empty()) {
+    return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "At least one output should be requested.");
+  }
+
+  for (const auto& name : output_names) {
+    if (model_output_names_.find(name) == model_output_names_.end()) {
+      return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Invalid Output Name:" + name);
+    }
+  }
+
+  return common::Status::OK();
+}
+
+common::Status InferenceSession::ValidateOutputs(const PreparedRun& prepared_run,
                                                  const std::vector<OrtValue>* p_fetches) const {
   if (p_fetches == nullptr) {
     return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Output vector pointer is NULL");
   }
 
-  if (output_names.empty()) {
-    return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "At least one output should be requested.");
-  }
-
+  const auto& output_names = prepared_run.GetOutputNames();
   if (!p_fetches->empty() && (output_names.size() != p_fetches->size())) {
     std::ostringstream ostr;
     ostr << "Output vector incorrectly sized: output_names.size(): " << output_names.size()
@@ -1029,20 +1136,80 @@ common::Status InferenceSession::ValidateOutputs(const std::vector<std::string>&
     return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, ostr.str());
   }
 
-  for (const auto& name : output_names) {
-    if (model_output_names_.find(name) == model_output_names_.end()) {
-      return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Invalid Output Name:" + name);
+  // TODO add more validation here like checking shape of the allocated buffers
+
+  return common::Status::OK();
+}
+
+common::Status InferenceSession::PrepareRun(const std::vector<std::string>& feed_names,
+                                            const std::vector<std::string>& output_names,
+                                            std::unique_ptr<PreparedRun>& prepared_run) const {
+  if (!is_inited_) {
+    LOGS(*session_logger_, ERROR) << "Session was not initialized";
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+
+  std::vector<PreparedRun::FeedDef> feed_defs;
+  feed_defs.reserve(feed_names.size());
+
+  for (const auto& feed_name : feed_names) {
+    auto iter = input_def_map_.find(feed_name);
+    if (input_def_map_.end() == iter) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid Feed Input Name:", feed_name);
     }
+
+    feed_defs.push_back({iter->second.ml_data_type, &iter->second.tensor_shape});
   }
 
-  // TODO add more validation here like checking shape of the allocated buffers
+  ORT_RETURN_IF_ERROR(ValidateOutputNames(output_names));
 
-  return common::Status::OK();
+  std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager;
+  ORT_RETURN_IF_ERROR(FeedsFetchesManager::Create(feed_names, output_names,
+                                                  session_state_->GetOrtValueNameIdxMap(),
+                                                  feeds_fetches_manager));
+  ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(*session_state_, *feeds_fetches_manager));
+
+  prepared_run.reset(new PreparedRun(*this, std::move(feeds_fetches_manager), std::move(feed_defs)));
+  return Status::OK();
 }
 
 Status InferenceSession::Run(const RunOptions& run_options, const std::vector<std::string>& feed_names,
                              const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
                              std::vector<OrtValue>* p_fetches) {
+  // the lock only covers the cache lookup so concurrent Run calls don't wait for each other. entries are never
+  // removed, so the PreparedRun stays valid after the lock is released.
+  const auto key = std::tie(feed_names, output_names);
+  const PreparedRun* cached_run = nullptr;
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(prepared_runs_mutex_);
+    auto it = prepared_runs_.find(key);
+    if (it != prepared_runs_.end()) {
+      cached_run = it->second.get();
+    }
+  }
+
+  if (cached_run != nullptr) {
+    return Run(run_options, *cached_run, feeds, p_fetches);
+  }
+
+  std::unique_ptr<PreparedRun> prepared_run;
+  ORT_RETURN_IF_ERROR_SESSIONID_(PrepareRun(feed_names, output_names, prepared_run));
+
+  // once the cache is full any other combination of names is prepared on every call
+  cached_run = prepared_run.get();
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(prepared_runs_mutex_);
+    if (prepared_runs_.size() < kMaxCachedPreparedRuns) {
+      // another thread may have added the same names in the meantime, in which case its entry is kept
+      cached_run = prepared_runs_.emplace(key, std::move(prepared_run)).first->second.get();
+    }
+  }
+
+  return Run(run_options, *cached_run, feeds, p_fetches);
+}
+
+Status InferenceSession::Run(const RunOptions& run_options, const PreparedRun& prepared_run,
+                             const std::vector<OrtValue>& feeds, std::vector<OrtValue>* p_fetches) {
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.StartTime();
@@ -1073,16 +1240,24 @@ Status InferenceSession::Run(const RunOptions& run_options, const std::vector<st
       telemetry_.isEvaluationStart = true;
     }
 
-    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
-    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+    if (prepared_run.session_ != this) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The prepared run was created by a different session.");
+    }
 
-    FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
-    FeedsFetchesManager feeds_fetches_manager{std::move(info)};
+    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(prepared_run, feeds));
+    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(prepared_run, p_fetches));
 
     if (!run_options.run_tag.empty()) {
       LOGS(*session_logger_, INFO) << "Running with tag: " << run_options.run_tag;
     }
 
+    // the session has no timer to shrink the arenas while it's idle, so the first run after the idle time does it
+    const int64_t idle_ms = session_options_.arena_shrink_idle_ms;
+    if (idle_ms > 0 && current_num_runs_ == 0 && last_run_end_time_us_ > 0 &&
+        SteadyClockMicroSeconds() - last_run_end_time_us_ >= idle_ms * 1000) {
+      ShrinkMemoryArenas();
+    }
+
     ++current_num_runs_;
 
     // TODO should we add this exec to the list of executors? i guess its not needed now?
@@ -1109,7 +1284,7 @@ Status InferenceSession::Run(const RunOptions& run_options, const std::vector<st
 
     // execute the graph
     ORT_CHECK_AND_SET_RETVAL(
-        utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
+        utils::ExecuteGraph(*session_state_, *prepared_run.feeds_fetches_manager_, feeds, *p_fetches,
                             session_options_.execution_mode,
                             run_options.terminate, run_logger));
 
@@ -1127,6 +1302,13 @@ Status InferenceSession::Run(const RunOptions& run_options, const std::vector<st
 
   --current_num_runs_;
 
+  const int64_t num_completed_runs = ++num_completed_runs_;
+  const int interval_runs = session_options_.arena_shrink_interval_runs;
+  if (run_options.shrink_memory_arenas || (interval_runs > 0 && num_completed_runs % interval_runs == 0)) {
+    ShrinkMemoryArenas();
+  }
+  last_run_end_time_us_ = SteadyClockMicroSeconds();
+
   // keep track of telemetry
   ++telemetry_.total_runs_since_last_;
   telemetry_.total_run_duration_since_last_ += TimeDiffMicroSeconds(tp);
@@ -3,13 +3,16 @@
 
 #pragma once
 
+#include <map>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/common/profiler.h"
 #include "core/common/status.h"
+#include "core/framework/arena.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/iexecutor.h"
@@ -20,6 +23,7 @@
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
 #include "core/framework/session_options.h"
+#include "core/platform/env.h"
 
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 #include "core/language_interop_ops/language_interop_ops.h"
@@ -47,6 +51,7 @@ class IExecutionProvider;  // forward decl
 class IOBinding;
 class CustomRegistry;
 class Notification;
+class PrepackedWeightsContainer;
 
 namespace logging {
 class LoggingManager;
@@ -71,6 +76,46 @@ struct ModelMetadata {
   std::unordered_map<std::string, std::string> custom_metadata_map;
 };
 
+class InferenceSession;
+
+/**
+  * Feed and fetch names resolved once by InferenceSession::PrepareRun.
+  * Reusing it across Run calls skips the per-call name lookups and device copy checks.
+  * It is not modified by Run, so concurrent Run calls can share it.
+  * It can only be used with the InferenceSession that created it and must not outlive that session.
+  */
+class PreparedRun {
+ public:
+  const std::vector<std::string>& GetFeedNames() const {
+    return feeds_fetches_manager_->GetFeedsFetchesInfo().feed_names;
+  }
+
+  const std::vector<std::string>& GetOutputNames() const {
+    return feeds_fetches_manager_->GetFeedsFetchesInfo().output_names;
+  }
+
+ private:
+  friend class InferenceSession;
+
+  // expected type and shape of a feed. the shape is owned by the InferenceSession.
+  struct FeedDef {
+    MLDataType ml_data_type;
+    const TensorShape* tensor_shape;
+  };
+
+  PreparedRun(const InferenceSession& session, std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager,
+              std::vector<FeedDef>&& feed_defs)
+      : session_(&session),
+        feeds_fetches_manager_(std::move(feeds_fetches_manager)),
+        feed_defs_(std::move(feed_defs)) {}
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PreparedRun);
+
+  const InferenceSession* session_;
+  std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager_;
+  std::vector<FeedDef> feed_defs_;
+};
+
 /**
  * @brief This is the main class used to Run a model.
  * Sample simple usage:
@@ -197,6 +242,23 @@ class InferenceSession {
     */
   common::Status AddCustomOpDomains(const std::vector<OrtCustomOpDomain*>& ops);
 
+  /**
+    * Set the container used to share pre-packed weights with other sessions. Kernels that pre-pack
+    * constant initializers will use the packed buffers held by the container instead of keeping their own.
+    * The container must outlive the session. Call this before invoking Initialize().
+    * This API is not thread safe.
+    */
+  common::Status SetPrepackedWeightsContainer(PrepackedWeightsContainer* prepacked_weights_container);
+
+  /**
+    * Use thread pools shared with other sessions, such as the global thread pools of the environment, when
+    * SessionOptions::use_per_session_threads is false. A nullptr pool runs that work on the calling thread.
+    * The thread pools must outlive the session. Call this before invoking Initialize().
+    * This API is not thread safe.
+    */
+  common::Status SetGlobalThreadPools(concurrency::ThreadPool* intra_op_thread_pool,
+                                      concurrency::ThreadPool* inter_op_thread_pool);
+
   /**
     * Register a custom registry for operator schema and kernels.  If you've one to register,
     * call this before invoking Initialize().
@@ -252,6 +314,28 @@ class InferenceSession {
                      const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
                      std::vector<OrtValue>* p_fetches);
 
+  /**
+    * Resolve the feed and fetch names, and the device copy information for them, once for repeated Run calls
+    * using the same inputs and outputs.
+    * This API is thread-safe.
+    * @param feed_names names of the inputs that will be fed.
+    * @param output_names names of the outputs that will be fetched.
+    * @param prepared_run set to the resolved information on success.
+    * @return OK if success.
+    */
+  common::Status PrepareRun(const std::vector<std::string>& feed_names, const std::vector<std::string>& output_names,
+                            std::unique_ptr<PreparedRun>& prepared_run) const;
+
+  /**
+    * Run a pre-loaded and pre-intialized model using feed and fetch names resolved by PrepareRun.
+    * Multiple threads are allowed to run this function, including with the same prepared_run; hence its thread-safe.
+    * @param feeds inputs in the order of prepared_run.GetFeedNames().
+    * @param p_fetches output values in the order of prepared_run.GetOutputNames().
+    * @return OK if success.
+    */
+  common::Status Run(const RunOptions& run_options, const PreparedRun& prepared_run,
+                     const std::vector<OrtValue>& feeds, std::vector<OrtValue>* p_fetches);
+
   /**
     * Run a pre-loaded and pre-intialized model.
     * Multiple threads are allowed to run this function; hence its thread-safe.
@@ -318,6 +402,18 @@ class InferenceSession {
     */
   int GetCurrentNumRuns() const;
 
+  /**
+    * Return the memory regions of the session's arenas that have nothing in use to their devices.
+    * Safe to call while other Run calls are in progress.
+    */
+  void ShrinkMemoryArenas();
+
+  /**
+    * Get the statistics of the session's arena for mem_info.
+    * @return INVALID_ARGUMENT if the session has no allocator for mem_info, or that allocator isn't an arena.
+    */
+  common::Status GetAllocatorStats(const OrtMemoryInfo& mem_info, AllocatorStats& stats) const;
+
   /**
     * Get the names of registered Execution Providers. The returned vector is ordered by Execution Provider
     * priority. The first provider in the vector has the highest priority.
@@ -378,6 +474,10 @@ class InferenceSession {
   // if they need.
   std::shared_ptr<onnxruntime::Model> model_;
 
+  // The model file mapped into memory with SessionOptions::use_mapped_model_loading. The initializers of the model
+  // and the initialized tensors of the session state refer to it, so it must outlive both.
+  Env::MappedMemoryPtr model_data_;
+
   // names of model outputs used for quick validation.
   std::unordered_set<std::string> model_output_names_;
 
@@ -427,9 +527,11 @@ class InferenceSession {
                              const TensorShape& input_shape,
                              const TensorShape& expected_shape) const;
 
-  common::Status ValidateInputs(const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds) const;
+  common::Status ValidateOutputNames(const std::vector<std::string>& output_names) const;
 
-  common::Status ValidateOutputs(const std::vector<std::string>& output_names, const std::vector<OrtValue>* p_fetches) const;
+  common::Status ValidateInputs(const PreparedRun& prepared_run, const std::vector<OrtValue>& feeds) const;
+
+  common::Status ValidateOutputs(const PreparedRun& prepared_run, const std::vector<OrtValue>* p_fetches) const;
 
   common::Status WaitForNotification(Notification* p_executor_done, int64_t timeout_in_ms);
 
@@ -473,6 +575,12 @@ class InferenceSession {
   KernelRegistryManager kernel_registry_manager_;
   std::list<std::shared_ptr<onnxruntime::IOnnxRuntimeOpSchemaCollection>> custom_schema_registries_;
 
+  // Container for pre-packed weights shared between sessions. Not owned. nullptr if sharing is not enabled.
+  PrepackedWeightsContainer* prepacked_weights_container_ = nullptr;
+
+  // true once SetGlobalThreadPools was called. Only needed when the session has no thread pools of its own.
+  bool global_thread_pools_set_ = false;
+
   // A set of executors that can run in parallel.
   std::vector<std::unique_ptr<IExecutor>> executors_;  // TODO do we need this vector?
 
@@ -496,6 +604,17 @@ class InferenceSession {
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_;
 
+  // for the arena shrink policy of the session options
+  std::atomic<int64_t> num_completed_runs_{0};
+  std::atomic<int64_t> last_run_end_time_us_{0};
+
+  // PreparedRun for each combination of feed and output names passed to the name based Run, so repeated calls
+  // skip resolving the names. Entries are never removed, so a PreparedRun can be used after releasing the lock.
+  static constexpr size_t kMaxCachedPreparedRuns = 64;
+  using PreparedRunKey = std::tuple<std::vector<std::string>, std::vector<std::string>>;
+  mutable onnxruntime::OrtMutex prepared_runs_mutex_;
+  std::map<PreparedRunKey, std::unique_ptr<PreparedRun>, std::less<>> prepared_runs_;  // GUARDED_BY(prepared_runs_mutex_)
+
   mutable onnxruntime::OrtMutex session_mutex_;  // to ensure only one thread can invoke Load/Initialize
   bool is_model_loaded_ = false;                 // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;                       // GUARDED_BY(session_mutex_)
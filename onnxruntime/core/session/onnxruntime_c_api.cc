@@ -28,6 +28,7 @@
 #include "abi_session_options_impl.h"
 #include "core/framework/TensorSeq.h"
 #include "core/platform/ort_mutex.h"
+#include "core/util/thread_utils.h"
 
 using namespace onnxruntime::logging;
 using onnxruntime::BFloat16;
@@ -80,6 +81,90 @@ ORT_API_STATUS_IMPL(OrtApis::CreateEnv, OrtLoggingLevel default_warning_level,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateEnvWithGlobalThreadPools, OrtLoggingLevel default_logging_level,
+                    _In_ const char* logid, _In_ const OrtThreadingOptions* threading_options,
+                    _Outptr_ OrtEnv** out) {
+  API_IMPL_BEGIN
+  if (threading_options == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "threading_options cannot be null");
+  }
+  OrtEnv::LoggingManagerConstructionInfo lm_info{nullptr, nullptr, default_logging_level, logid};
+  Status status;
+  *out = OrtEnv::GetInstance(lm_info, status, threading_options);
+  return ToOrtStatus(status);
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CreateThreadingOptions, _Outptr_ OrtThreadingOptions** out) {
+  API_IMPL_BEGIN
+  *out = new OrtThreadingOptions();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetGlobalIntraOpNumThreads, _Inout_ OrtThreadingOptions* tp_options,
+                    int intra_op_num_threads) {
+  tp_options->intra_op_thread_pool_params.thread_pool_size = intra_op_num_threads;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetGlobalInterOpNumThreads, _Inout_ OrtThreadingOptions* tp_options,
+                    int inter_op_num_threads) {
+  tp_options->inter_op_thread_pool_params.thread_pool_size = inter_op_num_threads;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetGlobalSpinDuration, _Inout_ OrtThreadingOptions* tp_options, int spin_duration_us) {
+  if (spin_duration_us < 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "spin_duration_us must be 0 or greater");
+  }
+  tp_options->intra_op_thread_pool_params.spin_duration_us = spin_duration_us;
+  tp_options->inter_op_thread_pool_params.spin_duration_us = spin_duration_us;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetGlobalAllowSpinning, _Inout_ OrtThreadingOptions* tp_options, int allow_spinning) {
+  tp_options->intra_op_thread_pool_params.allow_spinning = allow_spinning != 0;
+  tp_options->inter_op_thread_pool_params.allow_spinning = allow_spinning != 0;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetGlobalThreadAffinity, _Inout_ OrtThreadingOptions* tp_options,
+                    OrtThreadAffinityPolicy policy,
+                    _In_opt_ const size_t* logical_processors, size_t num_logical_processors) {
+  std::vector<size_t> affinity;
+  switch (policy) {
+    case ORT_THREAD_AFFINITY_NONE:
+    case ORT_THREAD_AFFINITY_COMPACT:
+    case ORT_THREAD_AFFINITY_SCATTER:
+      break;
+    case ORT_THREAD_AFFINITY_EXPLICIT:
+      if (logical_processors == nullptr || num_logical_processors == 0) {
+        return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                     "ORT_THREAD_AFFINITY_EXPLICIT requires a list of logical processors");
+      }
+      affinity.assign(logical_processors, logical_processors + num_logical_processors);
+      break;
+    default:
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "unknown thread affinity policy");
+  }
+
+  for (auto* params : {&tp_options->intra_op_thread_pool_params, &tp_options->inter_op_thread_pool_params}) {
+    params->affinity_policy = policy;
+    params->affinity = affinity;
+  }
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetGlobalNumaNode, _Inout_ OrtThreadingOptions* tp_options, int numa_node) {
+  if (numa_node < -1) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "numa_node must be -1 or greater");
+  }
+  tp_options->intra_op_thread_pool_params.numa_node = numa_node;
+  tp_options->inter_op_thread_pool_params.numa_node = numa_node;
+  return nullptr;
+}
+
 // enable platform telemetry
 ORT_API_STATUS_IMPL(OrtApis::EnableTelemetryEvents, _In_ const OrtEnv* ort_env) {
   API_IMPL_BEGIN
@@ -353,7 +438,7 @@ ORT_API_STATUS_IMPL(OrtApis::RegisterCustomOpsLibrary, _Inout_ OrtSessionOptions
 }
 
 namespace {
-OrtStatus* LoadAndInitializeSession(_In_ const OrtEnv* /*env*/, _In_ const OrtSessionOptions* options,
+OrtStatus* LoadAndInitializeSession(_In_ const OrtEnv* env, _In_ const OrtSessionOptions* options,
                                     _In_ std::unique_ptr<::onnxruntime::InferenceSession>& sess,
                                     _Outptr_ OrtSession** out) {
   // we need to disable mem pattern if DML is one of the providers since DML doesn't have the concept of
@@ -383,6 +468,29 @@ OrtStatus* LoadAndInitializeSession(_In_ const OrtEnv* /*env*/, _In_ const OrtSe
       if (!status.IsOK())
         return ToOrtStatus(status);
     }
+
+    // sessions created from the same env share the weights their kernels pre-pack
+    if (options->value.share_prepacked_weights) {
+      status = sess->SetPrepackedWeightsContainer(env->GetEnvironment().GetPrepackedWeightsContainer());
+      if (!status.IsOK())
+        return ToOrtStatus(status);
+    }
+
+    if (!options->value.use_per_session_threads) {
+      if (!env->GetEnvironment().EnvCreatedWithGlobalThreadPools()) {
+        return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                     "Per-session threads are disabled but the env has no global thread pools. "
+                                     "Create the env with CreateEnvWithGlobalThreadPools.");
+      }
+      // only a parallel session needs the inter-op pool, so don't make the env create it otherwise
+      const auto& environment = env->GetEnvironment();
+      status = sess->SetGlobalThreadPools(environment.GetIntraOpThreadPool(),
+                                          options->value.execution_mode == ExecutionMode::ORT_PARALLEL
+                                              ? environment.GetInterOpThreadPool()
+                                              : nullptr);
+      if (!status.IsOK())
+        return ToOrtStatus(status);
+    }
   }
 
   // register the providers
@@ -437,39 +545,25 @@ ORT_API_STATUS_IMPL(OrtApis::CreateSessionFromArray, _In_ const OrtEnv* env, _In
   API_IMPL_END
 }
 
-ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess,
-                    _In_opt_ const OrtRunOptions* run_options,
-                    _In_ const char* const* input_names, _In_ const OrtValue* const* input, size_t input_len,
-                    _In_ const char* const* output_names1, size_t output_names_len, _Outptr_ OrtValue** output) {
-  API_IMPL_BEGIN
-  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+namespace {
+// wrap the user provided inputs, waiting on any fences
+void CreateFeeds(_In_ const OrtValue* const* input, size_t input_len, std::vector<OrtValue>& feeds) {
   const int queue_id = 0;
 
-  std::vector<std::string> feed_names(input_len);
-  std::vector<OrtValue> feeds(input_len);
-
+  feeds.resize(input_len);
   for (size_t i = 0; i != input_len; ++i) {
-    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
-      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
-    }
-
-    feed_names[i] = input_names[i];
     auto& ort_value = feeds[i] = *reinterpret_cast<const ::OrtValue*>(input[i]);
 
     if (ort_value.Fence()) ort_value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
   }
+}
 
-  // Create output feed
-  std::vector<std::string> output_names(output_names_len);
-  for (size_t i = 0; i != output_names_len; ++i) {
-    if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
-      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
-    }
-    output_names[i] = output_names1[i];
-  }
+// wrap any pre-allocated outputs provided by the user
+void CreateFetches(_In_ OrtValue* const* output, size_t output_len, std::vector<OrtValue>& fetches) {
+  const int queue_id = 0;
 
-  std::vector<OrtValue> fetches(output_names_len);
-  for (size_t i = 0; i != output_names_len; ++i) {
+  fetches.resize(output_len);
+  for (size_t i = 0; i != output_len; ++i) {
     if (output[i] != nullptr) {
       ::OrtValue& value = *(output[i]);
       if (value.Fence())
@@ -477,6 +571,57 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess,
       fetches[i] = value;
     }
   }
+}
+
+// return the fetches to the user, allocating OrtValue instances for outputs that were not pre-allocated
+void ReturnFetches(std::vector<OrtValue>& fetches, _Inout_ OrtValue** output) {
+  const int queue_id = 0;
+
+  for (size_t i = 0, end = fetches.size(); i != end; ++i) {
+    ::OrtValue& value = fetches[i];
+    if (value.Fence())
+      value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+    if (output[i] == nullptr) {
+      output[i] = new OrtValue(value);
+    }
+  }
+}
+
+OrtStatus* CreateNames(_In_ const char* const* names, size_t names_len, const char* kind,
+                       std::vector<std::string>& out) {
+  out.resize(names_len);
+  for (size_t i = 0; i != names_len; ++i) {
+    if (names[i] == nullptr || names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, (std::string(kind) + " name cannot be empty").c_str());
+    }
+    out[i] = names[i];
+  }
+  return nullptr;
+}
+}  // namespace
+
+ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess,
+                    _In_opt_ const OrtRunOptions* run_options,
+                    _In_ const char* const* input_names, _In_ const OrtValue* const* input, size_t input_len,
+                    _In_ const char* const* output_names1, size_t output_names_len, _Outptr_ OrtValue** output) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::string> feed_names;
+  if (auto* status = CreateNames(input_names, input_len, "input", feed_names))
+    return status;
+
+  std::vector<OrtValue> feeds;
+  CreateFeeds(input, input_len, feeds);
+
+  // Create output feed
+  std::vector<std::string> output_names;
+  if (auto* status = CreateNames(output_names1, output_names_len, "output", output_names))
+    return status;
+
+  std::vector<OrtValue> fetches;
+  CreateFetches(output, output_names_len, fetches);
+
   Status status;
   if (run_options == nullptr) {
     OrtRunOptions op;
@@ -487,14 +632,68 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess,
 
   if (!status.IsOK())
     return ToOrtStatus(status);
-  for (size_t i = 0; i != output_names_len; ++i) {
-    ::OrtValue& value = fetches[i];
-    if (value.Fence())
-      value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
-    if (output[i] == nullptr) {
-      output[i] = new OrtValue(value);
-    }
+
+  ReturnFetches(fetches, output);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CreateRunHandle, _In_ const OrtSession* sess,
+                    _In_ const char* const* input_names, size_t input_len,
+                    _In_ const char* const* output_names1, size_t output_names_len,
+                    _Outptr_ OrtRunHandle** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::string> feed_names;
+  if (auto* status = CreateNames(input_names, input_len, "input", feed_names))
+    return status;
+
+  std::vector<std::string> output_names;
+  if (auto* status = CreateNames(output_names1, output_names_len, "output", output_names))
+    return status;
+
+  std::unique_ptr<::onnxruntime::PreparedRun> prepared_run;
+  auto status = session->PrepareRun(feed_names, output_names, prepared_run);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+
+  *out = reinterpret_cast<OrtRunHandle*>(prepared_run.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunWithHandle, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_ const OrtRunHandle* run_handle,
+                    _In_ const OrtValue* const* input, size_t input_len,
+                    _Inout_ OrtValue** output, size_t output_len) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  const auto& prepared_run = *reinterpret_cast<const ::onnxruntime::PreparedRun*>(run_handle);
+
+  if (output_len != prepared_run.GetOutputNames().size()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                 "output_len does not match the number of outputs in the run handle");
+  }
+
+  std::vector<OrtValue> feeds;
+  CreateFeeds(input, input_len, feeds);
+
+  std::vector<OrtValue> fetches;
+  CreateFetches(output, output_len, fetches);
+
+  Status status;
+  if (run_options == nullptr) {
+    OrtRunOptions op;
+    status = session->Run(op, prepared_run, feeds, &fetches);
+  } else {
+    status = session->Run(*run_options, prepared_run, feeds, &fetches);
   }
+
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+
+  ReturnFetches(fetches, output);
   return nullptr;
   API_IMPL_END
 }
@@ -671,6 +870,31 @@ ORT_API_STATUS_IMPL(OrtApis::SessionEndProfiling, _In_ OrtSession* sess, _Inout_
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetAllocatorStats, _In_ const OrtSession* sess, _In_ const OrtMemoryInfo* mem_info,
+                    _Out_ OrtAllocatorStats* out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  onnxruntime::AllocatorStats stats;
+  auto status = session->GetAllocatorStats(*mem_info, stats);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+
+  out->num_allocs = stats.num_allocs;
+  out->bytes_in_use = stats.bytes_in_use;
+  out->total_allocated_bytes = stats.total_allocated_bytes;
+  out->max_bytes_in_use = stats.max_bytes_in_use;
+  out->max_alloc_size = stats.max_alloc_size;
+  out->bytes_limit = stats.bytes_limit;
+  out->num_thread_cache_hits = stats.num_thread_cache_hits;
+  out->bytes_in_thread_caches = stats.bytes_in_thread_caches;
+  out->num_lock_contentions = stats.num_lock_contentions;
+  out->num_regions = stats.num_regions;
+  out->largest_free_block = stats.largest_free_block;
+  out->total_released_bytes = stats.total_released_bytes;
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::SessionGetModelMetadata, _In_ const OrtSession* sess,
                     _Outptr_ OrtModelMetadata** out) {
   API_IMPL_BEGIN
@@ -1500,6 +1724,32 @@ static constexpr OrtApi ort_api_1_to_2 = {
     &OrtApis::ModelMetadataLookupCustomMetadataMap,
     &OrtApis::ModelMetadataGetVersion,
     &OrtApis::ReleaseModelMetadata,
+    &OrtApis::EnablePrePackedWeightsSharing,
+    &OrtApis::DisablePrePackedWeightsSharing,
+    &OrtApis::CreateRunHandle,
+    &OrtApis::RunWithHandle,
+    &OrtApis::ReleaseRunHandle,
+    &OrtApis::SetThreadPoolSpinDuration,
+    &OrtApis::SetThreadPoolAllowSpinning,
+    &OrtApis::SetThreadPoolAffinity,
+    &OrtApis::SetThreadPoolNumaNode,
+    &OrtApis::CreateEnvWithGlobalThreadPools,
+    &OrtApis::DisablePerSessionThreads,
+    &OrtApis::CreateThreadingOptions,
+    &OrtApis::ReleaseThreadingOptions,
+    &OrtApis::SetGlobalIntraOpNumThreads,
+    &OrtApis::SetGlobalInterOpNumThreads,
+    &OrtApis::SetGlobalSpinDuration,
+    &OrtApis::SetGlobalAllowSpinning,
+    &OrtApis::SetGlobalThreadAffinity,
+    &OrtApis::SetGlobalNumaNode,
+    &OrtApis::SetArenaShrinkPolicy,
+    &OrtApis::SetCpuMemArenaMaxBytes,
+    &OrtApis::RunOptionsSetShrinkArenas,
+    &OrtApis::SessionGetAllocatorStats,
+    &OrtApis::SetMemPatternShapeBuckets,
+    &OrtApis::EnableMappedModelLoading,
+    &OrtApis::DisableMappedModelLoading,
 };
 
 // Assert to do a limited check to ensure Version 1 of OrtApi never changes (will detect an addition or deletion but not if they cancel out each other)
@@ -1529,3 +1779,5 @@ DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Value, OrtValue)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(RunOptions, OrtRunOptions)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Session, ::onnxruntime::InferenceSession)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(ModelMetadata, ::onnxruntime::ModelMetadata)
+DEFINE_RELEASE_ORT_OBJECT_FUNCTION(RunHandle, ::onnxruntime::PreparedRun)
+DEFINE_RELEASE_ORT_OBJECT_FUNCTION(ThreadingOptions, OrtThreadingOptions)
@@ -19,6 +19,8 @@ ORT_API(void, ReleaseCustomOpDomain, OrtCustomOpDomain*);
 ORT_API(void, ReleaseMapTypeInfo, OrtMapTypeInfo*);
 ORT_API(void, ReleaseSequenceTypeInfo, OrtSequenceTypeInfo*);
 ORT_API(void, ReleaseModelMetadata, OrtModelMetadata*);
+ORT_API(void, ReleaseRunHandle, OrtRunHandle*);
+ORT_API(void, ReleaseThreadingOptions, OrtThreadingOptions*);
 
 ORT_API_STATUS_IMPL(CreateStatus, OrtErrorCode code, _In_ const char* msg);
 OrtErrorCode ORT_API_CALL GetErrorCode(_In_ const OrtStatus* status) NO_EXCEPTION ORT_ALL_ARGS_NONNULL;
@@ -94,6 +96,46 @@ ORT_API_STATUS_IMPL(ModelMetadataLookupCustomMetadataMap, _In_ const OrtModelMet
 ORT_API_STATUS_IMPL(ModelMetadataGetVersion, _In_ const OrtModelMetadata* model_metadata,
                     _Out_ int64_t* value);
 
+ORT_API_STATUS_IMPL(EnablePrePackedWeightsSharing, _In_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(DisablePrePackedWeightsSharing, _In_ OrtSessionOptions* options);
+
+ORT_API_STATUS_IMPL(CreateRunHandle, _In_ const OrtSession* sess,
+                    _In_ const char* const* input_names, size_t input_len,
+                    _In_ const char* const* output_names, size_t output_names_len,
+                    _Outptr_ OrtRunHandle** out);
+ORT_API_STATUS_IMPL(RunWithHandle, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_ const OrtRunHandle* run_handle,
+                    _In_ const OrtValue* const* input, size_t input_len,
+                    _Inout_ OrtValue** output, size_t output_len);
+
+ORT_API_STATUS_IMPL(SetThreadPoolSpinDuration, _Inout_ OrtSessionOptions* options, int spin_duration_us);
+ORT_API_STATUS_IMPL(SetThreadPoolAllowSpinning, _Inout_ OrtSessionOptions* options, int allow_spinning);
+ORT_API_STATUS_IMPL(SetThreadPoolAffinity, _Inout_ OrtSessionOptions* options, OrtThreadAffinityPolicy policy,
+                    _In_opt_ const size_t* logical_processors, size_t num_logical_processors);
+ORT_API_STATUS_IMPL(SetThreadPoolNumaNode, _Inout_ OrtSessionOptions* options, int numa_node);
+
+ORT_API_STATUS_IMPL(CreateEnvWithGlobalThreadPools, OrtLoggingLevel default_logging_level, _In_ const char* logid,
+                    _In_ const OrtThreadingOptions* threading_options, _Outptr_ OrtEnv** out);
+ORT_API_STATUS_IMPL(DisablePerSessionThreads, _Inout_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(CreateThreadingOptions, _Outptr_ OrtThreadingOptions** out);
+ORT_API_STATUS_IMPL(SetGlobalIntraOpNumThreads, _Inout_ OrtThreadingOptions* tp_options, int intra_op_num_threads);
+ORT_API_STATUS_IMPL(SetGlobalInterOpNumThreads, _Inout_ OrtThreadingOptions* tp_options, int inter_op_num_threads);
+ORT_API_STATUS_IMPL(SetGlobalSpinDuration, _Inout_ OrtThreadingOptions* tp_options, int spin_duration_us);
+ORT_API_STATUS_IMPL(SetGlobalAllowSpinning, _Inout_ OrtThreadingOptions* tp_options, int allow_spinning);
+ORT_API_STATUS_IMPL(SetGlobalThreadAffinity, _Inout_ OrtThreadingOptions* tp_options, OrtThreadAffinityPolicy policy,
+                    _In_opt_ const size_t* logical_processors, size_t num_logical_processors);
+ORT_API_STATUS_IMPL(SetGlobalNumaNode, _Inout_ OrtThreadingOptions* tp_options, int numa_node);
+
+ORT_API_STATUS_IMPL(SetArenaShrinkPolicy, _Inout_ OrtSessionOptions* options, int interval_runs, int64_t idle_ms);
+ORT_API_STATUS_IMPL(SetCpuMemArenaMaxBytes, _Inout_ OrtSessionOptions* options, size_t max_bytes);
+ORT_API_STATUS_IMPL(RunOptionsSetShrinkArenas, _Inout_ OrtRunOptions* options, int shrink);
+ORT_API_STATUS_IMPL(SetMemPatternShapeBuckets, _Inout_ OrtSessionOptions* options, _In_opt_ const int64_t* dim_buckets,
+                    size_t num_buckets, size_t max_patterns);
+ORT_API_STATUS_IMPL(SessionGetAllocatorStats, _In_ const OrtSession* sess, _In_ const OrtMemoryInfo* mem_info,
+                    _Out_ OrtAllocatorStats* out);
+ORT_API_STATUS_IMPL(EnableMappedModelLoading, _Inout_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(DisableMappedModelLoading, _Inout_ OrtSessionOptions* options);
+
 ORT_API_STATUS_IMPL(CreateRunOptions, _Outptr_ OrtRunOptions** out);
 
 ORT_API_STATUS_IMPL(RunOptionsSetRunLogVerbosityLevel, _Inout_ OrtRunOptions* options, int value);
@@ -34,11 +34,13 @@ OrtEnv::OrtEnv(std::unique_ptr<onnxruntime::Environment> value1, std::unique_ptr
     : value_(std::move(value1)), logging_manager_(std::move(logging_manager)) {
 }
 
-OrtEnv* OrtEnv::GetInstance(const OrtEnv::LoggingManagerConstructionInfo& lm_info, onnxruntime::common::Status& status) {
+OrtEnv* OrtEnv::GetInstance(const OrtEnv::LoggingManagerConstructionInfo& lm_info, onnxruntime::common::Status& status,
+                            const OrtThreadingOptions* tp_options) {
   std::lock_guard<onnxruntime::OrtMutex> lock(m_);
   if (!p_instance_) {
     std::unique_ptr<onnxruntime::Environment> env;
-    status = onnxruntime::Environment::Create(env);
+    status = tp_options == nullptr ? onnxruntime::Environment::Create(env)
+                                   : onnxruntime::Environment::Create(env, *tp_options);
     if (!status.IsOK()) {
       return nullptr;
     }
@@ -62,6 +64,10 @@ OrtEnv* OrtEnv::GetInstance(const OrtEnv::LoggingManagerConstructionInfo& lm_inf
     }
 
     p_instance_ = new OrtEnv(std::move(env), std::move(lmgr));
+  } else if (tp_options != nullptr && !p_instance_->GetEnvironment().EnvCreatedWithGlobalThreadPools()) {
+    status = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "The environment already exists and was created without global thread pools.");
+    return nullptr;
   }
   ++ref_count_;
   return p_instance_;
@@ -42,7 +42,9 @@ struct OrtEnv {
     const char* logid{};
   };
 
-  static OrtEnv* GetInstance(const LoggingManagerConstructionInfo& lm_info, onnxruntime::common::Status& status);
+  // tp_options requests global thread pools. It's only used when the environment is first created.
+  static OrtEnv* GetInstance(const LoggingManagerConstructionInfo& lm_info, onnxruntime::common::Status& status,
+                             const OrtThreadingOptions* tp_options = nullptr);
 
   static void Release(OrtEnv* env_ptr);
 
@@ -50,6 +52,8 @@ struct OrtEnv {
 
   void SetLoggingManager(std::unique_ptr<onnxruntime::logging::LoggingManager> logging_manager);
 
+  const onnxruntime::Environment& GetEnvironment() const { return *value_; }
+
  private:
   static OrtEnv* p_instance_;
   static onnxruntime::OrtMutex m_;
@@ -31,12 +31,13 @@ void GemmlowpMultiplyu8u8_u8(const uint8_t* lhs_data, const uint8_t* rhs_data, u
 }
 
 void GemmlowpMultiplyu8u8_s32(const uint8_t* lhs_data, const uint8_t* rhs_data, int32_t* result_data,
-                                const int lhs_offset, const int rhs_offset, int m, int n, int k, concurrency::ThreadPool* ) {
+                                const int lhs_offset, const int rhs_offset, int m, int n, int k, int lda, int ldb, int ldc,
+                                concurrency::ThreadPool* ) {
 
   const auto matOrder = gemmlowp::MapOrder::RowMajor;
-  gemmlowp::MatrixMap<const uint8_t, matOrder> lhs(lhs_data, m, k);
-  gemmlowp::MatrixMap<const uint8_t, matOrder> rhs(rhs_data, k, n);
-  gemmlowp::MatrixMap<std::int32_t, matOrder> result(result_data, m, n);
+  gemmlowp::MatrixMap<const uint8_t, matOrder> lhs(lhs_data, m, k, lda);
+  gemmlowp::MatrixMap<const uint8_t, matOrder> rhs(rhs_data, k, n, ldb);
+  gemmlowp::MatrixMap<std::int32_t, matOrder> result(result_data, m, n, ldc);
 
   gemmlowp::GemmContext gemm_context;
 
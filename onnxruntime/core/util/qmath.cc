@@ -21,6 +21,25 @@
 
 namespace onnxruntime {
 
+#if !defined(MLAS_SUPPORTS_GEMM_U8X8) || defined(USE_GEMMLOWP)
+static void DequantizeAccumulators(
+    int M,
+    int N,
+    const int32_t* accumulator_data,
+    float* result_data,
+    int ldc,
+    const float* result_scale,
+    bool per_column_scale) {
+  for (int m = 0; m < M; m++) {
+    for (int n = 0; n < N; n++) {
+      result_data[n] = static_cast<float>(accumulator_data[n]) * result_scale[per_column_scale ? n : 0];
+    }
+    accumulator_data += N;
+    result_data += ldc;
+  }
+}
+#endif
+
 void QGemmu8s8_s32(
     int M,
     int N,
@@ -64,13 +83,322 @@ void QGemmu8u8_s32(
     concurrency::ThreadPool* thread_pool) {
 #ifdef USE_GEMMLOWP
 
+  GemmlowpMultiplyu8u8_s32(lhs_data, rhs_data, result_data, lhs_offset, rhs_offset, M, N, K, lda, ldb, ldc, thread_pool);
+
+#else
+  MlasGemm(M, N, K, lhs_data, lda, lhs_offset, rhs_data, ldb, rhs_offset, result_data, ldc, thread_pool);
+
+#endif
+}
+
+void QGemmu8u8_u8(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    int lda,
+    const uint8_t lhs_offset,
+    const uint8_t* rhs_data,
+    int ldb,
+    const uint8_t rhs_offset,
+    uint8_t* result_data,
+    int ldc,
+    float real_multiplier,
+    const uint8_t result_offset,
+    int32_t* accumulator_data,
+    concurrency::ThreadPool* thread_pool) {
+#ifdef USE_GEMMLOWP
+  ORT_UNUSED_PARAMETER(accumulator_data);
+  ORT_UNUSED_PARAMETER(thread_pool);
+
   ORT_ENFORCE(lda == K && ldb == N && ldc == N, "For gemmlowp only RowMajor*RowMajor=RowMajor format is supported");
 
-  GemmlowpMultiplyu8u8_s32(lhs_data, rhs_data, result_data, lhs_offset, rhs_offset, M, N, K, thread_pool);
+  int32_t integer_multiplier;
+  int right_shift;
+  QuantizeMultiplier(real_multiplier, &integer_multiplier, &right_shift);
+
+  GemmlowpMultiplyu8u8_u8(lhs_data, rhs_data, result_data, lhs_offset, rhs_offset, result_offset,
+                          M, N, K, integer_multiplier, right_shift);
 
 #else
-  MlasGemm(M, N, K, lhs_data, lda, lhs_offset, rhs_data, ldb, rhs_offset, result_data, ldc, thread_pool);
+  MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR requant_processor(result_data, ldc, nullptr, &real_multiplier, false,
+                                                        result_offset);
+
+  MlasGemm(M, N, K, lhs_data, lda, lhs_offset, rhs_data, ldb, rhs_offset, accumulator_data, N, thread_pool,
+           &requant_processor);
+
+#endif
+}
+
+void QGemmu8s8_f32(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    int lda,
+    const uint8_t lhs_offset,
+    const int8_t* rhs_data,
+    int ldb,
+    const int8_t rhs_offset,
+    float* result_data,
+    int ldc,
+    const float* result_scale,
+    bool per_column_scale,
+    int32_t* accumulator_data,
+    concurrency::ThreadPool* thread_pool) {
+#ifdef MLAS_SUPPORTS_GEMM_U8X8
+
+  MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR scale_bias_processor(result_data, ldc, result_scale, per_column_scale,
+                                                              nullptr, nullptr);
+
+  MlasGemm(M, N, K, lhs_data, lda, lhs_offset, rhs_data, ldb, rhs_offset, accumulator_data, N, thread_pool,
+           &scale_bias_processor);
+
+#else
+  ORT_UNUSED_PARAMETER(thread_pool);
+
+  ORT_ENFORCE(rhs_offset == 0, "For Eigen, the rhs zero point must be zero");
+  ORT_ENFORCE(lda == K && ldb == N, "For Eigen only RowMajor*RowMajor=RowMajor format is supported");
+
+  EigenCastGEMM<uint8_t, int8_t, int32_t>(lhs_data, rhs_data, accumulator_data, M, N, K);
+
+  // Remove the lhs zero point from the accumulators: sum((a - a_zp) * b) = sum(a * b) - a_zp * sum(b).
+  if (lhs_offset != 0) {
+    std::vector<int32_t> rhs_column_sums(N, 0);
+    for (int k = 0; k < K; k++) {
+      for (int n = 0; n < N; n++) {
+        rhs_column_sums[n] += rhs_data[k * N + n];
+      }
+    }
+    for (int m = 0; m < M; m++) {
+      for (int n = 0; n < N; n++) {
+        accumulator_data[m * N + n] -= static_cast<int32_t>(lhs_offset) * rhs_column_sums[n];
+      }
+    }
+  }
+
+  DequantizeAccumulators(M, N, accumulator_data, result_data, ldc, result_scale, per_column_scale);
+
+#endif
+}
+
+void QGemmu8u8_f32(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    int lda,
+    const uint8_t lhs_offset,
+    const uint8_t* rhs_data,
+    int ldb,
+    const uint8_t rhs_offset,
+    float* result_data,
+    int ldc,
+    const float* result_scale,
+    bool per_column_scale,
+    int32_t* accumulator_data,
+    concurrency::ThreadPool* thread_pool) {
+#ifdef USE_GEMMLOWP
+
+  GemmlowpMultiplyu8u8_s32(lhs_data, rhs_data, accumulator_data, lhs_offset, rhs_offset, M, N, K, lda, ldb, N,
+                           thread_pool);
+
+  DequantizeAccumulators(M, N, accumulator_data, result_data, ldc, result_scale, per_column_scale);
+
+#else
+  MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR scale_bias_processor(result_data, ldc, result_scale, per_column_scale,
+                                                              nullptr, nullptr);
+
+  MlasGemm(M, N, K, lhs_data, lda, lhs_offset, rhs_data, ldb, rhs_offset, accumulator_data, N, thread_pool,
+           &scale_bias_processor);
+
+#endif
+}
+
+size_t QGemmPackBSize(int N, int K, bool rhs_is_signed) {
+#if defined(MLAS_SUPPORTS_GEMM_U8X8)
+#ifdef USE_GEMMLOWP
+  // the u8u8 matrix multiply runs on gemmlowp
+  if (!rhs_is_signed) {
+    return 0;
+  }
+#endif
+  return MlasGemmPackBSize(N, K, rhs_is_signed);
+
+#else
+  ORT_UNUSED_PARAMETER(N);
+  ORT_UNUSED_PARAMETER(K);
+  ORT_UNUSED_PARAMETER(rhs_is_signed);
+  return 0;
 
 #endif
 }
+
+void QGemmPackB(int N, int K, const uint8_t* rhs_data, int ldb, bool rhs_is_signed, void* packed_rhs_data) {
+#if defined(MLAS_SUPPORTS_GEMM_U8X8)
+
+  MlasGemmPackB(N, K, rhs_data, ldb, rhs_is_signed, packed_rhs_data);
+
+#else
+  ORT_UNUSED_PARAMETER(N);
+  ORT_UNUSED_PARAMETER(K);
+  ORT_UNUSED_PARAMETER(rhs_data);
+  ORT_UNUSED_PARAMETER(ldb);
+  ORT_UNUSED_PARAMETER(rhs_is_signed);
+  ORT_UNUSED_PARAMETER(packed_rhs_data);
+  ORT_THROW("QGemmPackB: a packed matrix B is not supported on this platform");
+
+#endif
+}
+
+void QGemmu8x8_s32(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    int lda,
+    const uint8_t lhs_offset,
+    const void* packed_rhs_data,
+    const uint8_t rhs_offset,
+    bool rhs_is_signed,
+    int32_t* result_data,
+    int ldc,
+    concurrency::ThreadPool* thread_pool) {
+#if defined(MLAS_SUPPORTS_GEMM_U8X8)
+
+  MlasGemm(M, N, K, lhs_data, lda, lhs_offset, packed_rhs_data, rhs_offset, rhs_is_signed, result_data, ldc,
+           thread_pool);
+
+#else
+  ORT_UNUSED_PARAMETER(M);
+  ORT_UNUSED_PARAMETER(N);
+  ORT_UNUSED_PARAMETER(K);
+  ORT_UNUSED_PARAMETER(lhs_data);
+  ORT_UNUSED_PARAMETER(lda);
+  ORT_UNUSED_PARAMETER(lhs_offset);
+  ORT_UNUSED_PARAMETER(packed_rhs_data);
+  ORT_UNUSED_PARAMETER(rhs_offset);
+  ORT_UNUSED_PARAMETER(rhs_is_signed);
+  ORT_UNUSED_PARAMETER(result_data);
+  ORT_UNUSED_PARAMETER(ldc);
+  ORT_UNUSED_PARAMETER(thread_pool);
+  ORT_THROW("QGemmu8x8_s32: a packed matrix B is not supported on this platform");
+
+#endif
+}
+
+void QGemmu8x8_f32(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    int lda,
+    const uint8_t lhs_offset,
+    const void* packed_rhs_data,
+    const uint8_t rhs_offset,
+    bool rhs_is_signed,
+    float* result_data,
+    int ldc,
+    const float* result_scale,
+    bool per_column_scale,
+    int32_t* accumulator_data,
+    concurrency::ThreadPool* thread_pool) {
+#if defined(MLAS_SUPPORTS_GEMM_U8X8)
+
+  MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR scale_bias_processor(result_data, ldc, result_scale, per_column_scale,
+                                                              nullptr, nullptr);
+
+  MlasGemm(M, N, K, lhs_data, lda, lhs_offset, packed_rhs_data, rhs_offset, rhs_is_signed, accumulator_data, N,
+           thread_pool, &scale_bias_processor);
+
+#else
+  ORT_UNUSED_PARAMETER(M);
+  ORT_UNUSED_PARAMETER(N);
+  ORT_UNUSED_PARAMETER(K);
+  ORT_UNUSED_PARAMETER(lhs_data);
+  ORT_UNUSED_PARAMETER(lda);
+  ORT_UNUSED_PARAMETER(lhs_offset);
+  ORT_UNUSED_PARAMETER(packed_rhs_data);
+  ORT_UNUSED_PARAMETER(rhs_offset);
+  ORT_UNUSED_PARAMETER(rhs_is_signed);
+  ORT_UNUSED_PARAMETER(result_data);
+  ORT_UNUSED_PARAMETER(ldc);
+  ORT_UNUSED_PARAMETER(result_scale);
+  ORT_UNUSED_PARAMETER(per_column_scale);
+  ORT_UNUSED_PARAMETER(accumulator_data);
+  ORT_UNUSED_PARAMETER(thread_pool);
+  ORT_THROW("QGemmu8x8_f32: a packed matrix B is not supported on this platform");
+
+#endif
+}
+
+size_t QGemmPackASize(int M, int K, bool rhs_is_signed) {
+#if defined(MLAS_SUPPORTS_GEMM_U8X8)
+#ifdef USE_GEMMLOWP
+  // the u8u8 matrix multiply runs on gemmlowp
+  if (!rhs_is_signed) {
+    return 0;
+  }
+#endif
+  return MlasGemmPackASize(M, K, rhs_is_signed);
+
+#else
+  ORT_UNUSED_PARAMETER(M);
+  ORT_UNUSED_PARAMETER(K);
+  ORT_UNUSED_PARAMETER(rhs_is_signed);
+  return 0;
+
+#endif
+}
+
+void QGemmPackA(int M, int K, const uint8_t* lhs_data, int lda, bool rhs_is_signed, void* packed_lhs_data) {
+#if defined(MLAS_SUPPORTS_GEMM_U8X8)
+
+  MlasGemmPackA(M, K, lhs_data, lda, rhs_is_signed, packed_lhs_data);
+
+#else
+  ORT_UNUSED_PARAMETER(M);
+  ORT_UNUSED_PARAMETER(K);
+  ORT_UNUSED_PARAMETER(lhs_data);
+  ORT_UNUSED_PARAMETER(lda);
+  ORT_UNUSED_PARAMETER(rhs_is_signed);
+  ORT_UNUSED_PARAMETER(packed_lhs_data);
+  ORT_THROW("QGemmPackA: a packed matrix A is not supported on this platform");
+
+#endif
+}
+
+void QGemmu8u8_s32(
+    int M,
+    int N,
+    int K,
+    const void* packed_lhs_data,
+    const uint8_t lhs_offset,
+    const uint8_t* rhs_data,
+    int ldb,
+    const uint8_t rhs_offset,
+    int32_t* result_data,
+    int ldc,
+    concurrency::ThreadPool* thread_pool) {
+#if defined(MLAS_SUPPORTS_GEMM_U8X8) && !defined(USE_GEMMLOWP)
+
+  MlasGemm(M, N, K, packed_lhs_data, lhs_offset, rhs_data, ldb, rhs_offset, false, result_data, ldc, thread_pool);
+
+#else
+  ORT_UNUSED_PARAMETER(M);
+  ORT_UNUSED_PARAMETER(N);
+  ORT_UNUSED_PARAMETER(K);
+  ORT_UNUSED_PARAMETER(packed_lhs_data);
+  ORT_UNUSED_PARAMETER(lhs_offset);
+  ORT_UNUSED_PARAMETER(rhs_data);
+  ORT_UNUSED_PARAMETER(ldb);
+  ORT_UNUSED_PARAMETER(rhs_offset);
+  ORT_UNUSED_PARAMETER(result_data);
+  ORT_UNUSED_PARAMETER(ldc);
+  ORT_UNUSED_PARAMETER(thread_pool);
+  ORT_THROW("QGemmu8u8_s32: a packed matrix A is not supported on this platform");
+
+#endif
+}
+
 }  // namespace onnxruntime
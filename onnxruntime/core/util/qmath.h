@@ -35,4 +35,122 @@ void QGemmu8u8_s32(
     int ldc,
     concurrency::ThreadPool* thread_pool);
 
+// Computes the u8u8 matrix multiply and requantizes the result to uint8 with the real multiplier
+// (lhs_scale * rhs_scale / result_scale) and the result zero point. When MLAS is used, each block of the int32
+// accumulators is requantized as soon as it is complete, which needs an M x N accumulator buffer. The buffer is
+// not used with gemmlowp and can be null.
+void QGemmu8u8_u8(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    int lda,
+    const uint8_t lhs_offset,
+    const uint8_t* rhs_data,
+    int ldb,
+    const uint8_t rhs_offset,
+    uint8_t* result_data,
+    int ldc,
+    float real_multiplier,
+    const uint8_t result_offset,
+    int32_t* accumulator_data,
+    concurrency::ThreadPool* thread_pool);
+
+// Computes the u8s8 or u8u8 matrix multiply and dequantizes the result to float with the supplied scale, which is
+// either a single value or one value per column of the result (lhs_scale * rhs_scale). When MLAS is used, each block
+// of the int32 accumulators is dequantized as soon as it is complete, which needs an M x N accumulator buffer.
+void QGemmu8s8_f32(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    int lda,
+    const uint8_t lhs_offset,
+    const int8_t* rhs_data,
+    int ldb,
+    const int8_t rhs_offset,
+    float* result_data,
+    int ldc,
+    const float* result_scale,
+    bool per_column_scale,
+    int32_t* accumulator_data,
+    concurrency::ThreadPool* thread_pool);
+
+void QGemmu8u8_f32(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    int lda,
+    const uint8_t lhs_offset,
+    const uint8_t* rhs_data,
+    int ldb,
+    const uint8_t rhs_offset,
+    float* result_data,
+    int ldc,
+    const float* result_scale,
+    bool per_column_scale,
+    int32_t* accumulator_data,
+    concurrency::ThreadPool* thread_pool);
+
+// Returns the number of bytes needed to pack the K x N matrix B of a u8s8 or u8u8 matrix multiply once with
+// QGemmPackB, or zero if the matrix multiply doesn't support a packed matrix B on this platform.
+size_t QGemmPackBSize(int N, int K, bool rhs_is_signed);
+
+void QGemmPackB(int N, int K, const uint8_t* rhs_data, int ldb, bool rhs_is_signed, void* packed_rhs_data);
+
+// Computes the u8s8 or u8u8 matrix multiply with a matrix B packed by QGemmPackB. The packed matrix doesn't depend
+// on the zero points, so they are supplied here. A signed rhs_offset is passed reinterpreted as uint8_t.
+void QGemmu8x8_s32(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    int lda,
+    const uint8_t lhs_offset,
+    const void* packed_rhs_data,
+    const uint8_t rhs_offset,
+    bool rhs_is_signed,
+    int32_t* result_data,
+    int ldc,
+    concurrency::ThreadPool* thread_pool);
+
+void QGemmu8x8_f32(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    int lda,
+    const uint8_t lhs_offset,
+    const void* packed_rhs_data,
+    const uint8_t rhs_offset,
+    bool rhs_is_signed,
+    float* result_data,
+    int ldc,
+    const float* result_scale,
+    bool per_column_scale,
+    int32_t* accumulator_data,
+    concurrency::ThreadPool* thread_pool);
+
+// Returns the number of bytes needed to pack the M x K matrix A of a u8s8 or u8u8 matrix multiply once with
+// QGemmPackA, or zero if the matrix multiply doesn't support a packed matrix A on this platform.
+size_t QGemmPackASize(int M, int K, bool rhs_is_signed);
+
+void QGemmPackA(int M, int K, const uint8_t* lhs_data, int lda, bool rhs_is_signed, void* packed_lhs_data);
+
+// Computes the u8u8 matrix multiply with a matrix A packed by QGemmPackA. The packed matrix doesn't depend on the
+// zero points, so they are supplied here.
+void QGemmu8u8_s32(
+    int M,
+    int N,
+    int K,
+    const void* packed_lhs_data,
+    const uint8_t lhs_offset,
+    const uint8_t* rhs_data,
+    int ldb,
+    const uint8_t rhs_offset,
+    int32_t* result_data,
+    int ldc,
+    concurrency::ThreadPool* thread_pool);
+
 }  // namespace onnxruntime
@@ -1,19 +1,99 @@
 #include "thread_utils.h"
 #include <algorithm>
+#include <numeric>
+#include <thread>
 
 #include <core/common/make_unique.h>
+#include "core/platform/env.h"
 
 namespace onnxruntime {
 namespace concurrency {
 
+std::vector<std::vector<size_t>> GetThreadAffinity(const ThreadPoolParams& params, int num_threads) {
+  std::vector<std::vector<size_t>> affinity;
+  if (num_threads <= 0) {
+    return affinity;
+  }
+
+  if (params.affinity_policy == ORT_THREAD_AFFINITY_EXPLICIT) {
+    for (int i = 0, end = std::min<int>(num_threads, static_cast<int>(params.affinity.size())); i < end; ++i) {
+      affinity.push_back({params.affinity[i]});
+    }
+    return affinity;
+  }
+
+  // the logical processors the threads may use: those the process is allowed to run on, narrowed down to the
+  // NUMA node if one is given. pinning a thread outside the process cpuset would fail.
+  const Env& env = Env::Default();
+  std::vector<size_t> processors = env.GetAvailableProcessors();
+  if (params.numa_node >= 0) {
+    std::vector<size_t> node_processors = env.GetNumaNodeProcessors(params.numa_node);
+    if (!processors.empty()) {
+      node_processors.erase(std::remove_if(node_processors.begin(), node_processors.end(),
+                                           [&processors](size_t processor) {
+                                             return std::find(processors.begin(), processors.end(),
+                                                              processor) == processors.end();
+                                           }),
+                            node_processors.end());
+    }
+    if (!node_processors.empty()) {
+      processors = std::move(node_processors);
+    }
+  }
+  if (processors.empty()) {
+    processors.resize(std::max<size_t>(1, std::thread::hardware_concurrency()));
+    std::iota(processors.begin(), processors.end(), size_t{0});
+  }
+  const int num_processors = static_cast<int>(processors.size());
+
+  switch (params.affinity_policy) {
+    case ORT_THREAD_AFFINITY_COMPACT:
+      // consecutive logical processors, so neighboring threads share cores and caches
+      for (int i = 0; i < num_threads; ++i) {
+        affinity.push_back({processors[i % num_processors]});
+      }
+      break;
+    case ORT_THREAD_AFFINITY_SCATTER:
+      // logical processors spread evenly over the available ones, so threads get their own cores
+      for (int i = 0; i < num_threads; ++i) {
+        const int index = num_threads <= num_processors ? i * num_processors / num_threads : i % num_processors;
+        affinity.push_back({processors[index]});
+      }
+      break;
+    default:
+      // not pinned to individual processors, but kept on the NUMA node
+      if (params.numa_node >= 0) {
+        affinity.push_back(processors);
+      }
+      break;
+  }
+
+  return affinity;
+}
+
 std::unique_ptr<ThreadPool> CreateThreadPool(const std::string& name, int thread_pool_size) {
+  ThreadPoolParams params;
+  params.thread_pool_size = thread_pool_size;
+  return CreateThreadPool(name, params);
+}
+
+std::unique_ptr<ThreadPool> CreateThreadPool(const std::string& name, const ThreadPoolParams& params) {
+  int thread_pool_size = params.thread_pool_size;
   if (thread_pool_size <= 0) {  // default
     thread_pool_size = std::max<int>(1, std::thread::hardware_concurrency() / 2);
   }
 
   // since we use the main thread for execution we don't have to create any threads on the thread pool when
   // the requested size is 1. For other cases, we will have thread_pool_size + 1 threads for execution
-  return thread_pool_size == 1 ? nullptr : onnxruntime::make_unique<concurrency::ThreadPool>(name, thread_pool_size);
+  if (thread_pool_size == 1) {
+    return nullptr;
+  }
+
+  ThreadPoolOptions options;
+  options.allow_spinning = params.allow_spinning;
+  options.spin_duration_us = params.spin_duration_us;
+  options.affinity = GetThreadAffinity(params, thread_pool_size);
+  return onnxruntime::make_unique<concurrency::ThreadPool>(name, thread_pool_size, options);
 }
 }  // namespace concurrency
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
@@ -1,10 +1,47 @@
+#pragma once
+
 #include "core/platform/threadpool.h"
+#include "core/session/onnxruntime_c_api.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace onnxruntime {
 namespace concurrency {
 
+struct ThreadPoolParams {
+  // number of threads in the pool. 0 picks a default.
+  int thread_pool_size = 0;
+
+  // time in microseconds that a thread running a parallel loop spins waiting for the last blocks of the loop before
+  // it blocks. 0 blocks straight away.
+  int spin_duration_us = 0;
+
+  // let the idle worker threads spin looking for work for a while before they sleep.
+  bool allow_spinning = true;
+
+  // how the threads are pinned to logical processors.
+  OrtThreadAffinityPolicy affinity_policy = ORT_THREAD_AFFINITY_NONE;
+
+  // logical processors for ORT_THREAD_AFFINITY_EXPLICIT. thread i is pinned to affinity[i % affinity.size()].
+  std::vector<size_t> affinity;
+
+  // when >= 0, the threads only use the logical processors of this NUMA node.
+  int numa_node = -1;
+};
+
 std::unique_ptr<ThreadPool> CreateThreadPool(const std::string& name, int thread_pool_size);
+
+std::unique_ptr<ThreadPool> CreateThreadPool(const std::string& name, const ThreadPoolParams& params);
+
+// Returns the logical processors each thread of a pool of num_threads threads is pinned to.
+// Empty if the threads are not pinned.
+std::vector<std::vector<size_t>> GetThreadAffinity(const ThreadPoolParams& params, int num_threads);
 }  // namespace concurrency
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
+
+// Options for the global thread pools of an environment created with CreateEnvWithGlobalThreadPools.
+struct OrtThreadingOptions {
+  onnxruntime::concurrency::ThreadPoolParams intra_op_thread_pool_params;
+  onnxruntime::concurrency::ThreadPoolParams inter_op_thread_pool_params;
+};
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
+#include <random>
+
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
@@ -204,5 +207,96 @@ TEST(AttentionTest, AttentionMaskExceedSequence) {
                    batch_size, sequence_length, hidden_size, number_of_heads);
 }
 
+// Computes the attention output directly from its definition, keeping the whole score matrix.
+static std::vector<float> ComputeAttentionReference(
+    const std::vector<float>& input_data,
+    const std::vector<float>& weights_data,
+    const std::vector<float>& bias_data,
+    const std::vector<int32_t>& mask_index_data,
+    int batch_size,
+    int sequence_length,
+    int hidden_size,
+    int number_of_heads) {
+  const int head_size = hidden_size / number_of_heads;
+
+  // qkv(B, S, 3NH) = input(B, S, NH) x weights(NH, 3NH) + bias(3NH)
+  std::vector<double> qkv(static_cast<size_t>(batch_size) * sequence_length * 3 * hidden_size);
+  for (int row = 0; row < batch_size * sequence_length; row++) {
+    for (int n = 0; n < 3 * hidden_size; n++) {
+      double sum = bias_data[n];
+      for (int k = 0; k < hidden_size; k++) {
+        sum += double(input_data[row * hidden_size + k]) * weights_data[k * 3 * hidden_size + n];
+      }
+      qkv[row * 3 * hidden_size + n] = sum;
+    }
+  }
+
+  std::vector<float> output_data(static_cast<size_t>(batch_size) * sequence_length * hidden_size);
+  std::vector<double> scores(sequence_length);
+  const double alpha = 1.0 / std::sqrt(static_cast<double>(head_size));
+
+  for (int b = 0; b < batch_size; b++) {
+    for (int h = 0; h < number_of_heads; h++) {
+      for (int s = 0; s < sequence_length; s++) {
+        const double* q = &qkv[(b * sequence_length + s) * 3 * hidden_size + h * head_size];
+        double max_score = -INFINITY;
+        for (int t = 0; t < sequence_length; t++) {
+          const double* k = &qkv[(b * sequence_length + t) * 3 * hidden_size + hidden_size + h * head_size];
+          double score = 0.0;
+          for (int i = 0; i < head_size; i++) {
+            score += q[i] * k[i];
+          }
+          scores[t] = score * alpha + (t >= mask_index_data[b] ? -10000.0 : 0.0);
+          max_score = std::max(max_score, scores[t]);
+        }
+        double sum = 0.0;
+        for (int t = 0; t < sequence_length; t++) {
+          scores[t] = std::exp(scores[t] - max_score);
+          sum += scores[t];
+        }
+        for (int i = 0; i < head_size; i++) {
+          double value = 0.0;
+          for (int t = 0; t < sequence_length; t++) {
+            value += scores[t] * qkv[(b * sequence_length + t) * 3 * hidden_size + 2 * hidden_size + h * head_size + i];
+          }
+          output_data[(b * sequence_length + s) * hidden_size + h * head_size + i] = static_cast<float>(value / sum);
+        }
+      }
+    }
+  }
+
+  return output_data;
+}
+
+// The sequence spans several query and key tiles of the CPU kernel, and the masks end inside a key tile
+// and mask out the whole sequence.
+TEST(AttentionTest, AttentionLongSequenceMask) {
+  int batch_size = 3;
+  int sequence_length = 300;
+  int hidden_size = 16;
+  int number_of_heads = 2;
+
+  std::default_random_engine generator(1234);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  auto random_vector = [&](size_t size) {
+    std::vector<float> data(size);
+    for (auto& value : data) {
+      value = distribution(generator);
+    }
+    return data;
+  };
+
+  std::vector<float> input_data = random_vector(batch_size * sequence_length * hidden_size);
+  std::vector<float> weight_data = random_vector(hidden_size * 3 * hidden_size);
+  std::vector<float> bias_data = random_vector(3 * hidden_size);
+  std::vector<int32_t> mask_index_data = {300L, 161L, 0L};
+
+  std::vector<float> output_data = ComputeAttentionReference(input_data, weight_data, bias_data, mask_index_data,
+                                                             batch_size, sequence_length, hidden_size, number_of_heads);
+
+  RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
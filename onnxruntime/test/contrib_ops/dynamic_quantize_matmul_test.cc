@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// Computes the expected output of DynamicQuantizeLinear -> MatMulInteger -> Cast -> Mul.
+template <typename T>
+std::vector<float> ComputeDynamicQuantizeMatMulReference(const std::vector<float>& A, const std::vector<T>& B,
+                                                         const std::vector<float>& b_scale, T b_zero_point,
+                                                         int64_t batch, int64_t M, int64_t N, int64_t K) {
+  float min = std::min(0.f, *std::min_element(A.begin(), A.end()));
+  float max = std::max(0.f, *std::max_element(A.begin(), A.end()));
+  float a_scale = (max - min) / 255.f;
+  auto a_zero_point = static_cast<int32_t>(std::nearbyintf(std::max(0.f, std::min(255.f, -min / a_scale))));
+
+  std::vector<float> Y(batch * M * N);
+  for (int64_t b = 0; b < batch; b++) {
+    for (int64_t m = 0; m < M; m++) {
+      for (int64_t n = 0; n < N; n++) {
+        int32_t sum = 0;
+        for (int64_t k = 0; k < K; k++) {
+          auto a = static_cast<int32_t>(std::max(0.f, std::min(255.f, std::nearbyintf(A[(b * M + m) * K + k] / a_scale) + a_zero_point)));
+          sum += (a - a_zero_point) * (static_cast<int32_t>(B[k * N + n]) - b_zero_point);
+        }
+        Y[(b * M + m) * N + n] = static_cast<float>(sum) * (a_scale * b_scale[b_scale.size() == 1 ? 0 : n]);
+      }
+    }
+  }
+  return Y;
+}
+
+template <typename T>
+void RunDynamicQuantizeMatMulTest(int64_t batch, int64_t M, int64_t N, int64_t K,
+                                  bool per_column_scale, bool has_zero_point, bool is_b_initializer = false) {
+  std::default_random_engine generator(1234);
+  std::uniform_real_distribution<float> a_distribution(-2.f, 5.f);
+  std::uniform_int_distribution<int32_t> b_distribution(std::numeric_limits<T>::min(),
+                                                        std::numeric_limits<T>::max());
+  std::uniform_real_distribution<float> scale_distribution(0.001f, 0.01f);
+
+  std::vector<float> A(batch * M * K);
+  std::generate(A.begin(), A.end(), [&] { return a_distribution(generator); });
+  std::vector<T> B(K * N);
+  std::generate(B.begin(), B.end(), [&] { return static_cast<T>(b_distribution(generator)); });
+  std::vector<float> b_scale(per_column_scale ? N : 1);
+  std::generate(b_scale.begin(), b_scale.end(), [&] { return scale_distribution(generator); });
+  T b_zero_point = has_zero_point ? static_cast<T>(b_distribution(generator)) : 0;
+
+  OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+  std::vector<int64_t> a_dims{M, K};
+  std::vector<int64_t> y_dims{M, N};
+  if (batch > 1) {
+    a_dims.insert(a_dims.begin(), batch);
+    y_dims.insert(y_dims.begin(), batch);
+  }
+  test.AddInput<float>("A", a_dims, A);
+  test.AddInput<T>("B", {K, N}, B, is_b_initializer);
+  if (per_column_scale) {
+    test.AddInput<float>("b_scale", {N}, b_scale);
+  } else {
+    test.AddInput<float>("b_scale", {}, b_scale);
+  }
+  if (has_zero_point) {
+    test.AddInput<T>("b_zero_point", {}, {b_zero_point});
+  }
+  test.AddOutput<float>("Y", y_dims,
+                        ComputeDynamicQuantizeMatMulReference(A, B, b_scale, b_zero_point, batch, M, N, K));
+  test.Run();
+}
+}  // namespace
+
+TEST(DynamicQuantizeMatMulOpTest, UInt8Weights) {
+  RunDynamicQuantizeMatMulTest<uint8_t>(1, 4, 8, 16, false, true);
+  RunDynamicQuantizeMatMulTest<uint8_t>(1, 17, 33, 65, false, false);
+}
+
+TEST(DynamicQuantizeMatMulOpTest, Int8Weights) {
+  RunDynamicQuantizeMatMulTest<int8_t>(1, 4, 8, 16, false, false);
+  RunDynamicQuantizeMatMulTest<int8_t>(1, 17, 33, 65, false, false);
+}
+
+TEST(DynamicQuantizeMatMulOpTest, PerColumnScale) {
+  RunDynamicQuantizeMatMulTest<uint8_t>(1, 5, 24, 40, true, true);
+  RunDynamicQuantizeMatMulTest<int8_t>(1, 5, 24, 40, true, false);
+}
+
+TEST(DynamicQuantizeMatMulOpTest, Batched) {
+  RunDynamicQuantizeMatMulTest<uint8_t>(3, 7, 16, 32, false, true);
+  RunDynamicQuantizeMatMulTest<int8_t>(3, 7, 16, 32, true, false);
+}
+
+// A constant B is pre-packed, and the zero point is only applied when the packed B is used.
+TEST(DynamicQuantizeMatMulOpTest, PrePackedWeights) {
+  RunDynamicQuantizeMatMulTest<uint8_t>(1, 17, 33, 65, false, true, true);
+  RunDynamicQuantizeMatMulTest<int8_t>(1, 17, 33, 65, true, false, true);
+  RunDynamicQuantizeMatMulTest<uint8_t>(3, 7, 16, 300, true, true, true);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
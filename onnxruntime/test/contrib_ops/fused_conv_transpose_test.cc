@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+namespace {
+void TestFusedConvTranspose(const std::string& activation, const std::vector<float>& activation_params,
+                            const std::vector<float>& expected_vals) {
+  OpTester test("FusedConvTranspose", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+  test.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+  test.AddAttribute("activation", activation);
+  if (!activation_params.empty()) {
+    test.AddAttribute("activation_params", activation_params);
+  }
+
+  test.AddInput<float>("X", {1, 1, 5, 5}, {0.22572887f, -0.07105902f, -0.40399021f, -0.14461157f, 0.05367219f,
+                                           -0.08353302f, 0.41023391f, 0.42745841f, -0.3769345f, -0.42057109f,
+                                           -0.1372498f, 0.05485916f, 0.34602994f, -0.06402895f, -0.06000063f,
+                                           0.07891446f, -0.09410021f, 0.26251942f, -0.11043271f, 0.47966552f,
+                                           0.34682763f, -0.04511502f, 0.22414422f, 0.24618894f, -0.21480265f});
+  test.AddInput<float>("W", {1, 1, 3, 3}, {-0.0962126f, 0.19827795f, 0.03667754f,
+                                           0.36756599f, -0.01076147f, -0.11781135f,
+                                           -0.11574665f, -0.38404959f, 0.44403327f});
+  test.AddInput<float>("B", {1}, {0.04676145f});
+  test.AddOutput<float>("Y", {1, 1, 5, 5}, expected_vals);
+  test.Run();
+}
+}  // namespace
+
+TEST(ContribOpTest, FusedConvTranspose_Relu) {
+  // ConvTranspose_2D_Bias_1 with the negative outputs clamped to zero
+  TestFusedConvTranspose("Relu", {},
+                         {0.0f, 0.0f, 0.14239404f, 0.09704495f, 0.0f,
+                          0.08749044f, 0.35613984f, 0.07240347f, 0.0f, 0.0f,
+                          0.07770107f, 0.0f, 0.13388641f, 0.30945939f, 0.14015588f,
+                          0.13079405f, 0.0f, 0.0f, 0.45621645f, 0.01566098f,
+                          0.00703105f, 0.12956856f, 0.0103332f, 0.04221053f, 0.0f});
+}
+
+TEST(ContribOpTest, FusedConvTranspose_LeakyRelu) {
+  TestFusedConvTranspose("LeakyRelu", {0.1f},
+                         {-0.003781903f, -0.009041066f, 0.14239404f, 0.09704495f, -0.003399426f,
+                          0.08749044f, 0.35613984f, 0.07240347f, -0.027841991f, -0.000337578f,
+                          0.07770107f, -0.009561026f, 0.13388641f, 0.30945939f, 0.14015588f,
+                          0.13079405f, -0.000488365f, -0.006758944f, 0.45621645f, 0.01566098f,
+                          0.00703105f, 0.12956856f, 0.0103332f, 0.04221053f, -0.021318194f});
+}
+}  // namespace test
+}  // namespace onnxruntime
@@ -4,6 +4,8 @@
 #include "core/framework/bfc_arena.h"
 #include "gtest/gtest.h"
 #include <cstdlib>
+#include <cstring>
+#include <thread>
 
 namespace onnxruntime {
 namespace test {
@@ -234,5 +236,168 @@ TEST(BFCArenaTest, TestReserve) {
   a.GetStats(&stats);
   EXPECT_EQ(stats.total_allocated_bytes, 1048576);
 }
+
+TEST(BFCArenaTest, ConcurrentAllocationsAndDeallocations) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+
+  const int num_threads = 8;
+  const int num_iterations = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&a, t]() {
+      // fill each buffer with a byte unique to the thread and the buffer, and check it's
+      // intact before freeing, so overlapping buffers are detected
+      std::vector<std::pair<void*, size_t>> live;
+      for (int i = 0; i < num_iterations; ++i) {
+        size_t size = 100 + 256 * static_cast<size_t>((i * 7 + t) % 32);
+        void* raw = a.Alloc(size);
+        ASSERT_NE(raw, nullptr);
+        memset(raw, (t * 16 + static_cast<int>(live.size())) & 0xff, size);
+        live.emplace_back(raw, size);
+
+        if (live.size() == 8 || i == num_iterations - 1) {
+          for (size_t j = 0; j < live.size(); ++j) {
+            const auto* bytes = static_cast<const unsigned char*>(live[j].first);
+            const auto expected = static_cast<unsigned char>((t * 16 + static_cast<int>(j)) & 0xff);
+            ASSERT_TRUE(std::all_of(bytes, bytes + live[j].second, [expected](unsigned char b) { return b == expected; }));
+            a.Free(live[j].first);
+          }
+          live.clear();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, num_threads * num_iterations);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_GT(stats.num_thread_cache_hits, 0);
+
+  a.FlushThreadCaches();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+}
+
+TEST(BFCArenaTest, ThreadCachesAreFlushedWhenOutOfMemory) {
+  // Configure a 1MiB byte limit
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 20);
+
+  // fill the arena with small chunks, which go to the thread cache when freed
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 16; ++i) {
+    ptrs.push_back(a.Alloc(1 << 16));
+    EXPECT_NE(nullptr, ptrs.back());
+  }
+  for (void* ptr : ptrs) {
+    a.Free(ptr);
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 1 << 20);
+
+  // a cached chunk is reused for the same size
+  void* cached_ptr = a.Alloc(1 << 16);
+  EXPECT_EQ(ptrs.back(), cached_ptr);
+  EXPECT_EQ(static_cast<size_t>(1 << 16), a.AllocatedSize(cached_ptr));
+  a.Free(cached_ptr);
+
+  // the cached chunks have to be coalesced to satisfy a larger allocation
+  void* large_ptr = a.Alloc(1 << 19);
+  EXPECT_NE(nullptr, large_ptr);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 1 << 19);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+  a.Free(large_ptr);
+}
+
+TEST(BFCArenaTest, MaxInUseReachedFromThreadCache) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+
+  // park 4 chunks of 16KiB and then 4 chunks of 8KiB in the thread cache, so
+  // the peak so far is the 64KiB of the first batch
+  for (size_t size : {size_t{16} << 10, size_t{8} << 10}) {
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 4; ++i) {
+      ptrs.push_back(a.Alloc(size));
+    }
+    for (void* ptr : ptrs) {
+      a.Free(ptr);
+    }
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.max_bytes_in_use, 64 << 10);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 96 << 10);
+  const int64_t num_thread_cache_hits = stats.num_thread_cache_hits;
+
+  // every chunk comes back from the cache, so only cache hits reach the new peak
+  std::vector<void*> ptrs;
+  for (size_t size : {size_t{16} << 10, size_t{8} << 10}) {
+    for (int i = 0; i < 4; ++i) {
+      ptrs.push_back(a.Alloc(size));
+    }
+  }
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits, num_thread_cache_hits + 8);
+  EXPECT_EQ(stats.bytes_in_use, 96 << 10);
+  EXPECT_EQ(stats.max_bytes_in_use, 96 << 10);
+  EXPECT_EQ(a.Used(), static_cast<size_t>(96 << 10));
+
+  for (void* ptr : ptrs) {
+    a.Free(ptr);
+  }
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.max_bytes_in_use, 96 << 10);
+}
+
+TEST(BFCArenaTest, TestShrink) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+
+  // the first region is 1MiB, and the large allocation needs a region of its own
+  void* small_ptr = a.Alloc(1024);
+  void* large_ptr = a.Alloc(1 << 26);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_regions, 2);
+  EXPECT_EQ(stats.total_allocated_bytes, (1 << 20) + (1 << 26));
+
+  // only the region with nothing in use is released
+  a.Free(large_ptr);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.largest_free_block, 1 << 26);
+  a.Shrink();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_regions, 1);
+  EXPECT_EQ(stats.bytes_in_use, 1024);
+  EXPECT_EQ(stats.total_allocated_bytes, 1 << 20);
+  EXPECT_EQ(stats.total_released_bytes, 1 << 26);
+  EXPECT_EQ(stats.largest_free_block, (1 << 20) - 1024);
+
+  // chunks in the thread caches don't keep their region alive
+  a.Free(small_ptr);
+  a.Shrink();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_regions, 0);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+  EXPECT_EQ(stats.total_released_bytes, (1 << 20) + (1 << 26));
+
+  // the arena grows again from the initial region size
+  small_ptr = a.Alloc(1024);
+  EXPECT_NE(nullptr, small_ptr);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 1 << 20);
+  a.Free(small_ptr);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/framework/execution_frame.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
+#include "core/framework/static_memory_planner.h"
 #include "core/graph/model.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/inference_session.h"
@@ -269,6 +270,76 @@ TEST_F(ExecutionFrameTest, MemPatternTest) {
   EXPECT_EQ(p->GetBlock(4)->offset_, 64u);
 }
 
+TEST_F(ExecutionFrameTest, StaticMemoryPlanTest) {
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_type = cpu_xp->Type();
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  onnxruntime::Model model("test", true, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  auto tensor_float = [](std::vector<int64_t> dims) {
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    for (auto dim : dims) {
+      type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+    return type;
+  };
+  TypeProto tensor_1x2 = tensor_float({1, 2}), tensor_2x2 = tensor_float({2, 2}), tensor_2x3 = tensor_float({2, 3}),
+            tensor_1x3 = tensor_float({1, 3});
+  onnxruntime::NodeArg input_def1("X1", &tensor_1x2),
+      input_def2("X2", &tensor_2x2),
+      input_def3("X3", &tensor_2x3),
+      gemm1_out_def("T1", &tensor_1x2),
+      gemm2_out_def("T2", &tensor_1x3),
+      clip_out_def("T3", &tensor_1x3);
+
+  graph.AddNode("node1", "MatMul", "gemm1", ArgMap{&input_def1, &input_def2}, ArgMap{&gemm1_out_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node2", "MatMul", "gemm2", ArgMap{&gemm1_out_def, &input_def3}, ArgMap{&gemm2_out_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node3", "Clip", "clip1", ArgMap{&gemm2_out_def}, ArgMap{&clip_out_def})
+      .SetExecutionProviderType(xp_type);
+
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  KernelRegistryManager kernel_registry_manager;
+
+  ExecutionProviders execution_providers;
+  execution_providers.Add(xp_type, std::move(cpu_xp));
+  kernel_registry_manager.RegisterKernels(execution_providers);
+  SessionState state{execution_providers, true, &tp_, nullptr};
+  status = state.SetGraphAndCreateKernels(graph, kernel_registry_manager);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  const OrtValueNameIdxMap& mlvalue_name_idx_map(state.GetOrtValueNameIdxMap());
+  int t1_idx, t2_idx, t3_idx;
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("T1", t1_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("T2", t2_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("T3", t3_idx).IsOK());
+
+  std::unique_ptr<SequentialExecutionPlan> p_seq_exec_plan;
+  SequentialPlannerContext context(ExecutionMode::ORT_SEQUENTIAL);
+  status = SequentialPlanner::CreatePlan(nullptr, GraphViewer(graph), {}, execution_providers, kernel_registry_manager,
+                                         mlvalue_name_idx_map, context, p_seq_exec_plan);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  MemoryPatternGroup pattern;
+  ASSERT_TRUE(PlanStaticMemoryPatterns(*p_seq_exec_plan, GraphViewer(graph), mlvalue_name_idx_map, pattern));
+
+  auto cpu_allocator = execution_providers.Get(xp_type)->GetAllocator(0, OrtMemTypeDefault);
+  EXPECT_EQ(pattern.patterns.size(), 1u);
+  auto p = pattern.GetPatterns(cpu_allocator->Info());
+  ASSERT_NE(p, nullptr);
+  // T1 is freed after node2 creates T2, and T3 is a graph output so it isn't in the pattern
+  EXPECT_EQ(p->PeakSize(), 2u * 64u);
+  EXPECT_EQ(p->GetBlock(t1_idx)->size_, 64u);
+  EXPECT_EQ(p->GetBlock(t2_idx)->size_, 64u);
+  EXPECT_NE(p->GetBlock(t1_idx)->offset_, p->GetBlock(t2_idx)->offset_);
+  EXPECT_EQ(p->GetBlock(t3_idx), nullptr);
+}
+
 TEST(ExecutionFrameTestWithoutSessionState, BadModelInvalidDimParamUsage) {
   // load model with 2 Scan ops that both incorrectly use shapes of { 'None', 'None' } for their outputs.
   // as 'None' is not a special value it's treated as a variable name, leading to a runtime error when we
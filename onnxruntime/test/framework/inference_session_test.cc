@@ -23,7 +23,9 @@
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
 #include "core/graph/op.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/env.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 #ifdef USE_CUDA
@@ -128,6 +130,29 @@ class InferenceSessionGetGraphWrapper : public InferenceSession {
   }
 };
 
+// InferenceSession wrapper to expose the mapped model file and the initialized tensors.
+class InferenceSessionGetMappedDataWrapper : public InferenceSession {
+ public:
+  explicit InferenceSessionGetMappedDataWrapper(const SessionOptions& session_options,
+                                                logging::LoggingManager* logging_manager)
+      : InferenceSession(session_options, logging_manager) {
+  }
+
+  const char* GetModelData() const {
+    return model_data_.get();
+  }
+
+  const OrtValue* GetInitializedTensor(const std::string& name) const {
+    int idx;
+    if (!session_state_->GetOrtValueNameIdxMap().GetIdx(name, idx).IsOK()) {
+      return nullptr;
+    }
+    const auto& initialized_tensors = session_state_->GetInitializedTensors();
+    auto it = initialized_tensors.find(idx);
+    return it != initialized_tensors.end() ? &it->second : nullptr;
+  }
+};
+
 namespace test {
 static void VerifyOutputs(const std::vector<OrtValue>& fetches, const std::vector<int64_t>& expected_dims,
                           const std::vector<float>& expected_values);
@@ -361,6 +386,46 @@ TEST(InferenceSessionTests, DisableCPUArena) {
   RunModel(session_object, run_options);
 }
 
+// the CPU arena is only created on x64, and is a plain BFC arena unless another allocator is used
+#if (defined(__amd64__) || defined(_M_AMD64)) && !defined(USE_JEMALLOC) && !defined(USE_MIMALLOC_ARENA_ALLOCATOR)
+TEST(InferenceSessionTests, ShrinkMemoryArenas) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.ShrinkMemoryArenas";
+  so.cpu_mem_arena_max_bytes = 1 << 30;
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  OrtMemoryInfo cpu_arena_info(CPU, OrtArenaAllocator);
+  AllocatorStats stats;
+  ASSERT_TRUE(session_object.GetAllocatorStats(cpu_arena_info, stats).IsOK());
+  EXPECT_EQ(stats.bytes_limit, 1 << 30);
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  RunModel(session_object, run_options);
+
+  // the arena keeps its memory after the run
+  ASSERT_TRUE(session_object.GetAllocatorStats(cpu_arena_info, stats).IsOK());
+  EXPECT_GT(stats.num_allocs, 0);
+  EXPECT_GT(stats.num_regions, 0);
+  EXPECT_EQ(stats.total_released_bytes, 0);
+
+  // nothing is left in use once the fetches are gone, so every region is returned
+  session_object.ShrinkMemoryArenas();
+  ASSERT_TRUE(session_object.GetAllocatorStats(cpu_arena_info, stats).IsOK());
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.num_regions, 0);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+  EXPECT_GT(stats.total_released_bytes, 0);
+
+  OrtMemoryInfo unknown_info("unknown", OrtArenaAllocator);
+  EXPECT_FALSE(session_object.GetAllocatorStats(unknown_info, stats).IsOK());
+}
+#endif
+
 TEST(InferenceSessionTests, TestModelSerialization) {
   // Load model with level 0 transform level
   // and assert that the model has Identity nodes.
@@ -666,6 +731,144 @@ TEST(InferenceSessionTests, PreAllocateOutputVector) {
   RunModel(session_object, run_options, is_preallocate_output_vec);
 }
 
+TEST(InferenceSessionTests, RunWithPreparedRun) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.RunWithPreparedRun";
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+
+  std::unique_ptr<PreparedRun> prepared_run;
+  ASSERT_FALSE(session_object.PrepareRun({"X"}, {"Y"}, prepared_run).IsOK());
+
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  ASSERT_FALSE(session_object.PrepareRun({"X_invalid"}, {"Y"}, prepared_run).IsOK());
+  ASSERT_FALSE(session_object.PrepareRun({"X"}, {"Y_invalid"}, prepared_run).IsOK());
+
+  common::Status st = session_object.PrepareRun({"X"}, {"Y"}, prepared_run);
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+  ASSERT_EQ(std::vector<std::string>{"X"}, prepared_run->GetFeedNames());
+  ASSERT_EQ(std::vector<std::string>{"Y"}, prepared_run->GetOutputNames());
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+
+  // prepare inputs
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<OrtValue> feeds(1);
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims_mul_x, values_mul_x,
+                       &feeds[0]);
+
+  // prepare expected inputs and outputs
+  std::vector<int64_t> expected_dims_mul_y = {3, 2};
+  std::vector<float> expected_values_mul_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+
+  // the prepared run can be used for any number of Run calls
+  for (int i = 0; i < 3; ++i) {
+    std::vector<OrtValue> fetches;
+    st = session_object.Run(run_options, *prepared_run, feeds, &fetches);
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+    VerifyOutputs(fetches, expected_dims_mul_y, expected_values_mul_y);
+  }
+
+  // the feeds must match the prepared run
+  std::vector<OrtValue> fetches;
+  ASSERT_FALSE(session_object.Run(run_options, *prepared_run, {}, &fetches).IsOK());
+
+  // a prepared run can't be used with another session
+  InferenceSession other_session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(other_session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(other_session_object.Initialize().IsOK());
+  ASSERT_FALSE(other_session_object.Run(run_options, *prepared_run, feeds, &fetches).IsOK());
+}
+
+TEST(InferenceSessionTests, RunWithNamesReusesPreparedRun) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.RunWithNamesReusesPreparedRun";
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<OrtValue> feeds(1);
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims_mul_x, values_mul_x,
+                       &feeds[0]);
+
+  std::vector<int64_t> expected_dims_mul_y = {3, 2};
+  std::vector<float> expected_values_mul_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+
+  // names that fail to resolve are not remembered, and the cached resolution of the valid names is reused
+  for (int i = 0; i < 3; ++i) {
+    std::vector<OrtValue> fetches;
+    ASSERT_FALSE(session_object.Run(run_options, {"X_invalid"}, feeds, {"Y"}, &fetches).IsOK());
+    ASSERT_FALSE(session_object.Run(run_options, {"X"}, feeds, {"Y_invalid"}, &fetches).IsOK());
+
+    common::Status st = session_object.Run(run_options, {"X"}, feeds, {"Y"}, &fetches);
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+    VerifyOutputs(fetches, expected_dims_mul_y, expected_values_mul_y);
+  }
+
+  // concurrent Run calls share the cached resolution of the names
+  auto run_with_names = [&]() {
+    for (int i = 0; i < 100; ++i) {
+      std::vector<OrtValue> fetches;
+      common::Status st = session_object.Run(run_options, {"X"}, feeds, {"Y"}, &fetches);
+      ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+      VerifyOutputs(fetches, expected_dims_mul_y, expected_values_mul_y);
+    }
+  };
+
+  std::thread thread1{run_with_names};
+  std::thread thread2{run_with_names};
+  thread1.join();
+  thread2.join();
+}
+
+TEST(InferenceSessionTests, RunWithGlobalThreadPools) {
+  concurrency::ThreadPool intra_op_thread_pool{"test_global_intra_op_thread_pool", 2};
+  concurrency::ThreadPool inter_op_thread_pool{"test_global_inter_op_thread_pool", 2};
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.RunWithGlobalThreadPools";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.use_per_session_threads = false;
+
+  // a session without per session threads can't be initialized until the global thread pools are set
+  InferenceSession session_without_pools{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_without_pools.Load(MODEL_URI).IsOK());
+  ASSERT_FALSE(session_without_pools.Initialize().IsOK());
+
+  // sessions that create their own thread pools can't use the global ones
+  SessionOptions per_session_so;
+  InferenceSession per_session_object{per_session_so, &DefaultLoggingManager()};
+  ASSERT_FALSE(per_session_object.SetGlobalThreadPools(&intra_op_thread_pool, &inter_op_thread_pool).IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+
+  // several sessions share the same pools
+  for (int i = 0; i < 2; ++i) {
+    InferenceSession session_object{so, &DefaultLoggingManager()};
+    ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+    common::Status st = session_object.SetGlobalThreadPools(&intra_op_thread_pool, &inter_op_thread_pool);
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+    st = session_object.Initialize();
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+    ASSERT_FALSE(session_object.SetGlobalThreadPools(&intra_op_thread_pool, &inter_op_thread_pool).IsOK());
+
+    RunModel(session_object, run_options);
+  }
+}
+
 TEST(InferenceSessionTests, ConfigureVerbosityLevel) {
   SessionOptions so;
 
@@ -1115,6 +1318,134 @@ TEST(ExecutionProviderTest, FunctionTest) {
   VerifyOutputs(fetches, expected_dims_mul_m, expected_values_mul_m);
 }
 
+TEST(InferenceSessionTests, MappedModelLoading) {
+  onnxruntime::Model model("graph_1", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  // the raw data of W is large enough to be left in the mapped file, the one of B isn't
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(16);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(64);
+  ONNX_NAMESPACE::TypeProto bias_tensor;
+  bias_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  bias_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(64);
+
+  std::vector<float> weights(16 * 64);
+  for (size_t i = 0; i < weights.size(); ++i) {
+    weights[i] = static_cast<float>(i);
+  }
+  std::vector<float> bias(64, 0.5f);
+  ONNX_NAMESPACE::TensorProto weights_proto;
+  weights_proto.set_name("W");
+  weights_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  weights_proto.add_dims(16);
+  weights_proto.add_dims(64);
+  weights_proto.set_raw_data(weights.data(), weights.size() * sizeof(float));
+  graph.AddInitializedTensor(weights_proto);
+  ONNX_NAMESPACE::TensorProto bias_proto;
+  bias_proto.set_name("B");
+  bias_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  bias_proto.add_dims(64);
+  bias_proto.set_raw_data(bias.data(), bias.size() * sizeof(float));
+  graph.AddInitializedTensor(bias_proto);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& weights_arg = graph.GetOrCreateNodeArg("W", &float_tensor);
+  auto& bias_arg = graph.GetOrCreateNodeArg("B", &bias_tensor);
+  auto& add_arg = graph.GetOrCreateNodeArg("add_out", &float_tensor);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("node_1", "Add", "node 1.", {&input_arg, &weights_arg}, {&add_arg});
+  graph.AddNode("node_2", "Add", "node 2.", {&add_arg, &bias_arg}, {&output_arg});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+  std::string model_file_name = "mapped_model_loading_test.onnx";
+
+  // W is only used in place if its data is aligned like the buffers of the CPU allocator. the doc string is
+  // written before the graph, so padding it moves the data of W to an aligned offset in the file.
+  const size_t alignment = MlasGetPreferredBufferAlignment();
+  const std::string weights_bytes(reinterpret_cast<const char*>(weights.data()), weights.size() * sizeof(float));
+  auto save_model = [&](size_t doc_string_length, size_t& weights_offset) {
+    model.SetDocString(std::string(doc_string_length, ' '));
+    ASSERT_TRUE(onnxruntime::Model::Save(model, model_file_name).IsOK());
+    std::ifstream model_file(model_file_name, std::ios::binary);
+    const std::string model_bytes{std::istreambuf_iterator<char>(model_file), std::istreambuf_iterator<char>()};
+    weights_offset = model_bytes.find(weights_bytes);
+    ASSERT_NE(weights_offset, std::string::npos);
+  };
+  size_t weights_offset;
+  ASSERT_NO_FATAL_FAILURE(save_model(1, weights_offset));
+  ASSERT_NO_FATAL_FAILURE(save_model(1 + (alignment - weights_offset % alignment) % alignment, weights_offset));
+  ASSERT_EQ(weights_offset % alignment, 0u);
+
+  std::vector<int64_t> dims = {16, 64};
+  std::vector<float> values_x(16 * 64, 1.0f);
+  OrtValue ml_value_x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims, values_x, &ml_value_x);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value_x));
+  std::vector<std::string> output_names{"Y"};
+  std::vector<float> expected_values_y(weights.size());
+  for (size_t i = 0; i < weights.size(); ++i) {
+    expected_values_y[i] = weights[i] + 1.5f;
+  }
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.MappedModelLoading";
+  so.use_mapped_model_loading = true;
+  // the saved model must hold the data of the initializers, not refer to the mapping
+  so.optimized_model_filepath = ToWideString(model_file_name + "-optimized");
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  {
+    InferenceSessionGetMappedDataWrapper session_object{so, &DefaultLoggingManager()};
+    ASSERT_TRUE(session_object.Load(model_file_name).IsOK());
+    ASSERT_TRUE(session_object.Initialize().IsOK());
+
+    // the tensor of W is created on the data in the mapped file. if the platform can't map files and the buffer
+    // the file is read into isn't aligned either, the data is copied.
+    const char* model_data = session_object.GetModelData();
+    ASSERT_NE(model_data, nullptr);
+    const OrtValue* weights_value = session_object.GetInitializedTensor("W");
+    ASSERT_NE(weights_value, nullptr);
+    const char* weights_data = static_cast<const char*>(weights_value->Get<Tensor>().DataRaw());
+    EXPECT_EQ(weights_data == model_data + weights_offset,
+              reinterpret_cast<uintptr_t>(model_data) % alignment == 0);
+
+    std::vector<OrtValue> fetches;
+    ASSERT_TRUE(session_object.Run(run_options, feeds, output_names, &fetches).IsOK());
+    VerifyOutputs(fetches, dims, expected_values_y);
+  }
+
+  SessionOptions so_saved;
+  so_saved.session_logid = so.session_logid;
+  InferenceSession session_object_saved{so_saved, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object_saved.Load(so.optimized_model_filepath).IsOK());
+  ASSERT_TRUE(session_object_saved.Initialize().IsOK());
+
+  std::vector<OrtValue> fetches;
+  ASSERT_TRUE(session_object_saved.Run(run_options, feeds, output_names, &fetches).IsOK());
+  VerifyOutputs(fetches, dims, expected_values_y);
+
+  // a model file can't make an initializer refer to data in memory, with or without mapped loading
+  auto model_proto = model.ToProto();
+  utils::SetInMemoryExternalData(weights.data(), weights.size() * sizeof(float),
+                                 *model_proto.mutable_graph()->mutable_initializer(0));
+  std::string crafted_model_file_name = "mapped_model_loading_test_in_memory_data.onnx";
+  {
+    std::ofstream crafted_model_file(crafted_model_file_name, std::ios::binary);
+    ASSERT_TRUE(model_proto.SerializeToOstream(&crafted_model_file));
+  }
+  for (bool use_mapped_model_loading : {false, true}) {
+    SessionOptions so_crafted;
+    so_crafted.session_logid = so.session_logid;
+    so_crafted.use_mapped_model_loading = use_mapped_model_loading;
+    InferenceSession session_object_crafted{so_crafted, &DefaultLoggingManager()};
+    auto status = session_object_crafted.Load(crafted_model_file_name);
+    ASSERT_FALSE(status.IsOK());
+    EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("reserved location"));
+  }
+}
+
 TEST(ExecutionProviderTest, FunctionInlineTest) {
   onnxruntime::Model model("graph_1", false, DefaultLoggingManager().DefaultLogger());
 
@@ -0,0 +1,135 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/mem_pattern_cache.h"
+
+#include <thread>
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+// insert a new pattern for the shapes and return it, or nullptr if the cache kept its own
+static const MemoryPatternGroup* Insert(MemoryPatternCache& cache, const std::vector<TensorShape>& shapes) {
+  MemoryPatternCache::InputShapes input_shapes(shapes.begin(), shapes.end());
+  auto patterns = onnxruntime::make_unique<MemoryPatternGroup>();
+  const MemoryPatternGroup* inserted = patterns.get();
+  cache.Insert(input_shapes, std::move(patterns));
+  return cache.Find(input_shapes).Get() == inserted ? inserted : nullptr;
+}
+
+static const MemoryPatternGroup* Find(const MemoryPatternCache& cache, const std::vector<TensorShape>& shapes) {
+  MemoryPatternCache::InputShapes input_shapes(shapes.begin(), shapes.end());
+  return cache.Find(input_shapes).Get();
+}
+
+TEST(MemPatternCacheTest, ExactShapesWithoutBuckets) {
+  MemoryPatternCache cache;
+
+  const auto* patterns = Insert(cache, {{2, 3}, {4}});
+  ASSERT_NE(patterns, nullptr);
+  EXPECT_EQ(Find(cache, {{2, 3}, {4}}), patterns);
+
+  EXPECT_EQ(Find(cache, {{3, 2}, {4}}), nullptr);
+  EXPECT_EQ(Find(cache, {{1, 3}, {4}}), nullptr);
+  EXPECT_EQ(Find(cache, {{2, 3, 4}}), nullptr);
+  EXPECT_EQ(Find(cache, {{2, 3}}), nullptr);
+
+  // the same shapes keep the cached pattern
+  EXPECT_EQ(Insert(cache, {{2, 3}, {4}}), nullptr);
+  EXPECT_EQ(cache.NumPatterns(), 1u);
+}
+
+TEST(MemPatternCacheTest, BucketKeepsPatternOfLargestShapes) {
+  MemoryPatternCache cache;
+  cache.Configure({16, 32, 64}, 8);
+
+  const auto* patterns_10 = Insert(cache, {{1, 10}});
+  ASSERT_NE(patterns_10, nullptr);
+  EXPECT_EQ(Find(cache, {{1, 1}}), patterns_10);
+  EXPECT_EQ(Find(cache, {{1, 10}}), patterns_10);
+
+  // larger shapes in the bucket need a new pattern, which replaces the old one
+  EXPECT_EQ(Find(cache, {{1, 12}}), nullptr);
+  const auto* patterns_12 = Insert(cache, {{1, 12}});
+  ASSERT_NE(patterns_12, nullptr);
+  EXPECT_EQ(Find(cache, {{1, 10}}), patterns_12);
+  EXPECT_EQ(Find(cache, {{1, 16}}), nullptr);
+
+  // smaller shapes don't replace it
+  EXPECT_EQ(Insert(cache, {{1, 8}}), nullptr);
+  EXPECT_EQ(Find(cache, {{1, 8}}), patterns_12);
+  EXPECT_EQ(cache.NumPatterns(), 1u);
+
+  // other buckets, and dims above the last bucket, get their own patterns
+  EXPECT_EQ(Find(cache, {{2, 10}}), nullptr);
+  EXPECT_EQ(Find(cache, {{1, 20}}), nullptr);
+  const auto* patterns_100 = Insert(cache, {{1, 100}});
+  ASSERT_NE(patterns_100, nullptr);
+  EXPECT_EQ(Find(cache, {{1, 99}}), nullptr);
+  EXPECT_EQ(cache.NumPatterns(), 2u);
+}
+
+TEST(MemPatternCacheTest, LeastRecentlyUsedPatternIsEvicted) {
+  MemoryPatternCache cache;
+  cache.Configure({}, 2);
+
+  const auto* patterns_1 = Insert(cache, {{1}});
+  const auto* patterns_2 = Insert(cache, {{2}});
+  ASSERT_NE(patterns_1, nullptr);
+  ASSERT_NE(patterns_2, nullptr);
+
+  MemoryPatternCache::InputShapes shapes_2;
+  TensorShape shape_2{2};
+  shapes_2.push_back(std::cref(shape_2));
+  MemoryPatternCache::PatternRef ref_2 = cache.Find(shapes_2);
+
+  // {1} was used last, so {2} is evicted
+  EXPECT_EQ(Find(cache, {{1}}), patterns_1);
+  const auto* patterns_3 = Insert(cache, {{3}});
+  ASSERT_NE(patterns_3, nullptr);
+  EXPECT_EQ(cache.NumPatterns(), 2u);
+  EXPECT_EQ(Find(cache, {{2}}), nullptr);
+  EXPECT_EQ(Find(cache, {{1}}), patterns_1);
+  EXPECT_EQ(Find(cache, {{3}}), patterns_3);
+
+  // an evicted pattern stays alive while it's referenced
+  ASSERT_NE(Insert(cache, {{4}}), nullptr);
+  EXPECT_EQ(cache.NumPatterns(), 2u);
+  ASSERT_EQ(ref_2.Get(), patterns_2);
+  EXPECT_TRUE(ref_2.Get()->locations.empty());
+  EXPECT_EQ(cache.NumRetiredPatterns(), 1u);
+
+  // and is deleted when its last reference is released, without waiting for another insert
+  ref_2 = MemoryPatternCache::PatternRef();
+  EXPECT_EQ(cache.NumRetiredPatterns(), 0u);
+}
+
+TEST(MemPatternCacheTest, ConcurrentFindAndInsert) {
+  MemoryPatternCache cache;
+  cache.Configure({4, 8, 16}, 4);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int64_t i = 0; i < 1000; ++i) {
+        std::vector<TensorShape> shapes{{t, (i * 7 + t) % 24}};
+        MemoryPatternCache::InputShapes input_shapes(shapes.begin(), shapes.end());
+        auto ref = cache.Find(input_shapes);
+        if (ref.Get() == nullptr) {
+          cache.Insert(input_shapes, onnxruntime::make_unique<MemoryPatternGroup>());
+        } else {
+          EXPECT_TRUE(ref.Get()->patterns.empty());
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_LE(cache.NumPatterns(), 4u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -1,11 +1,15 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <sstream>
+
 #include "core/framework/data_types.h"
 #include "core/framework/op_kernel.h"
+#include "core/graph/model.h"
 #include "test/providers/provider_test_utils.h"
 #include "test_utils.h"
 #include "core/session/inference_session.h"
+#include "test/test_environment.h"
 
 #include "gtest/gtest.h"
 
@@ -139,5 +143,62 @@ TEST(ParallelExecutor, TestNullInterOpThreadPool) {
   so.inter_op_num_threads = 1;
   tester.Run(so, OpTester::ExpectResult::kExpectSuccess, {}, {kTensorrtExecutionProvider}, nullptr, nullptr);
 }
+
+// run a graph with many independent branches, mixing nodes that are enqueued with cheap nodes that run inline
+TEST(ParallelExecutor, TestMultipleBranches) {
+  constexpr int num_branches = 8;
+
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 10}};
+  Model model("multiple_branches", false, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+              {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+  std::vector<NodeArg*> sum_inputs;
+  for (int i = 0; i < num_branches; ++i) {
+    const auto branch = std::to_string(i);
+    auto& neg_out = graph.GetOrCreateNodeArg("neg_" + branch, &float_tensor);
+    graph.AddNode("neg_node_" + branch, "Neg", "expensive branch node", {&input_arg}, {&neg_out});
+    auto& identity_out = graph.GetOrCreateNodeArg("identity_" + branch, &float_tensor);
+    graph.AddNode("identity_node_" + branch, "Identity", "cheap branch node", {&neg_out}, {&identity_out});
+    sum_inputs.push_back(&identity_out);
+  }
+
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("sum_node", "Sum", "join the branches", sum_inputs, {&output_arg});
+  Status status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  SessionOptions so;
+  so.session_logid = "ParallelExecutor.TestMultipleBranches";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.inter_op_num_threads = 4;
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+
+  std::string serialized_model;
+  model.ToProto().SerializeToString(&serialized_model);
+  std::stringstream model_stream(serialized_model);
+  ASSERT_TRUE((status = session_object.Load(model_stream)).IsOK()) << status;
+  ASSERT_TRUE((status = session_object.Initialize()).IsOK()) << status;
+
+  OrtValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {3, 2},
+                       {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &x);
+  NameMLValMap feeds{{"X", x}};
+  const std::vector<float> expected_y{-8.0f, -16.0f, -24.0f, -32.0f, -40.0f, -48.0f};
+
+  RunOptions run_options;
+  for (int run = 0; run < 10; ++run) {
+    std::vector<OrtValue> fetches;
+    ASSERT_TRUE((status = session_object.Run(run_options, feeds, {"Y"}, &fetches)).IsOK()) << status;
+    const auto& y = fetches[0].Get<Tensor>();
+    ASSERT_EQ(expected_y, std::vector<float>(y.Data<float>(), y.Data<float>() + y.Shape().Size()));
+  }
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -6,6 +6,7 @@
 #include "core/framework/execution_providers.h"
 #include "core/framework/graph_partitioner.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/prepacked_weights_container.h"
 #include "core/framework/session_state.h"
 #include "core/framework/session_state_initializer.h"
 #include "core/graph/graph_utils.h"
@@ -15,6 +16,7 @@
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "gtest/gtest.h"
 #include "test/test_environment.h"
+#include "test/util/include/asserts.h"
 
 using namespace ONNX_NAMESPACE;
 using namespace std;
@@ -152,5 +154,74 @@ TEST_P(SessionStateTestP, TestInitializerProcessing) {
 }
 
 INSTANTIATE_TEST_CASE_P(SessionStateTests, SessionStateTestP, testing::ValuesIn(param_list));
+
+// Build a model with a MatMul whose matrix B is a constant initializer and initialize a SessionState for it.
+static void CreatePrePackedSessionState(bool enable_mem_pattern, concurrency::ThreadPool& tp,
+                                        const ExecutionProviders& execution_providers,
+                                        KernelRegistryManager& krm,
+                                        PrepackedWeightsContainer* prepacked_weights_container,
+                                        std::shared_ptr<Model>& model,
+                                        std::unique_ptr<SessionState>& session_state) {
+  model = std::make_shared<Model>("prepack", false, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model->MainGraph();
+
+  TypeProto float_matrix;
+  float_matrix.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_matrix.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  float_matrix.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  TensorProto b_tensor;
+  b_tensor.set_name("B");
+  b_tensor.set_data_type(TensorProto_DataType_FLOAT);
+  b_tensor.add_dims(2);
+  b_tensor.add_dims(2);
+  for (float value : {1.f, 2.f, 3.f, 4.f}) {
+    b_tensor.add_float_data(value);
+  }
+  graph.AddInitializedTensor(b_tensor);
+
+  auto& a_arg = graph.GetOrCreateNodeArg("A", &float_matrix);
+  auto& b_arg = graph.GetOrCreateNodeArg("B", &float_matrix);
+  auto& y_arg = graph.GetOrCreateNodeArg("Y", &float_matrix);
+  graph.AddNode("matmul", "MatMul", "MatMul with constant B", {&a_arg, &b_arg}, {&y_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  session_state = onnxruntime::make_unique<SessionState>(execution_providers, enable_mem_pattern, &tp, nullptr);
+  SessionStateInitializer session_initializer(enable_mem_pattern, ORT_TSTR(""), graph, *session_state,
+                                              execution_providers, krm, prepacked_weights_container);
+
+  GraphPartitioner partitioner(krm, execution_providers);
+  ASSERT_STATUS_OK(partitioner.Partition(graph, session_state->ExportDll(), session_state->GetMutableFuncMgr()));
+  ASSERT_STATUS_OK(session_initializer.CreatePlan(nullptr, nullptr, ExecutionMode::ORT_SEQUENTIAL));
+}
+
+// Test that a constant initializer is released once the only kernel using it has pre-packed it,
+// and that sessions given the same container share the packed weights.
+TEST(SessionStateTest, PrePackConstantInitializers) {
+  concurrency::ThreadPool tp{"test", 1};
+
+  ExecutionProviders execution_providers;
+  CPUExecutionProviderInfo epi{false};
+  ASSERT_STATUS_OK(execution_providers.Add(onnxruntime::kCpuExecutionProvider,
+                                           onnxruntime::make_unique<CPUExecutionProvider>(epi)));
+
+  KernelRegistryManager krm;
+  ASSERT_STATUS_OK(krm.RegisterKernels(execution_providers));
+
+  for (bool enable_mem_pattern : {true, false}) {
+    PrepackedWeightsContainer prepacked_weights_container;
+
+    std::shared_ptr<Model> model_1, model_2;
+    std::unique_ptr<SessionState> session_state_1, session_state_2;
+    CreatePrePackedSessionState(enable_mem_pattern, tp, execution_providers, krm, &prepacked_weights_container,
+                                model_1, session_state_1);
+    CreatePrePackedSessionState(enable_mem_pattern, tp, execution_providers, krm, &prepacked_weights_container,
+                                model_2, session_state_2);
+
+    EXPECT_TRUE(session_state_1->GetInitializedTensors().empty());
+    EXPECT_TRUE(session_state_2->GetInitializedTensors().empty());
+    EXPECT_EQ(prepacked_weights_container.GetNumberOfElements(), static_cast<size_t>(1));
+  }
+}
 }  // namespace test
 }  // namespace onnxruntime
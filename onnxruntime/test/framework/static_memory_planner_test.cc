@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/static_memory_planner.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+TEST(StaticMemoryPlannerTest, TensorsNotAliveTogetherOverlap) {
+  StaticMemoryPlanner planner;
+  planner.AddTensor(0, 1024, 0, 1);
+  planner.AddTensor(1, 256, 1, 2);
+  planner.AddTensor(2, 512, 2, 3);
+  planner.AddTensor(3, 768, 3, 3);
+
+  auto pattern = planner.GenerateMemPattern();
+
+  // 3 isn't alive with 0 so it starts at 0 too. 2 goes after 3, and 1 after 0 and 2.
+  EXPECT_EQ(pattern.PeakSize(), 1024u + 256u + 256u);
+  EXPECT_EQ(pattern.GetBlock(0)->offset_, 0u);
+  EXPECT_EQ(pattern.GetBlock(3)->offset_, 0u);
+  EXPECT_EQ(pattern.GetBlock(2)->offset_, 768u);
+  EXPECT_EQ(pattern.GetBlock(1)->offset_, 768u + 512u);
+  EXPECT_EQ(pattern.GetBlock(1)->size_, 256u);
+}
+
+TEST(StaticMemoryPlannerTest, SmallestGapIsUsed) {
+  StaticMemoryPlanner planner;
+  planner.AddTensor(0, 1024, 0, 3);
+  planner.AddTensor(1, 512, 0, 0);
+  planner.AddTensor(2, 256, 0, 3);
+  planner.AddTensor(3, 128, 0, 0);
+  planner.AddTensor(4, 96, 0, 3);
+  planner.AddTensor(5, 64, 2, 3);
+  planner.AddTensor(6, 0, 2, 2);
+
+  auto pattern = planner.GenerateMemPattern();
+
+  EXPECT_EQ(pattern.GetBlock(0)->offset_, 0u);
+  EXPECT_EQ(pattern.GetBlock(1)->offset_, 1024u);
+  EXPECT_EQ(pattern.GetBlock(2)->offset_, 1024u + 512u);
+  EXPECT_EQ(pattern.GetBlock(3)->offset_, 1024u + 512u + 256u);
+  EXPECT_EQ(pattern.GetBlock(4)->offset_, 1024u + 512u + 256u + 128u);
+
+  // 1 and 3 are dead when 5 is created, and 5 takes the smaller of the gaps they leave
+  EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u + 512u + 256u);
+  EXPECT_EQ(pattern.GetBlock(6)->size_, 0u);
+  EXPECT_EQ(pattern.PeakSize(), 1024u + 512u + 256u + 128u + 96u);
+}
+}  // namespace test
+}  // namespace onnxruntime
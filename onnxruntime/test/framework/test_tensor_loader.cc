@@ -4,6 +4,8 @@
 #include "core/common/common.h"
 #include "core/framework/callback.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/mlas/inc/mlas.h"
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "file_util.h"
 
@@ -136,6 +138,62 @@ TEST(CApiTensorTest, load_float_tensor_with_external_data) {
   run_external_data_test<false>();
 }
 
+static void LoadInMemoryExternalData(char* data, bool expect_in_place) {
+  const float test_data[] = {1.0f, 2.2f, 3.5f};
+  memcpy(data, test_data, sizeof(test_data));
+  onnx::TensorProto p;
+  p.mutable_dims()->Add(3);
+  p.set_data_type(onnx::TensorProto_DataType_FLOAT);
+  utils::SetInMemoryExternalData(data, sizeof(test_data), p);
+  ASSERT_EQ(utils::UsesInMemoryData(p), expect_in_place);
+
+  std::vector<float> output(3);
+  OrtValue value;
+  auto deleter = onnxruntime::make_unique<onnxruntime::OrtCallback>();
+  OrtMemoryInfo cpu_memory_info(onnxruntime::CPU, OrtDeviceAllocator, OrtDevice(), 0, OrtMemTypeDefault);
+  auto st = utils::TensorProtoToMLValue(Env::Default(), nullptr, p,
+                                        MemBuffer(output.data(), output.size() * sizeof(float), cpu_memory_info),
+                                        value, *deleter);
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+  ASSERT_EQ(deleter->f, nullptr);
+  const float* real_output = value.Get<Tensor>().Data<float>();
+  ASSERT_EQ(real_output, expect_in_place ? reinterpret_cast<const float*>(data) : output.data());
+  ASSERT_EQ(real_output[0], 1.0f);
+  ASSERT_EQ(real_output[1], 2.2f);
+  ASSERT_EQ(real_output[2], 3.5f);
+}
+
+TEST(CApiTensorTest, load_float_tensor_with_in_memory_external_data) {
+  // the data is used in place if it's aligned like the buffers of the CPU allocator, and copied otherwise
+  const size_t alignment = MlasGetPreferredBufferAlignment();
+  std::vector<char> memory(2 * alignment + 3 * sizeof(float));
+  char* const aligned_data = memory.data() + alignment - reinterpret_cast<uintptr_t>(memory.data()) % alignment;
+  utils::RegisterInMemoryExternalData(memory.data(), memory.size());
+  LoadInMemoryExternalData(aligned_data, true);
+  LoadInMemoryExternalData(aligned_data + sizeof(float), false);
+  utils::UnregisterInMemoryExternalData(memory.data());
+}
+
+TEST(CApiTensorTest, load_float_tensor_with_unregistered_in_memory_external_data) {
+  // an address that wasn't registered, e.g. one from a model file, is never read
+  std::vector<float> data{1.0f, 2.2f, 3.5f};
+  onnx::TensorProto p;
+  p.mutable_dims()->Add(3);
+  p.set_data_type(onnx::TensorProto_DataType_FLOAT);
+  utils::SetInMemoryExternalData(data.data(), data.size() * sizeof(float), p);
+  ASSERT_FALSE(utils::UsesInMemoryData(p));
+
+  std::vector<float> output(3);
+  OrtValue value;
+  auto deleter = onnxruntime::make_unique<onnxruntime::OrtCallback>();
+  OrtMemoryInfo cpu_memory_info(onnxruntime::CPU, OrtDeviceAllocator, OrtDevice(), 0, OrtMemTypeDefault);
+  auto st = utils::TensorProtoToMLValue(Env::Default(), nullptr, p,
+                                        MemBuffer(output.data(), output.size() * sizeof(float), cpu_memory_info),
+                                        value, *deleter);
+  ASSERT_FALSE(st.IsOK());
+  EXPECT_THAT(st.ErrorMessage(), testing::HasSubstr("wasn't loaded with the model"));
+}
+
 #if defined(__amd64__) || defined(_M_X64)
 #ifndef __ANDROID__
 #ifdef NDEBUG
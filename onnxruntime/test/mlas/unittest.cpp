@@ -17,8 +17,11 @@ Abstract:
 #include <stdio.h>
 #include <memory.h>
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
+#include <random>
+#include <type_traits>
 #include <mlas.h>
 
 #if defined(_WIN32)
@@ -464,6 +467,93 @@ public:
     }
 };
 
+class MlasSgemmPackedTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        float beta
+        )
+    {
+        const float* A = BufferA.GetBuffer(K * M);
+        const float* B = BufferB.GetBuffer(N * K);
+        float* C = BufferC.GetBuffer(N * M);
+        float* CReference = BufferCReference.GetBuffer(N * M);
+
+        Test(CblasNoTrans, CblasNoTrans, M, N, K, alpha, A, K, B, N, beta, C, CReference, N);
+        Test(CblasNoTrans, CblasTrans, M, N, K, alpha, A, K, B, K, beta, C, CReference, N);
+        Test(CblasTrans, CblasNoTrans, M, N, K, alpha, A, M, B, N, beta, C, CReference, N);
+        Test(CblasTrans, CblasTrans, M, N, K, alpha, A, M, B, K, beta, C, CReference, N);
+    }
+
+    void
+    Test(
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        const float* A,
+        size_t lda,
+        const float* B,
+        size_t ldb,
+        float beta,
+        float* C,
+        float* CReference,
+        size_t ldc
+        )
+    {
+        size_t PackedBSize = MlasGemmPackBSize(N, K);
+        void* PackedB = BufferPackedB.GetBuffer(PackedBSize);
+
+        MlasGemmPackB(TransB, N, K, B, ldb, PackedB);
+
+        std::fill_n(C, M * N, -0.5f);
+        std::fill_n(CReference, M * N, -0.5f);
+
+        MlasGemm(TransA, M, N, K, alpha, A, lda, PackedB, beta, C, ldc, threadpool);
+        MlasGemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, CReference, ldc, threadpool);
+
+        for (size_t f = 0; f < M * N; f++) {
+            // Sensitive to comparing positive/negative zero.
+            if (C[f] != CReference[f]) {
+                printf("mismatch packed TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, alpha=%f, beta=%f  %f %f!\n", TransA, TransB, M, N, K, alpha, beta, C[f], CReference[f]);
+            }
+        }
+    }
+
+    MatrixGuardBuffer<float> BufferA;
+    MatrixGuardBuffer<float> BufferB;
+    MatrixGuardBuffer<float> BufferC;
+    MatrixGuardBuffer<float> BufferCReference;
+    MatrixGuardBuffer<uint8_t> BufferPackedB;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t b = 1; b < 16; b++) {
+            Test(b, b, b, 1.0f, 0.0f);
+        }
+        for (size_t b = 16; b <= 256; b <<= 1) {
+            Test(b, b, b, 1.0f, 0.0f);
+        }
+        for (size_t b = 256; b < 320; b += 32) {
+            Test(b, b, b, 1.0f, 0.0f);
+        }
+        Test(1, 2000, 600, 1.0f, 0.0f);
+        Test(7, 300, 520, 0.5f, 1.0f);
+        Test(33, 130, 17, -1.0f, 0.25f);
+    }
+};
+
 #ifdef MLAS_HAS_QGEMM_U8X8
 
 template <typename xint8_t>
@@ -514,6 +604,122 @@ private:
                 printf("mismatch M=%zd, N=%zd, K=%zd, offa=%d, offb=%d!\n", M, N, K, offa, offb);
             }
         }
+
+        constexpr bool BIsSigned = std::is_signed<xint8_t>::value;
+
+        size_t PackedBSize = MlasGemmPackBSize(N, K, BIsSigned);
+        void* PackedB = BufferPackedB.GetBuffer(PackedBSize);
+
+        MlasGemmPackB(N, K, (const uint8_t*)B, ldb, BIsSigned, PackedB);
+
+        std::fill_n(C, M * N, -1);
+
+        MlasGemm(M, N, K, A, lda, offa, PackedB, uint8_t(offb), BIsSigned, C, ldc, threadpool);
+
+        for (size_t f = 0; f < M * N; f++) {
+            if (C[f] != CReference[f]) {
+                printf("mismatch packed B M=%zd, N=%zd, K=%zd, offa=%d, offb=%d!\n", M, N, K, offa, offb);
+            }
+        }
+
+        size_t PackedASize = MlasGemmPackASize(M, K, BIsSigned);
+        void* PackedA = BufferPackedA.GetBuffer(PackedASize);
+
+        MlasGemmPackA(M, K, A, lda, BIsSigned, PackedA);
+
+        std::fill_n(C, M * N, -1);
+
+        MlasGemm(M, N, K, PackedA, offa, (const uint8_t*)B, ldb, uint8_t(offb), BIsSigned, C, ldc, threadpool);
+
+        for (size_t f = 0; f < M * N; f++) {
+            if (C[f] != CReference[f]) {
+                printf("mismatch packed A M=%zd, N=%zd, K=%zd, offa=%d, offb=%d!\n", M, N, K, offa, offb);
+            }
+        }
+    }
+
+    void
+    TestOutputProcessor(
+        size_t M,
+        size_t N,
+        size_t K,
+        uint8_t offa,
+        uint8_t offb,
+        bool PerColumnScale
+        )
+    {
+        const uint8_t* A = BufferA.GetBuffer(K * M);
+        const xint8_t* B = BufferB.GetBuffer(N * K);
+        int32_t* C = BufferC.GetBuffer(N * M);
+        int32_t* CReference = BufferCReference.GetBuffer(N * M);
+        uint8_t* Requantized = BufferRequantized.GetBuffer(N * M);
+        float* Dequantized = BufferDequantized.GetBuffer(N * M);
+
+        std::vector<int32_t> IntegerBias(N);
+        std::vector<float> FloatBias(N);
+        std::vector<float> Scale(N);
+
+        for (size_t n = 0; n < N; n++) {
+            IntegerBias[n] = int32_t(n * 131 % 1999) - 1000;
+            FloatBias[n] = float(IntegerBias[n]) / 64.0f;
+            Scale[n] = PerColumnScale ? 0.0001f * float(n % 31 + 1) : 0.0017f;
+        }
+
+        ReferenceQgemm(M, N, K, A, K, offa, B, N, xint8_t(offb), CReference, N);
+
+        MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR RequantProcessor(Requantized, N,
+            IntegerBias.data(), Scale.data(), PerColumnScale, 113);
+
+        MlasGemm(M, N, K, A, K, offa, B, N, xint8_t(offb), C, N, threadpool, &RequantProcessor);
+
+        for (size_t f = 0; f < M * N; f++) {
+            size_t n = f % N;
+            float Value = float(CReference[f] + IntegerBias[n]) * Scale[n];
+            Value = std::min(std::max(Value, -113.0f), 142.0f);
+            uint8_t Expected = uint8_t(int32_t(std::nearbyintf(Value)) + 113);
+            if (Requantized[f] != Expected) {
+                printf("mismatch requantize M=%zd, N=%zd, K=%zd, offa=%d, offb=%d, %d %d!\n", M, N, K, offa, offb, Requantized[f], Expected);
+                break;
+            }
+        }
+
+        constexpr bool BIsSigned = std::is_signed<xint8_t>::value;
+
+        size_t PackedASize = MlasGemmPackASize(M, K, BIsSigned);
+        void* PackedA = BufferPackedA.GetBuffer(PackedASize);
+
+        MlasGemmPackA(M, K, A, K, BIsSigned, PackedA);
+
+        std::vector<uint8_t> RequantizedPacked(M * N);
+
+        MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR PackedRequantProcessor(RequantizedPacked.data(), N,
+            IntegerBias.data(), Scale.data(), PerColumnScale, 113);
+
+        MlasGemm(M, N, K, PackedA, offa, (const uint8_t*)B, N, offb, BIsSigned, C, N, threadpool, &PackedRequantProcessor);
+
+        for (size_t f = 0; f < M * N; f++) {
+            if (RequantizedPacked[f] != Requantized[f]) {
+                printf("mismatch packed A requantize M=%zd, N=%zd, K=%zd, offa=%d, offb=%d, %d %d!\n", M, N, K, offa, offb, RequantizedPacked[f], Requantized[f]);
+                break;
+            }
+        }
+
+        MLAS_ACTIVATION Activation;
+        Activation.ActivationKind = MlasReluActivation;
+
+        MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR ScaleBiasProcessor(Dequantized, N,
+            Scale.data(), PerColumnScale, FloatBias.data(), &Activation);
+
+        MlasGemm(M, N, K, A, K, offa, B, N, xint8_t(offb), C, N, threadpool, &ScaleBiasProcessor);
+
+        for (size_t f = 0; f < M * N; f++) {
+            size_t n = f % N;
+            float Expected = std::max(float(CReference[f]) * Scale[n] + FloatBias[n], 0.0f);
+            if (std::fabs(Dequantized[f] - Expected) > 1e-5f * std::max(1.0f, std::fabs(Expected))) {
+                printf("mismatch dequantize M=%zd, N=%zd, K=%zd, offa=%d, offb=%d, %f %f!\n", M, N, K, offa, offb, Dequantized[f], Expected);
+                break;
+            }
+        }
     }
 
     void
@@ -555,6 +761,10 @@ private:
     MatrixGuardBuffer<xint8_t> BufferB;
     MatrixGuardBuffer<int32_t> BufferC;
     MatrixGuardBuffer<int32_t> BufferCReference;
+    MatrixGuardBuffer<uint8_t> BufferRequantized;
+    MatrixGuardBuffer<float> BufferDequantized;
+    MatrixGuardBuffer<uint8_t> BufferPackedA;
+    MatrixGuardBuffer<uint8_t> BufferPackedB;
 
 public:
     void
@@ -565,6 +775,11 @@ public:
         for (size_t b = 1; b < 16; b++) {
             Test(b, b, b, 14, 211);
         }
+        for (size_t b = 1; b < 300; b += 37) {
+            TestOutputProcessor(b, b + 3, b + 5, 14, 211, false);
+            TestOutputProcessor(b + 7, b, 129, 34, 1, true);
+            TestOutputProcessor(1, b, b, 0, 0, true);
+        }
         for (size_t b = 16; b <= 256; b <<= 1) {
             Test(b, b, b, 34, 1);
         }
@@ -1191,6 +1406,233 @@ public:
 
 };
 
+class MlasConvTranspose2DTest : public MlasTestBase
+{
+protected:
+    void
+    Test(
+        size_t BatchCount,
+        size_t GroupCount,
+        size_t InputChannels,
+        size_t InputHeight,
+        size_t InputWidth,
+        size_t FilterCount,
+        size_t KernelHeight,
+        size_t KernelWidth,
+        size_t PaddingLeftHeight,
+        size_t PaddingLeftWidth,
+        size_t PaddingRightHeight,
+        size_t PaddingRightWidth,
+        size_t DilationHeight,
+        size_t DilationWidth,
+        size_t StrideHeight,
+        size_t StrideWidth
+        )
+    {
+        int64_t OutputHeight64 =
+            int64_t(StrideHeight) * (int64_t(InputHeight) - 1) +
+            int64_t(DilationHeight) * (int64_t(KernelHeight) - 1) + 1 -
+            int64_t(PaddingLeftHeight) - int64_t(PaddingRightHeight);
+        int64_t OutputWidth64 =
+            int64_t(StrideWidth) * (int64_t(InputWidth) - 1) +
+            int64_t(DilationWidth) * (int64_t(KernelWidth) - 1) + 1 -
+            int64_t(PaddingLeftWidth) - int64_t(PaddingRightWidth);
+
+        if (OutputHeight64 <= 0 || OutputWidth64 <= 0) {
+            return;
+        }
+
+        size_t OutputHeight = size_t(OutputHeight64);
+        size_t OutputWidth = size_t(OutputWidth64);
+
+        size_t InputSize = InputHeight * InputWidth;
+        size_t KernelSize = KernelHeight * KernelWidth;
+        size_t OutputSize = OutputHeight * OutputWidth;
+
+        size_t InputElements = BatchCount * GroupCount * InputChannels * InputSize;
+        size_t FilterElements = GroupCount * InputChannels * FilterCount * KernelSize;
+        size_t BiasElements = GroupCount * FilterCount;
+        size_t OutputElements = BatchCount * GroupCount * FilterCount * OutputSize;
+
+        const float* Input = BufferInput.GetBuffer(InputElements);
+        const float* Filter = BufferFilter.GetBuffer(FilterElements);
+        const float* Bias = BufferBias.GetBuffer(BiasElements);
+        float* Output = BufferOutput.GetBuffer(OutputElements);
+        float* OutputReference = BufferOutputReference.GetBuffer(OutputElements);
+
+        int64_t InputShape[] = { int64_t(InputHeight), int64_t(InputWidth) };
+        int64_t KernelShape[] = { int64_t(KernelHeight), int64_t(KernelWidth) };
+        int64_t DilationShape[] = { int64_t(DilationHeight), int64_t(DilationWidth) };
+        int64_t Padding[] = { int64_t(PaddingLeftHeight), int64_t(PaddingLeftWidth), int64_t(PaddingRightHeight), int64_t(PaddingRightWidth) };
+        int64_t StrideShape[] = { int64_t(StrideHeight), int64_t(StrideWidth) };
+        int64_t OutputShape[] = { int64_t(OutputHeight), int64_t(OutputWidth) };
+
+        MLAS_ACTIVATION Activation;
+        Activation.ActivationKind = MlasIdentityActivation;
+
+        MLAS_CONV_PARAMETERS Parameters;
+        size_t WorkingBufferSize;
+
+        MlasConvTransposePrepare(&Parameters,
+                                 2,
+                                 BatchCount,
+                                 GroupCount,
+                                 InputChannels,
+                                 InputShape,
+                                 KernelShape,
+                                 DilationShape,
+                                 Padding,
+                                 StrideShape,
+                                 OutputShape,
+                                 FilterCount,
+                                 &Activation,
+                                 &WorkingBufferSize,
+                                 threadpool);
+
+        MlasConvTranspose(&Parameters,
+                          Input,
+                          Filter,
+                          Bias,
+                          BufferWorking.GetBuffer(WorkingBufferSize),
+                          Output,
+                          threadpool);
+
+        ReferenceConvTranspose2D(BatchCount,
+                                 GroupCount,
+                                 InputChannels,
+                                 InputHeight, InputWidth,
+                                 FilterCount,
+                                 KernelHeight, KernelWidth,
+                                 PaddingLeftHeight, PaddingLeftWidth,
+                                 DilationHeight, DilationWidth,
+                                 StrideHeight, StrideWidth,
+                                 OutputHeight, OutputWidth,
+                                 Input,
+                                 Filter,
+                                 Bias,
+                                 OutputReference);
+
+        constexpr float AbsoluteTolerance = 1e-4f;
+        constexpr float RelativeTolerance = 1e-5f;
+
+        for (size_t n = 0; n < OutputElements; n++) {
+            float diff = std::fabs(Output[n] - OutputReference[n]);
+            if (diff > AbsoluteTolerance && diff > std::fabs(OutputReference[n]) * RelativeTolerance) {
+                printf("mismatch: batch=%zd,group=%zd,input(%zd,%zd,%zd),filter=%zd,kernel(%zd,%zd)!!!\n",
+                    BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount,
+                    KernelHeight, KernelWidth);
+                break;
+            }
+        }
+    }
+
+    void
+    ReferenceConvTranspose2D(
+        size_t BatchCount,
+        size_t GroupCount,
+        size_t InputChannels,
+        size_t InputHeight,
+        size_t InputWidth,
+        size_t FilterCount,
+        size_t KernelHeight,
+        size_t KernelWidth,
+        size_t PaddingLeftHeight,
+        size_t PaddingLeftWidth,
+        size_t DilationHeight,
+        size_t DilationWidth,
+        size_t StrideHeight,
+        size_t StrideWidth,
+        size_t OutputHeight,
+        size_t OutputWidth,
+        const float* Input,
+        const float* Filter,
+        const float* Bias,
+        float* Output
+        )
+    {
+        size_t InputSize = InputHeight * InputWidth;
+        size_t OutputSize = OutputHeight * OutputWidth;
+        size_t KernelSize = KernelHeight * KernelWidth;
+
+        for (size_t b = 0; b < BatchCount; b++) {
+
+            for (size_t g = 0; g < GroupCount; g++) {
+
+                const float* filter = Filter + g * InputChannels * FilterCount * KernelSize;
+                const float* bias = Bias + g * FilterCount;
+
+                //
+                // Initialize the output with the bias and then scatter each
+                // input element through the kernel.
+                //
+
+                for (size_t f = 0; f < FilterCount; f++) {
+                    std::fill_n(Output + f * OutputSize, OutputSize, bias[f]);
+                }
+
+                for (size_t c = 0; c < InputChannels; c++) {
+
+                    for (size_t f = 0; f < FilterCount; f++) {
+
+                        const float* kernel = filter + (c * FilterCount + f) * KernelSize;
+
+                        for (size_t ih = 0; ih < InputHeight; ih++) {
+
+                            for (size_t iw = 0; iw < InputWidth; iw++) {
+
+                                float value = Input[c * InputSize + ih * InputWidth + iw];
+
+                                for (size_t ky = 0; ky < KernelHeight; ky++) {
+
+                                    size_t oh = ih * StrideHeight + ky * DilationHeight - PaddingLeftHeight;
+
+                                    for (size_t kx = 0; kx < KernelWidth; kx++) {
+
+                                        size_t ow = iw * StrideWidth + kx * DilationWidth - PaddingLeftWidth;
+
+                                        if (oh < OutputHeight && ow < OutputWidth) {
+                                            Output[f * OutputSize + oh * OutputWidth + ow] +=
+                                                value * kernel[ky * KernelWidth + kx];
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+
+                Input += InputChannels * InputSize;
+                Output += FilterCount * OutputSize;
+            }
+        }
+    }
+
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferFilter;
+    MatrixGuardBuffer<float> BufferBias;
+    MatrixGuardBuffer<float> BufferOutput;
+    MatrixGuardBuffer<float> BufferOutputReference;
+    MatrixGuardBuffer<float> BufferWorking;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (unsigned i = 1; i < 64; i <<= 1) {
+            Test(1, 1, 16, i, i, 32, 3, 3, 0, 0, 0, 0, 1, 1, 1, 1);
+            Test(1, 1, 16, i, i, 32, 3, 3, 0, 0, 0, 0, 1, 1, 2, 2);
+            Test(1, 1, 16, i, i, 32, 3, 3, 0, 0, 0, 0, 2, 2, 1, 1);
+            Test(1, 1, 16, i, i, 32, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2);
+            Test(1, 1, 16, i, i, 32, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1);
+            Test(2, 3, 8, i, i, 5, 2, 2, 0, 1, 1, 0, 1, 1, 2, 2);
+            Test(3, 1, 4, 1, i, 7, 1, 5, 0, 2, 0, 1, 1, 1, 1, 3);
+        }
+    }
+
+};
+
 class MlasPool2DTest : public MlasTestBase
 {
 protected:
@@ -1969,6 +2411,122 @@ public:
     }
 };
 
+class MlasSoftmaxTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferOutput;
+    MatrixGuardBuffer<float> BufferOutputReference;
+
+    void
+    Test(
+        size_t N,
+        size_t D,
+        float MinimumValue,
+        float MaximumValue
+        )
+    {
+        float* Input = BufferInput.GetBuffer(N * D);
+        float* Output = BufferOutput.GetBuffer(N * D);
+        float* OutputReference = BufferOutputReference.GetBuffer(N * D);
+
+        std::default_random_engine generator(static_cast<unsigned>(N * D));
+        std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+
+        for (size_t nd = 0; nd < N * D; nd++) {
+            Input[nd] = distribution(generator);
+        }
+
+        Test(Input, Output, OutputReference, N, D, false);
+        Test(Input, Output, OutputReference, N, D, true);
+    }
+
+    void
+    Test(
+        const float* Input,
+        float* Output,
+        float* OutputReference,
+        size_t N,
+        size_t D,
+        bool LogSoftmax
+        )
+    {
+        MlasComputeSoftmax(Input, Output, N, D, LogSoftmax, threadpool);
+        ReferenceSoftmax(Input, OutputReference, N, D, LogSoftmax);
+
+        constexpr float AbsoluteTolerance = 1e-6f;
+        constexpr float RelativeTolerance = 1e-5f;
+
+        for (size_t nd = 0; nd < N * D; nd++) {
+            float diff = std::fabs(Output[nd] - OutputReference[nd]);
+            if (diff > AbsoluteTolerance && diff > std::fabs(OutputReference[nd]) * RelativeTolerance) {
+                printf("mismatch Softmax: log=%d N=%zd D=%zd index=%zd value=%.8f expected=%.8f\n",
+                    int(LogSoftmax), N, D, nd, Output[nd], OutputReference[nd]);
+                break;
+            }
+        }
+    }
+
+    void
+    ReferenceSoftmax(
+        const float* Input,
+        float* Output,
+        size_t N,
+        size_t D,
+        bool LogSoftmax
+        )
+    {
+        for (size_t n = 0; n < N; n++) {
+
+            float MaximumValue = std::numeric_limits<float>::lowest();
+
+            for (size_t d = 0; d < D; d++) {
+                MaximumValue = (std::max)(MaximumValue, Input[d]);
+            }
+
+            double Sum = 0.0;
+
+            for (size_t d = 0; d < D; d++) {
+                double e = std::exp(double(Input[d]) - double(MaximumValue));
+                Sum += e;
+                Output[d] = float(e);
+            }
+
+            if (LogSoftmax) {
+
+                for (size_t d = 0; d < D; d++) {
+                    Output[d] = float(double(Input[d]) - double(MaximumValue) - std::log(Sum));
+                }
+
+            } else {
+
+                for (size_t d = 0; d < D; d++) {
+                    Output[d] = float(Output[d] / Sum);
+                }
+            }
+
+            Input += D;
+            Output += D;
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t d = 1; d < 128; d++) {
+            Test(1, d, -10.f, 10.f);
+        }
+
+        Test(3, 128, 20.f, 30.f);
+        Test(63, 95, -150.f, 190.f);
+        Test(16, 211, 20.f, 30.f);
+        Test(128, 512, -4.f, 4.f);
+    }
+};
+
 class MlasReorderOutputTest : public MlasTestBase
 {
 private:
@@ -2071,6 +2629,211 @@ public:
     }
 };
 
+class MlasNchwcUpsampleTest : public MlasTestBase
+{
+private:
+    const size_t BlockSize = MlasNchwcGetBlockSize();
+
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferOutput;
+    MatrixGuardBuffer<float> BufferOutputReference;
+
+    void
+    Test(
+        size_t BatchCount,
+        size_t Channels,
+        size_t InputHeight,
+        size_t InputWidth,
+        size_t ScaleHeight,
+        size_t ScaleWidth
+        )
+    {
+        size_t NchwcChannels = (Channels + BlockSize - 1) & ~(BlockSize - 1);
+        size_t OutputHeight = InputHeight * ScaleHeight;
+        size_t OutputWidth = InputWidth * ScaleWidth;
+
+        size_t InputBufferElements = BatchCount * NchwcChannels * InputHeight * InputWidth;
+        size_t OutputBufferElements = BatchCount * NchwcChannels * OutputHeight * OutputWidth;
+
+        float* Input = BufferInput.GetBuffer(InputBufferElements);
+        float* Output = BufferOutput.GetBuffer(OutputBufferElements);
+        float* OutputReference = BufferOutputReference.GetBuffer(OutputBufferElements);
+
+        for (size_t i = 0; i < InputBufferElements; i++) {
+            Input[i] = float((i % 23) + 1) * 0.25f;
+        }
+
+        int64_t InputShape[] = { int64_t(BatchCount), int64_t(NchwcChannels), int64_t(InputHeight), int64_t(InputWidth) };
+        int64_t Scales[] = { int64_t(ScaleHeight), int64_t(ScaleWidth) };
+
+        std::fill_n(Output, OutputBufferElements, -0.5f);
+        std::fill_n(OutputReference, OutputBufferElements, -0.5f);
+
+        MlasNchwcUpsampleNearest(InputShape, Scales, Input, Output);
+        ReferenceUpsample(BatchCount * NchwcChannels, InputHeight, InputWidth, ScaleHeight, ScaleWidth, Input, OutputReference, false);
+
+        if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+            printf("mismatch UpsampleNearest: batch=%zd channels=%zd height=%zd width=%zd scales=%zd,%zd\n",
+                BatchCount, Channels, InputHeight, InputWidth, ScaleHeight, ScaleWidth);
+        }
+
+        std::vector<float> InterpolationWidth(OutputWidth);
+        for (size_t ow = 0; ow < OutputWidth; ow++) {
+            InterpolationWidth[ow] = float(ow) / float(ScaleWidth);
+        }
+
+        std::fill_n(Output, OutputBufferElements, -0.5f);
+        std::fill_n(OutputReference, OutputBufferElements, -0.5f);
+
+        const float* input = Input;
+        float* output = Output;
+
+        for (size_t c = 0; c < BatchCount * NchwcChannels; c += BlockSize) {
+            for (size_t oh = 0; oh < OutputHeight; oh++) {
+                MlasNchwcUpsampleLinear(InputHeight, InputWidth, OutputWidth, float(oh) / float(ScaleHeight),
+                    InterpolationWidth.data(), input, output);
+                output += OutputWidth * BlockSize;
+            }
+            input += InputHeight * InputWidth * BlockSize;
+        }
+
+        ReferenceUpsample(BatchCount * NchwcChannels, InputHeight, InputWidth, ScaleHeight, ScaleWidth, Input, OutputReference, true);
+
+        for (size_t i = 0; i < OutputBufferElements; i++) {
+            if (std::fabs(Output[i] - OutputReference[i]) > 1e-5f) {
+                printf("mismatch UpsampleLinear: batch=%zd channels=%zd height=%zd width=%zd scales=%zd,%zd\n",
+                    BatchCount, Channels, InputHeight, InputWidth, ScaleHeight, ScaleWidth);
+                break;
+            }
+        }
+    }
+
+    void
+    ReferenceUpsample(
+        size_t TotalChannels,
+        size_t InputHeight,
+        size_t InputWidth,
+        size_t ScaleHeight,
+        size_t ScaleWidth,
+        const float* Input,
+        float* Output,
+        bool LinearMode
+        )
+    {
+        size_t OutputHeight = InputHeight * ScaleHeight;
+        size_t OutputWidth = InputWidth * ScaleWidth;
+
+        for (size_t c = 0; c < TotalChannels; c++) {
+
+            const float* input = Input + (c & ~(BlockSize - 1)) * InputHeight * InputWidth + (c & (BlockSize - 1));
+            float* output = Output + (c & ~(BlockSize - 1)) * OutputHeight * OutputWidth + (c & (BlockSize - 1));
+
+            for (size_t oh = 0; oh < OutputHeight; oh++) {
+                for (size_t ow = 0; ow < OutputWidth; ow++) {
+
+                    float value;
+
+                    if (LinearMode) {
+                        float y = float(oh) / float(ScaleHeight);
+                        float x = float(ow) / float(ScaleWidth);
+                        size_t y1 = size_t(y);
+                        size_t y2 = std::min(y1 + 1, InputHeight - 1);
+                        size_t x1 = size_t(x);
+                        size_t x2 = std::min(x1 + 1, InputWidth - 1);
+                        float dy1 = (y1 == y2) ? 0.5f : y - float(y1);
+                        float dy2 = (y1 == y2) ? 0.5f : float(y2) - y;
+                        float dx1 = (x1 == x2) ? 0.5f : x - float(x1);
+                        float dx2 = (x1 == x2) ? 0.5f : float(x2) - x;
+                        value = dx2 * dy2 * input[(y1 * InputWidth + x1) * BlockSize] +
+                                dx1 * dy2 * input[(y1 * InputWidth + x2) * BlockSize] +
+                                dx2 * dy1 * input[(y2 * InputWidth + x1) * BlockSize] +
+                                dx1 * dy1 * input[(y2 * InputWidth + x2) * BlockSize];
+                    } else {
+                        value = input[((oh / ScaleHeight) * InputWidth + (ow / ScaleWidth)) * BlockSize];
+                    }
+
+                    output[(oh * OutputWidth + ow) * BlockSize] = value;
+                }
+            }
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t s = 1; s <= 4; s++) {
+            Test(1, 16, 1, 1, s, s);
+            Test(1, 32, 7, 9, s, s);
+            Test(3, 64, 5, 4, s, s + 1);
+            Test(2, 48, 13, 11, s + 1, s);
+        }
+    }
+};
+
+template<typename ElementType>
+class MlasTransposeTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<ElementType> BufferInput;
+    MatrixGuardBuffer<ElementType> BufferOutput;
+    MatrixGuardBuffer<ElementType> BufferOutputReference;
+
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t ldInput,
+        size_t ldOutput
+        )
+    {
+        ElementType* Input = BufferInput.GetBuffer(M * ldInput);
+        ElementType* Output = BufferOutput.GetBuffer(N * ldOutput);
+        ElementType* OutputReference = BufferOutputReference.GetBuffer(N * ldOutput);
+
+        for (size_t i = 0; i < M * ldInput; i++) {
+            Input[i] = ElementType(i * 0x9E3779B97F4A7C15ull >> 7);
+        }
+
+        std::fill_n(Output, N * ldOutput, ElementType(0x55));
+        std::fill_n(OutputReference, N * ldOutput, ElementType(0x55));
+
+        MlasTranspose(Input, ldInput, Output, ldOutput, M, N);
+
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < N; n++) {
+                OutputReference[n * ldOutput + m] = Input[m * ldInput + n];
+            }
+        }
+
+        if (memcmp(Output, OutputReference, N * ldOutput * sizeof(ElementType)) != 0) {
+            printf("mismatch Transpose: element=%zd M=%zd N=%zd ldInput=%zd ldOutput=%zd\n",
+                sizeof(ElementType), M, N, ldInput, ldOutput);
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t m = 1; m <= 32; m++) {
+            for (size_t n = 1; n <= 32; n++) {
+                Test(m, n, n, m);
+                Test(m, n, n + 3, m + 5);
+            }
+        }
+
+        Test(3, 1000, 1000, 3);
+        Test(1000, 3, 3, 1000);
+        Test(197, 211, 211, 197);
+        Test(256, 384, 400, 300);
+    }
+};
+
 int
 #if defined(_WIN32)
 __cdecl
@@ -2083,6 +2846,7 @@ main(
 
         printf("SGEMM tests.\n");
         onnxruntime::make_unique<MlasFgemmTest<float>>()->ExecuteShort();
+        onnxruntime::make_unique<MlasSgemmPackedTest>()->ExecuteShort();
 #ifdef MLAS_HAS_DGEMM
         printf("DGEMM tests.\n");
         onnxruntime::make_unique<MlasFgemmTest<double>>()->ExecuteShort();
@@ -2100,6 +2864,9 @@ main(
           onnxruntime::make_unique<MlasNchwcConv2DTest>()->ExecuteShort();
         }
 
+        printf("ConvTranspose2D tests.\n");
+        onnxruntime::make_unique<MlasConvTranspose2DTest>()->ExecuteShort();
+
         printf("Pool2D tests.\n");
         onnxruntime::make_unique<MlasPool2DTest>()->ExecuteShort();
         if (MlasNchwcGetBlockSize() > 1) {
@@ -2109,6 +2876,9 @@ main(
         printf("Pool3D tests.\n");
         onnxruntime::make_unique<MlasPool3DTest>()->ExecuteShort();
 
+        printf("Softmax tests.\n");
+        onnxruntime::make_unique<MlasSoftmaxTest>()->ExecuteShort();
+
         printf("Done.\n");
 #if !defined(MLAS_NO_ONNXRUNTIME_THREADPOOL)
         if(threadpool != nullptr) threadpool = new onnxruntime::concurrency::ThreadPool("test", 2);
@@ -2128,5 +2898,16 @@ main(
         onnxruntime::make_unique<MlasReorderOutputTest>()->ExecuteShort();
     }
 
+    printf("NCHWc Upsample tests.\n");
+    if (MlasNchwcGetBlockSize() > 1) {
+        onnxruntime::make_unique<MlasNchwcUpsampleTest>()->ExecuteShort();
+    }
+
+    printf("Transpose tests.\n");
+    onnxruntime::make_unique<MlasTransposeTest<uint8_t>>()->ExecuteShort();
+    onnxruntime::make_unique<MlasTransposeTest<uint16_t>>()->ExecuteShort();
+    onnxruntime::make_unique<MlasTransposeTest<uint32_t>>()->ExecuteShort();
+    onnxruntime::make_unique<MlasTransposeTest<uint64_t>>()->ExecuteShort();
+
     return 0;
 }
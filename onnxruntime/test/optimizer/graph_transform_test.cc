@@ -14,6 +14,7 @@
 #include "core/optimizer/conv_add_fusion.h"
 #include "core/optimizer/conv_activation_fusion.h"
 #include "core/optimizer/dropout_elimination.h"
+#include "core/optimizer/dynamic_quantize_matmul_fusion.h"
 #include "core/optimizer/gemm_activation_fusion.h"
 #include "core/optimizer/bias_gelu_fusion.h"
 #include "core/optimizer/gelu_fusion.h"
@@ -398,6 +399,40 @@ TEST(GraphTransformationTests, FuseConvActivation) {
   }
 }
 
+TEST(GraphTransformationTests, FuseConvTransposeActivation) {
+  Model model("FuseConvTransposeActivation", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &tensor_type);
+  auto& w = graph.GetOrCreateNodeArg("W", &tensor_type);
+  auto& conv_output = graph.GetOrCreateNodeArg("conv_output", &tensor_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &tensor_type);
+
+  graph.AddNode("conv_transpose", "ConvTranspose", "ConvTranspose to fuse", {&x, &w}, {&conv_output});
+  auto& leaky_relu = graph.AddNode("leaky_relu", "LeakyRelu", "LeakyRelu to fuse", {&conv_output}, {&y});
+  leaky_relu.AddAttribute("alpha", 0.1f);
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<ConvActivationFusion>(), TransformerLevel::Level2);
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, DefaultLoggingManager().DefaultLogger()).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["ConvTranspose"], 0);
+  ASSERT_EQ(op_to_count["LeakyRelu"], 0);
+  ASSERT_EQ(op_to_count["FusedConvTranspose"], 1);
+
+  for (const Node& node : graph.Nodes()) {
+    EXPECT_EQ(graph_utils::GetNodeAttribute(node, "activation")->s(), "LeakyRelu");
+    EXPECT_EQ(graph_utils::GetNodeAttribute(node, "activation_params")->floats(0), 0.1f);
+  }
+}
+
 TEST(GraphTransformationTests, FuseConvClip11Activation) {
   auto model_uri = MODEL_FOLDER "fusion/conv_clip11.onnx";
   std::shared_ptr<Model> p_model;
@@ -1605,6 +1640,100 @@ TEST(GraphTransformationTests, EmbedLayerNormFusionFormat5) {
   }
 }
 
+// Test fusion of DynamicQuantizeLinear -> MatMulInteger -> Cast -> Mul chains sharing one DynamicQuantizeLinear.
+TEST(GraphTransformationTests, DynamicQuantizeMatMulFusion) {
+  Model model("DynamicQuantizeMatMulFusion", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto make_tensor_type = [](TensorProto_DataType elem_type, const std::vector<int64_t>& dims) {
+    TypeProto tensor_type;
+    tensor_type.mutable_tensor_type()->set_elem_type(elem_type);
+    auto* shape = tensor_type.mutable_tensor_type()->mutable_shape();
+    for (auto dim : dims) {
+      shape->add_dim()->set_dim_value(dim);
+    }
+    return tensor_type;
+  };
+
+  TypeProto a_type = make_tensor_type(TensorProto_DataType_FLOAT, {4, 16});
+  TypeProto a_quant_type = make_tensor_type(TensorProto_DataType_UINT8, {4, 16});
+  TypeProto float_scalar_type = make_tensor_type(TensorProto_DataType_FLOAT, {});
+  TypeProto uint8_scalar_type = make_tensor_type(TensorProto_DataType_UINT8, {});
+  TypeProto b0_type = make_tensor_type(TensorProto_DataType_UINT8, {16, 8});
+  TypeProto b1_type = make_tensor_type(TensorProto_DataType_INT8, {16, 8});
+  TypeProto b1_scale_type = make_tensor_type(TensorProto_DataType_FLOAT, {8});
+  TypeProto int32_output_type = make_tensor_type(TensorProto_DataType_INT32, {4, 8});
+  TypeProto float_output_type = make_tensor_type(TensorProto_DataType_FLOAT, {4, 8});
+
+  auto& a = graph.GetOrCreateNodeArg("A", &a_type);
+  auto& a_quant = graph.GetOrCreateNodeArg("A_quant", &a_quant_type);
+  auto& a_scale = graph.GetOrCreateNodeArg("A_scale", &float_scalar_type);
+  auto& a_zero_point = graph.GetOrCreateNodeArg("A_zero_point", &uint8_scalar_type);
+  graph.AddNode("dynamic_quantize", "DynamicQuantizeLinear", "Quantize A", {&a}, {&a_quant, &a_scale, &a_zero_point});
+
+  // B0 is uint8 with a zero point and a per tensor scale, B1 is int8 with a per column scale.
+  auto& b0 = graph.GetOrCreateNodeArg("B0", &b0_type);
+  auto& b0_scale = graph.GetOrCreateNodeArg("B0_scale", &float_scalar_type);
+  auto& b0_zero_point = graph.GetOrCreateNodeArg("B0_zero_point", &uint8_scalar_type);
+  auto& b1 = graph.GetOrCreateNodeArg("B1", &b1_type);
+  auto& b1_scale = graph.GetOrCreateNodeArg("B1_scale", &b1_scale_type);
+
+  std::vector<NodeArg*> outputs;
+  for (int i = 0; i < 2; i++) {
+    std::string suffix = std::to_string(i);
+    std::vector<NodeArg*> matmul_integer_inputs{&a_quant, i == 0 ? &b0 : &b1, &a_zero_point};
+    if (i == 0) {
+      matmul_integer_inputs.push_back(&b0_zero_point);
+    }
+
+    auto& matmul_integer_output = graph.GetOrCreateNodeArg("matmul_integer_output" + suffix, &int32_output_type);
+    auto& cast_output = graph.GetOrCreateNodeArg("cast_output" + suffix, &float_output_type);
+    auto& scales_mul_output = graph.GetOrCreateNodeArg("scales_mul_output" + suffix,
+                                                       i == 0 ? &float_scalar_type : &b1_scale_type);
+    auto& y = graph.GetOrCreateNodeArg("Y" + suffix, &float_output_type);
+
+    graph.AddNode("matmul_integer" + suffix, "MatMulInteger", "MatMulInteger", matmul_integer_inputs,
+                  {&matmul_integer_output});
+    auto& cast = graph.AddNode("cast" + suffix, "Cast", "Cast to float", {&matmul_integer_output}, {&cast_output});
+    cast.AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_FLOAT));
+    graph.AddNode("scales_mul" + suffix, "Mul", "Multiply scales", {&a_scale, i == 0 ? &b0_scale : &b1_scale},
+                  {&scales_mul_output});
+    graph.AddNode("output_mul" + suffix, "Mul", "Dequantize output", {&cast_output, &scales_mul_output}, {&y});
+    outputs.push_back(&y);
+  }
+
+  graph.SetInputs({&a, &b0, &b0_scale, &b0_zero_point, &b1, &b1_scale});
+  graph.SetOutputs(outputs);
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<DynamicQuantizeMatMulFusion>(), TransformerLevel::Level2);
+  status = graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, DefaultLoggingManager().DefaultLogger());
+  ASSERT_TRUE(status.IsOK()) << status;
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["DynamicQuantizeLinear"], 0);
+  EXPECT_EQ(op_to_count["MatMulInteger"], 0);
+  EXPECT_EQ(op_to_count["Cast"], 0);
+  EXPECT_EQ(op_to_count["Mul"], 0);
+  EXPECT_EQ(op_to_count["DynamicQuantizeMatMul"], 2);
+
+  for (const Node& node : graph.Nodes()) {
+    EXPECT_EQ(node.InputDefs()[0]->Name(), "A");
+    if (node.InputDefs()[1]->Name() == "B0") {
+      ASSERT_EQ(node.InputDefs().size(), 4u);
+      EXPECT_EQ(node.InputDefs()[2]->Name(), "B0_scale");
+      EXPECT_EQ(node.InputDefs()[3]->Name(), "B0_zero_point");
+      EXPECT_EQ(node.OutputDefs()[0]->Name(), "Y0");
+    } else {
+      ASSERT_EQ(node.InputDefs().size(), 3u);
+      EXPECT_EQ(node.InputDefs()[2]->Name(), "B1_scale");
+      EXPECT_EQ(node.OutputDefs()[0]->Name(), "Y1");
+    }
+  }
+}
+
 #endif
 
 }  // namespace test
@@ -315,7 +315,7 @@ TEST(NchwcOptimizerTests, ConvNchwc) {
     NchwcOptimizerTester(build_test_case, check_nchwc_graph);
   };
 
-  std::vector<std::string> activation_op_types = {"", "Relu", "LeakyRelu", "Clip"};
+  std::vector<std::string> activation_op_types = {"", "Relu", "LeakyRelu", "Clip", "Sigmoid", "HardSigmoid"};
   for (auto& activation_op_type : activation_op_types) {
     test_case(activation_op_type);
   }
@@ -579,6 +579,50 @@ TEST(NchwcOptimizerTests, ConvAddFusion) {
   }
 }
 
+TEST(NchwcOptimizerTests, ConvAddActivationFusion) {
+  auto test_case = [&](const std::string& activation_op_type) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput({1, 32, 28, 28});
+      auto* conv1_output_arg = helper.MakeIntermediate();
+      auto* conv2_output_arg = helper.MakeIntermediate();
+      auto* add_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      helper.AddConvNode(input_arg, conv1_output_arg, {32, 32, 3, 3});
+      helper.AddConvNode(input_arg, conv2_output_arg, {32, 32, 3, 3});
+      helper.AddNode("Add", {conv1_output_arg, conv2_output_arg}, {add_output_arg});
+
+      auto& activation_node = helper.AddNode(activation_op_type, {add_output_arg}, {output_arg});
+      if (activation_op_type == "HardSigmoid") {
+        activation_node.AddAttribute("alpha", 0.01f);
+        activation_node.AddAttribute("beta", 0.25f);
+      }
+
+      // The fused activation is computed by MLAS instead of the standalone
+      // activation kernel, which may introduce small bit differences.
+      helper.per_sample_tolerance_ = 1e-6;
+    };
+
+    auto check_nchwc_graph = [&](NchwcInferenceSession& session) {
+      auto op_to_count = session.CountOpsInGraph();
+      EXPECT_EQ(op_to_count["nchwc.Conv"], 2);
+      EXPECT_EQ(op_to_count["nchwc.ReorderInput"], 1);
+      EXPECT_EQ(op_to_count["nchwc.ReorderOutput"], 1);
+      EXPECT_EQ(op_to_count["Add"], 0);
+      EXPECT_EQ(op_to_count[activation_op_type], 0);
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+  };
+
+  // Verify that an activation following a Conv/Add fusion is also fused into
+  // the NCHWc Conv node.
+  std::vector<std::string> activation_op_types = {"Relu", "Sigmoid", "Tanh", "HardSigmoid"};
+  for (auto& activation_op_type : activation_op_types) {
+    test_case(activation_op_type);
+  }
+}
+
 TEST(NchwcOptimizerTests, ConvNoBiasAddFusion) {
   auto build_test_case = [&](NchwcTestHelper& helper) {
     auto* input_arg = helper.MakeInput({1, 32, 28, 28});
@@ -1059,6 +1103,203 @@ TEST(NchwcOptimizerTests, BatchNormalization) {
   test_case(true);
 }
 
+TEST(NchwcOptimizerTests, UpsampleNearest) {
+  auto test_case = [&](int opset_version, const std::string& transformation_mode, const std::string& nearest_mode, bool expect_transform) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput({3, 3, 27, 15});
+      auto* conv_output_arg = helper.MakeIntermediate();
+      auto* upsample_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      helper.AddConvNode(input_arg, conv_output_arg, {32, 3, 3, 3});
+
+      std::vector<float> scales = {1.0f, 1.0f, 2.0f, 3.0f};
+      if (opset_version >= 11) {
+        auto* roi_arg = helper.MakeInitializer({8}, std::vector<float>(8, 0.0f));
+        auto* scales_arg = helper.MakeInitializer({4}, scales);
+        auto& resize_node = helper.AddNode("Resize", {conv_output_arg, roi_arg, scales_arg}, {upsample_output_arg});
+        resize_node.AddAttribute("coordinate_transformation_mode", transformation_mode);
+        resize_node.AddAttribute("nearest_mode", nearest_mode);
+      } else if (opset_version >= 9) {
+        auto* scales_arg = helper.MakeInitializer({4}, scales);
+        helper.AddNode(opset_version >= 10 ? "Resize" : "Upsample", {conv_output_arg, scales_arg}, {upsample_output_arg});
+      } else {
+        auto& upsample_node = helper.AddNode("Upsample", {conv_output_arg}, {upsample_output_arg});
+        upsample_node.AddAttribute("scales", scales);
+      }
+
+      helper.AddConvNode(upsample_output_arg, output_arg, {16, 32, 1, 1});
+    };
+
+    auto check_nchwc_graph = [&](NchwcInferenceSession& session) {
+      auto op_to_count = session.CountOpsInGraph();
+      EXPECT_EQ(op_to_count["nchwc.Conv"], 2);
+      EXPECT_EQ(op_to_count["nchwc.Upsample"], expect_transform ? 1 : 0);
+      EXPECT_EQ(op_to_count["nchwc.ReorderInput"], expect_transform ? 0 : 1);
+      EXPECT_EQ(op_to_count["nchwc.ReorderOutput"], expect_transform ? 1 : 2);
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph, opset_version);
+  };
+
+  // Verify that nearest neighbor upsampling with integer scales is transformed
+  // only if the coordinate transformation reduces to replicating the input.
+  test_case(7, "", "", true);
+  test_case(9, "", "", true);
+  test_case(10, "", "", true);
+  test_case(11, "asymmetric", "floor", true);
+  test_case(11, "half_pixel", "round_prefer_floor", true);
+  test_case(11, "pytorch_half_pixel", "round_prefer_ceil", true);
+  test_case(11, "tf_half_pixel_for_nn", "floor", true);
+  test_case(11, "asymmetric", "round_prefer_floor", false);
+  test_case(11, "align_corners", "round_prefer_floor", false);
+}
+
+TEST(NchwcOptimizerTests, UpsampleLinear) {
+  auto test_case = [&](int opset_version, const std::string& transformation_mode, bool expect_transform) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput({2, 32, 11, 17});
+      auto* conv_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      helper.AddConvNode(input_arg, conv_output_arg, {48, 32, 3, 3});
+
+      std::vector<float> scales = {1.0f, 1.0f, 4.0f, 2.0f};
+      auto* scales_arg = helper.MakeInitializer({4}, scales);
+      if (opset_version >= 11) {
+        auto* roi_arg = helper.MakeInitializer({8}, std::vector<float>(8, 0.0f));
+        auto& resize_node = helper.AddNode("Resize", {conv_output_arg, roi_arg, scales_arg}, {output_arg});
+        resize_node.AddAttribute("mode", "linear");
+        resize_node.AddAttribute("coordinate_transformation_mode", transformation_mode);
+      } else {
+        auto& upsample_node = helper.AddNode("Upsample", {conv_output_arg, scales_arg}, {output_arg});
+        upsample_node.AddAttribute("mode", "linear");
+      }
+    };
+
+    auto check_nchwc_graph = [&](NchwcInferenceSession& session) {
+      auto op_to_count = session.CountOpsInGraph();
+      EXPECT_EQ(op_to_count["nchwc.Conv"], 1);
+      EXPECT_EQ(op_to_count["nchwc.Upsample"], expect_transform ? 1 : 0);
+      EXPECT_EQ(op_to_count["nchwc.ReorderInput"], 1);
+      EXPECT_EQ(op_to_count["nchwc.ReorderOutput"], 1);
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph, opset_version);
+  };
+
+  test_case(9, "", true);
+  test_case(11, "asymmetric", true);
+  test_case(11, "half_pixel", true);
+  test_case(11, "pytorch_half_pixel", true);
+  test_case(11, "align_corners", true);
+  test_case(11, "tf_crop_and_resize", false);
+}
+
+TEST(NchwcOptimizerTests, SqueezeExcitation) {
+  auto test_case = [&](const std::string& activation_op_type) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput({2, 64, 19, 19});
+      auto* conv_output_arg = helper.MakeIntermediate();
+      auto* pool_output_arg = helper.MakeIntermediate();
+      auto* reduce_output_arg = helper.MakeIntermediate();
+      auto* relu_output_arg = helper.MakeIntermediate();
+      auto* expand_output_arg = helper.MakeIntermediate();
+      auto* scale_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      helper.AddConvNode(input_arg, conv_output_arg, {96, 64, 3, 3});
+      helper.AddNode("GlobalAveragePool", {conv_output_arg}, {pool_output_arg});
+      helper.AddConvNode(pool_output_arg, reduce_output_arg, {32, 96, 1, 1});
+      helper.AddNode("Relu", {reduce_output_arg}, {relu_output_arg});
+      helper.AddConvNode(relu_output_arg, expand_output_arg, {96, 32, 1, 1});
+      helper.AddNode(activation_op_type, {expand_output_arg}, {scale_output_arg});
+      helper.AddNode("Mul", {conv_output_arg, scale_output_arg}, {output_arg});
+    };
+
+    auto check_nchwc_graph = [&](NchwcInferenceSession& session) {
+      auto op_to_count = session.CountOpsInGraph();
+      EXPECT_EQ(op_to_count["nchwc.Conv"], 3);
+      EXPECT_EQ(op_to_count["nchwc.GlobalAveragePool"], 1);
+      EXPECT_EQ(op_to_count["nchwc.ScaleChannels"], 1);
+      EXPECT_EQ(op_to_count["nchwc.ReorderInput"], 1);
+      EXPECT_EQ(op_to_count["nchwc.ReorderOutput"], 1);
+      EXPECT_EQ(op_to_count["Mul"], 0);
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+  };
+
+  // Verify that a squeeze-and-excitation block is kept in NCHWc format,
+  // including the channel-wise multiply of the excitation step.
+  test_case("Sigmoid");
+  test_case("HardSigmoid");
+}
+
+TEST(NchwcOptimizerTests, ConvReduceMean) {
+  auto test_case = [&](const std::vector<int64_t>& axes, int64_t keepdims, bool expect_transform) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput({1, 32, 23, 31});
+      auto* conv_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      helper.AddConvNode(input_arg, conv_output_arg, {48, 32, 3, 3});
+
+      auto& reduce_node = helper.AddNode("ReduceMean", {conv_output_arg}, {output_arg});
+      reduce_node.AddAttribute("axes", axes);
+      reduce_node.AddAttribute("keepdims", keepdims);
+
+      // The NCHWc GlobalAveragePool accumulates in a different order than
+      // ReduceMean, which introduces small bit differences.
+      helper.per_sample_tolerance_ = .01;
+    };
+
+    auto check_nchwc_graph = [&](NchwcInferenceSession& session) {
+      auto op_to_count = session.CountOpsInGraph();
+      EXPECT_EQ(op_to_count["nchwc.Conv"], 1);
+      EXPECT_EQ(op_to_count["nchwc.GlobalAveragePool"], expect_transform ? 1 : 0);
+      EXPECT_EQ(op_to_count["nchwc.ReorderInput"], 1);
+      EXPECT_EQ(op_to_count["nchwc.ReorderOutput"], 1);
+      EXPECT_EQ(op_to_count["ReduceMean"], expect_transform ? 0 : 1);
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+  };
+
+  // Verify that ReduceMean over the spatial dimensions is transformed to a
+  // NCHWc GlobalAveragePool.
+  test_case({2, 3}, 1, true);
+  test_case({-1, -2}, 1, true);
+  test_case({2, 3}, 0, false);
+  test_case({1, 2}, 1, false);
+}
+
+TEST(NchwcOptimizerTests, MulElementwise) {
+  auto build_test_case = [&](NchwcTestHelper& helper) {
+    auto* input_arg = helper.MakeInput({1, 48, 17, 29});
+    auto* conv1_output_arg = helper.MakeIntermediate();
+    auto* conv2_output_arg = helper.MakeIntermediate();
+    auto* output_arg = helper.MakeOutput();
+
+    helper.AddConvNode(input_arg, conv1_output_arg, {40, 48, 3, 3});
+    helper.AddConvNode(input_arg, conv2_output_arg, {40, 48, 3, 3});
+    helper.AddNode("Mul", {conv1_output_arg, conv2_output_arg}, {output_arg});
+  };
+
+  auto check_nchwc_graph = [&](NchwcInferenceSession& session) {
+    auto op_to_count = session.CountOpsInGraph();
+    EXPECT_EQ(op_to_count["nchwc.Conv"], 2);
+    EXPECT_EQ(op_to_count["nchwc.ScaleChannels"], 0);
+    EXPECT_EQ(op_to_count["nchwc.ReorderInput"], 1);
+    EXPECT_EQ(op_to_count["nchwc.ReorderOutput"], 1);
+    EXPECT_EQ(op_to_count["Mul"], 1);
+  };
+
+  // Verify that a multiply of identically shaped NCHWc tensors runs directly
+  // on the NCHWc tensors and is not fused into the convolution.
+  NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+}
+
 TEST(NchwcOptimizerTests, ConvReorderOutputNhwc) {
   auto build_test_case = [&](NchwcTestHelper& helper) {
     auto* input_arg = helper.MakeInput({1, 64, 28, 32});
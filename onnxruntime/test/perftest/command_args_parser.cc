@@ -43,6 +43,11 @@ namespace perftest {
       "\t-v: Show verbose information.\n"
       "\t-x [intra_op_num_threads]: Sets the number of threads used to parallelize the execution within nodes, A value of 0 means ORT will pick a default. Must >=0.\n"
       "\t-y [inter_op_num_threads]: Sets the number of threads used to parallelize the execution of the graph (across nodes), A value of 0 means ORT will pick a default. Must >=0.\n"
+      "\t-S [spin_duration_us]: Sets the time in microseconds that a thread running a parallel loop spins waiting for the thread pool threads before blocking. Default:0.\n"
+      "\t-D: Disables the spinning of idle thread pool threads before they sleep.\n"
+      "\t-a [none|compact|scatter|processor list]: Pins the thread pool threads to logical processors. A comma separated list such as '0,2,4' pins thread i to the i-th entry. Default:none.\n"
+      "\t-N [numa_node]: Restricts the thread pool threads to the logical processors of a NUMA node. Default:-1 (all nodes).\n"
+      "\t-w: Sweep the thread pool spin settings and affinity policies, and print the latency of each combination.\n"
       "\t-P: Use parallel executor instead of sequential executor.\n"
       "\t-o [optimization level]: Default is 1. Valid values are 0 (disable), 1 (basic), 2 (extended), 99 (all).\n"
       "\t\tPlease see onnxruntime_c_api.h (enum GraphOptimizationLevel) for the full list of all optimization levels. \n"
@@ -52,7 +57,7 @@ namespace perftest {
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:o:u:AMPvhs"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:o:u:S:a:N:ADMPvhsw"))) != -1) {
     switch (ch) {
       case 'm':
         if (!CompareCString(optarg, ORT_TSTR("duration"))) {
@@ -132,6 +137,54 @@ namespace perftest {
           return false;
         }
         break;
+      case 'S':
+        test_config.run_config.thread_pool_spin_duration_us =
+            static_cast<int>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
+        if (test_config.run_config.thread_pool_spin_duration_us < 0) {
+          return false;
+        }
+        break;
+      case 'D':
+        test_config.run_config.thread_pool_allow_spinning = false;
+        break;
+      case 'a':
+        test_config.run_config.thread_pool_affinity.clear();
+        if (!CompareCString(optarg, ORT_TSTR("none"))) {
+          test_config.run_config.thread_pool_affinity_policy = ORT_THREAD_AFFINITY_NONE;
+        } else if (!CompareCString(optarg, ORT_TSTR("compact"))) {
+          test_config.run_config.thread_pool_affinity_policy = ORT_THREAD_AFFINITY_COMPACT;
+        } else if (!CompareCString(optarg, ORT_TSTR("scatter"))) {
+          test_config.run_config.thread_pool_affinity_policy = ORT_THREAD_AFFINITY_SCATTER;
+        } else {
+          // comma separated list of logical processors
+          PATH_CHAR_TYPE* p = optarg;
+          for (;;) {
+            PATH_CHAR_TYPE* end = nullptr;
+            long processor = OrtStrtol<PATH_CHAR_TYPE>(p, &end);
+            if (end == p || processor < 0) {
+              return false;
+            }
+            test_config.run_config.thread_pool_affinity.push_back(static_cast<size_t>(processor));
+            if (*end == 0) {
+              break;
+            }
+            if (*end != ',') {
+              return false;
+            }
+            p = end + 1;
+          }
+          test_config.run_config.thread_pool_affinity_policy = ORT_THREAD_AFFINITY_EXPLICIT;
+        }
+        break;
+      case 'N':
+        test_config.run_config.thread_pool_numa_node = static_cast<int>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
+        if (test_config.run_config.thread_pool_numa_node < -1) {
+          return false;
+        }
+        break;
+      case 'w':
+        test_config.run_config.sweep_thread_pool_settings = true;
+        break;
       case 'P':
         test_config.run_config.execution_mode = ExecutionMode::ORT_PARALLEL;
         break;
@@ -3,12 +3,79 @@
 
 // onnxruntime dependencies
 #include <core/session/onnxruntime_c_api.h>
+#include <algorithm>
+#include <numeric>
 #include <random>
+#include <vector>
 #include "command_args_parser.h"
 #include "performance_runner.h"
 
 using namespace onnxruntime;
 
+namespace {
+struct SpinSetting {
+  int spin_duration_us;
+  bool allow_spinning;
+};
+
+struct SweepResult {
+  SpinSetting spin;
+  const char* affinity;
+  double average;
+  double p50;
+  double p90;
+  double p99;
+};
+
+// Runs the test for each combination of thread pool spin setting and affinity policy, and prints the latencies.
+int RunThreadPoolSweep(Ort::Env& env, const perftest::PerformanceTestConfig& base_config, std::random_device& rd) {
+  const SpinSetting spin_settings[] = {{0, false}, {0, true}, {50, true}, {200, true}};
+  std::vector<std::pair<OrtThreadAffinityPolicy, const char*>> policies = {{ORT_THREAD_AFFINITY_NONE, "none"},
+                                                                           {ORT_THREAD_AFFINITY_COMPACT, "compact"},
+                                                                           {ORT_THREAD_AFFINITY_SCATTER, "scatter"}};
+  if (!base_config.run_config.thread_pool_affinity.empty()) {
+    policies.emplace_back(ORT_THREAD_AFFINITY_EXPLICIT, "explicit");
+  }
+
+  std::vector<SweepResult> results;
+  for (const SpinSetting& spin : spin_settings) {
+    for (const auto& policy : policies) {
+      perftest::PerformanceTestConfig test_config = base_config;
+      test_config.run_config.thread_pool_spin_duration_us = spin.spin_duration_us;
+      test_config.run_config.thread_pool_allow_spinning = spin.allow_spinning;
+      test_config.run_config.thread_pool_affinity_policy = policy.first;
+
+      perftest::PerformanceRunner perf_runner(env, test_config, rd);
+      auto status = perf_runner.Run();
+      if (!status.IsOK()) {
+        printf("Run failed:%s\n", status.ErrorMessage().c_str());
+        return -1;
+      }
+      perf_runner.SerializeResult();
+
+      std::vector<double> sorted_time = perf_runner.GetResult().time_costs;
+      if (sorted_time.empty()) {
+        continue;
+      }
+      std::sort(sorted_time.begin(), sorted_time.end());
+      const size_t total = sorted_time.size();
+      results.push_back({spin, policy.second,
+                         std::accumulate(sorted_time.begin(), sorted_time.end(), 0.0) / total,
+                         sorted_time[static_cast<size_t>(total * 0.5)],
+                         sorted_time[static_cast<size_t>(total * 0.9)],
+                         sorted_time[static_cast<size_t>(total * 0.99)]});
+    }
+  }
+
+  printf("\nspin_duration_us,allow_spinning,affinity,average_ms,p50_ms,p90_ms,p99_ms\n");
+  for (const auto& result : results) {
+    printf("%d,%d,%s,%.4f,%.4f,%.4f,%.4f\n", result.spin.spin_duration_us, result.spin.allow_spinning ? 1 : 0,
+           result.affinity, result.average * 1000, result.p50 * 1000, result.p90 * 1000, result.p99 * 1000);
+  }
+  return 0;
+}
+}  // namespace
+
 #ifdef _WIN32
 int real_main(int argc, wchar_t* argv[]) {
 #else
@@ -30,6 +97,10 @@ int real_main(int argc, char* argv[]) {
     return -1;
   }
   std::random_device rd;
+  if (test_config.run_config.sweep_thread_pool_settings) {
+    return RunThreadPoolSweep(env, test_config, rd);
+  }
+
   perftest::PerformanceRunner perf_runner(env, test_config, rd);
   auto status = perf_runner.Run();
   if (!status.IsOK()) {
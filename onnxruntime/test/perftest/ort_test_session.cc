@@ -108,6 +108,13 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
   }
 
   session_options.SetInterOpNumThreads(performance_test_config.run_config.inter_op_num_threads);
+
+  const auto& thread_pool_affinity = performance_test_config.run_config.thread_pool_affinity;
+  session_options.SetThreadPoolSpinDuration(performance_test_config.run_config.thread_pool_spin_duration_us);
+  session_options.SetThreadPoolAllowSpinning(performance_test_config.run_config.thread_pool_allow_spinning);
+  session_options.SetThreadPoolAffinity(performance_test_config.run_config.thread_pool_affinity_policy,
+                                        thread_pool_affinity.data(), thread_pool_affinity.size());
+  session_options.SetThreadPoolNumaNode(performance_test_config.run_config.thread_pool_numa_node);
   // Set optimization level.
   session_options.SetGraphOptimizationLevel(performance_test_config.run_config.optimization_level);
   if (!performance_test_config.run_config.profile_file.empty())
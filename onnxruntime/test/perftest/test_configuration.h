@@ -5,6 +5,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "core/graph/constants.h"
 #include "core/framework/session_options.h"
@@ -47,6 +48,12 @@ struct RunConfig {
   ExecutionMode execution_mode{ExecutionMode::ORT_SEQUENTIAL};
   int intra_op_num_threads{0};
   int inter_op_num_threads{0};
+  int thread_pool_spin_duration_us{0};
+  bool thread_pool_allow_spinning{true};
+  OrtThreadAffinityPolicy thread_pool_affinity_policy{ORT_THREAD_AFFINITY_NONE};
+  std::vector<size_t> thread_pool_affinity;
+  int thread_pool_numa_node{-1};
+  bool sweep_thread_pool_settings{false};
   GraphOptimizationLevel optimization_level{ORT_ENABLE_ALL};
   std::basic_string<ORTCHAR_T> optimized_model_path;
 };
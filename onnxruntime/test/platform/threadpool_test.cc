@@ -1,15 +1,20 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include "core/common/common.h"
+#include "core/platform/env.h"
 #include "core/platform/threadpool.h"
+#include "core/util/thread_utils.h"
 
 #include <core/common/make_unique.h>
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <functional>
 #include <mutex>
+#include <thread>
 
 using namespace onnxruntime::concurrency;
 
@@ -66,6 +71,19 @@ void TestBatchParallelFor(const std::string& name, int num_threads, int num_task
   ValidateTestData(*test_data);
 }
 
+void TestParallelForWithCost(const std::string& name, int num_threads, int num_tasks, double cost_per_unit) {
+  auto test_data = CreateTestData(num_tasks);
+  CreateThreadPoolAndTest(name, num_threads, [&](ThreadPool* tp) {
+    tp->ParallelFor(num_tasks, cost_per_unit, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      ASSERT_LT(first, last);
+      for (std::ptrdiff_t i = first; i < last; ++i) {
+        IncrementElement(*test_data, static_cast<int>(i));
+      }
+    });
+  });
+  ValidateTestData(*test_data);
+}
+
 }  // namespace
 
 TEST(ThreadPoolTest, TestParallelFor_2_Thread_NoTask) {
@@ -99,3 +117,159 @@ TEST(ThreadPoolTest, TestBatchParallelFor_2_Thread_50_Task_100_Batch) {
 TEST(ThreadPoolTest, TestBatchParallelFor_2_Thread_81_Task_20_Batch) {
   TestBatchParallelFor("TestBatchParallelFor_2_Thread_81_Task_20_Batch", 2, 81, 20);
 }
+
+TEST(ThreadPoolTest, TestParallelForWithCost_4_Thread_NoTask) {
+  TestParallelForWithCost("TestParallelForWithCost_4_Thread_NoTask", 4, 0, 1000.0);
+}
+
+TEST(ThreadPoolTest, TestParallelForWithCost_4_Thread_1000_Cheap_Task) {
+  TestParallelForWithCost("TestParallelForWithCost_4_Thread_1000_Cheap_Task", 4, 1000, 1.0);
+}
+
+TEST(ThreadPoolTest, TestParallelForWithCost_4_Thread_1000_Expensive_Task) {
+  TestParallelForWithCost("TestParallelForWithCost_4_Thread_1000_Expensive_Task", 4, 1000, 100000.0);
+}
+
+TEST(ThreadPoolTest, TestParallelForWithCost_4_Thread_97_Expensive_Task) {
+  TestParallelForWithCost("TestParallelForWithCost_4_Thread_97_Expensive_Task", 4, 97, 1000000.0);
+}
+
+TEST(ThreadPoolTest, TestParallelForWithCost_1_Thread_1000_Expensive_Task) {
+  TestParallelForWithCost("TestParallelForWithCost_1_Thread_1000_Expensive_Task", 1, 1000, 100000.0);
+}
+
+TEST(ThreadPoolTest, TestParallelForWithTensorOpCost) {
+  const int num_tasks = 10000;
+  auto test_data = CreateTestData(num_tasks);
+  CreateThreadPoolAndTest("TestParallelForWithTensorOpCost", 4, [&](ThreadPool* tp) {
+    ThreadPool::TryParallelFor(tp, num_tasks, TensorOpCost{64.0, 64.0, 100.0},
+                               [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+                                 for (std::ptrdiff_t i = first; i < last; ++i) {
+                                   IncrementElement(*test_data, static_cast<int>(i));
+                                 }
+                               });
+  });
+  ValidateTestData(*test_data);
+}
+
+TEST(ThreadPoolTest, TestParallelForWithThreadPoolOptions) {
+  const int num_tasks = 1000;
+  auto test_data = CreateTestData(num_tasks);
+
+  ThreadPoolOptions options;
+  options.allow_spinning = false;
+  options.spin_duration_us = 100;
+  // pinning is best effort, so every thread is restricted to processor 0, which always exists
+  options.affinity = {{0}};
+  ThreadPool tp("TestParallelForWithThreadPoolOptions", 2, options);
+
+  tp.ParallelFor(num_tasks, 100000.0, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (std::ptrdiff_t i = first; i < last; ++i) {
+      IncrementElement(*test_data, static_cast<int>(i));
+    }
+  });
+  ValidateTestData(*test_data);
+}
+
+TEST(ThreadPoolTest, TestGetThreadAffinity) {
+  ThreadPoolParams params;
+  ASSERT_TRUE(GetThreadAffinity(params, 4).empty());
+
+  params.affinity_policy = ORT_THREAD_AFFINITY_EXPLICIT;
+  params.affinity = {3, 1};
+  std::vector<std::vector<size_t>> expected_explicit{{3}, {1}};
+  ASSERT_EQ(expected_explicit, GetThreadAffinity(params, 4));
+
+  // COMPACT and SCATTER only use the processors the process may run on
+  std::vector<size_t> available = onnxruntime::Env::Default().GetAvailableProcessors();
+  if (available.empty()) {
+    available.push_back(0);
+  }
+  auto is_available = [&available](const std::vector<size_t>& processors) {
+    return processors.size() == 1 &&
+           std::find(available.begin(), available.end(), processors[0]) != available.end();
+  };
+
+  params.affinity.clear();
+  params.affinity_policy = ORT_THREAD_AFFINITY_COMPACT;
+  auto compact = GetThreadAffinity(params, 2);
+  ASSERT_EQ(2u, compact.size());
+  ASSERT_EQ(std::vector<size_t>{available[0]}, compact[0]);
+  ASSERT_TRUE(is_available(compact[1]));
+
+  params.affinity_policy = ORT_THREAD_AFFINITY_SCATTER;
+  auto scatter = GetThreadAffinity(params, 2);
+  ASSERT_EQ(2u, scatter.size());
+  ASSERT_EQ(std::vector<size_t>{available[0]}, scatter[0]);
+  ASSERT_TRUE(is_available(scatter[1]));
+}
+
+TEST(ThreadPoolTest, TestConcurrentParallelFor) {
+  const int num_callers = 4;
+  const int num_tasks = 1000;
+  std::vector<std::unique_ptr<TestData>> test_data;
+  for (int i = 0; i < num_callers; ++i) {
+    test_data.push_back(CreateTestData(num_tasks));
+  }
+
+  // callers sharing the pool each get a share of its threads, and all of them complete
+  CreateThreadPoolAndTest("TestConcurrentParallelFor", 4, [&](ThreadPool* tp) {
+    std::vector<std::thread> callers;
+    for (int i = 0; i < num_callers; ++i) {
+      callers.emplace_back([tp, &test_data, i]() {
+        tp->ParallelFor(num_tasks, 100000.0, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t j = first; j < last; ++j) {
+            IncrementElement(*test_data[i], static_cast<int>(j));
+          }
+        });
+      });
+    }
+    for (auto& caller : callers) {
+      caller.join();
+    }
+  });
+
+  for (auto& data : test_data) {
+    ValidateTestData(*data);
+  }
+}
+
+TEST(ThreadPoolTest, TestNestedParallelFor) {
+  const int num_outer = 16;
+  const int num_inner = 100;
+  auto test_data = CreateTestData(num_outer * num_inner);
+
+  // loops started from pool threads run to completion without waiting for helpers queued behind the
+  // busy threads of the same pool
+  CreateThreadPoolAndTest("TestNestedParallelFor", 2, [&](ThreadPool* tp) {
+    tp->ParallelFor(num_outer, 1000000.0, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t i = first; i < last; ++i) {
+        tp->ParallelFor(num_inner, 100000.0, [&](std::ptrdiff_t inner_first, std::ptrdiff_t inner_last) {
+          for (std::ptrdiff_t j = inner_first; j < inner_last; ++j) {
+            IncrementElement(*test_data, static_cast<int>(i * num_inner + j));
+          }
+        });
+      }
+    });
+  });
+  ValidateTestData(*test_data);
+}
+
+TEST(ThreadPoolTest, TestParallelForException) {
+  const int num_tasks = 100;
+  std::atomic<int> num_started{0};
+
+  // an exception thrown on any thread reaches the caller, once no thread uses the loop any more
+  CreateThreadPoolAndTest("TestParallelForException", 4, [&](ThreadPool* tp) {
+    for (int throwing_task : {0, num_tasks - 1}) {
+      auto task = [&](int32_t i) {
+        ++num_started;
+        if (i == throwing_task) {
+          ORT_THROW("task ", i, " failed");
+        }
+      };
+      EXPECT_THROW(tp->ParallelFor(num_tasks, task), onnxruntime::OnnxRuntimeException);
+    }
+  });
+  ASSERT_GT(num_started.load(), 0);
+}
@@ -250,6 +250,43 @@ TEST(MathOpTest, Add_Broadcast_2x1x4_1x3x1) {
 #endif
 }
 
+// large enough for the broadcast loop to be split across threads, with blocks
+// that start and end in the middle of a span
+TEST(MathOpTest, Add_Broadcast_Large) {
+  const int64_t rows = 97, cols = 1031;
+  std::vector<float> a(rows * cols), row(cols), col(rows);
+  for (int64_t i = 0; i < rows * cols; ++i) a[i] = static_cast<float>(i % 113);
+  for (int64_t c = 0; c < cols; ++c) row[c] = static_cast<float>(c % 7) * 1000.0f;
+  for (int64_t r = 0; r < rows; ++r) col[r] = static_cast<float>(r) * 100000.0f;
+
+  auto run = [&](const std::vector<int64_t>& b_dims, const std::vector<float>& b, bool a_first) {
+    std::vector<float> c(rows * cols);
+    for (int64_t r = 0; r < rows; ++r)
+      for (int64_t i = 0; i < cols; ++i) {
+        float bv = b.size() == 1 ? b[0] : (b.size() == static_cast<size_t>(cols) ? b[i] : b[r]);
+        c[r * cols + i] = a[r * cols + i] + bv;
+      }
+
+    OpTester test("Add");
+    if (a_first) {
+      test.AddInput<float>("A", {rows, cols}, a);
+      test.AddInput<float>("B", b_dims, b);
+    } else {
+      test.AddInput<float>("A", b_dims, b);
+      test.AddInput<float>("B", {rows, cols}, a);
+    }
+    test.AddOutput<float>("C", {rows, cols}, c);
+    test.Run();
+  };
+
+  run({1}, {5.0f}, true);
+  run({1}, {5.0f}, false);
+  run({cols}, row, true);
+  run({cols}, row, false);
+  run({rows, 1}, col, true);
+  run({rows, 1}, col, false);
+}
+
 TEST(MathOpTest, Add_Broadcast_2x1x1_3x4) {
   OpTester test("Add");
 
@@ -106,6 +106,55 @@ TEST(GemmOpTest, GemmTrans) {
   test.Run();
 }
 
+TEST(GemmOpTest, GemmConstantB) {
+  OpTester test("Gemm");
+
+  test.AddAttribute("transA", (int64_t)0);
+  test.AddAttribute("transB", (int64_t)0);
+  test.AddAttribute("alpha", 1.0f);
+  test.AddAttribute("beta", 1.0f);
+
+  test.AddInput<float>("A", {2, 4},
+                       {1.0f, 2.0f, 3.0f, 4.0f,
+                        -1.0f, -2.0f, -3.0f, -4.0f});
+  test.AddInput<float>("B", {4, 3},
+                       {1.0f, 2.0f, 3.0f,
+                        4.0f, 5.0f, 6.0f,
+                        7.0f, 8.0f, 9.0f,
+                        10.0f, 11.0f, 12.0f},
+                       true);
+  test.AddInput<float>("C", {3}, std::vector<float>{1.0f, 2.0f, 3.0f});
+  test.AddOutput<float>("Y", {2, 3},
+                        {71.0f, 82.0f, 93.0f,
+                         -69.0f, -78.0f, -87.0f});
+  test.Run();
+}
+
+TEST(GemmOpTest, GemmTransConstantB) {
+  OpTester test("Gemm");
+
+  test.AddAttribute("transA", (int64_t)1);
+  test.AddAttribute("transB", (int64_t)1);
+  test.AddAttribute("alpha", 0.5f);
+  test.AddAttribute("beta", 2.0f);
+
+  test.AddInput<float>("A", {4, 2},
+                       {1.0f, -1.0f,
+                        2.0f, -2.0f,
+                        3.0f, -3.0f,
+                        4.0f, -4.0f});
+  test.AddInput<float>("B", {3, 4},
+                       {1.0f, 4.0f, 7.0f, 10.0f,
+                        2.0f, 5.0f, 8.0f, 11.0f,
+                        3.0f, 6.0f, 9.0f, 12.0f},
+                       true);
+  test.AddInput<float>("C", {3}, std::vector<float>(3, 1.0f));
+  test.AddOutput<float>("Y", {2, 3},
+                        {37.0f, 42.0f, 47.0f,
+                         -33.0f, -38.0f, -43.0f});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 TEST(GemmOpTest, GemmAlphaBeta) {
   OpTester test("Gemm");
 
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "core/framework/session_options.h"
 #include "test/providers/provider_test_utils.h"
 
 namespace onnxruntime {
@@ -151,5 +152,111 @@ TEST(MLOpTest, TreeEnsembleClassifierBinary) {
   test.Run();
 }
 
+TEST(MLOpTest, TreeEnsembleClassifierSoftmaxLargeBatch) {
+  OpTester test("TreeEnsembleClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<int64_t> lefts = {1, -1, 3, -1, -1, 1, -1, 3, 4, -1, -1, -1, 1, 2, -1, 4, -1, -1, -1};
+  std::vector<int64_t> rights = {2, -1, 4, -1, -1, 2, -1, 6, 5, -1, -1, -1, 6, 3, -1, 5, -1, -1, -1};
+  std::vector<int64_t> treeids = {0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2};
+  std::vector<int64_t> nodeids = {0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 5, 6, 0, 1, 2, 3, 4, 5, 6};
+  std::vector<int64_t> featureids = {2, -2, 0, -2, -2, 0, -2, 2, 1, -2, -2, -2, 0, 2, -2, 1, -2, -2, -2};
+  std::vector<float> thresholds = {-172.f, -2.f, 2.5f, -2.f, -2.f, 1.5f, -2.f, -62.5f, 213.09999084f,
+                                   -2.f, -2.f, -2.f, 27.5f, -172.f, -2.f, 8.10000038f, -2.f, -2.f, -2.f};
+  std::vector<std::string> modes = {"BRANCH_LEQ", "LEAF", "BRANCH_LEQ", "LEAF", "LEAF", "BRANCH_LEQ",
+                                    "LEAF", "BRANCH_LEQ", "BRANCH_LEQ", "LEAF", "LEAF", "LEAF",
+                                    "BRANCH_LEQ", "BRANCH_LEQ", "LEAF", "BRANCH_LEQ", "LEAF", "LEAF", "LEAF"};
+  std::vector<int64_t> class_treeids = {0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2};
+  std::vector<int64_t> class_nodeids = {1, 3, 4, 1, 4, 5, 6, 2, 4, 5, 6};
+  std::vector<int64_t> class_classids = {2, 0, 1, 0, 2, 3, 1, 2, 0, 1, 3};
+  std::vector<float> class_weights = {1.f, 4.f, 1.f, 2.f, 1.f, 1.f, 2.f, 1.f, 1.f, 1.f, 3.f};
+  std::vector<int64_t> classes = {0, 1, 2, 3};
+  std::vector<float> X1 = {1.f, 0.0f, 0.4f, 3.0f, 44.0f, -3.f, 12.0f, 12.9f, -312.f, 23.0f, 11.3f, -222.f, 23.0f,
+                           11.3f, -222.f, 23.0f, 3311.3f, -222.f, 23.0f, 11.3f, -222.f, 43.0f, 413.3f, -114.f};
+  std::vector<int64_t> results1 = {0, 1, 2, 2, 2, 2, 2, 3};
+  // softmax of the scores of the TreeEnsembleClassifier test
+  std::vector<float> scores1{0.99727182f, 0.00090939419f, 0.00090939419f, 0.00090939419f,
+                             0.017361669f, 0.94791499f, 0.017361669f, 0.017361669f,
+                             0.043317164f, 0.043317164f, 0.87004851f, 0.043317164f,
+                             0.043317164f, 0.043317164f, 0.87004851f, 0.043317164f,
+                             0.043317164f, 0.043317164f, 0.87004851f, 0.043317164f,
+                             0.082594539f, 0.082594539f, 0.61029569f, 0.22451524f,
+                             0.043317164f, 0.043317164f, 0.87004851f, 0.043317164f,
+                             0.016858735f, 0.045826793f, 0.016858735f, 0.92045574f};
+
+  // enough rows to be evaluated in several blocks and transformed together
+  std::vector<float> X;
+  std::vector<int64_t> results;
+  std::vector<float> scores;
+  for (int i = 0; i < 25; ++i) {
+    X.insert(X.end(), X1.begin(), X1.end());
+    results.insert(results.end(), results1.begin(), results1.end());
+    scores.insert(scores.end(), scores1.begin(), scores1.end());
+  }
+
+  //define the context of the operator call
+  const int64_t N = static_cast<int64_t>(results.size());
+  test.AddAttribute("nodes_truenodeids", lefts);
+  test.AddAttribute("nodes_falsenodeids", rights);
+  test.AddAttribute("nodes_treeids", treeids);
+  test.AddAttribute("nodes_nodeids", nodeids);
+  test.AddAttribute("nodes_featureids", featureids);
+  test.AddAttribute("nodes_values", thresholds);
+  test.AddAttribute("nodes_modes", modes);
+  test.AddAttribute("class_treeids", class_treeids);
+  test.AddAttribute("class_nodeids", class_nodeids);
+  test.AddAttribute("class_ids", class_classids);
+  test.AddAttribute("class_weights", class_weights);
+  test.AddAttribute("classlabels_int64s", classes);
+  test.AddAttribute("post_transform", "SOFTMAX");
+
+  test.AddInput<float>("X", {N, 3}, X);
+  test.AddOutput<int64_t>("Y", {N}, results);
+  test.AddOutput<float>("Z", {N, static_cast<int64_t>(classes.size())}, scores);
+
+  // split the rows over several threads
+  SessionOptions so;
+  so.intra_op_num_threads = 4;
+  test.Run(so);
+}
+
+TEST(MLOpTest, TreeEnsembleClassifierTopClassOutOfRange) {
+  OpTester test("TreeEnsembleClassifier", 1, onnxruntime::kMLDomain);
+
+  // a single leaf voting for class 4, which is not one of the 3 class labels
+  std::vector<int64_t> lefts = {-1};
+  std::vector<int64_t> rights = {-1};
+  std::vector<int64_t> treeids = {0};
+  std::vector<int64_t> nodeids = {0};
+  std::vector<int64_t> featureids = {-2};
+  std::vector<float> thresholds = {-2.f};
+  std::vector<std::string> modes = {"LEAF"};
+  std::vector<int64_t> class_treeids = {0};
+  std::vector<int64_t> class_nodeids = {0};
+  std::vector<int64_t> class_classids = {4};
+  std::vector<float> class_weights = {1.f};
+  std::vector<int64_t> classes = {0, 1, 2};
+  std::vector<float> X = {1.f, 2.f};
+
+  const int N = 2;
+  test.AddAttribute("nodes_truenodeids", lefts);
+  test.AddAttribute("nodes_falsenodeids", rights);
+  test.AddAttribute("nodes_treeids", treeids);
+  test.AddAttribute("nodes_nodeids", nodeids);
+  test.AddAttribute("nodes_featureids", featureids);
+  test.AddAttribute("nodes_values", thresholds);
+  test.AddAttribute("nodes_modes", modes);
+  test.AddAttribute("class_treeids", class_treeids);
+  test.AddAttribute("class_nodeids", class_nodeids);
+  test.AddAttribute("class_ids", class_classids);
+  test.AddAttribute("class_weights", class_weights);
+  test.AddAttribute("classlabels_int64s", classes);
+
+  test.AddInput<float>("X", {N, 1}, X);
+  test.AddOutput<int64_t>("Y", {N}, {0, 0});
+  test.AddOutput<float>("Z", {N, static_cast<int64_t>(classes.size())}, {0, 0, 0, 0, 0, 0});
+
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Top class 4 of row 0 is not one of the 3 class labels");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -552,5 +552,58 @@ TEST(ConvTransposeTest, ConvTranspose_2D_NonDefaultStridesAndDilations) {
   TestConvTransposeOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
 }
 
+TEST(ConvTransposeTest, ConvTranspose_1D_Group_Bias_Batch) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{2},     // kernel_shape
+      {},                     // output_padding
+      {},                     // output_shape
+      vector<int64_t>{1, 0},  // pads
+      vector<int64_t>{2},     // strides
+      vector<int64_t>{1},     // dilations
+      2                       // group
+  };
+  vector<float> X = {-1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f,
+                     1.0f, 1.5f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, -1.5f, -1.0f, -0.5f};
+  vector<int64_t> X_shape = {2, 4, 3};
+  vector<float> W = {-0.5f, 0.25f, -0.25f, 0.5f, 0.0f, -0.5f, 0.25f, -0.25f,
+                     0.5f, 0.0f, -0.5f, 0.25f, -0.25f, 0.5f, 0.0f, -0.5f};
+  vector<int64_t> W_shape = {4, 2, 2};
+  vector<float> B = {0.5f, -1.0f, 0.25f, 1.5f};
+  vector<int64_t> B_shape = {4};
+  vector<int64_t> Y_shape = {2, 4, 5};
+  auto expected_vals = {0.125f, 1.0f, 0.0f, 0.75f, -0.125f,
+                        -1.75f, -0.625f, -1.625f, -0.625f, -1.5f,
+                        0.0f, -0.5f, 0.25f, -0.375f, 0.5f,
+                        2.125f, 2.25f, 1.125f, 2.0f, 1.0f,
+                        1.25f, -0.25f, 1.125f, 1.25f, 0.125f,
+                        -0.25f, -1.5f, -0.125f, -0.625f, -1.75f,
+                        -0.5f, 1.0f, -0.25f, 1.125f, 0.0f,
+                        2.375f, 1.0f, 2.25f, 0.75f, 2.125f};
+
+  TestConvTransposeOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape, OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kTensorrtExecutionProvider});
+}
+
+TEST(ConvTransposeTest, ConvTranspose_2D_Pointwise_Bias) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{1, 1},        // kernel_shape
+      {},                           // output_padding
+      {},                           // output_shape
+      vector<int64_t>{0, 0, 0, 0},  // pads
+      vector<int64_t>{1, 1},        // strides
+      vector<int64_t>{1, 1},        // dilations
+      1                             // group
+  };
+  vector<float> X = {-5.0f, -4.0f, -3.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  vector<int64_t> X_shape = {1, 3, 2, 2};
+  vector<float> W = {0.5f, -1.0f, 1.0f, 0.25f, -0.5f, 2.0f};
+  vector<int64_t> W_shape = {3, 2, 1, 1};
+  vector<float> B = {1.0f, -1.0f};
+  vector<int64_t> B_shape = {2};
+  vector<int64_t> Y_shape = {1, 2, 2, 2};
+  auto expected_vals = {-4.0f, -3.0f, -2.0f, -1.0f, 9.75f, 11.0f, 12.25f, 13.5f};
+
+  TestConvTransposeOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
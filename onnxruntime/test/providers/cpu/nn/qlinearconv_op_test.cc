@@ -176,6 +176,83 @@ TEST(ConvTest, QLinearConv3DTest) {
   test.Run();
 }
 
+// Grouped convolution with per-channel filter scales and a bias. The input channels of a group expand to enough
+// rows that each image is split into several output tiles. The expected output is computed with the integer
+// accumulators and the same float requantization as the kernel.
+TEST(ConvTest, QLinearConv2DGroupPerChannelTest) {
+  OpTester test("QLinearConv", 10);
+
+  const int64_t N = 2, C = 128, H = 20, W = 20, M = 8, group = 2, kernel = 3;
+  const int64_t group_input_channels = C / group;
+  const int64_t group_output_channels = M / group;
+
+  vector<uint8_t> x(N * C * H * W), w(M * group_input_channels * kernel * kernel);
+  vector<int32_t> bias(M);
+  vector<float> w_scale(M);
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = static_cast<uint8_t>((i * 37 + 11) % 256);
+  }
+  for (size_t i = 0; i < w.size(); i++) {
+    w[i] = static_cast<uint8_t>((i * 53 + 7) % 256);
+  }
+  for (int64_t m = 0; m < M; m++) {
+    bias[m] = static_cast<int32_t>(m * 997 - 3000);
+    w_scale[m] = 0.001f * (m + 1);
+  }
+
+  const float x_scale = 0.02f, y_scale = 0.75f;
+  const uint8_t x_zero_point = 120, w_zero_point = 130, y_zero_point = 100;
+
+  // pads of 1 keep the output size equal to the input size
+  vector<uint8_t> y(N * M * H * W);
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t m = 0; m < M; m++) {
+      const int64_t g = m / group_output_channels;
+      const float scale = (x_scale * w_scale[m]) / y_scale;
+      for (int64_t oh = 0; oh < H; oh++) {
+        for (int64_t ow = 0; ow < W; ow++) {
+          int32_t sum = bias[m];
+          for (int64_t c = 0; c < group_input_channels; c++) {
+            for (int64_t kh = 0; kh < kernel; kh++) {
+              for (int64_t kw = 0; kw < kernel; kw++) {
+                const int64_t ih = oh + kh - 1, iw = ow + kw - 1;
+                if (ih < 0 || ih >= H || iw < 0 || iw >= W) {
+                  continue;
+                }
+                const int32_t x_value = x[((n * C + g * group_input_channels + c) * H + ih) * W + iw];
+                const int32_t w_value = w[((m * group_input_channels + c) * kernel + kh) * kernel + kw];
+                sum += (x_value - x_zero_point) * (w_value - w_zero_point);
+              }
+            }
+          }
+          float value = std::nearbyintf(static_cast<float>(sum) * scale) + y_zero_point;
+          y[((n * M + m) * H + oh) * W + ow] = static_cast<uint8_t>(std::max(0.f, std::min(255.f, value)));
+        }
+      }
+    }
+  }
+
+  test.AddAttribute("group", group);
+  test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+
+  test.AddInput<uint8_t>("x", {N, C, H, W}, x);
+  test.AddInput<float>("x_scale", {}, {x_scale});
+  test.AddInput<uint8_t>("x_zero_point", {}, {x_zero_point});
+
+  // the filter is a constant initializer so that it is pre-packed for each group
+  test.AddInput<uint8_t>("w", {M, group_input_channels, kernel, kernel}, w, /*is_initializer*/ true);
+  test.AddInput<float>("w_scale", {M}, w_scale);
+  test.AddInput<uint8_t>("w_zero_point", {}, {w_zero_point});
+
+  test.AddInput<float>("y_scale", {}, {y_scale});
+  test.AddInput<uint8_t>("y_zero_point", {}, {y_zero_point});
+  test.AddInput<int32_t>("B", {M}, bias);
+
+  test.AddOutput<uint8_t>("y", {N, M, H, W}, y);
+
+  test.Run();
+}
+
 }  // namespace
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <random>
 #include <cmath>
 #include <type_traits>
@@ -683,6 +684,69 @@ TEST(ReductionOpTest, ReduceMean_int32) {
   test.Run();
 }
 
+// the reduced axes are adjacent, so the input is reduced in place as [outer, reduced, inner]
+TEST(ReductionOpTest, ReduceMean_middle_axes) {
+  const std::vector<int64_t> dims{2, 3, 4, 5};
+  std::vector<float> data(2 * 3 * 4 * 5);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 7);
+  }
+
+  std::vector<float> expected(2 * 5, 0.0f);
+  for (int64_t o = 0; o < 2; ++o) {
+    for (int64_t r = 0; r < 3 * 4; ++r) {
+      for (int64_t i = 0; i < 5; ++i) {
+        expected[o * 5 + i] += data[(o * 3 * 4 + r) * 5 + i] / 12.0f;
+      }
+    }
+  }
+
+  OpTester test("ReduceMean");
+  test.AddAttribute("axes", std::vector<int64_t>{1, 2});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", dims, data);
+  test.AddOutput<float>("reduced", {2, 5}, expected);
+  test.Run();
+}
+
+// few rows with many elements each, which are split in parts that are reduced in parallel
+TEST(ReductionOpTest, ReduceSumMax_large_rows) {
+  const int64_t rows = 2;
+  const int64_t row_size = 100003;
+  std::vector<float> data(rows * row_size);
+  std::vector<float> expected_sum(rows, 0.0f);
+  std::vector<float> expected_max(rows);
+  for (int64_t r = 0; r < rows; ++r) {
+    for (int64_t i = 0; i < row_size; ++i) {
+      // small integer values so the sum is exact in any order
+      const float value = static_cast<float>((i * 31 + r) % 5);
+      data[r * row_size + i] = value;
+      expected_sum[r] += value;
+    }
+
+    // a different maximum in each row, above the other values and placed in a different part of the row
+    const int64_t peak_index = (r + 1) * row_size / (rows + 1);
+    const float peak = static_cast<float>(10 + r);
+    expected_sum[r] += peak - data[r * row_size + peak_index];
+    expected_max[r] = peak;
+    data[r * row_size + peak_index] = peak;
+  }
+
+  OpTester test("ReduceSum");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {rows, row_size}, data);
+  test.AddOutput<float>("reduced", {rows}, expected_sum);
+  test.Run();
+
+  OpTester test_max("ReduceMax");
+  test_max.AddAttribute("axes", std::vector<int64_t>{1});
+  test_max.AddAttribute("keepdims", (int64_t)0);
+  test_max.AddInput<float>("data", {rows, row_size}, data);
+  test_max.AddOutput<float>("reduced", {rows}, expected_max);
+  test_max.Run();
+}
+
 TEST(ReductionOpTest, ReduceMin_default_axes_keepdims) {
   OpTester test("ReduceMin");
   test.AddAttribute("keepdims", (int64_t)1);
@@ -33,7 +33,8 @@ static void RunGruTest(const std::vector<float>& X_data,
                        // copy the following vectors as we may modify them
                        std::vector<string> activations = default_activations,
                        std::vector<float> activation_alphas = {},
-                       std::vector<float> activation_betas = {}) {
+                       std::vector<float> activation_betas = {},
+                       bool weights_are_initializers = true) {
   OpTester test("GRU");
 
   test.AddShapeToTensorData();
@@ -65,8 +66,9 @@ static void RunGruTest(const std::vector<float>& X_data,
   std::vector<int64_t> R_dims = {num_directions, 3 * hidden_size, hidden_size};
 
   test.AddInput<float>("X", X_dims, X_data);
-  test.AddInput<float>("W", W_dims, W_data, true);
-  test.AddInput<float>("R", R_dims, R_data, true);
+  // constant weights are pre-packed by the kernel
+  test.AddInput<float>("W", W_dims, W_data, weights_are_initializers);
+  test.AddInput<float>("R", R_dims, R_data, weights_are_initializers);
 
   if (B_data) {
     std::vector<int64_t> B_dims = {num_directions, 6 * hidden_size};
@@ -134,6 +136,11 @@ void DefaultActivationsSimpleWeightsNoBias(std::string direction,
   if (!Y_h_data.empty())
     RunGruTest(X_data, W_data, R_data, Y_data, Y_h_data, input_size, batch_size, hidden_size, seq_length,
                nullptr, nullptr, nullptr, direction, 9999.0, /* output_sequence*/ false);
+
+  // repeat with W and R as graph inputs so the weights aren't pre-packed
+  RunGruTest(X_data, W_data, R_data, Y_data, Y_h_data, input_size, batch_size, hidden_size, seq_length,
+             nullptr, nullptr, nullptr, direction, 9999.0, true, false, default_activations, {}, {},
+             /* weights_are_initializers */ false);
 }
 
 TEST(GRUTest, ForwardDefaultActivationsSimpleWeightsNoBiasTwoRows) {
@@ -245,6 +252,11 @@ void DefaultActivationsSimpleWeightsWithBias(std::string direction,
 
   RunGruTest(X_data, W_data, R_data, Y_data, {}, input_size, batch_size, hidden_size, seq_length,
              &B_data, nullptr, nullptr, direction, 999.f, /* output_sequence*/ true, linear_before_reset);
+
+  // repeat with W and R as graph inputs so the weights aren't pre-packed
+  RunGruTest(X_data, W_data, R_data, Y_data, {}, input_size, batch_size, hidden_size, seq_length,
+             &B_data, nullptr, nullptr, direction, 999.f, /* output_sequence*/ true, linear_before_reset,
+             default_activations, {}, {}, /* weights_are_initializers */ false);
 }
 
 TEST(GRUTest, ForwardDefaultActivationsSimpleWeightsWithBiasBatchParallel) {
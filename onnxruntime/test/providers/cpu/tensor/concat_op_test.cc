@@ -233,5 +233,37 @@ TEST(ConcatOpTest, Concat3D_3) {
   test.Run();
 }
 
+TEST(ConcatOpTest, Concat3D_large) {
+  // inputs with different sizes along the concat axis, large enough to be split across threads
+  const int64_t outer = 8, inner = 1000;
+  const std::vector<int64_t> axis_dims{3, 1, 5};
+
+  std::vector<std::vector<float>> inputs;
+  float value = 0.0f;
+  for (auto axis_dim : axis_dims) {
+    std::vector<float> input(outer * axis_dim * inner);
+    for (auto& v : input) {
+      v = value++;
+    }
+    inputs.push_back(std::move(input));
+  }
+
+  std::vector<float> output;
+  for (int64_t o = 0; o < outer; ++o) {
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      const int64_t pitch = axis_dims[i] * inner;
+      output.insert(output.end(), inputs[i].begin() + o * pitch, inputs[i].begin() + (o + 1) * pitch);
+    }
+  }
+
+  OpTester test("Concat");
+  test.AddAttribute("axis", int64_t{1});
+  test.AddInput<float>("input1", {outer, axis_dims[0], inner}, inputs[0]);
+  test.AddInput<float>("input2", {outer, axis_dims[1], inner}, inputs[1]);
+  test.AddInput<float>("input3", {outer, axis_dims[2], inner}, inputs[2]);
+  test.AddOutput<float>("concat_result", {outer, 9, inner}, output);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -323,5 +323,37 @@ TEST(GatherOpTest, Gather_axis1_neg_indices2d_int8) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});  //TensorRT: Assertion `regionRanges != nullptr' failed
 }
 
+TEST(GatherOpTest, Gather_axis1_large) {
+  // enough blocks to be split across threads, with a mix of negative and repeated indices
+  const int64_t M = 16, axis_dim = 50, K = 3, N = 200;
+  std::vector<float> input(M * axis_dim * K);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i);
+  }
+
+  std::vector<int64_t> indices(N);
+  for (int64_t i = 0; i < N; ++i) {
+    indices[i] = (i * 7) % axis_dim - (i % 2 == 0 ? axis_dim : 0);
+  }
+
+  std::vector<float> output;
+  output.reserve(M * N * K);
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      const int64_t idx = indices[n] < 0 ? indices[n] + axis_dim : indices[n];
+      for (int64_t k = 0; k < K; ++k) {
+        output.push_back(input[(m * axis_dim + idx) * K + k]);
+      }
+    }
+  }
+
+  OpTester test("Gather", 11);
+  test.AddAttribute<int64_t>("axis", 1LL);
+  test.AddInput<float>("data", {M, axis_dim, K}, input);
+  test.AddInput<int64_t>("indices", {N}, indices);
+  test.AddOutput<float>("output", {M, N, K}, output);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
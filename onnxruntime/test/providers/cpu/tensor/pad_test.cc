@@ -489,5 +489,69 @@ TEST(TensorOpTest, Pad_Reflect_DimWithZeroInput) {
                                "Cannot use 'reflect' mode to pad dimension with a value of 0. Input shape:{0,2,1}");
 }
 
+// Pads a 4D input the way numpy.pad does so the larger tests can compute their expected output.
+// Negative pads remove data from the start or end of the axis (constant mode only).
+static std::vector<float> PadReference(const std::vector<int64_t>& input_dims, const std::vector<float>& input,
+                                       const std::vector<int64_t>& pads, float value, const std::string& mode,
+                                       std::vector<int64_t>& output_dims) {
+  const size_t rank = input_dims.size();
+  output_dims.resize(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    output_dims[i] = input_dims[i] + pads[i] + pads[i + rank];
+  }
+
+  std::vector<float> output;
+  for (int64_t n = 0; n < output_dims[0]; ++n) {
+    for (int64_t c = 0; c < output_dims[1]; ++c) {
+      for (int64_t h = 0; h < output_dims[2]; ++h) {
+        for (int64_t w = 0; w < output_dims[3]; ++w) {
+          int64_t index[] = {n - pads[0], c - pads[1], h - pads[2], w - pads[3]};
+          bool inside = true;
+          for (size_t i = 0; i < rank; ++i) {
+            if (index[i] < 0 || index[i] >= input_dims[i]) {
+              inside = false;
+              if (mode == "edge") {
+                index[i] = index[i] < 0 ? 0 : input_dims[i] - 1;
+              } else if (mode == "reflect") {
+                index[i] = index[i] < 0 ? -index[i] : 2 * (input_dims[i] - 1) - index[i];
+              }
+            }
+          }
+
+          if (!inside && mode == "constant") {
+            output.push_back(value);
+          } else {
+            output.push_back(input[((index[0] * input_dims[1] + index[1]) * input_dims[2] + index[2]) * input_dims[3] +
+                                   index[3]]);
+          }
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+// large enough for the copy of the input to be split across threads
+TEST(TensorOpTest, Pad_4D_large) {
+  const std::vector<int64_t> input_dims{2, 3, 40, 60};
+  std::vector<float> input(2 * 3 * 40 * 60);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i);
+  }
+
+  for (const std::string mode : {"constant", "edge", "reflect"}) {
+    const std::vector<int64_t> pads{0, 1, 2, 3, 1, 0, 3, 2};
+    std::vector<int64_t> output_dims;
+    const auto output = PadReference(input_dims, input, pads, 0.5f, mode, output_dims);
+    RunAllOpsetAllDomainPadTests(input_dims, input, pads, 0.5f, output_dims, output, mode);
+  }
+
+  const std::vector<int64_t> negative_pads{0, -1, 2, -3, 0, 1, -4, 2};
+  std::vector<int64_t> output_dims;
+  const auto output = PadReference(input_dims, input, negative_pads, 0.5f, "constant", output_dims);
+  RunAllOpsetAllDomainPadTests(input_dims, input, negative_pads, 0.5f, output_dims, output);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
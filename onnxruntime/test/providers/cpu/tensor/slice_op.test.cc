@@ -575,5 +575,62 @@ TEST(SliceTest, Slice5D_SubsetOfAxes_Flatten2Dims_OffsetInput) {
                       {-5.f, -6.f, -7.f, -8.f},
                       true);
 }
+
+// large enough for the rows to be split across threads
+TEST(SliceTest, Slice3D_large) {
+  const int64_t dim0 = 8, dim1 = 64, dim2 = 500;
+  std::vector<float> input(dim0 * dim1 * dim2);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i);
+  }
+
+  // input[1:7, 3:60, 10:490]
+  std::vector<float> output;
+  for (int64_t i = 1; i < 7; ++i) {
+    for (int64_t j = 3; j < 60; ++j) {
+      for (int64_t k = 10; k < 490; ++k) {
+        output.push_back(input[(i * dim1 + j) * dim2 + k]);
+      }
+    }
+  }
+
+  RunSliceTest<float>({dim0, dim1, dim2},
+                      input,
+                      {1, 3, 10},
+                      {7, 60, 490},
+                      {},
+                      {},
+                      {6, 57, 480},
+                      output);
+}
+
+// a step along the innermost axis copies one element at a time
+TEST(SliceTest, Slice3D_large_WithPositiveAndNegativeSteps) {
+  const int64_t dim0 = 8, dim1 = 64, dim2 = 500;
+  std::vector<float> input(dim0 * dim1 * dim2);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i);
+  }
+
+  // input[7:0:-2, 1:64:3, 499:0:-3]
+  std::vector<float> output;
+  for (int64_t i = 7; i > 0; i -= 2) {
+    for (int64_t j = 1; j < 64; j += 3) {
+      for (int64_t k = 499; k > 0; k -= 3) {
+        output.push_back(input[(i * dim1 + j) * dim2 + k]);
+      }
+    }
+  }
+
+  RunSliceTest<float>({dim0, dim1, dim2},
+                      input,
+                      {7, 1, 499},
+                      {0, 64, 0},
+                      {0, 1, 2},
+                      {-2, 3, -3},
+                      {4, 21, 167},
+                      output,
+                      true);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -414,5 +416,75 @@ TEST(TransposeOpTest, SingleAxisMovingInwardsBlockCopy) {
 
   TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals, false, false);
 }
+
+// compute the expected output of a transpose element by element and compare it against the kernel. the shapes are
+// large enough to cover multiple cache tiles and partial blocks in the 2D transposes.
+template <typename T>
+static void TransposeReferenceTest(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perm) {
+  const size_t rank = input_shape.size();
+  const size_t size = static_cast<size_t>(std::accumulate(input_shape.begin(), input_shape.end(), int64_t{1},
+                                                          std::multiplies<int64_t>()));
+
+  std::vector<T> input_vals(size);
+  for (size_t i = 0; i < size; ++i) {
+    input_vals[i] = static_cast<T>(i % 251);
+  }
+
+  std::vector<int64_t> input_strides(rank);
+  std::vector<int64_t> output_shape(rank);
+  int64_t stride = 1;
+  for (size_t i = rank; i-- > 0;) {
+    input_strides[i] = stride;
+    stride *= input_shape[i];
+  }
+  for (size_t i = 0; i < rank; ++i) {
+    output_shape[i] = input_shape[perm[i]];
+  }
+
+  std::vector<T> expected_vals(size);
+  std::vector<int64_t> index(rank, 0);
+  for (size_t i = 0; i < size; ++i) {
+    int64_t offset = 0;
+    for (size_t j = 0; j < rank; ++j) {
+      offset += index[j] * input_strides[perm[j]];
+    }
+    expected_vals[i] = input_vals[offset];
+
+    for (size_t j = rank; j-- > 0;) {
+      if (++index[j] < output_shape[j]) break;
+      index[j] = 0;
+    }
+  }
+
+  OpTester test("Transpose");
+  test.AddAttribute("perm", perm);
+  test.AddInput<T>("X", input_shape, input_vals);
+  test.AddOutput<T>("Y", output_shape, expected_vals);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
+TEST(TransposeOpTest, LargeNCHW2NHWC) {
+  TransposeReferenceTest<uint8_t>({2, 67, 9, 11}, {0, 2, 3, 1});
+  TransposeReferenceTest<int16_t>({2, 67, 9, 11}, {0, 2, 3, 1});
+  TransposeReferenceTest<float>({2, 67, 9, 11}, {0, 2, 3, 1});
+  TransposeReferenceTest<double>({2, 67, 9, 11}, {0, 2, 3, 1});
+}
+
+TEST(TransposeOpTest, LargeNHWC2NCHW) {
+  TransposeReferenceTest<uint8_t>({3, 13, 10, 70}, {0, 3, 1, 2});
+  TransposeReferenceTest<float>({3, 13, 10, 70}, {0, 3, 1, 2});
+}
+
+TEST(TransposeOpTest, AttentionHeads) {
+  // {batch, sequence, heads, head size} <-> {batch, heads, sequence, head size}
+  TransposeReferenceTest<float>({2, 33, 12, 16}, {0, 2, 1, 3});
+  TransposeReferenceTest<float>({2, 12, 33, 3}, {0, 2, 1, 3});
+}
+
+TEST(TransposeOpTest, MergedAndUnitAxes) {
+  TransposeReferenceTest<float>({1, 5, 1, 7, 9}, {3, 4, 2, 0, 1});
+  TransposeReferenceTest<int32_t>({4, 1, 6, 5, 3}, {2, 3, 1, 4, 0});
+  TransposeReferenceTest<uint8_t>({3, 5, 2, 7}, {2, 3, 0, 1});
+}
 }  // namespace test
 }  // namespace onnxruntime